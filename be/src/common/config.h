@@ -222,6 +222,12 @@ CONF_String(storage_page_cache_limit, "20%");
 CONF_Int32(index_page_cache_percentage, "10");
 // whether to disable page cache feature in storage
 CONF_Bool(disable_storage_page_cache, "false");
+// Eviction policy of storage page cache, could be LRU, SLRU, TINYLFU or CLOCK.
+// SLRU and TINYLFU keep the frequently hit pages from being flushed by large scans.
+// CLOCK doesn't take lock on cache hit, which reduces lock contention on many cores.
+CONF_String(storage_page_cache_eviction_policy, "LRU");
+// Number of shards of the caches using CLOCK eviction policy, will be rounded up to power of 2.
+CONF_Int32(clock_cache_num_shards, "64");
 
 // be policy
 // whether disable automatic compaction task
@@ -363,6 +369,16 @@ CONF_Int32(fragment_pool_thread_num_min, "64");
 CONF_Int32(fragment_pool_thread_num_max, "512");
 CONF_Int32(fragment_pool_queue_size, "2048");
 
+// Number of worker threads of the pipeline engine. If 0, it's the number of cpu cores.
+CONF_Int32(pipeline_executor_size, "0");
+// A pipeline task yields the worker thread after running for this long, so that
+// other tasks can be scheduled.
+CONF_mInt32(pipeline_task_time_slice_ms, "100");
+
+// If not empty, the query plan fragments received by this BE are saved in this dir, one
+// sub dir for each query, so that they can be replayed by query_benchmark_tool without FE.
+CONF_mString(plan_fragment_dump_dir, "");
+
 // Control the number of disks on the machine.  If 0, this comes from the system settings.
 CONF_Int32(num_disks, "0");
 // The maximum number of the threads per disk is also the max queue depth per disk.
@@ -601,6 +617,11 @@ CONF_mInt32(remote_storage_read_buffer_mb, "16");
 // the level equal or lower than mem_tracker_level will show in web page
 CONF_Int16(mem_tracker_level, "0");
 
+// The memory consumed by a thread attached to a MemTracker is cached in the thread,
+// and flushed to the tracker and its ancestors when the cached bytes exceed this value.
+// A tracker's consumption may lag behind by this many bytes per thread.
+CONF_mInt64(mem_tracker_consume_min_size_bytes, "1048576");
+
 // The version information of the tablet will be stored in the memory
 // in an adjacency graph data structure.
 // And as the new version is written and the old version is deleted,
@@ -641,6 +662,8 @@ CONF_mInt32(external_table_connect_timeout_sec, "5");
 // Althought it is called "segment cache", but it caches segments in rowset granularity.
 // So the value of this config should corresponding to the number of rowsets on this BE.
 CONF_mInt32(segment_cache_capacity, "1000000");
+// Eviction policy of segment cache, could be LRU, SLRU, TINYLFU or CLOCK.
+CONF_String(segment_cache_eviction_policy, "LRU");
 
 // Set to true to disable the minidump feature.
 CONF_Bool(disable_minidump , "false");
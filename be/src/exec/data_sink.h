@@ -63,6 +63,13 @@ public:
     virtual Status send(RuntimeState* state, vectorized::Block* block) {
         return Status::NotSupported("Not support send block");
     };
+
+    // Returns false if send() would block. Used by the pipeline engine to avoid
+    // holding a worker thread while waiting for the receiver.
+    virtual bool can_write() { return true; }
+    // Called by the pipeline engine before open(), send() is only called when can_write() is
+    // true. A sink may exceed the buffer limit of a receiver by a block instead of waiting.
+    virtual void set_non_blocking() {}
     // Releases all resources that were allocated in prepare()/send().
     // Further send() calls are illegal after calling close().
     // It must be okay to call this multiple times. Subsequent calls should
@@ -64,6 +64,7 @@
 
 #include "vec/core/block.h"
 #include "vec/exec/join/vhash_join_node.h"
+#include "vec/exec/join/vmerge_join_node.h"
 #include "vec/exec/vaggregation_node.h"
 #include "vec/exec/ves_http_scan_node.h"
 #include "vec/exec/vcross_join_node.h"
@@ -77,6 +78,8 @@
 #include "vec/exec/vexcept_node.h"
 #include "vec/exec/vanalytic_eval_node.h"
 #include "vec/exec/vassert_num_rows_node.h"
+#include "vec/exec/vrepeat_node.h"
+#include "vec/exec/vtable_function_node.h"
 #include "vec/exprs/vexpr.h"
 #include "vec/exec/vempty_set_node.h"
 #include "vec/exec/vschema_scan_node.h"
@@ -376,6 +379,7 @@ Status ExecNode::create_node(RuntimeState* state, ObjectPool* pool, const TPlanN
         case TPlanNodeType::AGGREGATION_NODE:
         case TPlanNodeType::UNION_NODE:
         case TPlanNodeType::CROSS_JOIN_NODE:
+        case TPlanNodeType::MERGE_JOIN_NODE:
         case TPlanNodeType::SORT_NODE:
         case TPlanNodeType::EXCHANGE_NODE:
         case TPlanNodeType::ODBC_SCAN_NODE:
@@ -386,6 +390,8 @@ Status ExecNode::create_node(RuntimeState* state, ObjectPool* pool, const TPlanN
         case TPlanNodeType::EMPTY_SET_NODE:
         case TPlanNodeType::SCHEMA_SCAN_NODE:
         case TPlanNodeType::ANALYTIC_EVAL_NODE:
+        case TPlanNodeType::REPEAT_NODE:
+        case TPlanNodeType::TABLE_FUNCTION_NODE:
             break;
         default: {
             const auto& i = _TPlanNodeType_VALUES_TO_NAMES.find(tnode.node_type);
@@ -481,7 +487,11 @@ Status ExecNode::create_node(RuntimeState* state, ObjectPool* pool, const TPlanN
         return Status::OK();
 
     case TPlanNodeType::MERGE_JOIN_NODE:
-        *node = pool->add(new MergeJoinNode(pool, tnode, descs));
+        if (state->enable_vectorized_exec()) {
+            *node = pool->add(new vectorized::VMergeJoinNode(pool, tnode, descs));
+        } else {
+            *node = pool->add(new MergeJoinNode(pool, tnode, descs));
+        }
         return Status::OK();
 
     case TPlanNodeType::EMPTY_SET_NODE:
@@ -561,7 +571,20 @@ Status ExecNode::create_node(RuntimeState* state, ObjectPool* pool, const TPlanN
         return Status::OK();
 
     case TPlanNodeType::REPEAT_NODE:
-        *node = pool->add(new RepeatNode(pool, tnode, descs));
+        if (state->enable_vectorized_exec()) {
+            *node = pool->add(new vectorized::VRepeatNode(pool, tnode, descs));
+        } else {
+            *node = pool->add(new RepeatNode(pool, tnode, descs));
+        }
+        return Status::OK();
+
+    case TPlanNodeType::TABLE_FUNCTION_NODE:
+        if (state->enable_vectorized_exec()) {
+            *node = pool->add(new vectorized::VTableFunctionNode(pool, tnode, descs));
+        } else {
+            error_msg << "Table function node is only supported by the vectorized engine";
+            return Status::InternalError(error_msg.str());
+        }
         return Status::OK();
 
     case TPlanNodeType::ASSERT_NUM_ROWS_NODE:
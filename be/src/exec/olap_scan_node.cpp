@@ -37,6 +37,7 @@
 #include "runtime/tuple_row.h"
 #include "util/priority_thread_pool.hpp"
 #include "util/runtime_profile.h"
+#include "util/time.h"
 
 namespace doris {
 
@@ -214,8 +215,15 @@ Status OlapScanNode::open(RuntimeState* state) {
 
     // acquire runtime filter
     _runtime_filter_ctxs.resize(_runtime_filter_descs.size());
+    _runtime_filter_wait_start_ms = MonotonicMillis();
+    return acquire_runtime_filters(state, _wait_runtime_filters_in_open);
+}
 
+Status OlapScanNode::acquire_runtime_filters(RuntimeState* state, bool wait) {
     for (size_t i = 0; i < _runtime_filter_descs.size(); ++i) {
+        if (_runtime_filter_ctxs[i].apply_mark) {
+            continue;
+        }
         auto& filter_desc = _runtime_filter_descs[i];
         IRuntimeFilter* runtime_filter = nullptr;
         state->runtime_filter_mgr()->get_consume_filter(filter_desc.filter_id, &runtime_filter);
@@ -224,7 +232,7 @@ Status OlapScanNode::open(RuntimeState* state) {
             continue;
         }
         bool ready = runtime_filter->is_ready();
-        if (!ready) {
+        if (!ready && wait) {
             ready = runtime_filter->await();
         }
         if (ready) {
@@ -247,6 +255,25 @@ Status OlapScanNode::open(RuntimeState* state) {
     return Status::OK();
 }
 
+bool OlapScanNode::runtime_filters_ready_or_timeout() const {
+    if (MonotonicMillis() - _runtime_filter_wait_start_ms >=
+        _runtime_state->runtime_filter_wait_time_ms()) {
+        return true;
+    }
+    for (size_t i = 0; i < _runtime_filter_descs.size(); ++i) {
+        if (_runtime_filter_ctxs[i].apply_mark) {
+            continue;
+        }
+        IRuntimeFilter* runtime_filter = nullptr;
+        _runtime_state->runtime_filter_mgr()->get_consume_filter(
+                _runtime_filter_descs[i].filter_id, &runtime_filter);
+        if (runtime_filter != nullptr && !runtime_filter->is_ready()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 Status OlapScanNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) {
     RETURN_IF_ERROR(exec_debug_action(TExecNodePhase::GETNEXT));
     SCOPED_TIMER(_runtime_profile->total_time_counter());
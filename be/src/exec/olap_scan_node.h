@@ -61,6 +61,13 @@ public:
     virtual Status set_scan_ranges(const std::vector<TScanRangeParams>& scan_ranges);
     inline void set_no_agg_finalize() { _need_agg_finalize = false; }
 
+    // If false, open() doesn't wait for the runtime filters which are not ready, they are
+    // applied if they are ready when the scan starts. Used by the pipeline engine, which
+    // checks runtime_filters_ready_or_timeout() instead of waiting in a worker thread.
+    void set_wait_runtime_filters_in_open(bool wait) { _wait_runtime_filters_in_open = wait; }
+    // True if every runtime filter is ready, or the wait time of them has passed since open().
+    bool runtime_filters_ready_or_timeout() const;
+
 protected:
     typedef struct {
         Tuple* tuple;
@@ -104,6 +111,9 @@ protected:
     void remove_pushed_conjuncts(RuntimeState* state);
 
     Status start_scan(RuntimeState* state);
+    // Apply the runtime filters which are ready and not applied yet, waits for the others
+    // at most the wait time of the runtime filters if 'wait' is true.
+    Status acquire_runtime_filters(RuntimeState* state, bool wait);
 
     void eval_const_conjuncts();
     Status normalize_conjuncts();
@@ -273,6 +283,8 @@ protected:
     std::vector<TRuntimeFilterDesc> _runtime_filter_descs;
     std::vector<RuntimeFilterContext> _runtime_filter_ctxs;
     std::map<int, RuntimeFilterContext*> _conjunctid_to_runtime_filter_ctxs;
+    bool _wait_runtime_filters_in_open = true;
+    int64_t _runtime_filter_wait_start_ms = 0;
 
     std::unique_ptr<RuntimeProfile> _scanner_profile;
     std::unique_ptr<RuntimeProfile> _segment_profile;
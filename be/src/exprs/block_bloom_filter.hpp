@@ -64,12 +64,21 @@ public:
     // Same as above with convenience of hashing the key.
     bool find(const Slice& key) const noexcept {
         if (key.data) {
-            return find(HashUtil::murmur_hash3_32(key.data, key.size, _hash_seed));
+            return find(hash(key));
         } else {
             return false;
         }
     }
 
+    // The hash of a key used by insert(const Slice&) and find(const Slice&).
+    uint32_t hash(const Slice& key) const noexcept {
+        return HashUtil::murmur_hash3_32(key.data, key.size, _hash_seed);
+    }
+
+    // Sets results[i] to find(hashes[i]). The buckets of the following hashes are prefetched
+    // while probing, so it's faster than calling find() in a loop for a large filter.
+    void find_batch(const uint32_t* hashes, size_t num, uint8_t* results) const noexcept;
+
     // Computes the logical OR of this filter with 'other' and stores the result in this
     // filter.
     // Notes:
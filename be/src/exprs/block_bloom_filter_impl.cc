@@ -169,6 +169,28 @@ bool BlockBloomFilter::find(const uint32_t hash) const noexcept {
 #endif
 }
 
+void BlockBloomFilter::find_batch(const uint32_t* __restrict hashes, size_t num,
+                                  uint8_t* __restrict results) const noexcept {
+    if (_always_false) {
+        memset(results, 0, num);
+        return;
+    }
+    // Far enough to hide the latency of a cache miss of a random bucket.
+    constexpr size_t PREFETCH_DISTANCE = 16;
+    for (size_t i = 0; i < num; ++i) {
+        if (i + PREFETCH_DISTANCE < num) {
+            __builtin_prefetch(
+                    &_directory[rehash32to32(hashes[i + PREFETCH_DISTANCE]) & _directory_mask]);
+        }
+        const uint32_t bucket_idx = rehash32to32(hashes[i]) & _directory_mask;
+#ifdef __AVX2__
+        results[i] = bucket_find_avx2(bucket_idx, hashes[i]);
+#else
+        results[i] = bucket_find(bucket_idx, hashes[i]);
+#endif
+    }
+}
+
 void BlockBloomFilter::or_equal_array_internal(size_t n, const uint8_t* __restrict__ in,
                                                uint8_t* __restrict__ out) {
 #ifdef __AVX2__
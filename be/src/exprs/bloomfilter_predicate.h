@@ -31,6 +31,11 @@
 #include "olap/uint24.h"
 #include "runtime/mem_tracker.h"
 #include "runtime/raw_value.h"
+#include "util/binary_cast.hpp"
+#include "vec/columns/column.h"
+#include "vec/columns/column_string.h"
+#include "vec/common/assert_cast.h"
+#include "vec/runtime/vdatetime_value.h"
 
 namespace doris {
 namespace detail {
@@ -67,6 +72,14 @@ public:
 
     void add_bytes(const char* data, size_t len) { _bloom_filter->insert(Slice(data, len)); }
 
+    uint32_t hash_bytes(const char* data, size_t len) const {
+        return _bloom_filter->hash(Slice(data, len));
+    }
+
+    void test_hashes(const uint32_t* hashes, size_t num, uint8_t* results) const {
+        _bloom_filter->find_batch(hashes, num, results);
+    }
+
 private:
     std::shared_ptr<doris::BlockBloomFilter> _bloom_filter;
 };
@@ -83,6 +96,11 @@ public:
     virtual void insert(const void* data) = 0;
     virtual bool find(const void* data) const = 0;
     virtual bool find_olap_engine(const void* data) const = 0;
+    // Tests all rows of a vectorized column of the filter's type. results[i] is set to 1 if
+    // row i may be in the filter, and 0 if it's not or null_map[i] is set. null_map may be
+    // nullptr.
+    virtual void find_batch(const vectorized::IColumn& column, const uint8_t* null_map,
+                            uint8_t* results) const = 0;
 
     virtual Status merge(IBloomFilterFuncBase* bloomfilter_func) = 0;
     virtual Status assign(const char* data, int len) = 0;
@@ -315,6 +333,81 @@ public:
         return dummy.find_olap_engine(*this->_bloom_filter, data);
     }
 
+    void find_batch(const vectorized::IColumn& column, const uint8_t* null_map,
+                    uint8_t* results) const override {
+        DCHECK(this->_bloom_filter != nullptr);
+        const size_t rows = column.size();
+        uint32_t hashes[HASH_BATCH_SIZE];
+        for (size_t start = 0; start < rows; start += HASH_BATCH_SIZE) {
+            size_t num = std::min(HASH_BATCH_SIZE, rows - start);
+            hash_rows(column, start, num, hashes);
+            this->_bloom_filter->test_hashes(hashes, num, results + start);
+        }
+        if (null_map != nullptr) {
+            for (size_t i = 0; i < rows; ++i) {
+                results[i] &= !null_map[i];
+            }
+        }
+    }
+
+    // Hashes the rows [start, start + num) of a vectorized column. The values are hashed in
+    // the format they are inserted by the hash join, see IRuntimeFilter::insert(StringRef).
+    void hash_rows(const vectorized::IColumn& column, size_t start, size_t num,
+                   uint32_t* hashes) const {
+        if constexpr (type == TYPE_DATE || type == TYPE_DATETIME) {
+            const auto* data =
+                    reinterpret_cast<const vectorized::Int64*>(column.get_raw_data().data);
+            for (size_t i = 0; i < num; ++i) {
+                DateTimeValue value;
+                binary_cast<vectorized::Int64, vectorized::VecDateTimeValue>(data[start + i])
+                        .convert_vec_dt_to_dt(&value);
+                hashes[i] = this->_bloom_filter->hash_bytes((const char*)&value, sizeof(value));
+            }
+        } else if constexpr (type == TYPE_CHAR || type == TYPE_VARCHAR || type == TYPE_STRING) {
+            const auto& strings = assert_cast<const vectorized::ColumnString&>(column);
+            for (size_t i = 0; i < num; ++i) {
+                StringRef value = strings.get_data_at(start + i);
+                if constexpr (type == TYPE_CHAR) {
+                    // the padding zeros are not hashed, same as FixedStringFindOp
+                    while (value.size > 0 && value.data[value.size - 1] == '\0') {
+                        --value.size;
+                    }
+                }
+                hashes[i] = this->_bloom_filter->hash_bytes(value.data, value.size);
+            }
+        } else {
+            using T = typename PrimitiveTypeTraits<type>::CppType;
+            const char* data = column.get_raw_data().data;
+            for (size_t i = 0; i < num; ++i) {
+                hashes[i] = this->_bloom_filter->hash_bytes(data + (start + i) * sizeof(T),
+                                                            sizeof(T));
+            }
+        }
+    }
+
+    // Same as hash_rows() for the cells of a storage column block, only for the types whose
+    // cells are stored in the same format as they are hashed.
+    static constexpr bool is_olap_cell_hashable =
+            type != TYPE_CHAR && type != TYPE_DATE && type != TYPE_DATETIME &&
+            type != TYPE_DECIMALV2;
+
+    uint32_t hash_olap_cell(const void* cell) const {
+        static_assert(is_olap_cell_hashable);
+        if constexpr (type == TYPE_VARCHAR || type == TYPE_STRING) {
+            const auto* value = reinterpret_cast<const StringValue*>(cell);
+            return this->_bloom_filter->hash_bytes(value->ptr, value->len);
+        } else {
+            using T = typename PrimitiveTypeTraits<type>::CppType;
+            return this->_bloom_filter->hash_bytes((const char*)cell, sizeof(T));
+        }
+    }
+
+    void test_hashes(const uint32_t* hashes, size_t num, uint8_t* results) const {
+        this->_bloom_filter->test_hashes(hashes, num, results);
+    }
+
+    static constexpr size_t HASH_BATCH_SIZE = 1024;
+
 private:
     typename BloomFilterTypeTraits<type, BloomFilterAdaptor>::FindOp dummy;
 };
@@ -328,7 +421,7 @@ public:
     virtual Expr* clone(ObjectPool* pool) const override {
         return pool->add(new BloomFilterPredicate(*this));
     }
-    Status prepare(RuntimeState* state, IBloomFilterFuncBase* bloomfilterfunc);
+    Status prepare(RuntimeState* state, const std::shared_ptr<IBloomFilterFuncBase>& bloomfilterfunc);
 
     std::shared_ptr<IBloomFilterFuncBase> get_bloom_filter_func() { return _filter; }
 
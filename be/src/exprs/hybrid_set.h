@@ -20,7 +20,12 @@
 
 #include <parallel_hashmap/phmap.h>
 
+#include <algorithm>
 #include <cstring>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 #include "common/object_pool.h"
 #include "common/status.h"
@@ -28,9 +33,26 @@
 #include "runtime/decimalv2_value.h"
 #include "runtime/primitive_type.h"
 #include "runtime/string_value.h"
+#include "util/binary_cast.hpp"
+#include "vec/columns/column.h"
+#include "vec/columns/column_string.h"
+#include "vec/common/assert_cast.h"
+#include "vec/runtime/vdatetime_value.h"
 
 namespace doris {
 
+// Sets of the values of IN predicates and IN runtime filters.
+//
+// Besides the hash set, the values are kept in the layout which is the fastest to probe for
+// the number of values and, for integers, for their range:
+// - sets of up to FIXED_CONTAINER_SIZE values are probed by comparing with all of them, in a
+//   loop of fixed length that the compiler vectorizes;
+// - larger sets of integers with a dense range are probed in a bitmap;
+// - other sets are probed in the open addressing hash set.
+// The layouts are maintained by insert(), so a set probed by several threads needs no
+// preparation after it is built.
+static constexpr size_t FIXED_CONTAINER_SIZE = 16;
+
 class HybridSetBase {
 public:
     HybridSetBase() = default;
@@ -45,6 +67,11 @@ public:
     virtual bool find(void* data) = 0;
     // use in vectorize execute engine
     virtual bool find(void* data, size_t) = 0;
+    // Tests all rows of a vectorized column of the set's type. results[i] is set to 1 if
+    // row i is in the set, and 0 if it's not or null_map[i] is set. null_map may be nullptr.
+    virtual void find_batch(const vectorized::IColumn& column, const uint8_t* null_map,
+                            uint8_t* results) = 0;
+
     class IteratorBase {
     public:
         IteratorBase() {}
@@ -59,6 +86,13 @@ public:
 
 template <class T>
 class HybridSet : public HybridSetBase {
+    // Integers up to 64 bits are kept in a bitmap when their range is dense.
+    static constexpr bool use_bitmap = std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+                                       sizeof(T) <= sizeof(int64_t);
+    // The bitmap is kept if it takes no more bits per value than this.
+    static constexpr uint64_t DENSE_BITS_PER_VALUE = 32;
+    static constexpr uint64_t MAX_BITMAP_BITS = 1ULL << 24;
+
 public:
     HybridSet() = default;
 
@@ -67,31 +101,69 @@ public:
     void insert(const void* data) override {
         if (data == nullptr) return;
 
+        T value;
         if (sizeof(T) >= 16) {
             // for largeint, it will core dump with no memcpy
-            T value;
             memcpy(&value, data, sizeof(T));
-            _set.insert(value);
         } else {
-            _set.insert(*reinterpret_cast<const T*>(data));
+            value = *reinterpret_cast<const T*>(data);
         }
+        _insert_value(value);
     }
     void insert(void* data, size_t) override { insert(data); }
 
     void insert(HybridSetBase* set) override {
         HybridSet<T>* hybrid_set = reinterpret_cast<HybridSet<T>*>(set);
-        _set.insert(hybrid_set->_set.begin(), hybrid_set->_set.end());
+        for (const auto& value : hybrid_set->_set) {
+            _insert_value(value);
+        }
     }
 
     int size() override { return _set.size(); }
 
     bool find(void* data) override {
-        auto it = _set.find(*reinterpret_cast<T*>(data));
-        return !(it == _set.end());
+        if (sizeof(T) >= 16) {
+            T value;
+            memcpy(&value, data, sizeof(T));
+            return _find_value(value);
+        }
+        return _find_value(*reinterpret_cast<T*>(data));
     }
 
     bool find(void* data, size_t) override { return find(data); }
 
+    void find_batch(const vectorized::IColumn& column, const uint8_t* null_map,
+                    uint8_t* results) override {
+        const size_t rows = column.size();
+        if constexpr (std::is_same_v<T, DateTimeValue>) {
+            // DATE and DATETIME columns are VecDateTimeValue, see IRuntimeFilter::insert()
+            const auto* data =
+                    reinterpret_cast<const vectorized::Int64*>(column.get_raw_data().data);
+            for (size_t i = 0; i < rows; ++i) {
+                DateTimeValue value;
+                binary_cast<vectorized::Int64, vectorized::VecDateTimeValue>(data[i])
+                        .convert_vec_dt_to_dt(&value);
+                results[i] = _find_value(value);
+            }
+        } else {
+            const T* data = reinterpret_cast<const T*>(column.get_raw_data().data);
+            if (_set.empty()) {
+                memset(results, 0, rows);
+            } else if (_set.size() <= FIXED_CONTAINER_SIZE) {
+                for (size_t i = 0; i < rows; ++i) {
+                    results[i] = _find_fixed(data[i]);
+                }
+            } else {
+                _find_batch_large(data, rows, results);
+            }
+        }
+        if (null_map != nullptr) {
+            for (size_t i = 0; i < rows; ++i) {
+                results[i] &= !null_map[i];
+            }
+        }
+    }
+
     template <class _iT>
     class Iterator : public IteratorBase {
     public:
@@ -113,7 +185,107 @@ public:
     }
 
 private:
+    void _insert_value(const T& value) {
+        if (!_set.insert(value).second) {
+            return;
+        }
+        size_t size = _set.size();
+        if (size == 1) {
+            // the unused slots repeat the first value, so they can be compared too
+            std::fill(_fixed_values, _fixed_values + FIXED_CONTAINER_SIZE, value);
+        } else if (size <= FIXED_CONTAINER_SIZE) {
+            _fixed_values[size - 1] = value;
+        }
+        if constexpr (use_bitmap) {
+            auto v = static_cast<int64_t>(value);
+            if (size == 1) {
+                _min = _max = v;
+            } else {
+                _min = std::min(_min, v);
+                _max = std::max(_max, v);
+            }
+            if (!_bitmap.empty() && _bitmap_offset(value) < _bitmap.size() * 64) {
+                uint64_t offset = _bitmap_offset(value);
+                _bitmap[offset / 64] |= 1ULL << (offset % 64);
+            } else if (size > FIXED_CONTAINER_SIZE) {
+                _rebuild_bitmap();
+            }
+        }
+    }
+
+    bool _find_value(const T& value) const {
+        if (_set.size() <= FIXED_CONTAINER_SIZE) {
+            return !_set.empty() && _find_fixed(value);
+        }
+        if constexpr (use_bitmap) {
+            if (!_bitmap.empty()) {
+                return _test_bitmap(value);
+            }
+        }
+        return _set.find(value) != _set.end();
+    }
+
+    void _find_batch_large(const T* data, size_t rows, uint8_t* results) const {
+        if constexpr (use_bitmap) {
+            if (!_bitmap.empty()) {
+                for (size_t i = 0; i < rows; ++i) {
+                    results[i] = _test_bitmap(data[i]);
+                }
+                return;
+            }
+        }
+        for (size_t i = 0; i < rows; ++i) {
+            results[i] = _set.find(data[i]) != _set.end();
+        }
+    }
+
+    bool _find_fixed(const T& value) const {
+        bool found = false;
+        for (size_t i = 0; i < FIXED_CONTAINER_SIZE; ++i) {
+            found |= _fixed_values[i] == value;
+        }
+        return found;
+    }
+
+    // Wraps around for the values below _bitmap_min, which makes them out of range too.
+    uint64_t _bitmap_offset(const T& value) const {
+        return static_cast<uint64_t>(static_cast<int64_t>(value)) -
+               static_cast<uint64_t>(_bitmap_min);
+    }
+
+    bool _test_bitmap(const T& value) const {
+        uint64_t offset = _bitmap_offset(value);
+        return offset < _bitmap.size() * 64 && (_bitmap[offset / 64] >> (offset % 64)) & 1;
+    }
+
+    // Called when a value doesn't fit in the bitmap. The new bitmap leaves room on both sides
+    // of the range, so a range growing value by value is rebuilt only O(log n) times.
+    void _rebuild_bitmap() {
+        _bitmap.clear();
+        uint64_t span = static_cast<uint64_t>(_max) - static_cast<uint64_t>(_min) + 1;
+        if (span == 0 || span > MAX_BITMAP_BITS || span > _set.size() * DENSE_BITS_PER_VALUE) {
+            return;
+        }
+        uint64_t bits = (std::min(span * 2, MAX_BITMAP_BITS) + 63) / 64 * 64;
+        __int128 bitmap_min = static_cast<__int128>(_min) - (bits - span) / 2;
+        _bitmap_min = static_cast<int64_t>(
+                std::max(bitmap_min, static_cast<__int128>(std::numeric_limits<T>::min())));
+        _bitmap.resize(bits / 64);
+        for (const auto& value : _set) {
+            uint64_t offset = _bitmap_offset(value);
+            _bitmap[offset / 64] |= 1ULL << (offset % 64);
+        }
+    }
+
     phmap::flat_hash_set<T> _set;
+    // the first FIXED_CONTAINER_SIZE values
+    T _fixed_values[FIXED_CONTAINER_SIZE];
+    // range of the values and the bitmap of [_bitmap_min, _bitmap_min + _bitmap.size() * 64),
+    // the bitmap is empty if the range is too sparse or the set is small
+    int64_t _min = 0;
+    int64_t _max = 0;
+    int64_t _bitmap_min = 0;
+    std::vector<uint64_t> _bitmap;
     ObjectPool _pool;
 };
 
@@ -127,33 +299,50 @@ public:
         if (data == nullptr) return;
 
         const auto* value = reinterpret_cast<const StringValue*>(data);
-        std::string str_value(value->ptr, value->len);
-        _set.insert(str_value);
+        _insert_value(std::string_view(value->ptr, value->len));
     }
     void insert(void* data, size_t size) override {
-        std::string str_value(reinterpret_cast<char*>(data), size);
-        _set.insert(str_value);
+        _insert_value(std::string_view(reinterpret_cast<char*>(data), size));
     }
 
     void insert(HybridSetBase* set) override {
         StringValueSet* string_set = reinterpret_cast<StringValueSet*>(set);
-        _set.insert(string_set->_set.begin(), string_set->_set.end());
+        for (const auto& value : string_set->_set) {
+            _insert_value(value);
+        }
     }
 
     int size() override { return _set.size(); }
 
     bool find(void* data) override {
         auto* value = reinterpret_cast<StringValue*>(data);
-        std::string_view str_value(const_cast<const char*>(value->ptr), value->len);
-        auto it = _set.find(str_value);
-
-        return !(it == _set.end());
+        return _find_value(std::string_view(const_cast<const char*>(value->ptr), value->len));
     }
 
     bool find(void* data, size_t size) override {
-        std::string str_value(reinterpret_cast<char*>(data), size);
-        auto it = _set.find(str_value);
-        return !(it == _set.end());
+        return _find_value(std::string_view(reinterpret_cast<char*>(data), size));
+    }
+
+    void find_batch(const vectorized::IColumn& column, const uint8_t* null_map,
+                    uint8_t* results) override {
+        const auto& strings = assert_cast<const vectorized::ColumnString&>(column);
+        const size_t rows = strings.size();
+        if (_set.size() <= FIXED_CONTAINER_SIZE) {
+            for (size_t i = 0; i < rows; ++i) {
+                StringRef value = strings.get_data_at(i);
+                results[i] = _find_fixed(std::string_view(value.data, value.size));
+            }
+        } else {
+            for (size_t i = 0; i < rows; ++i) {
+                StringRef value = strings.get_data_at(i);
+                results[i] = _set.find(std::string_view(value.data, value.size)) != _set.end();
+            }
+        }
+        if (null_map != nullptr) {
+            for (size_t i = 0; i < rows; ++i) {
+                results[i] &= !null_map[i];
+            }
+        }
     }
 
     class Iterator : public IteratorBase {
@@ -181,7 +370,32 @@ public:
     }
 
 private:
+    void _insert_value(std::string_view value) {
+        if (_set.emplace(value).second && _set.size() <= FIXED_CONTAINER_SIZE) {
+            _fixed_values.emplace_back(value);
+        }
+    }
+
+    bool _find_value(std::string_view value) const {
+        if (_set.size() <= FIXED_CONTAINER_SIZE) {
+            return _find_fixed(value);
+        }
+        return _set.find(value) != _set.end();
+    }
+
+    // Most of the values are rejected by the length, without hashing them.
+    bool _find_fixed(std::string_view value) const {
+        for (const auto& fixed_value : _fixed_values) {
+            if (fixed_value == value) {
+                return true;
+            }
+        }
+        return false;
+    }
+
     phmap::flat_hash_set<std::string> _set;
+    // the first FIXED_CONTAINER_SIZE values
+    std::vector<std::string> _fixed_values;
     ObjectPool _pool;
 };
 
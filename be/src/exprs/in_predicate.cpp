@@ -36,11 +36,11 @@ InPredicate::InPredicate(const TExprNode& node)
 
 InPredicate::~InPredicate() {}
 
-Status InPredicate::prepare(RuntimeState* state, HybridSetBase* hset) {
+Status InPredicate::prepare(RuntimeState* state, const std::shared_ptr<HybridSetBase>& hset) {
     if (_is_prepare) {
         return Status::OK();
     }
-    _hybrid_set.reset(hset);
+    _hybrid_set = hset;
     if (nullptr == _hybrid_set) {
         return Status::InternalError("Unknown column type.");
     }
@@ -38,7 +38,7 @@ public:
         return pool->add(new InPredicate(*this));
     }
 
-    Status prepare(RuntimeState* state, HybridSetBase* hset);
+    Status prepare(RuntimeState* state, const std::shared_ptr<HybridSetBase>& hset);
     Status open(RuntimeState* state, ExprContext* context,
                 FunctionContext::FunctionStateScope scope);
     virtual Status prepare(RuntimeState* state, const RowDescriptor& row_desc,
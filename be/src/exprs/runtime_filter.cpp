@@ -34,12 +34,18 @@
 #include "exprs/predicate.h"
 #include "gen_cpp/internal_service.pb.h"
 #include "gen_cpp/types.pb.h"
+#include "pipeline/task_scheduler.h"
 #include "runtime/runtime_filter_mgr.h"
 #include "runtime/runtime_state.h"
 #include "runtime/type_limit.h"
 #include "util/defer_op.h"
 #include "util/runtime_profile.h"
 #include "util/string_parser.hpp"
+#include "vec/exprs/vbloom_predicate.h"
+#include "vec/exprs/vdirect_in_predicate.h"
+#include "vec/exprs/vectorized_fn_call.h"
+#include "vec/exprs/vexpr_context.h"
+#include "vec/exprs/vliteral.h"
 
 namespace doris {
 // PrimitiveType->TExprNodeType
@@ -204,8 +210,8 @@ TTypeDesc create_type_desc(PrimitiveType type) {
 }
 
 // only used to push down to olap engine
-Expr* create_literal(ObjectPool* pool, PrimitiveType type, const void* data) {
-    TExprNode node;
+bool create_literal_node(PrimitiveType type, const void* data, TExprNode* literal) {
+    TExprNode& node = *literal;
 
     switch (type) {
     case TYPE_BOOLEAN: {
@@ -283,13 +289,49 @@ Expr* create_literal(ObjectPool* pool, PrimitiveType type, const void* data) {
     }
     default:
         DCHECK(false);
-        return nullptr;
+        return false;
     }
     node.__set_node_type(get_expr_node_type(type));
     node.__set_type(create_type_desc(type));
+    node.__set_is_nullable(false);
+    return true;
+}
+
+Expr* create_literal(ObjectPool* pool, PrimitiveType type, const void* data) {
+    TExprNode node;
+    if (!create_literal_node(type, data, &node)) {
+        return nullptr;
+    }
     return pool->add(new Literal(node));
 }
 
+vectorized::VExpr* create_vliteral(ObjectPool* pool, PrimitiveType type, const void* data) {
+    TExprNode node;
+    if (!create_literal_node(type, data, &node)) {
+        return nullptr;
+    }
+    return pool->add(new vectorized::VLiteral(node));
+}
+
+// The node of a vectorized predicate of runtime filter, e.g. "le" for the max value of
+// minmax filter.
+TExprNode create_vpredicate_node(TExprNodeType::type node_type, const std::string& fn_name,
+                                 bool is_nullable) {
+    TExprNode node;
+    node.__set_type(create_type_desc(TYPE_BOOLEAN));
+    node.__set_node_type(node_type);
+    node.__set_num_children(node_type == TExprNodeType::BINARY_PRED ? 2 : 1);
+    node.__set_is_nullable(is_nullable);
+    if (!fn_name.empty()) {
+        TFunctionName name;
+        name.__set_function_name(fn_name);
+        TFunction fn;
+        fn.__set_name(name);
+        node.__set_fn(fn);
+    }
+    return node;
+}
+
 BinaryPredicate* create_bin_predicate(ObjectPool* pool, PrimitiveType prim_type,
                                       TExprOpcode::type opcode) {
     TExprNode node;
@@ -410,7 +452,7 @@ public:
             node.__isset.vector_opcode = true;
             node.__set_vector_opcode(to_in_opcode(_column_return_type));
             auto in_pred = _pool->add(new InPredicate(node));
-            RETURN_IF_ERROR(in_pred->prepare(state, _hybrid_set.release()));
+            RETURN_IF_ERROR(in_pred->prepare(state, _hybrid_set));
             in_pred->add_child(Expr::copy(_pool, prob_expr->root()));
             ExprContext* ctx = _pool->add(new ExprContext(in_pred));
             container->push_back(ctx);
@@ -441,7 +483,7 @@ public:
             node.__isset.vector_opcode = true;
             node.__set_vector_opcode(to_in_opcode(_column_return_type));
             auto bloom_pred = _pool->add(new BloomFilterPredicate(node));
-            RETURN_IF_ERROR(bloom_pred->prepare(state, _bloomfilter_func.release()));
+            RETURN_IF_ERROR(bloom_pred->prepare(state, _bloomfilter_func));
             bloom_pred->add_child(Expr::copy(_pool, prob_expr->root()));
             ExprContext* ctx = _pool->add(new ExprContext(bloom_pred));
             container->push_back(ctx);
@@ -454,6 +496,65 @@ public:
         return Status::OK();
     }
 
+    // Same as get_push_context, but creates vectorized exprs. Each expr has its own probe
+    // expr tree created from probe_expr.
+    Status get_push_vexpr_context(std::vector<vectorized::VExprContext*>* container,
+                                  const TExpr& probe_expr) {
+        DCHECK(container != nullptr);
+        DCHECK(_pool != nullptr);
+        auto create_probe = [&](vectorized::VExpr** probe) -> Status {
+            vectorized::VExprContext* probe_ctx = nullptr;
+            RETURN_IF_ERROR(vectorized::VExpr::create_expr_tree(_pool, probe_expr, &probe_ctx));
+            DCHECK(probe_ctx->root()->type().type == _column_return_type);
+            *probe = probe_ctx->root();
+            return Status::OK();
+        };
+
+        switch (_filter_type) {
+        case RuntimeFilterType::IN_FILTER: {
+            vectorized::VExpr* probe = nullptr;
+            RETURN_IF_ERROR(create_probe(&probe));
+            auto in_pred = _pool->add(new vectorized::VDirectInPredicate(
+                    create_vpredicate_node(TExprNodeType::IN_PRED, "", false), _hybrid_set));
+            in_pred->add_child(probe);
+            container->push_back(_pool->add(new vectorized::VExprContext(in_pred)));
+            break;
+        }
+        case RuntimeFilterType::MINMAX_FILTER: {
+            std::pair<const char*, void*> bounds[] = {{"le", _minmax_func->get_max()},
+                                                      {"ge", _minmax_func->get_min()}};
+            for (auto& [fn_name, value] : bounds) {
+                vectorized::VExpr* probe = nullptr;
+                RETURN_IF_ERROR(create_probe(&probe));
+                auto literal = create_vliteral(_pool, _column_return_type, value);
+                if (literal == nullptr) {
+                    return Status::InternalError("Unknown column type.");
+                }
+                auto pred = _pool->add(new vectorized::VectorizedFnCall(create_vpredicate_node(
+                        TExprNodeType::BINARY_PRED, fn_name, probe->is_nullable())));
+                pred->add_child(probe);
+                pred->add_child(literal);
+                container->push_back(_pool->add(new vectorized::VExprContext(pred)));
+            }
+            break;
+        }
+        case RuntimeFilterType::BLOOM_FILTER: {
+            vectorized::VExpr* probe = nullptr;
+            RETURN_IF_ERROR(create_probe(&probe));
+            auto bloom_pred = _pool->add(new vectorized::VBloomPredicate(
+                    create_vpredicate_node(TExprNodeType::BLOOM_PRED, "", false),
+                    _bloomfilter_func));
+            bloom_pred->add_child(probe);
+            container->push_back(_pool->add(new vectorized::VExprContext(bloom_pred)));
+            break;
+        }
+        default:
+            DCHECK(false);
+            break;
+        }
+        return Status::OK();
+    }
+
     Status merge(const RuntimePredicateWrapper* wrapper) {
         DCHECK(_filter_type == wrapper->_filter_type);
         if (_filter_type != wrapper->_filter_type) {
@@ -625,8 +726,9 @@ private:
     PrimitiveType _column_return_type; // column type
     RuntimeFilterType _filter_type;
     std::unique_ptr<MinMaxFuncBase> _minmax_func;
-    std::unique_ptr<HybridSetBase> _hybrid_set;
-    std::unique_ptr<IBloomFilterFuncBase> _bloomfilter_func;
+    // shared with the predicates created by get_push_context and get_push_vexprs
+    std::shared_ptr<HybridSetBase> _hybrid_set;
+    std::shared_ptr<IBloomFilterFuncBase> _bloomfilter_func;
 };
 
 Status IRuntimeFilter::create(RuntimeState* state, MemTracker* tracker, ObjectPool* pool,
@@ -703,6 +805,32 @@ Status IRuntimeFilter::get_prepared_context(std::vector<ExprContext*>* push_expr
     return Expr::open(_push_down_ctxs, _state);
 }
 
+Status IRuntimeFilter::get_push_vexpr_ctxs(
+        std::vector<vectorized::VExprContext*>* push_vexpr_ctxs) {
+    DCHECK(is_consumer());
+    if (!_is_ignored) {
+        return _wrapper->get_push_vexpr_context(push_vexpr_ctxs, _probe_expr);
+    }
+    return Status::OK();
+}
+
+Status IRuntimeFilter::get_prepared_vexpr_ctxs(
+        std::vector<vectorized::VExprContext*>* push_vexpr_ctxs, const RowDescriptor& desc,
+        const std::shared_ptr<MemTracker>& tracker) {
+    DCHECK(_is_ready);
+    DCHECK(is_consumer());
+    std::lock_guard<std::mutex> guard(_inner_mutex);
+
+    if (_push_down_vexpr_ctxs.empty()) {
+        RETURN_IF_ERROR(_wrapper->get_push_vexpr_context(&_push_down_vexpr_ctxs, _probe_expr));
+        RETURN_IF_ERROR(vectorized::VExpr::prepare(_push_down_vexpr_ctxs, _state, desc, tracker));
+        RETURN_IF_ERROR(vectorized::VExpr::open(_push_down_vexpr_ctxs, _state));
+    }
+    push_vexpr_ctxs->insert(push_vexpr_ctxs->end(), _push_down_vexpr_ctxs.begin(),
+                            _push_down_vexpr_ctxs.end());
+    return Status::OK();
+}
+
 bool IRuntimeFilter::await() {
     DCHECK(is_consumer());
     SCOPED_TIMER(_await_time_cost);
@@ -719,6 +847,8 @@ void IRuntimeFilter::signal() {
     DCHECK(is_consumer());
     _is_ready = true;
     _inner_cv.notify_all();
+    // the scan of a pipeline task waits for the filter without blocking the thread
+    pipeline::wake_up_blocked_tasks();
     _effect_timer.reset();
 }
 
@@ -760,6 +890,7 @@ Status IRuntimeFilter::init_with_desc(const TRuntimeFilterDesc* desc, int node_i
             return Status::InternalError("not found a node id");
         }
         RETURN_IF_ERROR(Expr::create_expr_tree(_pool, iter->second, &_probe_ctx));
+        _probe_expr = iter->second;
     }
 
     _wrapper = _pool->add(new RuntimePredicateWrapper(_state, _mem_tracker, _pool, &params));
@@ -943,6 +1074,7 @@ Status IRuntimeFilter::update_filter(const UpdateRuntimeFilterParams* param) {
 Status IRuntimeFilter::consumer_close() {
     DCHECK(is_consumer());
     Expr::close(_push_down_ctxs, _state);
+    vectorized::VExpr::close(_push_down_vexpr_ctxs, _state);
     return Status::OK();
 }
 
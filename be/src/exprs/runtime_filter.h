@@ -45,6 +45,10 @@ class PMinMaxFilter;
 class HashJoinNode;
 class RuntimeProfile;
 
+namespace vectorized {
+class VExprContext;
+} // namespace vectorized
+
 enum class RuntimeFilterType {
     UNKNOWN_FILTER = -1,
     IN_FILTER = 0,
@@ -145,6 +149,17 @@ public:
                                 const RowDescriptor& desc,
                                 const std::shared_ptr<MemTracker>& tracker);
 
+    // Creates the vectorized exprs of the filter, in the same order as the contexts of
+    // get_push_expr_ctxs. The contexts are not prepared.
+    // only consumer could call this
+    Status get_push_vexpr_ctxs(std::vector<vectorized::VExprContext*>* push_vexpr_ctxs);
+
+    // Same as get_prepared_context, for the vectorized engine.
+    // This function can be called multiple times
+    Status get_prepared_vexpr_ctxs(std::vector<vectorized::VExprContext*>* push_vexpr_ctxs,
+                                   const RowDescriptor& desc,
+                                   const std::shared_ptr<MemTracker>& tracker);
+
     bool is_broadcast_join() const { return _is_broadcast_join; }
 
     bool has_remote_target() const { return _has_remote_target; }
@@ -246,6 +261,8 @@ protected:
     // it only used in consumer to generate runtime_filter expr_context
     // we don't have to prepare it or close it
     ExprContext* _probe_ctx;
+    // the probe expr, used to create the vectorized probe expr trees
+    TExpr _probe_expr;
 
     // Indicate whether runtime filter expr has been ignored
     bool _is_ignored;
@@ -255,6 +272,8 @@ protected:
     // these context is called prepared by this,
     // consumer_close should be called before release
     std::vector<ExprContext*> _push_down_ctxs;
+    // same as _push_down_ctxs, for the vectorized engine
+    std::vector<vectorized::VExprContext*> _push_down_vexpr_ctxs;
 
     struct rpc_context;
     std::shared_ptr<rpc_context> _rpc_context;
@@ -79,6 +79,32 @@ void BloomFilterColumnPredicate<type>::evaluate(VectorizedRowBatch* batch) const
 template <PrimitiveType type>
 void BloomFilterColumnPredicate<type>::evaluate(ColumnBlock* block, uint16_t* sel,
                                                 uint16_t* size) const {
+    if constexpr (SpecificFilter::is_olap_cell_hashable) {
+        // Hash the selected cells first and probe the filter in batches, so the cache misses
+        // of the probes are overlapped.
+        constexpr size_t batch_size = SpecificFilter::HASH_BATCH_SIZE;
+        uint32_t hashes[batch_size];
+        uint8_t found[batch_size];
+        uint16_t new_size = 0;
+        for (size_t start = 0; start < *size; start += batch_size) {
+            size_t num = std::min<size_t>(batch_size, *size - start);
+            for (size_t i = 0; i < num; ++i) {
+                auto cell = block->cell(sel[start + i]);
+                // the content of a null cell may be garbage
+                hashes[i] = block->is_nullable() && cell.is_null()
+                                    ? 0
+                                    : _specific_filter->hash_olap_cell(cell.cell_ptr());
+            }
+            _specific_filter->test_hashes(hashes, num, found);
+            for (size_t i = 0; i < num; ++i) {
+                uint16_t idx = sel[start + i];
+                sel[new_size] = idx;
+                new_size += found[i] && !(block->is_nullable() && block->cell(idx).is_null());
+            }
+        }
+        *size = new_size;
+        return;
+    }
     uint16_t new_size = 0;
     if (block->is_nullable()) {
         for (uint16_t i = 0; i < *size; ++i) {
@@ -0,0 +1,395 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/clock_cache.h"
+
+#include <stdlib.h>
+
+#include <algorithm>
+
+#include "util/doris_metrics.h"
+
+namespace doris {
+
+extern MetricPrototype METRIC_capacity;
+extern MetricPrototype METRIC_usage;
+extern MetricPrototype METRIC_usage_ratio;
+extern MetricPrototype METRIC_lookup_count;
+extern MetricPrototype METRIC_hit_count;
+extern MetricPrototype METRIC_hit_ratio;
+
+ClockCache::ClockCache(LRUCacheType type, size_t capacity, size_t estimated_entry_charge)
+        : _type(type), _capacity(capacity) {
+    size_t num_entries = capacity;
+    if (type == LRUCacheType::SIZE) {
+        num_entries = capacity / std::max<size_t>(estimated_entry_charge, 1);
+    }
+    // Keep the load factor of table below 0.75 to make probe sequences short.
+    size_t length = 16;
+    while (length < num_entries * 3 / 2) {
+        length *= 2;
+    }
+    _table.reset(new ClockHandle[length]);
+    _table_mask = length - 1;
+    _max_occupancy = length * 3 / 4;
+}
+
+ClockCache::~ClockCache() {
+    prune();
+}
+
+bool ClockCache::_try_ref(ClockHandle* h) {
+    uint64_t meta = h->meta.load(std::memory_order_relaxed);
+    while (meta & VISIBLE) {
+        if (h->meta.compare_exchange_weak(meta, (meta + 1) | CLOCK_BIT,
+                                          std::memory_order_acq_rel,
+                                          std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ClockCache::_unref(ClockHandle* h) {
+    uint64_t old_meta = h->meta.fetch_sub(1, std::memory_order_acq_rel);
+    DCHECK((old_meta & REFS_MASK) > 0);
+    // Nobody could take a reference of an invisible entry, so the one who
+    // releases the last reference owns it.
+    if ((old_meta & REFS_MASK) == 1 && !(old_meta & VISIBLE)) {
+        _free_entry(h);
+    }
+}
+
+Cache::Handle* ClockCache::lookup(const CacheKey& key, uint32_t hash) {
+    _lookup_count.fetch_add(1, std::memory_order_relaxed);
+    size_t index = hash & _table_mask;
+    for (size_t probe = 0; probe <= _table_mask; ++probe) {
+        ClockHandle* h = &_table[index];
+        if (h->hash.load(std::memory_order_relaxed) == hash && _try_ref(h)) {
+            // The slot may be reused by another entry before we take the reference,
+            // so check the key again.
+            if (h->hash.load(std::memory_order_relaxed) == hash && h->key() == key) {
+                _hit_count.fetch_add(1, std::memory_order_relaxed);
+                return reinterpret_cast<Cache::Handle*>(h);
+            }
+            _unref(h);
+        }
+        if (h->displacements.load(std::memory_order_acquire) == 0) {
+            break;
+        }
+        index = (index + 1) & _table_mask;
+    }
+    return nullptr;
+}
+
+void ClockCache::release(Cache::Handle* handle) {
+    if (handle == nullptr) {
+        return;
+    }
+    _unref(reinterpret_cast<ClockHandle*>(handle));
+}
+
+ClockHandle* ClockCache::_find_visible(const CacheKey& key, uint32_t hash) {
+    size_t index = hash & _table_mask;
+    for (size_t probe = 0; probe <= _table_mask; ++probe) {
+        ClockHandle* h = &_table[index];
+        // Only writers could make an entry invisible, so a visible entry won't
+        // change while we hold _mutex.
+        if ((h->meta.load(std::memory_order_acquire) & VISIBLE) &&
+            h->hash.load(std::memory_order_relaxed) == hash && h->key() == key) {
+            return h;
+        }
+        if (h->displacements.load(std::memory_order_acquire) == 0) {
+            break;
+        }
+        index = (index + 1) & _table_mask;
+    }
+    return nullptr;
+}
+
+void ClockCache::_remove_from_cache(ClockHandle* h) {
+    uint64_t old_meta = h->meta.fetch_and(~VISIBLE, std::memory_order_acq_rel);
+    DCHECK(old_meta & VISIBLE);
+    if ((old_meta & REFS_MASK) == 0) {
+        _free_entry(h);
+    }
+}
+
+bool ClockCache::_try_evict(ClockHandle* h) {
+    uint64_t meta = h->meta.load(std::memory_order_acquire);
+    if (!(meta & VISIBLE) || (meta & REFS_MASK) != 0) {
+        return false;
+    }
+    if (meta & CLOCK_BIT) {
+        // give it a second chance
+        h->meta.fetch_and(~CLOCK_BIT, std::memory_order_relaxed);
+        return false;
+    }
+    // fail if the entry is referenced by a concurrent lookup
+    if (!h->meta.compare_exchange_strong(meta, meta & ~VISIBLE, std::memory_order_acq_rel,
+                                         std::memory_order_relaxed)) {
+        return false;
+    }
+    _free_entry(h);
+    return true;
+}
+
+bool ClockCache::_evict_one() {
+    // The first two rounds only evict normal entries, the first round clears
+    // the reference bits, and the second round evicts the ones not hit since then.
+    size_t table_size = _table_mask + 1;
+    for (size_t step = 0; step < 3 * table_size; ++step) {
+        ClockHandle* h = &_table[_clock_hand];
+        _clock_hand = (_clock_hand + 1) & _table_mask;
+        if (h->priority == CachePriority::DURABLE && step < 2 * table_size) {
+            // priority is only changed when slot is empty, so it's safe to read it here
+            if (h->meta.load(std::memory_order_acquire) & VISIBLE) {
+                continue;
+            }
+        }
+        if (_try_evict(h)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ClockCache::_free_entry(ClockHandle* h) {
+    (*h->deleter)(h->key(), h->value);
+    ::free(h->key_data);
+    h->key_data = nullptr;
+    _usage.fetch_sub(h->total_size, std::memory_order_relaxed);
+    if (h->detached) {
+        delete h;
+        return;
+    }
+    // undo the displacements of the probe sequence
+    size_t index = h - _table.get();
+    for (size_t i = h->hash.load(std::memory_order_relaxed) & _table_mask; i != index;
+         i = (i + 1) & _table_mask) {
+        _table[i].displacements.fetch_sub(1, std::memory_order_relaxed);
+    }
+    _occupancy.fetch_sub(1, std::memory_order_relaxed);
+    h->meta.store(0, std::memory_order_release);
+}
+
+Cache::Handle* ClockCache::insert(const CacheKey& key, uint32_t hash, void* value, size_t charge,
+                                  void (*deleter)(const CacheKey& key, void* value),
+                                  CachePriority priority) {
+    char* key_data = reinterpret_cast<char*>(malloc(key.size()));
+    memcpy(key_data, key.data(), key.size());
+    size_t total_size = (_type == LRUCacheType::SIZE ? key.size() + charge : 1);
+
+    MutexLock l(&_mutex);
+    ClockHandle* old = _find_visible(key, hash);
+    if (old != nullptr) {
+        _remove_from_cache(old);
+    }
+
+    // Free the space following CLOCK policy until enough space is freed or no
+    // entry could be evicted. Note that the cache might get larger than its capacity.
+    while (_usage.load(std::memory_order_relaxed) + total_size > _capacity ||
+           _occupancy.load(std::memory_order_relaxed) >= _max_occupancy) {
+        if (!_evict_one()) {
+            break;
+        }
+    }
+
+    // find an empty slot along the probe sequence
+    size_t start = hash & _table_mask;
+    size_t index = start;
+    ClockHandle* h = nullptr;
+    for (size_t probe = 0; probe <= _table_mask; ++probe) {
+        if (_table[index].meta.load(std::memory_order_acquire) == 0) {
+            h = &_table[index];
+            break;
+        }
+        index = (index + 1) & _table_mask;
+    }
+
+    uint64_t meta = OCCUPIED | 1; // one reference for the returned handle
+    if (h == nullptr) {
+        // all the slots are referenced by others, don't cache this entry
+        h = new ClockHandle();
+        h->detached = true;
+    } else {
+        for (size_t i = start; i != index; i = (i + 1) & _table_mask) {
+            _table[i].displacements.fetch_add(1, std::memory_order_relaxed);
+        }
+        _occupancy.fetch_add(1, std::memory_order_relaxed);
+        meta |= VISIBLE;
+    }
+    h->hash.store(hash, std::memory_order_relaxed);
+    h->value = value;
+    h->deleter = deleter;
+    h->key_data = key_data;
+    h->key_length = key.size();
+    h->charge = charge;
+    h->total_size = total_size;
+    h->priority = priority;
+    _usage.fetch_add(total_size, std::memory_order_relaxed);
+    // publish the entry
+    h->meta.store(meta, std::memory_order_release);
+    return reinterpret_cast<Cache::Handle*>(h);
+}
+
+void ClockCache::erase(const CacheKey& key, uint32_t hash) {
+    MutexLock l(&_mutex);
+    ClockHandle* h = _find_visible(key, hash);
+    if (h != nullptr) {
+        _remove_from_cache(h);
+    }
+}
+
+int64_t ClockCache::prune() {
+    return prune_if([](const void*) { return true; });
+}
+
+int64_t ClockCache::prune_if(CacheValuePredicate pred) {
+    MutexLock l(&_mutex);
+    int64_t pruned_count = 0;
+    for (size_t i = 0; i <= _table_mask; ++i) {
+        ClockHandle* h = &_table[i];
+        uint64_t meta = h->meta.load(std::memory_order_acquire);
+        if (!(meta & VISIBLE) || (meta & REFS_MASK) != 0 || !pred(h->value)) {
+            continue;
+        }
+        if (h->meta.compare_exchange_strong(meta, meta & ~VISIBLE, std::memory_order_acq_rel,
+                                            std::memory_order_relaxed)) {
+            _free_entry(h);
+            ++pruned_count;
+        }
+    }
+    return pruned_count;
+}
+
+ShardedClockCache::ShardedClockCache(const std::string& name, size_t total_capacity,
+                                     LRUCacheType type, uint32_t num_shards,
+                                     std::shared_ptr<MemTracker> parent,
+                                     size_t estimated_entry_charge)
+        : _name(name),
+          _last_id(1),
+          _mem_tracker(MemTracker::CreateTracker(-1, name, parent, true, false,
+                                                 MemTrackerLevel::OVERVIEW)) {
+    while ((1U << _num_shard_bits) < num_shards && _num_shard_bits < 16) {
+        ++_num_shard_bits;
+    }
+    num_shards = 1U << _num_shard_bits;
+    const size_t per_shard = (total_capacity + (num_shards - 1)) / num_shards;
+    for (uint32_t s = 0; s < num_shards; s++) {
+        _shards.push_back(new ClockCache(type, per_shard, estimated_entry_charge));
+    }
+
+    _entity = DorisMetrics::instance()->metric_registry()->register_entity(
+            std::string("lru_cache:") + name,
+            {{"name", name}, {"policy", lru_cache_policy_name(LRUCachePolicy::CLOCK)}});
+    _entity->register_hook(name, std::bind(&ShardedClockCache::update_cache_metrics, this));
+    INT_GAUGE_METRIC_REGISTER(_entity, capacity);
+    INT_GAUGE_METRIC_REGISTER(_entity, usage);
+    INT_DOUBLE_METRIC_REGISTER(_entity, usage_ratio);
+    INT_ATOMIC_COUNTER_METRIC_REGISTER(_entity, lookup_count);
+    INT_ATOMIC_COUNTER_METRIC_REGISTER(_entity, hit_count);
+    INT_DOUBLE_METRIC_REGISTER(_entity, hit_ratio);
+}
+
+ShardedClockCache::~ShardedClockCache() {
+    for (auto shard : _shards) {
+        delete shard;
+    }
+    _entity->deregister_hook(_name);
+    DorisMetrics::instance()->metric_registry()->deregister_entity(_entity);
+    _mem_tracker->Release(_mem_tracker->consumption());
+}
+
+Cache::Handle* ShardedClockCache::insert(const CacheKey& key, void* value, size_t charge,
+                                         void (*deleter)(const CacheKey& key, void* value),
+                                         CachePriority priority) {
+    const uint32_t hash = _hash_slice(key);
+    return _shards[_shard(hash)]->insert(key, hash, value, charge, deleter, priority);
+}
+
+Cache::Handle* ShardedClockCache::lookup(const CacheKey& key) {
+    const uint32_t hash = _hash_slice(key);
+    return _shards[_shard(hash)]->lookup(key, hash);
+}
+
+void ShardedClockCache::release(Handle* handle) {
+    if (handle == nullptr) {
+        return;
+    }
+    ClockHandle* h = reinterpret_cast<ClockHandle*>(handle);
+    _shards[_shard(h->hash.load(std::memory_order_relaxed))]->release(handle);
+}
+
+void ShardedClockCache::erase(const CacheKey& key) {
+    const uint32_t hash = _hash_slice(key);
+    _shards[_shard(hash)]->erase(key, hash);
+}
+
+void* ShardedClockCache::value(Handle* handle) {
+    return reinterpret_cast<ClockHandle*>(handle)->value;
+}
+
+Slice ShardedClockCache::value_slice(Handle* handle) {
+    auto clock_handle = reinterpret_cast<ClockHandle*>(handle);
+    return Slice((char*)clock_handle->value, clock_handle->charge);
+}
+
+uint64_t ShardedClockCache::new_id() {
+    return _last_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+int64_t ShardedClockCache::prune() {
+    int64_t num_prune = 0;
+    for (auto shard : _shards) {
+        num_prune += shard->prune();
+    }
+    return num_prune;
+}
+
+int64_t ShardedClockCache::prune_if(CacheValuePredicate pred) {
+    int64_t num_prune = 0;
+    for (auto shard : _shards) {
+        num_prune += shard->prune_if(pred);
+    }
+    return num_prune;
+}
+
+void ShardedClockCache::update_cache_metrics() const {
+    size_t total_capacity = 0;
+    size_t total_usage = 0;
+    size_t total_lookup_count = 0;
+    size_t total_hit_count = 0;
+    for (auto shard : _shards) {
+        total_capacity += shard->get_capacity();
+        total_usage += shard->get_usage();
+        total_lookup_count += shard->get_lookup_count();
+        total_hit_count += shard->get_hit_count();
+    }
+
+    capacity->set_value(total_capacity);
+    usage->set_value(total_usage);
+    lookup_count->set_value(total_lookup_count);
+    hit_count->set_value(total_hit_count);
+    usage_ratio->set_value(total_capacity == 0 ? 0 : ((double)total_usage / total_capacity));
+    hit_ratio->set_value(total_lookup_count == 0 ? 0
+                                                 : ((double)total_hit_count / total_lookup_count));
+
+    _mem_tracker->Consume(total_usage - _mem_tracker->consumption());
+}
+
+} // namespace doris
@@ -0,0 +1,175 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "olap/lru_cache.h"
+
+namespace doris {
+
+// A slot of ClockCache's hash table. Slots are allocated when the cache is
+// created, and reused by different entries during the lifetime of the cache.
+struct ClockHandle {
+    // State bits and the number of external references, see ClockCache.
+    std::atomic<uint64_t> meta {0};
+    // Number of entries whose probe sequence passes through this slot.
+    // Lookup stops probing when it reaches a slot with no displacements.
+    std::atomic<uint32_t> displacements {0};
+    std::atomic<uint32_t> hash {0};
+    void* value = nullptr;
+    void (*deleter)(const CacheKey& key, void* value) = nullptr;
+    char* key_data = nullptr;
+    size_t key_length = 0;
+    size_t charge = 0;
+    size_t total_size = 0;
+    CachePriority priority = CachePriority::NORMAL;
+    // True if the entry is not placed in the table because all slots are
+    // referenced. It is freed when the handle is released.
+    bool detached = false;
+
+    CacheKey key() const { return CacheKey(key_data, key_length); }
+};
+
+// A single shard of the read-mostly cache, using CLOCK eviction.
+//
+// Entries live in a fixed size open addressing table, so a slot is never
+// freed while the cache is alive. lookup() and release() don't take any lock:
+// a lookup probes the table and takes a reference with a CAS on the slot's meta
+// word, which also sets the CLOCK reference bit. The reference pins the slot, so
+// the key can be compared safely after the reference is taken.
+// insert(), erase() and eviction are serialized by _mutex. An entry which is
+// erased or replaced while referenced becomes invisible, and is freed by whoever
+// releases the last reference.
+class ClockCache {
+public:
+    // Bits of ClockHandle::meta.
+    static constexpr uint64_t REFS_MASK = (1ULL << 32) - 1;
+    // Entry is in cache and can be found by lookup.
+    static constexpr uint64_t VISIBLE = 1ULL << 32;
+    // Slot holds an entry, maybe invisible.
+    static constexpr uint64_t OCCUPIED = 1ULL << 33;
+    // Entry was hit since the clock hand passed it last time.
+    static constexpr uint64_t CLOCK_BIT = 1ULL << 34;
+
+    // The table is sized for capacity / estimated_entry_charge entries when the
+    // capacity is in bytes. Entries are evicted when the table is almost full
+    // even if the capacity is not reached.
+    ClockCache(LRUCacheType type, size_t capacity, size_t estimated_entry_charge);
+    ~ClockCache();
+
+    // Like Cache methods, but with an extra "hash" parameter.
+    Cache::Handle* insert(const CacheKey& key, uint32_t hash, void* value, size_t charge,
+                          void (*deleter)(const CacheKey& key, void* value),
+                          CachePriority priority = CachePriority::NORMAL);
+    Cache::Handle* lookup(const CacheKey& key, uint32_t hash);
+    void release(Cache::Handle* handle);
+    void erase(const CacheKey& key, uint32_t hash);
+    int64_t prune();
+    int64_t prune_if(CacheValuePredicate pred);
+
+    uint64_t get_lookup_count() const { return _lookup_count.load(std::memory_order_relaxed); }
+    uint64_t get_hit_count() const { return _hit_count.load(std::memory_order_relaxed); }
+    size_t get_usage() const { return _usage.load(std::memory_order_relaxed); }
+    size_t get_capacity() const { return _capacity; }
+    size_t get_table_size() const { return _table_mask + 1; }
+
+private:
+    // Take a reference of a visible entry, return false if entry is not visible.
+    bool _try_ref(ClockHandle* h);
+    void _unref(ClockHandle* h);
+    // Writer only, return the visible entry of key.
+    ClockHandle* _find_visible(const CacheKey& key, uint32_t hash);
+    // Writer only, make a visible entry invisible and free it if it's not referenced.
+    void _remove_from_cache(ClockHandle* h);
+    // Writer only, try to evict an unreferenced and visible entry.
+    bool _try_evict(ClockHandle* h);
+    // Writer only, move the clock hand until an entry is evicted.
+    bool _evict_one();
+    // Free an invisible entry which has no reference, and make the slot empty.
+    void _free_entry(ClockHandle* h);
+
+private:
+    LRUCacheType _type;
+    size_t _capacity;
+
+    std::unique_ptr<ClockHandle[]> _table;
+    size_t _table_mask = 0;
+    // Evict entries when the number of occupied slots reaches this.
+    size_t _max_occupancy = 0;
+
+    // _mutex serializes insert, erase and eviction.
+    Mutex _mutex;
+    size_t _clock_hand = 0;
+
+    std::atomic<size_t> _usage {0};
+    std::atomic<size_t> _occupancy {0};
+    std::atomic<uint64_t> _lookup_count {0};
+    std::atomic<uint64_t> _hit_count {0};
+};
+
+// A read-mostly cache with configurable number of ClockCache shards.
+class ShardedClockCache : public Cache {
+public:
+    // num_shards is rounded up to power of 2.
+    ShardedClockCache(const std::string& name, size_t total_capacity, LRUCacheType type,
+                      uint32_t num_shards, std::shared_ptr<MemTracker> parent,
+                      size_t estimated_entry_charge = 8192);
+    ~ShardedClockCache() override;
+
+    Handle* insert(const CacheKey& key, void* value, size_t charge,
+                   void (*deleter)(const CacheKey& key, void* value),
+                   CachePriority priority = CachePriority::NORMAL) override;
+    Handle* lookup(const CacheKey& key) override;
+    void release(Handle* handle) override;
+    void erase(const CacheKey& key) override;
+    void* value(Handle* handle) override;
+    Slice value_slice(Handle* handle) override;
+    uint64_t new_id() override;
+    int64_t prune() override;
+    int64_t prune_if(CacheValuePredicate pred) override;
+
+    uint32_t num_shards() const { return _shards.size(); }
+
+private:
+    void update_cache_metrics() const;
+
+    static inline uint32_t _hash_slice(const CacheKey& s) { return s.hash(s.data(), s.size(), 0); }
+    uint32_t _shard(uint32_t hash) const {
+        return _num_shard_bits == 0 ? 0 : hash >> (32 - _num_shard_bits);
+    }
+
+    std::string _name;
+    int _num_shard_bits = 0;
+    std::vector<ClockCache*> _shards;
+    std::atomic<uint64_t> _last_id;
+
+    std::shared_ptr<MemTracker> _mem_tracker;
+    std::shared_ptr<MetricEntity> _entity = nullptr;
+    IntGauge* capacity = nullptr;
+    IntGauge* usage = nullptr;
+    DoubleGauge* usage_ratio = nullptr;
+    IntAtomicCounter* lookup_count = nullptr;
+    IntAtomicCounter* hit_count = nullptr;
+    DoubleGauge* hit_ratio = nullptr;
+};
+
+} // namespace doris
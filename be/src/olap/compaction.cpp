@@ -120,7 +120,7 @@ OLAPStatus Compaction::do_compaction_impl(int64_t permits) {
     TRACE("check correctness finished");
 
     // 4. modify rowsets in memory
-    modify_rowsets();
+    RETURN_NOT_OK(modify_rowsets());
     TRACE("modify rowsets finished");
 
     // 5. update last success compaction time
@@ -161,6 +161,7 @@ OLAPStatus Compaction::construct_output_rowset_writer() {
     }
     context.rowset_path_prefix = _tablet->tablet_path();
     context.tablet_schema = &(_tablet->tablet_schema());
+    context.enable_unique_key_merge_on_write = _tablet->enable_unique_key_merge_on_write();
     context.rowset_state = VISIBLE;
     context.version = _output_version;
     context.version_hash = _output_version_hash;
@@ -184,13 +185,21 @@ OLAPStatus Compaction::construct_input_rowset_readers() {
     return OLAP_SUCCESS;
 }
 
-void Compaction::modify_rowsets() {
+OLAPStatus Compaction::modify_rowsets() {
     std::vector<RowsetSharedPtr> output_rowsets;
     output_rowsets.push_back(_output_rowset);
 
+    // rows of output rowset may be replaced by the rowsets published during compaction,
+    // they are looked up before taking the header lock
+    Tablet::PendingDeleteBitmap pending_delete_bitmap;
+    RETURN_NOT_OK(_tablet->calc_delete_bitmap_without_lock(_output_rowset, false,
+                                                           &pending_delete_bitmap));
     WriteLock wrlock(_tablet->get_header_lock_ptr());
+    RETURN_NOT_OK(_tablet->update_delete_bitmap_unlocked(_output_rowset, false,
+                                                         &pending_delete_bitmap));
     _tablet->modify_rowsets(output_rowsets, _input_rowsets);
     _tablet->save_meta();
+    return OLAP_SUCCESS;
 }
 
 void Compaction::gc_output_rowset() {
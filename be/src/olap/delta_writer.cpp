@@ -136,6 +136,7 @@ OLAPStatus DeltaWriter::init() {
     }
     writer_context.rowset_path_prefix = _tablet->tablet_path();
     writer_context.tablet_schema = &(_tablet->tablet_schema());
+    writer_context.enable_unique_key_merge_on_write = _tablet->enable_unique_key_merge_on_write();
     writer_context.rowset_state = PREPARED;
     writer_context.txn_id = _req.txn_id;
     writer_context.load_id = _req.load_id;
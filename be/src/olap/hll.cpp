@@ -79,6 +79,16 @@ void HyperLogLog::update(uint64_t hash_value) {
     }
 }
 
+void HyperLogLog::update_batch(const uint64_t* hash_values, size_t num) {
+    size_t i = 0;
+    for (; i < num && _type != HLL_DATA_SPARSE && _type != HLL_DATA_FULL; ++i) {
+        update(hash_values[i]);
+    }
+    for (; i < num; ++i) {
+        _update_registers(hash_values[i]);
+    }
+}
+
 void HyperLogLog::merge(const HyperLogLog& other) {
     // fast path
     if (other._type == HLL_DATA_EMPTY) {
@@ -418,7 +428,8 @@ int64_t HyperLogLog::estimate_cardinality() const {
     int num_zero_registers = 0;
 
     for (int i = 0; i < HLL_REGISTERS_COUNT; ++i) {
-        harmonic_mean += powf(2.0f, -_registers[i]);
+        // the same as powf(2.0f, -_registers[i]), registers are at most HLL_ZERO_COUNT_BITS + 1
+        harmonic_mean += 1.0f / static_cast<float>(1ULL << _registers[i]);
 
         if (_registers[i] == 0) {
             ++num_zero_registers;
@@ -18,6 +18,10 @@
 #ifndef DORIS_BE_SRC_OLAP_HLL_H
 #define DORIS_BE_SRC_OLAP_HLL_H
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #include <map>
 #include <math.h>
 #include <stdio.h>
@@ -112,6 +116,10 @@ public:
     // NOTE: input must be a hash_value
     void update(uint64_t hash_value);
 
+    // Add hash values to this HLL value, the same as calling update() for each of them.
+    // Once the registers are used, the values are put into the registers in a tight loop.
+    void update_batch(const uint64_t* hash_values, size_t num);
+
     void merge(const HyperLogLog& other);
 
     // Return max size of serialized binary
@@ -199,7 +207,16 @@ private:
 
     // absorb other registers into this registers
     void _merge_registers(const uint8_t* other) {
-        for (int i = 0; i < HLL_REGISTERS_COUNT; ++i) {
+        int i = 0;
+#ifdef __SSE2__
+        for (; i + 16 <= HLL_REGISTERS_COUNT; i += 16) {
+            __m128i registers = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_registers + i));
+            __m128i other_registers = _mm_loadu_si128(reinterpret_cast<const __m128i*>(other + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(_registers + i),
+                             _mm_max_epu8(registers, other_registers));
+        }
+#endif
+        for (; i < HLL_REGISTERS_COUNT; ++i) {
             _registers[i] = _registers[i] < other[i] ? other[i] : _registers[i];
         }
     }
@@ -17,7 +17,9 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
+#include <roaring/roaring.hh>
 
 #include "common/status.h"
 #include "olap/olap_common.h"
@@ -78,6 +80,9 @@ public:
     // to unify Conditions and ColumnPredicate
     std::vector<ColumnPredicate*> column_predicates;
 
+    // segment id -> rows replaced by later loads, only for merge-on-write unique key tablet
+    std::map<uint32_t, std::shared_ptr<roaring::Roaring>> delete_bitmap;
+
     // REQUIRED (null is not allowed)
     OlapReaderStatistics* stats = nullptr;
     bool use_page_cache = false;
@@ -8,9 +8,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <algorithm>
+#include <boost/algorithm/string.hpp>
 #include <sstream>
 #include <string>
 
+#include "common/config.h"
+#include "olap/clock_cache.h"
 #include "olap/olap_common.h"
 #include "olap/olap_define.h"
 #include "olap/olap_index.h"
@@ -29,6 +33,36 @@ DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(usage_ratio, MetricUnit::NOUNIT);
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(lookup_count, MetricUnit::OPERATIONS);
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(hit_count, MetricUnit::OPERATIONS);
 DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(hit_ratio, MetricUnit::NOUNIT);
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(protected_usage, MetricUnit::BYTES);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(admission_reject_count, MetricUnit::OPERATIONS);
+
+LRUCachePolicy parse_lru_cache_policy(const std::string& name) {
+    std::string upper_name = boost::to_upper_copy(name);
+    if (upper_name == "LRU") {
+        return LRUCachePolicy::LRU;
+    } else if (upper_name == "SLRU") {
+        return LRUCachePolicy::SEGMENTED_LRU;
+    } else if (upper_name == "TINYLFU") {
+        return LRUCachePolicy::TINY_LFU;
+    } else if (upper_name == "CLOCK") {
+        return LRUCachePolicy::CLOCK;
+    }
+    LOG(WARNING) << "unknown lru cache policy: " << name << ", use LRU instead";
+    return LRUCachePolicy::LRU;
+}
+
+const char* lru_cache_policy_name(LRUCachePolicy policy) {
+    switch (policy) {
+    case LRUCachePolicy::SEGMENTED_LRU:
+        return "SLRU";
+    case LRUCachePolicy::TINY_LFU:
+        return "TINYLFU";
+    case LRUCachePolicy::CLOCK:
+        return "CLOCK";
+    default:
+        return "LRU";
+    }
+}
 
 uint32_t CacheKey::hash(const char* data, size_t n, uint32_t seed) const {
     // Similar to murmur hash
@@ -175,10 +209,78 @@ void HandleTable::_resize() {
     _length = new_length;
 }
 
-LRUCache::LRUCache(LRUCacheType type) : _type(type) {
+static const uint64_t SKETCH_SEEDS[] = {0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL,
+                                         0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL};
+
+void FrequencySketch::resize(size_t num_entries) {
+    size_t length = 16;
+    while (length < num_entries) {
+        length *= 2;
+    }
+    _table.assign(length, 0);
+    _table_mask = length - 1;
+    _sample_size = 10 * length;
+    _additions = 0;
+}
+
+size_t FrequencySketch::_index_of(uint32_t hash, int i) const {
+    uint64_t h = (hash + SKETCH_SEEDS[i]) * SKETCH_SEEDS[i];
+    h += (h >> 32);
+    return h & _table_mask;
+}
+
+bool FrequencySketch::_increment_at(size_t index, int counter) {
+    int offset = counter << 2;
+    uint64_t mask = 0xfULL << offset;
+    if ((_table[index] & mask) != mask) {
+        _table[index] += (1ULL << offset);
+        return true;
+    }
+    return false;
+}
+
+void FrequencySketch::increment(uint32_t hash) {
+    if (_table.empty()) {
+        return;
+    }
+    // Each hash uses 4 counters in different table elements, and the counters
+    // are chosen from the 16 counters of an element by the low bits of hash.
+    int start = (hash & 3) << 2;
+    bool added = false;
+    for (int i = 0; i < 4; ++i) {
+        added |= _increment_at(_index_of(hash, i), start + i);
+    }
+    if (added && ++_additions >= _sample_size) {
+        _reset();
+    }
+}
+
+uint32_t FrequencySketch::frequency(uint32_t hash) const {
+    if (_table.empty()) {
+        return 0;
+    }
+    int start = (hash & 3) << 2;
+    uint32_t freq = 15;
+    for (int i = 0; i < 4; ++i) {
+        uint32_t count = (_table[_index_of(hash, i)] >> ((start + i) << 2)) & 0xfULL;
+        freq = std::min(freq, count);
+    }
+    return freq;
+}
+
+void FrequencySketch::_reset() {
+    for (auto& value : _table) {
+        value = (value >> 1) & 0x7777777777777777ULL;
+    }
+    _additions /= 2;
+}
+
+LRUCache::LRUCache(LRUCacheType type, LRUCachePolicy policy) : _type(type), _policy(policy) {
     // Make empty circular linked list
     _lru_normal.next = &_lru_normal;
     _lru_normal.prev = &_lru_normal;
+    _lru_protected.next = &_lru_protected;
+    _lru_protected.prev = &_lru_protected;
     _lru_durable.next = &_lru_durable;
     _lru_durable.prev = &_lru_durable;
 }
@@ -187,6 +289,21 @@ LRUCache::~LRUCache() {
     prune();
 }
 
+void LRUCache::set_capacity(size_t capacity) {
+    _capacity = capacity;
+    if (_policy == LRUCachePolicy::LRU) {
+        return;
+    }
+    // Most of the space is given to the protected segment, the probationary segment
+    // only needs to be large enough to hold new entries until they are hit again.
+    _protected_capacity = capacity * 4 / 5;
+    if (_policy == LRUCachePolicy::TINY_LFU) {
+        // Capacity of a SIZE cache is in bytes, assume the average entry is a 4KB page.
+        size_t num_entries = _type == LRUCacheType::NUMBER ? capacity : capacity / 4096;
+        _sketch.resize(std::min<size_t>(num_entries, 1 << 18));
+    }
+}
+
 bool LRUCache::_unref(LRUHandle* e) {
     DCHECK(e->refs > 0);
     e->refs--;
@@ -197,6 +314,9 @@ void LRUCache::_lru_remove(LRUHandle* e) {
     e->next->prev = e->prev;
     e->prev->next = e->next;
     e->prev = e->next = nullptr;
+    if (e->in_protected) {
+        _protected_usage -= e->total_size;
+    }
 }
 
 void LRUCache::_lru_append(LRUHandle* list, LRUHandle* e) {
@@ -205,11 +325,43 @@ void LRUCache::_lru_append(LRUHandle* list, LRUHandle* e) {
     e->prev = list->prev;
     e->prev->next = e;
     e->next->prev = e;
+    if (e->in_protected) {
+        _protected_usage += e->total_size;
+    }
+}
+
+void LRUCache::_balance_protected() {
+    while (_protected_usage > _protected_capacity && _lru_protected.next != &_lru_protected) {
+        LRUHandle* old = _lru_protected.next;
+        _lru_remove(old);
+        old->in_protected = false;
+        // demoted entry is the newest one of probationary segment
+        _lru_append(&_lru_normal, old);
+    }
+}
+
+bool LRUCache::_reject_by_admission(LRUHandle* e) {
+    if (_policy != LRUCachePolicy::TINY_LFU || e->priority != CachePriority::NORMAL ||
+        _usage + e->total_size <= _capacity || _lru_normal.next == &_lru_normal) {
+        return false;
+    }
+    if (_table.lookup(e->key(), e->hash) != nullptr) {
+        // always replace the old value of the same key
+        return false;
+    }
+    // The victim is the oldest entry of probationary segment. Candidate should be
+    // strictly more frequent than victim, so entries which are only read once by a
+    // scan won't take the place of others.
+    LRUHandle* victim = _lru_normal.next;
+    return _sketch.frequency(e->hash) <= _sketch.frequency(victim->hash);
 }
 
 Cache::Handle* LRUCache::lookup(const CacheKey& key, uint32_t hash) {
     MutexLock l(&_mutex);
     ++_lookup_count;
+    if (_policy == LRUCachePolicy::TINY_LFU) {
+        _sketch.increment(hash);
+    }
     LRUHandle* e = _table.lookup(key, hash);
     if (e != nullptr) {
         // we get it from _table, so in_cache must be true
@@ -220,6 +372,10 @@ Cache::Handle* LRUCache::lookup(const CacheKey& key, uint32_t hash) {
         }
         e->refs++;
         ++_hit_count;
+        if (_policy != LRUCachePolicy::LRU && e->priority == CachePriority::NORMAL) {
+            // promote to protected segment, it will be put to _lru_protected when released
+            e->in_protected = true;
+        }
     }
     return reinterpret_cast<Cache::Handle*>(e);
 }
@@ -246,7 +402,10 @@ void LRUCache::release(Cache::Handle* handle) {
                 last_ref = true;
             } else {
                 // put it to LRU free list
-                if (e->priority == CachePriority::NORMAL) {
+                if (e->in_protected) {
+                    _lru_append(&_lru_protected, e);
+                    _balance_protected();
+                } else if (e->priority == CachePriority::NORMAL) {
                     _lru_append(&_lru_normal, e);
                 } else if (e->priority == CachePriority::DURABLE) {
                     _lru_append(&_lru_durable, e);
@@ -270,7 +429,15 @@ void LRUCache::_evict_from_lru(size_t total_size, LRUHandle** to_remove_head) {
         old->next = *to_remove_head;
         *to_remove_head = old;
     }
-    // 2. evict durable cache entries if need
+    // 2. evict protected cache entries of segmented LRU if need
+    while (_usage + total_size > _capacity && _lru_protected.next != &_lru_protected) {
+        LRUHandle* old = _lru_protected.next;
+        DCHECK(old->priority == CachePriority::NORMAL);
+        _evict_one_entry(old);
+        old->next = *to_remove_head;
+        *to_remove_head = old;
+    }
+    // 3. evict durable cache entries if need
     while (_usage + total_size > _capacity && _lru_durable.next != &_lru_durable) {
         LRUHandle* old = _lru_durable.next;
         DCHECK(old->priority == CachePriority::DURABLE);
@@ -304,12 +471,23 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
     e->refs = 2; // one for the returned handle, one for LRUCache.
     e->next = e->prev = nullptr;
     e->in_cache = true;
+    e->in_protected = false;
     e->priority = priority;
     memcpy(e->key_data, key.data(), key.size());
     LRUHandle* to_remove_head = nullptr;
     {
         MutexLock l(&_mutex);
 
+        if (_reject_by_admission(e)) {
+            // The entry is only owned by the returned handle, and it will be
+            // freed when the handle is released.
+            e->in_cache = false;
+            e->refs = 1;
+            _usage += e->total_size;
+            ++_admission_reject_count;
+            return reinterpret_cast<Cache::Handle*>(e);
+        }
+
         // Free the space following strict LRU policy until enough space
         // is freed or the lru list is empty
         _evict_from_lru(e->total_size, &to_remove_head);
@@ -377,6 +555,12 @@ int64_t LRUCache::prune() {
             old->next = to_remove_head;
             to_remove_head = old;
         }
+        while (_lru_protected.next != &_lru_protected) {
+            LRUHandle* old = _lru_protected.next;
+            _evict_one_entry(old);
+            old->next = to_remove_head;
+            to_remove_head = old;
+        }
         while (_lru_durable.next != &_lru_durable) {
             LRUHandle* old = _lru_durable.next;
             _evict_one_entry(old);
@@ -409,6 +593,17 @@ int64_t LRUCache::prune_if(CacheValuePredicate pred) {
             p = next;
         }
 
+        p = _lru_protected.next;
+        while (p != &_lru_protected) {
+            LRUHandle* next = p->next;
+            if (pred(p->value)) {
+                _evict_one_entry(p);
+                p->next = to_remove_head;
+                to_remove_head = p;
+            }
+            p = next;
+        }
+
         p = _lru_durable.next;
         while (p != &_lru_durable) {
             LRUHandle* next = p->next;
@@ -439,19 +634,20 @@ uint32_t ShardedLRUCache::_shard(uint32_t hash) {
 }
 
 ShardedLRUCache::ShardedLRUCache(const std::string& name, size_t total_capacity, LRUCacheType type,
-                                 std::shared_ptr<MemTracker> parent)
+                                 std::shared_ptr<MemTracker> parent, LRUCachePolicy policy)
         : _name(name),
           _last_id(1),
           _mem_tracker(MemTracker::CreateTracker(-1, name, parent, true, false,
                                                  MemTrackerLevel::OVERVIEW)) {
     const size_t per_shard = (total_capacity + (kNumShards - 1)) / kNumShards;
     for (int s = 0; s < kNumShards; s++) {
-        _shards[s] = new LRUCache(type);
+        _shards[s] = new LRUCache(type, policy);
         _shards[s]->set_capacity(per_shard);
     }
 
     _entity = DorisMetrics::instance()->metric_registry()->register_entity(
-            std::string("lru_cache:") + name, {{"name", name}});
+            std::string("lru_cache:") + name,
+            {{"name", name}, {"policy", lru_cache_policy_name(policy)}});
     _entity->register_hook(name, std::bind(&ShardedLRUCache::update_cache_metrics, this));
     INT_GAUGE_METRIC_REGISTER(_entity, capacity);
     INT_GAUGE_METRIC_REGISTER(_entity, usage);
@@ -459,6 +655,8 @@ ShardedLRUCache::ShardedLRUCache(const std::string& name, size_t total_capacity,
     INT_ATOMIC_COUNTER_METRIC_REGISTER(_entity, lookup_count);
     INT_ATOMIC_COUNTER_METRIC_REGISTER(_entity, hit_count);
     INT_DOUBLE_METRIC_REGISTER(_entity, hit_ratio);
+    INT_GAUGE_METRIC_REGISTER(_entity, protected_usage);
+    INT_ATOMIC_COUNTER_METRIC_REGISTER(_entity, admission_reject_count);
 }
 
 ShardedLRUCache::~ShardedLRUCache() {
@@ -526,11 +724,15 @@ void ShardedLRUCache::update_cache_metrics() const {
     size_t total_usage = 0;
     size_t total_lookup_count = 0;
     size_t total_hit_count = 0;
+    size_t total_protected_usage = 0;
+    size_t total_admission_reject_count = 0;
     for (int i = 0; i < kNumShards; i++) {
         total_capacity += _shards[i]->get_capacity();
         total_usage += _shards[i]->get_usage();
         total_lookup_count += _shards[i]->get_lookup_count();
         total_hit_count += _shards[i]->get_hit_count();
+        total_protected_usage += _shards[i]->get_protected_usage();
+        total_admission_reject_count += _shards[i]->get_admission_reject_count();
     }
 
     capacity->set_value(total_capacity);
@@ -540,18 +742,24 @@ void ShardedLRUCache::update_cache_metrics() const {
     usage_ratio->set_value(total_capacity == 0 ? 0 : ((double)total_usage / total_capacity));
     hit_ratio->set_value(total_lookup_count == 0 ? 0
                                                  : ((double)total_hit_count / total_lookup_count));
+    protected_usage->set_value(total_protected_usage);
+    admission_reject_count->set_value(total_admission_reject_count);
 
     _mem_tracker->Consume(total_usage - _mem_tracker->consumption());
 }
 
 Cache* new_lru_cache(const std::string& name, size_t capacity,
-                     std::shared_ptr<MemTracker> parent_tracker) {
-    return new ShardedLRUCache(name, capacity, LRUCacheType::SIZE, parent_tracker);
+                     std::shared_ptr<MemTracker> parent_tracker, LRUCachePolicy policy) {
+    return new_typed_lru_cache(name, capacity, LRUCacheType::SIZE, parent_tracker, policy);
 }
 
 Cache* new_typed_lru_cache(const std::string& name, size_t capacity, LRUCacheType type,
-                           std::shared_ptr<MemTracker> parent_tracker) {
-    return new ShardedLRUCache(name, capacity, type, parent_tracker);
+                           std::shared_ptr<MemTracker> parent_tracker, LRUCachePolicy policy) {
+    if (policy == LRUCachePolicy::CLOCK) {
+        return new ShardedClockCache(name, capacity, type, config::clock_cache_num_shards,
+                                     parent_tracker);
+    }
+    return new ShardedLRUCache(name, capacity, type, parent_tracker, policy);
 }
 
 } // namespace doris
@@ -54,13 +54,38 @@ enum LRUCacheType {
     NUMBER // The capacity of cache is based on the number of cache entry.
 };
 
+// The eviction policy used by each shard of the cache.
+enum class LRUCachePolicy {
+    // Plain least-recently-used.
+    LRU = 0,
+    // Segmented LRU. New entries are inserted into a probationary segment and are
+    // only promoted to the protected segment when they are hit again, so a one-off
+    // scan can only flush the probationary segment.
+    SEGMENTED_LRU = 1,
+    // Segmented LRU with a TinyLFU admission filter. When the cache is full, a new
+    // entry is only admitted if it was accessed more frequently than the entry it
+    // would evict.
+    TINY_LFU = 2,
+    // CLOCK approximation of LRU, implemented by ShardedClockCache. Lookups don't
+    // take any lock, which suits read-mostly caches on machines with many cores.
+    CLOCK = 3
+};
+
+// Parse policy name ("LRU", "SLRU", "TINYLFU", "CLOCK", case insensitive).
+// Return LRUCachePolicy::LRU if the name is unknown.
+LRUCachePolicy parse_lru_cache_policy(const std::string& name);
+
+const char* lru_cache_policy_name(LRUCachePolicy policy);
+
 // Create a new cache with a specified name and a fixed SIZE capacity.
-// This implementation of Cache uses a least-recently-used eviction policy.
+// This implementation of Cache uses a least-recently-used eviction policy by default.
 extern Cache* new_lru_cache(const std::string& name, size_t capacity,
-                            std::shared_ptr<MemTracker> parent_tracekr = nullptr);
+                            std::shared_ptr<MemTracker> parent_tracekr = nullptr,
+                            LRUCachePolicy policy = LRUCachePolicy::LRU);
 
 extern Cache* new_typed_lru_cache(const std::string& name, size_t capacity, LRUCacheType type,
-                                  std::shared_ptr<MemTracker> parent_tracekr = nullptr);
+                                  std::shared_ptr<MemTracker> parent_tracekr = nullptr,
+                                  LRUCachePolicy policy = LRUCachePolicy::LRU);
 
 class CacheKey {
 public:
@@ -238,6 +263,7 @@ typedef struct LRUHandle {
     size_t key_length;
     size_t total_size; // including key length
     bool in_cache;     // Whether entry is in the cache.
+    bool in_protected; // Whether entry is in the protected segment of a segmented LRU.
     uint32_t refs;
     uint32_t hash; // Hash of key(); used for fast sharding and comparisons
     CachePriority priority = CachePriority::NORMAL;
@@ -303,14 +329,44 @@ private:
     void _resize();
 };
 
+// A 4-bit count-min sketch which estimates how often a key was accessed recently.
+// It is used as the TinyLFU admission filter of LRUCache. All counters are halved
+// once the number of increments reaches 10 times of the expected entry number,
+// so that the history of old accesses fades away.
+class FrequencySketch {
+public:
+    FrequencySketch() {}
+
+    // Size the sketch for "num_entries" cache entries, all counters are reset.
+    void resize(size_t num_entries);
+
+    void increment(uint32_t hash);
+
+    // Return the estimated frequency of the hash, in range [0, 15].
+    uint32_t frequency(uint32_t hash) const;
+
+private:
+    FRIEND_TEST(CacheTest, FrequencySketch);
+
+    size_t _index_of(uint32_t hash, int i) const;
+    bool _increment_at(size_t index, int counter);
+    void _reset();
+
+    // Every element holds 16 4-bit counters.
+    std::vector<uint64_t> _table;
+    uint64_t _table_mask = 0;
+    size_t _sample_size = 0;
+    size_t _additions = 0;
+};
+
 // A single shard of sharded cache.
 class LRUCache {
 public:
-    LRUCache(LRUCacheType type);
+    LRUCache(LRUCacheType type, LRUCachePolicy policy = LRUCachePolicy::LRU);
     ~LRUCache();
 
     // Separate from constructor so caller can easily make an array of LRUCache
-    void set_capacity(size_t capacity) { _capacity = capacity; }
+    void set_capacity(size_t capacity);
 
     // Like Cache methods, but with an extra "hash" parameter.
     Cache::Handle* insert(const CacheKey& key, uint32_t hash, void* value, size_t charge,
@@ -324,7 +380,9 @@ public:
 
     uint64_t get_lookup_count() const { return _lookup_count; }
     uint64_t get_hit_count() const { return _hit_count; }
+    uint64_t get_admission_reject_count() const { return _admission_reject_count; }
     size_t get_usage() const { return _usage; }
+    size_t get_protected_usage() const { return _protected_usage; }
     size_t get_capacity() const { return _capacity; }
 
 private:
@@ -333,9 +391,15 @@ private:
     bool _unref(LRUHandle* e);
     void _evict_from_lru(size_t total_size, LRUHandle** to_remove_head);
     void _evict_one_entry(LRUHandle* e);
+    // Demote the oldest protected entries to probationary segment until
+    // the protected segment fits its capacity.
+    void _balance_protected();
+    // Return true if the TinyLFU filter refuses to admit entry "e" to the cache.
+    bool _reject_by_admission(LRUHandle* e);
 
 private:
     LRUCacheType _type;
+    LRUCachePolicy _policy;
 
     // Initialized before use.
     size_t _capacity = 0;
@@ -347,14 +411,26 @@ private:
     // Dummy head of LRU list.
     // Entries have refs==1 and in_cache==true.
     // _lru_normal.prev is newest entry, _lru_normal.next is oldest entry.
+    // For segmented LRU, _lru_normal is the probationary segment.
     LRUHandle _lru_normal;
+    // _lru_protected.prev is newest entry, _lru_protected.next is oldest entry.
+    // Only used by segmented LRU, holds the normal entries which have been hit.
+    LRUHandle _lru_protected;
     // _lru_durable.prev is newest entry, _lru_durable.next is oldest entry.
     LRUHandle _lru_durable;
 
+    // Capacity and usage of entries in _lru_protected.
+    size_t _protected_capacity = 0;
+    size_t _protected_usage = 0;
+
     HandleTable _table;
 
+    // Only used by TinyLFU.
+    FrequencySketch _sketch;
+
     uint64_t _lookup_count = 0; // cache查找总次数
     uint64_t _hit_count = 0;    // 命中cache的总次数
+    uint64_t _admission_reject_count = 0;
 };
 
 static const int kNumShardBits = 4;
@@ -363,7 +439,8 @@ static const int kNumShards = 1 << kNumShardBits;
 class ShardedLRUCache : public Cache {
 public:
     explicit ShardedLRUCache(const std::string& name, size_t total_capacity, LRUCacheType type,
-                             std::shared_ptr<MemTracker> parent);
+                             std::shared_ptr<MemTracker> parent,
+                             LRUCachePolicy policy = LRUCachePolicy::LRU);
     // TODO(fdy): 析构时清除所有cache元素
     virtual ~ShardedLRUCache();
     virtual Handle* insert(const CacheKey& key, void* value, size_t charge,
@@ -397,6 +474,8 @@ private:
     IntAtomicCounter* lookup_count = nullptr;
     IntAtomicCounter* hit_count = nullptr;
     DoubleGauge* hit_ratio = nullptr;
+    IntGauge* protected_usage = nullptr;
+    IntAtomicCounter* admission_reject_count = nullptr;
 };
 
 } // namespace doris
@@ -209,6 +209,10 @@ OLAPStatus Reader::_capture_rs_readers(const ReaderParams& read_params,
             // duplicated keys are allowed, no need to merge sort keys in rowset
             need_ordered_result = false;
         }
+        if (_tablet->enable_unique_key_merge_on_write()) {
+            // replaced rows are removed by delete bitmap, keys are unique without merging
+            need_ordered_result = false;
+        }
         if (_aggregation) {
             // compute engine will aggregate rows with the same key,
             // it's ok for rowset to return unordered result
@@ -236,6 +240,10 @@ OLAPStatus Reader::_capture_rs_readers(const ReaderParams& read_params,
     _reader_context.runtime_state = read_params.runtime_state;
     _reader_context.use_page_cache = read_params.use_page_cache;
     _reader_context.sequence_id_idx = _sequence_col_idx;
+    if (read_params.reader_type == READER_QUERY && _tablet->enable_unique_key_merge_on_write()) {
+        _reader_context.delete_bitmap = &_tablet->tablet_meta()->delete_bitmap();
+        _reader_context.version = read_params.version;
+    }
 
     *valid_rs_readers = *rs_readers;
 
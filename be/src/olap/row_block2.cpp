@@ -23,7 +23,7 @@
 #include "gutil/strings/substitute.h"
 #include "olap/row_cursor.h"
 #include "util/bitmap.h"
-#include "vec/columns/column_complex.h"
+#include "vec/columns/column_bitmap.h"
 #include "vec/columns/column_vector.h"
 #include "vec/core/block.h"
 #include "vec/core/types.h"
@@ -136,20 +136,18 @@ void RowBlockV2::_copy_data_to_column(int cid, doris::vectorized::MutableColumnP
     case OLAP_FIELD_TYPE_OBJECT: {
         auto column_bitmap = assert_cast<vectorized::ColumnBitmap*>(column);
         for (uint16_t j = 0; j < _selected_size; ++j) {
-            column_bitmap->insert_default();
             if (!nullable_mark_array[j]) {
                 uint16_t row_idx = _selection_vector[j];
                 auto slice = reinterpret_cast<const Slice*>(column_block(cid).cell_ptr(row_idx));
 
-                BitmapValue* pvalue = &column_bitmap->get_element(column_bitmap->size() - 1);
-
                 if (slice->size != 0) {
-                    BitmapValue value;
-                    value.deserialize(slice->data);
-                    *pvalue = std::move(value);
+                    // the column keeps the serialized bitmap
+                    column_bitmap->insert_data(slice->data, slice->size);
                 } else {
-                    *pvalue = std::move(*reinterpret_cast<BitmapValue*>(slice->data));
+                    column_bitmap->insert_value(*reinterpret_cast<BitmapValue*>(slice->data));
                 }
+            } else {
+                column_bitmap->insert_default();
             }
         }
         break;
@@ -26,6 +26,7 @@
 #include "olap/row_cursor.h"
 #include "olap/rowset/segment_v2/segment_iterator.h"
 #include "olap/schema.h"
+#include "olap/tablet_meta.h"
 
 #include "vec/core/block.h"
 
@@ -80,9 +81,12 @@ OLAPStatus BetaRowsetReader::init(RowsetReaderContext* read_context) {
                                               read_context->predicates->end());
     }
     // if unique table with rowset [0-x] or [0-1] [2-y] [...],
-    // value column predicates can be pushdown on rowset [0-x] or [2-y]
+    // value column predicates can be pushdown on rowset [0-x] or [2-y].
+    // for merge-on-write unique table, replaced rows are removed by delete bitmap,
+    // so value column predicates can be pushdown on any rowset
     if (_rowset->keys_type() == UNIQUE_KEYS &&
-        (_rowset->start_version() == 0 || _rowset->start_version() == 2)) {
+        (_rowset->start_version() == 0 || _rowset->start_version() == 2 ||
+         read_context->delete_bitmap != nullptr)) {
         if (read_context->value_predicates != nullptr) {
             read_options.column_predicates.insert(read_options.column_predicates.end(),
                                                   read_context->value_predicates->begin(),
@@ -98,6 +102,13 @@ OLAPStatus BetaRowsetReader::init(RowsetReaderContext* read_context) {
     RETURN_NOT_OK(SegmentLoader::instance()->load_segments(
             _rowset, &_segment_cache_handle, read_context->reader_type == ReaderType::READER_QUERY));
 
+    if (read_context->delete_bitmap != nullptr) {
+        for (auto& seg_ptr : _segment_cache_handle.get_segments()) {
+            read_options.delete_bitmap[seg_ptr->id()] = read_context->delete_bitmap->get_agg(
+                    {_rowset->rowset_id(), seg_ptr->id(), read_context->version.second});
+        }
+    }
+
     // create iterator for each segment
     std::vector<std::unique_ptr<RowwiseIterator>> seg_iterators;
     for (auto& seg_ptr : _segment_cache_handle.get_segments()) {
@@ -223,6 +223,7 @@ OLAPStatus BetaRowsetWriter::_create_segment_writer(std::unique_ptr<segment_v2::
 
     DCHECK(wblock != nullptr);
     segment_v2::SegmentWriterOptions writer_options;
+    writer_options.enable_unique_key_merge_on_write = _context.enable_unique_key_merge_on_write;
     writer->reset(new segment_v2::SegmentWriter(wblock.get(), _num_segment,
                                                 _context.tablet_schema, writer_options, _context.parent_mem_tracker));
     {
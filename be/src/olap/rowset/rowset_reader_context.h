@@ -26,6 +26,7 @@ namespace doris {
 
 class RowCursor;
 class Conditions;
+class DeleteBitmap;
 class DeleteHandler;
 class TabletSchema;
 
@@ -61,6 +62,10 @@ struct RowsetReaderContext {
     RuntimeState* runtime_state = nullptr;
     bool use_page_cache = false;
     int sequence_id_idx = -1;
+    // rows replaced by later loads, only for merge-on-write unique key tablet
+    const DeleteBitmap* delete_bitmap = nullptr;
+    // the version to read, delete bitmap is applied up to this version
+    Version version = {-1, 0};
 };
 
 } // namespace doris
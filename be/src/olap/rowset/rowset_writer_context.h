@@ -70,6 +70,8 @@ struct RowsetWriterContext {
     // the default is set to INT32_MAX to avoid overflow issue when casting from uint32_t to int.
     // test cases can change this value to control flush timing
     uint32_t max_rows_per_segment = INT32_MAX;
+    // write primary key index in each segment, only for merge-on-write unique key tablet
+    bool enable_unique_key_merge_on_write = false;
 };
 
 } // namespace doris
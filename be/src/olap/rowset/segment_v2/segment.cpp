@@ -24,6 +24,7 @@
 #include "olap/fs/fs_util.h"
 #include "olap/rowset/segment_v2/column_reader.h" // ColumnReader
 #include "olap/rowset/segment_v2/empty_segment_iterator.h"
+#include "olap/rowset/segment_v2/indexed_column_reader.h"
 #include "olap/rowset/segment_v2/page_io.h"
 #include "olap/rowset/segment_v2/segment_iterator.h"
 #include "olap/rowset/segment_v2/segment_writer.h" // k_segment_magic_length
@@ -172,6 +173,34 @@ Status Segment::_load_index() {
     });
 }
 
+Status Segment::load_primary_key_index() {
+    if (!has_primary_key_index()) {
+        return Status::NotSupported(
+                strings::Substitute("segment $0 has no primary key index", _fname));
+    }
+    return _load_pk_index_once.call([this] {
+        _pk_index_reader.reset(new IndexedColumnReader(_fname, _footer.primary_key_index_meta()));
+        return _pk_index_reader->load(true, _tablet_schema->is_in_memory());
+    });
+}
+
+Status Segment::new_primary_key_iterator(std::unique_ptr<IndexedColumnIterator>* iter) {
+    RETURN_IF_ERROR(load_primary_key_index());
+    iter->reset(new IndexedColumnIterator(_pk_index_reader.get()));
+    return Status::OK();
+}
+
+Status Segment::lookup_row_key(IndexedColumnIterator* iter, const Slice& encoded_key,
+                               uint32_t* row_id) {
+    bool exact_match = false;
+    RETURN_IF_ERROR(iter->seek_at_or_after(&encoded_key, &exact_match));
+    if (!exact_match) {
+        return Status::NotFound("key not found");
+    }
+    *row_id = iter->get_current_ordinal();
+    return Status::OK();
+}
+
 Status Segment::_create_column_readers() {
     for (uint32_t ordinal = 0; ordinal < _footer.columns().size(); ++ordinal) {
         auto& column_pb = _footer.columns(ordinal);
@@ -45,6 +45,8 @@ namespace segment_v2 {
 class BitmapIndexIterator;
 class ColumnReader;
 class ColumnIterator;
+class IndexedColumnReader;
+class IndexedColumnIterator;
 class Segment;
 class SegmentIterator;
 using SegmentSharedPtr = std::shared_ptr<Segment>;
@@ -103,6 +105,19 @@ public:
     // only used by UT
     const SegmentFooterPB& footer() const { return _footer; }
 
+    // Primary key index maps the encoded full key of each row to its row id, it's
+    // only written for merge-on-write unique key tablet. Empty segment has no index.
+    bool has_primary_key_index() const { return _footer.has_primary_key_index_meta(); }
+    // Load primary key index, may be called multiple times, subsequent calls will no op.
+    Status load_primary_key_index();
+    // Return an iterator of the primary key index. An iterator can be reused for
+    // multiple lookups, but it's not thread-safe.
+    Status new_primary_key_iterator(std::unique_ptr<IndexedColumnIterator>* iter);
+    // Look up `encoded_key` in the primary key index by `iter`,
+    // return NotFound if the key doesn't exist in this segment.
+    Status lookup_row_key(IndexedColumnIterator* iter, const Slice& encoded_key,
+                          uint32_t* row_id);
+
 private:
     DISALLOW_COPY_AND_ASSIGN(Segment);
     Segment(std::string fname, uint32_t segment_id, const TabletSchema* tablet_schema);
@@ -141,6 +156,9 @@ private:
     PageHandle _sk_index_handle;
     // short key index decoder
     std::unique_ptr<ShortKeyIndexDecoder> _sk_index_decoder;
+
+    DorisCallOnce<Status> _load_pk_index_once;
+    std::unique_ptr<IndexedColumnReader> _pk_index_reader;
 };
 
 } // namespace segment_v2
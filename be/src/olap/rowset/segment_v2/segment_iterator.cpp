@@ -132,6 +132,7 @@ Status SegmentIterator::_init() {
     if (_segment->_tablet_schema->sort_type() != SortType::ZORDER) {
         RETURN_IF_ERROR(_get_row_ranges_by_keys());
     }
+    _apply_delete_bitmap();
     RETURN_IF_ERROR(_get_row_ranges_by_column_conditions());
     _init_lazy_materialization();
     _range_iter.reset(new BitmapRangeIterator(_row_bitmap));
@@ -212,6 +213,16 @@ Status SegmentIterator::_prepare_seek(const StorageReadOptions::KeyRange& key_ra
     return Status::OK();
 }
 
+void SegmentIterator::_apply_delete_bitmap() {
+    auto it = _opts.delete_bitmap.find(segment_id());
+    if (it == _opts.delete_bitmap.end() || it->second == nullptr || _row_bitmap.isEmpty()) {
+        return;
+    }
+    size_t pre_size = _row_bitmap.cardinality();
+    _row_bitmap -= *it->second;
+    _opts.stats->rows_del_filtered += (pre_size - _row_bitmap.cardinality());
+}
+
 Status SegmentIterator::_get_row_ranges_by_column_conditions() {
     if (_row_bitmap.isEmpty()) {
         return Status::OK();
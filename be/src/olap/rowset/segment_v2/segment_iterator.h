@@ -67,6 +67,8 @@ private:
 
     // calculate row ranges that fall into requested key ranges using short key index
     Status _get_row_ranges_by_keys();
+    // remove rows replaced by later loads, only for merge-on-write unique key tablet
+    void _apply_delete_bitmap();
     Status _prepare_seek(const StorageReadOptions::KeyRange& key_range);
     Status _lookup_ordinal(const RowCursor& key, bool is_include, rowid_t upper_bound,
                            rowid_t* rowid);
@@ -23,9 +23,12 @@
 #include "olap/row.h"                             // ContiguousRow
 #include "olap/row_cursor.h"                      // RowCursor
 #include "olap/rowset/segment_v2/column_writer.h" // ColumnWriter
+#include "olap/rowset/segment_v2/encoding_info.h"
+#include "olap/rowset/segment_v2/indexed_column_writer.h"
 #include "olap/rowset/segment_v2/page_io.h"
 #include "olap/schema.h"
 #include "olap/short_key_index.h"
+#include "olap/types.h"
 #include "runtime/mem_tracker.h"
 #include "util/crc32c.h"
 #include "util/faststring.h"
@@ -95,6 +98,20 @@ Status SegmentWriter::init(uint32_t write_mbytes_per_sec __attribute__((unused))
         _column_writers.push_back(std::move(writer));
     }
     _index_builder.reset(new ShortKeyIndexBuilder(_segment_id, _opts.num_rows_per_block));
+    if (_opts.enable_unique_key_merge_on_write) {
+        DCHECK(_tablet_schema->keys_type() == UNIQUE_KEYS);
+        // the primary key index stores the encoded full key of each row in key order,
+        // the ordinal index is used to iterate all keys when computing delete bitmap
+        // and the value index is used to look up a key
+        const TypeInfo* type_info = get_scalar_type_info(OLAP_FIELD_TYPE_VARCHAR);
+        IndexedColumnWriterOptions options;
+        options.write_ordinal_index = true;
+        options.write_value_index = true;
+        options.encoding = EncodingInfo::get_default_encoding(type_info, true);
+        options.compression = LZ4F;
+        _primary_key_index_builder.reset(new IndexedColumnWriter(options, type_info, _wblock));
+        RETURN_IF_ERROR(_primary_key_index_builder->init());
+    }
     return Status::OK();
 }
 
@@ -111,6 +128,12 @@ Status SegmentWriter::append_row(const RowType& row) {
         encode_key(&encoded_key, row, _tablet_schema->num_short_key_columns());
         RETURN_IF_ERROR(_index_builder->add_item(encoded_key));
     }
+    if (_primary_key_index_builder != nullptr) {
+        std::string full_encoded_key;
+        encode_full_key(&full_encoded_key, row, _tablet_schema->num_key_columns());
+        Slice key_slice(full_encoded_key);
+        RETURN_IF_ERROR(_primary_key_index_builder->add(&key_slice));
+    }
     ++_row_count;
     return Status::OK();
 }
@@ -146,6 +169,7 @@ Status SegmentWriter::finalize(uint64_t* segment_file_size, uint64_t* index_size
     RETURN_IF_ERROR(_write_bitmap_index());
     RETURN_IF_ERROR(_write_bloom_filter_index());
     RETURN_IF_ERROR(_write_short_key_index());
+    RETURN_IF_ERROR(_write_primary_key_index());
     *index_size = _wblock->bytes_appended() - index_offset;
     RETURN_IF_ERROR(_write_footer());
     RETURN_IF_ERROR(_wblock->finalize());
@@ -201,6 +225,14 @@ Status SegmentWriter::_write_short_key_index() {
     return Status::OK();
 }
 
+Status SegmentWriter::_write_primary_key_index() {
+    // IndexedColumn doesn't support empty input
+    if (_primary_key_index_builder == nullptr || _row_count == 0) {
+        return Status::OK();
+    }
+    return _primary_key_index_builder->finish(_footer.mutable_primary_key_index_meta());
+}
+
 Status SegmentWriter::_write_footer() {
     _footer.set_num_rows(_row_count);
 
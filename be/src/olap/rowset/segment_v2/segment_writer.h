@@ -42,12 +42,15 @@ class WritableBlock;
 namespace segment_v2 {
 
 class ColumnWriter;
+class IndexedColumnWriter;
 
 extern const char* k_segment_magic;
 extern const uint32_t k_segment_magic_length;
 
 struct SegmentWriterOptions {
     uint32_t num_rows_per_block = 1024;
+    // write a primary key index for merge-on-write unique key tablet
+    bool enable_unique_key_merge_on_write = false;
 };
 
 class SegmentWriter {
@@ -77,6 +80,7 @@ private:
     Status _write_bitmap_index();
     Status _write_bloom_filter_index();
     Status _write_short_key_index();
+    Status _write_primary_key_index();
     Status _write_footer();
     Status _write_raw_data(const std::vector<Slice>& slices);
 
@@ -90,6 +94,8 @@ private:
 
     SegmentFooterPB _footer;
     std::unique_ptr<ShortKeyIndexBuilder> _index_builder;
+    // only created when _opts.enable_unique_key_merge_on_write is true
+    std::unique_ptr<IndexedColumnWriter> _primary_key_index_builder;
     std::vector<std::unique_ptr<ColumnWriter>> _column_writers;
     std::shared_ptr<MemTracker> _mem_tracker;
     uint32_t _row_count = 0;
@@ -1356,6 +1356,7 @@ bool SchemaChangeWithSorting::_internal_sorting(const std::vector<RowBlock*>& ro
     context.rowset_type = new_rowset_type;
     context.rowset_path_prefix = new_tablet->tablet_path();
     context.tablet_schema = &(new_tablet->tablet_schema());
+    context.enable_unique_key_merge_on_write = new_tablet->enable_unique_key_merge_on_write();
     context.rowset_state = VISIBLE;
     context.version = version;
     context.version_hash = version_hash;
@@ -1762,6 +1763,7 @@ OLAPStatus SchemaChangeHandler::schema_version_convert(TabletSharedPtr base_tabl
     }
     writer_context.rowset_path_prefix = new_tablet->tablet_path();
     writer_context.tablet_schema = &(new_tablet->tablet_schema());
+    writer_context.enable_unique_key_merge_on_write = new_tablet->enable_unique_key_merge_on_write();
     writer_context.rowset_state = PREPARED;
     writer_context.txn_id = (*base_rowset)->txn_id();
     writer_context.load_id.set_hi((*base_rowset)->load_id().hi());
@@ -1909,6 +1911,8 @@ OLAPStatus SchemaChangeHandler::_convert_historical_rowsets(const SchemaChangePa
         }
         writer_context.rowset_path_prefix = new_tablet->tablet_path();
         writer_context.tablet_schema = &(new_tablet->tablet_schema());
+        writer_context.enable_unique_key_merge_on_write =
+                new_tablet->enable_unique_key_merge_on_write();
         writer_context.rowset_state = VISIBLE;
         writer_context.version = rs_reader->version();
         writer_context.version_hash = rs_reader->version_hash();
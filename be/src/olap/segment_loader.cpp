@@ -17,6 +17,7 @@
 
 #include "olap/segment_loader.h"
 
+#include "common/config.h"
 #include "olap/rowset/rowset.h"
 #include "util/stopwatch.hpp"
 
@@ -34,7 +35,8 @@ SegmentLoader::SegmentLoader(size_t capacity)
         : _mem_tracker(MemTracker::CreateTracker(capacity, "SegmentLoader", nullptr, true, true,
                                                  MemTrackerLevel::OVERVIEW)) {
     _cache = std::unique_ptr<Cache>(
-            new_typed_lru_cache("SegmentCache", capacity, LRUCacheType::NUMBER, _mem_tracker));
+            new_typed_lru_cache("SegmentCache", capacity, LRUCacheType::NUMBER, _mem_tracker,
+                                parse_lru_cache_policy(config::segment_cache_eviction_policy)));
 }
 
 bool SegmentLoader::_lookup(const SegmentLoader::CacheKey& key, SegmentCacheHandle* handle) {
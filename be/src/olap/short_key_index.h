@@ -24,6 +24,7 @@
 
 #include "common/status.h"
 #include "gen_cpp/segment_v2.pb.h"
+#include "olap/olap_common.h"
 #include "util/debug_util.h"
 #include "util/faststring.h"
 #include "util/slice.h"
@@ -106,6 +107,43 @@ void encode_key(std::string* buf, const RowType& row, size_t num_keys) {
     }
 }
 
+// Encode the full content of the first num_keys columns of one row into binary, it's
+// the key of the primary key index. Unlike encode_key(), the CHAR/VARCHAR/STRING columns
+// are not cut to their index length. To keep the encoding unambiguous and in key order,
+// such a column which isn't the last key is escaped (0x00 as 0x00 0x01) and terminated
+// by 0x00 0x00.
+template <typename RowType, bool null_first = true>
+void encode_full_key(std::string* buf, const RowType& row, size_t num_keys) {
+    for (auto cid = 0; cid < num_keys; cid++) {
+        auto cell = row.cell(cid);
+        if (cell.is_null()) {
+            if (null_first) {
+                buf->push_back(KEY_NULL_FIRST_MARKER);
+            } else {
+                buf->push_back(KEY_NULL_LAST_MARKER);
+            }
+            continue;
+        }
+        buf->push_back(KEY_NORMAL_MARKER);
+        auto field = row.schema()->column(cid);
+        FieldType type = field->type();
+        bool is_string = type == OLAP_FIELD_TYPE_CHAR || type == OLAP_FIELD_TYPE_VARCHAR ||
+                         type == OLAP_FIELD_TYPE_STRING;
+        if (!is_string || cid == num_keys - 1) {
+            field->full_encode_ascending(cell.cell_ptr(), buf);
+            continue;
+        }
+        const Slice* slice = reinterpret_cast<const Slice*>(cell.cell_ptr());
+        for (size_t i = 0; i < slice->size; ++i) {
+            buf->push_back(slice->data[i]);
+            if (slice->data[i] == '\0') {
+                buf->push_back('\x01');
+            }
+        }
+        buf->append(2, '\0');
+    }
+}
+
 // Encode a segment short key indices to one ShortKeyPage. This version
 // only accepts binary key, client should assure that input key is sorted,
 // otherwise error could happens. This builder would arrange the page body in the
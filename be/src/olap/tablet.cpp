@@ -34,11 +34,20 @@
 #include "olap/olap_define.h"
 #include "olap/reader.h"
 #include "olap/row_cursor.h"
+#include "olap/rowset/beta_rowset.h"
 #include "olap/rowset/rowset.h"
 #include "olap/rowset/rowset_factory.h"
 #include "olap/rowset/rowset_meta_manager.h"
+#include "olap/column_block.h"
+#include "olap/column_vector.h"
+#include "olap/rowset/segment_v2/indexed_column_reader.h"
+#include "olap/rowset/segment_v2/segment.h"
+#include "olap/segment_loader.h"
 #include "olap/storage_engine.h"
 #include "olap/tablet_meta_manager.h"
+#include "olap/types.h"
+#include "runtime/mem_pool.h"
+#include "runtime/mem_tracker.h"
 #include "util/path_util.h"
 #include "util/pretty_printer.h"
 #include "util/scoped_cleanup.h"
@@ -177,9 +186,11 @@ OLAPStatus Tablet::revise_tablet_meta(const std::vector<RowsetMetaSharedPtr>& ro
         auto it = _rs_version_map.find(version);
         DCHECK(it != _rs_version_map.end());
         StorageEngine::instance()->add_unused_rowset(it->second);
+        _tablet_meta->delete_bitmap().remove_rowset(it->second->rowset_id());
         _rs_version_map.erase(it);
     }
 
+    std::vector<RowsetSharedPtr> cloned_rowsets;
     for (auto& rs_meta : rowsets_to_clone) {
         Version version = {rs_meta->start_version(), rs_meta->end_version()};
         RowsetSharedPtr rowset;
@@ -188,9 +199,23 @@ OLAPStatus Tablet::revise_tablet_meta(const std::vector<RowsetMetaSharedPtr>& ro
             LOG(WARNING) << "fail to init rowset. version=" << version;
             return res;
         }
+        cloned_rowsets.push_back(rowset);
         _rs_version_map[version] = std::move(rowset);
     }
 
+    if (enable_unique_key_merge_on_write()) {
+        // delete bitmap of cloned rowsets is not cloned, calculate it in version order
+        std::sort(cloned_rowsets.begin(), cloned_rowsets.end(), Rowset::comparator);
+        for (auto& rowset : cloned_rowsets) {
+            res = update_delete_bitmap_unlocked(rowset);
+            if (res != OLAP_SUCCESS) {
+                LOG(WARNING) << "fail to update delete bitmap of cloned rowset. tablet="
+                             << full_name() << ", version=" << rowset->version();
+                return res;
+            }
+        }
+    }
+
     // reconstruct from tablet meta
     _timestamped_version_tracker.construct_versioned_tracker(_tablet_meta->all_rs_metas());
     // clear stale rowset
@@ -207,6 +232,8 @@ OLAPStatus Tablet::revise_tablet_meta(const std::vector<RowsetMetaSharedPtr>& ro
 
 OLAPStatus Tablet::add_rowset(RowsetSharedPtr rowset, bool need_persist) {
     DCHECK(rowset != nullptr);
+    PendingDeleteBitmap pending_delete_bitmap;
+    RETURN_NOT_OK(calc_delete_bitmap_without_lock(rowset, true, &pending_delete_bitmap));
     WriteLock wrlock(&_meta_lock);
     // If the rowset already exist, just return directly.  The rowset_id is an unique-id,
     // we can use it to check this situation.
@@ -215,6 +242,7 @@ OLAPStatus Tablet::add_rowset(RowsetSharedPtr rowset, bool need_persist) {
     }
     // Otherwise, the version should be not contained in any existing rowset.
     RETURN_NOT_OK(_contains_version(rowset->version()));
+    RETURN_NOT_OK(update_delete_bitmap_unlocked(rowset, true, &pending_delete_bitmap));
 
     RETURN_NOT_OK(_tablet_meta->add_rs_meta(rowset->rowset_meta()));
     _rs_version_map[rowset->version()] = rowset;
@@ -309,6 +337,7 @@ void Tablet::modify_rowsets(std::vector<RowsetSharedPtr>& to_add,
         for (auto& rs : to_delete) {
             LOG(INFO) << "add unused rowset " << rs->rowset_id() << " because of same version";
             StorageEngine::instance()->add_unused_rowset(rs);
+            _tablet_meta->delete_bitmap().remove_rowset(rs->rowset_id());
         }
     }
 }
@@ -369,11 +398,14 @@ RowsetSharedPtr Tablet::_rowset_with_largest_size() {
 // add inc rowset should not persist tablet meta, because it will be persisted when publish txn.
 OLAPStatus Tablet::add_inc_rowset(const RowsetSharedPtr& rowset) {
     DCHECK(rowset != nullptr);
+    PendingDeleteBitmap pending_delete_bitmap;
+    RETURN_NOT_OK(calc_delete_bitmap_without_lock(rowset, true, &pending_delete_bitmap));
     WriteLock wrlock(&_meta_lock);
     if (_contains_rowset(rowset->rowset_id())) {
         return OLAP_SUCCESS;
     }
     RETURN_NOT_OK(_contains_version(rowset->version()));
+    RETURN_NOT_OK(update_delete_bitmap_unlocked(rowset, true, &pending_delete_bitmap));
 
     RETURN_NOT_OK(_tablet_meta->add_rs_meta(rowset->rowset_meta()));
     _rs_version_map[rowset->version()] = rowset;
@@ -384,6 +416,235 @@ OLAPStatus Tablet::add_inc_rowset(const RowsetSharedPtr& rowset) {
     return OLAP_SUCCESS;
 }
 
+OLAPStatus Tablet::calc_delete_bitmap(const RowsetSharedPtr& rowset,
+                                      const std::vector<RowsetSharedPtr>& specified_rowsets,
+                                      int64_t version, DeleteBitmap* delete_bitmap,
+                                      const DeleteBitmap* base) {
+    // the segments to look up, from newest to oldest
+    struct LookupSegment {
+        RowsetId rowset_id;
+        segment_v2::SegmentSharedPtr segment;
+        std::unique_ptr<segment_v2::IndexedColumnIterator> iter;
+    };
+    std::vector<LookupSegment> lookup_segments;
+    std::vector<SegmentCacheHandle> segment_cache_handles;
+    auto load_segments = [&](const RowsetSharedPtr& rs) -> OLAPStatus {
+        if (rs->rowset_meta()->rowset_type() != BETA_ROWSET) {
+            LOG(WARNING) << "merge-on-write only supports beta rowset. tablet=" << full_name()
+                         << ", rowset=" << rs->rowset_id();
+            return OLAP_ERR_ROWSET_TYPE_NOT_FOUND;
+        }
+        SegmentCacheHandle handle;
+        RETURN_NOT_OK(SegmentLoader::instance()->load_segments(
+                std::static_pointer_cast<BetaRowset>(rs), &handle, true));
+        segment_cache_handles.push_back(std::move(handle));
+        return OLAP_SUCCESS;
+    };
+    auto new_lookup_segment = [&](const RowsetId& rowset_id,
+                                  const segment_v2::SegmentSharedPtr& segment,
+                                  LookupSegment* lookup_segment) -> OLAPStatus {
+        lookup_segment->rowset_id = rowset_id;
+        lookup_segment->segment = segment;
+        auto st = segment->new_primary_key_iterator(&lookup_segment->iter);
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to load primary key index. tablet=" << full_name()
+                         << ", rowset=" << rowset_id << ", segment=" << segment->id()
+                         << ", status=" << st.to_string();
+            return OLAP_ERR_INDEX_LOAD_ERROR;
+        }
+        return OLAP_SUCCESS;
+    };
+
+    for (auto& rs : specified_rowsets) {
+        RETURN_NOT_OK(load_segments(rs));
+        auto& segments = segment_cache_handles.back().get_segments();
+        for (auto it = segments.rbegin(); it != segments.rend(); ++it) {
+            if ((*it)->num_rows() == 0) {
+                continue;
+            }
+            LookupSegment lookup_segment;
+            RETURN_NOT_OK(new_lookup_segment(rs->rowset_id(), *it, &lookup_segment));
+            lookup_segments.push_back(std::move(lookup_segment));
+        }
+    }
+
+    RETURN_NOT_OK(load_segments(rowset));
+    // segment_cache_handles may be reallocated, copy the segments of rowset
+    std::vector<segment_v2::SegmentSharedPtr> segments =
+            segment_cache_handles.back().get_segments();
+
+    // Mark the newest row of `key` which is not deleted yet in `candidates`.
+    auto mark_replaced_row = [&](const Slice& key, std::vector<LookupSegment>& candidates,
+                                 bool* marked) -> OLAPStatus {
+        for (auto& candidate : candidates) {
+            uint32_t row_id = 0;
+            auto st = candidate.segment->lookup_row_key(candidate.iter.get(), key, &row_id);
+            if (st.is_not_found()) {
+                continue;
+            }
+            if (!st.ok()) {
+                LOG(WARNING) << "failed to look up primary key index. tablet=" << full_name()
+                             << ", rowset=" << candidate.rowset_id
+                             << ", segment=" << candidate.segment->id()
+                             << ", status=" << st.to_string();
+                return OLAP_ERR_INDEX_LOAD_ERROR;
+            }
+            DeleteBitmap::BitmapKey bmk {candidate.rowset_id, candidate.segment->id(), version};
+            if (delete_bitmap->contains_agg(bmk, row_id) ||
+                (base != nullptr && base->contains_agg(bmk, row_id))) {
+                continue;
+            }
+            delete_bitmap->add(bmk, row_id);
+            *marked = true;
+            break;
+        }
+        return OLAP_SUCCESS;
+    };
+
+    const TypeInfo* type_info = get_scalar_type_info(OLAP_FIELD_TYPE_VARCHAR);
+    auto tracker = std::make_shared<MemTracker>();
+    MemPool pool(tracker.get());
+    constexpr size_t kBatchSize = 1024;
+    std::unique_ptr<ColumnVectorBatch> cvb;
+    if (!ColumnVectorBatch::create(kBatchSize, false, type_info, nullptr, &cvb).ok()) {
+        return OLAP_ERR_MALLOC_ERROR;
+    }
+
+    // earlier segments of rowset are looked up first, they are newer than specified rowsets
+    std::vector<LookupSegment> own_segments;
+    for (auto& segment : segments) {
+        if (segment->num_rows() == 0) {
+            continue;
+        }
+        LookupSegment self;
+        RETURN_NOT_OK(new_lookup_segment(rowset->rowset_id(), segment, &self));
+        for (size_t ordinal = 0; ordinal < segment->num_rows();) {
+            ColumnBlock block(cvb.get(), &pool);
+            ColumnBlockView column_block_view(&block);
+            size_t num_read = std::min(kBatchSize, segment->num_rows() - ordinal);
+            auto st = self.iter->seek_to_ordinal(ordinal);
+            if (st.ok()) {
+                st = self.iter->next_batch(&num_read, &column_block_view);
+            }
+            if (!st.ok() || num_read == 0) {
+                LOG(WARNING) << "failed to read primary key index. tablet=" << full_name()
+                             << ", rowset=" << rowset->rowset_id() << ", segment=" << segment->id()
+                             << ", status=" << st.to_string();
+                return OLAP_ERR_INDEX_LOAD_ERROR;
+            }
+            const Slice* keys = reinterpret_cast<const Slice*>(block.data());
+            for (size_t i = 0; i < num_read; ++i) {
+                bool marked = false;
+                RETURN_NOT_OK(mark_replaced_row(keys[i], own_segments, &marked));
+                if (!marked) {
+                    RETURN_NOT_OK(mark_replaced_row(keys[i], lookup_segments, &marked));
+                }
+            }
+            ordinal += num_read;
+            pool.clear();
+        }
+        own_segments.insert(own_segments.begin(), std::move(self));
+    }
+    return OLAP_SUCCESS;
+}
+
+void Tablet::_delete_bitmap_rowsets(const RowsetSharedPtr& rowset,
+                                    std::vector<RowsetSharedPtr>* older_rowsets,
+                                    std::vector<RowsetSharedPtr>* newer_rowsets) const {
+    for (auto& it : _rs_version_map) {
+        if (it.second->rowset_id() == rowset->rowset_id()) {
+            continue;
+        }
+        if (it.first.second < rowset->start_version()) {
+            older_rowsets->push_back(it.second);
+        } else if (it.first.first > rowset->end_version()) {
+            newer_rowsets->push_back(it.second);
+        }
+    }
+    // look up from the newest rowset
+    std::sort(older_rowsets->begin(), older_rowsets->end(), Rowset::comparator);
+    std::reverse(older_rowsets->begin(), older_rowsets->end());
+    std::sort(newer_rowsets->begin(), newer_rowsets->end(), Rowset::comparator);
+}
+
+OLAPStatus Tablet::calc_delete_bitmap_without_lock(const RowsetSharedPtr& rowset,
+                                                   bool replace_older,
+                                                   PendingDeleteBitmap* pending) {
+    if (!enable_unique_key_merge_on_write()) {
+        return OLAP_SUCCESS;
+    }
+    std::vector<RowsetSharedPtr> older_rowsets;
+    std::vector<RowsetSharedPtr> newer_rowsets;
+    {
+        ReadLock rdlock(&_meta_lock);
+        pending->tablet_meta = _tablet_meta;
+        _delete_bitmap_rowsets(rowset, &older_rowsets, &newer_rowsets);
+    }
+    // DeleteBitmap is thread-safe, the marks added meanwhile are either of other versions or
+    // of the rowsets looked up again in update_delete_bitmap_unlocked()
+    const DeleteBitmap* base = &pending->tablet_meta->delete_bitmap();
+    OlapStopWatch watch;
+    if (replace_older) {
+        RETURN_NOT_OK(calc_delete_bitmap(rowset, older_rowsets, rowset->start_version(),
+                                         &pending->delete_bitmap, base));
+        for (auto& older_rowset : older_rowsets) {
+            pending->checked_rowsets.insert(older_rowset->rowset_id());
+        }
+    }
+    for (auto& newer_rowset : newer_rowsets) {
+        RETURN_NOT_OK(calc_delete_bitmap(newer_rowset, {rowset}, newer_rowset->start_version(),
+                                         &pending->delete_bitmap, base));
+        pending->checked_rowsets.insert(newer_rowset->rowset_id());
+    }
+    VLOG_NOTICE << "calc delete bitmap without lock. tablet=" << full_name()
+                << ", rowset=" << rowset->rowset_id() << ", version=" << rowset->version()
+                << ", older_rowsets=" << older_rowsets.size()
+                << ", newer_rowsets=" << newer_rowsets.size()
+                << ", cost=" << watch.get_elapse_time_us() << "us";
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus Tablet::update_delete_bitmap_unlocked(const RowsetSharedPtr& rowset,
+                                                 bool replace_older,
+                                                 const PendingDeleteBitmap* pending) {
+    if (!enable_unique_key_merge_on_write()) {
+        return OLAP_SUCCESS;
+    }
+    std::vector<RowsetSharedPtr> older_rowsets;
+    std::vector<RowsetSharedPtr> newer_rowsets;
+    _delete_bitmap_rowsets(rowset, &older_rowsets, &newer_rowsets);
+
+    DeleteBitmap& delete_bitmap = _tablet_meta->delete_bitmap();
+    // The pending marks are stale if the tablet meta is replaced, e.g. by a clone.
+    if (pending != nullptr && pending->tablet_meta == _tablet_meta) {
+        delete_bitmap.merge(pending->delete_bitmap);
+        auto checked = [&](const RowsetSharedPtr& rs) {
+            return pending->checked_rowsets.count(rs->rowset_id()) > 0;
+        };
+        // only the rowsets added meanwhile, e.g. by compaction or a concurrent publish
+        older_rowsets.erase(std::remove_if(older_rowsets.begin(), older_rowsets.end(), checked),
+                            older_rowsets.end());
+        newer_rowsets.erase(std::remove_if(newer_rowsets.begin(), newer_rowsets.end(), checked),
+                            newer_rowsets.end());
+    }
+
+    OlapStopWatch watch;
+    if (replace_older && !older_rowsets.empty()) {
+        RETURN_NOT_OK(calc_delete_bitmap(rowset, older_rowsets, rowset->start_version(),
+                                         &delete_bitmap));
+    }
+    for (auto& newer_rowset : newer_rowsets) {
+        RETURN_NOT_OK(calc_delete_bitmap(newer_rowset, {rowset}, newer_rowset->start_version(),
+                                         &delete_bitmap));
+    }
+    VLOG_NOTICE << "update delete bitmap. tablet=" << full_name()
+                << ", rowset=" << rowset->rowset_id() << ", version=" << rowset->version()
+                << ", older_rowsets=" << older_rowsets.size()
+                << ", newer_rowsets=" << newer_rowsets.size()
+                << ", cost=" << watch.get_elapse_time_us() << "us";
+    return OLAP_SUCCESS;
+}
+
 void Tablet::_delete_stale_rowset_by_version(const Version& version) {
     RowsetMetaSharedPtr rowset_meta = _tablet_meta->acquire_stale_rs_meta_by_version(version);
     if (rowset_meta == nullptr) {
@@ -512,6 +773,7 @@ void Tablet::delete_expired_stale_rowset() {
             if (it != _stale_rs_version_map.end()) {
                 // delete rowset
                 StorageEngine::instance()->add_unused_rowset(it->second);
+                _tablet_meta->delete_bitmap().remove_rowset(it->second->rowset_id());
                 _stale_rs_version_map.erase(it);
                 VLOG_NOTICE << "delete stale rowset tablet=" << full_name() << " version["
                           << timestampedVersion->version().first << ","
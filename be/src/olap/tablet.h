@@ -109,6 +109,42 @@ public:
     const RowsetSharedPtr rowset_with_max_version() const;
 
     OLAPStatus add_inc_rowset(const RowsetSharedPtr& rowset);
+
+    // merge-on-write unique key tablet maintains a delete bitmap of the rows replaced
+    // by later loads, so that it can be read without merging rowsets.
+    inline bool enable_unique_key_merge_on_write() const;
+    // Mark the rows of `specified_rowsets` whose keys exist in `rowset` as deleted
+    // at `version` in `delete_bitmap`, as well as the rows of earlier segments of
+    // `rowset` whose keys exist in later segments. `specified_rowsets` should be
+    // ordered from newest to oldest.
+    // The rows marked in `base` are taken as deleted too, but only `delete_bitmap` is updated.
+    OLAPStatus calc_delete_bitmap(const RowsetSharedPtr& rowset,
+                                  const std::vector<RowsetSharedPtr>& specified_rowsets,
+                                  int64_t version, DeleteBitmap* delete_bitmap,
+                                  const DeleteBitmap* base = nullptr);
+
+    // The delete bitmap of a rowset calculated before the rowset is added to tablet, see
+    // calc_delete_bitmap_without_lock().
+    struct PendingDeleteBitmap {
+        // the tablet meta whose rowsets and delete bitmap it's calculated with
+        TabletMetaSharedPtr tablet_meta;
+        std::set<RowsetId> checked_rowsets;
+        DeleteBitmap delete_bitmap;
+    };
+    // Calculate the marks update_delete_bitmap_unlocked() would add for `rowset` against the
+    // current rowsets of tablet. Only the rowsets are captured under _meta_lock, the primary
+    // key lookups run without it, so loads and queries aren't blocked by them.
+    OLAPStatus calc_delete_bitmap_without_lock(const RowsetSharedPtr& rowset, bool replace_older,
+                                               PendingDeleteBitmap* pending);
+    // Update delete bitmap before `rowset` is added to tablet. The rows of older rowsets
+    // replaced by `rowset` are marked if `replace_older` is true, and the rows of `rowset`
+    // replaced by newer rowsets are always marked. Compaction output doesn't need to
+    // replace older rowsets because its keys were resolved when its input rowsets were
+    // published. If `pending` is given, its marks are applied and only the rowsets added
+    // after it's calculated are looked up. The caller should hold _meta_lock.
+    OLAPStatus update_delete_bitmap_unlocked(const RowsetSharedPtr& rowset,
+                                             bool replace_older = true,
+                                             const PendingDeleteBitmap* pending = nullptr);
     /// Delete stale rowset by timing. This delete policy uses now() minutes
     /// config::tablet_rowset_expired_stale_sweep_time_sec to compute the deadline of expired rowset
     /// to delete.  When rowset is deleted, it will be added to StorageEngine unused map and record
@@ -266,6 +302,11 @@ private:
     void _print_missed_versions(const std::vector<Version>& missed_versions) const;
     bool _contains_rowset(const RowsetId rowset_id);
     OLAPStatus _contains_version(const Version& version);
+    // The rowsets of tablet older and newer than `rowset`, ordered as update_delete_bitmap_unlocked()
+    // looks them up. The caller should hold _meta_lock.
+    void _delete_bitmap_rowsets(const RowsetSharedPtr& rowset,
+                                std::vector<RowsetSharedPtr>* older_rowsets,
+                                std::vector<RowsetSharedPtr>* newer_rowsets) const;
 
     // Returns:
     // version: the max continuous version from beginning
@@ -404,6 +445,10 @@ inline Version Tablet::max_version() const {
     return _tablet_meta->max_version();
 }
 
+inline bool Tablet::enable_unique_key_merge_on_write() const {
+    return _tablet_meta->enable_unique_key_merge_on_write();
+}
+
 inline KeysType Tablet::keys_type() const {
     return _schema.keys_type();
 }
@@ -742,6 +742,12 @@ OLAPStatus TabletManager::load_tablet_from_meta(DataDir* data_dir, TTabletId tab
                      << "tablet=" << tablet_meta->full_name() << ", path=" << data_dir->path();
         return OLAP_ERR_HEADER_PB_PARSE_FAILED;
     }
+    if (tablet_meta->enable_unique_key_merge_on_write()) {
+        RETURN_NOT_OK_LOG(TabletMetaManager::load_delete_bitmap(data_dir, tablet_id, schema_hash,
+                                                                &tablet_meta->delete_bitmap()),
+                          strings::Substitute("fail to load delete bitmap. tablet=$0",
+                                              tablet_meta->full_name()));
+    }
 
     if (restore) {
         // we're restoring tablet from trash, tablet state should be changed from shutdown back to running
@@ -42,18 +42,22 @@ OLAPStatus TabletMeta::create(const TCreateTabletReq& request, const TabletUid&
             request.table_id, request.partition_id, request.tablet_id,
             request.tablet_schema.schema_hash, shard_id, request.tablet_schema, next_unique_id,
             col_ordinal_to_unique_id, tablet_uid,
-            request.__isset.tablet_type ? request.tablet_type : TTabletType::TABLET_TYPE_DISK));
+            request.__isset.tablet_type ? request.tablet_type : TTabletType::TABLET_TYPE_DISK,
+            request.__isset.enable_unique_key_merge_on_write &&
+                    request.enable_unique_key_merge_on_write));
     return OLAP_SUCCESS;
 }
 
-TabletMeta::TabletMeta() : _tablet_uid(0, 0), _schema(new TabletSchema) {}
+TabletMeta::TabletMeta()
+        : _tablet_uid(0, 0), _schema(new TabletSchema), _delete_bitmap(new DeleteBitmap()) {}
 
 TabletMeta::TabletMeta(int64_t table_id, int64_t partition_id, int64_t tablet_id,
                        int32_t schema_hash, uint64_t shard_id, const TTabletSchema& tablet_schema,
                        uint32_t next_unique_id,
                        const std::unordered_map<uint32_t, uint32_t>& col_ordinal_to_unique_id,
-                       TabletUid tablet_uid, TTabletType::type tabletType)
-        : _tablet_uid(0, 0), _schema(new TabletSchema) {
+                       TabletUid tablet_uid, TTabletType::type tabletType,
+                       bool enable_unique_key_merge_on_write)
+        : _tablet_uid(0, 0), _schema(new TabletSchema), _delete_bitmap(new DeleteBitmap()) {
     TabletMetaPB tablet_meta_pb;
     tablet_meta_pb.set_table_id(table_id);
     tablet_meta_pb.set_partition_id(partition_id);
@@ -96,6 +100,11 @@ TabletMeta::TabletMeta(int64_t table_id, int64_t partition_id, int64_t tablet_id
     }
     schema->set_sort_col_num(tablet_schema.sort_col_num);
     tablet_meta_pb.set_in_restore_mode(false);
+    // merge-on-write only makes sense for unique key tablets without sequence column,
+    // rows with the same key are resolved by load order.
+    tablet_meta_pb.set_enable_unique_key_merge_on_write(
+            enable_unique_key_merge_on_write && tablet_schema.keys_type == TKeysType::UNIQUE_KEYS &&
+            tablet_schema.sequence_col_idx == -1);
 
     // set column information
     uint32_t col_ordinal = 0;
@@ -164,7 +173,9 @@ TabletMeta::TabletMeta(const TabletMeta& b)
           _stale_rs_metas(b._stale_rs_metas),
           _del_pred_array(b._del_pred_array),
           _in_restore_mode(b._in_restore_mode),
-          _preferred_rowset_type(b._preferred_rowset_type) {}
+          _preferred_rowset_type(b._preferred_rowset_type),
+          _enable_unique_key_merge_on_write(b._enable_unique_key_merge_on_write),
+          _delete_bitmap(new DeleteBitmap(*b._delete_bitmap)) {}
 
 void TabletMeta::_init_column_from_tcolumn(uint32_t unique_id, const TColumn& tcolumn,
                                            ColumnPB* column) {
@@ -308,8 +319,22 @@ OLAPStatus TabletMeta::_save_meta(DataDir* data_dir) {
         LOG(FATAL) << "tablet_uid is invalid"
                    << " tablet=" << full_name() << " _tablet_uid=" << _tablet_uid.to_string();
     }
+    // the delete bitmap is saved incrementally before the rowsets it refers to
+    if (_enable_unique_key_merge_on_write) {
+        OLAPStatus status = TabletMetaManager::save_delete_bitmap(
+                data_dir, tablet_id(), schema_hash(), _delete_bitmap.get());
+        if (status != OLAP_SUCCESS) {
+            LOG(FATAL) << "fail to save delete bitmap. status=" << status
+                       << ", tablet_id=" << tablet_id() << ", schema_hash=" << schema_hash();
+            return status;
+        }
+    }
+    TabletMetaPB tablet_meta_pb;
+    to_meta_pb(&tablet_meta_pb, false);
     string meta_binary;
-    RETURN_NOT_OK(serialize(&meta_binary));
+    if (!tablet_meta_pb.SerializeToString(&meta_binary)) {
+        LOG(FATAL) << "failed to serialize meta " << full_name();
+    }
     OLAPStatus status = TabletMetaManager::save(data_dir, tablet_id(), schema_hash(), meta_binary);
     if (status != OLAP_SUCCESS) {
         LOG(FATAL) << "fail to save tablet_meta. status=" << status << ", tablet_id=" << tablet_id()
@@ -402,9 +427,17 @@ void TabletMeta::init_from_pb(const TabletMetaPB& tablet_meta_pb) {
     if (tablet_meta_pb.has_preferred_rowset_type()) {
         _preferred_rowset_type = tablet_meta_pb.preferred_rowset_type();
     }
+
+    _enable_unique_key_merge_on_write = tablet_meta_pb.enable_unique_key_merge_on_write();
+    if (tablet_meta_pb.has_delete_bitmap()) {
+        // from a tablet meta file or the meta store of an earlier version, the entries are
+        // saved under their own keys by the next save_meta()
+        _delete_bitmap->init_from_pb(tablet_meta_pb.delete_bitmap());
+        _delete_bitmap->mark_all_updated();
+    }
 }
 
-void TabletMeta::to_meta_pb(TabletMetaPB* tablet_meta_pb) {
+void TabletMeta::to_meta_pb(TabletMetaPB* tablet_meta_pb, bool with_delete_bitmap) {
     tablet_meta_pb->set_table_id(table_id());
     tablet_meta_pb->set_partition_id(partition_id());
     tablet_meta_pb->set_tablet_id(tablet_id());
@@ -446,6 +479,13 @@ void TabletMeta::to_meta_pb(TabletMetaPB* tablet_meta_pb) {
     if (_preferred_rowset_type == BETA_ROWSET) {
         tablet_meta_pb->set_preferred_rowset_type(_preferred_rowset_type);
     }
+
+    if (_enable_unique_key_merge_on_write) {
+        tablet_meta_pb->set_enable_unique_key_merge_on_write(true);
+        if (with_delete_bitmap) {
+            _delete_bitmap->to_pb(tablet_meta_pb->mutable_delete_bitmap());
+        }
+    }
 }
 
 uint32_t TabletMeta::mem_size() const {
@@ -659,6 +699,7 @@ bool operator==(const TabletMeta& a, const TabletMeta& b) {
     }
     if (a._in_restore_mode != b._in_restore_mode) return false;
     if (a._preferred_rowset_type != b._preferred_rowset_type) return false;
+    if (a._enable_unique_key_merge_on_write != b._enable_unique_key_merge_on_write) return false;
     return true;
 }
 
@@ -666,4 +707,183 @@ bool operator!=(const TabletMeta& a, const TabletMeta& b) {
     return !(a == b);
 }
 
+DeleteBitmap::DeleteBitmap(const DeleteBitmap& other) {
+    ReadLock rlock(&other._lock);
+    _delete_bitmap = other._delete_bitmap;
+    _updated = other._updated;
+    _removed = other._removed;
+}
+
+DeleteBitmap& DeleteBitmap::operator=(const DeleteBitmap& other) {
+    if (this != &other) {
+        std::map<BitmapKey, roaring::Roaring> copied;
+        std::set<SaveKey> updated;
+        std::set<SaveKey> removed;
+        {
+            ReadLock rlock(&other._lock);
+            copied = other._delete_bitmap;
+            updated = other._updated;
+            removed = other._removed;
+        }
+        WriteLock wrlock(&_lock);
+        _delete_bitmap.swap(copied);
+        _updated.swap(updated);
+        _removed.swap(removed);
+    }
+    return *this;
+}
+
+void DeleteBitmap::_mark_updated(const BitmapKey& bmk) {
+    SaveKey key {std::get<0>(bmk), std::get<2>(bmk)};
+    _removed.erase(key);
+    _updated.insert(key);
+}
+
+void DeleteBitmap::add(const BitmapKey& bmk, uint32_t row_id) {
+    WriteLock wrlock(&_lock);
+    _delete_bitmap[bmk].add(row_id);
+    _mark_updated(bmk);
+}
+
+bool DeleteBitmap::contains(const BitmapKey& bmk, uint32_t row_id) const {
+    ReadLock rlock(&_lock);
+    auto it = _delete_bitmap.find(bmk);
+    return it != _delete_bitmap.end() && it->second.contains(row_id);
+}
+
+void DeleteBitmap::set(const BitmapKey& bmk, const roaring::Roaring& segment_delete_bitmap) {
+    WriteLock wrlock(&_lock);
+    _delete_bitmap[bmk] = segment_delete_bitmap;
+    _mark_updated(bmk);
+}
+
+void DeleteBitmap::merge(const DeleteBitmap& other) {
+    if (this == &other) {
+        return;
+    }
+    ReadLock rlock(&other._lock);
+    WriteLock wrlock(&_lock);
+    for (auto& it : other._delete_bitmap) {
+        _delete_bitmap[it.first] |= it.second;
+        _mark_updated(it.first);
+    }
+}
+
+bool DeleteBitmap::contains_agg(const BitmapKey& bmk, uint32_t row_id) const {
+    ReadLock rlock(&_lock);
+    BitmapKey start {std::get<0>(bmk), std::get<1>(bmk), 0};
+    for (auto it = _delete_bitmap.lower_bound(start);
+         it != _delete_bitmap.end() && std::get<0>(it->first) == std::get<0>(bmk) &&
+         std::get<1>(it->first) == std::get<1>(bmk) && std::get<2>(it->first) <= std::get<2>(bmk);
+         ++it) {
+        if (it->second.contains(row_id)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::shared_ptr<roaring::Roaring> DeleteBitmap::get_agg(const BitmapKey& bmk) const {
+    std::shared_ptr<roaring::Roaring> result;
+    ReadLock rlock(&_lock);
+    BitmapKey start {std::get<0>(bmk), std::get<1>(bmk), 0};
+    for (auto it = _delete_bitmap.lower_bound(start);
+         it != _delete_bitmap.end() && std::get<0>(it->first) == std::get<0>(bmk) &&
+         std::get<1>(it->first) == std::get<1>(bmk) && std::get<2>(it->first) <= std::get<2>(bmk);
+         ++it) {
+        if (result == nullptr) {
+            result = std::make_shared<roaring::Roaring>(it->second);
+        } else {
+            *result |= it->second;
+        }
+    }
+    return result;
+}
+
+void DeleteBitmap::remove_rowset(const RowsetId& rowset_id) {
+    WriteLock wrlock(&_lock);
+    auto it = _delete_bitmap.lower_bound({rowset_id, 0, 0});
+    while (it != _delete_bitmap.end() && std::get<0>(it->first) == rowset_id) {
+        SaveKey key {rowset_id, std::get<2>(it->first)};
+        _updated.erase(key);
+        _removed.insert(key);
+        it = _delete_bitmap.erase(it);
+    }
+}
+
+size_t DeleteBitmap::num_entries() const {
+    ReadLock rlock(&_lock);
+    return _delete_bitmap.size();
+}
+
+uint64_t DeleteBitmap::cardinality() const {
+    ReadLock rlock(&_lock);
+    uint64_t res = 0;
+    for (auto& it : _delete_bitmap) {
+        res += it.second.cardinality();
+    }
+    return res;
+}
+
+void DeleteBitmap::init_from_pb(const DeleteBitmapPB& delete_bitmap_pb) {
+    WriteLock wrlock(&_lock);
+    int size = delete_bitmap_pb.rowset_ids_size();
+    DCHECK_EQ(size, delete_bitmap_pb.segment_ids_size());
+    DCHECK_EQ(size, delete_bitmap_pb.versions_size());
+    DCHECK_EQ(size, delete_bitmap_pb.segment_delete_bitmaps_size());
+    for (int i = 0; i < size; ++i) {
+        RowsetId rowset_id;
+        rowset_id.init(delete_bitmap_pb.rowset_ids(i));
+        const std::string& buf = delete_bitmap_pb.segment_delete_bitmaps(i);
+        _delete_bitmap[{rowset_id, delete_bitmap_pb.segment_ids(i), delete_bitmap_pb.versions(i)}] =
+                roaring::Roaring::read(buf.data());
+    }
+}
+
+void DeleteBitmap::to_pb(DeleteBitmapPB* delete_bitmap_pb) const {
+    ReadLock rlock(&_lock);
+    for (auto& it : _delete_bitmap) {
+        delete_bitmap_pb->add_rowset_ids(std::get<0>(it.first).to_string());
+        delete_bitmap_pb->add_segment_ids(std::get<1>(it.first));
+        delete_bitmap_pb->add_versions(std::get<2>(it.first));
+        std::string* buf = delete_bitmap_pb->add_segment_delete_bitmaps();
+        buf->resize(it.second.getSizeInBytes());
+        it.second.write(buf->data());
+    }
+}
+
+bool DeleteBitmap::to_pb(const SaveKey& key, DeleteBitmapPB* delete_bitmap_pb) const {
+    ReadLock rlock(&_lock);
+    bool found = false;
+    for (auto it = _delete_bitmap.lower_bound({key.first, 0, 0});
+         it != _delete_bitmap.end() && std::get<0>(it->first) == key.first; ++it) {
+        if (std::get<2>(it->first) != key.second) {
+            continue;
+        }
+        delete_bitmap_pb->add_rowset_ids(key.first.to_string());
+        delete_bitmap_pb->add_segment_ids(std::get<1>(it->first));
+        delete_bitmap_pb->add_versions(key.second);
+        std::string* buf = delete_bitmap_pb->add_segment_delete_bitmaps();
+        buf->resize(it->second.getSizeInBytes());
+        it->second.write(buf->data());
+        found = true;
+    }
+    return found;
+}
+
+void DeleteBitmap::take_changes(std::set<SaveKey>* updated, std::set<SaveKey>* removed) {
+    WriteLock wrlock(&_lock);
+    updated->swap(_updated);
+    removed->swap(_removed);
+    _updated.clear();
+    _removed.clear();
+}
+
+void DeleteBitmap::mark_all_updated() {
+    WriteLock wrlock(&_lock);
+    for (auto& it : _delete_bitmap) {
+        _mark_updated(it.first);
+    }
+}
+
 } // namespace doris
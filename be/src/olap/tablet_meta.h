@@ -18,8 +18,13 @@
 #ifndef DORIS_BE_SRC_OLAP_TABLET_META_H
 #define DORIS_BE_SRC_OLAP_TABLET_META_H
 
+#include <map>
 #include <mutex>
+#include <roaring/roaring.hh>
+#include <set>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include "common/logging.h"
@@ -66,7 +71,9 @@ class RowsetMeta;
 class Rowset;
 class DataDir;
 class TabletMeta;
+class DeleteBitmap;
 using TabletMetaSharedPtr = std::shared_ptr<TabletMeta>;
+using DeleteBitmapPtr = std::shared_ptr<DeleteBitmap>;
 
 // Class encapsulates meta of tablet.
 // The concurrency control is handled in Tablet Class, not in this class.
@@ -81,7 +88,8 @@ public:
     TabletMeta(int64_t table_id, int64_t partition_id, int64_t tablet_id, int32_t schema_hash,
                uint64_t shard_id, const TTabletSchema& tablet_schema, uint32_t next_unique_id,
                const std::unordered_map<uint32_t, uint32_t>& col_ordinal_to_unique_id,
-               TabletUid tablet_uid, TTabletType::type tabletType);
+               TabletUid tablet_uid, TTabletType::type tabletType,
+               bool enable_unique_key_merge_on_write = false);
     // If need add a filed in TableMeta, filed init copy in copy construct function
     TabletMeta(const TabletMeta& tablet_meta);
     TabletMeta(TabletMeta&& tablet_meta) = delete;
@@ -100,7 +108,9 @@ public:
     OLAPStatus deserialize(const std::string& meta_binary);
     void init_from_pb(const TabletMetaPB& tablet_meta_pb);
 
-    void to_meta_pb(TabletMetaPB* tablet_meta_pb);
+    // The delete bitmap is left out if `with_delete_bitmap` is false, it's saved to the
+    // meta store separately by save_meta().
+    void to_meta_pb(TabletMetaPB* tablet_meta_pb, bool with_delete_bitmap = true);
     void to_json(std::string* json_string, json2pb::Pb2JsonOptions& options);
     uint32_t mem_size() const;
 
@@ -167,6 +177,9 @@ public:
     // used for after tablet cloned to clear stale rowset
     void clear_stale_rowset() { _stale_rs_metas.clear(); }
 
+    bool enable_unique_key_merge_on_write() const { return _enable_unique_key_merge_on_write; }
+    DeleteBitmap& delete_bitmap() { return *_delete_bitmap; }
+
 private:
     OLAPStatus _save_meta(DataDir* data_dir);
     void _init_column_from_tcolumn(uint32_t unique_id, const TColumn& tcolumn, ColumnPB* column);
@@ -201,9 +214,71 @@ private:
     bool _in_restore_mode = false;
     RowsetTypePB _preferred_rowset_type = BETA_ROWSET;
 
+    bool _enable_unique_key_merge_on_write = false;
+    // Copied when tablet meta is copied, it is protected by its own lock.
+    DeleteBitmapPtr _delete_bitmap;
+
     RWMutex _meta_lock;
 };
 
+// Rows of a merge-on-write unique key tablet which are replaced by later loads.
+// Each entry holds the rows of one segment which are marked deleted by the load
+// of one version, a reader of version v applies the union of the entries whose
+// version is not greater than v. Thread-safe.
+class DeleteBitmap {
+public:
+    // (rowset id, segment id, version)
+    using BitmapKey = std::tuple<RowsetId, uint32_t, int64_t>;
+
+    DeleteBitmap() = default;
+    DeleteBitmap(const DeleteBitmap& other);
+    DeleteBitmap& operator=(const DeleteBitmap& other);
+
+    // Mark row `row_id` of the segment deleted at version of `bmk`.
+    void add(const BitmapKey& bmk, uint32_t row_id);
+    // Return true if the row is marked deleted exactly at version of `bmk`.
+    bool contains(const BitmapKey& bmk, uint32_t row_id) const;
+    void set(const BitmapKey& bmk, const roaring::Roaring& segment_delete_bitmap);
+    // Merge the entries of `other` into this bitmap.
+    void merge(const DeleteBitmap& other);
+
+    // Return true if the row is marked deleted at any version not greater
+    // than version of `bmk`.
+    bool contains_agg(const BitmapKey& bmk, uint32_t row_id) const;
+    // Return the union of the entries of the segment whose version is not
+    // greater than version of `bmk`, nullptr if there is no such entry.
+    std::shared_ptr<roaring::Roaring> get_agg(const BitmapKey& bmk) const;
+
+    // Remove all entries of `rowset_id`.
+    void remove_rowset(const RowsetId& rowset_id);
+    size_t num_entries() const;
+    uint64_t cardinality() const;
+
+    void init_from_pb(const DeleteBitmapPB& delete_bitmap_pb);
+    void to_pb(DeleteBitmapPB* delete_bitmap_pb) const;
+
+    // (rowset id, version), the entries of all segments of a rowset at a version are
+    // saved together under one key of the meta store, see TabletMetaManager::save_delete_bitmap().
+    using SaveKey = std::pair<RowsetId, int64_t>;
+    // Serialize the entries of `key`, return false if there is none.
+    bool to_pb(const SaveKey& key, DeleteBitmapPB* delete_bitmap_pb) const;
+    // Move the keys whose entries are updated or removed since the last call to
+    // `updated` and `removed`.
+    void take_changes(std::set<SaveKey>* updated, std::set<SaveKey>* removed);
+    // Take all the entries as updated, e.g. after they are loaded from a tablet meta file.
+    void mark_all_updated();
+
+private:
+    // the caller should hold _lock
+    void _mark_updated(const BitmapKey& bmk);
+
+    mutable RWMutex _lock;
+    std::map<BitmapKey, roaring::Roaring> _delete_bitmap;
+    // the changes not saved to the meta store yet
+    std::set<SaveKey> _updated;
+    std::set<SaveKey> _removed;
+};
+
 static const std::string SEQUENCE_COL = "__DORIS_SEQUENCE_COL__";
 
 inline TabletUid TabletMeta::tablet_uid() const {
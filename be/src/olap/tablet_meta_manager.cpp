@@ -121,6 +121,9 @@ OLAPStatus TabletMetaManager::remove(DataDir* store, TTabletId tablet_id, TSchem
     LOG(INFO) << "start to remove tablet_meta, key:" << key;
     OLAPStatus res = meta->remove(META_COLUMN_FAMILY_INDEX, key);
     LOG(INFO) << "remove tablet_meta, key:" << key << ", res:" << res;
+    if (res == OLAP_SUCCESS) {
+        res = remove_delete_bitmap(store, tablet_id, schema_hash);
+    }
     return res;
 }
 
@@ -169,4 +172,78 @@ OLAPStatus TabletMetaManager::load_json_meta(DataDir* store, const std::string&
     return save(store, tablet_id, schema_hash, meta_binary);
 }
 
+static std::string delete_bitmap_key_prefix(TTabletId tablet_id, TSchemaHash schema_hash) {
+    std::stringstream key_stream;
+    key_stream << DELETE_BITMAP_PREFIX << tablet_id << "_" << schema_hash << "_";
+    return key_stream.str();
+}
+
+OLAPStatus TabletMetaManager::save_delete_bitmap(DataDir* store, TTabletId tablet_id,
+                                                 TSchemaHash schema_hash,
+                                                 DeleteBitmap* delete_bitmap) {
+    std::set<DeleteBitmap::SaveKey> updated;
+    std::set<DeleteBitmap::SaveKey> removed;
+    delete_bitmap->take_changes(&updated, &removed);
+    if (updated.empty() && removed.empty()) {
+        return OLAP_SUCCESS;
+    }
+    OlapMeta* meta = store->get_meta();
+    std::string prefix = delete_bitmap_key_prefix(tablet_id, schema_hash);
+    auto to_key = [&prefix](const DeleteBitmap::SaveKey& save_key) {
+        return prefix + save_key.first.to_string() + "_" + std::to_string(save_key.second);
+    };
+    for (auto& save_key : removed) {
+        RETURN_NOT_OK(meta->remove(META_COLUMN_FAMILY_INDEX, to_key(save_key)));
+    }
+    for (auto& save_key : updated) {
+        DeleteBitmapPB delete_bitmap_pb;
+        // removed after the changes are taken, its key is removed by the next save
+        if (!delete_bitmap->to_pb(save_key, &delete_bitmap_pb)) {
+            continue;
+        }
+        std::string value;
+        delete_bitmap_pb.SerializeToString(&value);
+        RETURN_NOT_OK(meta->put(META_COLUMN_FAMILY_INDEX, to_key(save_key), value));
+    }
+    VLOG_NOTICE << "save delete bitmap. tablet_id=" << tablet_id << ", schema_hash=" << schema_hash
+                << ", updated=" << updated.size() << ", removed=" << removed.size();
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus TabletMetaManager::load_delete_bitmap(DataDir* store, TTabletId tablet_id,
+                                                 TSchemaHash schema_hash,
+                                                 DeleteBitmap* delete_bitmap) {
+    bool parsed = true;
+    auto load_func = [&](const std::string& key, const std::string& value) -> bool {
+        DeleteBitmapPB delete_bitmap_pb;
+        if (!delete_bitmap_pb.ParseFromString(value)) {
+            LOG(WARNING) << "parse delete bitmap failed, key:" << key;
+            parsed = false;
+            return false;
+        }
+        delete_bitmap->init_from_pb(delete_bitmap_pb);
+        return true;
+    };
+    RETURN_NOT_OK(store->get_meta()->iterate(META_COLUMN_FAMILY_INDEX,
+                                             delete_bitmap_key_prefix(tablet_id, schema_hash),
+                                             load_func));
+    return parsed ? OLAP_SUCCESS : OLAP_ERR_HEADER_PB_PARSE_FAILED;
+}
+
+OLAPStatus TabletMetaManager::remove_delete_bitmap(DataDir* store, TTabletId tablet_id,
+                                                   TSchemaHash schema_hash) {
+    OlapMeta* meta = store->get_meta();
+    std::vector<std::string> keys;
+    auto collect_func = [&keys](const std::string& key, const std::string& value) -> bool {
+        keys.push_back(key);
+        return true;
+    };
+    RETURN_NOT_OK(meta->iterate(META_COLUMN_FAMILY_INDEX,
+                                delete_bitmap_key_prefix(tablet_id, schema_hash), collect_func));
+    for (auto& key : keys) {
+        RETURN_NOT_OK(meta->remove(META_COLUMN_FAMILY_INDEX, key));
+    }
+    return OLAP_SUCCESS;
+}
+
 } // namespace doris
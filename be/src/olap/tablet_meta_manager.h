@@ -30,6 +30,9 @@ const std::string OLD_HEADER_PREFIX = "hdr_";
 
 const std::string HEADER_PREFIX = "tabletmeta_";
 
+// "dlbm_" + tablet_id + "_" + schema_hash + "_" + rowset_id + "_" + version
+const std::string DELETE_BITMAP_PREFIX = "dlbm_";
+
 // Helper Class for managing tablet headers of one root path.
 class TabletMetaManager {
 public:
@@ -54,6 +57,16 @@ public:
             const string& header_prefix = "tabletmeta_");
 
     static OLAPStatus load_json_meta(DataDir* store, const std::string& meta_path);
+
+    // The delete bitmap of a merge-on-write tablet isn't saved in the tablet meta, but under
+    // one key per (rowset, version), so saving the tablet meta only writes the entries
+    // changed since the last save.
+    static OLAPStatus save_delete_bitmap(DataDir* store, TTabletId tablet_id,
+                                         TSchemaHash schema_hash, DeleteBitmap* delete_bitmap);
+    static OLAPStatus load_delete_bitmap(DataDir* store, TTabletId tablet_id,
+                                         TSchemaHash schema_hash, DeleteBitmap* delete_bitmap);
+    static OLAPStatus remove_delete_bitmap(DataDir* store, TTabletId tablet_id,
+                                           TSchemaHash schema_hash);
 };
 
 } // namespace doris
@@ -97,7 +97,10 @@ OLAPStatus TupleReader::init(const ReaderParams& read_params) {
         _next_row_func = &TupleReader::_direct_next_row;
         break;
     case KeysType::UNIQUE_KEYS:
-        _next_row_func = &TupleReader::_unique_key_next_row;
+        // rows of merge-on-write unique key tablet are already deduplicated by delete bitmap
+        _next_row_func = _tablet->enable_unique_key_merge_on_write() && _reader_type == READER_QUERY
+                                 ? &TupleReader::_direct_next_row
+                                 : &TupleReader::_unique_key_next_row;
         break;
     case KeysType::AGG_KEYS:
         _next_row_func = &TupleReader::_agg_key_next_row;
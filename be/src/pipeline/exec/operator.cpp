@@ -0,0 +1,72 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "pipeline/exec/operator.h"
+
+#include "exec/data_sink.h"
+#include "vec/core/block.h"
+#include "vec/exec/vexchange_node.h"
+#include "vec/exec/volap_scan_node.h"
+
+namespace doris::pipeline {
+
+template <>
+Status ExchangeSourceOperator::open(RuntimeState* state) {
+    return _node->open(state);
+}
+
+// The scan is started after the runtime filters are ready or timed out, can_read() is false
+// until then.
+template <>
+Status OlapScanSourceOperator::open(RuntimeState* state) {
+    _node->set_wait_runtime_filters_in_open(false);
+    return _node->open(state);
+}
+
+template <>
+Status OlapScanSourceOperator::get_block(RuntimeState* state, vectorized::Block* block,
+                                         bool* eos) {
+    if (!_node->started()) {
+        RETURN_IF_ERROR(_node->start(state));
+        if (!_node->ready_to_read()) {
+            // get_next() would wait for the first block of the scanners
+            return Status::OK();
+        }
+    }
+    return _node->get_next(state, block, eos);
+}
+
+DataSinkOperator::DataSinkOperator(DataSink* sink)
+        : SinkOperator("DataSinkOperator"), _sink(sink) {}
+
+Status DataSinkOperator::open(RuntimeState* state) {
+    _sink->set_non_blocking();
+    return _sink->open(state);
+}
+
+bool DataSinkOperator::can_write() {
+    return _sink->can_write();
+}
+
+Status DataSinkOperator::sink(RuntimeState* state, vectorized::Block* block, bool eos) {
+    if (block->rows() == 0) {
+        return Status::OK();
+    }
+    return _sink->send(state, block);
+}
+
+} // namespace doris::pipeline
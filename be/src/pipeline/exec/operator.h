@@ -0,0 +1,207 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <string>
+
+#include "common/status.h"
+#include "exec/exec_node.h"
+#include "util/runtime_profile.h"
+
+namespace doris {
+
+class DataSink;
+class RuntimeState;
+
+namespace vectorized {
+class Block;
+class AggregationNode;
+class HashJoinNode;
+class VExchangeNode;
+class VOlapScanNode;
+class VSortNode;
+} // namespace vectorized
+
+namespace pipeline {
+
+// Operators are the stages of a Pipeline. A pipeline has one SourceOperator, zero or more
+// streaming Operators and one SinkOperator. None of the calls waits for other pipelines
+// or for the network: a task checks can_read() of the source and can_write() of the sink
+// before calling them, and gives up the worker thread if they are not ready.
+//
+// Operators don't own the exec nodes they wrap, the nodes are closed together with the plan
+// tree when the fragment is done.
+class OperatorBase {
+public:
+    explicit OperatorBase(std::string name) : _name(std::move(name)) {}
+    virtual ~OperatorBase() = default;
+
+    // Called in the first run of the task.
+    virtual Status open(RuntimeState* state) { return Status::OK(); }
+    // Called when the task is finished or cancelled, maybe without open().
+    virtual Status close(RuntimeState* state) { return Status::OK(); }
+
+    const std::string& name() const { return _name; }
+
+private:
+    std::string _name;
+};
+
+class SourceOperator : public OperatorBase {
+public:
+    using OperatorBase::OperatorBase;
+
+    // Returns false if get_block() would wait for data. get_block() may still return an empty
+    // block without eos if it has no data, then the task checks can_read() again.
+    virtual bool can_read() { return true; }
+    virtual Status get_block(RuntimeState* state, vectorized::Block* block, bool* eos) = 0;
+};
+
+// A streaming operator, which processes the input block by block.
+class Operator : public OperatorBase {
+public:
+    using OperatorBase::OperatorBase;
+
+    // True if the last pushed block is consumed by pull(), and the input isn't finished.
+    virtual bool need_more_input_data() const = 0;
+    virtual Status push(RuntimeState* state, vectorized::Block* input_block, bool eos) = 0;
+    virtual Status pull(RuntimeState* state, vectorized::Block* output_block, bool* eos) = 0;
+};
+
+class SinkOperator : public OperatorBase {
+public:
+    using OperatorBase::OperatorBase;
+
+    // Returns false if sink() would wait for the receiver.
+    virtual bool can_write() { return true; }
+    virtual Status sink(RuntimeState* state, vectorized::Block* block, bool eos) = 0;
+};
+
+// Source of a leaf node which buffers its input in other threads, e.g. exchange and scan.
+template <typename NodeType>
+class BufferedSourceOperator final : public SourceOperator {
+public:
+    BufferedSourceOperator(std::string name, NodeType* node)
+            : SourceOperator(std::move(name)), _node(node) {}
+
+    Status open(RuntimeState* state) override;
+    bool can_read() override { return _node->ready_to_read(); }
+    Status get_block(RuntimeState* state, vectorized::Block* block, bool* eos) override {
+        return _node->get_next(state, block, eos);
+    }
+
+private:
+    NodeType* _node;
+};
+
+using ExchangeSourceOperator = BufferedSourceOperator<vectorized::VExchangeNode>;
+using OlapScanSourceOperator = BufferedSourceOperator<vectorized::VOlapScanNode>;
+
+template <>
+Status ExchangeSourceOperator::open(RuntimeState* state);
+template <>
+Status OlapScanSourceOperator::open(RuntimeState* state);
+template <>
+Status OlapScanSourceOperator::get_block(RuntimeState* state, vectorized::Block* block, bool* eos);
+
+// The sink side of a pipeline breaker, e.g. hash table build, blocking aggregation and sort.
+template <typename NodeType>
+class NodeSinkOperator final : public SinkOperator {
+public:
+    NodeSinkOperator(std::string name, NodeType* node)
+            : SinkOperator(std::move(name)), _node(node) {}
+
+    Status open(RuntimeState* state) override { return _node->alloc_resource(state); }
+    Status sink(RuntimeState* state, vectorized::Block* block, bool eos) override {
+        SCOPED_TIMER(_node->runtime_profile()->total_time_counter());
+        return _node->sink(state, block, eos);
+    }
+
+private:
+    NodeType* _node;
+};
+
+// The source side of a pipeline breaker, its pipeline runs after the sink side finished.
+template <typename NodeType>
+class NodeSourceOperator final : public SourceOperator {
+public:
+    NodeSourceOperator(std::string name, NodeType* node)
+            : SourceOperator(std::move(name)), _node(node) {}
+
+    Status get_block(RuntimeState* state, vectorized::Block* block, bool* eos) override {
+        SCOPED_TIMER(_node->runtime_profile()->total_time_counter());
+        return _node->pull(state, block, eos);
+    }
+
+private:
+    NodeType* _node;
+};
+
+// A node which processes its input block by block, e.g. hash join probe and streaming
+// preaggregation.
+template <typename NodeType>
+class NodeStreamingOperator final : public Operator {
+public:
+    NodeStreamingOperator(std::string name, NodeType* node)
+            : Operator(std::move(name)), _node(node) {}
+
+    // The node is opened by the sink of its build side if there is one.
+    Status open(RuntimeState* state) override {
+        return _open_node ? _node->alloc_resource(state) : Status::OK();
+    }
+    bool need_more_input_data() const override { return _node->need_more_input_data(); }
+    Status push(RuntimeState* state, vectorized::Block* input_block, bool eos) override {
+        SCOPED_TIMER(_node->runtime_profile()->total_time_counter());
+        return _node->push(state, input_block, eos);
+    }
+    Status pull(RuntimeState* state, vectorized::Block* output_block, bool* eos) override {
+        SCOPED_TIMER(_node->runtime_profile()->total_time_counter());
+        return _node->pull(state, output_block, eos);
+    }
+
+    void set_open_node(bool open_node) { _open_node = open_node; }
+
+private:
+    NodeType* _node;
+    bool _open_node = true;
+};
+
+using AggSinkOperator = NodeSinkOperator<vectorized::AggregationNode>;
+using AggSourceOperator = NodeSourceOperator<vectorized::AggregationNode>;
+using StreamingAggOperator = NodeStreamingOperator<vectorized::AggregationNode>;
+using SortSinkOperator = NodeSinkOperator<vectorized::VSortNode>;
+using SortSourceOperator = NodeSourceOperator<vectorized::VSortNode>;
+using HashJoinBuildSinkOperator = NodeSinkOperator<vectorized::HashJoinNode>;
+using HashJoinProbeOperator = NodeStreamingOperator<vectorized::HashJoinNode>;
+
+// Sends the result of the fragment to the data sink. The sink is closed by the
+// PlanFragmentExecutor with the final status of the fragment.
+class DataSinkOperator final : public SinkOperator {
+public:
+    explicit DataSinkOperator(DataSink* sink);
+
+    Status open(RuntimeState* state) override;
+    bool can_write() override;
+    Status sink(RuntimeState* state, vectorized::Block* block, bool eos) override;
+
+private:
+    DataSink* _sink;
+};
+
+} // namespace pipeline
+} // namespace doris
@@ -0,0 +1,58 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "pipeline/pipeline.h"
+
+#include <sstream>
+
+#include "gutil/strings/substitute.h"
+
+namespace doris::pipeline {
+
+Status Pipeline::check() const {
+    if (_source == nullptr || _sink == nullptr) {
+        return Status::InternalError(
+                strings::Substitute("pipeline $0 has no source or sink", _id));
+    }
+    return Status::OK();
+}
+
+bool Pipeline::dependencies_finished() const {
+    for (auto& dependency : _dependencies) {
+        if (!dependency->is_finished()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string Pipeline::debug_string() const {
+    std::stringstream ss;
+    ss << "Pipeline(id=" << _id << ", operators=["
+       << (_source == nullptr ? "null" : _source->name());
+    for (auto& op : _operators) {
+        ss << ", " << op->name();
+    }
+    ss << ", " << (_sink == nullptr ? "null" : _sink->name()) << "], dependencies=[";
+    for (int i = 0; i < _dependencies.size(); ++i) {
+        ss << (i > 0 ? ", " : "") << _dependencies[i]->id();
+    }
+    ss << "])";
+    return ss.str();
+}
+
+} // namespace doris::pipeline
@@ -0,0 +1,69 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "pipeline/exec/operator.h"
+
+namespace doris::pipeline {
+
+class Pipeline;
+using PipelinePtr = std::shared_ptr<Pipeline>;
+using PipelineId = uint32_t;
+
+// A chain of operators of a fragment, from a source to a sink, which runs without waiting
+// for other pipelines. The fragment is split into pipelines at the pipeline breakers,
+// e.g. the build side of a hash join is a pipeline ending with the hash table build sink,
+// and the probe side is another pipeline which depends on it.
+class Pipeline {
+public:
+    explicit Pipeline(PipelineId id) : _id(id) {}
+
+    void set_source(std::unique_ptr<SourceOperator> source) { _source = std::move(source); }
+    // Operators are added from the source to the sink.
+    void add_operator(std::unique_ptr<Operator> op) { _operators.emplace_back(std::move(op)); }
+    void set_sink(std::unique_ptr<SinkOperator> sink) { _sink = std::move(sink); }
+    // This pipeline can't start until 'pipeline' is finished.
+    void add_dependency(const PipelinePtr& pipeline) { _dependencies.push_back(pipeline); }
+
+    Status check() const;
+    bool dependencies_finished() const;
+
+    void set_finished() { _finished.store(true, std::memory_order_release); }
+    bool is_finished() const { return _finished.load(std::memory_order_acquire); }
+
+    PipelineId id() const { return _id; }
+    SourceOperator* source() const { return _source.get(); }
+    const std::vector<std::unique_ptr<Operator>>& operators() const { return _operators; }
+    SinkOperator* sink() const { return _sink.get(); }
+
+    std::string debug_string() const;
+
+private:
+    PipelineId _id;
+    std::unique_ptr<SourceOperator> _source;
+    std::vector<std::unique_ptr<Operator>> _operators;
+    std::unique_ptr<SinkOperator> _sink;
+    std::vector<PipelinePtr> _dependencies;
+    std::atomic<bool> _finished {false};
+};
+
+} // namespace doris::pipeline
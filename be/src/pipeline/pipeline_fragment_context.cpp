@@ -0,0 +1,165 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "pipeline/pipeline_fragment_context.h"
+
+#include "exec/data_sink.h"
+#include "exec/exec_node.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "gutil/strings/substitute.h"
+#include "pipeline/task_scheduler.h"
+#include "runtime/runtime_state.h"
+#include "vec/exec/join/vhash_join_node.h"
+#include "vec/exec/vaggregation_node.h"
+#include "vec/exec/vexchange_node.h"
+#include "vec/exec/volap_scan_node.h"
+#include "vec/exec/vsort_node.h"
+
+namespace doris::pipeline {
+
+PipelineFragmentContext::PipelineFragmentContext(RuntimeState* state, ExecNode* plan,
+                                                 DataSink* sink, FinishCallback callback)
+        : _runtime_state(state), _plan(plan), _sink(sink), _callback(std::move(callback)) {}
+
+PipelinePtr PipelineFragmentContext::_add_pipeline() {
+    auto pipeline = std::make_shared<Pipeline>(_pipelines.size());
+    _pipelines.push_back(pipeline);
+    return pipeline;
+}
+
+bool PipelineFragmentContext::is_supported(ExecNode* node) {
+    switch (node->type()) {
+    case TPlanNodeType::EXCHANGE_NODE:
+    case TPlanNodeType::OLAP_SCAN_NODE:
+        return true;
+    case TPlanNodeType::AGGREGATION_NODE:
+    case TPlanNodeType::SORT_NODE:
+        return is_supported(node->child(0));
+    case TPlanNodeType::HASH_JOIN_NODE:
+        return is_supported(node->child(0)) && is_supported(node->child(1));
+    default:
+        return false;
+    }
+}
+
+Status PipelineFragmentContext::prepare() {
+    auto root = _add_pipeline();
+    RETURN_IF_ERROR(_build_pipelines(_plan, root));
+    root->set_sink(std::make_unique<DataSinkOperator>(_sink));
+    for (auto& pipeline : _pipelines) {
+        RETURN_IF_ERROR(pipeline->check());
+    }
+    return Status::OK();
+}
+
+Status PipelineFragmentContext::_build_pipelines(ExecNode* node, const PipelinePtr& cur_pipe) {
+    switch (node->type()) {
+    case TPlanNodeType::EXCHANGE_NODE: {
+        cur_pipe->set_source(std::make_unique<ExchangeSourceOperator>(
+                "ExchangeSourceOperator", static_cast<vectorized::VExchangeNode*>(node)));
+        break;
+    }
+    case TPlanNodeType::OLAP_SCAN_NODE: {
+        cur_pipe->set_source(std::make_unique<OlapScanSourceOperator>(
+                "OlapScanSourceOperator", static_cast<vectorized::VOlapScanNode*>(node)));
+        break;
+    }
+    case TPlanNodeType::AGGREGATION_NODE: {
+        auto* agg_node = static_cast<vectorized::AggregationNode*>(node);
+        if (agg_node->is_streaming_preagg()) {
+            RETURN_IF_ERROR(_build_pipelines(node->child(0), cur_pipe));
+            cur_pipe->add_operator(
+                    std::make_unique<StreamingAggOperator>("StreamingAggOperator", agg_node));
+        } else {
+            auto sink_pipe = _add_pipeline();
+            RETURN_IF_ERROR(_build_pipelines(node->child(0), sink_pipe));
+            sink_pipe->set_sink(std::make_unique<AggSinkOperator>("AggSinkOperator", agg_node));
+            cur_pipe->set_source(
+                    std::make_unique<AggSourceOperator>("AggSourceOperator", agg_node));
+            cur_pipe->add_dependency(sink_pipe);
+        }
+        break;
+    }
+    case TPlanNodeType::SORT_NODE: {
+        auto* sort_node = static_cast<vectorized::VSortNode*>(node);
+        auto sink_pipe = _add_pipeline();
+        RETURN_IF_ERROR(_build_pipelines(node->child(0), sink_pipe));
+        sink_pipe->set_sink(std::make_unique<SortSinkOperator>("SortSinkOperator", sort_node));
+        cur_pipe->set_source(std::make_unique<SortSourceOperator>("SortSourceOperator", sort_node));
+        cur_pipe->add_dependency(sink_pipe);
+        break;
+    }
+    case TPlanNodeType::HASH_JOIN_NODE: {
+        auto* join_node = static_cast<vectorized::HashJoinNode*>(node);
+        auto build_pipe = _add_pipeline();
+        RETURN_IF_ERROR(_build_pipelines(node->child(1), build_pipe));
+        build_pipe->set_sink(
+                std::make_unique<HashJoinBuildSinkOperator>("HashJoinBuildSinkOperator", join_node));
+
+        RETURN_IF_ERROR(_build_pipelines(node->child(0), cur_pipe));
+        auto probe = std::make_unique<HashJoinProbeOperator>("HashJoinProbeOperator", join_node);
+        // the node is opened by the build sink, which always runs before the probe
+        probe->set_open_node(false);
+        cur_pipe->add_operator(std::move(probe));
+        cur_pipe->add_dependency(build_pipe);
+        break;
+    }
+    default:
+        return Status::NotSupported(strings::Substitute(
+                "node $0 is not supported by the pipeline engine", node->type()));
+    }
+    return Status::OK();
+}
+
+void PipelineFragmentContext::submit(TaskScheduler* scheduler) {
+    for (auto& pipeline : _pipelines) {
+        _tasks.emplace_back(new PipelineTask(pipeline.get(), _runtime_state, this,
+                                             _runtime_state->runtime_profile()));
+    }
+    // The tasks may be finished and closed before submit() returns.
+    std::vector<PipelineTask*> tasks;
+    for (auto& task : _tasks) {
+        tasks.push_back(task.get());
+    }
+    for (auto* task : tasks) {
+        scheduler->submit(task);
+    }
+}
+
+void PipelineFragmentContext::close_a_task(PipelineTask* task, const Status& status) {
+    Status close_status = task->close();
+    FinishCallback callback;
+    Status final_status;
+    {
+        std::lock_guard<std::mutex> l(_status_lock);
+        const Status& task_status = status.ok() ? close_status : status;
+        if (!task_status.ok() && _status.ok()) {
+            _status = task_status;
+            // stop the other tasks of this fragment
+            _runtime_state->set_is_cancelled(true);
+        }
+        if (++_closed_tasks < _tasks.size()) {
+            return;
+        }
+        callback = std::move(_callback);
+        final_status = _status;
+    }
+    // The context may be released in the callback.
+    callback(final_status);
+}
+
+} // namespace doris::pipeline
@@ -0,0 +1,87 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "common/status.h"
+#include "pipeline/pipeline.h"
+#include "pipeline/pipeline_task.h"
+
+namespace doris {
+
+class DataSink;
+class ExecNode;
+class RuntimeState;
+
+namespace pipeline {
+
+class TaskScheduler;
+
+// Splits the plan of a fragment instance into pipelines, and runs them as PipelineTasks
+// in the TaskScheduler. The plan tree and the data sink are owned by the caller, and must
+// be alive until the finish callback is called.
+class PipelineFragmentContext : public std::enable_shared_from_this<PipelineFragmentContext> {
+public:
+    // Called once when all tasks are closed, with the first error of the tasks.
+    using FinishCallback = std::function<void(const Status&)>;
+
+    PipelineFragmentContext(RuntimeState* state, ExecNode* plan, DataSink* sink,
+                            FinishCallback callback);
+
+    // True if every node of the plan can be split into pipelines. The other plans are run
+    // by the thread-pool executor, a node running through the blocking get_next() would
+    // occupy a worker of the scheduler.
+    static bool is_supported(ExecNode* plan);
+
+    Status prepare();
+    // Submit the tasks of all pipelines, the pipelines depending on others wait in the
+    // scheduler until their dependencies are finished.
+    void submit(TaskScheduler* scheduler);
+
+    // Called by the scheduler when a task is finished or failed. The task must not be
+    // used after this call.
+    void close_a_task(PipelineTask* task, const Status& status);
+
+    RuntimeState* runtime_state() const { return _runtime_state; }
+    const std::vector<PipelinePtr>& pipelines() const { return _pipelines; }
+
+private:
+    PipelinePtr _add_pipeline();
+    // Add the operators of the subtree 'node' to 'cur_pipe', the subtree may be split into
+    // new pipelines at the pipeline breakers.
+    Status _build_pipelines(ExecNode* node, const PipelinePtr& cur_pipe);
+
+    RuntimeState* _runtime_state;
+    ExecNode* _plan;
+    DataSink* _sink;
+    FinishCallback _callback;
+
+    std::vector<PipelinePtr> _pipelines;
+    std::vector<std::unique_ptr<PipelineTask>> _tasks;
+
+    std::mutex _status_lock;
+    Status _status;
+    int _closed_tasks = 0;
+};
+
+} // namespace pipeline
+} // namespace doris
@@ -0,0 +1,186 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "pipeline/pipeline_task.h"
+
+#include <sstream>
+
+#include "common/config.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/runtime_state.h"
+#include "util/time.h"
+#include "vec/core/block.h"
+
+namespace doris::pipeline {
+
+const char* get_state_name(PipelineTaskState state) {
+    switch (state) {
+    case PipelineTaskState::BLOCKED_FOR_DEPENDENCY:
+        return "BLOCKED_FOR_DEPENDENCY";
+    case PipelineTaskState::BLOCKED_FOR_SOURCE:
+        return "BLOCKED_FOR_SOURCE";
+    case PipelineTaskState::BLOCKED_FOR_SINK:
+        return "BLOCKED_FOR_SINK";
+    case PipelineTaskState::RUNNABLE:
+        return "RUNNABLE";
+    case PipelineTaskState::FINISHED:
+        return "FINISHED";
+    }
+    return "UNKNOWN";
+}
+
+PipelineTask::PipelineTask(Pipeline* pipeline, RuntimeState* state,
+                           PipelineFragmentContext* fragment_context,
+                           RuntimeProfile* parent_profile)
+        : _pipeline(pipeline),
+          _runtime_state(state),
+          _fragment_context(fragment_context),
+          _state(PipelineTaskState::BLOCKED_FOR_DEPENDENCY) {
+    _task_profile = parent_profile->create_child(
+            strings::Substitute("PipelineTask (pipeline_id=$0)", pipeline->id()));
+    _exec_timer = ADD_TIMER(_task_profile, "ExecuteTime");
+    _schedule_counter = ADD_COUNTER(_task_profile, "ScheduleCount", TUnit::UNIT);
+    _yield_counter = ADD_COUNTER(_task_profile, "YieldCount", TUnit::UNIT);
+    _wait_source_counter = ADD_COUNTER(_task_profile, "WaitSourceCount", TUnit::UNIT);
+    _wait_sink_counter = ADD_COUNTER(_task_profile, "WaitSinkCount", TUnit::UNIT);
+}
+
+Status PipelineTask::_open() {
+    RETURN_IF_ERROR(_pipeline->source()->open(_runtime_state));
+    for (auto& op : _pipeline->operators()) {
+        RETURN_IF_ERROR(op->open(_runtime_state));
+    }
+    RETURN_IF_ERROR(_pipeline->sink()->open(_runtime_state));
+    _opened = true;
+    return Status::OK();
+}
+
+Status PipelineTask::execute(bool* eos) {
+    SCOPED_TIMER(_exec_timer);
+    COUNTER_UPDATE(_schedule_counter, 1);
+    *eos = false;
+    RETURN_IF_CANCELLED(_runtime_state);
+    if (!_opened) {
+        RETURN_IF_ERROR(_open());
+    }
+
+    int64_t time_slice_ns = config::pipeline_task_time_slice_ms * 1000L * 1000L;
+    int64_t start_time = MonotonicNanos();
+    const int num_operators = _pipeline->operators().size();
+    while (true) {
+        RETURN_IF_CANCELLED(_runtime_state);
+        if (MonotonicNanos() - start_time > time_slice_ns) {
+            COUNTER_UPDATE(_yield_counter, 1);
+            _set_state(PipelineTaskState::RUNNABLE);
+            return Status::OK();
+        }
+        if (!_pipeline->sink()->can_write()) {
+            COUNTER_UPDATE(_wait_sink_counter, 1);
+            _set_state(PipelineTaskState::BLOCKED_FOR_SINK);
+            return Status::OK();
+        }
+
+        vectorized::Block block;
+        bool pipeline_eos = false;
+        bool blocked = false;
+        RETURN_IF_ERROR(_get_block(num_operators - 1, &block, &pipeline_eos, &blocked));
+        if (blocked) {
+            COUNTER_UPDATE(_wait_source_counter, 1);
+            _set_state(PipelineTaskState::BLOCKED_FOR_SOURCE);
+            return Status::OK();
+        }
+
+        RETURN_IF_ERROR(_pipeline->sink()->sink(_runtime_state, &block, pipeline_eos));
+        if (pipeline_eos) {
+            _set_state(PipelineTaskState::FINISHED);
+            *eos = true;
+            return Status::OK();
+        }
+    }
+}
+
+Status PipelineTask::_get_block(int idx, vectorized::Block* block, bool* eos, bool* blocked) {
+    if (idx < 0) {
+        auto* source = _pipeline->source();
+        if (!source->can_read()) {
+            *blocked = true;
+            return Status::OK();
+        }
+        RETURN_IF_ERROR(source->get_block(_runtime_state, block, eos));
+        *blocked = !*eos && block->rows() == 0;
+        return Status::OK();
+    }
+
+    auto& op = _pipeline->operators()[idx];
+    while (op->need_more_input_data()) {
+        vectorized::Block input_block;
+        bool input_eos = false;
+        RETURN_IF_ERROR(_get_block(idx - 1, &input_block, &input_eos, blocked));
+        if (*blocked) {
+            return Status::OK();
+        }
+        RETURN_IF_ERROR(op->push(_runtime_state, &input_block, input_eos));
+    }
+    return op->pull(_runtime_state, block, eos);
+}
+
+Status PipelineTask::close() {
+    Status status = _pipeline->source()->close(_runtime_state);
+    for (auto& op : _pipeline->operators()) {
+        Status st = op->close(_runtime_state);
+        if (status.ok()) {
+            status = st;
+        }
+    }
+    Status st = _pipeline->sink()->close(_runtime_state);
+    if (status.ok()) {
+        status = st;
+    }
+    _set_state(PipelineTaskState::FINISHED);
+    _pipeline->set_finished();
+    return status;
+}
+
+bool PipelineTask::is_ready() {
+    switch (_state) {
+    case PipelineTaskState::BLOCKED_FOR_DEPENDENCY:
+        return _pipeline->dependencies_finished();
+    case PipelineTaskState::BLOCKED_FOR_SOURCE:
+        return _pipeline->source()->can_read();
+    case PipelineTaskState::BLOCKED_FOR_SINK:
+        return _pipeline->sink()->can_write();
+    default:
+        return true;
+    }
+}
+
+bool PipelineTask::is_cancelled() const {
+    return _runtime_state->is_cancelled();
+}
+
+void PipelineTask::_set_state(PipelineTaskState state) {
+    _state = state;
+}
+
+std::string PipelineTask::debug_string() const {
+    std::stringstream ss;
+    ss << "PipelineTask(state=" << get_state_name(_state) << ", opened=" << _opened
+       << ", pipeline=" << _pipeline->debug_string() << ")";
+    return ss.str();
+}
+
+} // namespace doris::pipeline
@@ -0,0 +1,97 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <string>
+
+#include "common/status.h"
+#include "pipeline/pipeline.h"
+#include "util/runtime_profile.h"
+
+namespace doris {
+
+class RuntimeState;
+
+namespace pipeline {
+
+class PipelineFragmentContext;
+
+enum class PipelineTaskState : uint8_t {
+    // Waiting for the pipelines it depends on.
+    BLOCKED_FOR_DEPENDENCY = 0,
+    BLOCKED_FOR_SOURCE = 1,
+    BLOCKED_FOR_SINK = 2,
+    RUNNABLE = 3,
+    FINISHED = 4,
+};
+
+const char* get_state_name(PipelineTaskState state);
+
+// The execution of a Pipeline in a fragment instance. A task is run by at most one worker
+// thread of the TaskScheduler at a time, and gives up the thread when it can't make progress
+// or its time slice is used up, instead of waiting in the thread.
+class PipelineTask {
+public:
+    PipelineTask(Pipeline* pipeline, RuntimeState* state, PipelineFragmentContext* fragment_context,
+                 RuntimeProfile* parent_profile);
+
+    // Run the pipeline until the source or the sink isn't ready, the pipeline is finished, or
+    // the time slice is used up. state() tells which one happened if eos is false.
+    Status execute(bool* eos);
+
+    // Close the operators, and mark the pipeline as finished so that the pipelines
+    // depending on it can start. Called once, even if execute() failed.
+    Status close();
+
+    // Called by the scheduler to check whether a blocked task can run.
+    bool is_ready();
+
+    bool is_cancelled() const;
+
+    PipelineTaskState state() const { return _state; }
+    PipelineFragmentContext* fragment_context() const { return _fragment_context; }
+
+    int previous_core_id() const { return _previous_core_id; }
+    void set_previous_core_id(int id) { _previous_core_id = id; }
+
+    std::string debug_string() const;
+
+private:
+    Status _open();
+    // Get a block from the idx-th streaming operator, -1 means the source. 'blocked' is
+    // set if the source isn't ready, then the pushed blocks are kept in the operators.
+    Status _get_block(int idx, vectorized::Block* block, bool* eos, bool* blocked);
+    void _set_state(PipelineTaskState state);
+
+    Pipeline* _pipeline;
+    RuntimeState* _runtime_state;
+    PipelineFragmentContext* _fragment_context;
+    PipelineTaskState _state;
+    bool _opened = false;
+    int _previous_core_id = -1;
+
+    RuntimeProfile* _task_profile;
+    RuntimeProfile::Counter* _exec_timer;
+    RuntimeProfile::Counter* _schedule_counter;
+    RuntimeProfile::Counter* _yield_counter;
+    RuntimeProfile::Counter* _wait_source_counter;
+    RuntimeProfile::Counter* _wait_sink_counter;
+};
+
+} // namespace pipeline
+} // namespace doris
@@ -0,0 +1,218 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "pipeline/task_scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "gutil/strings/substitute.h"
+#include "pipeline/pipeline_fragment_context.h"
+#include "pipeline/pipeline_task.h"
+#include "runtime/exec_env.h"
+#include "util/cpu_info.h"
+#include "util/thread.h"
+
+namespace doris::pipeline {
+
+// The tasks are woken up by the events they wait for, the interval only bounds the latency
+// of the events which aren't signalled, e.g. cancellation.
+static constexpr std::chrono::milliseconds kSafetyNetPollInterval(100);
+
+TaskScheduler::TaskScheduler(int num_workers)
+        : _num_workers(num_workers > 0 ? num_workers : CpuInfo::num_cores()) {
+    for (int i = 0; i < _num_workers; ++i) {
+        _queues.emplace_back(new WorkQueue());
+    }
+}
+
+TaskScheduler::~TaskScheduler() {
+    shutdown();
+}
+
+Status TaskScheduler::start() {
+    for (int i = 0; i < _num_workers; ++i) {
+        scoped_refptr<Thread> thread;
+        RETURN_IF_ERROR(Thread::create("pipeline", strings::Substitute("pipeline_worker_$0", i),
+                                       [this, i]() { _worker_loop(i); }, &thread));
+        _workers.push_back(thread);
+    }
+    RETURN_IF_ERROR(Thread::create(
+            "pipeline", "pipeline_blocked_poller", [this]() { _poll_blocked_tasks(); }, &_poller));
+    return Status::OK();
+}
+
+void TaskScheduler::shutdown() {
+    if (_shutdown.exchange(true)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> l(_wait_lock);
+        _wait_cv.notify_all();
+    }
+    {
+        std::lock_guard<std::mutex> l(_blocked_lock);
+        _blocked_cv.notify_all();
+    }
+    for (auto& thread : _workers) {
+        thread->join();
+    }
+    if (_poller) {
+        _poller->join();
+    }
+}
+
+void TaskScheduler::submit(PipelineTask* task) {
+    if (task->state() == PipelineTaskState::BLOCKED_FOR_DEPENDENCY && !task->is_ready()) {
+        _add_blocked(task);
+        return;
+    }
+    _enqueue(_next_queue.fetch_add(1, std::memory_order_relaxed) % _num_workers, task);
+}
+
+void TaskScheduler::wake_up() {
+    if (_num_blocked_tasks.load(std::memory_order_acquire) == 0) {
+        // a task blocked concurrently is checked after it's added
+        return;
+    }
+    std::lock_guard<std::mutex> l(_blocked_lock);
+    _num_blocked_events++;
+    _blocked_cv.notify_one();
+}
+
+void TaskScheduler::_enqueue(int worker_id, PipelineTask* task) {
+    {
+        std::lock_guard<std::mutex> l(_queues[worker_id]->lock);
+        _queues[worker_id]->tasks.push_back(task);
+    }
+    std::lock_guard<std::mutex> l(_wait_lock);
+    _num_queued++;
+    _wait_cv.notify_one();
+}
+
+PipelineTask* TaskScheduler::_take_task(int worker_id) {
+    PipelineTask* task = nullptr;
+    {
+        auto& queue = *_queues[worker_id];
+        std::lock_guard<std::mutex> l(queue.lock);
+        if (!queue.tasks.empty()) {
+            task = queue.tasks.front();
+            queue.tasks.pop_front();
+        }
+    }
+    for (int i = 1; task == nullptr && i < _num_workers; ++i) {
+        auto& queue = *_queues[(worker_id + i) % _num_workers];
+        std::lock_guard<std::mutex> l(queue.lock);
+        if (!queue.tasks.empty()) {
+            task = queue.tasks.back();
+            queue.tasks.pop_back();
+        }
+    }
+    if (task != nullptr) {
+        std::lock_guard<std::mutex> l(_wait_lock);
+        _num_queued--;
+    }
+    return task;
+}
+
+void TaskScheduler::_worker_loop(int worker_id) {
+    while (!_shutdown) {
+        PipelineTask* task = _take_task(worker_id);
+        if (task == nullptr) {
+            std::unique_lock<std::mutex> l(_wait_lock);
+            // The timeout is a safety net, a task is always queued before _num_queued is
+            // increased under _wait_lock.
+            _wait_cv.wait_for(l, std::chrono::milliseconds(100),
+                              [this]() { return _num_queued > 0 || _shutdown; });
+            continue;
+        }
+
+        task->set_previous_core_id(worker_id);
+        bool eos = false;
+        Status status = task->execute(&eos);
+        if (!status.ok() || eos) {
+            _close_task(task, status);
+            continue;
+        }
+
+        if (task->state() == PipelineTaskState::RUNNABLE) {
+            _enqueue(worker_id, task);
+        } else {
+            _add_blocked(task);
+        }
+    }
+}
+
+void TaskScheduler::_close_task(PipelineTask* task, const Status& status) {
+    // The task and the fragment context may be released by the last close_a_task(),
+    // hold the context until the call returns.
+    auto context = task->fragment_context()->shared_from_this();
+    context->close_a_task(task, status);
+    // the pipelines depending on the closed one may be ready
+    wake_up();
+}
+
+void TaskScheduler::_add_blocked(PipelineTask* task) {
+    _num_blocked_tasks.fetch_add(1, std::memory_order_acq_rel);
+    std::lock_guard<std::mutex> l(_blocked_lock);
+    _blocked_tasks.push_back(task);
+    // check it at once, the event it waits for may have happened before it's added
+    _num_blocked_events++;
+    _blocked_cv.notify_one();
+}
+
+void TaskScheduler::_poll_blocked_tasks() {
+    std::list<PipelineTask*> tasks;
+    uint64_t num_checked_events = 0;
+    while (!_shutdown) {
+        {
+            std::unique_lock<std::mutex> l(_blocked_lock);
+            _blocked_tasks.splice(_blocked_tasks.end(), tasks);
+            _blocked_cv.wait_for(l, kSafetyNetPollInterval, [&]() {
+                return _num_blocked_events != num_checked_events || _shutdown;
+            });
+            num_checked_events = _num_blocked_events;
+            // Check the tasks without holding _blocked_lock, is_ready() takes the locks of
+            // the operators, and wake_up() may be called with them held.
+            tasks.swap(_blocked_tasks);
+        }
+
+        for (auto it = tasks.begin(); it != tasks.end();) {
+            PipelineTask* task = *it;
+            if (!task->is_cancelled() && !task->is_ready()) {
+                ++it;
+                continue;
+            }
+            it = tasks.erase(it);
+            _num_blocked_tasks.fetch_sub(1, std::memory_order_acq_rel);
+            int worker_id = task->previous_core_id();
+            if (worker_id < 0) {
+                worker_id = _next_queue.fetch_add(1, std::memory_order_relaxed) % _num_workers;
+            }
+            _enqueue(worker_id, task);
+        }
+    }
+}
+
+void wake_up_blocked_tasks() {
+    auto* scheduler = ExecEnv::GetInstance()->pipeline_task_scheduler();
+    if (scheduler != nullptr) {
+        scheduler->wake_up();
+    }
+}
+
+} // namespace doris::pipeline
@@ -0,0 +1,108 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "common/status.h"
+#include "gutil/ref_counted.h"
+
+namespace doris {
+
+class Thread;
+
+namespace pipeline {
+
+class PipelineTask;
+
+// Runs the PipelineTasks of all queries in a fixed number of worker threads.
+//
+// Each worker has its own run queue. A worker takes tasks from the front of its own queue,
+// and steals from the back of the other queues when its own is empty. A task which yields
+// after its time slice goes to the back of the queue of the worker that ran it, so a long
+// running pipeline doesn't starve the others.
+// Blocked tasks are kept in a separate list, and a poller thread puts the ready or cancelled
+// ones back to the queue of the worker which ran them last. The poller checks the list when
+// a task is blocked and when wake_up() is called by the event a task may wait for, e.g. data
+// arriving at an exchange, an rpc of a sender finishing or a pipeline finishing. Cancellation
+// isn't signalled, the poller also checks the list at a long interval as a safety net.
+class TaskScheduler {
+public:
+    // num_workers <= 0 means the number of cpu cores.
+    explicit TaskScheduler(int num_workers);
+    ~TaskScheduler();
+
+    Status start();
+    void shutdown();
+
+    // Submit a new task, the task is run after its dependencies are finished.
+    void submit(PipelineTask* task);
+
+    // Check the blocked tasks, some of them may be ready. Cheap if no task is blocked, and
+    // safe to call with any lock held.
+    void wake_up();
+
+    int num_workers() const { return _num_workers; }
+
+private:
+    struct WorkQueue {
+        std::mutex lock;
+        std::deque<PipelineTask*> tasks;
+    };
+
+    void _worker_loop(int worker_id);
+    void _poll_blocked_tasks();
+
+    void _enqueue(int worker_id, PipelineTask* task);
+    PipelineTask* _take_task(int worker_id);
+    void _add_blocked(PipelineTask* task);
+    void _close_task(PipelineTask* task, const Status& status);
+
+    int _num_workers;
+    std::vector<std::unique_ptr<WorkQueue>> _queues;
+    std::atomic<uint32_t> _next_queue {0};
+
+    // Workers wait on _wait_cv when there is no task to run.
+    std::mutex _wait_lock;
+    std::condition_variable _wait_cv;
+    int _num_queued = 0;
+
+    std::mutex _blocked_lock;
+    std::condition_variable _blocked_cv;
+    std::list<PipelineTask*> _blocked_tasks;
+    // the number of blocked tasks and wake_up() calls, wakes up the poller
+    uint64_t _num_blocked_events = 0;
+    // the number of blocked tasks which are not requeued, including the ones being checked
+    std::atomic<int> _num_blocked_tasks {0};
+
+    std::atomic<bool> _shutdown {false};
+    std::vector<scoped_refptr<Thread>> _workers;
+    scoped_refptr<Thread> _poller;
+};
+
+// TaskScheduler::wake_up() of the scheduler of the ExecEnv, if there is one.
+void wake_up_blocked_tasks();
+
+} // namespace pipeline
+} // namespace doris
@@ -19,6 +19,7 @@
 
 #include "gen_cpp/PaloInternalService_types.h"
 #include "gen_cpp/internal_service.pb.h"
+#include "pipeline/task_scheduler.h"
 #include "runtime/raw_value.h"
 #include "service/brpc.h"
 #include "util/thrift_util.h"
@@ -85,6 +86,11 @@ Status BufferControlBlock::init() {
     return Status::OK();
 }
 
+bool BufferControlBlock::can_add_batch() {
+    std::unique_lock<std::mutex> l(_lock);
+    return _is_cancelled || _batch_queue.empty() || _buffer_rows < _buffer_limit;
+}
+
 Status BufferControlBlock::add_batch(std::unique_ptr<TFetchDataResult>& result) {
     std::unique_lock<std::mutex> l(_lock);
 
@@ -148,6 +154,7 @@ Status BufferControlBlock::get_batch(TFetchDataResult* result) {
     _batch_queue.pop_front();
     _buffer_rows -= item->result_batch.rows.size();
     _data_removal.notify_one();
+    pipeline::wake_up_blocked_tasks();
     *result = *(item.get());
     result->__set_packet_num(_packet_num);
     _packet_num++;
@@ -170,6 +177,7 @@ void BufferControlBlock::get_batch(GetResultBatchCtx* ctx) {
         _batch_queue.pop_front();
         _buffer_rows -= result->result_batch.rows.size();
         _data_removal.notify_one();
+        pipeline::wake_up_blocked_tasks();
 
         ctx->on_data(result, _packet_num);
         _packet_num++;
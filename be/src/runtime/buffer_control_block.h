@@ -66,6 +66,9 @@ public:
     Status init();
     Status add_batch(std::unique_ptr<TFetchDataResult>& result);
 
+    // True if add_batch() won't wait for the buffered data to be fetched.
+    bool can_add_batch();
+
     // get result from batch, use timeout?
     Status get_batch(TFetchDataResult* result);
 
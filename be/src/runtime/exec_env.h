@@ -26,6 +26,9 @@ namespace doris {
 namespace vectorized {
 class VDataStreamMgr;
 }
+namespace pipeline {
+class TaskScheduler;
+}
 class BfdParser;
 class BrokerMgr;
 class BrpcStubCache;
@@ -118,6 +121,7 @@ public:
     ThreadPool* send_batch_thread_pool() { return _send_batch_thread_pool.get(); }
     CgroupsMgr* cgroups_mgr() { return _cgroups_mgr; }
     FragmentMgr* fragment_mgr() { return _fragment_mgr; }
+    pipeline::TaskScheduler* pipeline_task_scheduler() { return _pipeline_task_scheduler; }
     ResultCache* result_cache() { return _result_cache; }
     TMasterInfo* master_info() { return _master_info; }
     EtlJobMgr* etl_job_mgr() { return _etl_job_mgr; }
@@ -192,6 +196,7 @@ private:
     PriorityThreadPool* _etl_thread_pool = nullptr;
     CgroupsMgr* _cgroups_mgr = nullptr;
     FragmentMgr* _fragment_mgr = nullptr;
+    pipeline::TaskScheduler* _pipeline_task_scheduler = nullptr;
     ResultCache* _result_cache = nullptr;
     TMasterInfo* _master_info = nullptr;
     EtlJobMgr* _etl_job_mgr = nullptr;
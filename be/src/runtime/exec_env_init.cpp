@@ -28,6 +28,7 @@
 #include "olap/page_cache.h"
 #include "olap/segment_loader.h"
 #include "olap/storage_engine.h"
+#include "pipeline/task_scheduler.h"
 #include "plugin/plugin_mgr.h"
 #include "runtime/broker_mgr.h"
 #include "runtime/bufferpool/buffer_pool.h"
@@ -115,6 +116,7 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
                                               config::etl_thread_pool_queue_size);
     _cgroups_mgr = new CgroupsMgr(this, config::doris_cgroups);
     _fragment_mgr = new FragmentMgr(this);
+    _pipeline_task_scheduler = new pipeline::TaskScheduler(config::pipeline_executor_size);
     _result_cache = new ResultCache(config::query_cache_max_size_mb,
                                     config::query_cache_elasticity_size_mb);
     _master_info = new TMasterInfo();
@@ -145,6 +147,7 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
     }
     _broker_mgr->init();
     _small_file_mgr->init();
+    RETURN_IF_ERROR(_pipeline_task_scheduler->start());
     _init_mem_tracker();
 
     RETURN_IF_ERROR(_load_channel_mgr->init(_mem_tracker->limit()));
@@ -295,6 +298,7 @@ void ExecEnv::_destroy() {
     SAFE_DELETE(_load_path_mgr);
     SAFE_DELETE(_etl_job_mgr);
     SAFE_DELETE(_master_info);
+    SAFE_DELETE(_pipeline_task_scheduler);
     SAFE_DELETE(_fragment_mgr);
     SAFE_DELETE(_cgroups_mgr);
     SAFE_DELETE(_etl_thread_pool);
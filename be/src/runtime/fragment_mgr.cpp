@@ -20,6 +20,9 @@
 #include <gperftools/profiler.h>
 #include <thrift/protocol/TDebugProtocol.h>
 
+#include <atomic>
+#include <cinttypes>
+#include <fstream>
 #include <memory>
 #include <sstream>
 
@@ -46,6 +49,7 @@
 #include "service/backend_options.h"
 #include "util/debug_util.h"
 #include "util/doris_metrics.h"
+#include "util/file_utils.h"
 #include "util/stopwatch.hpp"
 #include "util/threadpool.h"
 #include "util/thrift_util.h"
@@ -93,6 +97,10 @@ public:
 
     Status execute();
 
+    // Run the fragment in the pipeline task scheduler, 'done' is called when the execution
+    // is finished and the executor is closed.
+    void execute_pipeline(pipeline::TaskScheduler* scheduler, std::function<void()> done);
+
     Status cancel_before_execute();
 
     Status cancel(const PPlanFragmentCancelReason& reason);
@@ -243,6 +251,24 @@ Status FragmentExecState::execute() {
     return Status::OK();
 }
 
+void FragmentExecState::execute_pipeline(pipeline::TaskScheduler* scheduler,
+                                         std::function<void()> done) {
+    int64_t start_ns = MonotonicNanos();
+    auto finish = [this, start_ns, done = std::move(done)]() {
+        _executor.close();
+        DorisMetrics::instance()->fragment_requests_total->increment(1);
+        DorisMetrics::instance()->fragment_request_duration_us->increment(
+                (MonotonicNanos() - start_ns) / 1000);
+        done();
+    };
+    Status st = _executor.open_pipeline(scheduler, finish);
+    if (!st.ok()) {
+        LOG(WARNING) << "Got error while opening fragment " << print_id(_fragment_instance_id)
+                     << " in pipeline: " << st.get_error_msg();
+        finish();
+    }
+}
+
 Status FragmentExecState::cancel_before_execute() {
     // set status as 'abort', cuz cancel() won't effect the status arg of DataSink::close().
     _executor.set_abort();
@@ -451,6 +477,32 @@ FragmentMgr::~FragmentMgr() {
 
 static void empty_function(PlanFragmentExecutor* exec) {}
 
+// Saves the params of a query fragment to <plan_fragment_dump_dir>/<query_id>/. The file names
+// start with a sequence number, because the simplified params of a query can only be executed
+// after the first params of the query.
+static void dump_plan_fragment(const TExecPlanFragmentParams& params) {
+    static std::atomic<int64_t> s_dump_seq {0};
+    std::string dir = config::plan_fragment_dump_dir + "/" + print_id(params.params.query_id);
+    Status st = FileUtils::create_dir(dir);
+    if (!st.ok()) {
+        LOG(WARNING) << "failed to create plan fragment dump dir " << dir << ": "
+                     << st.get_error_msg();
+        return;
+    }
+    std::string buf;
+    ThriftSerializer serializer(false, 4096);
+    st = serializer.serialize(const_cast<TExecPlanFragmentParams*>(&params), &buf);
+    if (!st.ok()) {
+        LOG(WARNING) << "failed to serialize plan fragment: " << st.get_error_msg();
+        return;
+    }
+    char name[32];
+    snprintf(name, sizeof(name), "%010" PRId64 "_", s_dump_seq.fetch_add(1));
+    std::ofstream out(dir + "/" + name + print_id(params.params.fragment_instance_id),
+                      std::ios::binary);
+    out.write(buf.data(), buf.size());
+}
+
 void FragmentMgr::_exec_actual(std::shared_ptr<FragmentExecState> exec_state, FinishCallback cb) {
     TAG(LOG(INFO))
             .log("PlanFragmentExecutor::_exec_actual")
@@ -458,7 +510,11 @@ void FragmentMgr::_exec_actual(std::shared_ptr<FragmentExecState> exec_state, Fi
             .instance_id(exec_state->fragment_instance_id())
             .tag("pthread_id", std::to_string((uintptr_t)pthread_self()));
     exec_state->execute();
+    _finish_fragment(exec_state, cb);
+}
 
+void FragmentMgr::_finish_fragment(const std::shared_ptr<FragmentExecState>& exec_state,
+                                   const FinishCallback& cb) {
     std::shared_ptr<QueryFragmentsCtx> fragments_ctx = exec_state->get_fragments_ctx();
     bool all_done = false;
     if (fragments_ctx != nullptr) {
@@ -480,6 +536,10 @@ void FragmentMgr::_exec_actual(std::shared_ptr<FragmentExecState> exec_state, Fi
 }
 
 Status FragmentMgr::exec_plan_fragment(const TExecPlanFragmentParams& params) {
+    if (!config::plan_fragment_dump_dir.empty() && params.__isset.params &&
+        params.query_options.query_type == TQueryType::SELECT) {
+        dump_plan_fragment(params);
+    }
     if (params.txn_conf.need_txn) {
         StreamLoadContext* stream_load_cxt = new StreamLoadContext(_exec_env);
         stream_load_cxt->db = params.txn_conf.db;
@@ -622,6 +682,12 @@ Status FragmentMgr::exec_plan_fragment(const TExecPlanFragmentParams& params, Fi
         _cv.notify_all();
     }
 
+    if (exec_state->executor()->can_run_in_pipeline()) {
+        exec_state->execute_pipeline(_exec_env->pipeline_task_scheduler(),
+                                     [this, exec_state, cb]() { _finish_fragment(exec_state, cb); });
+        return Status::OK();
+    }
+
     auto st = _thread_pool->submit_func(
             std::bind<void>(&FragmentMgr::_exec_actual, this, exec_state, cb));
     if (!st.ok()) {
@@ -93,6 +93,9 @@ public:
 
 private:
     void _exec_actual(std::shared_ptr<FragmentExecState> exec_state, FinishCallback cb);
+    // Remove the finished fragment and call 'cb'.
+    void _finish_fragment(const std::shared_ptr<FragmentExecState>& exec_state,
+                          const FinishCallback& cb);
 
     // This is input params
     ExecEnv* _exec_env;
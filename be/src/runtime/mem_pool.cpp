@@ -73,7 +73,7 @@ void MemPool::free_all() {
     total_allocated_bytes_ = 0;
     total_reserved_bytes_ = 0;
 
-    mem_tracker_->Release(total_bytes_released);
+    mem_tracker_->CacheRelease(total_bytes_released);
     DorisMetrics::instance()->memory_pool_bytes_total->increment(-total_bytes_released);
 }
 
@@ -120,7 +120,7 @@ bool MemPool::find_chunk(size_t min_size, bool check_limits) {
         WARN_IF_ERROR(st, "try to allocate a new buffer failed");
         if (!st) return false;
     } else {
-        mem_tracker_->Consume(chunk_size);
+        mem_tracker_->CacheConsume(chunk_size);
     }
 
     // Allocate a new chunk. Return early if allocate fails.
@@ -30,6 +30,7 @@
 
 #include "common/status.h"
 #include "gen_cpp/Types_types.h" // for TUniqueId
+#include "runtime/thread_mem_tracker_mgr.h"
 #include "util/mem_info.h"
 #include "util/metrics.h"
 #include "util/runtime_profile.h"
@@ -142,6 +143,20 @@ public:
         }
     }
 
+    /// Like Consume(), but if the current thread is attached to this tracker, the
+    /// consumption is cached in the thread and flushed in batches, see ThreadMemTrackerMgr.
+    /// Limits checked by other threads may lag behind by the cached bytes.
+    void CacheConsume(int64_t bytes) {
+        if (LIKELY(tls_mem_tracker_mgr.tracker() == this)) {
+            tls_mem_tracker_mgr.cache_consume(bytes);
+        } else {
+            Consume(bytes);
+        }
+    }
+
+    /// Same as above, but it decreases the consumption.
+    void CacheRelease(int64_t bytes) { CacheConsume(-bytes); }
+
     /// Increases the consumption of this tracker and the ancestors up to (but
     /// not including) end_tracker. This is useful if we want to move tracking between
     /// trackers that share a common (i.e. end_tracker) ancestor. This happens when we want
@@ -173,6 +188,8 @@ public:
             Release(-bytes);
             return Status::OK();
         }
+        // Make the limit check accurate for the current thread.
+        tls_mem_tracker_mgr.flush();
         if (MemInfo::current_mem() + bytes >= MemInfo::mem_limit()) {
             return Status::MemoryLimitExceeded(fmt::format(
                     "{}: TryConsume failed, bytes={} process whole consumption={}  mem limit={}",
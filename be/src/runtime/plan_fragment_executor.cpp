@@ -27,6 +27,7 @@
 #include "exec/exec_node.h"
 #include "exec/scan_node.h"
 #include "exprs/expr.h"
+#include "pipeline/pipeline_fragment_context.h"
 #include "runtime/data_stream_mgr.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
@@ -239,15 +240,7 @@ Status PlanFragmentExecutor::open() {
 
     // we need to start the profile-reporting thread before calling Open(), since it
     // may block
-    // TODO: if no report thread is started, make sure to send a final profile
-    // at end, otherwise the coordinator hangs in case we finish w/ an error
-    if (_is_report_success && _report_status_cb && config::status_report_interval > 0) {
-        std::unique_lock<std::mutex> l(_report_thread_lock);
-        _report_thread = std::thread(&PlanFragmentExecutor::report_profile, this);
-        // make sure the thread started up, otherwise report_profile() might get into a race
-        // with stop_report_thread()
-        _report_thread_started_cv.wait(l);
-    }
+    _start_report_thread();
     Status status = Status::OK();
     if (_runtime_state->enable_vectorized_exec()) {
         status = open_vectorized_internal();
@@ -298,6 +291,10 @@ Status PlanFragmentExecutor::open_vectorized_internal() {
         }
         RETURN_IF_ERROR(_sink->send(runtime_state(), block));
     }
+    return _finish_sink();
+}
+
+Status PlanFragmentExecutor::_finish_sink() {
     {
         SCOPED_TIMER(profile()->total_time_counter());
         _collect_query_statistics();
@@ -318,6 +315,50 @@ Status PlanFragmentExecutor::open_vectorized_internal() {
 
     return Status::OK();
 }
+
+bool PlanFragmentExecutor::can_run_in_pipeline() const {
+    return _runtime_state->enable_pipeline_exec() && _sink != nullptr &&
+           pipeline::PipelineFragmentContext::is_supported(_plan);
+}
+
+Status PlanFragmentExecutor::open_pipeline(pipeline::TaskScheduler* scheduler,
+                                           std::function<void()> done) {
+    _start_report_thread();
+    _pipeline_context = std::make_shared<pipeline::PipelineFragmentContext>(
+            _runtime_state.get(), _plan, _sink.get(),
+            [this, done = std::move(done)](const Status& exec_status) {
+                Status status = exec_status;
+                if (status.ok()) {
+                    status = _finish_sink();
+                }
+                if (!status.ok() && !status.is_cancelled() && _runtime_state->log_has_space()) {
+                    _runtime_state->log_error(status.get_error_msg());
+                }
+                update_status(status);
+                done();
+            });
+    Status status = _pipeline_context->prepare();
+    if (!status.ok()) {
+        _pipeline_context.reset();
+        update_status(status);
+        return status;
+    }
+    _pipeline_context->submit(scheduler);
+    return Status::OK();
+}
+
+void PlanFragmentExecutor::_start_report_thread() {
+    // TODO: if no report thread is started, make sure to send a final profile
+    // at end, otherwise the coordinator hangs in case we finish w/ an error
+    if (_is_report_success && _report_status_cb && config::status_report_interval > 0) {
+        std::unique_lock<std::mutex> l(_report_thread_lock);
+        _report_thread = std::thread(&PlanFragmentExecutor::report_profile, this);
+        // make sure the thread started up, otherwise report_profile() might get into a race
+        // with stop_report_thread()
+        _report_thread_started_cv.wait(l);
+    }
+}
+
 Status PlanFragmentExecutor::get_vectorized_internal(::doris::vectorized::Block** block) {
     if (_done) {
         *block = nullptr;
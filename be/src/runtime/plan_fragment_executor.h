@@ -48,6 +48,11 @@ class TPlanFragment;
 class TPlanFragmentExecParams;
 class TPlanExecParams;
 
+namespace pipeline {
+class PipelineFragmentContext;
+class TaskScheduler;
+} // namespace pipeline
+
 // PlanFragmentExecutor handles all aspects of the execution of a single plan fragment,
 // including setup and tear-down, both in the success and error case.
 // Tear-down frees all memory allocated for this plan fragment and closes all data
@@ -110,6 +115,14 @@ public:
     // time when open() returns, and the status-reporting thread will have been stopped.
     Status open();
 
+    // True if the fragment can be run by the pipeline engine, see open_pipeline().
+    bool can_run_in_pipeline() const;
+
+    // Like open(), but runs the fragment as pipeline tasks in 'scheduler' and returns
+    // without waiting for the result. 'done' is called when the execution is finished,
+    // it is not called if this returns an error.
+    Status open_pipeline(pipeline::TaskScheduler* scheduler, std::function<void()> done);
+
     // Return results through 'batch'. Sets '*batch' to nullptr if no more results.
     // '*batch' is owned by PlanFragmentExecutor and must not be deleted.
     // When *batch == nullptr, get_next() should not be called anymore. Also, report_status_cb
@@ -197,6 +210,9 @@ private:
     std::unique_ptr<RowBatch> _row_batch;
     std::unique_ptr<doris::vectorized::Block> _block;
 
+    // Set if the fragment is run by the pipeline engine.
+    std::shared_ptr<pipeline::PipelineFragmentContext> _pipeline_context;
+
     // Number of rows returned by this fragment
     RuntimeProfile::Counter* _rows_produced_counter;
 
@@ -247,6 +263,11 @@ private:
     // Idempotent.
     void stop_report_thread();
 
+    void _start_report_thread();
+
+    // Close the sink after all data is sent, and send the final report.
+    Status _finish_sink();
+
     const DescriptorTbl& desc_tbl() { return _runtime_state->desc_tbl(); }
 
     void _collect_query_statistics();
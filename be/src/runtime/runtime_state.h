@@ -351,6 +351,12 @@ public:
 
     bool enable_vectorized_exec() const { return _query_options.enable_vectorized_engine; }
 
+    bool enable_pipeline_exec() const {
+        return _query_options.enable_vectorized_engine && _query_options.enable_pipeline_engine;
+    }
+
+    int be_exec_version() const { return _query_options.be_exec_version; }
+
     bool return_object_data_as_binary() const {
         return _query_options.return_object_data_as_binary;
     }
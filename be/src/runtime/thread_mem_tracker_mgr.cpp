@@ -0,0 +1,38 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/thread_mem_tracker_mgr.h"
+
+#include "runtime/mem_tracker.h"
+
+namespace doris {
+
+thread_local ThreadMemTrackerMgr tls_mem_tracker_mgr;
+
+void ThreadMemTrackerMgr::flush() {
+    if (_untracked_mem == 0) {
+        return;
+    }
+    // Reset before consuming, Consume() never goes back to the cache.
+    int64_t bytes = _untracked_mem;
+    _untracked_mem = 0;
+    if (_tracker != nullptr) {
+        _tracker->Consume(bytes);
+    }
+}
+
+} // namespace doris
@@ -0,0 +1,91 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "common/compiler_util.h"
+#include "common/config.h"
+#include "util/runtime_profile.h" // for MACRO_CONCAT
+
+namespace doris {
+
+class MemTracker;
+
+// Batches the memory consumption of the current thread.
+//
+// A thread is attached to one MemTracker at a time, e.g. the tracker of the exec node it
+// is running. Consumption of the attached tracker through MemTracker::CacheConsume() is
+// accumulated in the thread, and only flushed to the tracker and all its ancestors when
+// it exceeds config::mem_tracker_consume_min_size_bytes, or when the thread is attached
+// to another tracker. This avoids updating the shared counters of the query and process
+// trackers on every small allocation.
+class ThreadMemTrackerMgr {
+public:
+    MemTracker* tracker() const { return _tracker; }
+    int64_t untracked_mem() const { return _untracked_mem; }
+
+    // 'bytes' is negative for release.
+    void cache_consume(int64_t bytes) {
+        _untracked_mem += bytes;
+        const int64_t flush_bytes = config::mem_tracker_consume_min_size_bytes;
+        if (UNLIKELY(_untracked_mem >= flush_bytes || _untracked_mem <= -flush_bytes)) {
+            flush();
+        }
+    }
+
+    // Flush the cached consumption to the attached tracker.
+    void flush();
+
+    // Attach the thread to 'tracker' after flushing the cached consumption, and return the
+    // previously attached tracker. 'tracker' may be null.
+    MemTracker* switch_tracker(MemTracker* tracker) {
+        flush();
+        MemTracker* old = _tracker;
+        _tracker = tracker;
+        return old;
+    }
+
+private:
+    MemTracker* _tracker = nullptr;
+    int64_t _untracked_mem = 0;
+};
+
+// Trivially constructible, so accessing it doesn't need a guard.
+extern thread_local ThreadMemTrackerMgr tls_mem_tracker_mgr;
+
+// Attaches the current thread to a tracker in a scope. The tracker must outlive the scope,
+// the cached consumption is flushed when leaving the scope.
+class ScopedSwitchThreadMemTracker {
+public:
+    explicit ScopedSwitchThreadMemTracker(MemTracker* tracker)
+            : _old_tracker(tls_mem_tracker_mgr.switch_tracker(tracker)) {}
+    explicit ScopedSwitchThreadMemTracker(const std::shared_ptr<MemTracker>& tracker)
+            : ScopedSwitchThreadMemTracker(tracker.get()) {}
+
+    ~ScopedSwitchThreadMemTracker() { tls_mem_tracker_mgr.switch_tracker(_old_tracker); }
+
+private:
+    MemTracker* _old_tracker;
+};
+
+#define SCOPED_SWITCH_THREAD_MEM_TRACKER(tracker) \
+    ScopedSwitchThreadMemTracker MACRO_CONCAT(scoped_mem_tracker_, __COUNTER__)(tracker)
+
+} // namespace doris
@@ -0,0 +1,504 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// Replays captured query plans against the local storage, without FE.
+//
+// The plans are captured by a BE with plan_fragment_dump_dir set, while running the queries
+// (e.g. SSB or TPC-H) on a cluster with a single BE. Then the BE is stopped, and this tool
+// opens the storage of the BE, runs the fragments of each query through FragmentMgr and
+// PlanFragmentExecutor, and plays the coordinator: it fetches the results from the result
+// buffer and collects the profiles of the fragment instances. The latency of each run and
+// the per-node profiles of the last run are written as JSON.
+
+#include <gflags/gflags.h>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "common/daemon.h"
+#include "common/logging.h"
+#include "common/resource_tls.h"
+#include "common/status.h"
+#include "gen_cpp/FrontendService.h"
+#include "gen_cpp/PaloInternalService_types.h"
+#include "gen_cpp/RuntimeProfile_types.h"
+#include "gutil/strings/split.h"
+#include "olap/options.h"
+#include "olap/storage_engine.h"
+#include "runtime/exec_env.h"
+#include "runtime/fragment_mgr.h"
+#include "runtime/result_buffer_mgr.h"
+#include "service/backend_options.h"
+#include "service/brpc_service.h"
+#include "util/stopwatch.hpp"
+#include "util/thrift_rpc_helper.h"
+#include "util/thrift_server.h"
+#include "util/thrift_util.h"
+#include "util/uid_util.h"
+
+DEFINE_string(conf, "", "config file of BE, ${DORIS_HOME}/conf/be.conf if empty");
+DEFINE_string(plan_dir, "",
+              "dir of the captured plans, each sub dir holds the fragments of one query and is "
+              "named by the query");
+DEFINE_string(queries, "", "comma separated queries to run, all queries in plan_dir if empty");
+DEFINE_int32(warmup, 1, "runs of each query before measuring");
+DEFINE_int32(iterations, 3, "measured runs of each query");
+DEFINE_int32(coordinator_port, 9070, "port of the coordinator which receives the reports");
+DEFINE_int32(query_timeout_s, 600, "timeout of a single run");
+DEFINE_string(output, "", "file of the JSON result, stdout if empty");
+
+namespace doris {
+
+std::string get_usage(const std::string& progname) {
+    std::stringstream ss;
+    ss << progname << " replays captured query plans against the local BE storage.\n";
+    ss << "Stop BE first before use this tool.\n";
+    ss << "Usage:\n";
+    ss << "./query_benchmark_tool --plan_dir=./ssb_plans --iterations=5 --output=ssb.json\n";
+    ss << "./query_benchmark_tool --plan_dir=./tpch_plans --queries=q1,q6 --warmup=0\n";
+    return ss.str();
+}
+
+// Receives the reports of fragment instances, as FE does.
+class BenchmarkCoordinator : public FrontendServiceNull {
+public:
+    struct InstanceReport {
+        TUniqueId fragment_instance_id;
+        TRuntimeProfileTree profile;
+    };
+
+    void reportExecStatus(TReportExecStatusResult& result,
+                          const TReportExecStatusParams& params) override {
+        result.status.__set_status_code(TStatusCode::OK);
+        std::lock_guard<std::mutex> l(_lock);
+        auto it = _queries.find(print_id(params.query_id));
+        if (it == _queries.end() || !params.done) {
+            return;
+        }
+        QueryState& query = it->second;
+        if (params.__isset.status && params.status.status_code != TStatusCode::OK &&
+            query.status.ok()) {
+            query.status = Status(params.status);
+        }
+        query.reports.push_back({params.fragment_instance_id, params.profile});
+        _cv.notify_all();
+    }
+
+    void register_query(const TUniqueId& query_id, size_t num_instances) {
+        std::lock_guard<std::mutex> l(_lock);
+        _queries[print_id(query_id)].num_instances = num_instances;
+    }
+
+    // Waits until all instances of the query are done, and unregisters the query.
+    Status wait_query(const TUniqueId& query_id, int timeout_s,
+                      std::vector<InstanceReport>* reports) {
+        std::unique_lock<std::mutex> l(_lock);
+        auto& query = _queries[print_id(query_id)];
+        bool done = _cv.wait_for(l, std::chrono::seconds(timeout_s), [&query] {
+            return query.reports.size() >= query.num_instances;
+        });
+        Status st = done ? query.status : Status::TimedOut("wait for the reports timeout");
+        *reports = std::move(query.reports);
+        _queries.erase(print_id(query_id));
+        return st;
+    }
+
+private:
+    struct QueryState {
+        size_t num_instances = 0;
+        Status status;
+        std::vector<InstanceReport> reports;
+    };
+
+    std::mutex _lock;
+    std::condition_variable _cv;
+    std::map<std::string, QueryState> _queries;
+};
+
+struct QueryPlan {
+    std::string name;
+    // In the order they were received by BE.
+    std::vector<TExecPlanFragmentParams> fragments;
+};
+
+struct RunResult {
+    int64_t elapsed_ns = 0;
+    int64_t rows = 0;
+    std::vector<BenchmarkCoordinator::InstanceReport> reports;
+};
+
+static Status load_query_plan(const std::filesystem::path& dir, QueryPlan* plan) {
+    plan->name = dir.filename().string();
+    std::vector<std::string> files;
+    for (auto& entry : std::filesystem::directory_iterator(dir)) {
+        if (entry.is_regular_file()) {
+            files.push_back(entry.path().string());
+        }
+    }
+    // Files are named by the sequence they were received.
+    std::sort(files.begin(), files.end());
+    for (auto& file : files) {
+        std::ifstream in(file, std::ios::binary);
+        std::string buf((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        uint32_t len = buf.size();
+        TExecPlanFragmentParams params;
+        RETURN_IF_ERROR(deserialize_thrift_msg(reinterpret_cast<const uint8_t*>(buf.data()), &len,
+                                               false, &params));
+        plan->fragments.push_back(std::move(params));
+    }
+    if (plan->fragments.empty()) {
+        return Status::InvalidArgument("no plan fragment in " + dir.string());
+    }
+    return Status::OK();
+}
+
+static TNetworkAddress make_address(const std::string& host, int port) {
+    TNetworkAddress address;
+    address.__set_hostname(host);
+    address.__set_port(port);
+    return address;
+}
+
+// Gives the fragments a new query id and new instance ids, so that a query can be run many
+// times, and points all addresses to this process.
+static std::vector<TExecPlanFragmentParams> rewrite_plan(const QueryPlan& plan,
+                                                         const TUniqueId& query_id) {
+    std::map<std::string, TUniqueId> instance_ids;
+    auto new_instance_id = [&](const TUniqueId& old_id) {
+        auto it = instance_ids.find(print_id(old_id));
+        if (it != instance_ids.end()) {
+            return it->second;
+        }
+        TUniqueId id = query_id;
+        id.__set_lo(query_id.lo + instance_ids.size() + 1);
+        instance_ids.emplace(print_id(old_id), id);
+        return id;
+    };
+    std::string localhost = BackendOptions::get_localhost();
+    TNetworkAddress brpc_address = make_address(localhost, config::brpc_port);
+
+    std::vector<TExecPlanFragmentParams> fragments = plan.fragments;
+    for (auto& params : fragments) {
+        auto& exec_params = params.params;
+        exec_params.__set_query_id(query_id);
+        exec_params.__set_fragment_instance_id(new_instance_id(exec_params.fragment_instance_id));
+        for (auto& destination : exec_params.destinations) {
+            destination.__set_fragment_instance_id(
+                    new_instance_id(destination.fragment_instance_id));
+            destination.__set_server(make_address(localhost, config::be_port));
+            destination.__set_brpc_server(brpc_address);
+        }
+        if (exec_params.__isset.runtime_filter_params) {
+            auto& filter_params = exec_params.runtime_filter_params;
+            if (filter_params.__isset.runtime_filter_merge_addr) {
+                filter_params.__set_runtime_filter_merge_addr(brpc_address);
+            }
+            for (auto& [filter_id, targets] : filter_params.rid_to_target_param) {
+                for (auto& target : targets) {
+                    target.__set_target_fragment_instance_id(
+                            new_instance_id(target.target_fragment_instance_id));
+                    target.__set_target_fragment_instance_addr(brpc_address);
+                }
+            }
+        }
+        if (params.__isset.coord) {
+            params.__set_coord(make_address(localhost, FLAGS_coordinator_port));
+        }
+        params.query_options.__set_is_report_success(true);
+        params.query_options.__set_query_timeout(FLAGS_query_timeout_s);
+    }
+    return fragments;
+}
+
+static Status run_query(const QueryPlan& plan, BenchmarkCoordinator* coordinator,
+                        RunResult* result) {
+    ExecEnv* exec_env = ExecEnv::GetInstance();
+    TUniqueId query_id = UniqueId::gen_uid().to_thrift();
+    std::vector<TExecPlanFragmentParams> fragments = rewrite_plan(plan, query_id);
+
+    const TExecPlanFragmentParams* result_fragment = nullptr;
+    for (auto& params : fragments) {
+        if (params.fragment.__isset.output_sink &&
+            params.fragment.output_sink.type == TDataSinkType::RESULT_SINK) {
+            result_fragment = &params;
+        }
+    }
+    if (result_fragment == nullptr) {
+        return Status::InvalidArgument("query " + plan.name + " has no result sink");
+    }
+
+    coordinator->register_query(query_id, fragments.size());
+    MonotonicStopWatch watch;
+    watch.start();
+
+    Status st;
+    std::vector<TUniqueId> started_instances;
+    for (auto& params : fragments) {
+        st = exec_env->fragment_mgr()->exec_plan_fragment(params);
+        if (!st.ok()) {
+            break;
+        }
+        started_instances.push_back(params.params.fragment_instance_id);
+    }
+    // Drain the result as the client does, the result sink blocks if its buffer is full.
+    while (st.ok()) {
+        TFetchDataResult fetch_result;
+        st = exec_env->result_mgr()->fetch_data(result_fragment->params.fragment_instance_id,
+                                                &fetch_result);
+        if (!st.ok() || fetch_result.eos) {
+            break;
+        }
+        result->rows += fetch_result.result_batch.rows.size();
+    }
+    if (!st.ok()) {
+        for (auto& instance_id : started_instances) {
+            exec_env->fragment_mgr()->cancel(instance_id);
+        }
+        coordinator->register_query(query_id, started_instances.size());
+    }
+    Status wait_st = coordinator->wait_query(query_id, FLAGS_query_timeout_s, &result->reports);
+    result->elapsed_ns = watch.elapsed_time();
+    RETURN_IF_ERROR(st);
+    return wait_st;
+}
+
+using JsonWriter = rapidjson::PrettyWriter<rapidjson::StringBuffer>;
+
+// Writes the profile tree, whose nodes are flattened in pre-order. Returns the index of the
+// next node after the subtree.
+static size_t write_profile(const std::vector<TRuntimeProfileNode>& nodes, size_t index,
+                            JsonWriter* writer) {
+    const TRuntimeProfileNode& node = nodes[index++];
+    writer->StartObject();
+    writer->Key("name");
+    writer->String(node.name.c_str());
+    writer->Key("counters");
+    writer->StartObject();
+    for (auto& counter : node.counters) {
+        writer->Key(counter.name.c_str());
+        writer->StartObject();
+        writer->Key("value");
+        writer->Int64(counter.value);
+        writer->Key("unit");
+        writer->String(_TUnit_VALUES_TO_NAMES.at(counter.type));
+        writer->EndObject();
+    }
+    writer->EndObject();
+    if (!node.info_strings.empty()) {
+        writer->Key("info");
+        writer->StartObject();
+        for (auto& [key, value] : node.info_strings) {
+            writer->Key(key.c_str());
+            writer->String(value.c_str());
+        }
+        writer->EndObject();
+    }
+    writer->Key("children");
+    writer->StartArray();
+    for (int i = 0; i < node.num_children && index < nodes.size(); ++i) {
+        index = write_profile(nodes, index, writer);
+    }
+    writer->EndArray();
+    writer->EndObject();
+    return index;
+}
+
+static void write_query_result(const QueryPlan& plan, const Status& status,
+                               const std::vector<RunResult>& runs, JsonWriter* writer) {
+    writer->StartObject();
+    writer->Key("query");
+    writer->String(plan.name.c_str());
+    writer->Key("status");
+    writer->String(status.ok() ? "OK" : status.get_error_msg().c_str());
+    writer->Key("fragment_instances");
+    writer->Uint64(plan.fragments.size());
+    if (!runs.empty()) {
+        int64_t min_ns = runs[0].elapsed_ns;
+        int64_t total_ns = 0;
+        writer->Key("runs_ms");
+        writer->StartArray();
+        for (auto& run : runs) {
+            writer->Double(run.elapsed_ns / 1e6);
+            min_ns = std::min(min_ns, run.elapsed_ns);
+            total_ns += run.elapsed_ns;
+        }
+        writer->EndArray();
+        writer->Key("min_ms");
+        writer->Double(min_ns / 1e6);
+        writer->Key("avg_ms");
+        writer->Double(total_ns / 1e6 / runs.size());
+        writer->Key("rows");
+        writer->Int64(runs.back().rows);
+
+        writer->Key("profiles");
+        writer->StartArray();
+        for (auto& report : runs.back().reports) {
+            writer->StartObject();
+            writer->Key("fragment_instance_id");
+            writer->String(print_id(report.fragment_instance_id).c_str());
+            if (!report.profile.nodes.empty()) {
+                writer->Key("profile");
+                write_profile(report.profile.nodes, 0, writer);
+            }
+            writer->EndObject();
+        }
+        writer->EndArray();
+    }
+    writer->EndObject();
+}
+
+static Status run_benchmark(BenchmarkCoordinator* coordinator, std::ostream* out) {
+    if (FLAGS_plan_dir.empty()) {
+        return Status::InvalidArgument("plan_dir is not set");
+    }
+    std::vector<std::filesystem::path> query_dirs;
+    if (FLAGS_queries.empty()) {
+        for (auto& entry : std::filesystem::directory_iterator(FLAGS_plan_dir)) {
+            if (entry.is_directory()) {
+                query_dirs.push_back(entry.path());
+            }
+        }
+        std::sort(query_dirs.begin(), query_dirs.end());
+    } else {
+        for (auto& name : strings::Split(FLAGS_queries, ",", strings::SkipWhitespace())) {
+            query_dirs.push_back(std::filesystem::path(FLAGS_plan_dir) / name.ToString());
+        }
+    }
+
+    rapidjson::StringBuffer buffer;
+    JsonWriter writer(buffer);
+    writer.StartArray();
+    for (auto& dir : query_dirs) {
+        QueryPlan plan;
+        RETURN_IF_ERROR(load_query_plan(dir, &plan));
+        std::vector<RunResult> runs;
+        Status st;
+        for (int i = 0; i < FLAGS_warmup + FLAGS_iterations && st.ok(); ++i) {
+            RunResult run;
+            st = run_query(plan, coordinator, &run);
+            if (st.ok() && i >= FLAGS_warmup) {
+                runs.push_back(std::move(run));
+            }
+        }
+        LOG(INFO) << "query " << plan.name << " finished, runs=" << runs.size()
+                  << ", status=" << st.get_error_msg();
+        write_query_result(plan, st, runs, &writer);
+    }
+    writer.EndArray();
+    *out << buffer.GetString() << std::endl;
+    return Status::OK();
+}
+
+} // namespace doris
+
+int main(int argc, char** argv) {
+    std::string usage = doris::get_usage(argv[0]);
+    gflags::SetUsageMessage(usage);
+
+    std::string conffile = FLAGS_conf;
+    if (conffile.empty()) {
+        if (getenv("DORIS_HOME") == nullptr) {
+            fprintf(stderr, "you need set DORIS_HOME environment variable or --conf.\n");
+            return -1;
+        }
+        conffile = std::string(getenv("DORIS_HOME")) + "/conf/be.conf";
+    }
+    // The flags are parsed by daemon.init(), but conf is needed before that.
+    google::ParseCommandLineFlags(&argc, &argv, false);
+    if (!doris::config::init(conffile.c_str(), false)) {
+        fprintf(stderr, "error read config file %s.\n", conffile.c_str());
+        return -1;
+    }
+    // Replaying plans must not capture them again.
+    doris::config::plan_fragment_dump_dir = "";
+
+    std::vector<doris::StorePath> paths;
+    auto olap_res = doris::parse_conf_store_paths(doris::config::storage_root_path, &paths);
+    if (olap_res != doris::OLAP_SUCCESS) {
+        fprintf(stderr, "parse config storage path failed, path=%s\n",
+                doris::config::storage_root_path.c_str());
+        return -1;
+    }
+
+    doris::Daemon daemon;
+    daemon.init(argc, argv, paths);
+
+    doris::ResourceTls::init();
+    if (!doris::BackendOptions::init()) {
+        return -1;
+    }
+
+    // Background threads of the storage engine are not started, so that compaction
+    // doesn't disturb the measurement.
+    doris::EngineOptions options;
+    options.store_paths = paths;
+    options.backend_uid = doris::UniqueId::gen_uid();
+    doris::StorageEngine* engine = nullptr;
+    auto st = doris::StorageEngine::open(options, &engine);
+    if (!st.ok()) {
+        LOG(ERROR) << "fail to open StorageEngine, res=" << st.get_error_msg();
+        return -1;
+    }
+    auto exec_env = doris::ExecEnv::GetInstance();
+    doris::ExecEnv::init(exec_env, paths);
+    exec_env->set_storage_engine(engine);
+    doris::ThriftRpcHelper::setup(exec_env);
+
+    // Exchanges and runtime filters between fragments go through brpc.
+    doris::BRpcService brpc_service(exec_env);
+    st = brpc_service.start(doris::config::brpc_port);
+    if (!st.ok()) {
+        LOG(ERROR) << "BRPC service did not start correctly: " << st.get_error_msg();
+        return -1;
+    }
+
+    auto coordinator = std::make_shared<doris::BenchmarkCoordinator>();
+    doris::ThriftServer coordinator_server(
+            "benchmark_coordinator",
+            std::make_shared<doris::FrontendServiceProcessor>(coordinator),
+            FLAGS_coordinator_port);
+    st = coordinator_server.start();
+    if (!st.ok()) {
+        LOG(ERROR) << "coordinator did not start correctly: " << st.get_error_msg();
+        return -1;
+    }
+
+    std::ofstream output_file;
+    if (!FLAGS_output.empty()) {
+        output_file.open(FLAGS_output);
+    }
+    st = doris::run_benchmark(coordinator.get(),
+                              FLAGS_output.empty() ? &std::cout : &output_file);
+    if (!st.ok()) {
+        std::cerr << "benchmark failed: " << st.get_error_msg() << std::endl;
+    }
+
+    coordinator_server.stop();
+    engine->stop();
+    return st.ok() ? 0 : 1;
+}
@@ -31,6 +31,7 @@
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "common/logging.h"
 #include "udf/udf.h"
@@ -174,17 +175,27 @@ public:
     /**
      * Add value n_args from pointer vals
      *
+     * The values having the same high bytes are added to their 32-bit bitmap in
+     * a batch, which is the fastest when the values are sorted.
      */
     void addMany(size_t n_args, const uint32_t* vals) {
-        for (size_t lcv = 0; lcv < n_args; lcv++) {
-            roarings[0].add(vals[lcv]);
-            roarings[0].setCopyOnWrite(copyOnWrite);
-        }
+        if (n_args == 0) return;
+        roarings[0].addMany(n_args, vals);
+        roarings[0].setCopyOnWrite(copyOnWrite);
     }
     void addMany(size_t n_args, const uint64_t* vals) {
-        for (size_t lcv = 0; lcv < n_args; lcv++) {
-            roarings[highBytes(vals[lcv])].add(lowBytes(vals[lcv]));
-            roarings[highBytes(vals[lcv])].setCopyOnWrite(copyOnWrite);
+        std::vector<uint32_t> low_bytes;
+        for (size_t begin = 0; begin < n_args;) {
+            const uint32_t high_bytes = highBytes(vals[begin]);
+            size_t end = begin + 1;
+            while (end < n_args && highBytes(vals[end]) == high_bytes) ++end;
+            low_bytes.resize(end - begin);
+            for (size_t lcv = begin; lcv < end; lcv++) {
+                low_bytes[lcv - begin] = lowBytes(vals[lcv]);
+            }
+            roarings[high_bytes].addMany(low_bytes.size(), low_bytes.data());
+            roarings[high_bytes].setCopyOnWrite(copyOnWrite);
+            begin = end;
         }
     }
 
@@ -894,10 +905,22 @@ public:
      * pointer).
      */
     static Roaring64Map fastunion(size_t n, const Roaring64Map** inputs) {
-        Roaring64Map ans;
-        // not particularly fast
+        // the 32-bit bitmaps having the same high bytes are merged at once by
+        // roaring_bitmap_or_many(), instead of one after another
+        phmap::btree_map<uint32_t, std::vector<const roaring::Roaring*>> groups;
         for (size_t lcv = 0; lcv < n; ++lcv) {
-            ans |= *(inputs[lcv]);
+            for (const auto& map_entry : inputs[lcv]->roarings) {
+                groups[map_entry.first].push_back(&map_entry.second);
+            }
+        }
+        Roaring64Map ans;
+        for (auto& [high_bytes, group] : groups) {
+            if (group.size() == 1) {
+                ans.roarings.emplace(high_bytes, *group[0]);
+            } else {
+                ans.roarings.emplace(high_bytes,
+                                     roaring::Roaring::fastunion(group.size(), group.data()));
+            }
         }
         return ans;
     }
@@ -1184,6 +1207,18 @@ public:
         }
     }
 
+    // Add the values, which is the fastest when they are sorted.
+    void add_many(const uint64_t* values, size_t num_values) {
+        size_t i = 0;
+        // stay in the smaller types until a second distinct value is added
+        for (; i < num_values && _type != BITMAP; ++i) {
+            add(values[i]);
+        }
+        if (i < num_values) {
+            _bitmap.addMany(num_values - i, values + i);
+        }
+    }
+
     void remove(uint64_t value) {
         switch (_type) {
         case EMPTY:
@@ -1258,6 +1293,39 @@ public:
         return *this;
     }
 
+    // Compute the union between the current bitmap and all the provided bitmaps, it's
+    // much faster than or-ing them one by one: the elements of the SINGLE bitmaps are
+    // added in one sorted batch, and the BITMAP ones are merged at once by
+    // Roaring64Map::fastunion().
+    BitmapValue& fastunion(const std::vector<const BitmapValue*>& values) {
+        std::vector<const detail::Roaring64Map*> bitmaps;
+        std::vector<uint64_t> single_values;
+        for (const auto* value : values) {
+            switch (value->_type) {
+            case EMPTY:
+                break;
+            case SINGLE:
+                single_values.push_back(value->_sv);
+                break;
+            case BITMAP:
+                bitmaps.push_back(&value->_bitmap);
+                break;
+            }
+        }
+        if (!bitmaps.empty()) {
+            if (_type == SINGLE) {
+                single_values.push_back(_sv);
+            } else if (_type == BITMAP) {
+                bitmaps.push_back(&_bitmap);
+            }
+            _bitmap = detail::Roaring64Map::fastunion(bitmaps.size(), bitmaps.data());
+            _type = BITMAP;
+        }
+        std::sort(single_values.begin(), single_values.end());
+        add_many(single_values.data(), single_values.size());
+        return *this;
+    }
+
     // Compute the intersection between the current bitmap and the provided bitmap.
     // Possible type transitions are:
     // SINGLE -> EMPTY
@@ -1691,7 +1759,46 @@ public:
         }
         return count;
     }
-    
+
+    // Reads the elements in ascending order, the bitmap must outlive the iterator and must
+    // not be modified meanwhile.
+    class Iterator {
+    public:
+        explicit Iterator(const BitmapValue& value)
+                : _value(value),
+                  _bitmap_iter(value._bitmap, value._type != BITMAP),
+                  _bitmap_end(value._bitmap, true) {}
+
+        // Reads at most 'num' of the next elements into 'values', returns the number read.
+        size_t read(uint64_t* values, size_t num) {
+            switch (_value._type) {
+            case EMPTY:
+                return 0;
+            case SINGLE:
+                if (_single_read || num == 0) {
+                    return 0;
+                }
+                values[0] = _value._sv;
+                _single_read = true;
+                return 1;
+            case BITMAP: {
+                size_t n = 0;
+                for (; n < num && _bitmap_iter != _bitmap_end; ++n, ++_bitmap_iter) {
+                    values[n] = *_bitmap_iter;
+                }
+                return n;
+            }
+            }
+            return 0;
+        }
+
+    private:
+        const BitmapValue& _value;
+        detail::Roaring64MapSetBitForwardIterator _bitmap_iter;
+        detail::Roaring64MapSetBitForwardIterator _bitmap_end;
+        bool _single_read = false;
+    };
+
     void clear() {
         _type = EMPTY;
         _bitmap.clear();
@@ -156,8 +156,8 @@ public:
             : _compression(compression),
               _max_processed(processedSize(mergedSize, compression)),
               _max_unprocessed(unprocessedSize(unmergedSize, compression)) {
-        _processed.reserve(_max_processed);
-        _unprocessed.reserve(_max_unprocessed + 1);
+        // the buffers are not reserved up front, a digest of a few values stays small when
+        // there are many of them, e.g. one per group of an aggregation
     }
 
     TDigest(std::vector<Centroid>&& processed, std::vector<Centroid>&& unprocessed,
@@ -429,6 +429,26 @@ public:
         return true;
     }
 
+    // add values with a weight of 1, the buffer of unprocessed centroids is filled up and
+    // compressed once it's full instead of checking it after every value
+    template <typename T>
+    void add_batch(const T* values, size_t num) {
+        size_t i = 0;
+        while (i < num) {
+            const size_t room = _unprocessed.size() < _max_unprocessed
+                                        ? _max_unprocessed - _unprocessed.size()
+                                        : 1;
+            const size_t end = std::min(num, i + room);
+            for (; i < end; ++i) {
+                if (!std::isnan(values[i])) {
+                    _unprocessed.emplace_back(values[i], 1);
+                    _unprocessed_weight += 1;
+                }
+            }
+            processIfNecessary();
+        }
+    }
+
     inline void add(std::vector<Centroid>::const_iterator iter,
                     std::vector<Centroid>::const_iterator end) {
         while (iter != end) {
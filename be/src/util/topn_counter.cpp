@@ -35,12 +35,13 @@ void TopNCounter::add_item(const std::string& item, uint64_t incrementCount) {
     _ordered = false;
 }
 
-void TopNCounter::serialize(std::string* buffer) {
-    sort_retain(_capacity);
+void TopNCounter::serialize(std::string* buffer) const {
+    std::vector<Counter> sorted_buffer;
+    const auto& counters = _sorted_counters(_capacity, &sorted_buffer);
     PTopNCounter topn_counter;
     topn_counter.set_top_num(_top_num);
     topn_counter.set_space_expand_rate(_space_expand_rate);
-    for(std::vector<Counter>::const_iterator it = _counter_vec->begin(); it != _counter_vec->end(); ++it)
+    for(std::vector<Counter>::const_iterator it = counters.begin(); it != counters.end(); ++it)
     {
         PCounter* counter = topn_counter.add_counter();
         counter->set_item(it->get_item());
@@ -88,20 +89,42 @@ void TopNCounter::sort_retain(uint32_t capacity, std::vector<Counter>* sort_vec)
     }
 }
 
+const std::vector<Counter>& TopNCounter::_sorted_counters(uint32_t capacity,
+                                                         std::vector<Counter>* buffer) const {
+    if (_ordered && _counter_vec->size() <= capacity) {
+        return *_counter_vec;
+    }
+    buffer->reserve(_counter_map->size());
+    for (const auto& entry : *_counter_map) {
+        buffer->emplace_back(entry.second.get_item(), entry.second.get_count());
+    }
+    std::sort(buffer->begin(), buffer->end(), TopNComparator());
+    if (buffer->size() > capacity) {
+        buffer->erase(buffer->begin() + capacity, buffer->end());
+    }
+    return *buffer;
+}
+
 // Based on the  parallel version of the Space Saving algorithm as described in:
 // A parallel space saving algorithm for frequent items and the Hurwitz zeta distribution by Massimo Cafaro, et al.
-void TopNCounter::merge(doris::TopNCounter &&other) {
+void TopNCounter::merge(const doris::TopNCounter &other) {
     if (other._counter_map->size() == 0) {
         return;
     }
 
     _space_expand_rate = other._space_expand_rate;
     set_top_num(other._top_num);
-    bool this_full = _counter_map->size() >= _capacity;
-    bool another_full = other._counter_map->size() >= other._capacity;
+    // the smallest counts are read from the ordered counters, other is sorted into a copy
+    if (!_ordered) {
+        sort_retain(_capacity);
+    }
+    std::vector<Counter> other_buffer;
+    const auto& other_counters = other._sorted_counters(other._capacity, &other_buffer);
+    bool this_full = !_counter_vec->empty() && _counter_map->size() >= _capacity;
+    bool another_full = !other_counters.empty() && other_counters.size() >= other._capacity;
 
     uint64_t m1 = this_full ? _counter_vec->back().get_count() : 0;
-    uint64_t m2 = another_full ? other._counter_vec->back().get_count() : 0;
+    uint64_t m2 = another_full ? other_counters.back().get_count() : 0;
 
     if (another_full == true) {
         for (auto &entry : *(this->_counter_map)) {
@@ -109,30 +132,34 @@ void TopNCounter::merge(doris::TopNCounter &&other) {
         }
     }
 
-    for (auto &other_entry : *(other._counter_map)) {
-        auto itr = this->_counter_map->find(other_entry.first);
+    for (const auto &other_counter : other_counters) {
+        auto itr = this->_counter_map->find(other_counter.get_item());
         if (itr != _counter_map->end()) {
-            itr->second.add_count(other_entry.second.get_count() - m2);
+            itr->second.add_count(other_counter.get_count() - m2);
         } else {
-            this->_counter_map->insert(std::make_pair(other_entry.first,
-                    Counter(other_entry.first,other_entry.second.get_count() + m1)));
+            this->_counter_map->insert(std::make_pair(other_counter.get_item(),
+                    Counter(other_counter.get_item(), other_counter.get_count() + m1)));
         }
     }
     _ordered = false;
     sort_retain(_capacity);
 }
 
-void TopNCounter::finalize(std::string& finalize_str) {
-    if (!_ordered) {
-        sort_retain(_top_num);
-    }
+void TopNCounter::finalize(std::string& finalize_str) const {
+    finalize(finalize_str, [](const std::string& item) { return item; });
+}
+
+void TopNCounter::finalize(std::string& finalize_str,
+                           const std::function<std::string(const std::string&)>& item_to_string) const {
+    std::vector<Counter> sorted_buffer;
+    const auto& counters = _ordered ? *_counter_vec : _sorted_counters(_top_num, &sorted_buffer);
     // use json format print
     rapidjson::StringBuffer buffer;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
     uint32_t k = 0;
     writer.StartObject();
-    for (std::vector<Counter>::const_iterator it = _counter_vec->begin(); it != _counter_vec->end() && k < _top_num; ++it, ++k) {
-        writer.Key(it->get_item().data());
+    for (std::vector<Counter>::const_iterator it = counters.begin(); it != counters.end() && k < _top_num; ++it, ++k) {
+        writer.Key(item_to_string(it->get_item()).data());
         writer.Uint64(it->get_count());
     }
     writer.EndObject();
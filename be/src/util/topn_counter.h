@@ -18,6 +18,7 @@
 #ifndef DORIS_BE_SRC_UTI_TOPN_COUNTER_H
 #define DORIS_BE_SRC_UTI_TOPN_COUNTER_H
 
+#include <functional>
 #include <list>
 #include <unordered_map>
 
@@ -137,25 +138,48 @@ public:
 
     void add_item(const std::string& item, uint64_t incrementCount);
 
-    void serialize(std::string* buffer);
+    // Only the counters within the capacity are written.
+    void serialize(std::string* buffer) const;
 
     bool deserialize(const Slice& src);
 
-    void merge(doris::TopNCounter&& other);
+    void merge(const doris::TopNCounter& other);
 
     // Sort counter by count value and record it in _counter_vec
     void sort_retain(uint32_t capacity);
 
     void sort_retain(uint32_t capacity, std::vector<Counter>* sort_vec);
 
-    void finalize(std::string&);
+    void finalize(std::string&) const;
+
+    // The same as finalize(), the items are printed as item_to_string(item).
+    void finalize(std::string& finalize_str,
+                  const std::function<std::string(const std::string&)>& item_to_string) const;
 
     void set_top_num(uint32_t top_num) {
         _top_num = top_num;
         _capacity = top_num * _space_expand_rate;
     }
 
+    void set_top_num(uint32_t top_num, uint32_t space_expand_rate) {
+        _space_expand_rate = space_expand_rate;
+        set_top_num(top_num);
+    }
+
+    // Keeps at most twice the capacity of counters, when there are more of them only the
+    // counters with the largest counts are retained, like merge() does.
+    void retain_capacity() {
+        if (_capacity > 0 && _counter_map->size() >= 2 * _capacity) {
+            sort_retain(_capacity);
+        }
+    }
+
 private:
+    // The counters with the largest counts, at most 'capacity' of them, in descending order
+    // of count. They are sorted into 'buffer' unless _counter_vec already has them.
+    const std::vector<Counter>& _sorted_counters(uint32_t capacity,
+                                                 std::vector<Counter>* buffer) const;
+
     uint32_t _top_num;
     uint32_t _space_expand_rate;
     uint64_t _capacity;
@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include <fmt/format.h>
+
 #include <cstddef>
 #include <istream>
 #include <memory>
@@ -27,7 +29,10 @@
 #include <type_traits>
 #include <vector>
 
+#include "common/status.h"
+#include "vec/columns/column_string.h"
 #include "vec/common/exception.h"
+#include "vec/common/string_buffer.hpp"
 #include "vec/core/block.h"
 #include "vec/core/column_numbers.h"
 #include "vec/core/field.h"
@@ -45,6 +50,12 @@ using DataTypes = std::vector<DataTypePtr>;
 using AggregateDataPtr = char*;
 using ConstAggregateDataPtr = const char*;
 
+/// The BEs of this exec version and later read the raw states of the functions with
+/// has_fixed_size_state(), the older ones only read the states written by serialize().
+/// The version of a query is the FE config be_exec_version, which is 0 until all BEs are
+/// upgraded and it's raised by the user.
+constexpr int RAW_AGGREGATE_STATE_EXEC_VERSION = 1;
+
 /** Aggregate functions interface.
   * Instances of classes with this interface do not contain the data itself for aggregation,
   *  but contain only metadata (description) of the aggregate function,
@@ -103,6 +114,32 @@ public:
     /// Deserializes state. This function is called only for empty (just created) states.
     virtual void deserialize(AggregateDataPtr __restrict place, BufferReadable& buf, Arena* arena) const = 0;
 
+    /** Returns true if the state is a fixed size structure which neither owns memory nor points to it.
+      * If raw_state is passed to serialize_vec(), the raw bytes of such a state are its serialized form.
+      */
+    virtual bool has_fixed_size_state() const { return false; }
+
+    /** Serializes the states at places[i] + offset, one row of `to` per state.
+      * If raw_state is true and has_fixed_size_state(), the states are copied as they are instead of
+      * being written by serialize(). The caller passes it only when all BEs of the query read it,
+      * see RAW_AGGREGATE_STATE_EXEC_VERSION.
+      */
+    virtual void serialize_vec(const AggregateDataPtr* places, size_t offset, ColumnString& to,
+                               size_t num_rows, bool raw_state) const = 0;
+
+    /** Deserializes the rows of `column` and merges row i into the state at places[i] + offset.
+      * raw_state must be the same as the one the rows were serialized with.
+      */
+    virtual Status deserialize_and_merge_vec(const AggregateDataPtr* places, size_t offset,
+                                             const ColumnString& column, Arena* arena,
+                                             size_t num_rows, bool raw_state) const = 0;
+
+    /** Serializes, for every row of the arguments, the state that adding only this row would make.
+      * Used to pass rows through a streaming pre-aggregation without keeping a state per row.
+      */
+    virtual void streaming_agg_serialize(const IColumn** columns, ColumnString& to,
+                                         size_t num_rows, Arena* arena, bool raw_state) const = 0;
+
     /// Returns true if a function requires Arena to handle own states (see add(), merge(), deserialize()).
     virtual bool allocates_memory_in_arena() const { return false; }
 
@@ -139,6 +176,21 @@ public:
     virtual void add_batch_range(size_t batch_begin, size_t batch_end, AggregateDataPtr place,
                                  const IColumn** columns, Arena* arena, bool has_null = false) = 0;
 
+    /** Returns true if retract() can remove a row added by add() from a state, so that the frame
+      * of a window function can slide without adding all rows of the frame again.
+      */
+    virtual bool is_retractable() const { return false; }
+
+    /// Removes the row `row_num` which was added by add() before from the state.
+    virtual void retract(AggregateDataPtr __restrict place, const IColumn** columns, size_t row_num,
+                         Arena* arena) const {
+        LOG(FATAL) << "Aggregate function " << get_name() << " can't retract rows";
+    }
+
+    /// Returns true if the state of a range of rows can be made by merging the states of its
+    /// sub-ranges in order, e.g. by a segment tree of the states of a window partition.
+    virtual bool is_frame_mergeable() const { return false; }
+
     // only used at window function
     virtual void add_range_single_place(int64_t partition_start, int64_t partition_end,
                                         int64_t frame_start, int64_t frame_end,
@@ -201,6 +253,97 @@ public:
         for (size_t i = batch_begin; i <= batch_end; ++i)
             static_cast<const Derived*>(this)->add(place, columns, i, arena);
     }
+
+    void serialize_vec(const AggregateDataPtr* places, size_t offset, ColumnString& to,
+                       size_t num_rows, bool raw_state) const override {
+        const auto* derived = static_cast<const Derived*>(this);
+        if (raw_state && derived->has_fixed_size_state()) {
+            /// Each row is the raw state followed by the terminating zero of ColumnString.
+            const size_t state_size = derived->size_of_data();
+            auto& chars = to.get_chars();
+            auto& offsets = to.get_offsets();
+            const size_t old_chars_size = chars.size();
+            const size_t old_rows = offsets.size();
+            chars.resize(old_chars_size + (state_size + 1) * num_rows);
+            offsets.resize(old_rows + num_rows);
+            for (size_t i = 0; i < num_rows; ++i) {
+                auto* pos = chars.data() + old_chars_size + (state_size + 1) * i;
+                memcpy(pos, places[i] + offset, state_size);
+                pos[state_size] = 0;
+                offsets[old_rows + i] = old_chars_size + (state_size + 1) * (i + 1);
+            }
+            return;
+        }
+        VectorBufferWriter writer(to);
+        for (size_t i = 0; i < num_rows; ++i) {
+            derived->serialize(places[i] + offset, writer);
+            writer.commit();
+        }
+    }
+
+    Status deserialize_and_merge_vec(const AggregateDataPtr* places, size_t offset,
+                                     const ColumnString& column, Arena* arena, size_t num_rows,
+                                     bool raw_state) const override {
+        const auto* derived = static_cast<const Derived*>(this);
+        /// Rows of a string column are not aligned, so every state is copied or deserialized
+        /// into this buffer before it's merged.
+        std::unique_ptr<char[]> buffer(new char[derived->size_of_data()]);
+        if (raw_state && derived->has_fixed_size_state()) {
+            const size_t state_size = derived->size_of_data();
+            for (size_t i = 0; i < num_rows; ++i) {
+                StringRef state = column.get_data_at(i);
+                if (UNLIKELY(state.size != state_size)) {
+                    return Status::InternalError(fmt::format(
+                            "invalid state of aggregate function {}, size {}, expected {}",
+                            derived->get_name(), state.size, state_size));
+                }
+                memcpy(buffer.get(), state.data, state_size);
+                derived->merge(places[i] + offset, buffer.get(), arena);
+            }
+            return Status::OK();
+        }
+        for (size_t i = 0; i < num_rows; ++i) {
+            VectorBufferReader reader(column.get_data_at(i));
+            derived->create(buffer.get());
+            derived->deserialize(buffer.get(), reader, arena);
+            derived->merge(places[i] + offset, buffer.get(), arena);
+            derived->destroy(buffer.get());
+        }
+        return Status::OK();
+    }
+
+    void streaming_agg_serialize(const IColumn** columns, ColumnString& to, size_t num_rows,
+                                 Arena* arena, bool raw_state) const override {
+        const auto* derived = static_cast<const Derived*>(this);
+        const size_t state_size = derived->size_of_data();
+        std::unique_ptr<char[]> buffer(new char[state_size]);
+        AggregateDataPtr place = buffer.get();
+        if (raw_state && derived->has_fixed_size_state()) {
+            auto& chars = to.get_chars();
+            auto& offsets = to.get_offsets();
+            const size_t old_chars_size = chars.size();
+            const size_t old_rows = offsets.size();
+            chars.resize(old_chars_size + (state_size + 1) * num_rows);
+            offsets.resize(old_rows + num_rows);
+            for (size_t i = 0; i < num_rows; ++i) {
+                derived->create(place);
+                derived->add(place, columns, i, arena);
+                auto* pos = chars.data() + old_chars_size + (state_size + 1) * i;
+                memcpy(pos, place, state_size);
+                pos[state_size] = 0;
+                offsets[old_rows + i] = old_chars_size + (state_size + 1) * (i + 1);
+            }
+            return;
+        }
+        VectorBufferWriter writer(to);
+        for (size_t i = 0; i < num_rows; ++i) {
+            derived->create(place);
+            derived->add(place, columns, i, arena);
+            derived->serialize(place, writer);
+            writer.commit();
+            derived->destroy(place);
+        }
+    }
 };
 
 /// Implements several methods for manipulation with data. T - type of structure with data for aggregation.
@@ -0,0 +1,65 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#include "vec/aggregate_functions/aggregate_function_approx_count_distinct.h"
+
+#include "common/logging.h"
+#include "vec/aggregate_functions/aggregate_function_simple_factory.h"
+#include "vec/aggregate_functions/factory_helpers.h"
+#include "vec/aggregate_functions/helpers.h"
+
+namespace doris::vectorized {
+
+AggregateFunctionPtr create_aggregate_function_approx_count_distinct(
+        const std::string& name, const DataTypes& argument_types, const Array& parameters,
+        const bool result_is_nullable) {
+    assert_no_parameters(name, parameters);
+    assert_unary(name, argument_types);
+
+    WhichDataType which(argument_types[0]);
+#define DISPATCH(TYPE)                                                                     \
+    if (which.idx == TypeIndex::TYPE)                                                      \
+        return std::make_shared<AggregateFunctionApproxCountDistinct<ColumnVector<TYPE>>>( \
+                argument_types);
+    FOR_NUMERIC_TYPES(DISPATCH)
+#undef DISPATCH
+    if (which.is_date_or_datetime()) {
+        return std::make_shared<AggregateFunctionApproxCountDistinct<ColumnVector<Int64>>>(
+                argument_types);
+    }
+    if (which.is_decimal128()) {
+        return std::make_shared<
+                AggregateFunctionApproxCountDistinct<ColumnDecimal<Decimal128>>>(argument_types);
+    }
+    if (which.is_string_or_fixed_string()) {
+        return std::make_shared<AggregateFunctionApproxCountDistinct<ColumnString>>(
+                argument_types);
+    }
+
+    LOG(WARNING) << fmt::format("Illegal type {} of argument for aggregate function {}",
+                                argument_types[0]->get_name(), name);
+    return nullptr;
+}
+
+void register_aggregate_function_approx_count_distinct(AggregateFunctionSimpleFactory& factory) {
+    factory.register_function("approx_count_distinct",
+                              create_aggregate_function_approx_count_distinct);
+    factory.register_function("ndv", create_aggregate_function_approx_count_distinct);
+}
+
+} // namespace doris::vectorized
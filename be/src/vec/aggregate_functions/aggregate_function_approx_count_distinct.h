@@ -0,0 +1,150 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#pragma once
+
+#include <type_traits>
+
+#include "olap/hll.h"
+#include "util/hash_util.hpp"
+#include "util/slice.h"
+#include "vec/aggregate_functions/aggregate_function.h"
+#include "vec/columns/column_decimal.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/common/assert_cast.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/io/io_helper.h"
+
+namespace doris::vectorized {
+
+struct AggregateFunctionApproxCountDistinctData {
+    HyperLogLog hll_data;
+
+    /// Hash values of 0 are skipped, like the row engine does.
+    void add(uint64_t hash_value) {
+        if (hash_value != 0) {
+            hll_data.update(hash_value);
+        }
+    }
+
+    void add_batch(uint64_t* hash_values, size_t num) {
+        size_t num_non_zero = 0;
+        for (size_t i = 0; i < num; ++i) {
+            hash_values[num_non_zero] = hash_values[i];
+            num_non_zero += hash_values[i] != 0;
+        }
+        hll_data.update_batch(hash_values, num_non_zero);
+    }
+
+    void merge(const AggregateFunctionApproxCountDistinctData& rhs) {
+        hll_data.merge(rhs.hll_data);
+    }
+
+    /// The HLL is written in its compact encoding: the explicit hash values, the non-zero
+    /// registers or all registers, whichever is the smallest.
+    void write(BufferWritable& buf) const {
+        std::string result(hll_data.max_serialized_size(), '0');
+        size_t size = hll_data.serialize((uint8_t*)result.data());
+        result.resize(size);
+        write_binary(result, buf);
+    }
+
+    void read(BufferReadable& buf) {
+        StringRef ref;
+        read_binary(ref, buf);
+        hll_data.deserialize(Slice(ref.data, ref.size));
+    }
+
+    Int64 get_cardinality() const { return hll_data.estimate_cardinality(); }
+
+    void reset() { hll_data.clear(); }
+};
+
+/// approx_count_distinct(x) and its alias ndv(x), the values are hashed with the same murmur
+/// hash as the row engine and counted in a HyperLogLog. ColumnDataType is the column of the
+/// argument, ColumnString or a column of fixed-size values.
+template <typename ColumnDataType>
+class AggregateFunctionApproxCountDistinct final
+        : public IAggregateFunctionDataHelper<
+                  AggregateFunctionApproxCountDistinctData,
+                  AggregateFunctionApproxCountDistinct<ColumnDataType>> {
+public:
+    /// The rows of a batch are hashed in chunks of this size before they are put into the HLL.
+    static constexpr size_t HASH_CHUNK_SIZE = 1024;
+
+    AggregateFunctionApproxCountDistinct(const DataTypes& argument_types_)
+            : IAggregateFunctionDataHelper<AggregateFunctionApproxCountDistinctData,
+                                           AggregateFunctionApproxCountDistinct<ColumnDataType>>(
+                      argument_types_, {}) {}
+
+    String get_name() const override { return "approx_count_distinct"; }
+
+    DataTypePtr get_return_type() const override { return std::make_shared<DataTypeInt64>(); }
+
+    static uint64_t ALWAYS_INLINE hash(const IColumn& column, size_t row_num) {
+        if constexpr (std::is_same_v<ColumnDataType, ColumnString>) {
+            StringRef value = assert_cast<const ColumnString&>(column).get_data_at(row_num);
+            return HashUtil::murmur_hash64A(value.data, value.size, HashUtil::MURMUR_SEED);
+        } else {
+            const auto& value = assert_cast<const ColumnDataType&>(column).get_data()[row_num];
+            return HashUtil::murmur_hash64A(&value, sizeof(value), HashUtil::MURMUR_SEED);
+        }
+    }
+
+    void add(AggregateDataPtr __restrict place, const IColumn** columns, size_t row_num,
+             Arena*) const override {
+        this->data(place).add(hash(*columns[0], row_num));
+    }
+
+    void add_batch_single_place(size_t batch_size, AggregateDataPtr place, const IColumn** columns,
+                                Arena*) const override {
+        uint64_t hash_values[HASH_CHUNK_SIZE];
+        for (size_t begin = 0; begin < batch_size; begin += HASH_CHUNK_SIZE) {
+            size_t num = std::min(HASH_CHUNK_SIZE, batch_size - begin);
+            for (size_t i = 0; i < num; ++i) {
+                hash_values[i] = hash(*columns[0], begin + i);
+            }
+            this->data(place).add_batch(hash_values, num);
+        }
+    }
+
+    void reset(AggregateDataPtr place) const override { this->data(place).reset(); }
+
+    void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs,
+               Arena*) const override {
+        this->data(place).merge(this->data(rhs));
+    }
+
+    void serialize(ConstAggregateDataPtr __restrict place, BufferWritable& buf) const override {
+        this->data(place).write(buf);
+    }
+
+    void deserialize(AggregateDataPtr __restrict place, BufferReadable& buf,
+                     Arena*) const override {
+        this->data(place).read(buf);
+    }
+
+    void insert_result_into(ConstAggregateDataPtr __restrict place, IColumn& to) const override {
+        assert_cast<ColumnInt64&>(to).get_data().push_back(this->data(place).get_cardinality());
+    }
+
+    const char* get_header_file_path() const override { return __FILE__; }
+};
+
+} // namespace doris::vectorized
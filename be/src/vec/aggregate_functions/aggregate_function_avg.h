@@ -96,6 +96,20 @@ public:
         ++this->data(place).count;
     }
 
+    /// Retracting floating point values would accumulate rounding errors.
+    bool is_retractable() const override {
+        return !std::is_floating_point_v<decltype(Data::sum)>;
+    }
+
+    void retract(AggregateDataPtr __restrict place, const IColumn** columns, size_t row_num,
+                 Arena*) const override {
+        const auto& column = static_cast<const ColVecType&>(*columns[0]);
+        this->data(place).sum -= column.get_data()[row_num];
+        --this->data(place).count;
+    }
+
+    bool is_frame_mergeable() const override { return true; }
+
     void reset(AggregateDataPtr place) const override {
         this->data(place).sum = 0;
         this->data(place).count = 0;
@@ -114,6 +128,8 @@ public:
         this->data(place).read(buf);
     }
 
+    bool has_fixed_size_state() const override { return true; }
+
     void insert_result_into(ConstAggregateDataPtr __restrict place, IColumn& to) const override {
         auto& column = static_cast<ColVecResult&>(to);
         column.get_data().push_back(this->data(place).template result<ResultType>());
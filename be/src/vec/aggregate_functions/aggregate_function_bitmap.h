@@ -16,11 +16,15 @@
 // under the License.
 
 #pragma once
+#include <parallel_hashmap/phmap.h>
+
+#include <algorithm>
 #include <istream>
 #include <ostream>
+#include <vector>
 
 #include "vec/aggregate_functions/aggregate_function.h"
-#include "vec/columns/column_complex.h"
+#include "vec/columns/column_bitmap.h"
 #include "vec/columns/column_nullable.h"
 #include "vec/common/assert_cast.h"
 #include "vec/data_types/data_type_bitmap.h"
@@ -38,14 +42,37 @@ struct AggregateFunctionBitmapUnionOp {
         res.add(data);
     }
 
-    static void add(BitmapValue& res, const BitmapValue& data) { res |= data; }
+    static void add(BitmapValue& res, const ColumnBitmap& column, size_t row) {
+        column.union_into(row, &res);
+    }
+
+    // Adds the given rows of the column at once.
+    static void add_many(BitmapValue& res, const ColumnBitmap& column, const uint32_t* rows,
+                         size_t num_rows, ColumnBitmap::UnionBuffers* buffers) {
+        column.union_into(rows, num_rows, &res, buffers);
+    }
+
+    template <typename ColumnType>
+    static void add_many(BitmapValue& res, const ColumnType& column, const uint32_t* rows,
+                         size_t num_rows, ColumnBitmap::UnionBuffers* buffers) {
+        const auto& data = column.get_data();
+        auto& values = buffers->single_values;
+        values.resize(num_rows);
+        for (size_t i = 0; i < num_rows; ++i) {
+            values[i] = data[rows[i]];
+        }
+        std::sort(values.begin(), values.end());
+        res.add_many(values.data(), values.size());
+    }
 
     static void merge(BitmapValue& res, const BitmapValue& data) { res |= data; }
 };
 
 struct AggregateFunctionBitmapIntersectOp {
     static constexpr auto name = "bitmap_intersect";
-    static void add(BitmapValue& res, const BitmapValue& data) { res &= data; }
+    static void add(BitmapValue& res, const ColumnBitmap& column, size_t row) {
+        res &= column.get_element(row);
+    }
 
     static void merge(BitmapValue& res, const BitmapValue& data) { res &= data; }
 };
@@ -59,6 +86,23 @@ struct AggregateFunctionBitmapData {
         Op::add(value, data);
     }
 
+    void add(const ColumnBitmap& column, size_t row) { Op::add(value, column, row); }
+
+    template <typename ColumnType>
+    void add_row(const ColumnType& column, size_t row) {
+        if constexpr (std::is_same_v<ColumnType, ColumnBitmap>) {
+            add(column, row);
+        } else {
+            add(column.get_data()[row]);
+        }
+    }
+
+    template <typename ColumnType>
+    void add_many(const ColumnType& column, const uint32_t* rows, size_t num_rows,
+                  ColumnBitmap::UnionBuffers* buffers) {
+        Op::add_many(value, column, rows, num_rows, buffers);
+    }
+
     void merge(const BitmapValue& data) { Op::merge(value, data); }
 
     void write(BufferWritable& buf) const { DataTypeBitMap::serialize_as_stream(value, buf); }
@@ -68,6 +112,88 @@ struct AggregateFunctionBitmapData {
     BitmapValue& get() { return value; }
 };
 
+// If the states of a batch have fewer rows than this on average, grouping the rows costs more
+// than unioning them at once saves.
+inline constexpr size_t MIN_BITMAP_ROWS_PER_STATE = 4;
+
+// Adds the rows of a batch to their states, all the rows of a state in one add_many() call, so
+// that they are unioned at once. The rows are grouped by a counting sort on the states in order
+// of their first rows, or added one by one if there are too many states. The rows marked in
+// 'null_map' are skipped.
+template <typename Data, typename ColumnType>
+void add_bitmap_batch(size_t batch_size, AggregateDataPtr* places, size_t place_offset,
+                      const ColumnType& column, const NullMap* null_map) {
+    const size_t max_groups = batch_size / MIN_BITMAP_ROWS_PER_STATE;
+    phmap::flat_hash_map<AggregateDataPtr, uint32_t> group_ids;
+    std::vector<AggregateDataPtr> group_places;
+    std::vector<uint32_t> group_offsets;
+    std::vector<uint32_t> row_groups(batch_size);
+    bool grouped = true;
+    for (uint32_t i = 0; i < batch_size; ++i) {
+        if (null_map != nullptr && (*null_map)[i]) {
+            continue;
+        }
+        auto [it, inserted] = group_ids.try_emplace(places[i], group_places.size());
+        if (inserted) {
+            if (group_places.size() == max_groups) {
+                grouped = false;
+                break;
+            }
+            group_places.push_back(places[i]);
+            group_offsets.push_back(0);
+        }
+        row_groups[i] = it->second;
+        ++group_offsets[it->second];
+    }
+
+    if (!grouped) {
+        for (size_t i = 0; i < batch_size; ++i) {
+            if (null_map == nullptr || !(*null_map)[i]) {
+                reinterpret_cast<Data*>(places[i] + place_offset)->add_row(column, i);
+            }
+        }
+        return;
+    }
+
+    // the sizes of the groups to their offsets in 'rows'
+    uint32_t num_rows = 0;
+    for (auto& offset : group_offsets) {
+        num_rows += offset;
+        offset = num_rows - offset;
+    }
+    std::vector<uint32_t> rows(num_rows);
+    for (uint32_t i = 0; i < batch_size; ++i) {
+        if (null_map == nullptr || !(*null_map)[i]) {
+            rows[group_offsets[row_groups[i]]++] = i;
+        }
+    }
+    // each offset is now the end of its group
+    ColumnBitmap::UnionBuffers buffers;
+    uint32_t begin = 0;
+    for (size_t group = 0; group < group_places.size(); ++group) {
+        uint32_t end = group_offsets[group];
+        reinterpret_cast<Data*>(group_places[group] + place_offset)
+                ->add_many(column, rows.data() + begin, end - begin, &buffers);
+        begin = end;
+    }
+}
+
+// Adds the rows [begin, end) to a state in one add_many() call, skipping the rows marked in
+// 'null_map'.
+template <typename Data, typename ColumnType>
+void add_bitmap_range(size_t begin, size_t end, AggregateDataPtr place, const ColumnType& column,
+                      const NullMap* null_map) {
+    std::vector<uint32_t> rows;
+    rows.reserve(end - begin);
+    for (uint32_t i = begin; i < end; ++i) {
+        if (null_map == nullptr || !(*null_map)[i]) {
+            rows.push_back(i);
+        }
+    }
+    ColumnBitmap::UnionBuffers buffers;
+    reinterpret_cast<Data*>(place)->add_many(column, rows.data(), rows.size(), &buffers);
+}
+
 template <typename Op>
 class AggregateFunctionBitmapOp final
         : public IAggregateFunctionDataHelper<AggregateFunctionBitmapData<Op>,
@@ -76,6 +202,10 @@ public:
     using ResultDataType = BitmapValue;
     using ColVecType = ColumnBitmap;
     using ColVecResult = ColumnBitmap;
+    using Data = AggregateFunctionBitmapData<Op>;
+    using Base = IAggregateFunctionDataHelper<Data, AggregateFunctionBitmapOp<Op>>;
+    // the rows of a batch are unioned at once, the intersection gains nothing from it
+    static constexpr bool batched = std::is_same_v<Op, AggregateFunctionBitmapUnionOp>;
 
     String get_name() const override { return Op::name; }
 
@@ -88,7 +218,37 @@ public:
     void add(AggregateDataPtr __restrict place, const IColumn** columns, size_t row_num,
              Arena*) const override {
         const auto& column = static_cast<const ColVecType&>(*columns[0]);
-        this->data(place).add(column.get_data()[row_num]);
+        this->data(place).add(column, row_num);
+    }
+
+    void add_batch(size_t batch_size, AggregateDataPtr* places, size_t place_offset,
+                   const IColumn** columns, Arena* arena) const override {
+        if constexpr (batched) {
+            add_bitmap_batch<Data>(batch_size, places, place_offset,
+                                   static_cast<const ColVecType&>(*columns[0]), nullptr);
+        } else {
+            Base::add_batch(batch_size, places, place_offset, columns, arena);
+        }
+    }
+
+    void add_batch_single_place(size_t batch_size, AggregateDataPtr place, const IColumn** columns,
+                                Arena* arena) const override {
+        if constexpr (batched) {
+            add_bitmap_range<Data>(0, batch_size, place,
+                                   static_cast<const ColVecType&>(*columns[0]), nullptr);
+        } else {
+            Base::add_batch_single_place(batch_size, place, columns, arena);
+        }
+    }
+
+    void add_batch_range(size_t batch_begin, size_t batch_end, AggregateDataPtr place,
+                         const IColumn** columns, Arena* arena, bool has_null) override {
+        if constexpr (batched) {
+            add_bitmap_range<Data>(batch_begin, batch_end + 1, place,
+                                   static_cast<const ColVecType&>(*columns[0]), nullptr);
+        } else {
+            Base::add_batch_range(batch_begin, batch_end, place, columns, arena, has_null);
+        }
     }
 
     void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs, Arena*) const override {
@@ -106,8 +266,7 @@ public:
 
     void insert_result_into(ConstAggregateDataPtr __restrict place, IColumn& to) const override {
         auto& column = static_cast<ColVecResult&>(to);
-        column.get_data().push_back(
-                const_cast<AggregateFunctionBitmapData<Op>&>(this->data(place)).get());
+        column.insert_value(this->data(place).value);
     }
 
     const char* get_header_file_path() const override { return __FILE__; }
@@ -138,14 +297,35 @@ public:
             if (!nullable_column.is_null_at(row_num)) {
                 const auto& column =
                         static_cast<const ColVecType&>(nullable_column.get_nested_column());
-                this->data(place).add(column.get_data()[row_num]);
+                _add(place, column, row_num);
             }
         } else {
             const auto& column = static_cast<const ColVecType&>(*columns[0]);
-            this->data(place).add(column.get_data()[row_num]);
+            _add(place, column, row_num);
         }
     }
 
+    void add_batch(size_t batch_size, AggregateDataPtr* places, size_t place_offset,
+                   const IColumn** columns, Arena*) const override {
+        const NullMap* null_map = nullptr;
+        const auto& column = _get_column(columns, &null_map);
+        add_bitmap_batch<AggFunctionData>(batch_size, places, place_offset, column, null_map);
+    }
+
+    void add_batch_single_place(size_t batch_size, AggregateDataPtr place, const IColumn** columns,
+                                Arena*) const override {
+        const NullMap* null_map = nullptr;
+        const auto& column = _get_column(columns, &null_map);
+        add_bitmap_range<AggFunctionData>(0, batch_size, place, column, null_map);
+    }
+
+    void add_batch_range(size_t batch_begin, size_t batch_end, AggregateDataPtr place,
+                         const IColumn** columns, Arena*, bool) override {
+        const NullMap* null_map = nullptr;
+        const auto& column = _get_column(columns, &null_map);
+        add_bitmap_range<AggFunctionData>(batch_begin, batch_end + 1, place, column, null_map);
+    }
+
     void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs, Arena*) const override {
         this->data(place).merge(const_cast<AggFunctionData&>(this->data(rhs)).get());
     }
@@ -165,6 +345,21 @@ public:
     }
 
     const char* get_header_file_path() const override { return __FILE__; }
+
+private:
+    static const ColVecType& _get_column(const IColumn** columns, const NullMap** null_map) {
+        if constexpr (nullable) {
+            const auto& nullable_column = assert_cast<const ColumnNullable&>(*columns[0]);
+            *null_map = &nullable_column.get_null_map_data();
+            return static_cast<const ColVecType&>(nullable_column.get_nested_column());
+        } else {
+            return static_cast<const ColVecType&>(*columns[0]);
+        }
+    }
+
+    void _add(AggregateDataPtr __restrict place, const ColVecType& column, size_t row_num) const {
+        this->data(place).add_row(column, row_num);
+    }
 };
 
 AggregateFunctionPtr create_aggregate_function_bitmap_union(const std::string& name,
@@ -50,6 +50,14 @@ public:
         ++data(place).count;
     }
 
+    bool is_retractable() const override { return true; }
+
+    void retract(AggregateDataPtr __restrict place, const IColumn**, size_t, Arena*) const override {
+        --data(place).count;
+    }
+
+    bool is_frame_mergeable() const override { return true; }
+
     void reset(AggregateDataPtr place) const override {
         this->data(place).count = 0;
     }
@@ -66,6 +74,8 @@ public:
         read_var_uint(data(place).count, buf);
     }
 
+    bool has_fixed_size_state() const override { return true; }
+
     void insert_result_into(ConstAggregateDataPtr __restrict place, IColumn& to) const override {
         assert_cast<ColumnInt64&>(to).get_data().push_back(data(place).count);
     }
@@ -99,6 +109,15 @@ public:
         data(place).count += !assert_cast<const ColumnNullable&>(*columns[0]).is_null_at(row_num);
     }
 
+    bool is_retractable() const override { return true; }
+
+    void retract(AggregateDataPtr __restrict place, const IColumn** columns, size_t row_num,
+                 Arena*) const override {
+        data(place).count -= !assert_cast<const ColumnNullable&>(*columns[0]).is_null_at(row_num);
+    }
+
+    bool is_frame_mergeable() const override { return true; }
+
     void reset(AggregateDataPtr place) const override {
         data(place).count = 0;
     }
@@ -115,6 +134,8 @@ public:
         read_var_uint(data(place).count, buf);
     }
 
+    bool has_fixed_size_state() const override { return true; }
+
     void insert_result_into(ConstAggregateDataPtr __restrict place, IColumn& to) const override {
         assert_cast<ColumnInt64&>(to).get_data().push_back(data(place).count);
     }
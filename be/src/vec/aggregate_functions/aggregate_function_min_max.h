@@ -39,6 +39,8 @@ private:
     T value;
 
 public:
+    static constexpr bool IS_FIXED_SIZE = true;
+
     bool has() const { return has_value; }
 
     void insert_result_into(IColumn& to) const {
@@ -154,6 +156,8 @@ private:
     int128_t value;
 
 public:
+    static constexpr bool IS_FIXED_SIZE = true;
+
     bool has() const { return has_value; }
 
     void insert_result_into(IColumn& to) const {
@@ -274,6 +278,7 @@ private:
     char* large_data = nullptr;
 
 public:
+    static constexpr bool IS_FIXED_SIZE = false;
     static constexpr Int32 AUTOMATIC_STORAGE_SIZE = 64;
     static constexpr Int32 MAX_SMALL_STRING_SIZE =
             AUTOMATIC_STORAGE_SIZE - sizeof(size) - sizeof(capacity) - sizeof(large_data);
@@ -513,6 +518,10 @@ public:
         this->data(place).read(buf);
     }
 
+    bool has_fixed_size_state() const override { return Data::IS_FIXED_SIZE; }
+
+    bool is_frame_mergeable() const override { return true; }
+
     bool allocates_memory_in_arena() const override { return AllocatesMemoryInArena; }
 
     void insert_result_into(ConstAggregateDataPtr __restrict place, IColumn& to) const override {
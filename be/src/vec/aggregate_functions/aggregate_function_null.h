@@ -140,6 +140,10 @@ public:
         }
     }
 
+    bool has_fixed_size_state() const override { return nested_function->has_fixed_size_state(); }
+
+    bool is_frame_mergeable() const override { return nested_function->is_frame_mergeable(); }
+
     void insert_result_into(ConstAggregateDataPtr __restrict place, IColumn& to) const override {
         if constexpr (result_is_nullable) {
             ColumnNullable& to_concrete = assert_cast<ColumnNullable&>(to);
@@ -188,6 +192,21 @@ public:
         }
     }
 
+    /// Whether a nullable result is NULL is unknown after its non-NULL values are retracted.
+    bool is_retractable() const override {
+        return !result_is_nullable && this->nested_function->is_retractable();
+    }
+
+    void retract(AggregateDataPtr __restrict place, const IColumn** columns, size_t row_num,
+                 Arena* arena) const override {
+        const ColumnNullable* column = assert_cast<const ColumnNullable*>(columns[0]);
+        if (!column->is_null_at(row_num)) {
+            const IColumn* nested_column = &column->get_nested_column();
+            this->nested_function->retract(this->nested_place(place), &nested_column, row_num,
+                                           arena);
+        }
+    }
+
     void add_batch_single_place(size_t batch_size, AggregateDataPtr place, const IColumn** columns,
                                 Arena* arena) const override {
         const ColumnNullable* column = assert_cast<const ColumnNullable*>(columns[0]);
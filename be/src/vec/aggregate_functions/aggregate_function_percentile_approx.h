@@ -0,0 +1,184 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#pragma once
+
+#include <cmath>
+#include <memory>
+
+#include "util/tdigest.h"
+#include "vec/aggregate_functions/aggregate_function.h"
+#include "vec/columns/column_vector.h"
+#include "vec/common/assert_cast.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/io/io_helper.h"
+
+namespace doris::vectorized {
+
+struct PercentileApproxState {
+    static constexpr double INIT_QUANTILE = -1.0;
+    static constexpr double DEFAULT_COMPRESSION = 10000;
+
+    /// Created by the first value, so that groups without values don't allocate a digest.
+    std::unique_ptr<TDigest> digest;
+    double target_quantile = INIT_QUANTILE;
+
+    /// The compression is only used if it's in [2048, 10000], like the row engine does.
+    void init(double compression) {
+        if (!(compression >= 2048 && compression <= 10000)) {
+            compression = DEFAULT_COMPRESSION;
+        }
+        digest = std::make_unique<TDigest>(compression);
+    }
+
+    void add(double value, double quantile, double compression) {
+        if (!digest) {
+            init(compression);
+        }
+        digest->add(value);
+        target_quantile = quantile;
+    }
+
+    void add_batch(const double* values, size_t num, double quantile, double compression) {
+        if (!digest) {
+            init(compression);
+        }
+        digest->add_batch(values, num);
+        target_quantile = quantile;
+    }
+
+    void merge(const PercentileApproxState& rhs) {
+        if (rhs.digest) {
+            if (!digest) {
+                digest = std::make_unique<TDigest>(rhs.digest->compression());
+            }
+            digest->merge(rhs.digest.get());
+        }
+        // the quantile is only set once, the states without values have no quantile
+        if (target_quantile == INIT_QUANTILE) {
+            target_quantile = rhs.target_quantile;
+        }
+    }
+
+    /// The buffered values are compressed into the centroids before the digest is written.
+    void write(BufferWritable& buf) const {
+        write_binary(target_quantile, buf);
+        std::string serialized;
+        if (digest) {
+            if (digest->haveUnprocessed()) {
+                digest->compress();
+            }
+            serialized.resize(digest->serialized_size());
+            digest->serialize((uint8_t*)serialized.data());
+        }
+        write_binary(serialized, buf);
+    }
+
+    void read(BufferReadable& buf) {
+        read_binary(target_quantile, buf);
+        StringRef serialized;
+        read_binary(serialized, buf);
+        if (serialized.size > 0) {
+            digest = std::make_unique<TDigest>();
+            digest->unserialize((const uint8_t*)serialized.data);
+        }
+    }
+
+    double get() const {
+        if (!digest) {
+            return NAN;
+        }
+        return digest->quantile(target_quantile);
+    }
+
+    void reset() {
+        digest.reset();
+        target_quantile = INIT_QUANTILE;
+    }
+};
+
+/// percentile_approx(x, quantile[, compression]), all arguments are DOUBLE. The quantile and
+/// the compression are constants, they are read from the first row of a batch.
+class AggregateFunctionPercentileApprox final
+        : public IAggregateFunctionDataHelper<PercentileApproxState,
+                                              AggregateFunctionPercentileApprox> {
+public:
+    AggregateFunctionPercentileApprox(const DataTypes& argument_types_)
+            : IAggregateFunctionDataHelper<PercentileApproxState,
+                                           AggregateFunctionPercentileApprox>(argument_types_,
+                                                                              {}) {}
+
+    String get_name() const override { return "percentile_approx"; }
+
+    DataTypePtr get_return_type() const override { return std::make_shared<DataTypeFloat64>(); }
+
+    void add(AggregateDataPtr __restrict place, const IColumn** columns, size_t row_num,
+             Arena*) const override {
+        this->data(place).add(value_data(columns)[row_num], get_quantile(columns, row_num),
+                              get_compression(columns, row_num));
+    }
+
+    void add_batch_single_place(size_t batch_size, AggregateDataPtr place, const IColumn** columns,
+                                Arena*) const override {
+        if (batch_size == 0) {
+            return;
+        }
+        this->data(place).add_batch(value_data(columns), batch_size, get_quantile(columns, 0),
+                                    get_compression(columns, 0));
+    }
+
+    void reset(AggregateDataPtr place) const override { this->data(place).reset(); }
+
+    void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs,
+               Arena*) const override {
+        this->data(place).merge(this->data(rhs));
+    }
+
+    void serialize(ConstAggregateDataPtr __restrict place, BufferWritable& buf) const override {
+        this->data(place).write(buf);
+    }
+
+    void deserialize(AggregateDataPtr __restrict place, BufferReadable& buf,
+                     Arena*) const override {
+        this->data(place).read(buf);
+    }
+
+    void insert_result_into(ConstAggregateDataPtr __restrict place, IColumn& to) const override {
+        assert_cast<ColumnFloat64&>(to).get_data().push_back(this->data(place).get());
+    }
+
+    const char* get_header_file_path() const override { return __FILE__; }
+
+private:
+    static const Float64* value_data(const IColumn** columns) {
+        return assert_cast<const ColumnFloat64&>(*columns[0]).get_data().data();
+    }
+
+    static double get_quantile(const IColumn** columns, size_t row_num) {
+        return assert_cast<const ColumnFloat64&>(*columns[1]).get_data()[row_num];
+    }
+
+    double get_compression(const IColumn** columns, size_t row_num) const {
+        if (this->argument_types.size() < 3) {
+            return PercentileApproxState::DEFAULT_COMPRESSION;
+        }
+        return assert_cast<const ColumnFloat64&>(*columns[2]).get_data()[row_num];
+    }
+};
+
+} // namespace doris::vectorized
@@ -38,6 +38,8 @@ struct AggregateFunctionSumData {
 
     void add(T value) { sum += value; }
 
+    void retract(T value) { sum -= value; }
+
     void merge(const AggregateFunctionSumData& rhs) { sum += rhs.sum; }
 
     void write(BufferWritable& buf) const { write_binary(sum, buf); }
@@ -82,6 +84,17 @@ public:
         const auto& column = static_cast<const ColVecType&>(*columns[0]);
         this->data(place).add(column.get_data()[row_num]);
     }
+
+    /// Retracting floating point values would accumulate rounding errors.
+    bool is_retractable() const override { return !std::is_floating_point_v<TResult>; }
+
+    void retract(AggregateDataPtr __restrict place, const IColumn** columns, size_t row_num,
+                 Arena*) const override {
+        const auto& column = static_cast<const ColVecType&>(*columns[0]);
+        this->data(place).retract(column.get_data()[row_num]);
+    }
+
+    bool is_frame_mergeable() const override { return true; }
     
     void reset(AggregateDataPtr place) const override {
         this->data(place).sum = {};
@@ -99,6 +112,8 @@ public:
         this->data(place).read(buf);
     }
 
+    bool has_fixed_size_state() const override { return true; }
+
     void insert_result_into(ConstAggregateDataPtr __restrict place, IColumn& to) const override {
         auto& column = static_cast<ColVecResult&>(to);
         column.get_data().push_back(this->data(place).get());
@@ -0,0 +1,152 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#pragma once
+
+#include <parallel_hashmap/phmap.h>
+
+#include <string>
+
+#include "util/slice.h"
+#include "util/topn_counter.h"
+#include "vec/aggregate_functions/aggregate_function.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/common/assert_cast.h"
+#include "vec/common/string_ref.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/io/io_helper.h"
+
+namespace doris::vectorized {
+
+/// The items are the raw bytes of the values, they are only printed when the result is built.
+struct AggregateFunctionTopNData {
+    TopNCounter counter;
+
+    void add(const StringRef& item, uint64_t count, uint32_t top_num, uint32_t space_expand_rate) {
+        counter.set_top_num(top_num, space_expand_rate);
+        counter.add_item(item.to_string(), count);
+        counter.retain_capacity();
+    }
+
+    void merge(const AggregateFunctionTopNData& rhs) { counter.merge(rhs.counter); }
+
+    /// Only the counters within the capacity are written, with the protobuf encoding of
+    /// the row engine.
+    void write(BufferWritable& buf) const {
+        std::string buffer;
+        counter.serialize(&buffer);
+        write_binary(buffer, buf);
+    }
+
+    void read(BufferReadable& buf) {
+        StringRef ref;
+        read_binary(ref, buf);
+        counter.deserialize(Slice(ref.data, ref.size));
+    }
+};
+
+/// topn(x, top_num[, space_expand_rate]) returns the top_num most frequent values with their
+/// counts as a JSON object. It's the Space-Saving algorithm of TopNCounter: the counters are
+/// pruned to top_num * space_expand_rate once there are twice as many. top_num and
+/// space_expand_rate are constants, they are read from the first row of a batch.
+template <typename ColumnDataType>
+class AggregateFunctionTopN final
+        : public IAggregateFunctionDataHelper<AggregateFunctionTopNData,
+                                              AggregateFunctionTopN<ColumnDataType>> {
+public:
+    AggregateFunctionTopN(const DataTypes& argument_types_)
+            : IAggregateFunctionDataHelper<AggregateFunctionTopNData,
+                                           AggregateFunctionTopN<ColumnDataType>>(
+                      argument_types_, {}) {}
+
+    String get_name() const override { return "topn"; }
+
+    DataTypePtr get_return_type() const override { return std::make_shared<DataTypeString>(); }
+
+    void add(AggregateDataPtr __restrict place, const IColumn** columns, size_t row_num,
+             Arena*) const override {
+        this->data(place).add(
+                assert_cast<const ColumnDataType&>(*columns[0]).get_data_at(row_num), 1,
+                get_top_num(columns, row_num), get_space_expand_rate(columns, row_num));
+    }
+
+    /// The rows of the batch are counted in a hash map first, so every distinct value of the
+    /// batch updates the counters once.
+    void add_batch_single_place(size_t batch_size, AggregateDataPtr place, const IColumn** columns,
+                                Arena*) const override {
+        if (batch_size == 0) {
+            return;
+        }
+        const auto& column = assert_cast<const ColumnDataType&>(*columns[0]);
+        phmap::flat_hash_map<StringRef, uint64_t, StringRefHash> counts;
+        for (size_t i = 0; i < batch_size; ++i) {
+            ++counts[column.get_data_at(i)];
+        }
+        uint32_t top_num = get_top_num(columns, 0);
+        uint32_t space_expand_rate = get_space_expand_rate(columns, 0);
+        for (const auto& [item, count] : counts) {
+            this->data(place).add(item, count, top_num, space_expand_rate);
+        }
+    }
+
+    void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs,
+               Arena*) const override {
+        this->data(place).merge(this->data(rhs));
+    }
+
+    void serialize(ConstAggregateDataPtr __restrict place, BufferWritable& buf) const override {
+        this->data(place).write(buf);
+    }
+
+    void deserialize(AggregateDataPtr __restrict place, BufferReadable& buf,
+                     Arena*) const override {
+        this->data(place).read(buf);
+    }
+
+    void insert_result_into(ConstAggregateDataPtr __restrict place, IColumn& to) const override {
+        const auto& argument_type = this->argument_types[0];
+        std::string result;
+        this->data(place).counter.finalize(result, [&](const std::string& item) {
+            if constexpr (std::is_same_v<ColumnDataType, ColumnString>) {
+                return item;
+            } else {
+                auto column = argument_type->create_column();
+                column->insert_data(item.data(), item.size());
+                return argument_type->to_string(*column, 0);
+            }
+        });
+        assert_cast<ColumnString&>(to).insert_data(result.data(), result.size());
+    }
+
+    const char* get_header_file_path() const override { return __FILE__; }
+
+private:
+    static uint32_t get_top_num(const IColumn** columns, size_t row_num) {
+        return assert_cast<const ColumnInt32&>(*columns[1]).get_data()[row_num];
+    }
+
+    uint32_t get_space_expand_rate(const IColumn** columns, size_t row_num) const {
+        if (this->argument_types.size() < 3) {
+            return DEFAULT_SPACE_EXPAND_RATE;
+        }
+        return assert_cast<const ColumnInt32&>(*columns[2]).get_data()[row_num];
+    }
+};
+
+} // namespace doris::vectorized
@@ -0,0 +1,223 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/columns/column_bitmap.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "util/coding.h"
+#include "vec/columns/columns_common.h"
+#include "vec/common/memcpy_small.h"
+
+namespace doris::vectorized {
+
+uint64_t ColumnBitmap::cardinality(size_t n) const {
+    switch (*data_at(n)) {
+    case BitmapTypeCode::EMPTY:
+        return 0;
+    case BitmapTypeCode::SINGLE32:
+    case BitmapTypeCode::SINGLE64:
+        return 1;
+    default:
+        return get_element(n).cardinality();
+    }
+}
+
+void ColumnBitmap::union_into(size_t n, BitmapValue* dst) const {
+    const char* src = data_at(n);
+    switch (*src) {
+    case BitmapTypeCode::EMPTY:
+        break;
+    case BitmapTypeCode::SINGLE32:
+        dst->add(decode_fixed32_le(reinterpret_cast<const uint8_t*>(src + 1)));
+        break;
+    case BitmapTypeCode::SINGLE64:
+        dst->add(decode_fixed64_le(reinterpret_cast<const uint8_t*>(src + 1)));
+        break;
+    default:
+        *dst |= BitmapValue(src);
+        break;
+    }
+}
+
+void ColumnBitmap::union_into(const uint32_t* rows, size_t num_rows, BitmapValue* dst,
+                              UnionBuffers* buffers) const {
+    if (num_rows == 1) {
+        union_into(rows[0], dst);
+        return;
+    }
+    auto& single_values = buffers->single_values;
+    auto& bitmaps = buffers->bitmaps;
+    single_values.clear();
+    bitmaps.clear();
+    for (size_t i = 0; i < num_rows; ++i) {
+        const char* src = data_at(rows[i]);
+        switch (*src) {
+        case BitmapTypeCode::EMPTY:
+            break;
+        case BitmapTypeCode::SINGLE32:
+            single_values.push_back(decode_fixed32_le(reinterpret_cast<const uint8_t*>(src + 1)));
+            break;
+        case BitmapTypeCode::SINGLE64:
+            single_values.push_back(decode_fixed64_le(reinterpret_cast<const uint8_t*>(src + 1)));
+            break;
+        default:
+            bitmaps.emplace_back(src);
+            break;
+        }
+    }
+    if (!bitmaps.empty()) {
+        auto& inputs = buffers->inputs;
+        inputs.resize(bitmaps.size());
+        for (size_t i = 0; i < bitmaps.size(); ++i) {
+            inputs[i] = &bitmaps[i];
+        }
+        dst->fastunion(inputs);
+    }
+    std::sort(single_values.begin(), single_values.end());
+    dst->add_many(single_values.data(), single_values.size());
+}
+
+void ColumnBitmap::insert_value(const BitmapValue& value) {
+    // getSizeInBytes() optimizes the containers before they are written, it doesn't change
+    // the elements
+    auto& bitmap = const_cast<BitmapValue&>(value);
+    const size_t old_size = chars.size();
+    chars.resize(old_size + bitmap.getSizeInBytes());
+    bitmap.write(reinterpret_cast<char*>(chars.data() + old_size));
+    offsets.push_back(chars.size());
+}
+
+void ColumnBitmap::insert_many_defaults(size_t length) {
+    const size_t old_size = chars.size();
+    chars.resize_fill(old_size + length, BitmapTypeCode::EMPTY);
+    offsets.reserve(offsets.size() + length);
+    for (size_t i = 1; i <= length; ++i) {
+        offsets.push_back(old_size + i);
+    }
+}
+
+void ColumnBitmap::resize(size_t n) {
+    if (n <= size()) {
+        pop_back(size() - n);
+    } else {
+        insert_many_defaults(n - size());
+    }
+}
+
+MutableColumnPtr ColumnBitmap::clone_resized(size_t to_size) const {
+    auto res = ColumnBitmap::create();
+    res->insert_range_from(*this, 0, std::min(to_size, size()));
+    if (to_size > size()) {
+        res->insert_many_defaults(to_size - size());
+    }
+    return res;
+}
+
+void ColumnBitmap::insert_range_from(const IColumn& src, size_t start, size_t length) {
+    if (length == 0) return;
+
+    const auto& src_concrete = assert_cast<const ColumnBitmap&>(src);
+    if (start + length > src_concrete.offsets.size()) {
+        LOG(FATAL) << "Parameter out of bound in ColumnBitmap::insert_range_from method.";
+    }
+
+    size_t nested_offset = src_concrete.offset_at(start);
+    size_t nested_length = src_concrete.offsets[start + length - 1] - nested_offset;
+
+    size_t old_chars_size = chars.size();
+    chars.resize(old_chars_size + nested_length);
+    memcpy(&chars[old_chars_size], &src_concrete.chars[nested_offset], nested_length);
+
+    size_t old_size = offsets.size();
+    size_t prev_max_offset = offsets.back(); /// -1th index is Ok, see PaddedPODArray
+    offsets.resize(old_size + length);
+    for (size_t i = 0; i < length; ++i) {
+        offsets[old_size + i] = src_concrete.offsets[start + i] - nested_offset + prev_max_offset;
+    }
+}
+
+ColumnPtr ColumnBitmap::filter(const Filter& filt, ssize_t result_size_hint) const {
+    if (offsets.size() == 0) return ColumnBitmap::create();
+
+    auto res = ColumnBitmap::create();
+    filter_arrays_impl<UInt8>(chars, offsets, res->chars, res->offsets, filt, result_size_hint);
+    return res;
+}
+
+ColumnPtr ColumnBitmap::permute(const Permutation& perm, size_t limit) const {
+    size_t size = offsets.size();
+
+    if (limit == 0)
+        limit = size;
+    else
+        limit = std::min(size, limit);
+
+    if (perm.size() < limit) {
+        LOG(FATAL) << "Size of permutation is less than required.";
+    }
+
+    auto res = ColumnBitmap::create();
+    if (limit == 0) return res;
+
+    size_t new_chars_size = 0;
+    for (size_t i = 0; i < limit; ++i) new_chars_size += size_at(perm[i]);
+    res->chars.resize(new_chars_size);
+    res->offsets.resize(limit);
+
+    Offset current_new_offset = 0;
+    for (size_t i = 0; i < limit; ++i) {
+        size_t j = perm[i];
+        size_t value_size = size_at(j);
+        memcpy_small_allow_read_write_overflow15(&res->chars[current_new_offset],
+                                                 &chars[offset_at(j)], value_size);
+        current_new_offset += value_size;
+        res->offsets[i] = current_new_offset;
+    }
+    return res;
+}
+
+ColumnPtr ColumnBitmap::replicate(const Offsets& replicate_offsets) const {
+    size_t col_size = size();
+    if (col_size != replicate_offsets.size()) {
+        LOG(FATAL) << "Size of offsets doesn't match size of column.";
+    }
+
+    auto res = ColumnBitmap::create();
+    if (0 == col_size) return res;
+
+    Chars& res_chars = res->chars;
+    Offsets& res_offsets = res->offsets;
+    res_offsets.reserve(replicate_offsets.back());
+
+    Offset prev_replicate_offset = 0;
+    for (size_t i = 0; i < col_size; ++i) {
+        size_t size_to_replicate = replicate_offsets[i] - prev_replicate_offset;
+        size_t value_size = size_at(i);
+        for (size_t j = 0; j < size_to_replicate; ++j) {
+            res_chars.resize(res_chars.size() + value_size);
+            memcpy_small_allow_read_write_overflow15(&res_chars[res_chars.size() - value_size],
+                                                     &chars[offset_at(i)], value_size);
+            res_offsets.push_back(res_chars.size());
+        }
+        prev_replicate_offset = replicate_offsets[i];
+    }
+    return res;
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,228 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <vector>
+
+#include "util/bitmap_value.h"
+#include "vec/columns/column.h"
+#include "vec/columns/column_impl.h"
+#include "vec/common/assert_cast.h"
+#include "vec/common/pod_array.h"
+#include "vec/common/sip_hash.h"
+#include "vec/core/types.h"
+
+namespace doris::vectorized {
+
+/** Column for bitmap values.
+  * The values are kept serialized in the format of BitmapValue::write(), placed contiguously
+  * like the strings of ColumnString, so an empty or single value bitmap takes a few bytes
+  * inline instead of a heap object. Filter, permute and replicate copy bytes.
+  * A value is materialized into a BitmapValue only by get_element(), the cardinality and
+  * the union of the empty and single value bitmaps are computed without it.
+  */
+class ColumnBitmap final : public COWHelper<IColumn, ColumnBitmap> {
+public:
+    using Chars = PaddedPODArray<UInt8>;
+    using value_type = BitmapValue;
+
+private:
+    friend class COWHelper<IColumn, ColumnBitmap>;
+
+    /// Maps i'th position to offset to i+1'th element.
+    Offsets offsets;
+    /// The serialized bitmaps, placed contiguously.
+    Chars chars;
+
+    size_t ALWAYS_INLINE offset_at(ssize_t i) const { return offsets[i - 1]; }
+    size_t ALWAYS_INLINE size_at(ssize_t i) const { return offsets[i] - offsets[i - 1]; }
+    const char* ALWAYS_INLINE data_at(size_t n) const {
+        return reinterpret_cast<const char*>(&chars[offset_at(n)]);
+    }
+
+    ColumnBitmap() = default;
+
+    ColumnBitmap(const ColumnBitmap& src)
+            : offsets(src.offsets.begin(), src.offsets.end()),
+              chars(src.chars.begin(), src.chars.end()) {}
+
+public:
+    const char* get_family_name() const override { return TypeName<BitmapValue>::get(); }
+
+    size_t size() const override { return offsets.size(); }
+
+    size_t byte_size() const override { return chars.size() + offsets.size() * sizeof(offsets[0]); }
+
+    size_t allocated_bytes() const override {
+        return chars.allocated_bytes() + offsets.allocated_bytes();
+    }
+
+    void protect() override {
+        chars.protect();
+        offsets.protect();
+    }
+
+    MutableColumnPtr clone_resized(size_t to_size) const override;
+
+    /// The serialized bitmap.
+    StringRef get_data_at(size_t n) const override { return StringRef(data_at(n), size_at(n)); }
+
+    Chars& get_chars() { return chars; }
+    const Chars& get_chars() const { return chars; }
+
+    Offsets& get_offsets() { return offsets; }
+    const Offsets& get_offsets() const { return offsets; }
+
+    /// Materializes the n'th bitmap.
+    BitmapValue get_element(size_t n) const { return BitmapValue(data_at(n)); }
+
+    /// The cardinality of the n'th bitmap.
+    uint64_t cardinality(size_t n) const;
+
+    /// Adds the elements of the n'th bitmap to 'dst'.
+    void union_into(size_t n, BitmapValue* dst) const;
+
+    /// The buffers of union_into() of several rows, reused by the calls on the groups of a batch.
+    struct UnionBuffers {
+        std::vector<uint64_t> single_values;
+        std::vector<BitmapValue> bitmaps;
+        std::vector<const BitmapValue*> inputs;
+    };
+
+    /// Adds the elements of the bitmaps of the rows to 'dst' at once, see BitmapValue::fastunion().
+    void union_into(const uint32_t* rows, size_t num_rows, BitmapValue* dst,
+                    UnionBuffers* buffers) const;
+
+    /// Inserts a serialized bitmap.
+    void insert_data(const char* pos, size_t length) override {
+        const size_t old_size = chars.size();
+        chars.resize(old_size + length);
+        memcpy(chars.data() + old_size, pos, length);
+        offsets.push_back(old_size + length);
+    }
+
+    void insert_value(const BitmapValue& value);
+
+    void insert_from(const IColumn& src, size_t n) override {
+        const auto& src_column = assert_cast<const ColumnBitmap&>(src);
+        insert_data(src_column.data_at(n), src_column.size_at(n));
+    }
+
+    void insert_range_from(const IColumn& src, size_t start, size_t length) override;
+
+    void insert_default() override {
+        chars.push_back(BitmapTypeCode::EMPTY);
+        offsets.push_back(chars.size());
+    }
+
+    void insert_many_defaults(size_t length) override;
+
+    void pop_back(size_t n) override {
+        chars.resize_assume_reserved(offset_at(offsets.size() - n));
+        offsets.resize_assume_reserved(offsets.size() - n);
+    }
+
+    void clear() override {
+        chars.clear();
+        offsets.clear();
+    }
+
+    void reserve(size_t n) override { offsets.reserve(n); }
+
+    void resize(size_t n) override;
+
+    ColumnPtr filter(const Filter& filt, ssize_t result_size_hint) const override;
+
+    ColumnPtr permute(const Permutation& perm, size_t limit) const override;
+
+    ColumnPtr replicate(const Offsets& replicate_offsets) const override;
+
+    MutableColumns scatter(ColumnIndex num_columns, const Selector& selector) const override {
+        return scatter_impl<ColumnBitmap>(num_columns, selector);
+    }
+
+    void update_hash_with_value(size_t n, SipHash& hash) const override {
+        size_t size = size_at(n);
+        hash.update(reinterpret_cast<const char*>(&size), sizeof(size));
+        hash.update(data_at(n), size);
+    }
+
+    bool can_be_inside_nullable() const override { return true; }
+
+    bool structure_equals(const IColumn& rhs) const override {
+        return typeid(rhs) == typeid(ColumnBitmap);
+    }
+
+    // Like ColumnString, the rows must be replaced in the order of 0, 1, 2, ...
+    void replace_column_data(const IColumn& rhs, size_t row, size_t self_row = 0) override {
+        DCHECK(size() > self_row);
+        const auto& r = assert_cast<const ColumnBitmap&>(rhs);
+        if (!self_row) {
+            chars.clear();
+        }
+        chars.insert(r.data_at(row), r.data_at(row) + r.size_at(row));
+        offsets[self_row] = chars.size();
+    }
+
+    void replace_column_data_default(size_t self_row = 0) override {
+        DCHECK(size() > self_row);
+        if (!self_row) {
+            chars.clear();
+        }
+        chars.push_back(BitmapTypeCode::EMPTY);
+        offsets[self_row] = chars.size();
+    }
+
+    // A bitmap can't be a key of a hash table or be sorted, so these aren't implemented.
+    [[noreturn]] Field operator[](size_t n) const override {
+        LOG(FATAL) << "operator[] not implemented";
+    }
+
+    [[noreturn]] void get(size_t n, Field& res) const override {
+        LOG(FATAL) << "get field not implemented";
+    }
+
+    [[noreturn]] void insert(const Field& x) override {
+        LOG(FATAL) << "insert field not implemented";
+    }
+
+    [[noreturn]] StringRef serialize_value_into_arena(size_t n, Arena& arena,
+                                                      char const*& begin) const override {
+        LOG(FATAL) << "serialize_value_into_arena not implemented";
+    }
+
+    [[noreturn]] const char* deserialize_and_insert_from_arena(const char* pos) override {
+        LOG(FATAL) << "deserialize_and_insert_from_arena not implemented";
+    }
+
+    [[noreturn]] int compare_at(size_t n, size_t m, const IColumn& rhs,
+                                int nan_direction_hint) const override {
+        LOG(FATAL) << "compare_at not implemented";
+    }
+
+    [[noreturn]] void get_permutation(bool reverse, size_t limit, int nan_direction_hint,
+                                      Permutation& res) const override {
+        LOG(FATAL) << "get_permutation not implemented";
+    }
+
+    [[noreturn]] void get_extremes(Field& min, Field& max) const override {
+        LOG(FATAL) << "get_extremes not implemented";
+    }
+};
+
+} // namespace doris::vectorized
@@ -283,5 +283,4 @@ ColumnPtr ColumnComplexType<T>::replicate(const IColumn::Offsets& offsets) const
     return res;
 }
 
-using ColumnBitmap = ColumnComplexType<BitmapValue>;
 } // namespace doris::vectorized
\ No newline at end of file
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "vec/columns/column_string.h"
 #include "vec/common/arena.h"
@@ -132,6 +133,29 @@ protected:
         return SerializedKeyHolder {
                 serialize_keys_to_pool_contiguous(row, keys_size, key_columns, pool), pool};
     }
+
+    /// The keys of a batch are serialized once to a temporary arena, and copied to the pool
+    /// of the hash table only when they are inserted.
+    void init_batch_keys(size_t begin, size_t end) {
+        batch_pool = std::make_unique<Arena>();
+        batch_begin = begin;
+        batch_keys.resize(end - begin);
+        for (size_t row = begin; row < end; ++row) {
+            batch_keys[row - begin] =
+                    serialize_keys_to_pool_contiguous(row, keys_size, key_columns, *batch_pool);
+        }
+    }
+
+    ALWAYS_INLINE ArenaKeyHolder get_batch_key_holder(size_t row, Arena& pool) const {
+        DCHECK_GE(row, batch_begin);
+        DCHECK_LT(row - batch_begin, batch_keys.size());
+        return ArenaKeyHolder {batch_keys[row - batch_begin], pool};
+    }
+
+private:
+    std::unique_ptr<Arena> batch_pool;
+    size_t batch_begin = 0;
+    std::vector<StringRef> batch_keys;
 };
 
 /// For the case when there is one string key.
@@ -236,6 +260,50 @@ struct HashMethodSingleLowNullableColumn : public SingleColumnMethod {
         else
             return EmplaceResult(inserted);
     }
+
+    template <typename Data>
+    ALWAYS_INLINE FindResult find_key(Data & data, size_t row, Arena & pool) {
+        if (key_columns[0]->is_null_at(row)) {
+            bool has_null_key = data.has_null_key_data();
+            if constexpr (has_mapped)
+                return FindResult(&data.get_null_key_data(), has_null_key);
+            else
+                return FindResult(has_null_key);
+        }
+
+        auto key_holder = Base::get_key_holder(row, pool);
+        auto it = data.find(key_holder_get_key(key_holder));
+
+        if constexpr (has_mapped)
+            return FindResult(it ? lookup_result_get_mapped(it) : nullptr, it != nullptr);
+        else
+            return FindResult(it != nullptr);
+    }
+
+    /// The hash values of the null rows are computed on the default values of the nested
+    /// column by get_hashes(), they are not used.
+    template <typename Data>
+    ALWAYS_INLINE EmplaceResult emplace_key(Data & data, size_t hash_value, size_t row, Arena & pool) {
+        if (key_columns[0]->is_null_at(row)) {
+            return emplace_key(data, row, pool);
+        }
+
+        auto key_holder = Base::get_key_holder(row, pool);
+
+        bool inserted = false;
+        typename Data::LookupResult it;
+        data.emplace(key_holder, it, inserted, hash_value);
+
+        if constexpr (has_mapped) {
+            auto & mapped = *lookup_result_get_mapped(it);
+            if (inserted) {
+                new (&mapped) Mapped();
+            }
+            return EmplaceResult(mapped, mapped, inserted);
+        }
+        else
+            return EmplaceResult(inserted);
+    }
 };
 
 } // namespace ColumnsHashing
@@ -150,9 +150,44 @@ public:
         data.prefetch(key_holder);
     }
 
+    /// Batched interface. get_hashes() computes the hash values of the rows [begin, end) at once,
+    /// hash_values[row - begin] is the hash value of the row. Then the rows are emplaced or found
+    /// with their hash values below, while the buckets of the following rows are prefetched with
+    /// Data::prefetch_by_hash().
+    template <typename Data>
+    void get_hashes(const Data& data, size_t begin, size_t end, Arena& pool,
+                    size_t* hash_values) {
+        auto& derived = static_cast<Derived&>(*this);
+        derived.init_batch_keys(begin, end);
+        for (size_t row = begin; row < end; ++row) {
+            auto key_holder = derived.get_batch_key_holder(row, pool);
+            hash_values[row - begin] = data.hash(key_holder_get_key(key_holder));
+        }
+    }
+
+    template <typename Data>
+    ALWAYS_INLINE EmplaceResult emplace_key(Data& data, size_t hash_value, size_t row,
+                                            Arena& pool) {
+        auto key_holder = static_cast<Derived&>(*this).get_batch_key_holder(row, pool);
+        return emplaceImpl(key_holder, data, hash_value);
+    }
+
+    template <typename Data>
+    ALWAYS_INLINE FindResult find_key(Data& data, size_t hash_value, size_t row, Arena& pool) {
+        auto key_holder = static_cast<Derived&>(*this).get_batch_key_holder(row, pool);
+        return find_key_impl(key_holder_get_key(key_holder), data, hash_value);
+    }
+
 protected:
     Cache cache;
 
+    /// The methods whose key holders are expensive to build prepare the keys of a batch once.
+    void init_batch_keys(size_t /*begin*/, size_t /*end*/) {}
+
+    ALWAYS_INLINE auto get_batch_key_holder(size_t row, Arena& pool) {
+        return static_cast<Derived&>(*this).get_key_holder(row, pool);
+    }
+
     HashMethodBase() {
         if constexpr (consecutive_keys_optimization) {
             if constexpr (has_mapped) {
@@ -164,8 +199,10 @@ protected:
         }
     }
 
-    template <typename Data, typename KeyHolder>
-    ALWAYS_INLINE EmplaceResult emplaceImpl(KeyHolder& key_holder, Data& data) {
+    /// hash_value is empty, or the hash value of the key computed in advance.
+    template <typename Data, typename KeyHolder, typename... HashValue>
+    ALWAYS_INLINE EmplaceResult emplaceImpl(KeyHolder& key_holder, Data& data,
+                                            HashValue... hash_value) {
         if constexpr (Cache::consecutive_keys_optimization) {
             if (cache.found && cache.check(key_holder_get_key(key_holder))) {
                 if constexpr (has_mapped)
@@ -177,7 +214,7 @@ protected:
 
         typename Data::LookupResult it;
         bool inserted = false;
-        data.emplace(key_holder, it, inserted);
+        data.emplace(key_holder, it, inserted, hash_value...);
 
         [[maybe_unused]] Mapped* cached = nullptr;
         if constexpr (has_mapped) cached = lookup_result_get_mapped(it);
@@ -207,8 +244,8 @@ protected:
             return EmplaceResult(inserted);
     }
 
-    template <typename Data, typename Key>
-    ALWAYS_INLINE FindResult find_key_impl(Key key, Data& data) {
+    template <typename Data, typename Key, typename... HashValue>
+    ALWAYS_INLINE FindResult find_key_impl(Key key, Data& data, HashValue... hash_value) {
         if constexpr (Cache::consecutive_keys_optimization) {
             if (cache.check(key)) {
                 if constexpr (has_mapped)
@@ -218,7 +255,7 @@ protected:
             }
         }
 
-        auto it = data.find(key);
+        auto it = data.find(key, hash_value...);
 
         if constexpr (consecutive_keys_optimization) {
             cache.found = it != nullptr;
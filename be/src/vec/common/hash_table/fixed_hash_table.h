@@ -296,6 +296,10 @@ public:
         return res;
     }
 
+    /// The table is small and directly indexed by the key, nothing to prefetch.
+    template <bool READ>
+    void ALWAYS_INLINE prefetch_by_hash(size_t /* hash_value */) const {}
+
     LookupResult ALWAYS_INLINE find(const Key & x) { return !buf[x].is_zero(*this) ? &buf[x] : nullptr; }
 
     ConstLookupResult ALWAYS_INLINE find(const Key & x) const { return const_cast<std::decay_t<decltype(*this)> *>(this)->find(x); }
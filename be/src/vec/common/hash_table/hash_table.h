@@ -46,6 +46,11 @@
   * Also, key in hash table must be of type, that zero bytes is compared equals to zero key.
   */
 
+/** How many rows ahead the batched probes prefetch the bucket of, see HashTable::prefetch_by_hash().
+  * Far enough to hide a memory access behind the work of the rows in between.
+  */
+static constexpr size_t HASH_MAP_PREFETCH_DIST = 16;
+
 /** The state of the hash table that affects the properties of its cells.
   * Used as a template parameter.
   * For example, there is an implementation of an instantly clearable hash table - ClearableHashMap.
@@ -742,6 +747,14 @@ public:
         __builtin_prefetch(&buf[place_value]);
     }
 
+    /// Prefetches the bucket of a hash value computed in advance, for the batched probes which
+    /// hash a whole block first and prefetch HASH_MAP_PREFETCH_DIST rows ahead of the row being
+    /// emplaced or found. READ is false if the bucket is going to be written by emplace().
+    template <bool READ>
+    void ALWAYS_INLINE prefetch_by_hash(size_t hash_value) const {
+        __builtin_prefetch(&buf[grower.place(hash_value)], READ ? 0 : 1, 1);
+    }
+
     /// Reinsert node pointed to by iterator
     void ALWAYS_INLINE reinsert(iterator& it, size_t hash_value) {
         reinsert(*it.get_ptr(), hash_value);
@@ -0,0 +1,110 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <cstring>
+#include <string>
+
+#include "vec/core/types.h"
+
+namespace doris::vectorized {
+
+/** Case sensitive search of a constant needle, in one long haystack or in many short ones.
+  * The SIMD version compares the first and the last byte of the needle at 16 positions at
+  * once, and only compares the whole needle at the positions where both bytes match.
+  * (The "generic SIMD" algorithm in http://0x80.pl/articles/simd-strfind.html)
+  */
+class StringSearcher {
+public:
+    StringSearcher() = default;
+
+    explicit StringSearcher(std::string needle) : _needle(std::move(needle)) {
+#ifdef __SSE2__
+        if (_needle.size() > 1) {
+            _first = _mm_set1_epi8(_needle.front());
+            _last = _mm_set1_epi8(_needle.back());
+        }
+#endif
+    }
+
+    const std::string& needle() const { return _needle; }
+    size_t needle_size() const { return _needle.size(); }
+
+    /// Returns the position of the first occurrence in [haystack, haystack_end),
+    /// or haystack_end if not found.
+    const UInt8* search(const UInt8* haystack, const UInt8* haystack_end) const {
+        const size_t n = _needle.size();
+        if (n == 0) {
+            return haystack;
+        }
+        if (haystack_end - haystack < static_cast<ptrdiff_t>(n)) {
+            return haystack_end;
+        }
+        const auto* needle = reinterpret_cast<const UInt8*>(_needle.data());
+        if (n == 1) {
+            const void* pos = memchr(haystack, needle[0], haystack_end - haystack);
+            return pos == nullptr ? haystack_end : static_cast<const UInt8*>(pos);
+        }
+
+        /// The last position where the needle can start.
+        const UInt8* last_start = haystack_end - n;
+        const UInt8* pos = haystack;
+#ifdef __SSE2__
+        while (pos + 15 <= last_start) {
+            const __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+            const __m128i block_last =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos + n - 1));
+            int mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(_first, block_first),
+                                                       _mm_cmpeq_epi8(_last, block_last)));
+            while (mask != 0) {
+                int offset = __builtin_ctz(mask);
+                if (memcmp(pos + offset + 1, needle + 1, n - 2) == 0) {
+                    return pos + offset;
+                }
+                mask &= mask - 1;
+            }
+            pos += 16;
+        }
+#endif
+        for (; pos <= last_start; ++pos) {
+            if (pos[0] == needle[0] && pos[n - 1] == needle[n - 1] &&
+                memcmp(pos + 1, needle + 1, n - 2) == 0) {
+                return pos;
+            }
+        }
+        return haystack_end;
+    }
+
+    const char* search(const char* haystack, const char* haystack_end) const {
+        return reinterpret_cast<const char*>(search(reinterpret_cast<const UInt8*>(haystack),
+                                                    reinterpret_cast<const UInt8*>(haystack_end)));
+    }
+
+private:
+    std::string _needle;
+#ifdef __SSE2__
+    __m128i _first;
+    __m128i _last;
+#endif
+};
+
+} // namespace doris::vectorized
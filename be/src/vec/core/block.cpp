@@ -632,7 +632,12 @@ void Block::clear_column_data(int column_size) noexcept {
         }
     }
     for (auto& d : data) {
-        (*std::move(d.column)).mutate()->clear();
+        if (d.column->use_count() > 1) {
+            // shared with another block, e.g. the blocks of VRepeatNode, mutate() would copy it
+            d.column = d.column->clone_empty();
+        } else {
+            (*std::move(d.column)).mutate()->clear();
+        }
     }
 }
 
@@ -786,14 +791,11 @@ doris::Tuple* Block::deep_copy_tuple(const doris::TupleDescriptor& desc, MemPool
                 dst->get_string_slot(slot_desc->tuple_offset())->ptr = reinterpret_cast<char *>(str_ptr);
             }
         } else if (slot_desc->type() == TYPE_OBJECT) {
-            auto bitmap_value = (BitmapValue*)(data_ref.data);
-            auto size = bitmap_value->getSizeInBytes();
-
-            // serialize the content of string
+            // the bitmap column keeps the serialized bitmaps
             auto string_slot = dst->get_string_slot(slot_desc->tuple_offset());
-            string_slot->ptr = reinterpret_cast<char*>(pool->allocate(size));
-            bitmap_value->write(string_slot->ptr);
-            string_slot->len = size;
+            string_slot->ptr = reinterpret_cast<char*>(pool->allocate(data_ref.size));
+            memcpy(string_slot->ptr, data_ref.data, data_ref.size);
+            string_slot->len = data_ref.size;
         } else {
             VecDateTimeValue ts = *reinterpret_cast<const doris::vectorized::VecDateTimeValue*>(data_ref.data);
             DateTimeValue dt;
@@ -17,7 +17,7 @@
 
 #include "vec/data_types/data_type_bitmap.h"
 
-#include "vec/columns/column_complex.h"
+#include "vec/columns/column_bitmap.h"
 #include "vec/common/assert_cast.h"
 #include "vec/io/io_helper.h"
 
@@ -34,8 +34,7 @@ size_t DataTypeBitMap::serialize(const IColumn& column, PColumn* pcolumn) const
 
     // compute each bitmap size and save
     for (size_t i = 0; i < column.size(); ++i) {
-        auto& bitmap = const_cast<BitmapValue&>(data_column.get_element(i));
-        bitmap_size_array[i + 1] = bitmap.getSizeInBytes();
+        bitmap_size_array[i + 1] = data_column.get_data_at(i).size;
         allocate_content_size += bitmap_size_array[i + 1];
     }
     // serialize the bitmap size array
@@ -43,19 +42,14 @@ size_t DataTypeBitMap::serialize(const IColumn& column, PColumn* pcolumn) const
     auto* data = pcolumn->mutable_binary()->data();
     memcpy(data, bitmap_size_array, allocate_len_size);
     data += allocate_len_size;
-    // serialize each bitmap
-    for (size_t i = 0; i < column.size(); ++i) {
-        auto& bitmap = const_cast<BitmapValue&>(data_column.get_element(i));
-        bitmap.write(data);
-        data += bitmap_size_array[i + 1];
-    }
+    // the serialized bitmaps are contiguous in the column
+    memcpy(data, data_column.get_chars().data(), allocate_content_size);
 
     return compress_binary(pcolumn);
 }
 
 void DataTypeBitMap::deserialize(const PColumn& pcolumn, IColumn* column) const {
     auto& data_column = assert_cast<ColumnBitmap&>(*column);
-    auto& data = data_column.get_data();
 
     std::string uncompressed;
     read_binary(pcolumn, &uncompressed);
@@ -65,11 +59,15 @@ void DataTypeBitMap::deserialize(const PColumn& pcolumn, IColumn* column) const
     memcpy(bitmap_size_array, uncompressed.data() + sizeof(size_t), sizeof(size_t) * bitmap_size_array_size);
     auto bitmap_content_ptr = uncompressed.data() + sizeof(size_t) * (bitmap_size_array_size + 1);
 
-    data.resize(bitmap_size_array_size);
+    auto& chars = data_column.get_chars();
+    auto& offsets = data_column.get_offsets();
+    offsets.reserve(offsets.size() + bitmap_size_array_size);
+    size_t content_size = 0;
     for (int i = 0; i < bitmap_size_array_size; ++i) {
-        data[i].deserialize(bitmap_content_ptr);
-        bitmap_content_ptr += bitmap_size_array[i];
+        content_size += bitmap_size_array[i];
+        offsets.push_back(chars.size() + content_size);
     }
+    chars.insert(bitmap_content_ptr, bitmap_content_ptr + content_size);
 }
 
 MutableColumnPtr DataTypeBitMap::create_column() const {
@@ -0,0 +1,215 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/join/inequality_join.h"
+
+#include <algorithm>
+
+#include "common/logging.h"
+#include "vec/columns/column_nullable.h"
+
+namespace doris::vectorized {
+
+InequalityJoin::Op InequalityJoin::reverse(Op op) {
+    switch (op) {
+    case Op::LESS:
+        return Op::GREATER;
+    case Op::LESS_EQUAL:
+        return Op::GREATER_EQUAL;
+    case Op::GREATER:
+        return Op::LESS;
+    case Op::GREATER_EQUAL:
+        return Op::LESS_EQUAL;
+    }
+    __builtin_unreachable();
+}
+
+InequalityJoin::InequalityJoin(std::vector<Op> ops) : _ops(std::move(ops)) {
+    DCHECK(_ops.size() == 1 || _ops.size() == 2);
+}
+
+void InequalityJoin::_extract(Columns keys, Keys* dst) {
+    dst->columns.clear();
+    dst->holders.clear();
+    dst->valid_rows.clear();
+    size_t rows = keys.empty() ? 0 : keys[0]->size();
+    std::vector<uint8_t> is_null(rows, 0);
+    for (auto& key : keys) {
+        ColumnPtr column = key->convert_to_full_column_if_const();
+        if (const auto* nullable = check_and_get_column<ColumnNullable>(*column)) {
+            const auto& null_map = nullable->get_null_map_data();
+            for (size_t i = 0; i < rows; ++i) {
+                is_null[i] |= null_map[i];
+            }
+            dst->columns.push_back(&nullable->get_nested_column());
+        } else {
+            dst->columns.push_back(column.get());
+        }
+        dst->holders.push_back(std::move(column));
+    }
+    dst->valid_rows.reserve(rows);
+    for (uint32_t i = 0; i < rows; ++i) {
+        if (!is_null[i]) {
+            dst->valid_rows.push_back(i);
+        }
+    }
+}
+
+void InequalityJoin::build(Columns keys) {
+    DCHECK_EQ(keys.size(), _ops.size());
+    _extract(std::move(keys), &_build);
+
+    auto sort_on = [&](size_t i, std::vector<uint32_t>* order) {
+        const IColumn& column = *_build.columns[i];
+        *order = _build.valid_rows;
+        std::sort(order->begin(), order->end(), [&](uint32_t lhs, uint32_t rhs) {
+            return column.compare_at(lhs, rhs, column, 1) < 0;
+        });
+    };
+    sort_on(0, &_first_order);
+    if (_ops.size() == 2) {
+        sort_on(1, &_second_order);
+        _first_position.resize(_build.holders[0]->size());
+        for (uint32_t pos = 0; pos < _first_order.size(); ++pos) {
+            _first_position[_first_order[pos]] = pos;
+        }
+        _bitmap.resize((_first_order.size() + 63) / 64);
+    }
+}
+
+void InequalityJoin::probe(Columns keys) {
+    DCHECK_EQ(keys.size(), _ops.size());
+    _extract(std::move(keys), &_probe);
+    _probe_order = _probe.valid_rows;
+    _cursor = 0;
+    _in_probe_row = false;
+
+    if (_ops.size() == 2) {
+        // Visit the probe rows in the order in which the build rows satisfying the second
+        // condition only grow: ascending for "probe > build", descending for "probe < build".
+        const IColumn& column = *_probe.columns[1];
+        bool ascending = _ops[1] == Op::GREATER || _ops[1] == Op::GREATER_EQUAL;
+        std::sort(_probe_order.begin(), _probe_order.end(), [&](uint32_t lhs, uint32_t rhs) {
+            int res = column.compare_at(lhs, rhs, column, 1);
+            return ascending ? res < 0 : res > 0;
+        });
+        std::fill(_bitmap.begin(), _bitmap.end(), 0);
+        _num_marked = 0;
+    }
+}
+
+size_t InequalityJoin::_bound(uint32_t probe_row, bool upper) const {
+    size_t begin = 0;
+    size_t end = _first_order.size();
+    while (begin < end) {
+        size_t mid = begin + (end - begin) / 2;
+        int res = _compare(0, probe_row, _first_order[mid]);
+        // the build key is less than (or equal to) the probe key
+        if (upper ? res >= 0 : res > 0) {
+            begin = mid + 1;
+        } else {
+            end = mid;
+        }
+    }
+    return begin;
+}
+
+void InequalityJoin::_mark_build_rows(uint32_t probe_row) {
+    const Op op = _ops[1];
+    const bool ascending = op == Op::GREATER || op == Op::GREATER_EQUAL;
+    const size_t num_rows = _second_order.size();
+    for (; _num_marked < num_rows; ++_num_marked) {
+        uint32_t build_row = ascending ? _second_order[_num_marked]
+                                       : _second_order[num_rows - 1 - _num_marked];
+        int res = _compare(1, probe_row, build_row);
+        bool satisfied = (op == Op::LESS && res < 0) || (op == Op::LESS_EQUAL && res <= 0) ||
+                         (op == Op::GREATER && res > 0) ||
+                         (op == Op::GREATER_EQUAL && res >= 0);
+        if (!satisfied) {
+            break;
+        }
+        uint32_t pos = _first_position[build_row];
+        _bitmap[pos >> 6] |= 1ULL << (pos & 63);
+    }
+}
+
+size_t InequalityJoin::next_pairs(size_t max_pairs, std::vector<uint32_t>* probe_rows,
+                                  std::vector<uint32_t>* build_rows) {
+    size_t num_pairs = 0;
+    while (_cursor < _probe_order.size() && num_pairs < max_pairs) {
+        uint32_t probe_row = _probe_order[_cursor];
+        if (!_in_probe_row) {
+            if (_ops.size() == 2) {
+                _mark_build_rows(probe_row);
+            }
+            switch (_ops[0]) {
+            case Op::LESS:
+                _scan_pos = _bound(probe_row, true);
+                _scan_end = _first_order.size();
+                break;
+            case Op::LESS_EQUAL:
+                _scan_pos = _bound(probe_row, false);
+                _scan_end = _first_order.size();
+                break;
+            case Op::GREATER:
+                _scan_pos = 0;
+                _scan_end = _bound(probe_row, false);
+                break;
+            case Op::GREATER_EQUAL:
+                _scan_pos = 0;
+                _scan_end = _bound(probe_row, true);
+                break;
+            }
+            _in_probe_row = true;
+        }
+
+        if (_ops.size() == 1) {
+            size_t num = std::min(_scan_end - _scan_pos, max_pairs - num_pairs);
+            probe_rows->insert(probe_rows->end(), num, probe_row);
+            build_rows->insert(build_rows->end(), _first_order.begin() + _scan_pos,
+                               _first_order.begin() + _scan_pos + num);
+            _scan_pos += num;
+            num_pairs += num;
+        } else {
+            // the marked build rows in the range satisfy both conditions
+            while (_scan_pos < _scan_end && num_pairs < max_pairs) {
+                uint64_t word = _bitmap[_scan_pos >> 6] & (~0ULL << (_scan_pos & 63));
+                if (word == 0) {
+                    _scan_pos = (_scan_pos | 63) + 1;
+                    continue;
+                }
+                size_t pos = (_scan_pos & ~size_t(63)) + __builtin_ctzll(word);
+                if (pos >= _scan_end) {
+                    _scan_pos = _scan_end;
+                    break;
+                }
+                probe_rows->push_back(probe_row);
+                build_rows->push_back(_first_order[pos]);
+                ++num_pairs;
+                _scan_pos = pos + 1;
+            }
+        }
+
+        if (_scan_pos >= _scan_end) {
+            _in_probe_row = false;
+            ++_cursor;
+        }
+    }
+    return num_pairs;
+}
+
+} // namespace doris::vectorized
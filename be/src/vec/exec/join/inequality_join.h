@@ -0,0 +1,100 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "vec/columns/column.h"
+
+namespace doris::vectorized {
+
+// Finds the pairs of probe rows and build rows satisfying one or two inequality conditions
+// "probe_key op build_key", without enumerating the Cartesian product.
+//
+// The build rows are sorted on the first key. With one condition the build rows matching
+// a probe row are a range of that order. With two conditions (e.g. a band join, where
+// "a.ts BETWEEN b.start AND b.end" is "a.ts >= b.start AND a.ts <= b.end") this is the
+// IEJoin algorithm: the probe rows are visited in the order of their second key, the build
+// rows satisfying the second condition for the current probe row are marked in a bitmap
+// indexed by the first order, and the set bits in the range of the first condition are
+// the matches.
+//
+// Rows having a null key match nothing. The keys of both sides must be of the same type.
+class InequalityJoin {
+public:
+    enum class Op { LESS, LESS_EQUAL, GREATER, GREATER_EQUAL };
+
+    // The op of "rhs op lhs", if "lhs op rhs" is the given op.
+    static Op reverse(Op op);
+
+    // 'ops' has one or two conditions.
+    explicit InequalityJoin(std::vector<Op> ops);
+
+    // 'keys' holds a key column for each condition, with a value for each build row.
+    void build(Columns keys);
+
+    // Starts to probe the rows of a new probe block, 'keys' as in build().
+    void probe(Columns keys);
+    bool probe_finished() const { return _cursor == _probe_order.size(); }
+
+    // Appends at most 'max_pairs' of the next matched pairs, the pairs of a probe row are
+    // adjacent. Returns the number of pairs appended.
+    size_t next_pairs(size_t max_pairs, std::vector<uint32_t>* probe_rows,
+                      std::vector<uint32_t>* build_rows);
+
+private:
+    struct Keys {
+        // the nested columns if nullable
+        ColumnRawPtrs columns;
+        Columns holders;
+        std::vector<uint32_t> valid_rows;
+    };
+    static void _extract(Columns keys, Keys* dst);
+
+    // compare the key 'i' of a probe row and a build row
+    int _compare(size_t i, uint32_t probe_row, uint32_t build_row) const {
+        return _probe.columns[i]->compare_at(probe_row, build_row, *_build.columns[i], 1);
+    }
+    // the first position in the build order of the first key, where the build key is not
+    // less than (or with 'upper', is greater than) the key of the probe row
+    size_t _bound(uint32_t probe_row, bool upper) const;
+    // marks the build rows satisfying the second condition for the probe row
+    void _mark_build_rows(uint32_t probe_row);
+
+    const std::vector<Op> _ops;
+
+    Keys _build;
+    // the build rows sorted on the first and the second key
+    std::vector<uint32_t> _first_order;
+    std::vector<uint32_t> _second_order;
+    // the position of each build row in _first_order
+    std::vector<uint32_t> _first_position;
+    std::vector<uint64_t> _bitmap;
+    size_t _num_marked = 0;
+
+    Keys _probe;
+    std::vector<uint32_t> _probe_order;
+    size_t _cursor = 0;
+    // the range of _first_order being scanned for the current probe row
+    bool _in_probe_row = false;
+    size_t _scan_pos = 0;
+    size_t _scan_end = 0;
+};
+
+} // namespace doris::vectorized
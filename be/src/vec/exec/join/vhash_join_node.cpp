@@ -50,7 +50,7 @@ struct ProcessHashTableBuild {
         Defer defer {[&]() {
             int64_t bucket_size = hash_table_ctx.hash_table.get_buffer_size_in_cells();
             int64_t bucket_bytes = hash_table_ctx.hash_table.get_buffer_size_in_bytes();
-            _join_node->_mem_tracker->Consume(bucket_bytes - old_bucket_bytes);
+            _join_node->_mem_tracker->CacheConsume(bucket_bytes - old_bucket_bytes);
             _join_node->_mem_used += bucket_bytes - old_bucket_bytes;
             COUNTER_SET(_join_node->_build_buckets_counter, bucket_size);
         }};
@@ -65,18 +65,25 @@ struct ProcessHashTableBuild {
             inserted_rows.reserve(_batch_size);
         }
 
+        // Hash all rows first, so the bucket of the row HASH_MAP_PREFETCH_DIST rows ahead can
+        // be prefetched while the current row is emplaced.
+        std::vector<size_t> hash_values(_rows);
+        key_getter.get_hashes(hash_table_ctx.hash_table, 0, _rows, _join_node->_arena,
+                              hash_values.data());
+
         for (size_t k = 0; k < _rows; ++k) {
+            if (LIKELY(k + HASH_MAP_PREFETCH_DIST < _rows)) {
+                hash_table_ctx.hash_table.template prefetch_by_hash<false>(
+                        hash_values[k + HASH_MAP_PREFETCH_DIST]);
+            }
             if constexpr (ignore_null) {
                 if ((*null_map)[k]) {
                     continue;
                 }
             }
 
-            auto emplace_result =
-                    key_getter.emplace_key(hash_table_ctx.hash_table, k, _join_node->_arena);
-            if (k + 1 < _rows) {
-                key_getter.prefetch(hash_table_ctx.hash_table, k + 1, _join_node->_arena);
-            }
+            auto emplace_result = key_getter.emplace_key(hash_table_ctx.hash_table, hash_values[k],
+                                                         k, _join_node->_arena);
 
             if (emplace_result.is_inserted()) {
                 new (&emplace_result.get_mapped()) Mapped({&_acquired_block, k});
@@ -177,6 +184,12 @@ struct ProcessHashTableProbe {
 
         KeyGetter key_getter(_probe_raw_ptrs, _join_node->_probe_key_sz, nullptr);
 
+        // The rows are hashed batch_size rows at a time, a probe may stop early when the output
+        // block is full.
+        std::vector<size_t> hash_values(_batch_size);
+        size_t hashed_begin = 0;
+        size_t hashed_end = 0;
+
         IColumn::Offsets offset_data;
         auto& mcol = mutable_block.mutable_columns();
         offset_data.assign(_probe_rows, (uint32_t)0);
@@ -193,11 +206,23 @@ struct ProcessHashTableProbe {
                     continue;
                 }
             }
+            if (_probe_index >= hashed_end) {
+                hashed_begin = _probe_index;
+                hashed_end = std::min<size_t>(_probe_index + _batch_size, _probe_rows);
+                key_getter.get_hashes(hash_table_ctx.hash_table, hashed_begin, hashed_end, _arena,
+                                      hash_values.data());
+            }
+            if (LIKELY(_probe_index + HASH_MAP_PREFETCH_DIST < hashed_end)) {
+                hash_table_ctx.hash_table.template prefetch_by_hash<true>(
+                        hash_values[_probe_index + HASH_MAP_PREFETCH_DIST - hashed_begin]);
+            }
             auto find_result =
                     (*null_map)[_probe_index]
                             ? decltype(key_getter.find_key(hash_table_ctx.hash_table, _probe_index,
                                                            _arena)) {nullptr, false}
-                            : key_getter.find_key(hash_table_ctx.hash_table, _probe_index, _arena);
+                            : key_getter.find_key(hash_table_ctx.hash_table,
+                                                  hash_values[_probe_index - hashed_begin],
+                                                  _probe_index, _arena);
 
             if (find_result.is_found()) {
                 // left semi join only need one match, do not need insert the data of right table
@@ -281,6 +306,12 @@ struct ProcessHashTableProbe {
 
         KeyGetter key_getter(_probe_raw_ptrs, _join_node->_probe_key_sz, nullptr);
 
+        // The rows are hashed batch_size rows at a time, a probe may stop early when the output
+        // block is full.
+        std::vector<size_t> hash_values(_batch_size);
+        size_t hashed_begin = 0;
+        size_t hashed_end = 0;
+
         IColumn::Offsets offset_data;
         auto& mcol = mutable_block.mutable_columns();
         offset_data.assign(_probe_rows, (uint32_t)0);
@@ -305,11 +336,23 @@ struct ProcessHashTableProbe {
                     continue;
                 }
             }
+            if (_probe_index >= hashed_end) {
+                hashed_begin = _probe_index;
+                hashed_end = std::min<size_t>(_probe_index + _batch_size, _probe_rows);
+                key_getter.get_hashes(hash_table_ctx.hash_table, hashed_begin, hashed_end, _arena,
+                                      hash_values.data());
+            }
+            if (LIKELY(_probe_index + HASH_MAP_PREFETCH_DIST < hashed_end)) {
+                hash_table_ctx.hash_table.template prefetch_by_hash<true>(
+                        hash_values[_probe_index + HASH_MAP_PREFETCH_DIST - hashed_begin]);
+            }
             auto find_result =
                     (*null_map)[_probe_index]
                             ? decltype(key_getter.find_key(hash_table_ctx.hash_table, _probe_index,
                                                            _arena)) {nullptr, false}
-                            : key_getter.find_key(hash_table_ctx.hash_table, _probe_index, _arena);
+                            : key_getter.find_key(hash_table_ctx.hash_table,
+                                                  hash_values[_probe_index - hashed_begin],
+                                                  _probe_index, _arena);
 
             if (find_result.is_found()) {
                 auto& mapped = find_result.get_mapped();
@@ -658,58 +701,73 @@ Status HashJoinNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eo
 
 Status HashJoinNode::get_next(RuntimeState* state, Block* output_block, bool* eos) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
-    SCOPED_TIMER(_probe_timer);
-
-    size_t probe_rows = _probe_block.rows();
-    if ((probe_rows == 0 || _probe_index == probe_rows) && !_probe_eos) {
-        _probe_index = 0;
-        // clear_column_data of _probe_block
-        {
-            if (!_probe_column_disguise_null.empty()) {
-                for (int i = 0; i < _probe_column_disguise_null.size(); ++i) {
-                    auto column_to_erase = _probe_column_disguise_null[i];
-                    _probe_block.erase(column_to_erase - i);
-                }
-                _probe_column_disguise_null.clear();
-            }
-            release_block_memory(_probe_block);
-        }
 
+    if (need_more_input_data()) {
+        Block probe_block;
+        bool probe_eos = false;
         do {
             SCOPED_TIMER(_probe_next_timer);
-            RETURN_IF_ERROR(child(0)->get_next(state, &_probe_block, &_probe_eos));
-        } while (_probe_block.rows() == 0 && !_probe_eos);
+            release_block_memory(probe_block);
+            RETURN_IF_ERROR(child(0)->get_next(state, &probe_block, &probe_eos));
+        } while (probe_block.rows() == 0 && !probe_eos);
+        RETURN_IF_ERROR(push(state, &probe_block, probe_eos));
+    }
 
-        probe_rows = _probe_block.rows();
-        if (probe_rows != 0) {
-            COUNTER_UPDATE(_probe_rows_counter, probe_rows);
+    return pull(state, output_block, eos);
+}
 
-            int probe_expr_ctxs_sz = _probe_expr_ctxs.size();
-            _probe_columns.resize(probe_expr_ctxs_sz);
-            if (_null_map_column == nullptr) {
-                _null_map_column = ColumnUInt8::create();
-            }
-            _null_map_column->get_data().assign(probe_rows, (uint8_t)0);
+bool HashJoinNode::need_more_input_data() const {
+    return (_probe_block.rows() == 0 || _probe_index == _probe_block.rows()) && !_probe_eos;
+}
 
-            Status st = std::visit(
-                    [&](auto&& arg) -> Status {
-                        using HashTableCtxType = std::decay_t<decltype(arg)>;
-                        if constexpr (!std::is_same_v<HashTableCtxType, std::monostate>) {
-                            auto& null_map_val = _null_map_column->get_data();
-                            return extract_probe_join_column(_probe_block, null_map_val,
-                                                             _probe_columns, _probe_ignore_null,
-                                                             *_probe_expr_call_timer);
-                        } else {
-                            LOG(FATAL) << "FATAL: uninited hash table";
-                        }
-                        __builtin_unreachable();
-                    },
-                    _hash_table_variants);
+Status HashJoinNode::push(RuntimeState* state, Block* input_block, bool eos) {
+    SCOPED_TIMER(_probe_timer);
+    _probe_index = 0;
+    _probe_eos = eos;
+    // clear_column_data of _probe_block
+    if (!_probe_column_disguise_null.empty()) {
+        for (int i = 0; i < _probe_column_disguise_null.size(); ++i) {
+            auto column_to_erase = _probe_column_disguise_null[i];
+            _probe_block.erase(column_to_erase - i);
+        }
+        _probe_column_disguise_null.clear();
+    }
+    _probe_block.swap(*input_block);
+
+    size_t probe_rows = _probe_block.rows();
+    if (probe_rows != 0) {
+        COUNTER_UPDATE(_probe_rows_counter, probe_rows);
 
-            RETURN_IF_ERROR(st);
+        int probe_expr_ctxs_sz = _probe_expr_ctxs.size();
+        _probe_columns.resize(probe_expr_ctxs_sz);
+        if (_null_map_column == nullptr) {
+            _null_map_column = ColumnUInt8::create();
         }
+        _null_map_column->get_data().assign(probe_rows, (uint8_t)0);
+
+        Status st = std::visit(
+                [&](auto&& arg) -> Status {
+                    using HashTableCtxType = std::decay_t<decltype(arg)>;
+                    if constexpr (!std::is_same_v<HashTableCtxType, std::monostate>) {
+                        auto& null_map_val = _null_map_column->get_data();
+                        return extract_probe_join_column(_probe_block, null_map_val,
+                                                         _probe_columns, _probe_ignore_null,
+                                                         *_probe_expr_call_timer);
+                    } else {
+                        LOG(FATAL) << "FATAL: uninited hash table";
+                    }
+                    __builtin_unreachable();
+                },
+                _hash_table_variants);
+
+        RETURN_IF_ERROR(st);
     }
+    return Status::OK();
+}
 
+Status HashJoinNode::pull(RuntimeState* state, Block* output_block, bool* eos) {
+    SCOPED_TIMER(_probe_timer);
+    size_t probe_rows = _probe_block.rows();
     Status st;
     output_block->clear();
 
@@ -785,17 +843,21 @@ Status HashJoinNode::get_next(RuntimeState* state, Block* output_block, bool* eo
     return st;
 }
 
-Status HashJoinNode::open(RuntimeState* state) {
-    RETURN_IF_ERROR(ExecNode::open(state));
-    RETURN_IF_ERROR(exec_debug_action(TExecNodePhase::OPEN));
+Status HashJoinNode::alloc_resource(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
-    RETURN_IF_CANCELLED(state);
-
+    RETURN_IF_ERROR(ExecNode::open(state));
     RETURN_IF_ERROR(VExpr::open(_build_expr_ctxs, state));
     RETURN_IF_ERROR(VExpr::open(_probe_expr_ctxs, state));
     if (_vother_join_conjunct_ptr) {
         RETURN_IF_ERROR((*_vother_join_conjunct_ptr)->open(state));
     }
+    return Status::OK();
+}
+
+Status HashJoinNode::open(RuntimeState* state) {
+    RETURN_IF_ERROR(alloc_resource(state));
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    RETURN_IF_CANCELLED(state);
 
     RETURN_IF_ERROR(_hash_table_build(state));
     RETURN_IF_ERROR(child(0)->open(state));
@@ -805,7 +867,6 @@ Status HashJoinNode::open(RuntimeState* state) {
 
 Status HashJoinNode::_hash_table_build(RuntimeState* state) {
     RETURN_IF_ERROR(child(1)->open(state));
-    SCOPED_TIMER(_build_timer);
     Block block;
 
     bool eos = false;
@@ -814,12 +875,23 @@ Status HashJoinNode::_hash_table_build(RuntimeState* state) {
         RETURN_IF_CANCELLED(state);
 
         RETURN_IF_ERROR(child(1)->get_next(state, &block, &eos));
-        _mem_tracker->Consume(block.allocated_bytes());
-        _mem_used += block.allocated_bytes();
-        RETURN_IF_LIMIT_EXCEEDED(state, "Hash join, while getting next from the child 1.");
+        RETURN_IF_ERROR(sink(state, &block, eos));
+    }
 
-        RETURN_IF_ERROR(_process_build_block(state, block));
-        RETURN_IF_LIMIT_EXCEEDED(state, "Hash join, while constructing the hash table.");
+    return Status::OK();
+}
+
+Status HashJoinNode::sink(RuntimeState* state, Block* build_block, bool eos) {
+    SCOPED_TIMER(_build_timer);
+    SCOPED_SWITCH_THREAD_MEM_TRACKER(_mem_tracker);
+    _mem_tracker->CacheConsume(build_block->allocated_bytes());
+    _mem_used += build_block->allocated_bytes();
+    RETURN_IF_LIMIT_EXCEEDED(state, "Hash join, while getting next from the child 1.");
+
+    RETURN_IF_ERROR(_process_build_block(state, *build_block));
+    RETURN_IF_LIMIT_EXCEEDED(state, "Hash join, while constructing the hash table.");
+    if (!eos) {
+        return Status::OK();
     }
 
     return std::visit(
@@ -130,6 +130,20 @@ public:
     virtual Status close(RuntimeState* state);
     HashTableVariants& get_hash_table_variants() { return _hash_table_variants; }
 
+    // The methods below are used by the pipeline engine, which drives the build side and the
+    // probe side of the join separately instead of calling open() and get_next().
+
+    // Open the expressions of the node, but not the children.
+    Status alloc_resource(RuntimeState* state);
+    // Insert a block of the build side into the hash table.
+    Status sink(RuntimeState* state, Block* build_block, bool eos);
+    // True if the current probe block is consumed, and push() should be called.
+    bool need_more_input_data() const;
+    // Take the next probe block, it's swapped into the node.
+    Status push(RuntimeState* state, Block* input_block, bool eos);
+    // Probe the hash table with the current probe block.
+    Status pull(RuntimeState* state, Block* output_block, bool* eos);
+
 private:
     using VExprContexts = std::vector<VExprContext*>;
 
@@ -0,0 +1,488 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/join/vmerge_join_node.h"
+
+#include <sstream>
+
+#include "runtime/runtime_state.h"
+#include "util/runtime_profile.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/common/assert_cast.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/exprs/vexpr_context.h"
+#include "vec/utils/util.hpp"
+
+namespace doris::vectorized {
+
+// The columns of the output may be nullable while the ones of the inputs are not, e.g. the
+// right columns of a left outer join.
+static void insert_range(IColumn& dst, const IColumn& src, size_t start, size_t length) {
+    if (dst.is_nullable() && !src.is_nullable()) {
+        assert_cast<ColumnNullable&>(dst).insert_range_from_not_nullable(src, start, length);
+    } else {
+        dst.insert_range_from(src, start, length);
+    }
+}
+
+static void insert_many(IColumn& dst, const IColumn& src, size_t position, size_t length) {
+    if (dst.is_nullable() && !src.is_nullable()) {
+        assert_cast<ColumnNullable&>(dst).insert_many_from_not_nullable(src, position, length);
+    } else {
+        dst.insert_many_from(src, position, length);
+    }
+}
+
+VMergeJoinNode::VMergeJoinNode(ObjectPool* pool, const TPlanNode& tnode,
+                               const DescriptorTbl& descs)
+        : ExecNode(pool, tnode, descs),
+          _join_op(tnode.merge_join_node.__isset.join_op ? tnode.merge_join_node.join_op
+                                                         : TJoinOp::INNER_JOIN) {}
+
+Status VMergeJoinNode::init(const TPlanNode& tnode, RuntimeState* state) {
+    DCHECK(tnode.__isset.merge_join_node);
+    RETURN_IF_ERROR(ExecNode::init(tnode, state));
+    if (_join_op != TJoinOp::INNER_JOIN && _join_op != TJoinOp::LEFT_OUTER_JOIN &&
+        _join_op != TJoinOp::LEFT_SEMI_JOIN && _join_op != TJoinOp::LEFT_ANTI_JOIN) {
+        return Status::InternalError("Merge join only supports inner, left outer, left semi "
+                                     "and left anti join");
+    }
+    _row_desc_for_other_join_conjunct =
+            RowDescriptor(child(0)->row_desc(), child(1)->row_desc());
+
+    const std::vector<TEqJoinCondition>& cmp_conjuncts = tnode.merge_join_node.cmp_conjuncts;
+    for (const auto& cmp_conjunct : cmp_conjuncts) {
+        VExprContext* ctx = nullptr;
+        RETURN_IF_ERROR(VExpr::create_expr_tree(_pool, cmp_conjunct.left, &ctx));
+        _left_expr_ctxs.push_back(ctx);
+        RETURN_IF_ERROR(VExpr::create_expr_tree(_pool, cmp_conjunct.right, &ctx));
+        _right_expr_ctxs.push_back(ctx);
+        _is_null_safe_eq_join.push_back(cmp_conjunct.__isset.opcode &&
+                                        cmp_conjunct.opcode == TExprOpcode::EQ_FOR_NULL);
+    }
+
+    if (tnode.merge_join_node.__isset.vother_join_conjunct) {
+        _vother_join_conjunct_ptr.reset(new VExprContext*);
+        RETURN_IF_ERROR(VExpr::create_expr_tree(_pool, tnode.merge_join_node.vother_join_conjunct,
+                                                _vother_join_conjunct_ptr.get()));
+    }
+    return Status::OK();
+}
+
+Status VMergeJoinNode::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(ExecNode::prepare(state));
+    _left_rows_counter = ADD_COUNTER(runtime_profile(), "LeftChildRows", TUnit::UNIT);
+    _right_rows_counter = ADD_COUNTER(runtime_profile(), "RightChildRows", TUnit::UNIT);
+    _max_group_rows_counter = ADD_COUNTER(runtime_profile(), "MaxRightGroupRows", TUnit::UNIT);
+    _merge_timer = ADD_TIMER(runtime_profile(), "MergeTime");
+
+    RETURN_IF_ERROR(
+            VExpr::prepare(_left_expr_ctxs, state, child(0)->row_desc(), expr_mem_tracker()));
+    RETURN_IF_ERROR(
+            VExpr::prepare(_right_expr_ctxs, state, child(1)->row_desc(), expr_mem_tracker()));
+    if (_vother_join_conjunct_ptr) {
+        RETURN_IF_ERROR((*_vother_join_conjunct_ptr)
+                                ->prepare(state, _row_desc_for_other_join_conjunct,
+                                          expr_mem_tracker()));
+    }
+
+    for (int i = 0; i < _left_expr_ctxs.size(); ++i) {
+        _key_to_nullable.push_back(_left_expr_ctxs[i]->root()->is_nullable() ||
+                                   _right_expr_ctxs[i]->root()->is_nullable());
+    }
+    _num_left_columns = VectorizedUtils::get_data_types(child(0)->row_desc()).size();
+    _num_right_columns = VectorizedUtils::get_data_types(child(1)->row_desc()).size();
+    return Status::OK();
+}
+
+Status VMergeJoinNode::open(RuntimeState* state) {
+    RETURN_IF_ERROR(ExecNode::open(state));
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    RETURN_IF_CANCELLED(state);
+    RETURN_IF_ERROR(VExpr::open(_left_expr_ctxs, state));
+    RETURN_IF_ERROR(VExpr::open(_right_expr_ctxs, state));
+    if (_vother_join_conjunct_ptr) {
+        RETURN_IF_ERROR((*_vother_join_conjunct_ptr)->open(state));
+    }
+    RETURN_IF_ERROR(child(0)->open(state));
+    RETURN_IF_ERROR(child(1)->open(state));
+    return Status::OK();
+}
+
+Status VMergeJoinNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) {
+    return Status::NotSupported("Not Implemented VMergeJoinNode::get_next scalar");
+}
+
+Status VMergeJoinNode::get_next(RuntimeState* state, Block* block, bool* eos) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    RETURN_IF_CANCELLED(state);
+    block->clear();
+    *eos = false;
+    if (reached_limit()) {
+        *eos = true;
+        return Status::OK();
+    }
+
+    const bool need_unmatched =
+            _join_op == TJoinOp::LEFT_OUTER_JOIN || _join_op == TJoinOp::LEFT_ANTI_JOIN;
+    const bool per_row_other_conjunct =
+            _vother_join_conjunct_ptr != nullptr && _join_op != TJoinOp::INNER_JOIN;
+    const size_t batch_size = state->batch_size();
+
+    MutableBlock mutable_block(VectorizedUtils::create_empty_columnswithtypename(row_desc()));
+    auto& columns = mutable_block.mutable_columns();
+    while (mutable_block.rows() < batch_size) {
+        if (_left.exhausted()) {
+            if (_left.eos) {
+                break;
+            }
+            RETURN_IF_ERROR(_fetch_block(state, 0, &_left));
+            continue;
+        }
+
+        SCOPED_TIMER(_merge_timer);
+        if (!_right_group_loaded ||
+            _compare_keys(_left.key_columns, _left.pos, _right_group_keys, 0) > 0) {
+            RETURN_IF_ERROR(_load_right_group(state));
+        }
+        if (!_right_group_loaded) {
+            // the right input is exhausted, no more left rows can match
+            if (need_unmatched) {
+                _emit_unmatched(columns, _left.pos, _left.rows());
+            }
+            _left.pos = _left.rows();
+            _left.eos |= !need_unmatched;
+            continue;
+        }
+
+        // the keys of the group are not less than the current left key
+        if (_compare_keys(_left.key_columns, _left.pos, _right_group_keys, 0) < 0) {
+            size_t end = _lower_bound(_left.key_columns, _left.pos, _left.rows(),
+                                      _right_group_keys, 0, false);
+            _emit_unmatched(columns, _left.pos, end);
+            _left.pos = end;
+            continue;
+        }
+
+        size_t end = _lower_bound(_left.key_columns, _left.pos, _left.rows(), _right_group_keys,
+                                  0, true);
+        if (_right_group_has_null) {
+            _emit_unmatched(columns, _left.pos, end);
+            _left.pos = end;
+        } else if (per_row_other_conjunct) {
+            for (; _left.pos < end && mutable_block.rows() < batch_size; ++_left.pos) {
+                RETURN_IF_ERROR(_emit_matched_with_other_conjunct(columns, _left.pos));
+            }
+        } else if (_join_op == TJoinOp::LEFT_SEMI_JOIN || _join_op == TJoinOp::LEFT_ANTI_JOIN) {
+            _emit_matched(columns, _left.pos, end);
+            _left.pos = end;
+        } else {
+            // every left row outputs the whole group, stop once the block is full
+            size_t group_rows = _right_group_rows;
+            size_t left_rows = (batch_size - mutable_block.rows() + group_rows - 1) / group_rows;
+            left_rows = std::min(left_rows, end - _left.pos);
+            _emit_matched(columns, _left.pos, _left.pos + left_rows);
+            _left.pos += left_rows;
+        }
+    }
+
+    block->swap(mutable_block.to_block());
+    if (_vother_join_conjunct_ptr && _join_op == TJoinOp::INNER_JOIN) {
+        RETURN_IF_ERROR(
+                VExprContext::filter_block(_vother_join_conjunct_ptr, block, block->columns()));
+    }
+    RETURN_IF_ERROR(VExprContext::filter_block(_vconjunct_ctx_ptr, block, block->columns()));
+    *eos = _left.eos && _left.exhausted();
+
+    if (_limit != -1 && _num_rows_returned + block->rows() >= _limit) {
+        block->set_num_rows(_limit - _num_rows_returned);
+        *eos = true;
+    }
+    _num_rows_returned += block->rows();
+    COUNTER_SET(_rows_returned_counter, _num_rows_returned);
+    return Status::OK();
+}
+
+Status VMergeJoinNode::close(RuntimeState* state) {
+    if (is_closed()) {
+        return Status::OK();
+    }
+    VExpr::close(_left_expr_ctxs, state);
+    VExpr::close(_right_expr_ctxs, state);
+    if (_vother_join_conjunct_ptr) {
+        (*_vother_join_conjunct_ptr)->close(state);
+    }
+    return ExecNode::close(state);
+}
+
+Status VMergeJoinNode::_fetch_block(RuntimeState* state, int child_idx, ChildBlock* child_block) {
+    Block block;
+    do {
+        release_block_memory(block, child_idx);
+        RETURN_IF_ERROR(child(child_idx)->get_next(state, &block, &child_block->eos));
+    } while (block.rows() == 0 && !child_block->eos);
+
+    child_block->block.swap(block);
+    child_block->pos = 0;
+    if (child_block->rows() == 0) {
+        return Status::OK();
+    }
+    COUNTER_UPDATE(child_idx == 0 ? _left_rows_counter : _right_rows_counter,
+                   child_block->rows());
+    for (size_t i = 0; i < child_block->block.columns(); ++i) {
+        auto& column = child_block->block.get_by_position(i).column;
+        column = column->convert_to_full_column_if_const();
+    }
+    return _extract_key_columns(child_idx == 0 ? _left_expr_ctxs : _right_expr_ctxs,
+                                child_block);
+}
+
+Status VMergeJoinNode::_extract_key_columns(const VExprContexts& expr_ctxs,
+                                            ChildBlock* child_block) {
+    Block& block = child_block->block;
+    child_block->key_columns.resize(expr_ctxs.size());
+    for (int i = 0; i < expr_ctxs.size(); ++i) {
+        int result_column_id = -1;
+        RETURN_IF_ERROR(expr_ctxs[i]->execute(&block, &result_column_id));
+        ColumnPtr column = block.get_by_position(result_column_id).column;
+        DataTypePtr type = block.get_by_position(result_column_id).type;
+        // compare_at needs the key columns of both sides to be of the same kind
+        if (is_column_const(*column) || (_key_to_nullable[i] && !column->is_nullable())) {
+            column = column->convert_to_full_column_if_const();
+            if (_key_to_nullable[i]) {
+                column = make_nullable(column);
+                type = make_nullable(type);
+            }
+            block.insert({column, type, ""});
+            result_column_id = block.columns() - 1;
+        }
+        child_block->key_columns[i] = block.get_by_position(result_column_id).column.get();
+    }
+    return Status::OK();
+}
+
+Status VMergeJoinNode::_load_right_group(RuntimeState* state) {
+    _right_group_loaded = false;
+    _right_group_columns.clear();
+    _right_group_keys.clear();
+    _right_group_rows = 0;
+
+    // skip the right rows whose keys are less than the current left key
+    while (true) {
+        if (_right.exhausted()) {
+            if (_right.eos) {
+                return Status::OK();
+            }
+            RETURN_IF_ERROR(_fetch_block(state, 1, &_right));
+            continue;
+        }
+        _right.pos = _lower_bound(_right.key_columns, _right.pos, _right.rows(),
+                                  _left.key_columns, _left.pos, false);
+        if (!_right.exhausted()) {
+            break;
+        }
+    }
+
+    // the rows with the same key may span several right blocks, only the output columns
+    // and the key columns are kept
+    MutableColumns group_columns;
+    for (size_t i = 0; i < _num_right_columns; ++i) {
+        group_columns.push_back(_right.block.get_by_position(i).column->clone_empty());
+    }
+    for (const auto* key_column : _right.key_columns) {
+        group_columns.push_back(key_column->clone_empty());
+    }
+    auto append_rows = [&](size_t end) {
+        for (size_t i = 0; i < _num_right_columns; ++i) {
+            group_columns[i]->insert_range_from(*_right.block.get_by_position(i).column,
+                                                _right.pos, end - _right.pos);
+        }
+        for (size_t i = 0; i < _right.key_columns.size(); ++i) {
+            group_columns[_num_right_columns + i]->insert_range_from(*_right.key_columns[i],
+                                                                     _right.pos, end - _right.pos);
+        }
+        _right.pos = end;
+    };
+    append_rows(_lower_bound(_right.key_columns, _right.pos, _right.rows(), _right.key_columns,
+                             _right.pos, true));
+    for (size_t i = _num_right_columns; i < group_columns.size(); ++i) {
+        _right_group_keys.push_back(group_columns[i].get());
+    }
+    while (_right.exhausted() && !_right.eos) {
+        RETURN_IF_ERROR(_fetch_block(state, 1, &_right));
+        if (_right.exhausted()) {
+            break;
+        }
+        append_rows(_lower_bound(_right.key_columns, 0, _right.rows(), _right_group_keys, 0,
+                                 true));
+    }
+
+    _right_group_rows = group_columns[0]->size();
+    for (auto& column : group_columns) {
+        _right_group_columns.push_back(std::move(column));
+    }
+    _right_group_loaded = true;
+    _right_group_has_null = _has_null_key(_right_group_keys, 0);
+    if (_right_group_rows > _max_group_rows_counter->value()) {
+        COUNTER_SET(_max_group_rows_counter, (int64_t)_right_group_rows);
+    }
+    return Status::OK();
+}
+
+int VMergeJoinNode::_compare_keys(const ColumnRawPtrs& lhs, size_t lhs_row,
+                                  const ColumnRawPtrs& rhs, size_t rhs_row) const {
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        int res = lhs[i]->compare_at(lhs_row, rhs_row, *rhs[i], -1);
+        if (res != 0) {
+            return res;
+        }
+    }
+    return 0;
+}
+
+bool VMergeJoinNode::_has_null_key(const ColumnRawPtrs& keys, size_t row) const {
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (!_is_null_safe_eq_join[i] && keys[i]->is_null_at(row)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t VMergeJoinNode::_lower_bound(const ColumnRawPtrs& keys, size_t begin, size_t end,
+                                    const ColumnRawPtrs& target, size_t row, bool upper) const {
+    auto before_target = [&](size_t pos) {
+        int res = _compare_keys(keys, pos, target, row);
+        return upper ? res <= 0 : res < 0;
+    };
+    // The ranges are usually short, so gallop from the beginning before the binary search.
+    size_t step = 1;
+    while (begin < end && before_target(begin)) {
+        size_t next = begin + step;
+        if (next >= end || !before_target(next)) {
+            // the bound is in (begin, min(next, end)]
+            ++begin;
+            end = std::min(next, end);
+            while (begin < end) {
+                size_t mid = begin + (end - begin) / 2;
+                if (before_target(mid)) {
+                    begin = mid + 1;
+                } else {
+                    end = mid;
+                }
+            }
+            return begin;
+        }
+        begin = next;
+        step *= 2;
+    }
+    return begin;
+}
+
+void VMergeJoinNode::_emit_unmatched(MutableColumns& columns, size_t begin, size_t end) {
+    if (begin >= end || _join_op == TJoinOp::INNER_JOIN || _join_op == TJoinOp::LEFT_SEMI_JOIN) {
+        return;
+    }
+    for (size_t i = 0; i < _num_left_columns; ++i) {
+        insert_range(*columns[i], *_left.block.get_by_position(i).column, begin, end - begin);
+    }
+    if (_join_op == TJoinOp::LEFT_OUTER_JOIN) {
+        for (size_t i = 0; i < _num_right_columns; ++i) {
+            DCHECK(columns[_num_left_columns + i]->is_nullable());
+            columns[_num_left_columns + i]->insert_many_defaults(end - begin);
+        }
+    }
+}
+
+void VMergeJoinNode::_emit_matched(MutableColumns& columns, size_t begin, size_t end) {
+    if (_join_op == TJoinOp::LEFT_ANTI_JOIN) {
+        return;
+    }
+    if (_join_op == TJoinOp::LEFT_SEMI_JOIN) {
+        for (size_t i = 0; i < _num_left_columns; ++i) {
+            insert_range(*columns[i], *_left.block.get_by_position(i).column, begin,
+                         end - begin);
+        }
+        return;
+    }
+    size_t group_rows = _right_group_rows;
+    for (size_t row = begin; row < end; ++row) {
+        for (size_t i = 0; i < _num_left_columns; ++i) {
+            insert_many(*columns[i], *_left.block.get_by_position(i).column, row, group_rows);
+        }
+        for (size_t i = 0; i < _num_right_columns; ++i) {
+            insert_range(*columns[_num_left_columns + i], *_right_group_columns[i],
+                         0, group_rows);
+        }
+    }
+}
+
+// Joins one left row with the group, and evaluates the other join conjunct on the
+// candidates to decide which of them are matched.
+Status VMergeJoinNode::_emit_matched_with_other_conjunct(MutableColumns& columns, size_t row) {
+    size_t group_rows = _right_group_rows;
+    MutableBlock candidates(
+            VectorizedUtils::create_empty_columnswithtypename(_row_desc_for_other_join_conjunct));
+    auto& candidate_columns = candidates.mutable_columns();
+    for (size_t i = 0; i < _num_left_columns; ++i) {
+        insert_many(*candidate_columns[i], *_left.block.get_by_position(i).column, row,
+                    group_rows);
+    }
+    for (size_t i = 0; i < _num_right_columns; ++i) {
+        insert_range(*candidate_columns[_num_left_columns + i],
+                     *_right_group_columns[i], 0, group_rows);
+    }
+    Block candidate_block = candidates.to_block();
+    int result_column_id = -1;
+    RETURN_IF_ERROR((*_vother_join_conjunct_ptr)->execute(&candidate_block, &result_column_id));
+    const auto& filter = *candidate_block.get_by_position(result_column_id).column;
+
+    size_t matched = 0;
+    for (size_t i = 0; i < group_rows; ++i) {
+        if (!filter.get_bool(i)) {
+            continue;
+        }
+        ++matched;
+        if (_join_op != TJoinOp::LEFT_OUTER_JOIN) {
+            break;
+        }
+        for (size_t j = 0; j < _num_left_columns + _num_right_columns; ++j) {
+            insert_range(*columns[j], *candidate_block.get_by_position(j).column, i, 1);
+        }
+    }
+
+    if ((_join_op == TJoinOp::LEFT_SEMI_JOIN && matched > 0) ||
+        (_join_op == TJoinOp::LEFT_ANTI_JOIN && matched == 0)) {
+        for (size_t i = 0; i < _num_left_columns; ++i) {
+            insert_range(*columns[i], *_left.block.get_by_position(i).column, row, 1);
+        }
+    } else if (_join_op == TJoinOp::LEFT_OUTER_JOIN && matched == 0) {
+        _emit_unmatched(columns, row, row + 1);
+    }
+    return Status::OK();
+}
+
+void VMergeJoinNode::debug_string(int indentation_level, std::stringstream* out) const {
+    *out << std::string(indentation_level * 2, ' ');
+    *out << "VMergeJoinNode(left_pos=" << _left.pos
+         << " right_pos=" << _right.pos << " group_rows=" << _right_group_rows;
+    ExecNode::debug_string(indentation_level, out);
+    *out << ")";
+}
+
+} // namespace doris::vectorized
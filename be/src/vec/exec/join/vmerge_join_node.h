@@ -0,0 +1,119 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "exec/exec_node.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "vec/core/block.h"
+
+namespace doris {
+namespace vectorized {
+
+class VExprContext;
+
+// Joins two inputs which are both sorted ascending on the join keys, with nulls first.
+// Only the rows of the right input having the current key (a "group", which may span
+// several blocks) are kept in memory, so unlike the hash join the memory used doesn't
+// depend on the size of the inputs.
+// The matching ranges of the inputs are found with IColumn::compare_at and are copied
+// with insert_range_from. Supports inner, left outer, left semi and left anti joins.
+class VMergeJoinNode : public ::doris::ExecNode {
+public:
+    VMergeJoinNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs);
+    ~VMergeJoinNode() override = default;
+
+    Status init(const TPlanNode& tnode, RuntimeState* state = nullptr) override;
+    Status prepare(RuntimeState* state) override;
+    Status open(RuntimeState* state) override;
+    Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) override;
+    Status get_next(RuntimeState* state, Block* block, bool* eos) override;
+    Status close(RuntimeState* state) override;
+
+protected:
+    void debug_string(int indentation_level, std::stringstream* out) const override;
+
+private:
+    using VExprContexts = std::vector<VExprContext*>;
+
+    // A block of one input, with the columns of the join keys appended to it.
+    struct ChildBlock {
+        Block block;
+        ColumnRawPtrs key_columns;
+        size_t pos = 0;
+        bool eos = false;
+
+        size_t rows() const { return block.rows(); }
+        bool exhausted() const { return pos == block.rows(); }
+    };
+
+    // Fetch the next non empty block of the child, and evaluate the join keys on it.
+    Status _fetch_block(RuntimeState* state, int child_idx, ChildBlock* child_block);
+    Status _extract_key_columns(const VExprContexts& expr_ctxs, ChildBlock* child_block);
+
+    // Skip the right rows whose key is less than the key of the current left row, and
+    // collect the right rows having the next key into _right_group.
+    Status _load_right_group(RuntimeState* state);
+
+    // Compare the keys of two rows, nulls are less than any other value.
+    int _compare_keys(const ColumnRawPtrs& lhs, size_t lhs_row, const ColumnRawPtrs& rhs,
+                      size_t rhs_row) const;
+    bool _has_null_key(const ColumnRawPtrs& keys, size_t row) const;
+    // The first row in [begin, end) of `keys`, whose key isn't less than (or with `upper`,
+    // is greater than) the key of `row` in `target`.
+    size_t _lower_bound(const ColumnRawPtrs& keys, size_t begin, size_t end,
+                        const ColumnRawPtrs& target, size_t row, bool upper) const;
+
+    void _emit_unmatched(MutableColumns& columns, size_t begin, size_t end);
+    void _emit_matched(MutableColumns& columns, size_t begin, size_t end);
+    Status _emit_matched_with_other_conjunct(MutableColumns& columns, size_t row);
+
+    TJoinOp::type _join_op;
+    VExprContexts _left_expr_ctxs;
+    VExprContexts _right_expr_ctxs;
+    std::unique_ptr<VExprContext*> _vother_join_conjunct_ptr;
+    RowDescriptor _row_desc_for_other_join_conjunct;
+
+    // mark the join column whether support null eq
+    std::vector<bool> _is_null_safe_eq_join;
+    // the key columns of both sides are made nullable if either of them is
+    std::vector<bool> _key_to_nullable;
+
+    size_t _num_left_columns = 0;
+    size_t _num_right_columns = 0;
+
+    ChildBlock _left;
+    ChildBlock _right;
+
+    // The right rows having the current key: the output columns of the right input,
+    // followed by the key columns.
+    Columns _right_group_columns;
+    ColumnRawPtrs _right_group_keys;
+    size_t _right_group_rows = 0;
+    // True if _right_group holds a key, it's empty when the right input is exhausted.
+    bool _right_group_loaded = false;
+    // True if the key of _right_group contains a null, which matches no left row.
+    bool _right_group_has_null = false;
+
+    RuntimeProfile::Counter* _left_rows_counter;
+    RuntimeProfile::Counter* _right_rows_counter;
+    RuntimeProfile::Counter* _max_group_rows_counter;
+    RuntimeProfile::Counter* _merge_timer;
+};
+
+} // namespace vectorized
+} // namespace doris
@@ -17,14 +17,18 @@
 
 #include "vec/exec/vaggregation_node.h"
 
+#include <limits>
 #include <memory>
 
 #include "exec/exec_node.h"
 #include "runtime/mem_pool.h"
+#include "runtime/mem_tracker.h"
 #include "runtime/row_batch.h"
 #include "util/defer_op.h"
+#include "vec/common/assert_cast.h"
 #include "vec/core/block.h"
 #include "vec/data_types/data_type_nullable.h"
+#include "vec/exec/vrepeat_node.h"
 #include "vec/exprs/vexpr.h"
 #include "vec/exprs/vexpr_context.h"
 #include "vec/exprs/vslot_ref.h"
@@ -74,6 +78,20 @@ static constexpr StreamingHtMinReductionEntry STREAMING_HT_MIN_REDUCTION[] = {
 static constexpr int STREAMING_HT_MIN_REDUCTION_SIZE =
         sizeof(STREAMING_HT_MIN_REDUCTION) / sizeof(STREAMING_HT_MIN_REDUCTION[0]);
 
+// When the preagg passes rows through, the reduction is sampled again after this many rows,
+// since the distribution of the keys may change.
+static constexpr int64_t STREAMING_HT_RESAMPLE_ROWS = 1024 * 1024;
+
+// Find the appropriate reduction factor in our table for the current hash table sizes.
+static double streaming_ht_min_reduction(size_t ht_mem) {
+    int cache_level = 0;
+    while (cache_level + 1 < STREAMING_HT_MIN_REDUCTION_SIZE &&
+           ht_mem >= STREAMING_HT_MIN_REDUCTION[cache_level + 1].min_ht_mem) {
+        ++cache_level;
+    }
+    return STREAMING_HT_MIN_REDUCTION[cache_level].streaming_ht_min_reduction;
+}
+
 AggregationNode::AggregationNode(ObjectPool* pool, const TPlanNode& tnode,
                                  const DescriptorTbl& descs)
         : ExecNode(pool, tnode, descs),
@@ -217,6 +235,7 @@ Status AggregationNode::prepare(RuntimeState* state) {
             VExpr::prepare(_probe_expr_ctxs, state, child(0)->row_desc(), expr_mem_tracker()));
 
     _mem_pool = std::make_unique<MemPool>(mem_tracker().get());
+    _use_raw_agg_state = state->be_exec_version() >= RAW_AGGREGATE_STATE_EXEC_VERSION;
 
     int j = _probe_expr_ctxs.size();
     for (int i = 0; i < _aggregate_evaluators.size(); ++i, ++j) {
@@ -232,6 +251,11 @@ Status AggregationNode::prepare(RuntimeState* state) {
         evaluator->set_timer(_exec_timer, _merge_timer, _expr_timer);
     }
 
+    VExpr::set_expr_cache(_probe_expr_ctxs, &_expr_cache);
+    for (auto& evaluator : _aggregate_evaluators) {
+        VExpr::set_expr_cache(evaluator->input_exprs_ctxs(), &_expr_cache);
+    }
+
     _offsets_of_aggregate_states.resize(_aggregate_evaluators.size());
 
     for (size_t i = 0; i < _aggregate_evaluators.size(); ++i) {
@@ -302,7 +326,6 @@ Status AggregationNode::prepare(RuntimeState* state) {
             _executor.pre_agg =
                     std::bind<Status>(&AggregationNode::_pre_agg_with_serialized_key, this,
                                       std::placeholders::_1, std::placeholders::_2);
-            _max_size_of_stream_pre_agg_buffer = state->batch_size();
         }
 
         if (_needs_finalize) {
@@ -322,7 +345,7 @@ Status AggregationNode::prepare(RuntimeState* state) {
     return Status::OK();
 }
 
-Status AggregationNode::open(RuntimeState* state) {
+Status AggregationNode::alloc_resource(RuntimeState* state) {
     RETURN_IF_ERROR(ExecNode::open(state));
     SCOPED_TIMER(_runtime_profile->total_time_counter());
 
@@ -331,29 +354,84 @@ Status AggregationNode::open(RuntimeState* state) {
     for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
         RETURN_IF_ERROR(_aggregate_evaluators[i]->open(state));
     }
+    return Status::OK();
+}
+
+Status AggregationNode::open(RuntimeState* state) {
+    RETURN_IF_ERROR(alloc_resource(state));
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
 
     RETURN_IF_ERROR(_children[0]->open(state));
 
-    // Streaming preaggregations do all processing in GetNext().
+    // Streaming preaggregations do all processing in GetNext(), including the fusion of a
+    // repeat node.
     if (_is_streaming_preagg) return Status::OK();
 
+    // GROUPING SETS, ROLLUP and CUBE
+    if (auto* repeat_node = dynamic_cast<VRepeatNode*>(_children[0]);
+        repeat_node != nullptr && repeat_node->can_be_fused()) {
+        return _sink_repeated_blocks(state, repeat_node);
+    }
+
     bool eos = false;
     Block block;
     while (!eos) {
         RETURN_IF_CANCELLED(state);
         release_block_memory(block);
         RETURN_IF_ERROR(_children[0]->get_next(state, &block, &eos));
-        if (block.rows() == 0) {
+        RETURN_IF_ERROR(sink(state, &block, eos));
+    }
+
+    return Status::OK();
+}
+
+Status AggregationNode::sink(RuntimeState* state, Block* input_block, bool eos) {
+    SCOPED_SWITCH_THREAD_MEM_TRACKER(mem_tracker());
+    if (input_block->rows() == 0) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(_executor.execute(input_block));
+    _expr_cache.clear();
+    _executor.update_memusage();
+    RETURN_IF_LIMIT_EXCEEDED(state, "aggregator, while execute open.");
+    return Status::OK();
+}
+
+Status AggregationNode::_sink_repeated_blocks(RuntimeState* state, VRepeatNode* repeat_node) {
+    size_t repeat_times = repeat_node->repeat_times();
+    bool eos = false;
+    Block child_block;
+    while (!eos) {
+        RETURN_IF_CANCELLED(state);
+        RETURN_IF_ERROR(repeat_node->get_next_child_block(state, &child_block, &eos));
+        if (child_block.rows() == 0) {
             continue;
         }
-        RETURN_IF_ERROR(_executor.execute(&block));
-        _executor.update_memusage();
-        RETURN_IF_LIMIT_EXCEEDED(state, "aggregator, while execute open.");
+        for (size_t i = 0; i < repeat_times; ++i) {
+            Block repeated_block;
+            RETURN_IF_ERROR(repeat_node->get_repeated_block(child_block, i, &repeated_block));
+            RETURN_IF_ERROR(sink(state, &repeated_block, eos && i + 1 == repeat_times));
+        }
     }
-
     return Status::OK();
 }
 
+Status AggregationNode::_next_repeated_block(RuntimeState* state, VRepeatNode* repeat_node) {
+    while (_repeat_child_block.rows() == 0 || _next_repeat_idx == repeat_node->repeat_times()) {
+        if (_repeat_child_eos) {
+            return Status::OK();
+        }
+        // the columns of the last child block may be passed through to the returned blocks
+        _repeat_child_block.clear();
+        RETURN_IF_ERROR(
+                repeat_node->get_next_child_block(state, &_repeat_child_block, &_repeat_child_eos));
+        _next_repeat_idx = 0;
+    }
+    _preagg_block.clear();
+    return repeat_node->get_repeated_block(_repeat_child_block, _next_repeat_idx++,
+                                           &_preagg_block);
+}
+
 Status AggregationNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) {
     return Status::NotSupported("Not Implemented Aggregation Node::get_next scalar");
 }
@@ -365,13 +443,37 @@ Status AggregationNode::get_next(RuntimeState* state, Block* block, bool* eos) {
         bool child_eos = false;
 
         RETURN_IF_CANCELLED(state);
-        do {
-            release_block_memory(_preagg_block);
-            RETURN_IF_ERROR(_children[0]->get_next(state, &_preagg_block, &child_eos));
-        } while (_preagg_block.rows() == 0 && !child_eos);
+        // GROUPING SETS, ROLLUP and CUBE
+        if (auto* repeat_node = dynamic_cast<VRepeatNode*>(_children[0]);
+            repeat_node != nullptr && repeat_node->can_be_fused()) {
+            RETURN_IF_ERROR(_next_repeated_block(state, repeat_node));
+        } else {
+            do {
+                release_block_memory(_preagg_block);
+                RETURN_IF_ERROR(_children[0]->get_next(state, &_preagg_block, &child_eos));
+            } while (_preagg_block.rows() == 0 && !child_eos);
+        }
+    }
 
+    return pull(state, block, eos);
+}
+
+Status AggregationNode::push(RuntimeState* state, Block* input_block, bool eos) {
+    DCHECK(_is_streaming_preagg);
+    _child_eos = eos;
+    _preagg_block.swap(*input_block);
+    return Status::OK();
+}
+
+Status AggregationNode::pull(RuntimeState* state, Block* block, bool* eos) {
+    SCOPED_SWITCH_THREAD_MEM_TRACKER(mem_tracker());
+    if (_is_streaming_preagg) {
         if (_preagg_block.rows() != 0) {
             RETURN_IF_ERROR(_executor.pre_agg(&_preagg_block, block));
+            _expr_cache.clear();
+            // the input is consumed, columns of it may be passed through to the output block,
+            // so drop them instead of clearing the data.
+            _preagg_block.clear();
         } else {
             RETURN_IF_ERROR(_executor.get_result(state, block, eos));
         }
@@ -394,7 +496,6 @@ Status AggregationNode::close(RuntimeState* state) {
     RETURN_IF_ERROR(ExecNode::close(state));
     VExpr::close(_probe_expr_ctxs, state);
     if (_executor.close) _executor.close();
-    delete [] _streaming_pre_agg_buffer;
     return Status::OK();
 }
 
@@ -472,18 +573,13 @@ Status AggregationNode::_serialize_without_key(RuntimeState* state, Block* block
     std::vector<DataTypePtr> data_types(agg_size);
 
     // will serialize data to string column
-    std::vector<VectorBufferWriter> value_buffer_writers;
     auto serialize_string_type = std::make_shared<DataTypeString>();
     for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
         data_types[i] = serialize_string_type;
         value_columns[i] = serialize_string_type->create_column();
-        value_buffer_writers.emplace_back(*reinterpret_cast<ColumnString*>(value_columns[i].get()));
-    }
-
-    for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
-        _aggregate_evaluators[i]->function()->serialize(
-                _agg_data.without_key + _offsets_of_aggregate_states[i], value_buffer_writers[i]);
-        value_buffer_writers[i].commit();
+        _aggregate_evaluators[i]->function()->serialize_vec(
+                &_agg_data.without_key, _offsets_of_aggregate_states[i],
+                assert_cast<ColumnString&>(*value_columns[i]), 1, _use_raw_agg_state);
     }
     {
         ColumnsWithTypeAndName data_with_schema;
@@ -512,7 +608,6 @@ Status AggregationNode::_execute_without_key(Block* block) {
 Status AggregationNode::_merge_without_key(Block* block) {
     SCOPED_TIMER(_merge_timer);
     DCHECK(_agg_data.without_key != nullptr);
-    std::unique_ptr<char[]> deserialize_buffer(new char[_total_size_of_aggregate_states]);
     int rows = block->rows();
     for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
         if (_aggregate_evaluators[i]->is_merge()) {
@@ -521,21 +616,12 @@ Status AggregationNode::_merge_without_key(Block* block) {
                 column = ((ColumnNullable*)column.get())->get_nested_column_ptr();
             }
 
-            for (int j = 0; j < rows; ++j) {
-                VectorBufferReader buffer_reader(((ColumnString*)(column.get()))->get_data_at(j));
-                _create_agg_status(deserialize_buffer.get());
-
-                _aggregate_evaluators[i]->function()->deserialize(
-                        deserialize_buffer.get() + _offsets_of_aggregate_states[i], buffer_reader,
-                        &_agg_arena_pool);
-
-                _aggregate_evaluators[i]->function()->merge(
-                        _agg_data.without_key + _offsets_of_aggregate_states[i],
-                        deserialize_buffer.get() + _offsets_of_aggregate_states[i],
-                        &_agg_arena_pool);
-
-                _destory_agg_status(deserialize_buffer.get());
-            }
+            // all rows are merged into the single state
+            PODArray<AggregateDataPtr> places(rows, _agg_data.without_key);
+            RETURN_IF_ERROR(_aggregate_evaluators[i]->function()->deserialize_and_merge_vec(
+                    places.data(), _offsets_of_aggregate_states[i],
+                    assert_cast<const ColumnString&>(*column), &_agg_arena_pool, rows,
+                    _use_raw_agg_state));
         } else {
             _aggregate_evaluators[i]->execute_single_add(
                     block, _agg_data.without_key + _offsets_of_aggregate_states[i]);
@@ -545,7 +631,7 @@ Status AggregationNode::_merge_without_key(Block* block) {
 }
 
 void AggregationNode::_update_memusage_without_key() {
-    mem_tracker()->Consume(_agg_arena_pool.size() - _mem_usage_record.used_in_arena);
+    mem_tracker()->CacheConsume(_agg_arena_pool.size() - _mem_usage_record.used_in_arena);
     _mem_usage_record.used_in_arena = _agg_arena_pool.size();
 }
 
@@ -563,21 +649,17 @@ bool AggregationNode::_should_expand_preagg_hash_tables() {
                 auto [ht_mem, ht_rows] =
                         std::pair {hash_tbl.get_buffer_size_in_bytes(), hash_tbl.size()};
 
-                // Need some rows in tables to have valid statistics.
-                if (ht_rows == 0) return true;
-
-                // Find the appropriate reduction factor in our table for the current hash table sizes.
-                int cache_level = 0;
-                while (cache_level + 1 < STREAMING_HT_MIN_REDUCTION_SIZE &&
-                       ht_mem >= STREAMING_HT_MIN_REDUCTION[cache_level + 1].min_ht_mem) {
-                    ++cache_level;
-                }
+                // Need some rows in tables to have valid statistics. Only the rows added after
+                // a sample resumed the expansion are counted.
+                if (ht_rows <= _sampled_ht_rows) return true;
+                ht_rows -= _sampled_ht_rows;
 
                 // Compare the number of rows in the hash table with the number of input rows that
                 // were aggregated into it. Exclude passed through rows from this calculation since
                 // they were not in hash tables.
                 const int64_t input_rows = _children[0]->rows_returned();
-                const int64_t aggregated_input_rows = input_rows - _num_rows_returned;
+                const int64_t aggregated_input_rows =
+                        input_rows - _num_rows_returned - _sampled_input_rows;
                 // TODO chenhao
                 //  const int64_t expected_input_rows = estimated_input_cardinality_ - num_rows_returned_;
                 double current_reduction = static_cast<double>(aggregated_input_rows) / ht_rows;
@@ -595,8 +677,7 @@ bool AggregationNode::_should_expand_preagg_hash_tables() {
                 //  double estimated_reduction = aggregated_input_rows >= expected_input_rows
                 //      ? current_reduction
                 //      : 1 + (expected_input_rows / aggregated_input_rows) * (current_reduction - 1);
-                double min_reduction =
-                        STREAMING_HT_MIN_REDUCTION[cache_level].streaming_ht_min_reduction;
+                double min_reduction = streaming_ht_min_reduction(ht_mem);
 
                 //  COUNTER_SET(preagg_estimated_reduction_, estimated_reduction);
                 //    COUNTER_SET(preagg_streaming_ht_min_reduction_, min_reduction);
@@ -607,6 +688,31 @@ bool AggregationNode::_should_expand_preagg_hash_tables() {
             _agg_data._aggregated_method_variant);
 }
 
+template <typename HashMethod>
+bool AggregationNode::_sample_preagg_reduction(HashMethod& agg_method, ColumnRawPtrs& key_columns,
+                                               size_t rows) {
+    using AggState = typename HashMethod::State;
+    AggState state(key_columns, _probe_key_sz, nullptr);
+    // the keys serialized for the lookups are dropped with this pool
+    Arena pool;
+    size_t found_rows = 0;
+    for (size_t i = 0; i < rows; ++i) {
+        found_rows += state.find_key(agg_method.data, i, pool).is_found();
+    }
+    if (found_rows == 0) return false;
+
+    // Every row whose key is not found adds one row to the hash table at most.
+    double estimated_reduction = found_rows == rows
+                                         ? std::numeric_limits<double>::max()
+                                         : static_cast<double>(rows) / (rows - found_rows);
+    double min_reduction = streaming_ht_min_reduction(agg_method.data.get_buffer_size_in_bytes());
+    if (estimated_reduction <= min_reduction) return false;
+
+    _sampled_input_rows = _children[0]->rows_returned() - _num_rows_returned;
+    _sampled_ht_rows = agg_method.data.size();
+    return true;
+}
+
 Status AggregationNode::_pre_agg_with_serialized_key(doris::vectorized::Block* in_block,
                                                      doris::vectorized::Block* out_block) {
     SCOPED_TIMER(_build_timer);
@@ -639,40 +745,19 @@ Status AggregationNode::_pre_agg_with_serialized_key(doris::vectorized::Block* i
     std::visit(
             [&](auto&& agg_method) -> void {
                 if (auto& hash_tbl = agg_method.data; hash_tbl.add_elem_size_overflow(rows)) {
-                    // do not try to do agg, just init and serialize directly return the out_block
+                    if (!_should_expand_hash_table &&
+                        _passthrough_rows_since_sample >= STREAMING_HT_RESAMPLE_ROWS) {
+                        _passthrough_rows_since_sample = 0;
+                        _should_expand_hash_table =
+                                _sample_preagg_reduction(agg_method, key_columns, rows);
+                    }
+                    // do not try to do agg, just serialize one-row states of the input rows
+                    // directly to the out_block
                     if (!_should_expand_preagg_hash_tables()) {
                         ret_flag = true;
-                        if (_streaming_pre_agg_buffer == nullptr) {
-                            _streaming_pre_agg_buffer =
-                                    new char[((_total_size_of_aggregate_states *
-                                               _max_size_of_stream_pre_agg_buffer) /
-                                                      _align_aggregate_states +
-                                              1) *
-                                             _align_aggregate_states];
-                        }
-
-                        if (UNLIKELY(_max_size_of_stream_pre_agg_buffer < rows)) {
-                            delete[] _streaming_pre_agg_buffer;
-                            _streaming_pre_agg_buffer = new char[((_total_size_of_aggregate_states *
-                                                                   rows) / _align_aggregate_states +
-                                                                  1) *
-                                                                 _align_aggregate_states];
-                        }
-
-                        auto aggregate_data = _streaming_pre_agg_buffer;
-                        for (size_t i = 0; i < rows; ++i) {
-                            _create_agg_status(aggregate_data);
-                            places[i] = aggregate_data;
-                            aggregate_data += _total_size_of_aggregate_states;
-                        }
-                        for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
-                            _aggregate_evaluators[i]->execute_batch_add(
-                                    in_block, _offsets_of_aggregate_states[i], places.data(),
-                                    &_agg_arena_pool);
-                        }
+                        _passthrough_rows_since_sample += rows;
 
                         // will serialize value data to string column
-                        std::vector<VectorBufferWriter> value_buffer_writers;
                         bool mem_reuse = out_block->mem_reuse();
                         auto serialize_string_type = std::make_shared<DataTypeString>();
                         MutableColumns value_columns;
@@ -685,19 +770,9 @@ Status AggregationNode::_pre_agg_with_serialized_key(doris::vectorized::Block* i
                                 // slot type of value it should always be string type
                                 value_columns.emplace_back(serialize_string_type->create_column());
                             }
-                            value_buffer_writers.emplace_back(
-                                    *reinterpret_cast<ColumnString*>(value_columns[i].get()));
-                        }
-
-                        aggregate_data = _streaming_pre_agg_buffer;
-                        for (size_t j = 0; j < rows; ++j) {
-                            for (size_t i = 0; i < _aggregate_evaluators.size(); ++i) {
-                                _aggregate_evaluators[i]->function()->serialize(
-                                        aggregate_data + _offsets_of_aggregate_states[i],
-                                        value_buffer_writers[i]);
-                                value_buffer_writers[i].commit();
-                            }
-                            aggregate_data += _total_size_of_aggregate_states;
+                            _aggregate_evaluators[i]->streaming_agg_serialize(
+                                    in_block, assert_cast<ColumnString&>(*value_columns[i]),
+                                    _use_raw_agg_state, &_agg_arena_pool);
                         }
 
                         if (!mem_reuse) {
@@ -725,35 +800,7 @@ Status AggregationNode::_pre_agg_with_serialized_key(doris::vectorized::Block* i
             _agg_data._aggregated_method_variant);
 
     if (!ret_flag) {
-        std::visit(
-                [&](auto &&agg_method) -> void {
-                    using HashMethodType = std::decay_t<decltype(agg_method)>;
-                    using AggState = typename HashMethodType::State;
-                    AggState state(key_columns, _probe_key_sz, nullptr);
-                    /// For all rows.
-                    for (size_t i = 0; i < rows; ++i) {
-                        AggregateDataPtr aggregate_data = nullptr;
-
-                        auto emplace_result = state.emplace_key(agg_method.data, i, _agg_arena_pool);
-
-                        /// If a new key is inserted, initialize the states of the aggregate functions, and possibly something related to the key.
-                        if (emplace_result.is_inserted()) {
-                            /// exception-safety - if you can not allocate memory or create states, then destructors will not be called.
-                            emplace_result.set_mapped(nullptr);
-
-                            aggregate_data = _agg_arena_pool.aligned_alloc(
-                                    _total_size_of_aggregate_states, _align_aggregate_states);
-                            _create_agg_status(aggregate_data);
-
-                            emplace_result.set_mapped(aggregate_data);
-                        } else
-                            aggregate_data = emplace_result.get_mapped();
-
-                        places[i] = aggregate_data;
-                        assert(places[i] != nullptr);
-                    }
-                },
-                _agg_data._aggregated_method_variant);
+        _emplace_into_hash_table(places.data(), key_columns, rows);
 
         for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
             _aggregate_evaluators[i]->execute_batch_add(in_block, _offsets_of_aggregate_states[i],
@@ -764,37 +811,29 @@ Status AggregationNode::_pre_agg_with_serialized_key(doris::vectorized::Block* i
     return Status::OK();
 }
 
-Status AggregationNode::_execute_with_serialized_key(Block* block) {
-    SCOPED_TIMER(_build_timer);
-    DCHECK(!_probe_expr_ctxs.empty());
-
-    size_t key_size = _probe_expr_ctxs.size();
-    ColumnRawPtrs key_columns(key_size);
-    {
-        SCOPED_TIMER(_expr_timer);
-        for (size_t i = 0; i < key_size; ++i) {
-            int result_column_id = -1;
-            RETURN_IF_ERROR(_probe_expr_ctxs[i]->execute(block, &result_column_id));
-            block->get_by_position(result_column_id).column =
-                    block->get_by_position(result_column_id)
-                            .column->convert_to_full_column_if_const();
-            key_columns[i] = block->get_by_position(result_column_id).column.get();
-        }
-    }
-
-    int rows = block->rows();
-    PODArray<AggregateDataPtr> places(rows);
-
+void AggregationNode::_emplace_into_hash_table(AggregateDataPtr* places,
+                                               ColumnRawPtrs& key_columns, size_t rows) {
     std::visit(
             [&](auto&& agg_method) -> void {
                 using HashMethodType = std::decay_t<decltype(agg_method)>;
                 using AggState = typename HashMethodType::State;
                 AggState state(key_columns, _probe_key_sz, nullptr);
+
+                // Hash all rows first, so the bucket of the row HASH_MAP_PREFETCH_DIST rows
+                // ahead can be prefetched while the current row is emplaced.
+                _hash_values.resize(rows);
+                state.get_hashes(agg_method.data, 0, rows, _agg_arena_pool, _hash_values.data());
+
                 /// For all rows.
                 for (size_t i = 0; i < rows; ++i) {
                     AggregateDataPtr aggregate_data = nullptr;
 
-                    auto emplace_result = state.emplace_key(agg_method.data, i, _agg_arena_pool);
+                    if (LIKELY(i + HASH_MAP_PREFETCH_DIST < rows)) {
+                        agg_method.data.template prefetch_by_hash<false>(
+                                _hash_values[i + HASH_MAP_PREFETCH_DIST]);
+                    }
+                    auto emplace_result =
+                            state.emplace_key(agg_method.data, _hash_values[i], i, _agg_arena_pool);
 
                     /// If a new key is inserted, initialize the states of the aggregate functions, and possibly something related to the key.
                     if (emplace_result.is_inserted()) {
@@ -814,6 +853,30 @@ Status AggregationNode::_execute_with_serialized_key(Block* block) {
                 }
             },
             _agg_data._aggregated_method_variant);
+}
+
+Status AggregationNode::_execute_with_serialized_key(Block* block) {
+    SCOPED_TIMER(_build_timer);
+    DCHECK(!_probe_expr_ctxs.empty());
+
+    size_t key_size = _probe_expr_ctxs.size();
+    ColumnRawPtrs key_columns(key_size);
+    {
+        SCOPED_TIMER(_expr_timer);
+        for (size_t i = 0; i < key_size; ++i) {
+            int result_column_id = -1;
+            RETURN_IF_ERROR(_probe_expr_ctxs[i]->execute(block, &result_column_id));
+            block->get_by_position(result_column_id).column =
+                    block->get_by_position(result_column_id)
+                            .column->convert_to_full_column_if_const();
+            key_columns[i] = block->get_by_position(result_column_id).column.get();
+        }
+    }
+
+    int rows = block->rows();
+    PODArray<AggregateDataPtr> places(rows);
+
+    _emplace_into_hash_table(places.data(), key_columns, rows);
 
     for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
         _aggregate_evaluators[i]->execute_batch_add(block, _offsets_of_aggregate_states[i],
@@ -919,7 +982,6 @@ Status AggregationNode::_serialize_with_serialized_key_result(RuntimeState* stat
     }
 
     // will serialize data to string column
-    std::vector<VectorBufferWriter> value_buffer_writers;
     auto serialize_string_type = std::make_shared<DataTypeString>();
     for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
         value_data_types[i] = serialize_string_type;
@@ -928,9 +990,12 @@ Status AggregationNode::_serialize_with_serialized_key_result(RuntimeState* stat
         } else {
             value_columns[i] = serialize_string_type->create_column();
         }
-        value_buffer_writers.emplace_back(*reinterpret_cast<ColumnString*>(value_columns[i].get()));
     }
 
+    // the states of the returned rows, they are serialized per aggregate function at the end
+    PODArray<AggregateDataPtr> places;
+    places.reserve(state->batch_size() + 1);
+
     std::visit(
             [&](auto&& agg_method) -> void {
                 agg_method.init_once();
@@ -941,13 +1006,7 @@ Status AggregationNode::_serialize_with_serialized_key_result(RuntimeState* stat
                     auto& mapped = iter->get_second();
                     // insert keys
                     agg_method.insert_key_into_columns(key, key_columns, _probe_key_sz);
-
-                    // serialize values
-                    for (size_t i = 0; i < _aggregate_evaluators.size(); ++i) {
-                        _aggregate_evaluators[i]->function()->serialize(
-                                mapped + _offsets_of_aggregate_states[i], value_buffer_writers[i]);
-                        value_buffer_writers[i].commit();
-                    }
+                    places.push_back(mapped);
                     ++iter;
                 }
 
@@ -957,13 +1016,7 @@ Status AggregationNode::_serialize_with_serialized_key_result(RuntimeState* stat
                         DCHECK(key_columns[0]->is_nullable());
                         if (agg_method.data.has_null_key_data()) {
                             key_columns[0]->insert_data(nullptr, 0);
-                            auto mapped = agg_method.data.get_null_key_data();
-                            for (size_t i = 0; i < _aggregate_evaluators.size(); ++i) {
-                                _aggregate_evaluators[i]->function()->serialize(
-                                        mapped + _offsets_of_aggregate_states[i],
-                                        value_buffer_writers[i]);
-                                value_buffer_writers[i].commit();
-                            }
+                            places.push_back(agg_method.data.get_null_key_data());
                             *eos = true;
                         }
                     } else {
@@ -973,6 +1026,14 @@ Status AggregationNode::_serialize_with_serialized_key_result(RuntimeState* stat
             },
             _agg_data._aggregated_method_variant);
 
+    // serialize values
+    for (int i = 0; i < agg_size; ++i) {
+        _aggregate_evaluators[i]->function()->serialize_vec(
+                places.data(), _offsets_of_aggregate_states[i],
+                assert_cast<ColumnString&>(*value_columns[i]), places.size(),
+                _use_raw_agg_state);
+    }
+
     if (!mem_reuse) {
         ColumnsWithTypeAndName columns_with_schema;
         for (int i = 0; i < key_size; ++i) {
@@ -1003,37 +1064,7 @@ Status AggregationNode::_merge_with_serialized_key(Block* block) {
     int rows = block->rows();
     PODArray<AggregateDataPtr> places(rows);
 
-    std::visit(
-            [&](auto&& agg_method) -> void {
-                using HashMethodType = std::decay_t<decltype(agg_method)>;
-                using AggState = typename HashMethodType::State;
-                AggState state(key_columns, _probe_key_sz, nullptr);
-                /// For all rows.
-                for (size_t i = 0; i < rows; ++i) {
-                    AggregateDataPtr aggregate_data = nullptr;
-
-                    auto emplace_result = state.emplace_key(agg_method.data, i, _agg_arena_pool);
-
-                    /// If a new key is inserted, initialize the states of the aggregate functions, and possibly something related to the key.
-                    if (emplace_result.is_inserted()) {
-                        /// exception-safety - if you can not allocate memory or create states, then destructors will not be called.
-                        emplace_result.set_mapped(nullptr);
-
-                        aggregate_data = _agg_arena_pool.aligned_alloc(
-                                _total_size_of_aggregate_states, _align_aggregate_states);
-                        _create_agg_status(aggregate_data);
-
-                        emplace_result.set_mapped(aggregate_data);
-                    } else
-                        aggregate_data = emplace_result.get_mapped();
-
-                    places[i] = aggregate_data;
-                    assert(places[i] != nullptr);
-                }
-            },
-            _agg_data._aggregated_method_variant);
-
-    std::unique_ptr<char[]> deserialize_buffer(new char[_total_size_of_aggregate_states]);
+    _emplace_into_hash_table(places.data(), key_columns, rows);
 
     for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
         if (_aggregate_evaluators[i]->is_merge()) {
@@ -1042,21 +1073,10 @@ Status AggregationNode::_merge_with_serialized_key(Block* block) {
                 column = ((ColumnNullable*)column.get())->get_nested_column_ptr();
             }
 
-            for (int j = 0; j < rows; ++j) {
-                VectorBufferReader buffer_reader(((ColumnString*)(column.get()))->get_data_at(j));
-                _create_agg_status(deserialize_buffer.get());
-
-                _aggregate_evaluators[i]->function()->deserialize(
-                        deserialize_buffer.get() + _offsets_of_aggregate_states[i], buffer_reader,
-                        &_agg_arena_pool);
-
-                _aggregate_evaluators[i]->function()->merge(
-                        places.data()[j] + _offsets_of_aggregate_states[i],
-                        deserialize_buffer.get() + _offsets_of_aggregate_states[i],
-                        &_agg_arena_pool);
-
-                _destory_agg_status(deserialize_buffer.get());
-            }
+            RETURN_IF_ERROR(_aggregate_evaluators[i]->function()->deserialize_and_merge_vec(
+                    places.data(), _offsets_of_aggregate_states[i],
+                    assert_cast<const ColumnString&>(*column), &_agg_arena_pool, rows,
+                    _use_raw_agg_state));
         } else {
             _aggregate_evaluators[i]->execute_batch_add(block, _offsets_of_aggregate_states[i],
                                                         places.data(), &_agg_arena_pool);
@@ -1069,9 +1089,9 @@ void AggregationNode::_update_memusage_with_serialized_key() {
     std::visit(
             [&](auto&& agg_method) -> void {
                 auto& data = agg_method.data;
-                mem_tracker()->Consume(_agg_arena_pool.size() - _mem_usage_record.used_in_arena);
-                mem_tracker()->Consume(data.get_buffer_size_in_bytes() -
-                                       _mem_usage_record.used_in_state);
+                mem_tracker()->CacheConsume(_agg_arena_pool.size() - _mem_usage_record.used_in_arena);
+                mem_tracker()->CacheConsume(data.get_buffer_size_in_bytes() -
+                                            _mem_usage_record.used_in_state);
                 _mem_usage_record.used_in_state = data.get_buffer_size_in_bytes();
                 _mem_usage_record.used_in_arena = _agg_arena_pool.size();
             },
@@ -34,6 +34,7 @@ class MemPool;
 
 namespace vectorized {
 class VExprContext;
+class VRepeatNode;
 
 /** Aggregates by concatenating serialized key values.
   * The serialized value differs in that it uniquely allows to deserialize it, having only the position with which it starts.
@@ -385,12 +386,28 @@ public:
     virtual Status get_next(RuntimeState* state, Block* block, bool* eos);
     virtual Status close(RuntimeState* state);
 
+    // The methods below are used by the pipeline engine. A blocking aggregation is split into
+    // sink() and pull(), a streaming preaggregation is driven by push() and pull().
+
+    // Open the expressions and evaluators of the node, but not the child.
+    Status alloc_resource(RuntimeState* state);
+    Status sink(RuntimeState* state, Block* input_block, bool eos);
+    bool need_more_input_data() const { return _preagg_block.rows() == 0 && !_child_eos; }
+    Status push(RuntimeState* state, Block* input_block, bool eos);
+    Status pull(RuntimeState* state, Block* block, bool* eos);
+    bool is_streaming_preagg() const { return _is_streaming_preagg; }
+
 private:
     // group by k1,k2
     std::vector<VExprContext*> _probe_expr_ctxs;
     std::vector<size_t> _probe_key_sz;
 
     std::vector<AggFnEvaluator*> _aggregate_evaluators;
+    // the hash values of the keys of the input block
+    std::vector<size_t> _hash_values;
+    // shared by the group by exprs and the arguments of the aggregate functions, cleared
+    // after each input block.
+    VExprCache _expr_cache;
 
     // may be we don't have to know the tuple id
     TupleId _intermediate_tuple_id;
@@ -408,6 +425,9 @@ private:
     Sizes _offsets_of_aggregate_states;
     /// The total size of the row from the aggregate functions.
     size_t _total_size_of_aggregate_states = 0;
+    /// Whether the intermediate states of the functions with fixed size states are their raw
+    /// bytes, it's only true when all BEs of the query read them, see RAW_AGGREGATE_STATE_EXEC_VERSION.
+    bool _use_raw_agg_state = false;
 
     AggregatedDataVariants _agg_data;
 
@@ -421,9 +441,20 @@ private:
 
     bool _is_streaming_preagg;
     Block _preagg_block = Block();
+    // Only used by push()
+    bool _child_eos = false;
+    // The child block of a fused repeat node in a streaming preaggregation, one grouping set
+    // of it is pre-aggregated by each get_next().
+    Block _repeat_child_block;
+    size_t _next_repeat_idx = 0;
+    bool _repeat_child_eos = false;
     bool _should_expand_hash_table = true;
-    char* _streaming_pre_agg_buffer = nullptr;
-    size_t _max_size_of_stream_pre_agg_buffer = 0;
+    // Rows passed through since the reduction of the hash table was sampled last time.
+    int64_t _passthrough_rows_since_sample = 0;
+    // The aggregated input rows and hash table rows when a sample resumed the expansion,
+    // the reduction is computed on the rows aggregated after it.
+    int64_t _sampled_input_rows = 0;
+    size_t _sampled_ht_rows = 0;
 
     /// Expose the minimum reduction factor to continue growing the hash tables.
     RuntimeProfile::Counter* preagg_streaming_ht_min_reduction_;
@@ -432,10 +463,22 @@ private:
     /// Return true if we should keep expanding hash tables in the preagg. If false,
     /// the preagg should pass through any rows it can't fit in its tables.
     bool _should_expand_preagg_hash_tables();
+    /// Looks up the keys of the rows in the hash table while the preagg passes rows through.
+    /// Return true if the found rows show a reduction good enough to expand hash tables again.
+    template <typename HashMethod>
+    bool _sample_preagg_reduction(HashMethod& agg_method, ColumnRawPtrs& key_columns,
+                                  size_t rows);
 
     Status _create_agg_status(AggregateDataPtr data);
     Status _destory_agg_status(AggregateDataPtr data);
 
+    // Sinks every grouping set of the child blocks of the repeat node, without pulling the
+    // repeated blocks through VRepeatNode::get_next().
+    Status _sink_repeated_blocks(RuntimeState* state, VRepeatNode* repeat_node);
+    // Builds the next grouping set of the child blocks of the repeat node into _preagg_block,
+    // which is left empty once the child is exhausted.
+    Status _next_repeated_block(RuntimeState* state, VRepeatNode* repeat_node);
+
     Status _get_without_key_result(RuntimeState* state, Block* block, bool* eos);
     Status _serialize_without_key(RuntimeState* state, Block* block, bool* eos);
     Status _execute_without_key(Block* block);
@@ -446,6 +489,9 @@ private:
     Status _get_with_serialized_key_result(RuntimeState* state, Block* block, bool* eos);
     Status _serialize_with_serialized_key_result(RuntimeState* state, Block* block, bool* eos);
     Status _pre_agg_with_serialized_key(Block* in_block, Block* out_block);
+    // Finds or creates the aggregate states of the keys of the rows into places.
+    void _emplace_into_hash_table(AggregateDataPtr* places, ColumnRawPtrs& key_columns,
+                                  size_t rows);
     Status _execute_with_serialized_key(Block* block);
     Status _merge_with_serialized_key(Block* block);
     void _update_memusage_with_serialized_key();
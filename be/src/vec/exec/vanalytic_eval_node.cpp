@@ -17,6 +17,8 @@
 
 #include "vec/exec/vanalytic_eval_node.h"
 
+#include <algorithm>
+
 #include "exprs/agg_fn_evaluator.h"
 #include "exprs/anyval_util.h"
 #include "runtime/descriptors.h"
@@ -197,6 +199,28 @@ Status VAnalyticEvalNode::prepare(RuntimeState* state) {
     _fn_place_ptr =
             _agg_arena_pool.aligned_alloc(_total_size_of_aggregate_states, _align_aggregate_states);
     _create_agg_status();
+
+    // The frames of a ROWS window which isn't [UNBOUNDED PRECEDING, CURRENT ROW] slide forward
+    // with the current row, the functions of one argument don't have to add every frame again.
+    bool sliding_frame = _fn_scope == AnalyticFnScope::ROWS &&
+                         (_window.__isset.window_start ||
+                          _window.window_end.type != TAnalyticWindowBoundaryType::CURRENT_ROW);
+    bool one_argument = std::all_of(_agg_intput_columns.begin(), _agg_intput_columns.end(),
+                                    [](const auto& columns) { return columns.size() == 1; });
+    if (sliding_frame && one_argument) {
+        _frame_strategies.resize(_agg_functions_size, RECOMPUTE);
+        _segment_trees.resize(_agg_functions_size);
+        for (size_t i = 0; i < _agg_functions_size; ++i) {
+            const auto& agg_function = _agg_functions[i]->function();
+            if (agg_function->is_retractable()) {
+                _frame_strategies[i] = RETRACT;
+            } else if (agg_function->is_frame_mergeable()) {
+                _frame_strategies[i] = SEGMENT_TREE;
+                _segment_trees[i] = std::make_unique<WindowSegmentTree>(agg_function.get());
+            }
+        }
+    }
+
     _executor.insert_result =
             std::bind<void>(&VAnalyticEvalNode::_insert_result_info, this, std::placeholders::_1);
 
@@ -238,6 +262,7 @@ Status VAnalyticEvalNode::close(RuntimeState* state) {
         return Status::OK();
     }
     ExecNode::close(state);
+    _segment_trees.clear();
     _destory_agg_status();
     return Status::OK();
 }
@@ -313,16 +338,23 @@ Status VAnalyticEvalNode::_get_next_for_rows(RuntimeState* state, Block* block,
                 _window.window_end.type == TAnalyticWindowBoundaryType::CURRENT_ROW) { //[preceding, current_row],[current_row, following]
                 range_start.pos = _current_row_position;
                 range_end.pos = _current_row_position + 1; //going on calculate,add up data, no need to reset state
+                _executor.execute(_partition_by_start, _partition_by_end, range_start, range_end);
             } else {
-                _reset_agg_status();
                 if (!_window.__isset.window_start) { //[preceding, offset]        --unbound: [preceding, following]
                     range_start.pos = _partition_by_start.pos;
                 } else {
                     range_start.pos = _current_row_position + _rows_start_offset;
                 }
                 range_end.pos = _current_row_position + _rows_end_offset + 1;
+                if (_frame_strategies.empty()) {
+                    _reset_agg_status();
+                    _executor.execute(_partition_by_start, _partition_by_end, range_start,
+                                      range_end);
+                } else {
+                    _execute_for_sliding_frame(_partition_by_start, _partition_by_end, range_start,
+                                               range_end);
+                }
             }
-            _executor.execute(_partition_by_start, _partition_by_end, range_start, range_end);
             _executor.insert_result(current_block_rows);
         }
         if (_window_end_position == current_block_rows) {
@@ -602,6 +634,65 @@ void VAnalyticEvalNode::_execute_for_one_column(BlockRowPos partition_start,
     }
 }
 
+// The frames of the rows of a partition only slide forward. The RETRACT functions retract the
+// rows leaving the frame and add the rows entering it, the SEGMENT_TREE functions merge the
+// states of the frame from the segment tree of the partition.
+void VAnalyticEvalNode::_execute_for_sliding_frame(BlockRowPos partition_start,
+                                                   BlockRowPos partition_end,
+                                                   BlockRowPos frame_start, BlockRowPos frame_end) {
+    int64_t start = std::max(frame_start.pos, partition_start.pos);
+    int64_t end = std::max(std::min(frame_end.pos, partition_end.pos), start);
+    if (partition_start.pos != _sliding_partition_start ||
+        partition_end.pos != _sliding_partition_end) {
+        _sliding_partition_start = partition_start.pos;
+        _sliding_partition_end = partition_end.pos;
+        _sliding_frame_start = partition_start.pos;
+        _sliding_frame_end = partition_start.pos;
+        for (size_t i = 0; i < _agg_functions_size; ++i) {
+            if (_frame_strategies[i] == SEGMENT_TREE) {
+                const IColumn* agg_column = _agg_intput_columns[i][0].get();
+                _segment_trees[i]->build(&agg_column, partition_start.pos, partition_end.pos,
+                                         nullptr);
+            }
+        }
+    }
+
+    // the states are reset if the frame doesn't overlap the rows added before
+    bool restart = start >= _sliding_frame_end;
+    int64_t retract_start = restart ? start : _sliding_frame_start;
+    int64_t add_start = restart ? start : _sliding_frame_end;
+    for (size_t i = 0; i < _agg_functions_size; ++i) {
+        const IColumn* agg_column = _agg_intput_columns[i][0].get();
+        const auto& agg_function = _agg_functions[i]->function();
+        AggregateDataPtr place = _fn_place_ptr + _offsets_of_aggregate_states[i];
+        switch (_frame_strategies[i]) {
+        case RETRACT:
+            if (restart) {
+                _agg_functions[i]->reset(place);
+            }
+            for (int64_t row = retract_start; row < start; ++row) {
+                agg_function->retract(place, &agg_column, row, nullptr);
+            }
+            for (int64_t row = add_start; row < end; ++row) {
+                agg_function->add(place, &agg_column, row, nullptr);
+            }
+            break;
+        case SEGMENT_TREE:
+            _agg_functions[i]->reset(place);
+            _segment_trees[i]->merge_frame(place, start, end, nullptr);
+            break;
+        default:
+            _agg_functions[i]->reset(place);
+            agg_function->add_range_single_place(partition_start.pos, partition_end.pos,
+                                                 frame_start.pos, frame_end.pos, place,
+                                                 &agg_column, nullptr);
+            break;
+        }
+    }
+    _sliding_frame_start = start;
+    _sliding_frame_end = end;
+}
+
 //binary search for range to calculate peer group
 void VAnalyticEvalNode::_update_order_by_range() {
     _order_by_start = _order_by_end;
@@ -23,6 +23,7 @@
 #include "thrift/protocol/TDebugProtocol.h"
 #include "vec/common/arena.h"
 #include "vec/core/block.h"
+#include "vec/exec/window_segment_tree.h"
 #include "vec/exprs/vectorized_agg_fn.h"
 #include "vec/exprs/vexpr.h"
 #include "vec/exprs/vexpr_context.h"
@@ -62,6 +63,8 @@ private:
                                  BlockRowPos frame_start, BlockRowPos frame_end);
     void _execute_for_three_column(BlockRowPos partition_start, BlockRowPos partition_end,
                                    BlockRowPos frame_start, BlockRowPos frame_end);
+    void _execute_for_sliding_frame(BlockRowPos partition_start, BlockRowPos partition_end,
+                                    BlockRowPos frame_start, BlockRowPos frame_end);
 
     Status _reset_agg_status();
     Status _init_result_columns();
@@ -100,6 +103,8 @@ private:
 
 private:
     enum AnalyticFnScope { PARTITION, RANGE, ROWS };
+    // How a function computes the sliding frames of a ROWS window, see _execute_for_sliding_frame()
+    enum FrameStrategy { RECOMPUTE, RETRACT, SEGMENT_TREE };
     std::vector<Block> _input_blocks;
     std::vector<int64_t> input_block_first_row_positions;
     std::vector<AggFnEvaluator*> _agg_functions;
@@ -145,6 +150,17 @@ private:
     TupleDescriptor* _output_tuple_desc;
     std::vector<int64_t> _origin_cols;
 
+    // Empty if the frames are not sliding, or not all functions have one argument, then the
+    // states are reset and the frame of every row is added again.
+    std::vector<FrameStrategy> _frame_strategies;
+    std::vector<std::unique_ptr<WindowSegmentTree>> _segment_trees;
+    // The partition of the segment trees and of the sliding frame.
+    int64_t _sliding_partition_start = -1;
+    int64_t _sliding_partition_end = -1;
+    // The rows [_sliding_frame_start, _sliding_frame_end) are in the states of RETRACT functions.
+    int64_t _sliding_frame_start = 0;
+    int64_t _sliding_frame_end = 0;
+
     RuntimeProfile::Counter* _evaluation_timer;
 };
 } // namespace doris::vectorized
\ No newline at end of file
@@ -17,6 +17,7 @@
 
 #include "vec/exec/vcross_join_node.h"
 
+#include <set>
 #include <sstream>
 
 #include "exprs/expr.h"
@@ -24,6 +25,10 @@
 #include "runtime/row_batch.h"
 #include "runtime/runtime_state.h"
 #include "util/runtime_profile.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/exprs/vexpr_context.h"
+#include "vec/utils/util.hpp"
 
 namespace doris::vectorized {
 
@@ -36,9 +41,76 @@ Status VCrossJoinNode::prepare(RuntimeState* state) {
 
     _num_existing_columns = child(0)->row_desc().num_materialized_slots();
     _num_columns_to_add = child(1)->row_desc().num_materialized_slots();
+
+    if (_vconjunct_ctx_ptr) {
+        collect_inequality_conditions((*_vconjunct_ctx_ptr)->root());
+    }
+    if (!_inequality_ops.empty()) {
+        _inequality_join.reset(new InequalityJoin(_inequality_ops));
+        _inequality_candidates_counter =
+                ADD_COUNTER(runtime_profile(), "InequalityJoinCandidates", TUnit::UNIT);
+        add_runtime_exec_option("Inequality Join");
+    }
     return Status::OK();
 }
 
+// The child whose columns are read by the expr: 0 for the left child, 1 for the right
+// child, -1 if none or both.
+static int expr_child_idx(const VExpr* expr, size_t num_left_columns) {
+    std::set<int> column_ids;
+    expr->collect_slot_column_ids(&column_ids);
+    if (column_ids.empty()) {
+        return -1;
+    }
+    if (*column_ids.rbegin() < num_left_columns) {
+        return 0;
+    }
+    return *column_ids.begin() >= num_left_columns ? 1 : -1;
+}
+
+void VCrossJoinNode::collect_inequality_conditions(VExpr* expr) {
+    if (expr->is_and_expr()) {
+        for (auto child : expr->children()) {
+            collect_inequality_conditions(child);
+        }
+        return;
+    }
+    if (_inequality_ops.size() == 2 || expr->node_type() != TExprNodeType::BINARY_PRED ||
+        expr->children().size() != 2) {
+        return;
+    }
+
+    InequalityJoin::Op op;
+    if (expr->fn_name() == "lt") {
+        op = InequalityJoin::Op::LESS;
+    } else if (expr->fn_name() == "le") {
+        op = InequalityJoin::Op::LESS_EQUAL;
+    } else if (expr->fn_name() == "gt") {
+        op = InequalityJoin::Op::GREATER;
+    } else if (expr->fn_name() == "ge") {
+        op = InequalityJoin::Op::GREATER_EQUAL;
+    } else {
+        return;
+    }
+    VExpr* lhs = expr->children()[0];
+    VExpr* rhs = expr->children()[1];
+    // the keys are compared with IColumn::compare_at, which needs the same column types
+    if (!remove_nullable(lhs->data_type())->equals(*remove_nullable(rhs->data_type()))) {
+        return;
+    }
+    int lhs_child = expr_child_idx(lhs, _num_existing_columns);
+    int rhs_child = expr_child_idx(rhs, _num_existing_columns);
+    if (lhs_child == 1 && rhs_child == 0) {
+        std::swap(lhs, rhs);
+        op = InequalityJoin::reverse(op);
+    } else if (lhs_child != 0 || rhs_child != 1) {
+        return;
+    }
+    _left_inequality_exprs.push_back(lhs);
+    _right_inequality_exprs.push_back(rhs);
+    _inequality_ops.push_back(op);
+}
+
 Status VCrossJoinNode::close(RuntimeState* state) {
     // avoid double close
     if (is_closed()) {
@@ -80,9 +152,79 @@ Status VCrossJoinNode::construct_build_side(RuntimeState* state) {
     COUNTER_UPDATE(_build_row_counter, _build_rows);
     // If right table in join is empty, the node is eos
     _eos = _build_rows == 0;
+    if (_inequality_join != nullptr && !_eos) {
+        SCOPED_TIMER(_build_timer);
+        RETURN_IF_ERROR(build_inequality_join());
+    }
     return Status::OK();
 }
 
+Status VCrossJoinNode::build_inequality_join() {
+    MutableBlock mutable_block;
+    for (const auto& build_block : _build_blocks) {
+        mutable_block.merge(build_block);
+    }
+    Block build_block = mutable_block.to_block();
+    _build_blocks.clear();
+    _build_blocks.emplace_back(std::move(build_block));
+
+    // The right exprs read the columns after the ones of the left child, which are
+    // filled with constants here.
+    const Block& merged_block = _build_blocks[0];
+    Block key_block;
+    for (const auto& type : VectorizedUtils::get_data_types(child(0)->row_desc())) {
+        key_block.insert({type->create_column_const_with_default_value(_build_rows), type, ""});
+    }
+    for (const auto& column : merged_block.get_columns_with_type_and_name()) {
+        key_block.insert(column);
+    }
+    Columns keys;
+    for (auto expr : _right_inequality_exprs) {
+        int result_column_id = -1;
+        RETURN_IF_ERROR(expr->execute(*_vconjunct_ctx_ptr, &key_block, &result_column_id));
+        keys.push_back(key_block.get_by_position(result_column_id).column);
+    }
+    _inequality_join->build(std::move(keys));
+    return Status::OK();
+}
+
+Status VCrossJoinNode::probe_inequality_join() {
+    Block key_block(_left_block.get_columns_with_type_and_name());
+    Columns keys;
+    for (auto expr : _left_inequality_exprs) {
+        int result_column_id = -1;
+        RETURN_IF_ERROR(expr->execute(*_vconjunct_ctx_ptr, &key_block, &result_column_id));
+        keys.push_back(key_block.get_by_position(result_column_id).column);
+    }
+    _inequality_join->probe(std::move(keys));
+    _left_block_probed = true;
+    return Status::OK();
+}
+
+void VCrossJoinNode::process_inequality_pairs(MutableColumns& dst_columns) {
+    const size_t num_pairs = _probe_rows.size();
+    // the pairs of a left row are adjacent
+    for (size_t begin = 0; begin < num_pairs;) {
+        size_t end = begin + 1;
+        while (end < num_pairs && _probe_rows[end] == _probe_rows[begin]) {
+            ++end;
+        }
+        for (size_t i = 0; i < _num_existing_columns; ++i) {
+            const ColumnWithTypeAndName& src_column = _left_block.get_by_position(i);
+            dst_columns[i]->insert_many_from(*src_column.column, _probe_rows[begin], end - begin);
+        }
+        begin = end;
+    }
+    for (size_t i = 0; i < _num_columns_to_add; ++i) {
+        const IColumn& src_column = *_build_blocks[0].get_by_position(i).column;
+        auto& dst_column = dst_columns[_num_existing_columns + i];
+        for (auto row : _matched_build_rows) {
+            dst_column->insert_from(src_column, row);
+        }
+    }
+    COUNTER_UPDATE(_inequality_candidates_counter, num_pairs);
+}
+
 void VCrossJoinNode::init_get_next(int left_batch_row) {
     _current_build_pos = 0;
 }
@@ -100,7 +242,33 @@ Status VCrossJoinNode::get_next(RuntimeState* state, Block* block, bool* eos) {
     auto dst_columns = get_mutable_columns(block);
     ScopedTimer<MonotonicStopWatch> timer(_left_child_timer);
 
-    while (block->rows() < state->batch_size() && !_eos) {
+    while (_inequality_join != nullptr && block->rows() < state->batch_size() && !_eos) {
+        if (!_left_block_probed) {
+            RETURN_IF_ERROR(probe_inequality_join());
+        }
+        if (_inequality_join->probe_finished()) {
+            if (_left_side_eos) {
+                *eos = _eos = true;
+                break;
+            }
+            do {
+                release_block_memory(_left_block);
+                timer.stop();
+                RETURN_IF_ERROR(child(0)->get_next(state, &_left_block, &_left_side_eos));
+                timer.start();
+            } while (_left_block.rows() == 0 && !_left_side_eos);
+            COUNTER_UPDATE(_left_child_row_counter, _left_block.rows());
+            _left_block_probed = false;
+            continue;
+        }
+        _probe_rows.clear();
+        _matched_build_rows.clear();
+        _inequality_join->next_pairs(state->batch_size() - block->rows(), &_probe_rows,
+                                     &_matched_build_rows);
+        process_inequality_pairs(dst_columns);
+    }
+
+    while (_inequality_join == nullptr && block->rows() < state->batch_size() && !_eos) {
         // Check to see if we're done processing the current left child batch
         if (_current_build_pos == _build_blocks.size()) {
             _current_build_pos = 0;
@@ -29,15 +29,21 @@
 #include "runtime/mem_pool.h"
 
 #include "vec/core/block.h"
+#include "vec/exec/join/inequality_join.h"
 #include "vec/exec/vblocking_join_node.h"
 
 namespace doris::vectorized {
+class VExpr;
+
 // Node for cross joins.
 // Iterates over the left child rows and then the right child rows and, for
 // each combination, writes the output row if the conjuncts are satisfied. The
 // build batches are kept in a list that is fully constructed from the right child in
 // construct_build_side() (called by BlockingJoinNode::open()) while rows are fetched from
 // the left child as necessary in get_next().
+// If the conjuncts contain inequality conditions between the two children, e.g. a band
+// join "a.ts BETWEEN b.start AND b.end", the build rows are indexed on them, and only the
+// candidate pairs found with the index are produced and filtered by the conjuncts.
 class VCrossJoinNode final : public VBlockingJoinNode {
 public:
     VCrossJoinNode(ObjectPool *pool, const TPlanNode &tnode, const DescriptorTbl &descs);
@@ -64,6 +70,17 @@ private:
     uint64_t _build_rows = 0;
     uint64_t _total_mem_usage = 0;
 
+    // Set if the conjuncts have inequality conditions "left_expr op right_expr", the build
+    // blocks are then merged into one block indexed on the right exprs.
+    std::unique_ptr<InequalityJoin> _inequality_join;
+    std::vector<VExpr*> _left_inequality_exprs;
+    std::vector<VExpr*> _right_inequality_exprs;
+    std::vector<InequalityJoin::Op> _inequality_ops;
+    bool _left_block_probed = false;
+    std::vector<uint32_t> _probe_rows;
+    std::vector<uint32_t> _matched_build_rows;
+    RuntimeProfile::Counter* _inequality_candidates_counter = nullptr;
+
     // Build mutable columns to insert data.
     // if block can mem reuse, just clear data in block
     // else build a new block and alloc mem of column from left and right child block
@@ -74,6 +91,15 @@ private:
     //  now_process_build_block: right child block now to process
     void process_left_child_block(MutableColumns& dst_columns, const Block& now_process_build_block);
 
+    // Collects the inequality conditions of the ANDed conjuncts, at most two of them.
+    void collect_inequality_conditions(VExpr* expr);
+    // Merges the build blocks and builds _inequality_join on them.
+    Status build_inequality_join();
+    // Probes _inequality_join with the current left block.
+    Status probe_inequality_join();
+    // Appends the candidate pairs in _probe_rows and _matched_build_rows.
+    void process_inequality_pairs(MutableColumns& dst_columns);
+
     // Returns a debug string for _build_rows. This is used for debugging during the
     // build list construction and before doing the join.
     std::string build_list_debug_string();
@@ -94,6 +94,10 @@ Status VExchangeNode::get_next(RuntimeState* state, Block* block, bool* eos) {
     return status;
 }
 
+bool VExchangeNode::ready_to_read() const {
+    return _stream_recvr->ready_to_read();
+}
+
 Status VExchangeNode::close(RuntimeState* state) {
     if (_stream_recvr != nullptr) {
         _stream_recvr->close();
@@ -41,6 +41,9 @@ public:
     // Status collect_query_statistics(QueryStatistics* statistics) override;
     void set_num_senders(int num_senders) { _num_senders = num_senders; }
 
+    // True if get_next() won't wait for the senders.
+    bool ready_to_read() const;
+
 private:
     int _num_senders;
     bool _is_merging;
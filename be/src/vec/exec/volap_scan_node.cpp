@@ -18,6 +18,7 @@
 #include "vec/exec/volap_scan_node.h"
 
 #include "gen_cpp/PlanNodes_types.h"
+#include "pipeline/task_scheduler.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
 #include "runtime/runtime_filter_mgr.h"
@@ -48,6 +49,17 @@ void VOlapScanNode::transfer_thread(RuntimeState* state) {
             }
         }
     }
+    if (status.ok() && !_runtime_filter_vexpr_ctxs.empty()) {
+        for (auto scanner : _volap_scanners) {
+            status = VExpr::clone_if_not_exists(_runtime_filter_vexpr_ctxs, state,
+                                                scanner->runtime_filter_vexpr_ctxs());
+            if (!status.ok()) {
+                std::lock_guard<SpinLock> guard(_status_mutex);
+                _status = status;
+                break;
+            }
+        }
+    }
 
     /*********************************
      * 优先级调度基本策略:
@@ -124,6 +136,7 @@ void VOlapScanNode::transfer_thread(RuntimeState* state) {
     VLOG_CRITICAL << "TransferThread finish.";
     _transfer_done = true;
     _block_added_cv.notify_all();
+    pipeline::wake_up_blocked_tasks();
     {
         std::unique_lock<std::mutex> l(_scan_blocks_lock);
         _scan_thread_exit_cv.wait(l, [this] { return _running_thread == 0; });
@@ -151,10 +164,12 @@ void VOlapScanNode::scanner_thread(VOlapScanner* scanner) {
         scanner->set_opened();
     }
 
-    std::vector<ExprContext*> contexts;
+    // The runtime filters which arrive after the scan is started can't be pushed down to the
+    // storage engine any more, every scanner applies them on its blocks.
+    std::vector<VExprContext*> contexts;
     auto& scanner_filter_apply_marks = *scanner->mutable_runtime_filter_marks();
     DCHECK(scanner_filter_apply_marks.size() == _runtime_filter_descs.size());
-    for (size_t i = 0; i < scanner_filter_apply_marks.size(); i++) {
+    for (size_t i = 0; status.ok() && i < scanner_filter_apply_marks.size(); i++) {
         if (!scanner_filter_apply_marks[i] && !_runtime_filter_ctxs[i].apply_mark) {
             IRuntimeFilter* runtime_filter = nullptr;
             state->runtime_filter_mgr()->get_consume_filter(_runtime_filter_descs[i].filter_id,
@@ -162,19 +177,24 @@ void VOlapScanNode::scanner_thread(VOlapScanner* scanner) {
             DCHECK(runtime_filter != nullptr);
             bool ready = runtime_filter->is_ready();
             if (ready) {
-                runtime_filter->get_prepared_context(&contexts, row_desc(), _expr_mem_tracker);
-                _runtime_filter_ctxs[i].apply_mark = true;
+                status = runtime_filter->get_prepared_vexpr_ctxs(&contexts, row_desc(),
+                                                                 _expr_mem_tracker);
+                scanner_filter_apply_marks[i] = true;
             }
         }
     }
 
-    if (!contexts.empty()) {
-        std::vector<ExprContext*> new_contexts;
-        auto& scanner_conjunct_ctxs = *scanner->conjunct_ctxs();
-        Expr::clone_if_not_exists(contexts, state, &new_contexts);
-        scanner_conjunct_ctxs.insert(scanner_conjunct_ctxs.end(), new_contexts.begin(),
-                                     new_contexts.end());
-        scanner->set_use_pushdown_conjuncts(true);
+    if (status.ok() && !contexts.empty()) {
+        std::vector<VExprContext*> new_contexts;
+        status = VExpr::clone_if_not_exists(contexts, state, &new_contexts);
+        auto& scanner_filter_ctxs = *scanner->runtime_filter_vexpr_ctxs();
+        scanner_filter_ctxs.insert(scanner_filter_ctxs.end(), new_contexts.begin(),
+                                   new_contexts.end());
+    }
+    if (!status.ok()) {
+        std::lock_guard<SpinLock> guard(_status_mutex);
+        _status = status;
+        eos = true;
     }
 
     std::vector<Block*> blocks;
@@ -281,14 +301,45 @@ Status VOlapScanNode::_add_blocks(std::vector<Block*>& block) {
     }
     // remove one block, notify main thread
     _block_added_cv.notify_one();
+    pipeline::wake_up_blocked_tasks();
     return Status::OK();
 }
 
+Status VOlapScanNode::_init_runtime_filter_vexprs(RuntimeState* state) {
+    for (auto& filter_ctx : _runtime_filter_ctxs) {
+        if (!filter_ctx.apply_mark) {
+            continue;
+        }
+        // whether the conjuncts of the filter are pushed down, in the order they are created
+        std::vector<bool> pushed;
+        for (const auto& [conjunct_id, ctx] : _conjunctid_to_runtime_filter_ctxs) {
+            if (ctx == &filter_ctx) {
+                pushed.push_back(_pushed_conjuncts_index.count(conjunct_id) > 0);
+            }
+        }
+        if (std::all_of(pushed.begin(), pushed.end(), [](bool p) { return p; })) {
+            continue;
+        }
+        std::vector<VExprContext*> vexpr_ctxs;
+        RETURN_IF_ERROR(filter_ctx.runtimefilter->get_push_vexpr_ctxs(&vexpr_ctxs));
+        DCHECK_EQ(vexpr_ctxs.size(), pushed.size());
+        for (size_t i = 0; i < vexpr_ctxs.size() && i < pushed.size(); ++i) {
+            if (!pushed[i]) {
+                _runtime_filter_vexpr_ctxs.push_back(vexpr_ctxs[i]);
+            }
+        }
+    }
+    RETURN_IF_ERROR(
+            VExpr::prepare(_runtime_filter_vexpr_ctxs, state, row_desc(), _expr_mem_tracker));
+    return VExpr::open(_runtime_filter_vexpr_ctxs, state);
+}
+
 Status VOlapScanNode::start_scan_thread(RuntimeState* state) {
     if (_scan_ranges.empty()) {
         _transfer_done = true;
         return Status::OK();
     }
+    RETURN_IF_ERROR(_init_runtime_filter_vexprs(state));
 
     // ranges constructed from scan keys
     std::vector<std::unique_ptr<OlapScanRange>> cond_ranges;
@@ -396,11 +447,38 @@ Status VOlapScanNode::close(RuntimeState* state) {
         DCHECK(runtime_filter != nullptr);
         runtime_filter->consumer_close();
     }
+    VExpr::close(_runtime_filter_vexpr_ctxs, state);
 
     VLOG_CRITICAL << "VOlapScanNode::close()";
     return ScanNode::close(state);
 }
 
+Status VOlapScanNode::start(RuntimeState* state) {
+    if (_start) {
+        return Status::OK();
+    }
+    // the runtime filters which became ready after open()
+    RETURN_IF_ERROR(acquire_runtime_filters(state, false));
+    Status status = start_scan(state);
+    if (!status.ok()) {
+        LOG(ERROR) << "StartScan Failed cause " << status.get_error_msg();
+        return status;
+    }
+    _start = true;
+    return Status::OK();
+}
+
+bool VOlapScanNode::ready_to_read() {
+    if (!_start) {
+        return runtime_filters_ready_or_timeout();
+    }
+    if (_eos) {
+        return true;
+    }
+    std::lock_guard<std::mutex> l(_blocks_lock);
+    return !_materialized_blocks.empty() || _transfer_done;
+}
+
 Status VOlapScanNode::get_next(RuntimeState* state, Block* block, bool* eos) {
     RETURN_IF_ERROR(exec_debug_action(TExecNodePhase::GETNEXT));
     SCOPED_TIMER(_runtime_profile->total_time_counter());
@@ -418,15 +496,11 @@ Status VOlapScanNode::get_next(RuntimeState* state, Block* block, bool* eos) {
 
     // check if started.
     if (!_start) {
-        Status status = start_scan(state);
-
+        Status status = start(state);
         if (!status.ok()) {
-            LOG(ERROR) << "StartScan Failed cause " << status.get_error_msg();
             *eos = true;
             return status;
         }
-
-        _start = true;
     }
 
     // some conjuncts will be disposed in start_scan function, so
@@ -39,10 +39,22 @@ public:
     }
     Status get_next(RuntimeState* state, Block* block, bool* eos) override;
     Status close(RuntimeState* state) override;
+
+    // Start the scanners if they are not started, get_next() starts them on the first call
+    // otherwise. Used by the pipeline engine to start scanning without waiting for data.
+    Status start(RuntimeState* state);
+    bool started() const { return _start; }
+    // True if get_next() won't wait for the scanners. Before the scanners are started, true
+    // if start() won't miss a runtime filter which may still arrive.
+    bool ready_to_read();
+
 private:
     void transfer_thread(RuntimeState* state);
     void scanner_thread(VOlapScanner* scanner);
     Status start_scan_thread(RuntimeState* state) override;
+    // Creates the vectorized exprs of the runtime filters which are not pushed down to the
+    // storage engine, they are evaluated by the scanners.
+    Status _init_runtime_filter_vexprs(RuntimeState* state);
 
     Status _add_blocks(std::vector<Block*>& block);
     int _start_scanner_thread_task(RuntimeState* state, int block_per_scanner);
@@ -61,6 +73,8 @@ private:
     std::mutex _free_blocks_lock;
 
     std::list<VOlapScanner*> _volap_scanners;
+    // cloned to each scanner
+    std::vector<VExprContext*> _runtime_filter_vexpr_ctxs;
     std::mutex _volap_scanners_lock;
 
     int _max_materialized_blocks;
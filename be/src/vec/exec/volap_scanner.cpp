@@ -17,13 +17,14 @@
 
 #include "vec/exec/volap_scanner.h"
 
-#include "vec/columns/column_complex.h"
+#include "vec/columns/column_bitmap.h"
 #include "vec/columns/column_nullable.h"
 #include "vec/columns/column_string.h"
 #include "vec/columns/column_vector.h"
 #include "vec/common/assert_cast.h"
 #include "vec/core/block.h"
 #include "vec/exec/volap_scan_node.h"
+#include "vec/exprs/vexpr.h"
 #include "vec/exprs/vexpr_context.h"
 #include "vec/olap/block_reader.h"
 #include "vec/runtime/vdatetime_value.h"
@@ -61,6 +62,9 @@ Status VOlapScanner::get_block(RuntimeState* state, vectorized::Block* block, bo
         _num_rows_read += block->rows();
         _update_realtime_counter();
 
+        // runtime filters are usually more selective and cheaper than the other conjuncts
+        RETURN_IF_ERROR(VExprContext::filter_block(_runtime_filter_vexpr_ctxs, block,
+                                                   _tuple_desc->slots().size()));
         RETURN_IF_ERROR(
                 VExprContext::filter_block(_vconjunct_ctx, block, _tuple_desc->slots().size()));
     } while (block->rows() == 0 && !(*eof) && raw_rows_read() < raw_rows_threshold);
@@ -68,6 +72,14 @@ Status VOlapScanner::get_block(RuntimeState* state, vectorized::Block* block, bo
     return Status::OK();
 }
 
+Status VOlapScanner::close(RuntimeState* state) {
+    if (_is_closed) {
+        return Status::OK();
+    }
+    VExpr::close(_runtime_filter_vexpr_ctxs, state);
+    return OlapScanner::close(state);
+}
+
 void VOlapScanner::_convert_row_to_block(std::vector<vectorized::MutableColumnPtr>* columns) {
     size_t slots_size = _query_slots.size();
     for (int i = 0; i < slots_size; ++i) {
@@ -134,20 +146,12 @@ void VOlapScanner::_convert_row_to_block(std::vector<vectorized::MutableColumnPt
         }
         case TYPE_OBJECT: {
             Slice* slice = reinterpret_cast<Slice*>(ptr);
-            // insert_default()
             auto* target_column = assert_cast<ColumnBitmap*>(column_ptr);
-
-            target_column->insert_default();
-            BitmapValue* pvalue = nullptr;
-            int pos = target_column->size() - 1;
-            pvalue = &target_column->get_element(pos);
-
             if (slice->size != 0) {
-                BitmapValue value;
-                value.deserialize(slice->data);
-                *pvalue = std::move(value);
+                // the column keeps the serialized bitmap
+                target_column->insert_data(slice->data, slice->size);
             } else {
-                *pvalue = std::move(*reinterpret_cast<BitmapValue*>(slice->data));
+                target_column->insert_value(*reinterpret_cast<BitmapValue*>(slice->data));
             }
             break;
         }
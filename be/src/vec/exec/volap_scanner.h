@@ -39,12 +39,18 @@ public:
         return Status::NotSupported("Not Implemented VOlapScanNode Node::get_next scalar");
     }
 
+    Status close(RuntimeState* state);
+
     VExprContext** vconjunct_ctx_ptr() { return &_vconjunct_ctx; }
 
+    // The runtime filters which are not pushed down to the storage engine.
+    std::vector<VExprContext*>* runtime_filter_vexpr_ctxs() { return &_runtime_filter_vexpr_ctxs; }
+
 private:
     // TODO: Remove this function after we finish reader vec
     void _convert_row_to_block(std::vector<vectorized::MutableColumnPtr>* columns);
     VExprContext* _vconjunct_ctx = nullptr;
+    std::vector<VExprContext*> _runtime_filter_vexpr_ctxs;
 };
 
 } // namespace vectorized
@@ -0,0 +1,208 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/vrepeat_node.h"
+
+#include <fmt/format.h>
+
+#include "gen_cpp/PlanNodes_types.h"
+#include "gutil/strings/join.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+#include "util/runtime_profile.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/exprs/vexpr_context.h"
+
+namespace doris::vectorized {
+
+VRepeatNode::VRepeatNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
+        : ExecNode(pool, tnode, descs),
+          _slot_id_set_list(tnode.repeat_node.slot_id_set_list),
+          _all_slot_ids(tnode.repeat_node.all_slot_ids),
+          _repeat_id_list(tnode.repeat_node.repeat_id_list),
+          _grouping_list(tnode.repeat_node.grouping_list),
+          _output_tuple_id(tnode.repeat_node.output_tuple_id) {}
+
+Status VRepeatNode::prepare(RuntimeState* state) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    RETURN_IF_ERROR(ExecNode::prepare(state));
+    _output_tuple_desc = state->desc_tbl().get_tuple_descriptor(_output_tuple_id);
+    if (_output_tuple_desc == nullptr) {
+        return Status::InternalError("Failed to get tuple descriptor.");
+    }
+    if (_slot_id_set_list.size() != _repeat_id_list.size()) {
+        return Status::InternalError("The size of slot id set list and repeat id list mismatch.");
+    }
+    for (const auto& grouping : _grouping_list) {
+        if (grouping.size() != _repeat_id_list.size()) {
+            return Status::InternalError("The size of grouping list and repeat id list mismatch.");
+        }
+    }
+    if (_grouping_list.size() > _output_tuple_desc->slots().size()) {
+        return Status::InternalError("Too many grouping functions for the output tuple.");
+    }
+
+    // The tuples of this node are the tuples of the child, followed by the output tuple.
+    const auto& child_tuple_descs = child(0)->row_desc().tuple_descriptors();
+    const auto& tuple_descs = row_desc().tuple_descriptors();
+    if (tuple_descs.size() != child_tuple_descs.size() + 1) {
+        return Status::InternalError("The tuples of repeat node mismatch the child.");
+    }
+    for (size_t i = 0; i < child_tuple_descs.size(); ++i) {
+        const auto& child_slots = child_tuple_descs[i]->slots();
+        const auto& slots = tuple_descs[i]->slots();
+        DCHECK_EQ(child_slots.size(), slots.size());
+        for (size_t j = 0; j < child_slots.size(); ++j) {
+            if (!child_slots[j]->is_materialized()) {
+                continue;
+            }
+            DCHECK_EQ(child_slots[j]->type().type, slots[j]->type().type);
+            _child_slots.push_back(child_slots[j]);
+            _output_slots.push_back(slots[j]);
+        }
+    }
+    return Status::OK();
+}
+
+Status VRepeatNode::open(RuntimeState* state) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    RETURN_IF_ERROR(ExecNode::open(state));
+    RETURN_IF_CANCELLED(state);
+    RETURN_IF_ERROR(child(0)->open(state));
+    return Status::OK();
+}
+
+/**
+ * e.g. _repeat_id_list = [0, 3, 1, 2], repeat_id_idx = 2, _grouping_list [[0, 3, 1, 2], [0, 1, 1, 0]],
+ * child block ['a', 'b', 1] -> ['a', const null, 1, const 1, const 1]
+ */
+Status VRepeatNode::get_repeated_block(const Block& child_block, int repeat_id_idx,
+                                       Block* output_block) {
+    DCHECK_LT(repeat_id_idx, _repeat_id_list.size());
+    if (child_block.columns() != _child_slots.size()) {
+        return Status::InternalError(
+                fmt::format("Repeat node expects {} columns from the child, but got {}",
+                            _child_slots.size(), child_block.columns()));
+    }
+    size_t rows = child_block.rows();
+    const std::set<SlotId>& repeat_ids = _slot_id_set_list[repeat_id_idx];
+    output_block->clear();
+
+    for (size_t i = 0; i < _child_slots.size(); ++i) {
+        const SlotDescriptor* slot_desc = _output_slots[i];
+        SlotId slot_id = _child_slots[i]->id();
+        auto data_type = slot_desc->get_data_type_ptr();
+        ColumnPtr column;
+        if (_all_slot_ids.count(slot_id) != 0 && repeat_ids.count(slot_id) == 0) {
+            // set null base on repeated list
+            DCHECK(slot_desc->is_nullable());
+            column = data_type->create_column_const_with_default_value(rows);
+        } else {
+            column = child_block.get_by_position(i).column;
+            if (slot_desc->is_nullable()) {
+                column = make_nullable(column);
+            }
+        }
+        output_block->insert({std::move(column), std::move(data_type), slot_desc->col_name()});
+    }
+
+    // Fill grouping ID to the output tuple
+    for (size_t slot_idx = 0; slot_idx < _grouping_list.size(); ++slot_idx) {
+        const SlotDescriptor* slot_desc = _output_tuple_desc->slots()[slot_idx];
+        auto data_type = slot_desc->get_data_type_ptr();
+        auto column = data_type->create_column_const(
+                rows, Field(Int64(_grouping_list[slot_idx][repeat_id_idx])));
+        output_block->insert({std::move(column), std::move(data_type), slot_desc->col_name()});
+    }
+    return Status::OK();
+}
+
+Status VRepeatNode::get_next_child_block(RuntimeState* state, Block* child_block, bool* eos) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    RETURN_IF_CANCELLED(state);
+    DCHECK(can_be_fused());
+    // the repeated blocks of the last child block are released, the columns are reused
+    child_block->clear_column_data(child(0)->row_desc().num_materialized_slots());
+    RETURN_IF_ERROR(child(0)->get_next(state, child_block, eos));
+    _num_rows_returned += child_block->rows() * _repeat_id_list.size();
+    COUNTER_SET(_rows_returned_counter, _num_rows_returned);
+    return Status::OK();
+}
+
+Status VRepeatNode::get_next(RuntimeState* state, Block* block, bool* eos) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    RETURN_IF_CANCELLED(state);
+    if (reached_limit()) {
+        *eos = true;
+        return Status::OK();
+    }
+
+    // current child block has finished its repeat, get child's next block
+    if (_repeat_id_idx == 0) {
+        // A new block instead of release_block_memory(), the columns of the last block may
+        // still be referenced by the blocks returned to the parent.
+        _child_block.clear();
+        while (_child_block.rows() == 0 && !_child_eos) {
+            RETURN_IF_ERROR(child(0)->get_next(state, &_child_block, &_child_eos));
+        }
+        if (_child_block.rows() == 0) {
+            block->clear();
+            *eos = true;
+            return Status::OK();
+        }
+    }
+
+    RETURN_IF_ERROR(get_repeated_block(_child_block, _repeat_id_idx, block));
+    if (++_repeat_id_idx >= _repeat_id_list.size()) {
+        _child_block.clear();
+        _repeat_id_idx = 0;
+    }
+
+    RETURN_IF_ERROR(VExprContext::filter_block(_vconjunct_ctx_ptr, block, block->columns()));
+    if (_limit != -1 && _limit - _num_rows_returned < block->rows()) {
+        block->set_num_rows(_limit - _num_rows_returned);
+    }
+    _num_rows_returned += block->rows();
+    COUNTER_SET(_rows_returned_counter, _num_rows_returned);
+
+    *eos = reached_limit() || (_child_eos && _repeat_id_idx == 0);
+    return Status::OK();
+}
+
+Status VRepeatNode::close(RuntimeState* state) {
+    if (is_closed()) {
+        return Status::OK();
+    }
+    _child_block.clear();
+    return ExecNode::close(state);
+}
+
+void VRepeatNode::debug_string(int indentation_level, std::stringstream* out) const {
+    *out << std::string(indentation_level * 2, ' ');
+    *out << "VRepeatNode(";
+    *out << "repeat pattern: [" << JoinElements(_repeat_id_list, ",") << "]\n";
+    *out << "add " << _grouping_list.size() << " columns. \n";
+    *out << "added column values: ";
+    for (const std::vector<int64_t>& v : _grouping_list) {
+        *out << "[" << JoinElements(v, ",") << "] ";
+    }
+    *out << "\n";
+    ExecNode::debug_string(indentation_level, out);
+    *out << ")";
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,87 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <set>
+#include <vector>
+
+#include "exec/exec_node.h"
+#include "vec/core/block.h"
+
+namespace doris::vectorized {
+
+// Vectorized RepeatNode for GROUPING SETS, ROLLUP and CUBE. Every child block is returned once
+// for each grouping set. The repeated blocks share the columns of the child block, the slots
+// not in the grouping set are replaced by constant null columns, and the grouping functions
+// (grouping_id, grouping(k)) are appended as constant columns. No rows are copied.
+class VRepeatNode : public ExecNode {
+public:
+    VRepeatNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs);
+    ~VRepeatNode() override = default;
+
+    Status prepare(RuntimeState* state) override;
+    Status open(RuntimeState* state) override;
+    Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) override {
+        return Status::NotSupported("Not Implemented VRepeatNode::get_next.");
+    }
+    Status get_next(RuntimeState* state, Block* block, bool* eos) override;
+    Status close(RuntimeState* state) override;
+
+    // The number of grouping sets, i.e. how many times each child row is repeated.
+    size_t repeat_times() const { return _repeat_id_list.size(); }
+
+    // Whether the parent may skip get_next() and call get_repeated_block() on the child blocks
+    // itself. It can't when the node has its own conjuncts or limit.
+    bool can_be_fused() const { return _vconjunct_ctx_ptr == nullptr && _limit == -1; }
+
+    // Used instead of get_next() when the node is fused into its parent: pulls the next block
+    // of the child into child_block, whose grouping sets the parent builds with
+    // get_repeated_block(). The rows of all the grouping sets are counted as returned by this
+    // node, as get_next() would.
+    Status get_next_child_block(RuntimeState* state, Block* child_block, bool* eos);
+
+    // Builds the block of the repeat_id_idx-th grouping set from child_block. The columns of
+    // child_block are shared, not copied.
+    Status get_repeated_block(const Block& child_block, int repeat_id_idx, Block* output_block);
+
+protected:
+    void debug_string(int indentation_level, std::stringstream* out) const override;
+
+private:
+    // Slot id set used to indicate those slots need to set to null.
+    std::vector<std::set<SlotId>> _slot_id_set_list;
+    // all slot id
+    std::set<SlotId> _all_slot_ids;
+    // An integer bitmap list, it indicates the bit position of the exprs not null.
+    std::vector<int64_t> _repeat_id_list;
+    std::vector<std::vector<int64_t>> _grouping_list;
+    // Tuple id used for output, it has new slots.
+    TupleId _output_tuple_id;
+    const TupleDescriptor* _output_tuple_desc = nullptr;
+
+    // The materialized slots of the child tuples in the order of the block columns, and the
+    // corresponding slots of this node, which may be nullable when the child slots aren't.
+    std::vector<const SlotDescriptor*> _child_slots;
+    std::vector<const SlotDescriptor*> _output_slots;
+
+    Block _child_block;
+    bool _child_eos = false;
+    int _repeat_id_idx = 0;
+};
+
+} // namespace doris::vectorized
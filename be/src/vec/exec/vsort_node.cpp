@@ -18,6 +18,7 @@
 #include "vec/exec/vsort_node.h"
 
 #include "exec/sort_exec_exprs.h"
+#include "runtime/mem_tracker.h"
 #include "runtime/row_batch.h"
 #include "runtime/runtime_state.h"
 #include "util/debug_util.h"
@@ -48,10 +49,16 @@ Status VSortNode::prepare(RuntimeState* state) {
     return Status::OK();
 }
 
-Status VSortNode::open(RuntimeState* state) {
+Status VSortNode::alloc_resource(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
     RETURN_IF_ERROR(ExecNode::open(state));
     RETURN_IF_ERROR(_vsort_exec_exprs.open(state));
+    return Status::OK();
+}
+
+Status VSortNode::open(RuntimeState* state) {
+    RETURN_IF_ERROR(alloc_resource(state));
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
     RETURN_IF_CANCELLED(state);
     RETURN_IF_ERROR(state->check_query_state("vsort, while open."));
     RETURN_IF_ERROR(child(0)->open(state));
@@ -75,7 +82,10 @@ Status VSortNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eos)
 
 Status VSortNode::get_next(RuntimeState* state, Block* block, bool* eos) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    return pull(state, block, eos);
+}
 
+Status VSortNode::pull(RuntimeState* state, Block* block, bool* eos) {
     auto status = Status::OK();
     if (_sorted_blocks.empty()) {
         *eos = true;
@@ -125,48 +135,58 @@ Status VSortNode::sort_input(RuntimeState* state) {
     do {
         Block block;
         RETURN_IF_ERROR(child(0)->get_next(state, &block, &eos));
-        auto rows = block.rows();
-
-        if (rows != 0) {
-            RETURN_IF_ERROR(pretreat_block(block));
-            size_t mem_usage = block.allocated_bytes();
-
-            // dispose TOP-N logic
-            if (_limit != -1 ) {
-                // Here is a little opt to reduce the mem uasge, we build a max heap
-                // to order the block in _block_priority_queue.
-                // if one block totally greater the heap top of _block_priority_queue
-                // we can throw the block data directly.
-                if (_num_rows_in_block < _limit) {
+        RETURN_IF_ERROR(sink(state, &block, eos));
+    } while (!eos);
+
+    return Status::OK();
+}
+
+Status VSortNode::sink(RuntimeState* state, Block* input_block, bool eos) {
+    SCOPED_SWITCH_THREAD_MEM_TRACKER(_mem_tracker);
+    auto rows = input_block->rows();
+    if (rows != 0) {
+        RETURN_IF_ERROR(pretreat_block(*input_block));
+        size_t mem_usage = input_block->allocated_bytes();
+
+        // dispose TOP-N logic
+        if (_limit != -1) {
+            // Here is a little opt to reduce the mem uasge, we build a max heap
+            // to order the block in _block_priority_queue.
+            // if one block totally greater the heap top of _block_priority_queue
+            // we can throw the block data directly.
+            if (_num_rows_in_block < _limit) {
+                _total_mem_usage += mem_usage;
+                _sorted_blocks.emplace_back(std::move(*input_block));
+                _num_rows_in_block += rows;
+                _block_priority_queue.emplace(
+                        _pool->add(new SortCursorImpl(_sorted_blocks.back(), _sort_description)));
+            } else {
+                SortBlockCursor block_cursor(
+                        _pool->add(new SortCursorImpl(*input_block, _sort_description)));
+                if (!block_cursor.totally_greater(_block_priority_queue.top())) {
+                    _sorted_blocks.emplace_back(std::move(*input_block));
+                    _block_priority_queue.push(block_cursor);
                     _total_mem_usage += mem_usage;
-                    _sorted_blocks.emplace_back(std::move(block));
-                    _num_rows_in_block += rows;
-                    _block_priority_queue.emplace(
-                            _pool->add(new SortCursorImpl(_sorted_blocks.back(), _sort_description)));
                 } else {
-                    SortBlockCursor block_cursor(
-                            _pool->add(new SortCursorImpl(block, _sort_description)));
-                    if (!block_cursor.totally_greater(_block_priority_queue.top())) {
-                        _sorted_blocks.emplace_back(std::move(block));
-                        _block_priority_queue.push(block_cursor);
-                        _total_mem_usage += mem_usage;
-                    } else {
-                        continue;
-                    }
+                    mem_usage = 0;
                 }
-            } else {
-                // dispose normal sort logic
-                _total_mem_usage += mem_usage;
-                _sorted_blocks.emplace_back(std::move(block));
             }
+        } else {
+            // dispose normal sort logic
+            _total_mem_usage += mem_usage;
+            _sorted_blocks.emplace_back(std::move(*input_block));
+        }
 
-            _mem_tracker->Consume(mem_usage);
+        if (mem_usage > 0) {
+            _mem_tracker->CacheConsume(mem_usage);
             RETURN_IF_CANCELLED(state);
             RETURN_IF_ERROR(state->check_query_state("vsort, while sorting input."));
         }
-    } while (!eos);
+    }
 
-    build_merge_tree();
+    if (eos) {
+        build_merge_tree();
+    }
     return Status::OK();
 }
 
@@ -51,6 +51,14 @@ public:
 
     virtual Status close(RuntimeState *state);
 
+    // The methods below are used by the pipeline engine, which feeds the input with sink()
+    // and reads the sorted result with pull().
+
+    // Open the sort expressions, but not the child.
+    Status alloc_resource(RuntimeState* state);
+    Status sink(RuntimeState* state, Block* input_block, bool eos);
+    Status pull(RuntimeState* state, Block* block, bool* eos);
+
 protected:
     virtual void debug_string(int indentation_level, std::stringstream *out) const;
 
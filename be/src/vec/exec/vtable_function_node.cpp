@@ -0,0 +1,295 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/vtable_function_node.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+#include "util/runtime_profile.h"
+#include "vec/exprs/table_function/table_function.h"
+#include "vec/exprs/table_function/table_function_factory.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/exprs/vexpr_context.h"
+
+namespace doris::vectorized {
+
+VTableFunctionNode::VTableFunctionNode(ObjectPool* pool, const TPlanNode& tnode,
+                                       const DescriptorTbl& descs)
+        : ExecNode(pool, tnode, descs) {}
+
+Status VTableFunctionNode::init(const TPlanNode& tnode, RuntimeState* state) {
+    RETURN_IF_ERROR(ExecNode::init(tnode, state));
+    for (const TExpr& texpr : tnode.table_function_node.fnCallExprList) {
+        VExprContext* ctx = nullptr;
+        RETURN_IF_ERROR(VExpr::create_expr_tree(_pool, texpr, &ctx));
+        // Only the arguments are executed, the table function itself isn't a function of
+        // the SimpleFunctionFactory.
+        VExpr* root = ctx->root();
+        TableFunction* fn = nullptr;
+        RETURN_IF_ERROR(TableFunctionFactory::get_fn(root->fn_name(), _pool, &fn));
+        _fns.push_back(fn);
+        VExprContexts arg_ctxs;
+        for (VExpr* child : root->children()) {
+            arg_ctxs.push_back(_pool->add(new VExprContext(child)));
+        }
+        _fn_arg_ctxs.push_back(std::move(arg_ctxs));
+    }
+    for (TSlotId slot_id : tnode.table_function_node.outputSlotIds) {
+        _output_slot_ids.insert(slot_id);
+    }
+    _fn_sizes.resize(_fns.size());
+    return Status::OK();
+}
+
+Status VTableFunctionNode::prepare(RuntimeState* state) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    RETURN_IF_ERROR(ExecNode::prepare(state));
+    _child_rows_counter = ADD_COUNTER(runtime_profile(), "ChildRows", TUnit::UNIT);
+    _table_function_timer = ADD_TIMER(runtime_profile(), "TableFunctionTime");
+
+    for (auto& arg_ctxs : _fn_arg_ctxs) {
+        RETURN_IF_ERROR(
+                VExpr::prepare(arg_ctxs, state, child(0)->row_desc(), expr_mem_tracker()));
+    }
+
+    // The tuples of this node are the tuples of the child, followed by a lateral tuple of
+    // one slot for each function.
+    const auto& child_tuple_descs = child(0)->row_desc().tuple_descriptors();
+    const auto& tuple_descs = row_desc().tuple_descriptors();
+    if (tuple_descs.size() != child_tuple_descs.size() + _fns.size()) {
+        return Status::InternalError("The tuples of table function node mismatch the child.");
+    }
+    for (const TupleDescriptor* tuple_desc : child_tuple_descs) {
+        for (const SlotDescriptor* slot : tuple_desc->slots()) {
+            if (slot->is_materialized()) {
+                _child_slots.push_back(slot);
+            }
+        }
+    }
+    for (size_t i = 0; i < _fns.size(); ++i) {
+        const auto& slots = tuple_descs[child_tuple_descs.size() + i]->slots();
+        if (slots.size() != 1) {
+            return Status::InternalError(
+                    fmt::format("The lateral view of {} should have one slot, but got {}",
+                                _fns[i]->name(), slots.size()));
+        }
+        const SlotDescriptor* slot = slots[0];
+        _lateral_slots.push_back(slot->is_materialized() ? slot : nullptr);
+        _single_value_columns.push_back(slot->get_data_type_ptr()->create_column());
+    }
+    return Status::OK();
+}
+
+Status VTableFunctionNode::open(RuntimeState* state) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    RETURN_IF_ERROR(ExecNode::open(state));
+    RETURN_IF_CANCELLED(state);
+    for (auto& arg_ctxs : _fn_arg_ctxs) {
+        RETURN_IF_ERROR(VExpr::open(arg_ctxs, state));
+    }
+    RETURN_IF_ERROR(child(0)->open(state));
+    return Status::OK();
+}
+
+Status VTableFunctionNode::_fetch_child_block(RuntimeState* state) {
+    // A new block instead of release_block_memory(), the argument columns are appended to it.
+    _child_block.clear();
+    while (_child_block.rows() == 0 && !_child_eos) {
+        RETURN_IF_ERROR(child(0)->get_next(state, &_child_block, &_child_eos));
+    }
+    if (_child_block.rows() == 0) {
+        return Status::OK();
+    }
+    if (_child_block.columns() != _child_slots.size()) {
+        return Status::InternalError(
+                fmt::format("Table function node expects {} columns from the child, but got {}",
+                            _child_slots.size(), _child_block.columns()));
+    }
+    COUNTER_UPDATE(_child_rows_counter, _child_block.rows());
+
+    SCOPED_TIMER(_table_function_timer);
+    for (size_t i = 0; i < _fns.size(); ++i) {
+        Columns args;
+        for (VExprContext* ctx : _fn_arg_ctxs[i]) {
+            int result_column_id = -1;
+            RETURN_IF_ERROR(ctx->execute(&_child_block, &result_column_id));
+            args.push_back(_child_block.get_by_position(result_column_id).column);
+        }
+        RETURN_IF_ERROR(_fns[i]->process_init(args));
+    }
+    _cur_row = 0;
+    _cur_row_processed = false;
+    return Status::OK();
+}
+
+/**
+ * e.g. the functions produce [a, b] and [1, 2, 3] for a child row, the positions 0 to 5 are
+ * (a, 1), (a, 2), (a, 3), (b, 1), (b, 2), (b, 3). The last function is read by ranges of
+ * consecutive values, the value of the others is read once and repeated.
+ */
+void VTableFunctionNode::_append_values(size_t begin, size_t end,
+                                        MutableColumns& lateral_columns) {
+    size_t stride = 1;
+    for (int i = _fns.size() - 1; i >= 0; --i) {
+        const size_t size = _fn_sizes[i];
+        if (_lateral_slots[i] != nullptr) {
+            IColumn* column = lateral_columns[i].get();
+            for (size_t pos = begin; pos < end;) {
+                size_t idx = (pos / stride) % size;
+                if (stride == 1) {
+                    size_t length = std::min(size - idx, end - pos);
+                    _fns[i]->get_values(idx, length, column);
+                    pos += length;
+                } else {
+                    size_t length = std::min(stride - pos % stride, end - pos);
+                    _single_value_columns[i]->clear();
+                    _fns[i]->get_values(idx, 1, _single_value_columns[i].get());
+                    column->insert_many_from(*_single_value_columns[i], 0, length);
+                    pos += length;
+                }
+            }
+        }
+        stride *= size;
+    }
+}
+
+Status VTableFunctionNode::get_next(RuntimeState* state, Block* block, bool* eos) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    // the child rows of a block may produce no values, or the rows may be filtered out by the
+    // conjuncts, an empty block is returned only at the end
+    do {
+        RETURN_IF_CANCELLED(state);
+        RETURN_IF_ERROR(_expand_child_rows(state, block, eos));
+    } while (block->rows() == 0 && !*eos);
+    return Status::OK();
+}
+
+Status VTableFunctionNode::_expand_child_rows(RuntimeState* state, Block* block, bool* eos) {
+    block->clear();
+    if (reached_limit()) {
+        *eos = true;
+        return Status::OK();
+    }
+
+    if (_cur_row >= _child_block.rows()) {
+        RETURN_IF_ERROR(_fetch_child_block(state));
+        if (_child_block.rows() == 0) {
+            *eos = true;
+            return Status::OK();
+        }
+    }
+
+    MutableColumns lateral_columns;
+    for (const auto& column : _single_value_columns) {
+        lateral_columns.push_back(column->clone_empty());
+    }
+    // the number of output rows up to each child row in [begin_row, _cur_row]
+    IColumn::Offsets offsets;
+    const size_t begin_row = _cur_row;
+    const size_t batch_size = state->batch_size();
+    size_t num_rows = 0;
+    {
+        SCOPED_TIMER(_table_function_timer);
+        while (_cur_row < _child_block.rows() && num_rows < batch_size) {
+            if (!_cur_row_processed) {
+                _cur_row_size = 1;
+                for (size_t i = 0; i < _fns.size(); ++i) {
+                    _fn_sizes[i] = _fns[i]->process_row(_cur_row);
+                    _cur_row_size *= _fn_sizes[i];
+                }
+                _cur_offset = 0;
+                _cur_row_processed = true;
+            }
+            size_t length = std::min(_cur_row_size - _cur_offset, batch_size - num_rows);
+            if (length > 0) {
+                _append_values(_cur_offset, _cur_offset + length, lateral_columns);
+            }
+            num_rows += length;
+            _cur_offset += length;
+            offsets.push_back(num_rows);
+            if (_cur_offset < _cur_row_size) {
+                // the rest of the row is returned by the next call
+                break;
+            }
+            ++_cur_row;
+            _cur_row_processed = false;
+        }
+    }
+
+    for (size_t i = 0; i < _child_slots.size(); ++i) {
+        const SlotDescriptor* slot = _child_slots[i];
+        auto data_type = slot->get_data_type_ptr();
+        ColumnPtr column;
+        if (!_output_slot_ids.empty() && _output_slot_ids.count(slot->id()) == 0) {
+            // the slot is neither output nor used by the conjuncts
+            column = data_type->create_column_const_with_default_value(num_rows);
+        } else {
+            column = _child_block.get_by_position(i).column;
+            if (begin_row != 0 || offsets.size() != column->size()) {
+                column = column->cut(begin_row, offsets.size());
+            }
+            column = column->replicate(offsets);
+        }
+        block->insert({std::move(column), std::move(data_type), slot->col_name()});
+    }
+    for (size_t i = 0; i < _fns.size(); ++i) {
+        const SlotDescriptor* slot = _lateral_slots[i];
+        if (slot != nullptr) {
+            block->insert({std::move(lateral_columns[i]), slot->get_data_type_ptr(),
+                           slot->col_name()});
+        }
+    }
+
+    RETURN_IF_ERROR(VExprContext::filter_block(_vconjunct_ctx_ptr, block, block->columns()));
+    if (_limit != -1 && _limit - _num_rows_returned < block->rows()) {
+        block->set_num_rows(_limit - _num_rows_returned);
+    }
+    _num_rows_returned += block->rows();
+    COUNTER_SET(_rows_returned_counter, _num_rows_returned);
+
+    *eos = reached_limit() || (_child_eos && _cur_row >= _child_block.rows());
+    return Status::OK();
+}
+
+Status VTableFunctionNode::close(RuntimeState* state) {
+    if (is_closed()) {
+        return Status::OK();
+    }
+    for (auto& arg_ctxs : _fn_arg_ctxs) {
+        VExpr::close(arg_ctxs, state);
+    }
+    _child_block.clear();
+    return ExecNode::close(state);
+}
+
+void VTableFunctionNode::debug_string(int indentation_level, std::stringstream* out) const {
+    *out << std::string(indentation_level * 2, ' ');
+    *out << "VTableFunctionNode(functions: [";
+    for (size_t i = 0; i < _fns.size(); ++i) {
+        *out << (i == 0 ? "" : ", ") << _fns[i]->name();
+    }
+    *out << "]\n";
+    ExecNode::debug_string(indentation_level, out);
+    *out << ")";
+}
+
+} // namespace doris::vectorized
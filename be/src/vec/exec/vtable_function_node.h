@@ -0,0 +1,93 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <set>
+#include <vector>
+
+#include "exec/exec_node.h"
+#include "vec/core/block.h"
+
+namespace doris::vectorized {
+
+class TableFunction;
+class VExprContext;
+
+// Vectorized TableFunctionNode for LATERAL VIEW. Each child row is joined with the values
+// produced for it by the table functions, several functions produce the Cartesian product of
+// their values. A row producing no value is dropped.
+// The child columns are expanded with IColumn::replicate() by the offsets of the output rows
+// of each child row. The values are read lazily by ranges, so a child row producing many
+// values is spread over several blocks and no block exceeds the batch size.
+class VTableFunctionNode : public ExecNode {
+public:
+    VTableFunctionNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs);
+    ~VTableFunctionNode() override = default;
+
+    Status init(const TPlanNode& tnode, RuntimeState* state = nullptr) override;
+    Status prepare(RuntimeState* state) override;
+    Status open(RuntimeState* state) override;
+    Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) override {
+        return Status::NotSupported("Not Implemented VTableFunctionNode::get_next.");
+    }
+    Status get_next(RuntimeState* state, Block* block, bool* eos) override;
+    Status close(RuntimeState* state) override;
+
+protected:
+    void debug_string(int indentation_level, std::stringstream* out) const override;
+
+private:
+    using VExprContexts = std::vector<VExprContext*>;
+
+    // Fetches the next non empty child block, and initializes the functions with it.
+    Status _fetch_child_block(RuntimeState* state);
+    // Returns the output rows of the next child rows, at most a batch of them, may be empty.
+    Status _expand_child_rows(RuntimeState* state, Block* block, bool* eos);
+    // Appends the values of the positions [begin, end) of the current child row to the
+    // lateral columns, the positions enumerate the Cartesian product of the values.
+    void _append_values(size_t begin, size_t end, MutableColumns& lateral_columns);
+
+    std::vector<TableFunction*> _fns;
+    // the argument exprs of each function
+    std::vector<VExprContexts> _fn_arg_ctxs;
+    // the slots output by this node, all slots if it's empty
+    std::set<SlotId> _output_slot_ids;
+
+    // The materialized slots of the child, in the order of the child block columns, and the
+    // lateral slot of each function, nullptr if it isn't materialized.
+    std::vector<const SlotDescriptor*> _child_slots;
+    std::vector<const SlotDescriptor*> _lateral_slots;
+    // a column of one value of each lateral slot, to repeat the values of the functions
+    // other than the last one
+    MutableColumns _single_value_columns;
+
+    Block _child_block;
+    bool _child_eos = false;
+    size_t _cur_row = 0;
+    // The current child row is processed, with _cur_row_size output rows, of which the first
+    // _cur_offset are returned.
+    bool _cur_row_processed = false;
+    std::vector<size_t> _fn_sizes;
+    size_t _cur_row_size = 0;
+    size_t _cur_offset = 0;
+
+    RuntimeProfile::Counter* _child_rows_counter;
+    RuntimeProfile::Counter* _table_function_timer;
+};
+
+} // namespace doris::vectorized
@@ -0,0 +1,91 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/window_segment_tree.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace doris::vectorized {
+
+WindowSegmentTree::WindowSegmentTree(const IAggregateFunction* function) : _function(function) {
+    // every node is aligned as the first one allocated by new[]
+    size_t align = _function->align_of_data();
+    DCHECK_LE(align, alignof(std::max_align_t));
+    _state_size = (_function->size_of_data() + align - 1) / align * align;
+}
+
+void WindowSegmentTree::build(const IColumn** columns, int64_t begin, int64_t end, Arena* arena) {
+    clear();
+    _begin = begin;
+    _end = end;
+    if (begin >= end) {
+        return;
+    }
+    const size_t rows = end - begin;
+    _leaves = 1;
+    while (_leaves < rows) {
+        _leaves <<= 1;
+    }
+    _states.reset(new char[2 * _leaves * _state_size]);
+    for (size_t i = 0; i < _leaves; ++i) {
+        _function->create(_node(_leaves + i));
+        if (i < rows) {
+            _function->add(_node(_leaves + i), columns, begin + i, arena);
+        }
+    }
+    for (size_t i = _leaves - 1; i > 0; --i) {
+        _function->create(_node(i));
+        _function->merge(_node(i), _node(2 * i), arena);
+        _function->merge(_node(i), _node(2 * i + 1), arena);
+    }
+}
+
+void WindowSegmentTree::merge_frame(AggregateDataPtr place, int64_t frame_start,
+                                    int64_t frame_end, Arena* arena) {
+    frame_start = std::max(frame_start, _begin);
+    frame_end = std::min(frame_end, _end);
+    if (frame_start >= frame_end) {
+        return;
+    }
+    size_t l = frame_start - _begin + _leaves;
+    size_t r = frame_end - _begin + _leaves;
+    _right_nodes.clear();
+    for (; l < r; l >>= 1, r >>= 1) {
+        if (l & 1) {
+            _function->merge(place, _node(l++), arena);
+        }
+        if (r & 1) {
+            _right_nodes.push_back(--r);
+        }
+    }
+    for (auto it = _right_nodes.rbegin(); it != _right_nodes.rend(); ++it) {
+        _function->merge(place, _node(*it), arena);
+    }
+}
+
+void WindowSegmentTree::clear() {
+    if (_states != nullptr && !_function->has_trivial_destructor()) {
+        for (size_t i = 1; i < 2 * _leaves; ++i) {
+            _function->destroy(_node(i));
+        }
+    }
+    _states.reset();
+    _leaves = 0;
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,61 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "vec/aggregate_functions/aggregate_function.h"
+
+namespace doris::vectorized {
+
+// A segment tree of the aggregate states of the rows of a window partition, for the functions
+// whose states of sub-ranges can be merged in order (IAggregateFunction::is_frame_mergeable()).
+// The state of any frame is made by merging O(log(n)) states of the tree, instead of adding
+// every row of the frame.
+class WindowSegmentTree {
+public:
+    explicit WindowSegmentTree(const IAggregateFunction* function);
+    ~WindowSegmentTree() { clear(); }
+
+    // Builds the tree of the rows [begin, end) of the columns.
+    void build(const IColumn** columns, int64_t begin, int64_t end, Arena* arena);
+
+    // Merges the state of the rows [frame_start, frame_end) into place, the frame is clipped
+    // to the rows of the tree.
+    void merge_frame(AggregateDataPtr place, int64_t frame_start, int64_t frame_end,
+                     Arena* arena);
+
+    void clear();
+
+private:
+    AggregateDataPtr _node(size_t i) const { return _states.get() + i * _state_size; }
+
+    const IAggregateFunction* _function;
+    size_t _state_size;
+    int64_t _begin = 0;
+    int64_t _end = 0;
+    // The number of leaves, a power of two. Node 1 is the root, the children of node i are
+    // node 2i and 2i + 1, and the leaf of row `_begin + j` is node `_leaves + j`.
+    size_t _leaves = 0;
+    std::unique_ptr<char[]> _states;
+    // the nodes on the right side of a frame, they are merged after the left side
+    std::vector<size_t> _right_nodes;
+};
+
+} // namespace doris::vectorized
@@ -0,0 +1,78 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <string>
+
+#include "common/status.h"
+#include "vec/columns/column.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/common/typeid_cast.h"
+
+namespace doris::vectorized {
+
+// A table function produces any number of values for each input row, e.g. the lateral view
+// "explode_split(k1, ',')" produces a row for each part of k1.
+// The values of a row are read by ranges, so that a row producing many values can be spread
+// over several output blocks.
+class TableFunction {
+public:
+    virtual ~TableFunction() = default;
+
+    const std::string& name() const { return _fn_name; }
+
+    // Called for each input block, with the columns of the arguments.
+    virtual Status process_init(const Columns& args) = 0;
+
+    // Computes the values of a row of the current input block, returns the number of them.
+    virtual size_t process_row(size_t row) = 0;
+
+    // Appends the values [offset, offset + length) of the current row to 'column', which is
+    // nullable if the output slot is.
+    virtual void get_values(size_t offset, size_t length, IColumn* column) = 0;
+
+protected:
+    explicit TableFunction(std::string fn_name) : _fn_name(std::move(fn_name)) {}
+
+    // Returns the nested column of 'column' if it's nullable and sets 'null_map' to its null
+    // map, otherwise returns 'column' and sets 'null_map' to nullptr.
+    static IColumn* get_nested_column(IColumn* column, NullMap** null_map) {
+        if (auto* nullable = typeid_cast<ColumnNullable*>(column)) {
+            *null_map = &nullable->get_null_map_data();
+            return &nullable->get_nested_column();
+        }
+        *null_map = nullptr;
+        return column;
+    }
+
+    // Returns the nested column of 'column' if it's nullable and sets 'null_map' to its
+    // null map, or nullptr if it isn't nullable.
+    static const IColumn* get_nested_column(const ColumnPtr& column, const NullMap** null_map) {
+        if (const auto* nullable = check_and_get_column<ColumnNullable>(*column)) {
+            *null_map = &nullable->get_null_map_data();
+            return &nullable->get_nested_column();
+        }
+        *null_map = nullptr;
+        return column.get();
+    }
+
+private:
+    const std::string _fn_name;
+};
+
+} // namespace doris::vectorized
@@ -0,0 +1,45 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exprs/table_function/table_function_factory.h"
+
+#include "common/object_pool.h"
+#include "vec/exprs/table_function/vexplode_bitmap.h"
+#include "vec/exprs/table_function/vexplode_json_array.h"
+#include "vec/exprs/table_function/vexplode_split.h"
+
+namespace doris::vectorized {
+
+Status TableFunctionFactory::get_fn(const std::string& fn_name, ObjectPool* pool,
+                                    TableFunction** fn) {
+    if (fn_name == "explode_split") {
+        *fn = pool->add(new VExplodeSplitTableFunction());
+    } else if (fn_name == "explode_bitmap") {
+        *fn = pool->add(new VExplodeBitmapTableFunction());
+    } else if (fn_name == "explode_json_array_int") {
+        *fn = pool->add(new VExplodeJsonArrayTableFunction<ExplodeJsonArrayType::INT>());
+    } else if (fn_name == "explode_json_array_double") {
+        *fn = pool->add(new VExplodeJsonArrayTableFunction<ExplodeJsonArrayType::DOUBLE>());
+    } else if (fn_name == "explode_json_array_string") {
+        *fn = pool->add(new VExplodeJsonArrayTableFunction<ExplodeJsonArrayType::STRING>());
+    } else {
+        return Status::NotSupported("Table function " + fn_name + " is not supported");
+    }
+    return Status::OK();
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,71 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exprs/table_function/vexplode_bitmap.h"
+
+#include <cstring>
+
+#include "vec/columns/column_bitmap.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/assert_cast.h"
+
+namespace doris::vectorized {
+
+Status VExplodeBitmapTableFunction::process_init(const Columns& args) {
+    DCHECK_EQ(args.size(), 1);
+    _arg = args[0]->convert_to_full_column_if_const();
+    _bitmap_column = get_nested_column(_arg, &_null_map);
+    _values_materialized = false;
+    return Status::OK();
+}
+
+size_t VExplodeBitmapTableFunction::process_row(size_t row) {
+    _cur_row = row;
+    _values_materialized = false;
+    if (_null_map != nullptr && (*_null_map)[row]) {
+        _values.clear();
+        _values_materialized = true;
+        return 0;
+    }
+    // the cardinality of the serialized bitmap, the bitmap is deserialized only if its values
+    // are read
+    return assert_cast<const ColumnBitmap&>(*_bitmap_column).cardinality(row);
+}
+
+void VExplodeBitmapTableFunction::get_values(size_t offset, size_t length, IColumn* column) {
+    if (!_values_materialized) {
+        BitmapValue bitmap =
+                assert_cast<const ColumnBitmap&>(*_bitmap_column).get_element(_cur_row);
+        _values.resize(bitmap.cardinality());
+        BitmapValue::Iterator iter(bitmap);
+        size_t num_read = iter.read(_values.data(), _values.size());
+        DCHECK_EQ(num_read, _values.size());
+        _values_materialized = true;
+    }
+    DCHECK_LE(offset + length, _values.size());
+
+    NullMap* null_map = nullptr;
+    auto& data = assert_cast<ColumnInt64&>(*get_nested_column(column, &null_map)).get_data();
+    size_t old_size = data.size();
+    data.resize(old_size + length);
+    memcpy(data.data() + old_size, _values.data() + offset, length * sizeof(uint64_t));
+    if (null_map != nullptr) {
+        null_map->resize_fill(data.size(), 0);
+    }
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,50 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <vector>
+
+#include "util/bitmap_value.h"
+#include "vec/exprs/table_function/table_function.h"
+
+namespace doris::vectorized {
+
+// explode_bitmap(bitmap): a BIGINT value for each element of the bitmap, in ascending order.
+// The elements are read lazily, a bitmap of any cardinality doesn't need more memory.
+class VExplodeBitmapTableFunction final : public TableFunction {
+public:
+    VExplodeBitmapTableFunction() : TableFunction("explode_bitmap") {}
+
+    Status process_init(const Columns& args) override;
+    size_t process_row(size_t row) override;
+    void get_values(size_t offset, size_t length, IColumn* column) override;
+
+private:
+    ColumnPtr _arg;
+    const IColumn* _bitmap_column = nullptr;
+    const NullMap* _null_map = nullptr;
+
+    // The elements of the current row, materialized by the first get_values() of the row.
+    // With several lateral views the values of a row are read many times, not always in
+    // order.
+    size_t _cur_row = 0;
+    bool _values_materialized = false;
+    std::vector<uint64_t> _values;
+};
+
+} // namespace doris::vectorized
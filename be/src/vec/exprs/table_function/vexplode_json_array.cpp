@@ -0,0 +1,150 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exprs/table_function/vexplode_json_array.h"
+
+#include <rapidjson/document.h>
+
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/assert_cast.h"
+
+namespace doris::vectorized {
+
+namespace {
+
+const char* fn_name_of(ExplodeJsonArrayType type) {
+    switch (type) {
+    case ExplodeJsonArrayType::INT:
+        return "explode_json_array_int";
+    case ExplodeJsonArrayType::DOUBLE:
+        return "explode_json_array_double";
+    case ExplodeJsonArrayType::STRING:
+        return "explode_json_array_string";
+    }
+    __builtin_unreachable();
+}
+
+// Returns false if the element isn't of the type, the output value is null then.
+bool parse_element(const rapidjson::Value& element, Int64* value) {
+    if (element.IsInt64()) {
+        *value = element.GetInt64();
+        return true;
+    }
+    if (element.IsUint64()) {
+        // out of the range of BIGINT
+        return false;
+    }
+    if (element.IsDouble()) {
+        *value = static_cast<Int64>(element.GetDouble());
+        return true;
+    }
+    return false;
+}
+
+bool parse_element(const rapidjson::Value& element, Float64* value) {
+    if (element.IsNumber()) {
+        *value = element.GetDouble();
+        return true;
+    }
+    return false;
+}
+
+bool parse_element(const rapidjson::Value& element, std::string* value) {
+    if (element.IsString()) {
+        value->assign(element.GetString(), element.GetStringLength());
+        return true;
+    }
+    if (element.IsNumber() || element.IsBool()) {
+        // the text of scalars other than null, e.g. [1, true] produces "1" and "true"
+        if (element.IsBool()) {
+            *value = element.GetBool() ? "true" : "false";
+        } else if (element.IsInt64()) {
+            *value = std::to_string(element.GetInt64());
+        } else if (element.IsUint64()) {
+            *value = std::to_string(element.GetUint64());
+        } else {
+            *value = std::to_string(element.GetDouble());
+        }
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+template <ExplodeJsonArrayType type>
+VExplodeJsonArrayTableFunction<type>::VExplodeJsonArrayTableFunction()
+        : TableFunction(fn_name_of(type)) {}
+
+template <ExplodeJsonArrayType type>
+Status VExplodeJsonArrayTableFunction<type>::process_init(const Columns& args) {
+    DCHECK_EQ(args.size(), 1);
+    _arg = args[0]->convert_to_full_column_if_const();
+    _json_column = get_nested_column(_arg, &_null_map);
+    return Status::OK();
+}
+
+template <ExplodeJsonArrayType type>
+size_t VExplodeJsonArrayTableFunction<type>::process_row(size_t row) {
+    _values.clear();
+    _is_null.clear();
+    if (_null_map != nullptr && (*_null_map)[row]) {
+        return 0;
+    }
+
+    StringRef json = _json_column->get_data_at(row);
+    rapidjson::Document document;
+    document.Parse(json.data, json.size);
+    if (document.HasParseError() || !document.IsArray()) {
+        return 0;
+    }
+    const size_t size = document.Size();
+    _values.resize(size);
+    _is_null.resize(size);
+    for (size_t i = 0; i < size; ++i) {
+        _is_null[i] = !parse_element(document[i], &_values[i]);
+    }
+    return size;
+}
+
+template <ExplodeJsonArrayType type>
+void VExplodeJsonArrayTableFunction<type>::get_values(size_t offset, size_t length,
+                                                      IColumn* column) {
+    DCHECK_LE(offset + length, _values.size());
+    NullMap* null_map = nullptr;
+    IColumn* nested = get_nested_column(column, &null_map);
+    if constexpr (type == ExplodeJsonArrayType::STRING) {
+        auto& strings = assert_cast<ColumnString&>(*nested);
+        for (size_t i = offset; i < offset + length; ++i) {
+            strings.insert_data(_values[i].data(), _values[i].size());
+        }
+    } else {
+        auto& data = assert_cast<ColumnVector<ValueType>&>(*nested).get_data();
+        data.insert(_values.data() + offset, _values.data() + offset + length);
+    }
+    // the values of the null elements are defaults, they are kept if the slot isn't nullable
+    if (null_map != nullptr) {
+        null_map->insert(_is_null.data() + offset, _is_null.data() + offset + length);
+    }
+}
+
+template class VExplodeJsonArrayTableFunction<ExplodeJsonArrayType::INT>;
+template class VExplodeJsonArrayTableFunction<ExplodeJsonArrayType::DOUBLE>;
+template class VExplodeJsonArrayTableFunction<ExplodeJsonArrayType::STRING>;
+
+} // namespace doris::vectorized
@@ -0,0 +1,56 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "vec/core/types.h"
+#include "vec/exprs/table_function/table_function.h"
+
+namespace doris::vectorized {
+
+enum class ExplodeJsonArrayType { INT, DOUBLE, STRING };
+
+// explode_json_array_int/double/string(json): a value for each element of a json array.
+// The elements not of the type of the function are null, an input which isn't an array
+// produces no value.
+template <ExplodeJsonArrayType type>
+class VExplodeJsonArrayTableFunction final : public TableFunction {
+public:
+    using ValueType = std::conditional_t<
+            type == ExplodeJsonArrayType::INT, Int64,
+            std::conditional_t<type == ExplodeJsonArrayType::DOUBLE, Float64, std::string>>;
+
+    VExplodeJsonArrayTableFunction();
+
+    Status process_init(const Columns& args) override;
+    size_t process_row(size_t row) override;
+    void get_values(size_t offset, size_t length, IColumn* column) override;
+
+private:
+    ColumnPtr _arg;
+    const IColumn* _json_column = nullptr;
+    const NullMap* _null_map = nullptr;
+
+    std::vector<ValueType> _values;
+    std::vector<UInt8> _is_null;
+};
+
+} // namespace doris::vectorized
@@ -0,0 +1,84 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exprs/table_function/vexplode_split.h"
+
+#include "vec/columns/column_const.h"
+#include "vec/columns/column_string.h"
+#include "vec/common/assert_cast.h"
+
+namespace doris::vectorized {
+
+Status VExplodeSplitTableFunction::process_init(const Columns& args) {
+    DCHECK_EQ(args.size(), 2);
+    _args = args;
+    _const_delimiter = is_column_const(*_args[1]);
+    if (_const_delimiter) {
+        // the searcher of the delimiter is built once
+        _args[1] = assert_cast<const ColumnConst&>(*_args[1]).get_data_column_ptr();
+    }
+    _args[0] = _args[0]->convert_to_full_column_if_const();
+    _str_column = get_nested_column(_args[0], &_str_null_map);
+    _delimiter_column = get_nested_column(_args[1], &_delimiter_null_map);
+    if (_const_delimiter && (_delimiter_null_map == nullptr || !(*_delimiter_null_map)[0])) {
+        _searcher = StringSearcher(_delimiter_column->get_data_at(0).to_string());
+    }
+    return Status::OK();
+}
+
+size_t VExplodeSplitTableFunction::process_row(size_t row) {
+    _parts.clear();
+    size_t delimiter_row = _const_delimiter ? 0 : row;
+    if ((_str_null_map != nullptr && (*_str_null_map)[row]) ||
+        (_delimiter_null_map != nullptr && (*_delimiter_null_map)[delimiter_row])) {
+        return 0;
+    }
+    if (!_const_delimiter) {
+        _searcher = StringSearcher(_delimiter_column->get_data_at(row).to_string());
+    }
+
+    StringRef str = _str_column->get_data_at(row);
+    const char* pos = str.data;
+    const char* end = str.data + str.size;
+    size_t delimiter_size = _searcher.needle_size();
+    if (delimiter_size == 0) {
+        _parts.emplace_back(pos, str.size);
+        return 1;
+    }
+    while (true) {
+        const char* found = _searcher.search(pos, end);
+        _parts.emplace_back(pos, found - pos);
+        if (found == end) {
+            break;
+        }
+        pos = found + delimiter_size;
+    }
+    return _parts.size();
+}
+
+void VExplodeSplitTableFunction::get_values(size_t offset, size_t length, IColumn* column) {
+    NullMap* null_map = nullptr;
+    auto& strings = assert_cast<ColumnString&>(*get_nested_column(column, &null_map));
+    for (size_t i = offset; i < offset + length; ++i) {
+        strings.insert_data(_parts[i].data, _parts[i].size);
+    }
+    if (null_map != nullptr) {
+        null_map->resize_fill(strings.size(), 0);
+    }
+}
+
+} // namespace doris::vectorized
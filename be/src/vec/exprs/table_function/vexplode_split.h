@@ -0,0 +1,49 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <vector>
+
+#include "vec/common/string_ref.h"
+#include "vec/common/string_searcher.h"
+#include "vec/exprs/table_function/table_function.h"
+
+namespace doris::vectorized {
+
+// explode_split(str, delimiter): a value for each part of 'str' split by 'delimiter'.
+class VExplodeSplitTableFunction final : public TableFunction {
+public:
+    VExplodeSplitTableFunction() : TableFunction("explode_split") {}
+
+    Status process_init(const Columns& args) override;
+    size_t process_row(size_t row) override;
+    void get_values(size_t offset, size_t length, IColumn* column) override;
+
+private:
+    Columns _args;
+    const IColumn* _str_column = nullptr;
+    const NullMap* _str_null_map = nullptr;
+    const IColumn* _delimiter_column = nullptr;
+    const NullMap* _delimiter_null_map = nullptr;
+    bool _const_delimiter = false;
+    StringSearcher _searcher;
+
+    std::vector<StringRef> _parts;
+};
+
+} // namespace doris::vectorized
@@ -0,0 +1,57 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+
+#include "exprs/bloomfilter_predicate.h"
+#include "vec/exprs/vexpr.h"
+
+namespace doris::vectorized {
+
+// The vectorized BloomFilterPredicate, only used in runtime filter. The rows of the child
+// are hashed and probed in batches by IBloomFilterFuncBase::find_batch. The result is
+// not nullable, null rows are false.
+class VBloomPredicate final : public VExpr {
+public:
+    VBloomPredicate(const TExprNode& node, const std::shared_ptr<IBloomFilterFuncBase>& filter);
+    VBloomPredicate(const VBloomPredicate& other);
+    ~VBloomPredicate() override = default;
+
+    Status prepare(RuntimeState* state, const RowDescriptor& desc,
+                   VExprContext* context) override;
+    Status execute(VExprContext* context, Block* block, int* result_column_id) override;
+    VExpr* clone(ObjectPool* pool) const override { return pool->add(new VBloomPredicate(*this)); }
+    const std::string& expr_name() const override { return _expr_name; }
+
+private:
+    std::shared_ptr<IBloomFilterFuncBase> _filter;
+    std::string _expr_name;
+
+    // Same as BloomFilterPredicate, the filter is skipped if it filters less than
+    // _expect_filter_rate of the first _loop_size rows. A copy of the expr, e.g. the clone
+    // for another scanner, keeps a decision already made but samples its rows by itself.
+    std::atomic<bool> _always_true {false};
+    std::atomic<bool> _has_calculate_filter {false};
+    std::atomic<int64_t> _filtered_rows {0};
+    std::atomic<int64_t> _scan_rows {0};
+    constexpr static int64_t _loop_size = 8192;
+    constexpr static double _expect_filter_rate = 0.2;
+};
+
+} // namespace doris::vectorized
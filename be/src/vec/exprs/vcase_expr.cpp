@@ -61,6 +61,26 @@ Status VCaseExpr::prepare(doris::RuntimeState* state, const doris::RowDescriptor
     }
 
     VExpr::register_function_context(state, context);
+    init_fingerprint(fmt::format("case{}{}:{}", _has_case_expr, _has_else_expr,
+                                 _data_type->get_name()),
+                     _function->is_deterministic());
+
+    if (!_has_case_expr) {
+        auto result_type = remove_nullable(_data_type);
+        bool has_expensive_branch = false;
+        for (int i = 1; i < _children.size(); i++) {
+            auto child = _children[i];
+            bool is_then = i % 2 == 1 || (_has_else_expr && i == _children.size() - 1);
+            if (is_then && !remove_nullable(child->data_type())->equals(*result_type)) {
+                return Status::OK();
+            }
+            if (!child->is_slot_ref() && child->node_type() != TExprNodeType::NULL_LITERAL &&
+                !child->is_constant()) {
+                has_expensive_branch = true;
+            }
+        }
+        _short_circuit = has_expensive_branch;
+    }
     return Status::OK();
 }
 
@@ -86,6 +106,14 @@ void VCaseExpr::close(RuntimeState* state, VExprContext* context,
 }
 
 Status VCaseExpr::execute(VExprContext* context, Block* block, int* result_column_id) {
+    if (find_cached_result(context, *block, result_column_id)) {
+        return Status::OK();
+    }
+    if (_short_circuit) {
+        RETURN_IF_ERROR(_execute_short_circuit(context, block, result_column_id));
+        cache_result(context, *block, *result_column_id);
+        return Status::OK();
+    }
     ColumnNumbers arguments(_children.size());
 
     for (int i = 0; i < _children.size(); i++) {
@@ -103,7 +131,81 @@ Status VCaseExpr::execute(VExprContext* context, Block* block, int* result_colum
     RETURN_IF_ERROR(_function->execute(context->fn_context(_fn_context_index), *block, arguments,
                                        num_columns_without_result, block->rows(), false));
     *result_column_id = num_columns_without_result;
+    cache_result(context, *block, *result_column_id);
+
+    return Status::OK();
+}
+
+Status VCaseExpr::_execute_short_circuit(VExprContext* context, Block* block,
+                                         int* result_column_id) {
+    const size_t rows = block->rows();
+    const int pair_count = _children.size() / 2;
+
+    // The branch of each row, 0 is ELSE or no match, i is the i-th THEN.
+    std::vector<uint32_t> branch_idx(rows, 0);
+    // Columns of the branches, with the rows of the branch only.
+    std::vector<ColumnPtr> branch_columns(pair_count + 1);
+
+    IColumn::Filter remaining(rows, 1);
+    size_t num_remaining = rows;
+    IColumn::Filter matched(rows);
+    for (int i = 0; i < pair_count && num_remaining > 0; i++) {
+        ColumnPtr when_column;
+        RETURN_IF_ERROR(_children[2 * i]->execute_selected(context, block, remaining,
+                                                           num_remaining, &when_column));
+        when_column = when_column->convert_to_full_column_if_const();
+
+        size_t num_matched = 0;
+        for (size_t row = 0, j = 0; row < rows; row++) {
+            matched[row] = 0;
+            if (!remaining[row]) {
+                continue;
+            }
+            // null is not matched
+            if (!when_column->is_null_at(j) && when_column->get_bool(j)) {
+                matched[row] = 1;
+                remaining[row] = 0;
+                branch_idx[row] = i + 1;
+                num_matched++;
+            }
+            j++;
+        }
+        if (num_matched > 0) {
+            RETURN_IF_ERROR(_children[2 * i + 1]->execute_selected(
+                    context, block, matched, num_matched, &branch_columns[i + 1]));
+            num_remaining -= num_matched;
+        }
+    }
+    if (_has_else_expr && num_remaining > 0) {
+        RETURN_IF_ERROR(_children.back()->execute_selected(context, block, remaining,
+                                                           num_remaining, &branch_columns[0]));
+    }
+
+    const bool result_nullable = _data_type->is_nullable();
+    for (auto& column : branch_columns) {
+        if (column != nullptr) {
+            column = column->convert_to_full_column_if_const();
+            if (result_nullable) {
+                column = make_nullable(column);
+            }
+        }
+    }
+
+    auto result_column = _data_type->create_column();
+    result_column->reserve(rows);
+    std::vector<size_t> branch_row(pair_count + 1, 0);
+    for (size_t row = 0; row < rows; row++) {
+        uint32_t idx = branch_idx[row];
+        if (branch_columns[idx] == nullptr) {
+            // no ELSE, the result is null
+            result_column->insert_default();
+        } else {
+            result_column->insert_from(*branch_columns[idx], branch_row[idx]++);
+        }
+    }
 
+    *result_column_id = block->columns();
+    block->insert({std::move(result_column), _data_type, _expr_name});
     return Status::OK();
 }
 
@@ -38,9 +38,17 @@ public:
     virtual const std::string& expr_name() const override;
 
 private:
+    // Evaluates the WHEN conditions in order, each one only on the rows not matched by
+    // the previous ones, and each THEN/ELSE branch only on the rows it returns.
+    Status _execute_short_circuit(VExprContext* context, Block* block, int* result_column_id);
+
     bool _is_prepare;
     bool _has_case_expr;
     bool _has_else_expr;
+    // Only used for the searched CASE with a branch which is worth skipping, i.e.
+    // not a slot or literal, because building the result row by row costs more than
+    // the SIMD result selection of FunctionCase.
+    bool _short_circuit = false;
 
     FunctionBasePtr _function;
     std::string _function_name = "case";
@@ -53,6 +53,8 @@ doris::Status VCastExpr::prepare(doris::RuntimeState* state, const doris::RowDes
     }
     VExpr::register_function_context(state, context);
     _expr_name = fmt::format("(CAST {}, TO {})", child_name, _target_data_type_name);
+    init_fingerprint(fmt::format("cast:{}", _data_type->get_name()),
+                     _function->is_deterministic());
     return Status::OK();
 }
 
@@ -71,6 +73,9 @@ void VCastExpr::close(doris::RuntimeState* state, VExprContext* context,
 
 doris::Status VCastExpr::execute(VExprContext* context, doris::vectorized::Block* block,
                                  int* result_column_id) {
+    if (find_cached_result(context, *block, result_column_id)) {
+        return Status::OK();
+    }
     // for each child call execute
     doris::vectorized::ColumnNumbers arguments(2);
     int column_id = -1;
@@ -88,6 +93,7 @@ doris::Status VCastExpr::execute(VExprContext* context, doris::vectorized::Block
     _function->execute(context->fn_context(_fn_context_index), *block, arguments,
                        num_columns_without_result, block->rows(), false);
     *result_column_id = num_columns_without_result;
+    cache_result(context, *block, *result_column_id);
     return Status::OK();
 }
 
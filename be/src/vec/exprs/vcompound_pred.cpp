@@ -0,0 +1,154 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exprs/vcompound_pred.h"
+
+#include "util/time.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+
+namespace doris::vectorized {
+
+// Don't reorder the children until both of them have been evaluated on this many rows.
+static constexpr int64_t MIN_ROWS_TO_REORDER = 4096;
+
+double VcompoundPred::ChildStats::rank() const {
+    int64_t num_rows = rows.load(std::memory_order_relaxed);
+    double cost_per_row = double(cost_ns.load(std::memory_order_relaxed)) / num_rows;
+    double decided_ratio = double(decided_rows.load(std::memory_order_relaxed)) / num_rows;
+    return cost_per_row / std::max(decided_ratio, 0.001);
+}
+
+int VcompoundPred::_first_child() const {
+    const auto& stats = *_stats;
+    if (stats[0].rows.load(std::memory_order_relaxed) < MIN_ROWS_TO_REORDER ||
+        stats[1].rows.load(std::memory_order_relaxed) < MIN_ROWS_TO_REORDER) {
+        return 0;
+    }
+    return stats[1].rank() < stats[0].rank() ? 1 : 0;
+}
+
+namespace {
+
+struct BoolColumnView {
+    const UInt8* data = nullptr;
+    const UInt8* null_map = nullptr;
+
+    explicit BoolColumnView(const ColumnPtr& column) {
+        if (auto* nullable = check_and_get_column<ColumnNullable>(*column)) {
+            data = assert_cast<const ColumnUInt8&>(nullable->get_nested_column()).get_data().data();
+            null_map = nullable->get_null_map_data().data();
+        } else {
+            data = assert_cast<const ColumnUInt8&>(*column).get_data().data();
+        }
+    }
+
+    bool is_null(size_t i) const { return null_map != nullptr && null_map[i]; }
+    // The row is decided to be 'value' by this side alone.
+    bool is(size_t i, bool value) const { return !is_null(i) && (data[i] != 0) == value; }
+};
+
+} // namespace
+
+Status VcompoundPred::execute(VExprContext* context, Block* block, int* result_column_id) {
+    if (!_short_circuit) {
+        return VectorizedFnCall::execute(context, block, result_column_id);
+    }
+    if (find_cached_result(context, *block, result_column_id)) {
+        return Status::OK();
+    }
+
+    const size_t rows = block->rows();
+    const int first = _first_child();
+    auto& stats = *_stats;
+    // A row is decided by one side if it's false for AND, or true for OR.
+    const bool decided_value = _is_or;
+
+    ColumnPtr first_column;
+    int64_t start_ns = MonotonicNanos();
+    {
+        int column_id = -1;
+        RETURN_IF_ERROR(_children[first]->execute(context, block, &column_id));
+        first_column = block->get_by_position(column_id).column->convert_to_full_column_if_const();
+    }
+    BoolColumnView lhs(first_column);
+
+    IColumn::Filter undecided(rows);
+    size_t num_undecided = 0;
+    for (size_t i = 0; i < rows; ++i) {
+        undecided[i] = !lhs.is(i, decided_value);
+        num_undecided += undecided[i];
+    }
+    int64_t end_ns = MonotonicNanos();
+    stats[first].update(rows, rows - num_undecided, end_ns - start_ns);
+
+    ColumnPtr second_column;
+    if (num_undecided > 0) {
+        RETURN_IF_ERROR(_children[1 - first]->execute_selected(context, block, undecided,
+                                                               num_undecided, &second_column));
+        second_column = second_column->convert_to_full_column_if_const();
+    }
+    start_ns = end_ns;
+
+    auto result = ColumnUInt8::create(rows);
+    auto* __restrict res = result->get_data().data();
+    ColumnUInt8::MutablePtr null_map;
+    UInt8* __restrict res_null = nullptr;
+    if (_data_type->is_nullable()) {
+        null_map = ColumnUInt8::create(rows, 0);
+        res_null = null_map->get_data().data();
+    }
+
+    size_t second_decided = 0;
+    if (num_undecided == 0) {
+        memset(res, decided_value, rows);
+    } else {
+        BoolColumnView rhs(second_column);
+        for (size_t i = 0, j = 0; i < rows; ++i) {
+            if (!undecided[i]) {
+                res[i] = decided_value;
+                continue;
+            }
+            if (rhs.is(j, decided_value)) {
+                res[i] = decided_value;
+                second_decided++;
+            } else if (lhs.is_null(i) || rhs.is_null(j)) {
+                // null, or false if the result is not nullable
+                DCHECK(res_null != nullptr);
+                res[i] = 0;
+                if (res_null != nullptr) {
+                    res_null[i] = 1;
+                }
+            } else {
+                res[i] = !decided_value;
+            }
+            j++;
+        }
+        stats[1 - first].update(num_undecided, second_decided, MonotonicNanos() - start_ns);
+    }
+
+    ColumnPtr result_column = std::move(result);
+    if (null_map) {
+        result_column = ColumnNullable::create(result_column, std::move(null_map));
+    }
+    *result_column_id = block->columns();
+    block->insert({result_column, _data_type, expr_name()});
+    cache_result(context, *block, *result_column_id);
+    return Status::OK();
+}
+
+} // namespace doris::vectorized
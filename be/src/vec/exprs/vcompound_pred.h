@@ -16,6 +16,9 @@
 // under the License.
 
 #pragma once
+#include <array>
+#include <atomic>
+
 #include "runtime/runtime_state.h"
 #include "vec/exprs/vectorized_fn_call.h"
 #include "vec/exprs/vexpr.h"
@@ -23,6 +26,11 @@
 
 namespace doris::vectorized {
 
+// AND/OR are evaluated with short circuit: the second child only runs on the rows which
+// are not decided by the first one, i.e. the rows where the first child is true or null
+// for AND, and false or null for OR. Both operators are commutative, so the child which
+// is cheaper and decides more rows is evaluated first, according to the statistics
+// collected at runtime. NOT is evaluated as an ordinary function.
 class VcompoundPred final : public VectorizedFnCall {
 public:
     VcompoundPred(const TExprNode& node) : VectorizedFnCall(node) {
@@ -37,6 +45,37 @@ public:
             _fn.name.function_name = "not";
             break;
         }
+        _is_or = node.opcode == TExprOpcode::COMPOUND_OR;
+        _short_circuit = node.opcode == TExprOpcode::COMPOUND_AND ||
+                         node.opcode == TExprOpcode::COMPOUND_OR;
     }
+
+    Status execute(VExprContext* context, Block* block, int* result_column_id) override;
+
+    VExpr* clone(ObjectPool* pool) const override { return pool->add(new VcompoundPred(*this)); }
+
+private:
+    // Runtime statistics of a child, shared by the clones of this expr.
+    struct ChildStats {
+        std::atomic<int64_t> rows {0};
+        std::atomic<int64_t> decided_rows {0};
+        std::atomic<int64_t> cost_ns {0};
+
+        void update(int64_t num_rows, int64_t num_decided, int64_t ns) {
+            rows.fetch_add(num_rows, std::memory_order_relaxed);
+            decided_rows.fetch_add(num_decided, std::memory_order_relaxed);
+            cost_ns.fetch_add(ns, std::memory_order_relaxed);
+        }
+        // Expected cost of deciding a row by this child, lower is better.
+        double rank() const;
+    };
+
+    // The index of the child to evaluate first.
+    int _first_child() const;
+
+    bool _is_or = false;
+    bool _short_circuit = false;
+    std::shared_ptr<std::array<ChildStats, 2>> _stats =
+            std::make_shared<std::array<ChildStats, 2>>();
 };
 } // namespace doris::vectorized
@@ -0,0 +1,59 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exprs/vdirect_in_predicate.h"
+
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/core/block.h"
+
+namespace doris::vectorized {
+
+Status VDirectInPredicate::prepare(RuntimeState* state, const RowDescriptor& desc,
+                                   VExprContext* context) {
+    RETURN_IF_ERROR(VExpr::prepare(state, desc, context));
+    if (_children.size() != 1) {
+        return Status::InternalError("Invalid argument for in predicate of runtime filter");
+    }
+    if (_set == nullptr) {
+        return Status::InternalError("Unknown column type.");
+    }
+    _expr_name = fmt::format("({} in set)", _children[0]->expr_name());
+    return Status::OK();
+}
+
+Status VDirectInPredicate::execute(VExprContext* context, Block* block, int* result_column_id) {
+    int column_id = -1;
+    RETURN_IF_ERROR(_children[0]->execute(context, block, &column_id));
+    ColumnPtr argument =
+            block->get_by_position(column_id).column->convert_to_full_column_if_const();
+    const IColumn* nested = argument.get();
+    const uint8_t* null_map = nullptr;
+    if (const auto* nullable = check_and_get_column<ColumnNullable>(*argument)) {
+        nested = &nullable->get_nested_column();
+        null_map = nullable->get_null_map_data().data();
+    }
+
+    auto result = ColumnUInt8::create(block->rows());
+    _set->find_batch(*nested, null_map, result->get_data().data());
+
+    block->insert({std::move(result), _data_type, _expr_name});
+    *result_column_id = block->columns() - 1;
+    return Status::OK();
+}
+
+} // namespace doris::vectorized
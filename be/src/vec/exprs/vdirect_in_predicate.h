@@ -0,0 +1,48 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "exprs/hybrid_set.h"
+#include "vec/exprs/vexpr.h"
+
+namespace doris::vectorized {
+
+// The vectorized InPredicate of runtime filter. It probes the set built by the hash join
+// directly, instead of creating a literal for each value of the set like VInPredicate.
+// The values in the set are in the format of the row engine, e.g. DateTimeValue for dates.
+// The result is not nullable, null rows are false.
+class VDirectInPredicate final : public VExpr {
+public:
+    VDirectInPredicate(const TExprNode& node, const std::shared_ptr<HybridSetBase>& set)
+            : VExpr(node), _set(set) {}
+    ~VDirectInPredicate() override = default;
+
+    Status prepare(RuntimeState* state, const RowDescriptor& desc,
+                   VExprContext* context) override;
+    Status execute(VExprContext* context, Block* block, int* result_column_id) override;
+    VExpr* clone(ObjectPool* pool) const override {
+        return pool->add(new VDirectInPredicate(*this));
+    }
+    const std::string& expr_name() const override { return _expr_name; }
+
+private:
+    std::shared_ptr<HybridSetBase> _set;
+    std::string _expr_name;
+};
+
+} // namespace doris::vectorized
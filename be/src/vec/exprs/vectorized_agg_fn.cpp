@@ -130,6 +130,13 @@ void AggFnEvaluator::execute_single_merge(AggregateDataPtr place, ConstAggregate
     _function->merge(place, rhs, arena);
 }
 
+void AggFnEvaluator::streaming_agg_serialize(Block* block, ColumnString& to, bool raw_state,
+                                             Arena* arena) {
+    _calc_argment_columns(block);
+    SCOPED_TIMER(_exec_timer);
+    _function->streaming_agg_serialize(_agg_columns.data(), to, block->rows(), arena, raw_state);
+}
+
 void AggFnEvaluator::insert_result_info(AggregateDataPtr place, IColumn* column) {
     _function->insert_result_into(place, *column);
 }
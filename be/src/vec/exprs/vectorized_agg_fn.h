@@ -60,6 +60,10 @@ public:
     void execute_single_merge(AggregateDataPtr place, ConstAggregateDataPtr rhs,
                               Arena* arena = nullptr);
 
+    // serialize a one-row state for every row of the block
+    void streaming_agg_serialize(Block* block, ColumnString& to, bool raw_state,
+                                 Arena* arena = nullptr);
+
     void insert_result_info(AggregateDataPtr place, IColumn* column);
 
     void reset(AggregateDataPtr place);
@@ -70,6 +74,7 @@ public:
     static std::string debug_string(const std::vector<AggFnEvaluator*>& exprs);
     std::string debug_string() const;
     bool is_merge() const { return _is_merge; }
+    const std::vector<VExprContext*>& input_exprs_ctxs() const { return _input_exprs_ctxs; }
 
 private:
     const TFunction _fn;
@@ -50,6 +50,8 @@ doris::Status VectorizedFnCall::prepare(doris::RuntimeState* state,
     }
     VExpr::register_function_context(state, context);
     _expr_name = fmt::format("{}({})", _fn.name.function_name, child_expr_name);
+    init_fingerprint(fmt::format("{}:{}", _fn.name.function_name, _data_type->get_name()),
+                     _function->is_deterministic());
 
     return Status::OK();
 }
@@ -69,6 +71,9 @@ void VectorizedFnCall::close(doris::RuntimeState* state, VExprContext* context,
 
 doris::Status VectorizedFnCall::execute(VExprContext* context, doris::vectorized::Block* block,
                                         int* result_column_id) {
+    if (find_cached_result(context, *block, result_column_id)) {
+        return Status::OK();
+    }
     // TODO: not execute const expr again, but use the const column in function context
     doris::vectorized::ColumnNumbers arguments(_children.size());
     for (int i = 0; i < _children.size(); ++i) {
@@ -83,6 +88,7 @@ doris::Status VectorizedFnCall::execute(VExprContext* context, doris::vectorized
     RETURN_IF_ERROR(_function->execute(context->fn_context(_fn_context_index), *block, arguments,
                                        num_columns_without_result, block->rows(), false));
     *result_column_id = num_columns_without_result;
+    cache_result(context, *block, *result_column_id);
     return Status::OK();
 }
 
@@ -23,6 +23,8 @@
 
 #include "exprs/anyval_util.h"
 #include "gen_cpp/Exprs_types.h"
+#include "util/defer_op.h"
+#include "vec/columns/column_const.h"
 #include "vec/exprs/vcase_expr.h"
 #include "vec/exprs/vcast_expr.h"
 #include "vec/exprs/vcompound_pred.h"
@@ -214,6 +216,12 @@ void VExpr::close(const std::vector<VExprContext*>& ctxs, RuntimeState* state) {
     }
 }
 
+void VExpr::set_expr_cache(const std::vector<VExprContext*>& ctxs, VExprCache* cache) {
+    for (auto ctx : ctxs) {
+        ctx->set_expr_cache(cache);
+    }
+}
+
 Status VExpr::open(const std::vector<VExprContext*>& ctxs, RuntimeState* state) {
     for (int i = 0; i < ctxs.size(); ++i) {
         RETURN_IF_ERROR(ctxs[i]->open(state));
@@ -272,6 +280,90 @@ std::string VExpr::debug_string(const std::vector<VExprContext*>& ctxs) {
     return debug_string(exprs);
 }
 
+Status VExpr::execute_selected(VExprContext* context, Block* block, const IColumn::Filter& filter,
+                               size_t count, ColumnPtr* result) {
+    if (count == 0) {
+        *result = _data_type->create_column();
+        return Status::OK();
+    }
+    if (count == block->rows()) {
+        int column_id = -1;
+        RETURN_IF_ERROR(execute(context, block, &column_id));
+        *result = block->get_by_position(column_id).column;
+        return Status::OK();
+    }
+
+    // Only filter the columns read by this tree, the others are replaced by constants to
+    // keep the positions of the columns.
+    std::set<int> column_ids;
+    collect_slot_column_ids(&column_ids);
+    Block selected_block;
+    for (int i = 0; i < block->columns(); ++i) {
+        const auto& elem = block->get_by_position(i);
+        ColumnPtr column;
+        if (elem.column == nullptr) {
+            // keep it null
+        } else if (column_ids.count(i)) {
+            column = elem.column->filter(filter, count);
+        } else {
+            column = ColumnConst::create(elem.column->clone_resized(1), count);
+        }
+        selected_block.insert({column, elem.type, elem.name});
+    }
+    // the selected block is temporary, don't let its results replace the cached ones
+    VExprCache* expr_cache = context->expr_cache();
+    context->set_expr_cache(nullptr);
+    Defer restore_cache {[&]() { context->set_expr_cache(expr_cache); }};
+    int column_id = -1;
+    RETURN_IF_ERROR(execute(context, &selected_block, &column_id));
+    *result = selected_block.get_by_position(column_id).column;
+    return Status::OK();
+}
+
+void VExpr::init_fingerprint(const std::string& name, bool is_deterministic) {
+    _fingerprint.clear();
+    if (!is_deterministic) {
+        return;
+    }
+    std::string fingerprint = name + "(";
+    for (int i = 0; i < _children.size(); ++i) {
+        if (_children[i]->fingerprint().empty()) {
+            return;
+        }
+        if (i != 0) {
+            fingerprint += ",";
+        }
+        fingerprint += _children[i]->fingerprint();
+    }
+    fingerprint += ")";
+    _fingerprint = std::move(fingerprint);
+}
+
+bool VExpr::find_cached_result(VExprContext* context, const Block& block,
+                               int* result_column_id) const {
+    if (context->expr_cache() == nullptr || _fingerprint.empty()) {
+        return false;
+    }
+    int column_id = context->expr_cache()->find(block, _fingerprint);
+    if (column_id < 0) {
+        return false;
+    }
+    *result_column_id = column_id;
+    return true;
+}
+
+void VExpr::cache_result(VExprContext* context, const Block& block, int result_column_id) const {
+    if (context->expr_cache() != nullptr && !_fingerprint.empty()) {
+        context->expr_cache()->insert(block, _fingerprint, result_column_id);
+    }
+}
+
+void VExpr::collect_slot_column_ids(std::set<int>* column_ids) const {
+    for (auto child : _children) {
+        child->collect_slot_column_ids(column_ids);
+    }
+}
+
 bool VExpr::is_constant() const {
     for (int i = 0; i < _children.size(); ++i) {
         if (!_children[i]->is_constant()) {
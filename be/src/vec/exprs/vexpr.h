@@ -18,6 +18,7 @@
 #pragma once
 
 #include <memory>
+#include <set>
 #include <vector>
 
 #include "common/status.h"
@@ -62,6 +63,20 @@ public:
     virtual Status execute(VExprContext* context, vectorized::Block* block,
                            int* result_column_id) = 0;
 
+    /// Executes the expr only on the rows selected by 'filter', 'count' is the number of
+    /// selected rows. The result column has 'count' rows and is not added to 'block'.
+    /// Used to skip the rows which are already decided, e.g. by the other side of AND/OR.
+    Status execute_selected(VExprContext* context, vectorized::Block* block,
+                            const IColumn::Filter& filter, size_t count, ColumnPtr* result);
+
+    /// Collects the positions of the block columns read by this expr tree.
+    virtual void collect_slot_column_ids(std::set<int>* column_ids) const;
+
+    /// Identifies the result of this tree: structurally identical deterministic trees which
+    /// read the same block columns have the same fingerprint. Set in prepare(), empty if
+    /// the result can't be shared with other trees.
+    const std::string& fingerprint() const { return _fingerprint; }
+
     /// Subclasses overriding this function should call VExpr::Close().
     //
     /// If scope if FRAGMENT_LOCAL, both fragment- and thread-local state should be torn
@@ -96,6 +111,9 @@ public:
 
     static void close(const std::vector<VExprContext*>& ctxs, RuntimeState* state);
 
+    /// Makes the contexts share the results of their common subexpressions, see VExprCache.
+    static void set_expr_cache(const std::vector<VExprContext*>& ctxs, VExprCache* cache);
+
     bool is_nullable() const { return _data_type->is_nullable(); }
 
     PrimitiveType result_type() const { return _type.type; }
@@ -113,6 +131,8 @@ public:
 
     bool is_and_expr() { return _fn.name.function_name == "and"; }
 
+    const std::string& fn_name() const { return _fn.name.function_name; }
+
     /// Returns true if expr doesn't contain slotrefs, i.e., can be evaluated
     /// with get_value(NULL). The default implementation returns true if all of
     /// the children are constant.
@@ -132,6 +152,16 @@ protected:
         return out.str();
     }
 
+    /// Sets _fingerprint to 'name' followed by the fingerprints of the children. It is left
+    /// empty if this expr isn't deterministic or a child can't be shared.
+    void init_fingerprint(const std::string& name, bool is_deterministic);
+
+    /// Returns true if the result of this tree on 'block' is cached by the context, and sets
+    /// 'result_column_id' to its position.
+    bool find_cached_result(VExprContext* context, const Block& block,
+                            int* result_column_id) const;
+    void cache_result(VExprContext* context, const Block& block, int result_column_id) const;
+
     /// Helper function that calls ctx->register(), sets fn_context_index_, and returns the
     /// registered FunctionContext
     void register_function_context(doris::RuntimeState* state, VExprContext* context);
@@ -162,6 +192,8 @@ protected:
     // If this expr is constant, this will store and cache the value generated by
     // get_const_col()
     std::shared_ptr<ColumnPtrWrapper> _constant_col;
+
+    std::string _fingerprint;
 };
 
 } // namespace vectorized
@@ -18,9 +18,32 @@
 #include "vec/exprs/vexpr_context.h"
 
 #include "udf/udf_internal.h"
+#include "vec/columns/column_const.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/assert_cast.h"
+#include "vec/data_types/data_type_number.h"
 #include "vec/exprs/vexpr.h"
 
 namespace doris::vectorized {
+int VExprCache::find(const Block& block, const std::string& fingerprint) {
+    auto it = _entries.find(fingerprint);
+    if (it == _entries.end()) {
+        return -1;
+    }
+    const Entry& entry = it->second;
+    if (entry.column_id >= block.columns() ||
+        block.get_by_position(entry.column_id).column != entry.column) {
+        return -1;
+    }
+    ++_hit_count;
+    return entry.column_id;
+}
+
+void VExprCache::insert(const Block& block, const std::string& fingerprint, int column_id) {
+    _entries[fingerprint] = {column_id, block.get_by_position(column_id).column};
+}
+
 VExprContext::VExprContext(VExpr* expr)
         : _root(expr),
           _is_clone(false),
@@ -118,14 +141,62 @@ Status VExprContext::filter_block(const std::unique_ptr<VExprContext*>& vexpr_ct
     return Block::filter_block(block, result_column_id, column_to_keep);
 }
 
+Status VExprContext::filter_block(const std::vector<VExprContext*>& vexpr_ctxs, Block* block,
+                                  int column_to_keep) {
+    if (vexpr_ctxs.empty() || block->rows() == 0) {
+        return Status::OK();
+    }
+    if (vexpr_ctxs.size() == 1) {
+        return filter_block(vexpr_ctxs[0], block, column_to_keep);
+    }
+
+    size_t rows = block->rows();
+    auto filter_column = ColumnUInt8::create(rows, 1);
+    auto* filter = filter_column->get_data().data();
+    for (auto vexpr_ctx : vexpr_ctxs) {
+        int result_column_id = -1;
+        RETURN_IF_ERROR(vexpr_ctx->execute(block, &result_column_id));
+        ColumnPtr result = block->get_by_position(result_column_id).column;
+        if (const auto* const_column = check_and_get_column<ColumnConst>(*result)) {
+            if (!const_column->get_bool(0)) {
+                memset(filter, 0, rows);
+                break;
+            }
+            continue;
+        }
+        if (const auto* nullable_column = check_and_get_column<ColumnNullable>(*result)) {
+            const auto* null_map = nullable_column->get_null_map_data().data();
+            const auto* data =
+                    assert_cast<const ColumnUInt8&>(nullable_column->get_nested_column())
+                            .get_data()
+                            .data();
+            for (size_t i = 0; i < rows; ++i) {
+                filter[i] &= data[i] & !null_map[i];
+            }
+        } else {
+            const auto* data = assert_cast<const ColumnUInt8&>(*result).get_data().data();
+            for (size_t i = 0; i < rows; ++i) {
+                filter[i] &= data[i];
+            }
+        }
+    }
+    block->insert({std::move(filter_column), std::make_shared<DataTypeUInt8>(), "filter"});
+    return Block::filter_block(block, block->columns() - 1, column_to_keep);
+}
+
 Block VExprContext::get_output_block_after_execute_exprs(
         const std::vector<vectorized::VExprContext*>& output_vexpr_ctxs, const Block& input_block,
         Status& status) {
     vectorized::Block tmp_block(input_block.get_columns_with_type_and_name());
     vectorized::ColumnsWithTypeAndName result_columns;
+    // the output exprs often repeat the same subexpressions
+    VExprCache expr_cache;
     for (auto vexpr_ctx : output_vexpr_ctxs) {
         int result_column_id = -1;
+        VExprCache* saved_cache = vexpr_ctx->expr_cache();
+        vexpr_ctx->set_expr_cache(&expr_cache);
         status = vexpr_ctx->execute(&tmp_block, &result_column_id);
+        vexpr_ctx->set_expr_cache(saved_cache);
         if (UNLIKELY(!status.ok())) return {};
         DCHECK(result_column_id != -1);
         result_columns.emplace_back(tmp_block.get_by_position(result_column_id));
@@ -17,6 +17,9 @@
 
 #pragma once
 
+#include <string>
+#include <unordered_map>
+
 #include "common/status.h"
 #include "runtime/runtime_state.h"
 #include "vec/core/block.h"
@@ -24,6 +27,35 @@
 namespace doris::vectorized {
 class VExpr;
 
+/// Results of the common subexpressions executed on a block, shared by the VExprContexts
+/// of a node. An expr whose fingerprint is found reuses the result column in the block
+/// instead of executing again, e.g. substr(url, 1, 20) used by both a group key and an
+/// aggregate function argument is only executed once for a block.
+///
+/// An entry holds the result column, and only matches if the block still has that column
+/// at the same position, so a stale entry is never used after the block is filtered or
+/// reused. The cache should be cleared when the node is done with a block, to not keep
+/// the columns alive. It is not thread safe, so the contexts sharing it must be used by
+/// one thread.
+class VExprCache {
+public:
+    /// Returns the position of the cached result of 'fingerprint' in 'block', or -1.
+    int find(const Block& block, const std::string& fingerprint);
+    void insert(const Block& block, const std::string& fingerprint, int column_id);
+    void clear() { _entries.clear(); }
+
+    size_t size() const { return _entries.size(); }
+    int64_t hit_count() const { return _hit_count; }
+
+private:
+    struct Entry {
+        int column_id;
+        ColumnPtr column;
+    };
+    std::unordered_map<std::string, Entry> _entries;
+    int64_t _hit_count = 0;
+};
+
 class VExprContext {
 public:
     VExprContext(VExpr* expr);
@@ -56,10 +88,18 @@ public:
     static Status filter_block(VExprContext* vexpr_ctx, Block* block, int column_to_keep);
     static Status filter_block(const std::unique_ptr<VExprContext*>& vexpr_ctx_ptr, Block* block,
                                int column_to_keep);
+    // Filters the block by the conjunction of the contexts. The results are merged into one
+    // filter, so the columns of the block are filtered only once.
+    static Status filter_block(const std::vector<VExprContext*>& vexpr_ctxs, Block* block,
+                               int column_to_keep);
 
     static Block get_output_block_after_execute_exprs(const std::vector<vectorized::VExprContext*>&,
                                                       const Block&, Status&);
 
+    /// The cache is not owned by the context, and is not copied to the clones.
+    void set_expr_cache(VExprCache* expr_cache) { _expr_cache = expr_cache; }
+    VExprCache* expr_cache() const { return _expr_cache; }
+
     int get_last_result_column_id() {
         DCHECK(_last_result_column_id != -1);
         return _last_result_column_id;
@@ -87,5 +127,7 @@ private:
     std::unique_ptr<MemPool> _pool;
 
     int _last_result_column_id;
+
+    VExprCache* _expr_cache = nullptr;
 };
 } // namespace doris::vectorized
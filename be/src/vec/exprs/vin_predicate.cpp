@@ -68,6 +68,7 @@ Status VInPredicate::prepare(RuntimeState* state, const RowDescriptor& desc,
     }
 
     VExpr::register_function_context(state, context);
+    init_fingerprint(real_function_name, _function->is_deterministic());
     return Status::OK();
 }
 
@@ -85,6 +86,9 @@ void VInPredicate::close(RuntimeState* state, VExprContext* context,
 }
 
 Status VInPredicate::execute(VExprContext* context, Block* block, int* result_column_id) {
+    if (find_cached_result(context, *block, result_column_id)) {
+        return Status::OK();
+    }
     // TODO: not execute const expr again, but use the const column in function context
     doris::vectorized::ColumnNumbers arguments(_children.size());
     for (int i = 0; i < _children.size(); ++i) {
@@ -99,6 +103,7 @@ Status VInPredicate::execute(VExprContext* context, Block* block, int* result_co
     RETURN_IF_ERROR(_function->execute(context->fn_context(_fn_context_index), *block, arguments,
                                        num_columns_without_result, block->rows(), false));
     *result_column_id = num_columns_without_result;
+    cache_result(context, *block, *result_column_id);
     return Status::OK();
 }
 
@@ -121,6 +121,13 @@ VLiteral::VLiteral(const TExprNode& node) : VExpr(node) {
 
     this->_column_ptr = _data_type->create_column_const(1, field);
     _expr_name = _data_type->get_name();
+    if (_column_ptr->is_null_at(0)) {
+        _fingerprint = fmt::format("{}:null", _expr_name);
+    } else {
+        // the raw value is prefixed by its length, so it can't be confused with the others
+        StringRef value = _column_ptr->get_data_at(0);
+        _fingerprint = fmt::format("{}:{}:{}", _expr_name, value.size, value.to_string());
+    }
 }
 
 VLiteral::~VLiteral() {}
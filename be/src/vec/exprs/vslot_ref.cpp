@@ -55,6 +55,7 @@ Status VSlotRef::prepare(doris::RuntimeState* state, const doris::RowDescriptor&
     }
     _column_id = desc.get_column_id(_slot_id);
     _column_name = &slot_desc->col_name();
+    _fingerprint = fmt::format("slot{}@{}", _slot_id, _column_id);
     return Status::OK();
 }
 
@@ -38,6 +38,9 @@ public:
     virtual const std::string& expr_name() const override;
     virtual std::string debug_string() const;
     virtual bool is_constant() const { return false; }
+    void collect_slot_column_ids(std::set<int>* column_ids) const override {
+        column_ids->insert(_column_id);
+    }
 
 private:
     FunctionPtr _function;
@@ -50,7 +50,7 @@ struct ToBitmapImpl {
     using ReturnColumnType = ColumnBitmap;
 
     static Status vector(const ColumnString::Chars& data, const ColumnString::Offsets& offsets,
-                         std::vector<BitmapValue>& res) {
+                         ColumnBitmap& res) {
         auto size = offsets.size();
         res.reserve(size);
         for (size_t i = 0; i < size; ++i) {
@@ -68,8 +68,7 @@ struct ToBitmapImpl {
 //                                    "value from 0 to 18446744073709551615 currently",
 //                                    raw_str, str_size));
 //            }
-            res.emplace_back();
-            res.back().add(int_value);
+            res.insert_value(BitmapValue(int_value));
         }
         return Status::OK();
     }
@@ -85,7 +84,7 @@ struct BitmapFromString {
     using Type = String;
     using ReturnColumnType = ColumnBitmap;
     static Status vector(const ColumnString::Chars& data, const ColumnString::Offsets& offsets,
-                         std::vector<BitmapValue>& res) {
+                         ColumnBitmap& res) {
         auto size = offsets.size();
         res.reserve(size);
         std::vector<uint64_t> bits;
@@ -93,9 +92,9 @@ struct BitmapFromString {
             const char* raw_str = reinterpret_cast<const char*>(&data[offsets[i - 1]]);
             int str_size = offsets[i] - offsets[i - 1] - 1;
             if (SplitStringAndParse({raw_str, str_size}, ",", &safe_strtou64, &bits)) {
-                res.emplace_back(bits);
+                res.insert_value(BitmapValue(bits));
             } else {
-                res.emplace_back();
+                res.insert_default();
             }
             bits.clear();
         }
@@ -113,7 +112,7 @@ struct BitmapHash {
     using Type = String;
     using ReturnColumnType = ColumnBitmap;
     static Status vector(const ColumnString::Chars& data, const ColumnString::Offsets& offsets,
-                         std::vector<BitmapValue>& res) {
+                         ColumnBitmap& res) {
         auto size = offsets.size();
         res.reserve(size);
         for (size_t i = 0; i < size; ++i) {
@@ -121,8 +120,7 @@ struct BitmapHash {
             size_t str_size = offsets[i] - offsets[i - 1] - 1;
             uint32_t hash_value =
                 HashUtil::murmur_hash3_32(raw_str, str_size, HashUtil::MURMUR3_32_SEED);
-            res.emplace_back();
-            res.back().add(hash_value);
+            res.insert_value(BitmapValue(hash_value));
         }
         return Status::OK();
     }
@@ -139,11 +137,11 @@ struct BitmapCount {
     using ReturnColumnType = ColumnVector<Int64>;
     using ReturnColumnContainer = ColumnVector<Int64>::Container;
 
-    static Status vector(const std::vector<BitmapValue>& data, ReturnColumnContainer& res) {
+    static Status vector(const ColumnBitmap& data, ReturnColumnContainer& res) {
         size_t size = data.size();
         res.reserve(size);
         for (size_t i = 0; i < size; ++i) {
-            res.push_back(data[i].cardinality());
+            res.push_back(data.cardinality(i));
         }
         return Status::OK();
     }
@@ -158,13 +156,14 @@ struct BitmapAnd {
     using ResultDataType = DataTypeBitMap;
     using T0 = typename LeftDataType::FieldType;
     using T1 = typename RightDataType::FieldType;
-    using TData = std::vector<BitmapValue>;
+    using TData = ColumnBitmap;
 
     static Status vector_vector(const TData& lvec, const TData& rvec, TData& res) {
         size_t size = lvec.size();
         for (size_t i = 0; i < size; ++i) {
-            res[i] = lvec[i];
-            res[i] &= rvec[i];
+            BitmapValue value = lvec.get_element(i);
+            value &= rvec.get_element(i);
+            res.insert_value(value);
         }
         return Status::OK();
     }
@@ -179,13 +178,14 @@ struct BitmapOr {
     using ResultDataType = DataTypeBitMap;
     using T0 = typename LeftDataType::FieldType;
     using T1 = typename RightDataType::FieldType;
-    using TData = std::vector<BitmapValue>;
+    using TData = ColumnBitmap;
 
     static Status vector_vector(const TData& lvec, const TData& rvec, TData& res) {
         size_t size = lvec.size();
         for (size_t i = 0; i < size; ++i) {
-            res[i] = lvec[i];
-            res[i] |= rvec[i];
+            BitmapValue value = lvec.get_element(i);
+            rvec.union_into(i, &value);
+            res.insert_value(value);
         }
         return Status::OK();
     }
@@ -200,13 +200,14 @@ struct BitmapXor {
     using ResultDataType = DataTypeBitMap;
     using T0 = typename LeftDataType::FieldType;
     using T1 = typename RightDataType::FieldType;
-    using TData = std::vector<BitmapValue>;
+    using TData = ColumnBitmap;
 
     static Status vector_vector(const TData& lvec, const TData& rvec, TData& res) {
         size_t size = lvec.size();
         for (size_t i = 0; i < size; ++i) {
-            res[i] = lvec[i];
-            res[i] ^= rvec[i];
+            BitmapValue value = lvec.get_element(i);
+            value ^= rvec.get_element(i);
+            res.insert_value(value);
         }
         return Status::OK();
     }
@@ -221,13 +222,14 @@ struct BitmapNot {
     using ResultDataType = DataTypeBitMap;
     using T0 = typename LeftDataType::FieldType;
     using T1 = typename RightDataType::FieldType;
-    using TData = std::vector<BitmapValue>;
+    using TData = ColumnBitmap;
 
     static Status vector_vector(const TData& lvec, const TData& rvec, TData& res) {
         size_t size = lvec.size();
         for (size_t i = 0; i < size; ++i) {
-            res[i] = lvec[i];
-            res[i] -= rvec[i];
+            BitmapValue value = lvec.get_element(i);
+            value -= rvec.get_element(i);
+            res.insert_value(value);
         }
         return Status::OK();
     }
@@ -242,14 +244,14 @@ struct BitmapContains {
     using ResultDataType = DataTypeUInt8;
     using T0 = typename LeftDataType::FieldType;
     using T1 = typename RightDataType::FieldType;
-    using LTData = std::vector<BitmapValue>;
+    using LTData = ColumnBitmap;
     using RTData = typename ColumnVector<T1>::Container;
     using ResTData = typename ColumnVector<UInt8>::Container;
 
     static Status vector_vector(const LTData& lvec, const RTData& rvec, ResTData& res) {
         size_t size = lvec.size();
         for (size_t i = 0; i < size; ++i) {
-            res[i] = lvec[i].contains(rvec[i]);
+            res[i] = lvec.get_element(i).contains(rvec[i]);
         }
         return Status::OK();
     }
@@ -264,14 +266,14 @@ struct BitmapHasAny {
     using ResultDataType = DataTypeUInt8;
     using T0 = typename LeftDataType::FieldType;
     using T1 = typename RightDataType::FieldType;
-    using TData = std::vector<BitmapValue>;
+    using TData = ColumnBitmap;
     using ResTData = typename ColumnVector<UInt8>::Container;
 
     static Status vector_vector(const TData& lvec, const TData& rvec, ResTData& res) {
         size_t size = lvec.size();
         for (size_t i = 0; i < size; ++i) {
-            auto bitmap = const_cast<BitmapValue&>(lvec[i]);
-            bitmap &= rvec[i];
+            BitmapValue bitmap = lvec.get_element(i);
+            bitmap &= rvec.get_element(i);
             res[i] = bitmap.cardinality() != 0;
         }
         return Status::OK();
@@ -289,11 +291,11 @@ struct BitmapMin {
     using ReturnColumnType = ColumnVector<Int64>;
     using ReturnColumnContainer = ColumnVector<Int64>::Container;
 
-    static Status vector(const std::vector<BitmapValue>& data, ReturnColumnContainer& res) {
+    static Status vector(const ColumnBitmap& data, ReturnColumnContainer& res) {
         size_t size = data.size();
         res.reserve(size);
         for (size_t i = 0; i < size; ++i) {
-            auto min = const_cast<std::vector<BitmapValue>&>(data)[i].minimum();
+            auto min = data.get_element(i).minimum();
             res.push_back(min.val);
         }
         return Status::OK();
@@ -311,11 +313,11 @@ struct BitmapMax {
     using ReturnColumnType = ColumnVector<Int64>;
     using ReturnColumnContainer = ColumnVector<Int64>::Container;
 
-    static Status vector(const std::vector<BitmapValue>& data, ReturnColumnContainer& res) {
+    static Status vector(const ColumnBitmap& data, ReturnColumnContainer& res) {
         size_t size = data.size();
         res.reserve(size);
         for (size_t i = 0; i < size; ++i) {
-            auto max = const_cast<std::vector<BitmapValue>&>(data)[i].maximum();
+            auto max = data.get_element(i).maximum();
             res.push_back(max.val);
         }
         return Status::OK();
@@ -334,12 +336,12 @@ struct BitmapToString {
     using Chars = ColumnString::Chars;
     using Offsets = ColumnString::Offsets;
 
-    static Status vector(const std::vector<BitmapValue>& data, Chars& chars, Offsets& offsets) {
+    static Status vector(const ColumnBitmap& data, Chars& chars, Offsets& offsets) {
         size_t size = data.size();
         offsets.resize(size);
         chars.reserve(size);
         for (size_t i = 0; i < size; ++i) {
-            StringOP::push_value_string(data[i].to_string(), i, chars, offsets);
+            StringOP::push_value_string(data.get_element(i).to_string(), i, chars, offsets);
         }
         return Status::OK();
     }
@@ -353,17 +355,15 @@ struct BitmapAndCount {
     using ResultDataType = DataTypeInt64;
     using T0 = typename LeftDataType::FieldType;
     using T1 = typename RightDataType::FieldType;
-    using TData = std::vector<BitmapValue>;
+    using TData = ColumnBitmap;
     using ResTData = typename ColumnVector<Int64>::Container;
 
     static Status vector_vector(const TData& lvec, const TData& rvec, ResTData& res) {
         size_t size = lvec.size();
-        BitmapValue val;
         for (size_t i = 0; i < size; ++i) {
-            val |= lvec[i];
-            val &= rvec[i];
+            BitmapValue val = lvec.get_element(i);
+            val &= rvec.get_element(i);
             res[i] = val.cardinality();
-            val.clear();
         }
         return Status::OK();
     }
@@ -377,17 +377,15 @@ struct BitmapOrCount {
     using ResultDataType = DataTypeInt64;
     using T0 = typename LeftDataType::FieldType;
     using T1 = typename RightDataType::FieldType;
-    using TData = std::vector<BitmapValue>;
+    using TData = ColumnBitmap;
     using ResTData = typename ColumnVector<Int64>::Container;
 
     static Status vector_vector(const TData& lvec, const TData& rvec, ResTData& res) {
         size_t size = lvec.size();
-        BitmapValue val;
         for (size_t i = 0; i < size; ++i) {
-            val |= lvec[i];
-            val |= rvec[i];
+            BitmapValue val = lvec.get_element(i);
+            rvec.union_into(i, &val);
             res[i] = val.cardinality();
-            val.clear();
         }
         return Status::OK();
     }
@@ -401,17 +399,15 @@ struct BitmapXorCount {
     using ResultDataType = DataTypeInt64;
     using T0 = typename LeftDataType::FieldType;
     using T1 = typename RightDataType::FieldType;
-    using TData = std::vector<BitmapValue>;
+    using TData = ColumnBitmap;
     using ResTData = typename ColumnVector<Int64>::Container;
 
     static Status vector_vector(const TData& lvec, const TData& rvec, ResTData& res) {
         size_t size = lvec.size();
-        BitmapValue val;
         for (size_t i = 0; i < size; ++i) {
-            val |= lvec[i];
-            val ^= rvec[i];
+            BitmapValue val = lvec.get_element(i);
+            val ^= rvec.get_element(i);
             res[i] = val.cardinality();
-            val.clear();
         }
         return Status::OK();
     }
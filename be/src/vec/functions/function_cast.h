@@ -213,12 +213,92 @@ struct ConvertImplToTimeType {
 };
 
 // Generic conversion of any type to String.
+/// Conversion of numbers and dates to String, a column at a time. The chars are allocated once
+/// for the longest text of the type, and each row is written in place. The texts are the same
+/// as IDataType::to_string().
+template <typename FromDataType>
+struct ConvertImplToString {
+    using FromFieldType = typename FromDataType::FieldType;
+
+    static constexpr bool is_supported =
+            IsTimeType<FromDataType> ||
+            (std::is_arithmetic_v<FromFieldType> && !std::is_same_v<FromFieldType, Int128>);
+
+    static constexpr size_t max_text_length() {
+        if constexpr (std::is_integral_v<FromFieldType> && !IsTimeType<FromDataType>) {
+            // with the sign
+            return std::numeric_limits<FromFieldType>::digits10 + 2;
+        } else {
+            // the shortest round trip text of a double, and the text of a datetime
+            return 32;
+        }
+    }
+
+    static Status execute(const ColumnVector<FromFieldType>& col_from, Block& block,
+                          size_t result) {
+        const auto& vec_from = col_from.get_data();
+        size_t size = vec_from.size();
+
+        auto col_to = ColumnString::create();
+        auto& chars = col_to->get_chars();
+        auto& offsets = col_to->get_offsets();
+        chars.resize(size * (max_text_length() + 1));
+        offsets.resize(size);
+
+        auto* begin = reinterpret_cast<char*>(chars.data());
+        char* pos = begin;
+        [[maybe_unused]] const char* last_text = nullptr;
+        [[maybe_unused]] size_t last_length = 0;
+        for (size_t i = 0; i < size; ++i) {
+            if constexpr (IsTimeType<FromDataType>) {
+                // consecutive rows often have the same date, its text is copied
+                if (last_text != nullptr && vec_from[i] == vec_from[i - 1]) {
+                    memcpy(pos, last_text, last_length);
+                    pos += last_length;
+                } else {
+                    last_text = pos;
+                    pos += binary_cast<Int64, VecDateTimeValue>(vec_from[i]).to_buffer(pos);
+                    last_length = pos - last_text;
+                }
+            } else if constexpr (std::is_integral_v<FromFieldType>) {
+                pos = write_int_text(vec_from[i], pos);
+            } else {
+                // shortest round trip text, same as BufferWritable::write_number()
+                pos = fmt::format_to(pos, "{}", vec_from[i]);
+            }
+            *pos++ = '\0';
+            offsets[i] = pos - begin;
+        }
+        chars.resize(pos - begin);
+
+        block.replace_by_position(result, std::move(col_to));
+        return Status::OK();
+    }
+};
+
 struct ConvertImplGenericToString {
     static Status execute(Block& block, const ColumnNumbers& arguments, size_t result) {
         const auto& col_with_type_and_name = block.get_by_position(arguments[0]);
         const IDataType& type = *col_with_type_and_name.type;
         const IColumn& col_from = *col_with_type_and_name.column;
 
+        Status status;
+        auto call = [&](const auto& types) -> bool {
+            using FromDataType = typename std::decay_t<decltype(types)>::LeftType;
+            using Impl = ConvertImplToString<FromDataType>;
+            if constexpr (Impl::is_supported) {
+                using ColVecFrom = ColumnVector<typename Impl::FromFieldType>;
+                if (const auto* col_vec_from = check_and_get_column<ColVecFrom>(col_from)) {
+                    status = Impl::execute(*col_vec_from, block, result);
+                    return true;
+                }
+            }
+            return false;
+        };
+        if (call_on_index_and_data_type<DataTypeString>(type.get_type_id(), call)) {
+            return status;
+        }
+
         size_t size = col_from.size();
 
         auto col_to = ColumnString::create();
@@ -766,7 +846,15 @@ struct ConvertThroughParsing {
             {
                 bool parsed;
 
-                {
+                if constexpr (std::is_integral_v<ToFieldType> && !IsTimeType<ToDataType>) {
+                    parsed = read_int_text_fast_impl(
+                            vec_to[i], reinterpret_cast<const char*>(&(*chars)[current_offset]),
+                            string_size);
+                } else {
+                    parsed = false;
+                }
+
+                if (!parsed) {
                     parsed = try_parse_impl<ToDataType>(vec_to[i], read_buffer, local_time_zone);
 
                     parsed = parsed && is_all_read(read_buffer);
@@ -68,7 +68,7 @@ public:
     Status execute_impl(FunctionContext* context, Block& block, const ColumnNumbers& arguments,
                         size_t result, size_t input_rows_count) override {
         auto column = Impl::ReturnColVec::create();
-        column->get_data().emplace_back(Impl::init_value());
+        column->insert_value(Impl::init_value());
         block.replace_by_position(result, ColumnConst::create(std::move(column), 1));
         return Status::OK();
     }
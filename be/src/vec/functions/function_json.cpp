@@ -16,10 +16,12 @@
 // under the License.
 
 #include <rapidjson/document.h>
+#include <rapidjson/reader.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 #include <boost/token_functions.hpp>
 #include <boost/tokenizer.hpp>
+#include <cctype>
 
 #include "exprs/json_functions.h"
 #include "vec/columns/column_nullable.h"
@@ -178,80 +180,222 @@ rapidjson::Value* match_value(const std::vector<JsonPath>& parsed_paths, rapidjs
     return root;
 }
 
-template <JsonFunctionType fntype>
-rapidjson::Value* get_json_object(const std::string_view& json_string,
-                                  const std::string_view& path_string,
-                                  rapidjson::Document* document) {
-    std::vector<JsonPath>* parsed_paths;
-    std::vector<JsonPath> tmp_parsed_paths;
+// The parsed path of get_json_*. A constant path is parsed once in prepare().
+struct ParsedJsonPath {
+    std::vector<JsonPath> paths;
+    // All the components after "$" are object keys, without array indexes. The value of
+    // such a path is found by JsonPathLocator, without building the DOM of the document.
+    bool is_object_keys = false;
+};
 
+void parse_json_path(const std::string_view& path_string, ParsedJsonPath* path) {
     boost::tokenizer<boost::escaped_list_separator<char>> tok(
             path_string, boost::escaped_list_separator<char>("\\", ".", "\""));
-    std::vector<std::string> paths(tok.begin(), tok.end());
-    get_parsed_paths(paths, &tmp_parsed_paths);
-    parsed_paths = &tmp_parsed_paths;
+    std::vector<std::string> path_exprs(tok.begin(), tok.end());
+    path->paths.clear();
+    get_parsed_paths(path_exprs, &path->paths);
+
+    path->is_object_keys = path->paths.size() > 1 && path->paths[0].is_valid;
+    for (int i = 1; i < path->paths.size() && path->is_object_keys; ++i) {
+        const auto& json_path = path->paths[i];
+        path->is_object_keys = json_path.is_valid && !json_path.key.empty() && json_path.idx == -1;
+    }
+}
 
-    if (!(*parsed_paths)[0].is_valid) {
-        return document;
+// SAX handler which finds the value of a path of object keys, and stops the parsing as soon as
+// the value is complete. The value is the first member with the key at each level, same as
+// rapidjson::Value::FindMember().
+//
+// Array members of a path are flattened by match_value(), so the locator gives up when it
+// meets an array on the path, and the document is parsed into a DOM instead.
+class JsonPathLocator : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, JsonPathLocator> {
+public:
+    enum Result { NOT_FOUND, FOUND, USE_DOM };
+
+    JsonPathLocator(const std::vector<JsonPath>& paths, const rapidjson::StringStream& stream)
+            : _paths(paths), _last_depth(paths.size() - 1), _stream(stream) {}
+
+    Result result() const { return _result; }
+    // [value_begin(), value_end()) contains the value, maybe with the ':' before it
+    size_t value_begin() const { return _value_begin; }
+    size_t value_end() const { return _value_end; }
+
+    bool StartObject() {
+        if (!_start_value(true)) {
+            return false;
+        }
+        ++_depth;
+        return true;
+    }
+    bool StartArray() {
+        if (!_start_value(false)) {
+            return false;
+        }
+        ++_depth;
+        return true;
+    }
+    bool EndObject(rapidjson::SizeType) { return _end_container(); }
+    bool EndArray(rapidjson::SizeType) { return _end_container(); }
+
+    bool Key(const char* str, rapidjson::SizeType len, bool) {
+        // only the keys of the object on the path at the current level are compared
+        if (_depth == _matched && _target_depth < 0) {
+            const std::string& key = _paths[_depth].key;
+            if (key.size() == len && memcmp(key.data(), str, len) == 0) {
+                _on_path = true;
+                _value_begin = _stream.Tell();
+            }
+        }
+        return true;
     }
 
-    if (UNLIKELY((*parsed_paths).size() == 1)) {
-        if (fntype == JSON_FUN_STRING) {
-            document->SetString(json_string.data(), document->GetAllocator());
+    // all the scalar values
+    bool Default() {
+        if (_on_path) {
+            _on_path = false;
+            if (_depth == _last_depth) {
+                _value_end = _stream.Tell();
+                _result = FOUND;
+            }
+            // a scalar in the middle of the path, the path is not found
+            return false;
+        }
+        return true;
+    }
+
+private:
+    bool _start_value(bool is_object) {
+        if (_depth == 0) {
+            // the root, an object is required by the first key
+            _on_path = is_object;
+            if (!is_object) {
+                _result = USE_DOM;
+                return false;
+            }
+        }
+        if (!_on_path) {
+            return true;
+        }
+        _on_path = false;
+        if (_depth == _last_depth) {
+            _target_depth = _depth + 1;
+        } else if (is_object) {
+            _matched = _depth + 1;
         } else {
-            return document;
+            _result = USE_DOM;
+            return false;
         }
+        return true;
     }
 
-    document->Parse(json_string.data());
-    if (UNLIKELY(document->HasParseError())) {
-        // VLOG_CRITICAL << "Error at offset " << document->GetErrorOffset() << ": "
-        //         << GetParseError_En(document->GetParseError());
-        document->SetNull();
-        return document;
+    bool _end_container() {
+        if (_depth == _target_depth) {
+            _value_end = _stream.Tell();
+            _result = FOUND;
+            return false;
+        }
+        if (_depth == _matched) {
+            // the object on the path has no member of the key
+            return false;
+        }
+        --_depth;
+        return true;
     }
 
-    return match_value(*parsed_paths, document, document->GetAllocator());
-}
+    const std::vector<JsonPath>& _paths;
+    // depth of the object with the last key of the path
+    const int _last_depth;
+    const rapidjson::StringStream& _stream;
+    Result _result = NOT_FOUND;
+    // number of the open objects and arrays
+    int _depth = 0;
+    // depth of the deepest object on the path
+    int _matched = 0;
+    // depth of the target object or array, which is being skipped
+    int _target_depth = -1;
+    // the next value is on the path
+    bool _on_path = false;
+    size_t _value_begin = 0;
+    size_t _value_end = 0;
+};
 
-template <typename NumberType>
-struct GetJsonNumberType {
-    using ReturnType = typename NumberType::ReturnType;
-    using ColumnType = typename NumberType::ColumnType;
-    using Container = typename ColumnType::Container;
-    static void vector_vector(const ColumnString::Chars& ldata,
-                              const ColumnString::Offsets& loffsets,
-                              const ColumnString::Chars& rdata,
-                              const ColumnString::Offsets& roffsets, Container& res,
-                              NullMap& null_map) {
-        size_t size = loffsets.size();
-        res.resize(size);
-        for (size_t i = 0; i < size; ++i) {
-            const char* l_raw_str = reinterpret_cast<const char*>(&ldata[loffsets[i - 1]]);
-            int l_str_size = loffsets[i] - loffsets[i - 1] - 1;
+// Parses the json strings of a column. The parser, the parse stack and the memory of the
+// documents are reused across rows.
+class JsonParser {
+public:
+    JsonParser() : _allocator(_buffer, sizeof(_buffer)), _document(&_allocator) {}
+
+    // Returns the value of the path in the json string, the result is valid until the next
+    // call. json_string must be followed by '\0', as the strings of ColumnString are.
+    template <JsonFunctionType fntype>
+    rapidjson::Value* get_json_object(const std::string_view& json_string,
+                                      const ParsedJsonPath& path) {
+        _document.SetNull();
+        _allocator.Clear();
+
+        const std::vector<JsonPath>& parsed_paths = path.paths;
+        if (parsed_paths.empty() || !parsed_paths[0].is_valid) {
+            return &_document;
+        }
 
-            const char* r_raw_str = reinterpret_cast<const char*>(&rdata[roffsets[i - 1]]);
-            int r_str_size = roffsets[i] - roffsets[i - 1] - 1;
+        if (UNLIKELY(parsed_paths.size() == 1)) {
+            if (fntype != JSON_FUN_STRING) {
+                return &_document;
+            }
+        }
 
-            if (null_map[i]) {
-                res[i] = 0;
-                continue;
+        if (path.is_object_keys) {
+            rapidjson::StringStream stream(json_string.data());
+            JsonPathLocator locator(parsed_paths, stream);
+            _reader.Parse(stream, locator);
+            switch (locator.result()) {
+            case JsonPathLocator::NOT_FOUND:
+                return nullptr;
+            case JsonPathLocator::FOUND: {
+                // skip the ':' before the value
+                const char* begin = json_string.data() + locator.value_begin();
+                const char* end = json_string.data() + locator.value_end();
+                while (begin < end && (*begin == ':' || isspace(*begin))) {
+                    ++begin;
+                }
+                _document.Parse(begin, end - begin);
+                return _document.HasParseError() ? nullptr : &_document;
+            }
+            case JsonPathLocator::USE_DOM:
+                break;
             }
+        }
 
-            std::string_view json_string(l_raw_str, l_str_size);
-            std::string_view path_string(r_raw_str, r_str_size);
+        _document.Parse(json_string.data());
+        if (UNLIKELY(_document.HasParseError())) {
+            // VLOG_CRITICAL << "Error at offset " << document->GetErrorOffset() << ": "
+            //         << GetParseError_En(document->GetParseError());
+            _document.SetNull();
+            return &_document;
+        }
 
-            rapidjson::Document document;
-            rapidjson::Value* root = nullptr;
+        return match_value(parsed_paths, &_document, _allocator);
+    }
 
-            if constexpr (std::is_same_v<double, typename NumberType::T>) {
-                root = get_json_object<JSON_FUN_DOUBLE>(json_string, path_string, &document);
-                handle_result<double>(root, res[i], null_map[i]);
-            } else if constexpr (std::is_same_v<int32_t, typename NumberType::T>) {
-                root = get_json_object<JSON_FUN_DOUBLE>(json_string, path_string, &document);
-                handle_result<int32_t>(root, res[i], null_map[i]);
-            }
-        }
+private:
+    char _buffer[16 * 1024];
+    rapidjson::MemoryPoolAllocator<> _allocator;
+    rapidjson::Document _document;
+    rapidjson::Reader _reader;
+};
+
+template <typename NumberType>
+struct GetJsonNumberType {
+    using ReturnType = typename NumberType::ReturnType;
+    using ColumnType = typename NumberType::ColumnType;
+    static constexpr JsonFunctionType fntype = JSON_FUN_DOUBLE;
+
+    static void reserve(ColumnType& res, size_t rows) { res.get_data().resize(rows); }
+
+    static void insert_result(rapidjson::Value* root, size_t i, ColumnType& res,
+                              NullMap& null_map) {
+        res.get_data()[i] = 0;
+        handle_result<typename NumberType::T>(root, res.get_data()[i], null_map[i]);
     }
 
     template <typename T, std::enable_if_t<std::is_same_v<double, T>, T>* = nullptr>
@@ -307,58 +451,127 @@ struct GetJsonString {
     static constexpr auto name = "get_json_string";
     using ReturnType = DataTypeString;
     using ColumnType = ColumnString;
-    using Chars = ColumnString::Chars;
-    using Offsets = ColumnString::Offsets;
-    static void vector_vector(const Chars& ldata, const Offsets& loffsets, const Chars& rdata,
-                              const Offsets& roffsets, Chars& res_data, Offsets& res_offsets,
-                              NullMap& null_map) {
-        size_t input_rows_count = loffsets.size();
-        res_offsets.resize(input_rows_count);
+    static constexpr JsonFunctionType fntype = JSON_FUN_STRING;
 
-        for (size_t i = 0; i < input_rows_count; ++i) {
-            int l_size = loffsets[i] - loffsets[i - 1] - 1;
-            const auto l_raw = reinterpret_cast<const char*>(&ldata[loffsets[i - 1]]);
+    static void reserve(ColumnType& res, size_t rows) { res.get_offsets().resize(rows); }
 
-            int r_size = roffsets[i] - roffsets[i - 1] - 1;
-            const auto r_raw = reinterpret_cast<const char*>(&rdata[loffsets[i - 1]]);
-
-            if (null_map[i]) {
-                StringOP::push_null_string(i, res_data, res_offsets, null_map);
-                continue;
-            }
+    static void insert_result(rapidjson::Value* root, size_t i, ColumnType& res,
+                              NullMap& null_map) {
+        auto& res_data = res.get_chars();
+        auto& res_offsets = res.get_offsets();
+        const int max_string_len = 65535;
 
-            std::string_view json_string(l_raw, l_size);
-            std::string_view path_string(r_raw, r_size);
+        if (root == nullptr || root->IsNull()) {
+            StringOP::push_null_string(i, res_data, res_offsets, null_map);
+        } else if (root->IsString()) {
+            const auto ptr = root->GetString();
+            size_t len = strnlen(ptr, max_string_len);
+            StringOP::push_value_string(std::string_view(ptr, len), i, res_data, res_offsets);
+        } else {
+            rapidjson::StringBuffer buf;
+            rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
+            root->Accept(writer);
 
-            rapidjson::Document document;
-            rapidjson::Value* root = nullptr;
+            const auto ptr = buf.GetString();
+            size_t len = strnlen(ptr, max_string_len);
+            StringOP::push_value_string(std::string_view(ptr, len), i, res_data, res_offsets);
+        }
+    }
+};
 
-            root = get_json_object<JSON_FUN_STRING>(json_string, path_string, &document);
-            const int max_string_len = 65535;
+// get_json_xxx(json, path). A constant path is parsed once per FunctionContext, and a path
+// column is parsed again only when it changes.
+template <typename Impl>
+class FunctionGetJson : public IFunction {
+public:
+    static constexpr auto name = Impl::name;
+    static FunctionPtr create() { return std::make_shared<FunctionGetJson>(); }
+    String get_name() const override { return name; }
+    size_t get_number_of_arguments() const override { return 2; }
+    DataTypePtr get_return_type_impl(const DataTypes& arguments) const override {
+        return make_nullable(std::make_shared<typename Impl::ReturnType>());
+    }
+    bool use_default_implementation_for_constants() const override { return true; }
 
-            if (root == nullptr || root->IsNull()) {
-                null_map[i] = 1;
-                StringOP::push_null_string(i, res_data, res_offsets, null_map);
-            } else if (root->IsString()) {
-                const auto ptr = root->GetString();
-                size_t len = strnlen(ptr, max_string_len);
-                StringOP::push_value_string(std::string_view(ptr, len), i, res_data, res_offsets);
-            } else {
-                rapidjson::StringBuffer buf;
-                rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
-                root->Accept(writer);
+    Status prepare(FunctionContext* context, FunctionContext::FunctionStateScope scope) override {
+        if (scope != FunctionContext::FRAGMENT_LOCAL || !context->is_col_constant(1)) {
+            return Status::OK();
+        }
+        StringRef path_string = context->get_constant_col(1)->column_ptr->get_data_at(0);
+        if (path_string.data == nullptr) {
+            return Status::OK();
+        }
+        auto* path = new ParsedJsonPath();
+        parse_json_path(std::string_view(path_string.data, path_string.size), path);
+        context->set_function_state(scope, path);
+        return Status::OK();
+    }
 
-                const auto ptr = buf.GetString();
-                size_t len = strnlen(ptr, max_string_len);
-                StringOP::push_value_string(std::string_view(ptr, len), i, res_data, res_offsets);
+    Status execute_impl(FunctionContext* context, Block& block, const ColumnNumbers& arguments,
+                        size_t result, size_t input_rows_count) override {
+        auto null_map = ColumnUInt8::create(input_rows_count, 0);
+        ColumnPtr argument_columns[2];
+        for (int i = 0; i < 2; ++i) {
+            argument_columns[i] =
+                    block.get_by_position(arguments[i]).column->convert_to_full_column_if_const();
+            if (auto* nullable = check_and_get_column<ColumnNullable>(*argument_columns[i])) {
+                argument_columns[i] = nullable->get_nested_column_ptr();
+                VectorizedUtils::update_null_map(null_map->get_data(),
+                                                 nullable->get_null_map_data());
+            }
+        }
+        const auto& json_column = assert_cast<const ColumnString&>(*argument_columns[0]);
+        const auto& path_column = assert_cast<const ColumnString&>(*argument_columns[1]);
+        auto& null_map_data = null_map->get_data();
+
+        const auto* const_path = reinterpret_cast<const ParsedJsonPath*>(
+                context->get_function_state(FunctionContext::FRAGMENT_LOCAL));
+        ParsedJsonPath row_path;
+        StringRef last_path_string;
+        bool has_row_path = false;
+        auto parser = std::make_unique<JsonParser>();
+
+        auto res = Impl::ColumnType::create();
+        Impl::reserve(*res, input_rows_count);
+        for (size_t i = 0; i < input_rows_count; ++i) {
+            if (null_map_data[i]) {
+                Impl::insert_result(nullptr, i, *res, null_map_data);
+                continue;
+            }
+            const ParsedJsonPath* path = const_path;
+            if (path == nullptr) {
+                StringRef path_string = path_column.get_data_at(i);
+                if (!has_row_path || path_string != last_path_string) {
+                    parse_json_path(std::string_view(path_string.data, path_string.size),
+                                    &row_path);
+                    last_path_string = path_string;
+                    has_row_path = true;
+                }
+                path = &row_path;
             }
+            StringRef json_string = json_column.get_data_at(i);
+            rapidjson::Value* root = parser->get_json_object<Impl::fntype>(
+                    std::string_view(json_string.data, json_string.size), *path);
+            Impl::insert_result(root, i, *res, null_map_data);
+        }
+
+        block.get_by_position(result).column =
+                ColumnNullable::create(std::move(res), std::move(null_map));
+        return Status::OK();
+    }
+
+    Status close(FunctionContext* context, FunctionContext::FunctionStateScope scope) override {
+        if (scope == FunctionContext::FRAGMENT_LOCAL) {
+            delete reinterpret_cast<ParsedJsonPath*>(
+                    context->get_function_state(FunctionContext::FRAGMENT_LOCAL));
         }
+        return Status::OK();
     }
 };
 
-using FunctionGetJsonDouble = FunctionBinaryStringOperateToNullType<GetJsonDouble>;
-using FunctionGetJsonInt = FunctionBinaryStringOperateToNullType<GetJsonInt>;
-using FunctionGetJsonString = FunctionBinaryStringOperateToNullType<GetJsonString>;
+using FunctionGetJsonDouble = FunctionGetJson<GetJsonDouble>;
+using FunctionGetJsonInt = FunctionGetJson<GetJsonInt>;
+using FunctionGetJsonString = FunctionGetJson<GetJsonString>;
 
 void register_function_json(SimpleFunctionFactory& factory) {
     factory.register_function<FunctionGetJsonInt>();
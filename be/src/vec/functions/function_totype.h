@@ -18,7 +18,7 @@
 #pragma once
 #include <fmt/format.h>
 
-#include "vec/columns/column_complex.h"
+#include "vec/columns/column_bitmap.h"
 #include "vec/columns/column_string.h"
 #include "vec/columns/column_vector.h"
 #include "vec/data_types/data_type.h"
@@ -32,6 +32,17 @@
 
 namespace doris::vectorized {
 
+// The data of a column passed to the Impls. The bitmaps are serialized in ColumnBitmap, so the
+// column itself is passed.
+template <typename Column>
+decltype(auto) get_column_data(Column& column) {
+    if constexpr (std::is_same_v<std::remove_const_t<Column>, ColumnBitmap>) {
+        return (column);
+    } else {
+        return (column.get_data());
+    }
+}
+
 // support string->complex/primary
 // support primary/complex->primary/complex
 // support primary -> string
@@ -76,11 +87,9 @@ private:
                 return Status::OK();
             }
         } else if constexpr (is_complex_v<typename Impl::Type>) {
-            if (const auto* col = check_and_get_column<ColumnComplexType<typename Impl::Type>>(
-                        column.get())) {
+            if (const auto* col = check_and_get_column<ColumnBitmap>(column.get())) {
                 auto col_res = Impl::ReturnColumnType::create();
-                RETURN_IF_ERROR(Impl::vector(col->get_data(), col_res->get_chars(),
-                                             col_res->get_offsets()));
+                RETURN_IF_ERROR(Impl::vector(*col, col_res->get_chars(), col_res->get_offsets()));
                 block.replace_by_position(result, std::move(col_res));
                 return Status::OK();
             }
@@ -97,8 +106,8 @@ private:
         if constexpr (Impl::TYPE_INDEX == TypeIndex::String) {
             if (const ColumnString* col = check_and_get_column<ColumnString>(column.get())) {
                 auto col_res = Impl::ReturnColumnType::create();
-                RETURN_IF_ERROR(
-                        Impl::vector(col->get_chars(), col->get_offsets(), col_res->get_data()));
+                RETURN_IF_ERROR(Impl::vector(col->get_chars(), col->get_offsets(),
+                                             get_column_data(*col_res)));
                 block.replace_by_position(result, std::move(col_res));
                 return Status::OK();
             }
@@ -111,10 +120,9 @@ private:
                 return Status::OK();
             }
         } else if constexpr (is_complex_v<typename Impl::Type>) {
-            if (const auto* col = check_and_get_column<ColumnComplexType<typename Impl::Type>>(
-                        column.get())) {
+            if (const auto* col = check_and_get_column<ColumnBitmap>(column.get())) {
                 auto col_res = Impl::ReturnColumnType::create();
-                RETURN_IF_ERROR(Impl::vector(col->get_data(), col_res->get_data()));
+                RETURN_IF_ERROR(Impl::vector(*col, get_column_data(*col_res)));
                 block.replace_by_position(result, std::move(col_res));
                 return Status::OK();
             }
@@ -154,25 +162,26 @@ public:
         using T1 = typename RightDataType::FieldType;
         using ResultType = typename ResultDataType::FieldType;
 
-        using ColVecLeft =
-                std::conditional_t<is_complex_v<T0>, ColumnComplexType<T0>, ColumnVector<T0>>;
-        using ColVecRight =
-                std::conditional_t<is_complex_v<T1>, ColumnComplexType<T1>, ColumnVector<T1>>;
+        using ColVecLeft = std::conditional_t<is_complex_v<T0>, ColumnBitmap, ColumnVector<T0>>;
+        using ColVecRight = std::conditional_t<is_complex_v<T1>, ColumnBitmap, ColumnVector<T1>>;
 
-        using ColVecResult =
-                std::conditional_t<is_complex_v<ResultType>, ColumnComplexType<ResultType>,
-                                   ColumnVector<ResultType>>;
+        using ColVecResult = std::conditional_t<is_complex_v<ResultType>, ColumnBitmap,
+                                                ColumnVector<ResultType>>;
 
         typename ColVecResult::MutablePtr col_res = nullptr;
 
         col_res = ColVecResult::create();
-        auto& vec_res = col_res->get_data();
-        vec_res.resize(block.rows());
+        auto& vec_res = get_column_data(*col_res);
+        // the bitmaps are appended by the Impl
+        if constexpr (!is_complex_v<ResultType>) {
+            vec_res.resize(block.rows());
+        }
 
         if (auto col_left = check_and_get_column<ColVecLeft>(lcol.get())) {
             if (auto col_right = check_and_get_column<ColVecRight>(rcol.get())) {
-                Impl<LeftDataType, RightDataType>::vector_vector(col_left->get_data(),
-                                                                 col_right->get_data(), vec_res);
+                Impl<LeftDataType, RightDataType>::vector_vector(get_column_data(*col_left),
+                                                                 get_column_data(*col_right),
+                                                                 vec_res);
                 block.replace_by_position(result, std::move(col_res));
                 return Status::OK();
             }
@@ -295,25 +304,26 @@ public:
         using T1 = typename RightDataType::FieldType;
         using ResultType = typename ResultDataType::FieldType;
 
-        using ColVecLeft =
-                std::conditional_t<is_complex_v<T0>, ColumnComplexType<T0>, ColumnVector<T0>>;
-        using ColVecRight =
-                std::conditional_t<is_complex_v<T1>, ColumnComplexType<T1>, ColumnVector<T1>>;
+        using ColVecLeft = std::conditional_t<is_complex_v<T0>, ColumnBitmap, ColumnVector<T0>>;
+        using ColVecRight = std::conditional_t<is_complex_v<T1>, ColumnBitmap, ColumnVector<T1>>;
 
-        using ColVecResult =
-                std::conditional_t<is_complex_v<ResultType>, ColumnComplexType<ResultType>,
-                                   ColumnVector<ResultType>>;
+        using ColVecResult = std::conditional_t<is_complex_v<ResultType>, ColumnBitmap,
+                                                ColumnVector<ResultType>>;
 
         typename ColVecResult::MutablePtr col_res = nullptr;
 
         col_res = ColVecResult::create();
-        auto& vec_res = col_res->get_data();
-        vec_res.resize(block.rows());
+        auto& vec_res = get_column_data(*col_res);
+        // the bitmaps are appended by the Impl
+        if constexpr (!is_complex_v<ResultType>) {
+            vec_res.resize(block.rows());
+        }
 
         if (auto col_left = check_and_get_column<ColVecLeft>(argument_columns[0].get())) {
             if (auto col_right = check_and_get_column<ColVecRight>(argument_columns[1].get())) {
                 Impl<LeftDataType, RightDataType>::vector_vector(
-                        col_left->get_data(), col_right->get_data(), vec_res, null_map->get_data());
+                        get_column_data(*col_left), get_column_data(*col_right), vec_res,
+                        null_map->get_data());
                 block.get_by_position(result).column =
                         ColumnNullable::create(std::move(col_res), std::move(null_map));
                 return Status::OK();
@@ -20,6 +20,7 @@
 
 #include "exprs/create_predicate_function.h"
 
+#include "util/binary_cast.hpp"
 #include "vec/columns/column_const.h"
 #include "vec/columns/column_nullable.h"
 #include "vec/columns/column_set.h"
@@ -28,14 +29,15 @@
 #include "vec/data_types/data_type_number.h"
 #include "vec/functions/function.h"
 #include "vec/functions/simple_function_factory.h"
+#include "vec/runtime/vdatetime_value.h"
 
 namespace doris::vectorized {
 
 struct InState {
-    bool use_set;
+    bool use_set = true;
 
     // only use in null in set
-    bool null_in_set;
+    bool null_in_set = false;
     std::unique_ptr<HybridSetBase> hybrid_set;
 };
 
@@ -67,8 +69,8 @@ public:
         }
         auto* state = new InState();
         context->set_function_state(scope, state);
-        state->hybrid_set.reset(create_set(convert_type_to_primitive(
-                context->get_arg_type(0)->type)));
+        PrimitiveType type = convert_type_to_primitive(context->get_arg_type(0)->type);
+        state->hybrid_set.reset(create_set(type));
 
         DCHECK(context->get_num_args() > 1);
         for (int i = 1; i < context->get_num_args(); ++i) {
@@ -77,6 +79,13 @@ public:
                 auto const_data = const_column_ptr->column_ptr->get_data_at(0);
                 if (const_data.data == nullptr) {
                     state->null_in_set = true;
+                } else if (type == TYPE_DATE || type == TYPE_DATETIME) {
+                    // the set keeps DateTimeValue, same as the IN runtime filter
+                    DateTimeValue value;
+                    binary_cast<Int64, VecDateTimeValue>(
+                            *reinterpret_cast<const Int64*>(const_data.data))
+                            .convert_vec_dt_to_dt(&value);
+                    state->hybrid_set->insert(&value);
                 } else {
                     state->hybrid_set->insert((void *) const_data.data, const_data.size);
                 }
@@ -101,53 +110,64 @@ public:
         vec_res.resize(input_rows_count);
 
         ColumnUInt8::MutablePtr col_null_map_to;
-        col_null_map_to = ColumnUInt8::create(input_rows_count);
+        col_null_map_to = ColumnUInt8::create(input_rows_count, 0);
         auto& vec_null_map_to = col_null_map_to->get_data();
 
         /// First argument may be a single column.
         const ColumnWithTypeAndName& left_arg = block.get_by_position(arguments[0]);
         auto materialized_column = left_arg.column->convert_to_full_column_if_const();
+        const IColumn* nested_column = materialized_column.get();
+        const uint8_t* null_map = nullptr;
+        if (const auto* nullable = check_and_get_column<ColumnNullable>(*materialized_column)) {
+            nested_column = &nullable->get_nested_column();
+            null_map = nullable->get_null_map_data().data();
+        }
 
         if (in_state->use_set) {
+            in_state->hybrid_set->find_batch(*nested_column, null_map, vec_res.data());
             for (size_t i = 0; i < input_rows_count; ++i) {
-                const auto& ref_data = materialized_column->get_data_at(i);
-                if (ref_data.data) {
-                    vec_res[i] = negative ^ in_state->hybrid_set->find((void *) ref_data.data, ref_data.size);
-                    if (in_state->null_in_set) {
-                        vec_null_map_to[i] = negative == vec_res[i];
-                    }
-                } else {
-                    vec_null_map_to[i] = true;
+                vec_res[i] ^= negative;
+            }
+            if (in_state->null_in_set) {
+                for (size_t i = 0; i < input_rows_count; ++i) {
+                    vec_null_map_to[i] = negative == vec_res[i];
                 }
             }
         } else {
+            // The values are compared with the other arguments of the same row directly,
+            // building a set for each row costs more than the comparisons.
             std::vector<ColumnPtr> set_columns;
+            std::vector<const IColumn*> nested_set_columns;
+            std::vector<const uint8_t*> set_null_maps;
             for (int i = 1; i < arguments.size(); ++i) {
-                set_columns.emplace_back(block.get_by_position(arguments[i]).column);
+                auto& set_column = set_columns.emplace_back(
+                        block.get_by_position(arguments[i]).column->convert_to_full_column_if_const());
+                if (const auto* nullable = check_and_get_column<ColumnNullable>(*set_column)) {
+                    nested_set_columns.push_back(&nullable->get_nested_column());
+                    set_null_maps.push_back(nullable->get_null_map_data().data());
+                } else {
+                    nested_set_columns.push_back(set_column.get());
+                    set_null_maps.push_back(nullptr);
+                }
             }
 
             for (size_t i = 0; i < input_rows_count; ++i) {
-                const auto& ref_data = materialized_column->get_data_at(i);
-                if (ref_data.data == nullptr) {
-                    vec_null_map_to[i] = true;
-                    continue;
-                }
-
-                std::unique_ptr<HybridSetBase> hybrid_set(create_set(convert_type_to_primitive(
-                context->get_arg_type(0)->type)));
+                bool found = false;
                 bool null_in_set = false;
-
-                for (const auto& set_column : set_columns) {
-                    auto set_data = set_column->get_data_at(i);
-                    if (set_data.data == nullptr)
+                for (size_t j = 0; j < nested_set_columns.size() && !found; ++j) {
+                    if (set_null_maps[j] != nullptr && set_null_maps[j][i]) {
                         null_in_set = true;
-                    else
-                        hybrid_set->insert((void *)(set_data.data), set_data.size);
-                }
-                vec_res[i] = negative ^ hybrid_set->find((void *) ref_data.data, ref_data.size);
-                if (null_in_set) {
-                    vec_null_map_to[i] = negative == vec_res[i];
+                    } else {
+                        found = nested_column->compare_at(i, i, *nested_set_columns[j], 1) == 0;
+                    }
                 }
+                vec_res[i] = negative ^ found;
+                vec_null_map_to[i] = !found && null_in_set;
+            }
+        }
+        if (null_map != nullptr) {
+            for (size_t i = 0; i < input_rows_count; ++i) {
+                vec_null_map_to[i] |= null_map[i];
             }
         }
 
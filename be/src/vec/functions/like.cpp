@@ -17,6 +17,8 @@
 
 #include "vec/functions/like.h"
 
+#include <algorithm>
+
 #include "runtime/string_value.h"
 #include "runtime/string_value.hpp"
 #include "vec/columns/column_const.h"
@@ -49,51 +51,95 @@ static const re2::RE2 LIKE_ENDS_WITH_RE("(?:%+)(((\\\\%)|(\\\\_)|([^%_]))+)");
 static const re2::RE2 LIKE_STARTS_WITH_RE("(((\\\\%)|(\\\\_)|([^%_]))+)(?:%+)");
 static const re2::RE2 LIKE_EQUALS_RE("(((\\\\%)|(\\\\_)|([^%_]))+)");
 
-Status FunctionLikeBase::constant_starts_with_fn(LikeSearchState* state, const StringValue& val,
-                                          const StringValue& pattern, unsigned char* result) {
-    *result = (val.len >= state->search_string_sv.len) &&
-              (state->search_string_sv == val.substring(0, state->search_string_sv.len));
+// Sets result[i] to matcher(begin, end) of the i-th value.
+template <typename Matcher>
+static void match_rows(const ColumnString& values, ColumnUInt8::Container& result,
+                       Matcher matcher) {
+    const auto& chars = values.get_chars();
+    const auto& offsets = values.get_offsets();
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        const char* begin = reinterpret_cast<const char*>(&chars[offsets[i - 1]]);
+        result[i] = matcher(begin, begin + (offsets[i] - offsets[i - 1] - 1));
+    }
+}
+
+Status FunctionLikeBase::constant_starts_with_fn(LikeSearchState* state,
+                                                 const ColumnString& values,
+                                                 ColumnUInt8::Container& result) {
+    const std::string& needle = state->search_string;
+    match_rows(values, result, [&needle](const char* begin, const char* end) {
+        return static_cast<size_t>(end - begin) >= needle.size() &&
+               memcmp(begin, needle.data(), needle.size()) == 0;
+    });
     return Status::OK();
 }
 
-Status FunctionLikeBase::constant_ends_with_fn(LikeSearchState* state, const StringValue& val,
-                                        const StringValue& pattern, unsigned char* result) {
-    *result = (val.len >= state->search_string_sv.len) &&
-              (state->search_string_sv ==
-               val.substring(val.len - state->search_string_sv.len, state->search_string_sv.len));
+Status FunctionLikeBase::constant_ends_with_fn(LikeSearchState* state, const ColumnString& values,
+                                               ColumnUInt8::Container& result) {
+    const std::string& needle = state->search_string;
+    match_rows(values, result, [&needle](const char* begin, const char* end) {
+        return static_cast<size_t>(end - begin) >= needle.size() &&
+               memcmp(end - needle.size(), needle.data(), needle.size()) == 0;
+    });
     return Status::OK();
 }
 
-Status FunctionLikeBase::constant_equals_fn(LikeSearchState* state, const StringValue& val,
-                                     const StringValue& pattern, unsigned char* result) {
-    *result = (val == state->search_string_sv);
+Status FunctionLikeBase::constant_equals_fn(LikeSearchState* state, const ColumnString& values,
+                                            ColumnUInt8::Container& result) {
+    const std::string& needle = state->search_string;
+    match_rows(values, result, [&needle](const char* begin, const char* end) {
+        return static_cast<size_t>(end - begin) == needle.size() &&
+               memcmp(begin, needle.data(), needle.size()) == 0;
+    });
     return Status::OK();
 }
 
-Status FunctionLikeBase::constant_substring_fn(LikeSearchState* state, const StringValue& val,
-                                        const StringValue& pattern, unsigned char* result) {
-    if (state->search_string_sv.len == 0) {
-        *result = true;
+Status FunctionLikeBase::constant_substring_fn(LikeSearchState* state, const ColumnString& values,
+                                               ColumnUInt8::Container& result) {
+    const StringSearcher& searcher = state->substring_pattern;
+    if (searcher.needle_size() == 0) {
+        std::fill(result.begin(), result.end(), 1);
         return Status::OK();
     }
-    StringValue pattern_value = StringValue::from_string_val(val.ptr);
-    *result = state->substring_pattern.search(&pattern_value) != -1;
+    if (searcher.needle().find('\0') != std::string::npos) {
+        // The match may cross the terminating zero of a value, search in each value.
+        match_rows(values, result, [&searcher](const char* begin, const char* end) {
+            return searcher.search(begin, end) != end;
+        });
+        return Status::OK();
+    }
+
+    // Values are separated by zeros, so a match never crosses values. After a match is found,
+    // the search continues from the next value.
+    const auto& chars = values.get_chars();
+    const auto& offsets = values.get_offsets();
+    std::fill(result.begin(), result.end(), 0);
+    const UInt8* begin = chars.data();
+    const UInt8* end = begin + chars.size();
+    const UInt8* pos = begin;
+    size_t row = 0;
+    while (pos < end) {
+        pos = searcher.search(pos, end);
+        if (pos == end) {
+            break;
+        }
+        row = std::upper_bound(offsets.begin() + row, offsets.end(),
+                               static_cast<size_t>(pos - begin)) -
+              offsets.begin();
+        result[row] = 1;
+        pos = begin + offsets[row];
+        ++row;
+    }
     return Status::OK();
 }
 
 Status FunctionLikeBase::execute_impl(FunctionContext* context, Block& block,
                                const ColumnNumbers& arguments, size_t result,
                                size_t /*input_rows_count*/) {
-    // values and patterns
     const auto values_col =
             block.get_by_position(arguments[0]).column->convert_to_full_column_if_const();
-    const auto pattern_col =
-            block.get_by_position(arguments[1]).column->convert_to_full_column_if_const();
-
     const auto* values = check_and_get_column<ColumnString>(values_col.get());
-    const auto* patterns = check_and_get_column<ColumnString>(pattern_col.get());
-
-    if (!values || !patterns) {
+    if (!values) {
         return Status::InternalError("Not supported input arguments types");
     }
 
@@ -105,8 +151,19 @@ Status FunctionLikeBase::execute_impl(FunctionContext* context, Block& block,
     auto* state = reinterpret_cast<LikeState*>(
             context->get_function_state(FunctionContext::THREAD_LOCAL));
 
-    vector_vector(values->get_chars(), values->get_offsets(), patterns->get_chars(),
-                  patterns->get_offsets(), vec_res, state->function, &state->search_state);
+    if (state->constant_function) {
+        RETURN_IF_ERROR(state->constant_function(&state->search_state, *values, vec_res));
+    } else {
+        const auto pattern_col =
+                block.get_by_position(arguments[1]).column->convert_to_full_column_if_const();
+        const auto* patterns = check_and_get_column<ColumnString>(pattern_col.get());
+        if (!patterns) {
+            return Status::InternalError("Not supported input arguments types");
+        }
+        RETURN_IF_ERROR(vector_vector(values->get_chars(), values->get_offsets(),
+                                      patterns->get_chars(), patterns->get_offsets(), vec_res,
+                                      state->function, &state->search_state));
+    }
 
     block.replace_by_position(result, std::move(res));
     return Status::OK();
@@ -158,9 +215,35 @@ Status FunctionLike::like_fn(LikeSearchState* state, const StringValue& val,
     }
 }
 
-Status FunctionLike::constant_regex_full_fn(LikeSearchState* state, const StringValue& val,
-                                             const StringValue& pattern, unsigned char* result) {
-    *result = RE2::FullMatch(re2::StringPiece(val.ptr, val.len), *state->regex.get());
+Status FunctionLike::constant_segments_fn(LikeSearchState* state, const ColumnString& values,
+                                          ColumnUInt8::Container& result) {
+    const std::string& prefix = state->prefix;
+    const std::string& suffix = state->suffix;
+    match_rows(values, result, [&](const char* begin, const char* end) {
+        if (static_cast<size_t>(end - begin) < prefix.size() + suffix.size() ||
+            memcmp(begin, prefix.data(), prefix.size()) != 0 ||
+            memcmp(end - suffix.size(), suffix.data(), suffix.size()) != 0) {
+            return false;
+        }
+        begin += prefix.size();
+        end -= suffix.size();
+        for (const auto& searcher : state->middle_patterns) {
+            const char* pos = searcher.search(begin, end);
+            if (pos == end) {
+                return false;
+            }
+            begin = pos + searcher.needle_size();
+        }
+        return true;
+    });
+    return Status::OK();
+}
+
+Status FunctionLike::constant_regex_full_fn(LikeSearchState* state, const ColumnString& values,
+                                            ColumnUInt8::Container& result) {
+    match_rows(values, result, [state](const char* begin, const char* end) {
+        return RE2::FullMatch(re2::StringPiece(begin, end - begin), *state->regex);
+    });
     return Status::OK();
 }
 
@@ -193,6 +276,26 @@ void FunctionLike::convert_like_pattern(LikeSearchState* state, const std::strin
     }
 }
 
+bool FunctionLike::split_like_pattern(LikeSearchState* state, const std::string& pattern,
+                                      std::vector<std::string>* parts) {
+    // Escaped characters are literal, as in convert_like_pattern().
+    parts->assign(1, "");
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        if (pattern[i] == state->escape_char) {
+            if (i + 1 < pattern.size()) {
+                parts->back().append(1, pattern[++i]);
+            }
+        } else if (pattern[i] == '%') {
+            parts->emplace_back();
+        } else if (pattern[i] == '_') {
+            return false;
+        } else {
+            parts->back().append(1, pattern[i]);
+        }
+    }
+    return parts->size() > 1;
+}
+
 void FunctionLike::remove_escape_character(std::string* search_string) {
     std::string tmp_search_string;
     tmp_search_string.swap(*search_string);
@@ -222,22 +325,32 @@ Status FunctionLike::prepare(FunctionContext* context, FunctionContext::Function
 
         std::string pattern_str = pattern.to_string();
         std::string search_string;
+        std::vector<std::string> parts;
         if (RE2::FullMatch(pattern_str, LIKE_EQUALS_RE, &search_string)) {
             remove_escape_character(&search_string);
             state->search_state.set_search_string(search_string);
-            state->function = constant_equals_fn;
+            state->constant_function = constant_equals_fn;
         } else if (RE2::FullMatch(pattern_str, LIKE_STARTS_WITH_RE, &search_string)) {
             remove_escape_character(&search_string);
             state->search_state.set_search_string(search_string);
-            state->function = constant_starts_with_fn;
+            state->constant_function = constant_starts_with_fn;
         } else if (RE2::FullMatch(pattern_str, LIKE_ENDS_WITH_RE, &search_string)) {
             remove_escape_character(&search_string);
             state->search_state.set_search_string(search_string);
-            state->function = constant_ends_with_fn;
+            state->constant_function = constant_ends_with_fn;
         } else if (RE2::FullMatch(pattern_str, LIKE_SUBSTRING_RE, &search_string)) {
             remove_escape_character(&search_string);
             state->search_state.set_search_string(search_string);
-            state->function = constant_substring_fn;
+            state->constant_function = constant_substring_fn;
+        } else if (split_like_pattern(&state->search_state, pattern_str, &parts)) {
+            state->search_state.prefix = parts.front();
+            state->search_state.suffix = parts.back();
+            for (size_t i = 1; i + 1 < parts.size(); ++i) {
+                if (!parts[i].empty()) {
+                    state->search_state.middle_patterns.emplace_back(parts[i]);
+                }
+            }
+            state->constant_function = constant_segments_fn;
         } else {
             std::string re_pattern;
             convert_like_pattern(&state->search_state, pattern_str, &re_pattern);
@@ -249,7 +362,7 @@ Status FunctionLike::prepare(FunctionContext* context, FunctionContext::Function
                 return Status::InternalError(
                         fmt::format("Invalid regex expression: {}", pattern_str));
             }
-            state->function = constant_regex_full_fn;
+            state->constant_function = constant_regex_full_fn;
         }
     }
     return Status::OK();
@@ -271,16 +384,16 @@ Status FunctionRegexp::prepare(FunctionContext* context,
         std::string search_string;
         if (RE2::FullMatch(pattern_str, EQUALS_RE, &search_string)) {
             state->search_state.set_search_string(search_string);
-            state->function = constant_equals_fn;
+            state->constant_function = constant_equals_fn;
         } else if (RE2::FullMatch(pattern_str, STARTS_WITH_RE, &search_string)) {
             state->search_state.set_search_string(search_string);
-            state->function = constant_starts_with_fn;
+            state->constant_function = constant_starts_with_fn;
         } else if (RE2::FullMatch(pattern_str, ENDS_WITH_RE, &search_string)) {
             state->search_state.set_search_string(search_string);
-            state->function = constant_ends_with_fn;
+            state->constant_function = constant_ends_with_fn;
         } else if (RE2::FullMatch(pattern_str, SUBSTRING_RE, &search_string)) {
             state->search_state.set_search_string(search_string);
-            state->function = constant_substring_fn;
+            state->constant_function = constant_substring_fn;
         } else {
             RE2::Options opts;
             opts.set_never_nl(false);
@@ -290,16 +403,18 @@ Status FunctionRegexp::prepare(FunctionContext* context,
                 return Status::InternalError(
                         fmt::format("Invalid regex expression: {}", pattern_str));
             }
-            state->function = constant_regex_partial_fn;
+            state->constant_function = constant_regex_partial_fn;
         }
     }
     return Status::OK();
 }
 
-Status FunctionRegexp::constant_regex_partial_fn(LikeSearchState* state, const StringValue& val,
-                                                  const StringValue& pattern,
-                                                  unsigned char* result) {
-    *result = RE2::PartialMatch(re2::StringPiece(val.ptr, val.len), *state->regex);
+Status FunctionRegexp::constant_regex_partial_fn(LikeSearchState* state,
+                                                  const ColumnString& values,
+                                                  ColumnUInt8::Container& result) {
+    match_rows(values, result, [state](const char* begin, const char* end) {
+        return RE2::PartialMatch(re2::StringPiece(begin, end - begin), *state->regex);
+    });
     return Status::OK();
 }
 
@@ -17,14 +17,19 @@
 
 #pragma once
 
+#include <re2/re2.h>
+
 #include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 
-#include "runtime/string_search.hpp"
 #include "runtime/string_value.h"
 #include "vec/columns/column_const.h"
 #include "vec/columns/column_set.h"
+#include "vec/columns/column_string.h"
 #include "vec/columns/columns_number.h"
+#include "vec/common/string_searcher.h"
 #include "vec/data_types/data_type_nullable.h"
 #include "vec/data_types/data_type_number.h"
 #include "vec/exprs/vexpr.h"
@@ -33,25 +38,26 @@
 
 namespace doris::vectorized {
 
-// TODO: replace with std::string_view when `LikeSearchState.substring_pattern` can
-// construct from std::string_view.
 struct LikeSearchState {
     char escape_char;
 
-    /// Holds the string the StringValue points to and is set any time StringValue is
-    /// used.
-    std::string search_string;
-
     /// Used for LIKE predicates if the pattern is a constant argument, and is either a
     /// constant string or has a constant string at the beginning or end of the pattern.
     /// This will be set in order to check for that pattern in the corresponding part of
     /// the string.
-    doris::StringValue search_string_sv;
+    std::string search_string;
 
     /// Used for LIKE predicates if the pattern is a constant argument and has a constant
     /// string in the middle of it. This will be use in order to check for the substring
     /// in the value.
-    doris::StringSearch substring_pattern;
+    StringSearcher substring_pattern;
+
+    /// Used for LIKE predicates if the pattern is a constant argument which only has '%'
+    /// wildcards, e.g. 'a%b%c'. The value must start with prefix and end with suffix, and
+    /// contain the middle parts in order between them.
+    std::string prefix;
+    std::string suffix;
+    std::vector<StringSearcher> middle_patterns;
 
     /// Used for RLIKE and REGEXP predicates if the pattern is a constant argument.
     std::unique_ptr<re2::RE2> regex;
@@ -60,17 +66,23 @@ struct LikeSearchState {
 
     void set_search_string(const std::string& search_string_arg) {
         search_string = search_string_arg;
-        search_string_sv = StringValue(search_string);
-        substring_pattern = StringSearch(&search_string_sv);
+        substring_pattern = StringSearcher(search_string);
     }
 };
 
 using LikeFn = std::function<doris::Status(LikeSearchState* state, const StringValue&,
                                             const StringValue&, unsigned char*)>;
 
+/// Matches all rows of the column against the constant pattern.
+using LikeConstantFn = std::function<doris::Status(
+        LikeSearchState* state, const ColumnString& values, ColumnUInt8::Container& result)>;
+
 struct LikeState {
     LikeSearchState search_state;
+    /// Used if the pattern is not a constant, it's called for each row.
     LikeFn function;
+    /// Set if the pattern is a constant.
+    LikeConstantFn constant_function;
 };
 
 class FunctionLikeBase : public IFunction {
@@ -93,17 +105,18 @@ protected:
                          ColumnUInt8::Container& result, const LikeFn& function,
                          LikeSearchState* search_state);
 
-    static Status constant_starts_with_fn(LikeSearchState* state, const StringValue& val,
-                                          const StringValue& pattern, unsigned char* result);
+    static Status constant_starts_with_fn(LikeSearchState* state, const ColumnString& values,
+                                          ColumnUInt8::Container& result);
 
-    static Status constant_ends_with_fn(LikeSearchState* state, const StringValue& val,
-                                        const StringValue& pattern, unsigned char* result);
+    static Status constant_ends_with_fn(LikeSearchState* state, const ColumnString& values,
+                                        ColumnUInt8::Container& result);
 
-    static Status constant_equals_fn(LikeSearchState* state, const StringValue& val,
-                                     const StringValue& pattern, unsigned char* result);
+    static Status constant_equals_fn(LikeSearchState* state, const ColumnString& values,
+                                     ColumnUInt8::Container& result);
 
-    static Status constant_substring_fn(LikeSearchState* state, const StringValue& val,
-                                        const StringValue& pattern, unsigned char* result);
+    // Scans the chars of the column once, and maps the matches to rows by the offsets.
+    static Status constant_substring_fn(LikeSearchState* state, const ColumnString& values,
+                                        ColumnUInt8::Container& result);
 };
 
 class FunctionLike : public FunctionLikeBase {
@@ -119,12 +132,19 @@ private:
     static Status like_fn(LikeSearchState* state, const StringValue& val,
                           const StringValue& pattern, unsigned char* result);
 
-    static Status constant_regex_full_fn(LikeSearchState* state, const StringValue& val,
-                                         const StringValue& pattern, unsigned char* result);
+    static Status constant_segments_fn(LikeSearchState* state, const ColumnString& values,
+                                       ColumnUInt8::Container& result);
+
+    static Status constant_regex_full_fn(LikeSearchState* state, const ColumnString& values,
+                                         ColumnUInt8::Container& result);
 
     static void convert_like_pattern(LikeSearchState* state, const std::string& pattern,
                                      std::string* re_pattern);
 
+    // Splits the pattern by '%' if it has no '_' wildcard, returns false otherwise.
+    static bool split_like_pattern(LikeSearchState* state, const std::string& pattern,
+                                   std::vector<std::string>* parts);
+
     static void remove_escape_character(std::string* search_string);
 };
 
@@ -141,8 +161,8 @@ private:
     static Status regexp_fn(LikeSearchState* state, const StringValue& val,
                             const StringValue& pattern, unsigned char* result);
 
-    static Status constant_regex_partial_fn(LikeSearchState* state, const StringValue& val,
-                                            const StringValue& pattern, unsigned char* result);
+    static Status constant_regex_partial_fn(LikeSearchState* state, const ColumnString& values,
+                                            ColumnUInt8::Container& result);
 };
 
 void register_function_like(SimpleFunctionFactory& factory) {
@@ -33,6 +33,10 @@ public:
 
     bool use_default_implementation_for_constants() const override { return false; }
 
+    bool is_deterministic() const override { return false; }
+
+    bool is_deterministic_in_scope_of_query() const override { return false; }
+
     size_t get_number_of_arguments() const override { return 0; }
 
     bool is_variadic() const override { return true; }
@@ -19,7 +19,10 @@
 
 #include <snappy/snappy.h>
 
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <type_traits>
 
 #include "gen_cpp/data.pb.h"
 #include "util/binary_cast.hpp"
@@ -73,6 +76,45 @@ inline std::string int128_to_string(UInt128 value) {
     return value.to_hex_string();
 }
 
+inline constexpr char DIGIT_PAIRS[] =
+        "0001020304050607080910111213141516171819"
+        "2021222324252627282930313233343536373839"
+        "4041424344454647484950515253545556575859"
+        "6061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+
+/// Writes the decimal text of an integer, the same as fmt "{}", and returns the end of the
+/// text. Two digits are written at a time from DIGIT_PAIRS.
+template <typename T>
+char* write_int_text(T x, char* to) {
+    static_assert(std::is_integral_v<T>);
+    using UnsignedT = std::make_unsigned_t<T>;
+    UnsignedT value = x;
+    if constexpr (std::is_signed_v<T>) {
+        if (x < 0) {
+            *to++ = '-';
+            value = UnsignedT(0) - value;
+        }
+    }
+
+    char buf[std::numeric_limits<UnsignedT>::digits10 + 1];
+    char* end = buf + sizeof(buf);
+    char* pos = end;
+    while (value >= 100) {
+        pos -= 2;
+        memcpy(pos, DIGIT_PAIRS + (value % 100) * 2, 2);
+        value /= 100;
+    }
+    if (value >= 10) {
+        pos -= 2;
+        memcpy(pos, DIGIT_PAIRS + value * 2, 2);
+    } else {
+        *--pos = '0' + value;
+    }
+    memcpy(to, pos, end - pos);
+    return to + (end - pos);
+}
+
 template <typename T>
 void write_text(Decimal<T> value, UInt32 scale, std::ostream& ostr) {
     if (value < Decimal<T>(0)) {
@@ -338,6 +380,58 @@ bool read_int_text_impl(T& x, ReadBuffer& buf) {
     return true;
 }
 
+/// Parses the texts of an optional sign followed by digits, which are most of the texts cast
+/// to integers, with the same result as read_int_text_impl(). The digits are validated and
+/// converted 8 at a time. Returns false for the other texts, which are left to
+/// read_int_text_impl().
+template <typename T>
+bool read_int_text_fast_impl(T& x, const char* pos, size_t size) {
+    const char* end = pos + size;
+    bool negative = false;
+    if (pos < end && (*pos == '-' || *pos == '+')) {
+        negative = *pos == '-';
+        if (!std::is_signed_v<T> && negative) {
+            return false;
+        }
+        ++pos;
+    }
+    if (pos == end) {
+        return false;
+    }
+
+    // overflows wrap around the same as in read_int_text_impl()
+    using Accumulator = std::conditional_t<(sizeof(T) > sizeof(uint64_t)), unsigned __int128,
+                                           uint64_t>;
+    Accumulator res = 0;
+    for (; end - pos >= 8; pos += 8) {
+        uint64_t chunk;
+        memcpy(&chunk, pos, sizeof(chunk));
+        // a byte is a digit if its high nibble is 3, and still 3 after adding 6
+        if (((chunk & 0xF0F0F0F0F0F0F0F0ULL) |
+             (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) !=
+            0x3333333333333333ULL) {
+            return false;
+        }
+        // little endian, the first digit is the lowest byte
+        uint64_t digits = chunk - 0x3030303030303030ULL;
+        digits = digits * 10 + (digits >> 8);
+        digits = (((digits & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+                  (((digits >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >>
+                 32;
+        res = res * 100000000 + digits;
+    }
+    for (; pos < end; ++pos) {
+        if (*pos < '0' || *pos > '9') {
+            return false;
+        }
+        res = res * 10 + (*pos - '0');
+    }
+
+    auto value = static_cast<std::make_unsigned_t<T>>(res);
+    x = negative ? -value : value;
+    return true;
+}
+
 template <typename T>
 bool read_datetime_text_impl(T& x, ReadBuffer& buf) {
     static_assert(std::is_same_v<Int64, T>);
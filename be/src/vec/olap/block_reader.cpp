@@ -23,6 +23,7 @@
 #include "olap/storage_engine.h"
 #include "runtime/mem_pool.h"
 #include "runtime/mem_tracker.h"
+#include "vec/columns/column_bitmap.h"
 #include "vec/olap/vcollect_iterator.h"
 
 using std::nothrow;
@@ -107,13 +108,15 @@ void BlockReader::_init_agg_state() {
         function->create(place);
         _agg_places.push_back(place);
 
-        //calculate has_string tag
-        _stored_has_string_tag[idx] =
-                _stored_data_columns[idx]->is_column_string() ||
-                (_stored_data_columns[idx]->is_nullable() &&
-                 reinterpret_cast<ColumnNullable*>(_stored_data_columns[idx].get())
-                         ->get_nested_column_ptr()
-                         ->is_column_string());
+        //calculate has_string tag, the bitmaps are also stored like strings
+        const IColumn* nested_column = _stored_data_columns[idx].get();
+        if (nested_column->is_nullable()) {
+            nested_column = reinterpret_cast<const ColumnNullable*>(nested_column)
+                                    ->get_nested_column_ptr()
+                                    .get();
+        }
+        _stored_has_string_tag[idx] = nested_column->is_column_string() ||
+                                      check_and_get_column<ColumnBitmap>(nested_column) != nullptr;
     }
 }
 
@@ -156,7 +159,10 @@ OLAPStatus BlockReader::init(const ReaderParams& read_params) {
         _next_block_func = &BlockReader::_direct_next_block;
         break;
     case KeysType::UNIQUE_KEYS:
-        _next_block_func = &BlockReader::_unique_key_next_block;
+        // rows of merge-on-write unique key tablet are already deduplicated by delete bitmap
+        _next_block_func = _tablet->enable_unique_key_merge_on_write() && _reader_type == READER_QUERY
+                                   ? &BlockReader::_direct_next_block
+                                   : &BlockReader::_unique_key_next_block;
         break;
     case KeysType::AGG_KEYS:
         _next_block_func = &BlockReader::_agg_key_next_block;
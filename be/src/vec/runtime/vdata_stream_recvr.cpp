@@ -18,6 +18,7 @@
 #include "vec/runtime/vdata_stream_recvr.h"
 
 #include "gen_cpp/data.pb.h"
+#include "pipeline/task_scheduler.h"
 #include "runtime/mem_tracker.h"
 #include "util/uid_util.h"
 #include "vec/core/block.h"
@@ -36,6 +37,11 @@ VDataStreamRecvr::SenderQueue::SenderQueue(VDataStreamRecvr* parent_recvr, int n
 
 VDataStreamRecvr::SenderQueue::~SenderQueue() = default;
 
+bool VDataStreamRecvr::SenderQueue::should_wait() {
+    std::lock_guard<std::mutex> l(_lock);
+    return !_is_cancelled && _block_queue.empty() && _num_remaining_senders > 0;
+}
+
 Status VDataStreamRecvr::SenderQueue::get_batch(Block** next_block) {
     std::unique_lock<std::mutex> l(_lock);
     // wait until something shows up or we know we're done
@@ -81,6 +87,8 @@ Status VDataStreamRecvr::SenderQueue::get_batch(Block** next_block) {
         closure_pair.second.stop();
         _recvr->_buffer_full_total_timer->update(closure_pair.second.elapsed_time());
     }
+    // a local sender of a pipeline task may wait for the buffer
+    pipeline::wake_up_blocked_tasks();
 
     return Status::OK();
 }
@@ -135,9 +143,10 @@ void VDataStreamRecvr::SenderQueue::add_block(const PBlock& pblock, int be_numbe
     }
     _recvr->_num_buffered_bytes += block_byte_size;
     _data_arrival_cv.notify_one();
+    pipeline::wake_up_blocked_tasks();
 }
 
-void VDataStreamRecvr::SenderQueue::add_block(Block* block, bool use_move) {
+void VDataStreamRecvr::SenderQueue::add_block(Block* block, bool use_move, bool wait_if_full) {
     std::unique_lock<std::mutex> l(_lock);
     if (_is_cancelled) {
         return;
@@ -160,8 +169,9 @@ void VDataStreamRecvr::SenderQueue::add_block(Block* block, bool use_move) {
     _block_queue.emplace_back(block_size, nblock);
     _recvr->_mem_tracker->Consume(nblock->bytes());
     _data_arrival_cv.notify_one();
+    pipeline::wake_up_blocked_tasks();
 
-    if (_recvr->exceeds_limit(block_size)) {
+    if (wait_if_full && _recvr->exceeds_limit(block_size)) {
         std::thread::id tid = std::this_thread::get_id();
         MonotonicStopWatch monotonicStopWatch;
         monotonicStopWatch.start();
@@ -189,6 +199,7 @@ void VDataStreamRecvr::SenderQueue::decrement_senders(int be_number) {
               << " node_id=" << _recvr->dest_node_id() << " #senders=" << _num_remaining_senders;
     if (_num_remaining_senders == 0) {
         _data_arrival_cv.notify_one();
+        pipeline::wake_up_blocked_tasks();
     }
 }
 
@@ -205,6 +216,7 @@ void VDataStreamRecvr::SenderQueue::cancel() {
     // Wake up all threads waiting to produce/consume batches.  They will all
     // notice that the stream is cancelled and handle it.
     _data_arrival_cv.notify_all();
+    pipeline::wake_up_blocked_tasks();
     // _data_removal_cv.notify_all();
     // PeriodicCounterUpdater::StopTimeSeriesCounter(
     //         _recvr->_bytes_received_time_series_counter);
@@ -300,15 +312,24 @@ Status VDataStreamRecvr::create_merger(const std::vector<VExprContext*>& orderin
     return Status::OK();
 }
 
+bool VDataStreamRecvr::ready_to_read() {
+    for (auto* sender_queue : _sender_queues) {
+        if (sender_queue->should_wait()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void VDataStreamRecvr::add_block(const PBlock& pblock, int sender_id, int be_number,
                                  int64_t packet_seq, ::google::protobuf::Closure** done) {
     int use_sender_id = _is_merging ? sender_id : 0;
     _sender_queues[use_sender_id]->add_block(pblock, be_number, packet_seq, done);
 }
 
-void VDataStreamRecvr::add_block(Block* block, int sender_id, bool use_move) {
+void VDataStreamRecvr::add_block(Block* block, int sender_id, bool use_move, bool wait_if_full) {
     int use_sender_id = _is_merging ? sender_id : 0;
-    _sender_queues[use_sender_id]->add_block(block, use_move);
+    _sender_queues[use_sender_id]->add_block(block, use_move, wait_if_full);
 }
 
 Status VDataStreamRecvr::get_next(Block* block, bool* eos) {
@@ -66,10 +66,19 @@ public:
     void add_block(const PBlock& pblock, int sender_id, int be_number, int64_t packet_seq,
                    ::google::protobuf::Closure** done);
 
-    void add_block(Block* block, int sender_id, bool use_move);
+    // Add a block of a local sender. If 'wait_if_full', waits until a block is consumed when
+    // the buffer limit is exceeded, otherwise the limit is left to the sender, see is_full().
+    void add_block(Block* block, int sender_id, bool use_move, bool wait_if_full = true);
 
     Status get_next(Block* block, bool* eos);
 
+    // True if the buffered blocks use up the buffer limit.
+    bool is_full() const { return _num_buffered_bytes >= _total_buffer_limit; }
+
+    // True if get_next() won't wait for the senders. A merging receiver is ready when all
+    // of the sender queues have data or are done.
+    bool ready_to_read();
+
     const TUniqueId& fragment_instance_id() const { return _fragment_instance_id; }
     PlanNodeId dest_node_id() const { return _dest_node_id; }
     const RowDescriptor& row_desc() const { return _row_desc; }
@@ -150,10 +159,13 @@ public:
 
     Status get_batch(Block** next_block);
 
+    // True if get_batch() would wait for data.
+    bool should_wait();
+
     void add_block(const PBlock& pblock, int be_number, int64_t packet_seq,
                    ::google::protobuf::Closure** done);
 
-    void add_block(Block* block, bool use_move);
+    void add_block(Block* block, bool use_move, bool wait_if_full);
 
     void decrement_senders(int sender_id);
 
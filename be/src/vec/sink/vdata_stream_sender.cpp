@@ -21,6 +21,7 @@
 #include <fmt/format.h>
 #include <fmt/ranges.h>
 
+#include "pipeline/task_scheduler.h"
 #include "runtime/client_cache.h"
 #include "runtime/dpp_sink_internal.h"
 #include "runtime/exec_env.h"
@@ -33,6 +34,16 @@
 
 namespace doris::vectorized {
 
+// Wakes up the pipeline task waiting in can_write() when the rpc is done.
+class TransmitBlockClosure final : public RefCountClosure<PTransmitDataResult> {
+public:
+    void Run() override {
+        // the closure may be deleted here
+        RefCountClosure<PTransmitDataResult>::Run();
+        pipeline::wake_up_blocked_tasks();
+    }
+};
+
 Status VDataStreamSender::Channel::init(RuntimeState* state) {
     _be_number = state->be_number();
 
@@ -101,7 +112,7 @@ Status VDataStreamSender::Channel::send_local_block(bool eos) {
     if (recvr != nullptr) {
         Block block = _mutable_block->to_block();
         COUNTER_UPDATE(_parent->_local_bytes_send_counter, block.bytes());
-        recvr->add_block(&block, _parent->_sender_id, true);
+        recvr->add_block(&block, _parent->_sender_id, true, !_parent->_non_blocking);
         if (eos) {
             recvr->remove_sender(_parent->_sender_id, _be_number);
         }
@@ -116,14 +127,24 @@ Status VDataStreamSender::Channel::send_local_block(Block* block) {
                                                                     _dest_node_id);
     if (recvr != nullptr) {
         COUNTER_UPDATE(_parent->_local_bytes_send_counter, block->bytes());
-        recvr->add_block(block, _parent->_sender_id, false);
+        recvr->add_block(block, _parent->_sender_id, false, !_parent->_non_blocking);
     }
     return Status::OK();
 }
 
+bool VDataStreamSender::Channel::is_local_recvr_writable() {
+    if (!_is_local) {
+        return true;
+    }
+    std::shared_ptr<VDataStreamRecvr> recvr =
+            _parent->state()->exec_env()->vstream_mgr()->find_recvr(_fragment_instance_id,
+                                                                    _dest_node_id);
+    return recvr == nullptr || !recvr->is_full();
+}
+
 Status VDataStreamSender::Channel::send_block(PBlock* block, bool eos) {
     if (_closure == nullptr) {
-        _closure = new RefCountClosure<PTransmitDataResult>();
+        _closure = new TransmitBlockClosure();
         _closure->ref();
     } else {
         RETURN_IF_ERROR(_wait_last_brpc());
@@ -350,6 +371,15 @@ Status VDataStreamSender::send(RuntimeState* state, RowBatch* batch) {
     return Status::NotSupported("Not Implemented VOlapScanNode Node::get_next scalar");
 }
 
+bool VDataStreamSender::can_write() {
+    for (auto channel : _channels) {
+        if (!channel->is_rpc_done() || !channel->is_local_recvr_writable()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 Status VDataStreamSender::send(RuntimeState* state, Block* block) {
     SCOPED_TIMER(_profile->total_time_counter());
     if (_part_type == TPartitionType::UNPARTITIONED || _channels.size() == 1) {
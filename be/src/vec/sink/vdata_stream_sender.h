@@ -61,6 +61,10 @@ public:
 
     virtual Status send(RuntimeState* state, RowBatch* batch) override;
     virtual Status send(RuntimeState* state, Block* block) override;
+    // False if the last rpc of some channel is in flight, or the receiver of a local channel
+    // is full, send() would wait for them.
+    bool can_write() override;
+    void set_non_blocking() override { _non_blocking = true; }
 
     virtual Status close(RuntimeState* state, Status exec_status) override;
     virtual RuntimeProfile* profile() override { return _profile; }
@@ -123,6 +127,8 @@ private:
     RuntimeProfile::Counter* _local_bytes_send_counter;
     // Identifier of the destination plan node.
     PlanNodeId _dest_node_id;
+    // If true, the local channels don't wait for the receivers, see set_non_blocking().
+    bool _non_blocking = false;
 };
 
 // TODO: support local exechange
@@ -207,6 +213,13 @@ public:
 
     bool is_local() { return _is_local; }
 
+    // The channel holds one reference of the closure, the others are held by the
+    // rpcs in flight.
+    bool is_rpc_done() const { return _closure == nullptr || _closure->count() == 1; }
+
+    // False if the receiver of a local channel has used up its buffer limit.
+    bool is_local_recvr_writable();
+
 private:
     inline Status _wait_last_brpc() {
         if (_closure == nullptr) return Status::OK();
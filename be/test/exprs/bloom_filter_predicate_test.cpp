@@ -21,6 +21,9 @@
 #include "exprs/create_predicate_function.h"
 #include "gtest/gtest.h"
 #include "runtime/string_value.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/runtime/vdatetime_value.h"
 
 namespace doris {
 class BloomFilterPredicateTest : public testing::Test {
@@ -115,6 +118,75 @@ TEST_F(BloomFilterPredicateTest, bloom_filter_size_test) {
     ASSERT_EQ(length, len);
 }
 
+TEST_F(BloomFilterPredicateTest, bloom_filter_find_batch_test) {
+    auto tracker = MemTracker::CreateTracker();
+    std::unique_ptr<IBloomFilterFuncBase> func(
+            create_bloom_filter(tracker.get(), PrimitiveType::TYPE_INT));
+    ASSERT_TRUE(func->init(1024, 0.05).ok());
+    // more rows than a hash batch
+    const int data_size = 3000;
+    auto column = vectorized::ColumnInt32::create();
+    std::vector<uint8_t> null_map(data_size, 0);
+    for (int i = 0; i < data_size; i++) {
+        column->insert_value(i);
+        if (i % 2 == 0) {
+            func->insert((const void*)&i);
+        }
+        null_map[i] = i % 10 == 0;
+    }
+    std::vector<uint8_t> results(data_size);
+    func->find_batch(*column, nullptr, results.data());
+    for (int i = 0; i < data_size; i++) {
+        ASSERT_EQ(func->find((const void*)&i), results[i]) << i;
+    }
+    func->find_batch(*column, null_map.data(), results.data());
+    for (int i = 0; i < data_size; i++) {
+        ASSERT_EQ(func->find((const void*)&i) && !null_map[i], results[i]) << i;
+    }
+
+    // strings
+    func.reset(create_bloom_filter(tracker.get(), PrimitiveType::TYPE_VARCHAR));
+    ASSERT_TRUE(func->init(1024, 0.05).ok());
+    auto string_column = vectorized::ColumnString::create();
+    for (int i = 0; i < data_size; i++) {
+        std::string str = std::to_string(i);
+        string_column->insert_data(str.data(), str.size());
+        if (i % 3 == 0) {
+            StringValue value(str);
+            func->insert((const void*)&value);
+        }
+    }
+    func->find_batch(*string_column, nullptr, results.data());
+    for (int i = 0; i < data_size; i++) {
+        std::string str = std::to_string(i);
+        StringValue value(str);
+        ASSERT_EQ(func->find((const void*)&value), results[i]) << i;
+        if (i % 3 == 0) {
+            ASSERT_TRUE(results[i]);
+        }
+    }
+
+    // dates are probed as DateTimeValue
+    func.reset(create_bloom_filter(tracker.get(), PrimitiveType::TYPE_DATE));
+    ASSERT_TRUE(func->init(1024, 0.05).ok());
+    auto date_column = vectorized::ColumnInt64::create();
+    for (int i = 0; i < 28; i++) {
+        vectorized::VecDateTimeValue vec_date;
+        vec_date.from_date_int64(20200101 + i);
+        date_column->insert_value(
+                binary_cast<vectorized::VecDateTimeValue, vectorized::Int64>(vec_date));
+        if (i % 2 == 0) {
+            DateTimeValue date;
+            vec_date.convert_vec_dt_to_dt(&date);
+            func->insert((const void*)&date);
+        }
+    }
+    func->find_batch(*date_column, nullptr, results.data());
+    for (int i = 0; i < 28; i += 2) {
+        ASSERT_TRUE(results[i]) << i;
+    }
+}
+
 } // namespace doris
 
 int main(int argc, char** argv) {
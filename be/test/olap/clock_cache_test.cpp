@@ -0,0 +1,268 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/clock_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace doris {
+
+static std::atomic<int> s_deleted_count {0};
+
+static void deleter(const CacheKey& key, void* value) {
+    s_deleted_count++;
+}
+
+static void* encode_value(uintptr_t v) {
+    return reinterpret_cast<void*>(v);
+}
+
+static int decode_value(void* v) {
+    return reinterpret_cast<uintptr_t>(v);
+}
+
+class ClockCacheTest : public testing::Test {
+public:
+    void SetUp() override { s_deleted_count = 0; }
+
+    static void insert(ClockCache& cache, int key, int value,
+                       CachePriority priority = CachePriority::NORMAL) {
+        std::string key_str = std::to_string(key);
+        CacheKey cache_key(key_str);
+        uint32_t hash = cache_key.hash(cache_key.data(), cache_key.size(), 0);
+        cache.release(cache.insert(cache_key, hash, encode_value(value), 1, &deleter, priority));
+    }
+
+    static Cache::Handle* lookup_handle(ClockCache& cache, int key) {
+        std::string key_str = std::to_string(key);
+        CacheKey cache_key(key_str);
+        uint32_t hash = cache_key.hash(cache_key.data(), cache_key.size(), 0);
+        return cache.lookup(cache_key, hash);
+    }
+
+    static int lookup(ClockCache& cache, int key) {
+        Cache::Handle* handle = lookup_handle(cache, key);
+        if (handle == nullptr) {
+            return -1;
+        }
+        int value = decode_value(reinterpret_cast<ClockHandle*>(handle)->value);
+        cache.release(handle);
+        return value;
+    }
+
+    static void erase(ClockCache& cache, int key) {
+        std::string key_str = std::to_string(key);
+        CacheKey cache_key(key_str);
+        cache.erase(cache_key, cache_key.hash(cache_key.data(), cache_key.size(), 0));
+    }
+};
+
+TEST_F(ClockCacheTest, HitAndMiss) {
+    ClockCache cache(LRUCacheType::NUMBER, 100, 1);
+    ASSERT_EQ(-1, lookup(cache, 100));
+
+    insert(cache, 100, 101);
+    ASSERT_EQ(101, lookup(cache, 100));
+    ASSERT_EQ(-1, lookup(cache, 200));
+
+    insert(cache, 200, 201);
+    ASSERT_EQ(101, lookup(cache, 100));
+    ASSERT_EQ(201, lookup(cache, 200));
+
+    insert(cache, 100, 102);
+    ASSERT_EQ(102, lookup(cache, 100));
+    ASSERT_EQ(1, s_deleted_count);
+    ASSERT_EQ(2, cache.get_usage());
+    ASSERT_EQ(6, cache.get_lookup_count());
+    ASSERT_EQ(4, cache.get_hit_count());
+
+    erase(cache, 100);
+    ASSERT_EQ(-1, lookup(cache, 100));
+    ASSERT_EQ(201, lookup(cache, 200));
+    ASSERT_EQ(2, s_deleted_count);
+    ASSERT_EQ(1, cache.get_usage());
+}
+
+TEST_F(ClockCacheTest, EntriesArePinned) {
+    ClockCache cache(LRUCacheType::NUMBER, 100, 1);
+    insert(cache, 100, 101);
+    Cache::Handle* h1 = lookup_handle(cache, 100);
+    ASSERT_NE(nullptr, h1);
+
+    insert(cache, 100, 102);
+    Cache::Handle* h2 = lookup_handle(cache, 100);
+    ASSERT_EQ(102, decode_value(reinterpret_cast<ClockHandle*>(h2)->value));
+    ASSERT_EQ(0, s_deleted_count);
+
+    cache.release(h1);
+    ASSERT_EQ(1, s_deleted_count);
+
+    erase(cache, 100);
+    ASSERT_EQ(-1, lookup(cache, 100));
+    ASSERT_EQ(1, s_deleted_count);
+
+    cache.release(h2);
+    ASSERT_EQ(2, s_deleted_count);
+    ASSERT_EQ(0, cache.get_usage());
+}
+
+TEST_F(ClockCacheTest, EvictionPolicy) {
+    ClockCache cache(LRUCacheType::NUMBER, 100, 1);
+    insert(cache, 100, 101);
+    insert(cache, 200, 201, CachePriority::DURABLE);
+    insert(cache, 300, 301);
+
+    // Frequently used entry must be kept around
+    for (int i = 0; i < 1000; i++) {
+        insert(cache, 1000 + i, 2000 + i);
+        ASSERT_EQ(2000 + i, lookup(cache, 1000 + i));
+        ASSERT_EQ(101, lookup(cache, 100));
+    }
+    ASSERT_EQ(100, cache.get_usage());
+    ASSERT_EQ(101, lookup(cache, 100));
+    ASSERT_EQ(201, lookup(cache, 200));
+    ASSERT_EQ(-1, lookup(cache, 300));
+}
+
+TEST_F(ClockCacheTest, SizeLimitedByTable) {
+    // The table is sized for 10 entries of 100 bytes, it holds no more than
+    // 12 entries although the capacity is not reached.
+    ClockCache cache(LRUCacheType::SIZE, 1000, 100);
+    ASSERT_EQ(16, cache.get_table_size());
+    for (int i = 100; i < 200; i++) {
+        insert(cache, i, i);
+    }
+    ASSERT_EQ(12 * 4, cache.get_usage()); // charge is 1 and key length is 3
+    int found = 0;
+    for (int i = 100; i < 200; i++) {
+        if (lookup(cache, i) == i) {
+            found++;
+        }
+    }
+    ASSERT_EQ(12, found);
+    ASSERT_EQ(199, lookup(cache, 199));
+}
+
+TEST_F(ClockCacheTest, DetachedWhenAllPinned) {
+    ClockCache cache(LRUCacheType::NUMBER, 100, 1);
+    std::vector<Cache::Handle*> handles;
+    for (int i = 0; i < 300; i++) {
+        std::string key_str = std::to_string(i);
+        CacheKey cache_key(key_str);
+        uint32_t hash = cache_key.hash(cache_key.data(), cache_key.size(), 0);
+        handles.push_back(cache.insert(cache_key, hash, encode_value(i), 1, &deleter));
+    }
+    ASSERT_EQ(300, cache.get_usage());
+    ASSERT_EQ(0, s_deleted_count);
+    // entries which have no slot can't be found
+    ASSERT_EQ(-1, lookup(cache, 299));
+    for (auto handle : handles) {
+        cache.release(handle);
+    }
+    // the table is filled up, and the others are freed when released
+    ASSERT_EQ(cache.get_table_size(), cache.get_usage());
+    ASSERT_EQ(300 - cache.get_table_size(), s_deleted_count);
+
+    ASSERT_EQ(cache.get_table_size(), cache.prune());
+    ASSERT_EQ(0, cache.get_usage());
+    ASSERT_EQ(300, s_deleted_count);
+}
+
+TEST_F(ClockCacheTest, Prune) {
+    ClockCache cache(LRUCacheType::NUMBER, 5, 1);
+    for (int i = 1; i <= 5; ++i) {
+        insert(cache, i, i);
+    }
+    Cache::Handle* handle = lookup_handle(cache, 5);
+
+    ASSERT_EQ(0, cache.prune_if([](const void*) { return false; }));
+    // the referenced entry is not pruned
+    ASSERT_EQ(1, cache.prune_if([](const void* value) { return decode_value((void*)value) > 3; }));
+    ASSERT_EQ(4, cache.get_usage());
+
+    ASSERT_EQ(3, cache.prune());
+    ASSERT_EQ(1, cache.get_usage());
+    cache.release(handle);
+    ASSERT_EQ(1, cache.get_usage());
+    ASSERT_EQ(1, cache.prune());
+    ASSERT_EQ(0, cache.get_usage());
+}
+
+TEST_F(ClockCacheTest, ConcurrentLookup) {
+    ClockCache cache(LRUCacheType::NUMBER, 1000, 1);
+    for (int i = 0; i < 1000; i++) {
+        insert(cache, i, i);
+    }
+
+    std::atomic<bool> failed {false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([&cache, &failed, t]() {
+            for (int i = 0; i < 100000; i++) {
+                int key = (i * 7 + t) % 2000;
+                int value = lookup(cache, key);
+                if (value != -1 && value != key) {
+                    failed = true;
+                }
+                if (t % 4 == 0 && i % 10 == 0) {
+                    insert(cache, key, key);
+                }
+                if (t % 4 == 1 && i % 100 == 0) {
+                    erase(cache, key);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_FALSE(failed);
+    ASSERT_LE(cache.get_usage(), 1000);
+    cache.prune();
+    ASSERT_EQ(0, cache.get_usage());
+}
+
+TEST_F(ClockCacheTest, ShardedClockCache) {
+    std::unique_ptr<Cache> cache(
+            new_lru_cache("clock_test", 1000, nullptr, LRUCachePolicy::CLOCK));
+    ShardedClockCache* clock_cache = dynamic_cast<ShardedClockCache*>(cache.get());
+    ASSERT_NE(nullptr, clock_cache);
+
+    ShardedClockCache cache2("clock_test2", 1000, LRUCacheType::NUMBER, 6, nullptr);
+    ASSERT_EQ(8, cache2.num_shards());
+
+    CacheKey key("key");
+    cache2.release(cache2.insert(key, encode_value(1), 1, &deleter));
+    Cache::Handle* handle = cache2.lookup(key);
+    ASSERT_NE(nullptr, handle);
+    ASSERT_EQ(1, decode_value(cache2.value(handle)));
+    cache2.release(handle);
+    cache2.erase(key);
+    ASSERT_EQ(nullptr, cache2.lookup(key));
+    ASSERT_EQ(1, s_deleted_count);
+}
+
+} // namespace doris
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
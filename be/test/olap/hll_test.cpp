@@ -19,6 +19,8 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include "util/hash_util.hpp"
 #include "util/slice.h"
 
@@ -204,6 +206,29 @@ TEST_F(TestHll, InvalidPtr) {
     }
 }
 
+// update_batch() and the merge of registers give the same value as update() one by one.
+TEST_F(TestHll, UpdateBatchAndMerge) {
+    for (int num : {0, 10, 160, 161, 1000, 100000}) {
+        std::vector<uint64_t> hash_values;
+        HyperLogLog expected;
+        for (int i = 0; i < num; ++i) {
+            hash_values.push_back(hash(i));
+            expected.update(hash_values.back());
+        }
+        HyperLogLog batch_hll;
+        batch_hll.update_batch(hash_values.data(), hash_values.size());
+        ASSERT_EQ(expected.estimate_cardinality(), batch_hll.estimate_cardinality()) << num;
+
+        HyperLogLog merged;
+        merged.update_batch(hash_values.data(), hash_values.size() / 2);
+        HyperLogLog other;
+        other.update_batch(hash_values.data() + hash_values.size() / 2,
+                           hash_values.size() - hash_values.size() / 2);
+        merged.merge(other);
+        ASSERT_EQ(expected.estimate_cardinality(), merged.estimate_cardinality()) << num;
+    }
+}
+
 } // namespace doris
 
 int main(int argc, char** argv) {
@@ -317,6 +317,114 @@ TEST_F(CacheTest, Prune) {
     ASSERT_EQ(0, cache.get_usage());
 }
 
+static bool lookup_LRUCache(LRUCache& cache, const CacheKey& key) {
+    uint32_t hash = key.hash(key.data(), key.size(), 0);
+    Cache::Handle* handle = cache.lookup(key, hash);
+    if (handle == nullptr) {
+        return false;
+    }
+    cache.release(handle);
+    return true;
+}
+
+TEST_F(CacheTest, SegmentedLRUResistScan) {
+    LRUCache cache(LRUCacheType::NUMBER, LRUCachePolicy::SEGMENTED_LRU);
+    cache.set_capacity(10);
+
+    // hot entries are hit once, and promoted to protected segment
+    for (int i = 1; i <= 5; ++i) {
+        insert_LRUCache(cache, CacheKey {std::to_string(i)}, i, CachePriority::NORMAL);
+        ASSERT_TRUE(lookup_LRUCache(cache, CacheKey {std::to_string(i)}));
+    }
+    ASSERT_EQ(5, cache.get_protected_usage());
+
+    // a scan only evicts the entries of probationary segment
+    for (int i = 1000; i < 1100; ++i) {
+        insert_LRUCache(cache, CacheKey {std::to_string(i)}, i, CachePriority::NORMAL);
+    }
+    ASSERT_EQ(10, cache.get_usage());
+    for (int i = 1; i <= 5; ++i) {
+        ASSERT_TRUE(lookup_LRUCache(cache, CacheKey {std::to_string(i)}));
+    }
+    ASSERT_FALSE(lookup_LRUCache(cache, CacheKey {"1000"}));
+
+    // protected segment is limited to 80% of capacity
+    for (int i = 1095; i < 1100; ++i) {
+        ASSERT_TRUE(lookup_LRUCache(cache, CacheKey {std::to_string(i)}));
+    }
+    ASSERT_EQ(8, cache.get_protected_usage());
+    ASSERT_EQ(10, cache.get_usage());
+
+    cache.prune();
+    ASSERT_EQ(0, cache.get_usage());
+    ASSERT_EQ(0, cache.get_protected_usage());
+}
+
+TEST_F(CacheTest, TinyLFUAdmission) {
+    LRUCache cache(LRUCacheType::NUMBER, LRUCachePolicy::TINY_LFU);
+    cache.set_capacity(5);
+
+    for (int i = 1; i <= 5; ++i) {
+        CacheKey key {std::to_string(i)};
+        ASSERT_FALSE(lookup_LRUCache(cache, key));
+        insert_LRUCache(cache, key, i, CachePriority::NORMAL);
+        ASSERT_TRUE(lookup_LRUCache(cache, key));
+    }
+    ASSERT_EQ(5, cache.get_usage());
+
+    // an entry which is only read once is not admitted
+    CacheKey cold_key("100");
+    ASSERT_FALSE(lookup_LRUCache(cache, cold_key));
+    insert_LRUCache(cache, cold_key, 100, CachePriority::NORMAL);
+    ASSERT_EQ(1, cache.get_admission_reject_count());
+    ASSERT_EQ(5, cache.get_usage());
+    for (int i = 1; i <= 5; ++i) {
+        ASSERT_TRUE(lookup_LRUCache(cache, CacheKey {std::to_string(i)}));
+    }
+
+    // entry becomes hot enough to replace the victim
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_FALSE(lookup_LRUCache(cache, cold_key));
+    }
+    insert_LRUCache(cache, cold_key, 100, CachePriority::NORMAL);
+    ASSERT_EQ(1, cache.get_admission_reject_count());
+    ASSERT_EQ(5, cache.get_usage());
+    ASSERT_TRUE(lookup_LRUCache(cache, cold_key));
+
+    // durable entry is always admitted
+    insert_LRUCache(cache, CacheKey {"200"}, 200, CachePriority::DURABLE);
+    ASSERT_EQ(1, cache.get_admission_reject_count());
+    ASSERT_TRUE(lookup_LRUCache(cache, CacheKey {"200"}));
+}
+
+TEST_F(CacheTest, FrequencySketch) {
+    FrequencySketch sketch;
+    sketch.resize(64);
+    ASSERT_EQ(0, sketch.frequency(12345));
+
+    for (int i = 0; i < 3; ++i) {
+        sketch.increment(12345);
+    }
+    ASSERT_EQ(3, sketch.frequency(12345));
+
+    // counters are saturated at 15
+    for (int i = 0; i < 20; ++i) {
+        sketch.increment(12345);
+    }
+    ASSERT_EQ(15, sketch.frequency(12345));
+
+    sketch._reset();
+    ASSERT_EQ(7, sketch.frequency(12345));
+}
+
+TEST_F(CacheTest, ParsePolicy) {
+    ASSERT_EQ(LRUCachePolicy::LRU, parse_lru_cache_policy("lru"));
+    ASSERT_EQ(LRUCachePolicy::SEGMENTED_LRU, parse_lru_cache_policy("SLRU"));
+    ASSERT_EQ(LRUCachePolicy::TINY_LFU, parse_lru_cache_policy("TinyLFU"));
+    ASSERT_EQ(LRUCachePolicy::CLOCK, parse_lru_cache_policy("clock"));
+    ASSERT_EQ(LRUCachePolicy::LRU, parse_lru_cache_policy("unknown"));
+}
+
 TEST_F(CacheTest, HeavyEntries) {
     // Add a bunch of light and heavy entries and then count the combined
     // size of items still in the cache, which must be approximately the
@@ -388,6 +496,7 @@ TEST(CacheHandleTest, HandleTableTest) {
         h->prev_hash = nullptr;
         h->next_hash = nullptr;
         h->in_cache = false;
+        h->in_protected = false;
         h->priority = CachePriority::NORMAL;
         memcpy(h->key_data, key->data(), key->size());
 
@@ -425,6 +534,7 @@ TEST(CacheHandleTest, HandleTableTest) {
         h->prev_hash = nullptr;
         h->next_hash = nullptr;
         h->in_cache = false;
+        h->in_protected = false;
         h->priority = CachePriority::NORMAL;
         memcpy(h->key_data, key->data(), key->size());
 
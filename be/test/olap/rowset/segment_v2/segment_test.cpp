@@ -33,6 +33,8 @@
 #include "olap/row_block.h"
 #include "olap/row_block2.h"
 #include "olap/row_cursor.h"
+#include "olap/short_key_index.h"
+#include "olap/rowset/segment_v2/indexed_column_reader.h"
 #include "olap/rowset/segment_v2/segment_iterator.h"
 #include "olap/rowset/segment_v2/segment_writer.h"
 #include "olap/tablet_schema.h"
@@ -1156,6 +1158,171 @@ TEST_F(SegmentReaderWriterTest, TestBloomFilterIndexUniqueModel) {
     ASSERT_TRUE(column_contains_index(seg2->footer().columns(3), BLOOM_FILTER_INDEX));
 }
 
+TEST_F(SegmentReaderWriterTest, TestPrimaryKeyIndex) {
+    TabletSchema tablet_schema = create_schema(
+            {create_int_key(1), create_int_key(2), create_int_value(3), create_int_value(4)});
+    tablet_schema._keys_type = UNIQUE_KEYS;
+
+    SegmentWriterOptions opts;
+    opts.enable_unique_key_merge_on_write = true;
+    shared_ptr<Segment> segment;
+    build_segment(opts, tablet_schema, tablet_schema, 4096, DefaultIntGenerator, &segment);
+    ASSERT_TRUE(segment->has_primary_key_index());
+
+    std::unique_ptr<IndexedColumnIterator> pk_iter;
+    ASSERT_TRUE(segment->new_primary_key_iterator(&pk_iter).ok());
+
+    RowCursor key;
+    ASSERT_EQ(OLAP_SUCCESS, key.init(tablet_schema));
+    auto encode_row_key = [&](int k1, int k2) {
+        key.cell(0).set_not_null();
+        *(int*)key.cell(0).mutable_cell_ptr() = k1;
+        key.cell(1).set_not_null();
+        *(int*)key.cell(1).mutable_cell_ptr() = k2;
+        std::string encoded_key;
+        encode_full_key(&encoded_key, key, tablet_schema.num_key_columns());
+        return encoded_key;
+    };
+    // the iterator is reused for each lookup
+    for (uint32_t rid : {0, 1, 1023, 1024, 2048, 4095}) {
+        uint32_t row_id = 0;
+        std::string encoded_key = encode_row_key(rid * 10 + 1, rid * 10 + 2);
+        ASSERT_TRUE(segment->lookup_row_key(pk_iter.get(), encoded_key, &row_id).ok());
+        ASSERT_EQ(rid, row_id);
+    }
+    {
+        uint32_t row_id = 0;
+        std::string encoded_key = encode_row_key(11, 13);
+        ASSERT_TRUE(segment->lookup_row_key(pk_iter.get(), encoded_key, &row_id).is_not_found());
+        encoded_key = encode_row_key(40961, 40962);
+        ASSERT_TRUE(segment->lookup_row_key(pk_iter.get(), encoded_key, &row_id).is_not_found());
+    }
+
+    // rows in delete bitmap are not read
+    {
+        Schema schema(tablet_schema);
+        OlapReaderStatistics stats;
+        StorageReadOptions read_opts;
+        read_opts.stats = &stats;
+        auto delete_bitmap = std::make_shared<roaring::Roaring>();
+        delete_bitmap->addRange(0, 1000);
+        delete_bitmap->add(4095);
+        read_opts.delete_bitmap[segment->id()] = delete_bitmap;
+        std::unique_ptr<RowwiseIterator> iter;
+        ASSERT_TRUE(segment->new_iterator(schema, read_opts, nullptr, &iter).ok());
+
+        RowBlockV2 block(schema, 1024);
+        int rowid = 1000;
+        Status st;
+        do {
+            block.clear();
+            st = iter->next_batch(&block);
+            for (int i = 0; i < block.num_rows(); ++i, ++rowid) {
+                ASSERT_EQ(rowid * 10 + 1, *(int*)block.column_block(0).cell_ptr(i));
+            }
+        } while (st.ok());
+        ASSERT_TRUE(st.is_end_of_file());
+        ASSERT_EQ(4095, rowid);
+        ASSERT_EQ(1001, stats.rows_del_filtered);
+    }
+
+    // primary key index is not written by default
+    shared_ptr<Segment> segment2;
+    build_segment(SegmentWriterOptions(), tablet_schema, tablet_schema, 100, DefaultIntGenerator,
+                  &segment2);
+    ASSERT_FALSE(segment2->has_primary_key_index());
+}
+
+TEST_F(SegmentReaderWriterTest, TestPrimaryKeyIndexOfStringKeys) {
+    // the varchar keys are longer than their index length, which is 4
+    TabletSchema tablet_schema =
+            create_schema({create_varchar_key(1), create_varchar_key(2), create_int_value(3)});
+    tablet_schema._keys_type = UNIQUE_KEYS;
+    // sorted by the keys, the first two keys are the same if the first key isn't terminated
+    std::vector<std::pair<std::string, std::string>> old_keys = {
+            {"a", std::string("b\x02" "c")},
+            {std::string("a\x02" "b"), "c"},
+            {"shared_prefix_0123456789_a", "x"},
+            {"shared_prefix_0123456789_b", "x"}};
+    std::vector<std::pair<std::string, std::string>> new_keys = {
+            {"a", std::string("b\x02" "c")}, {"shared_prefix_0123456789_a", "x"}};
+    auto generator = [](const std::vector<std::pair<std::string, std::string>>& keys) {
+        return [keys](size_t rid, int cid, int block_id, RowCursorCell& cell) {
+            cell.set_not_null();
+            if (cid == 0) {
+                *(Slice*)cell.mutable_cell_ptr() = Slice(keys[rid].first);
+            } else if (cid == 1) {
+                *(Slice*)cell.mutable_cell_ptr() = Slice(keys[rid].second);
+            } else {
+                *(int*)cell.mutable_cell_ptr() = rid;
+            }
+        };
+    };
+
+    SegmentWriterOptions opts;
+    opts.enable_unique_key_merge_on_write = true;
+    shared_ptr<Segment> old_segment;
+    build_segment(opts, tablet_schema, tablet_schema, old_keys.size(), generator(old_keys),
+                  &old_segment);
+    shared_ptr<Segment> new_segment;
+    build_segment(opts, tablet_schema, tablet_schema, new_keys.size(), generator(new_keys),
+                  &new_segment);
+
+    RowCursor key;
+    ASSERT_EQ(OLAP_SUCCESS, key.init(tablet_schema));
+    auto encode_row_key = [&](const std::pair<std::string, std::string>& row_key) {
+        key.cell(0).set_not_null();
+        *(Slice*)key.cell(0).mutable_cell_ptr() = Slice(row_key.first);
+        key.cell(1).set_not_null();
+        *(Slice*)key.cell(1).mutable_cell_ptr() = Slice(row_key.second);
+        std::string encoded_key;
+        encode_full_key(&encoded_key, key, tablet_schema.num_key_columns());
+        return encoded_key;
+    };
+
+    // every key is found at its own row
+    std::unique_ptr<IndexedColumnIterator> pk_iter;
+    ASSERT_TRUE(old_segment->new_primary_key_iterator(&pk_iter).ok());
+    for (uint32_t rid = 0; rid < old_keys.size(); ++rid) {
+        uint32_t row_id = 0;
+        std::string encoded_key = encode_row_key(old_keys[rid]);
+        ASSERT_TRUE(old_segment->lookup_row_key(pk_iter.get(), encoded_key, &row_id).ok());
+        ASSERT_EQ(rid, row_id);
+    }
+
+    // the keys of the new segment replace only the same keys of the old segment
+    auto delete_bitmap = std::make_shared<roaring::Roaring>();
+    for (auto& new_key : new_keys) {
+        uint32_t row_id = 0;
+        std::string encoded_key = encode_row_key(new_key);
+        ASSERT_TRUE(old_segment->lookup_row_key(pk_iter.get(), encoded_key, &row_id).ok());
+        delete_bitmap->add(row_id);
+    }
+    ASSERT_EQ(2, delete_bitmap->cardinality());
+    ASSERT_TRUE(delete_bitmap->contains(0));
+    ASSERT_TRUE(delete_bitmap->contains(2));
+
+    Schema schema(tablet_schema);
+    OlapReaderStatistics stats;
+    StorageReadOptions read_opts;
+    read_opts.stats = &stats;
+    read_opts.delete_bitmap[old_segment->id()] = delete_bitmap;
+    std::unique_ptr<RowwiseIterator> iter;
+    ASSERT_TRUE(old_segment->new_iterator(schema, read_opts, nullptr, &iter).ok());
+    RowBlockV2 block(schema, 1024);
+    std::vector<int> rows;
+    Status st;
+    do {
+        block.clear();
+        st = iter->next_batch(&block);
+        for (int i = 0; i < block.num_rows(); ++i) {
+            rows.push_back(*(int*)block.column_block(2).cell_ptr(i));
+        }
+    } while (st.ok());
+    ASSERT_TRUE(st.is_end_of_file());
+    ASSERT_EQ(std::vector<int>({1, 3}), rows);
+}
+
 } // namespace segment_v2
 } // namespace doris
 
@@ -22,6 +22,7 @@
 
 #include <filesystem>
 #include <fstream>
+#include <set>
 #include <sstream>
 #include <string>
 
@@ -107,6 +108,57 @@ TEST_F(TabletMetaManagerTest, TestLoad) {
     ASSERT_EQ(_json_header, json_meta_read);
 }
 
+TEST_F(TabletMetaManagerTest, TestSaveAndLoadDeleteBitmap) {
+    const TTabletId tablet_id = 15673;
+    const TSchemaHash schema_hash = 567997577;
+    RowsetId rowset1;
+    rowset1.init(1);
+    RowsetId rowset2;
+    rowset2.init(2);
+    DeleteBitmap delete_bitmap;
+    delete_bitmap.add({rowset1, 0, 2}, 10);
+    delete_bitmap.add({rowset1, 1, 2}, 20);
+    delete_bitmap.add({rowset1, 0, 3}, 30);
+    OLAPStatus s =
+            TabletMetaManager::save_delete_bitmap(_data_dir, tablet_id, schema_hash, &delete_bitmap);
+    ASSERT_EQ(OLAP_SUCCESS, s);
+    int num_keys = 0;
+    auto count_func = [&num_keys](const std::string& key, const std::string& value) -> bool {
+        ++num_keys;
+        return true;
+    };
+    _data_dir->get_meta()->iterate(META_COLUMN_FAMILY_INDEX, DELETE_BITMAP_PREFIX, count_func);
+    // one key per (rowset, version)
+    ASSERT_EQ(2, num_keys);
+
+    // only the changed entries are saved again
+    delete_bitmap.add({rowset2, 0, 4}, 40);
+    delete_bitmap.remove_rowset(rowset1);
+    delete_bitmap.add({rowset1, 0, 3}, 30);
+    std::set<DeleteBitmap::SaveKey> updated;
+    std::set<DeleteBitmap::SaveKey> removed;
+    DeleteBitmap(delete_bitmap).take_changes(&updated, &removed);
+    ASSERT_EQ(2, updated.size());
+    ASSERT_EQ(1, removed.size());
+    s = TabletMetaManager::save_delete_bitmap(_data_dir, tablet_id, schema_hash, &delete_bitmap);
+    ASSERT_EQ(OLAP_SUCCESS, s);
+
+    DeleteBitmap loaded;
+    s = TabletMetaManager::load_delete_bitmap(_data_dir, tablet_id, schema_hash, &loaded);
+    ASSERT_EQ(OLAP_SUCCESS, s);
+    ASSERT_EQ(2, loaded.num_entries());
+    ASSERT_FALSE(loaded.contains({rowset1, 0, 2}, 10));
+    ASSERT_TRUE(loaded.contains({rowset1, 0, 3}, 30));
+    ASSERT_TRUE(loaded.contains({rowset2, 0, 4}, 40));
+
+    s = TabletMetaManager::remove_delete_bitmap(_data_dir, tablet_id, schema_hash);
+    ASSERT_EQ(OLAP_SUCCESS, s);
+    DeleteBitmap removed_bitmap;
+    s = TabletMetaManager::load_delete_bitmap(_data_dir, tablet_id, schema_hash, &removed_bitmap);
+    ASSERT_EQ(OLAP_SUCCESS, s);
+    ASSERT_EQ(0, removed_bitmap.num_entries());
+}
+
 } // namespace doris
 
 int main(int argc, char** argv) {
@@ -41,6 +41,82 @@ TEST(TabletMetaTest, SaveAndParse) {
     ASSERT_EQ(old_tablet_meta, new_tablet_meta);
 }
 
+TEST(TabletMetaTest, DeleteBitmap) {
+    RowsetId rowset1;
+    rowset1.init(1);
+    RowsetId rowset2;
+    rowset2.init(2);
+
+    DeleteBitmap delete_bitmap;
+    delete_bitmap.add({rowset1, 0, 3}, 10);
+    delete_bitmap.add({rowset1, 0, 5}, 20);
+    delete_bitmap.add({rowset1, 1, 5}, 30);
+    delete_bitmap.add({rowset2, 0, 6}, 40);
+    ASSERT_EQ(4, delete_bitmap.num_entries());
+    ASSERT_EQ(4, delete_bitmap.cardinality());
+
+    ASSERT_TRUE(delete_bitmap.contains({rowset1, 0, 3}, 10));
+    ASSERT_FALSE(delete_bitmap.contains({rowset1, 0, 5}, 10));
+    // deletes are visible to the later versions
+    ASSERT_FALSE(delete_bitmap.contains_agg({rowset1, 0, 2}, 10));
+    ASSERT_TRUE(delete_bitmap.contains_agg({rowset1, 0, 4}, 10));
+    ASSERT_FALSE(delete_bitmap.contains_agg({rowset1, 0, 4}, 20));
+    ASSERT_TRUE(delete_bitmap.contains_agg({rowset1, 0, 100}, 20));
+    ASSERT_FALSE(delete_bitmap.contains_agg({rowset1, 1, 100}, 20));
+
+    ASSERT_EQ(nullptr, delete_bitmap.get_agg({rowset1, 0, 2}));
+    ASSERT_EQ(1, delete_bitmap.get_agg({rowset1, 0, 3})->cardinality());
+    ASSERT_EQ(2, delete_bitmap.get_agg({rowset1, 0, 5})->cardinality());
+    ASSERT_EQ(1, delete_bitmap.get_agg({rowset2, 0, 6})->cardinality());
+
+    DeleteBitmapPB delete_bitmap_pb;
+    delete_bitmap.to_pb(&delete_bitmap_pb);
+    DeleteBitmap parsed;
+    parsed.init_from_pb(delete_bitmap_pb);
+    ASSERT_EQ(4, parsed.num_entries());
+    ASSERT_TRUE(parsed.contains({rowset1, 1, 5}, 30));
+    ASSERT_TRUE(parsed.contains({rowset2, 0, 6}, 40));
+
+    parsed.remove_rowset(rowset1);
+    ASSERT_EQ(1, parsed.num_entries());
+    ASSERT_FALSE(parsed.contains_agg({rowset1, 0, 100}, 20));
+    ASSERT_TRUE(parsed.contains({rowset2, 0, 6}, 40));
+
+    parsed.merge(delete_bitmap);
+    ASSERT_EQ(4, parsed.num_entries());
+}
+
+TEST(TabletMetaTest, MergeOnWrite) {
+    TTabletSchema tablet_schema;
+    tablet_schema.keys_type = TKeysType::UNIQUE_KEYS;
+    tablet_schema.sequence_col_idx = -1;
+    TabletMeta tablet_meta(1, 2, 3, 4, 5, tablet_schema, 6, {}, UniqueId(9, 10),
+                           TTabletType::TABLET_TYPE_DISK, true);
+    ASSERT_TRUE(tablet_meta.enable_unique_key_merge_on_write());
+    RowsetId rowset_id;
+    rowset_id.init(1);
+    tablet_meta.delete_bitmap().add({rowset_id, 0, 2}, 1);
+
+    TabletMetaPB tablet_meta_pb;
+    tablet_meta.to_meta_pb(&tablet_meta_pb);
+    TabletMeta parsed;
+    parsed.init_from_pb(tablet_meta_pb);
+    ASSERT_TRUE(parsed.enable_unique_key_merge_on_write());
+    ASSERT_TRUE(parsed.delete_bitmap().contains({rowset_id, 0, 2}, 1));
+
+    // the copy owns its delete bitmap
+    TabletMeta copied(tablet_meta);
+    ASSERT_TRUE(copied.delete_bitmap().contains({rowset_id, 0, 2}, 1));
+    copied.delete_bitmap().add({rowset_id, 0, 3}, 2);
+    ASSERT_FALSE(tablet_meta.delete_bitmap().contains({rowset_id, 0, 3}, 2));
+
+    // only unique key tablet without sequence column can be merge-on-write
+    tablet_schema.keys_type = TKeysType::DUP_KEYS;
+    TabletMeta dup_tablet_meta(1, 2, 3, 4, 5, tablet_schema, 6, {}, UniqueId(9, 10),
+                               TTabletType::TABLET_TYPE_DISK, true);
+    ASSERT_FALSE(dup_tablet_meta.enable_unique_key_merge_on_write());
+}
+
 } // namespace doris
 
 int main(int argc, char** argv) {
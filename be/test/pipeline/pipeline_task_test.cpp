@@ -0,0 +1,251 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "pipeline/pipeline_task.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include "pipeline/pipeline_fragment_context.h"
+#include "pipeline/task_scheduler.h"
+#include "runtime/runtime_state.h"
+#include "vec/columns/column_vector.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_number.h"
+
+namespace doris::pipeline {
+
+class MockSourceOperator : public SourceOperator {
+public:
+    explicit MockSourceOperator(int num_blocks)
+            : SourceOperator("MockSourceOperator"), _num_blocks(num_blocks) {}
+
+    bool can_read() override { return ready; }
+    Status get_block(RuntimeState* state, vectorized::Block* block, bool* eos) override {
+        if (no_data) {
+            return Status::OK();
+        }
+        auto column = vectorized::ColumnVector<Int32>::create();
+        for (int i = 0; i < 10; ++i) {
+            column->insert_value(i);
+        }
+        block->insert({column->get_ptr(), std::make_shared<vectorized::DataTypeInt32>(), "c"});
+        *eos = ++_produced == _num_blocks;
+        return Status::OK();
+    }
+
+    std::atomic<bool> ready {true};
+    // can_read() is true, but get_block() finds no data
+    bool no_data = false;
+
+private:
+    int _num_blocks;
+    int _produced = 0;
+};
+
+// Passes the input through, one block at a time.
+class MockOperator : public Operator {
+public:
+    MockOperator() : Operator("MockOperator") {}
+
+    bool need_more_input_data() const override { return !_has_block && !_eos; }
+    Status push(RuntimeState* state, vectorized::Block* input_block, bool eos) override {
+        _block.swap(*input_block);
+        _has_block = true;
+        _eos = eos;
+        return Status::OK();
+    }
+    Status pull(RuntimeState* state, vectorized::Block* output_block, bool* eos) override {
+        output_block->swap(_block);
+        _has_block = false;
+        *eos = _eos;
+        return Status::OK();
+    }
+
+private:
+    vectorized::Block _block;
+    bool _has_block = false;
+    bool _eos = false;
+};
+
+class MockSinkOperator : public SinkOperator {
+public:
+    MockSinkOperator() : SinkOperator("MockSinkOperator") {}
+
+    bool can_write() override { return writable; }
+    Status sink(RuntimeState* state, vectorized::Block* block, bool eos) override {
+        rows += block->rows();
+        return Status::OK();
+    }
+
+    bool writable = true;
+    int rows = 0;
+};
+
+class PipelineTaskTest : public testing::Test {
+public:
+    PipelineTaskTest() : _state(TQueryGlobals()) {}
+
+    PipelinePtr create_pipeline(PipelineId id, int num_blocks) {
+        auto pipeline = std::make_shared<Pipeline>(id);
+        auto source = std::make_unique<MockSourceOperator>(num_blocks);
+        auto sink = std::make_unique<MockSinkOperator>();
+        _source = source.get();
+        _sink = sink.get();
+        pipeline->set_source(std::move(source));
+        pipeline->add_operator(std::make_unique<MockOperator>());
+        pipeline->set_sink(std::move(sink));
+        return pipeline;
+    }
+
+protected:
+    RuntimeState _state;
+    MockSourceOperator* _source = nullptr;
+    MockSinkOperator* _sink = nullptr;
+};
+
+TEST_F(PipelineTaskTest, RunToEnd) {
+    auto pipeline = create_pipeline(0, 3);
+    ASSERT_TRUE(pipeline->check().ok());
+    PipelineTask task(pipeline.get(), &_state, nullptr, _state.runtime_profile());
+    ASSERT_TRUE(task.is_ready());
+
+    bool eos = false;
+    ASSERT_TRUE(task.execute(&eos).ok());
+    ASSERT_TRUE(eos);
+    ASSERT_EQ(PipelineTaskState::FINISHED, task.state());
+    ASSERT_EQ(30, _sink->rows);
+
+    ASSERT_FALSE(pipeline->is_finished());
+    ASSERT_TRUE(task.close().ok());
+    ASSERT_TRUE(pipeline->is_finished());
+}
+
+TEST_F(PipelineTaskTest, BlockedBySourceAndSink) {
+    auto pipeline = create_pipeline(0, 3);
+    PipelineTask task(pipeline.get(), &_state, nullptr, _state.runtime_profile());
+
+    bool eos = false;
+    _source->ready = false;
+    ASSERT_TRUE(task.execute(&eos).ok());
+    ASSERT_FALSE(eos);
+    ASSERT_EQ(PipelineTaskState::BLOCKED_FOR_SOURCE, task.state());
+    ASSERT_FALSE(task.is_ready());
+
+    _source->ready = true;
+    _sink->writable = false;
+    ASSERT_TRUE(task.is_ready());
+    ASSERT_TRUE(task.execute(&eos).ok());
+    ASSERT_FALSE(eos);
+    ASSERT_EQ(PipelineTaskState::BLOCKED_FOR_SINK, task.state());
+    ASSERT_FALSE(task.is_ready());
+    ASSERT_EQ(0, _sink->rows);
+
+    _sink->writable = true;
+    ASSERT_TRUE(task.is_ready());
+    ASSERT_TRUE(task.execute(&eos).ok());
+    ASSERT_TRUE(eos);
+    ASSERT_EQ(30, _sink->rows);
+    ASSERT_TRUE(task.close().ok());
+}
+
+TEST_F(PipelineTaskTest, BlockedByEmptySourceBlock) {
+    auto pipeline = create_pipeline(0, 3);
+    PipelineTask task(pipeline.get(), &_state, nullptr, _state.runtime_profile());
+
+    bool eos = false;
+    _source->no_data = true;
+    ASSERT_TRUE(task.execute(&eos).ok());
+    ASSERT_FALSE(eos);
+    ASSERT_EQ(PipelineTaskState::BLOCKED_FOR_SOURCE, task.state());
+    ASSERT_EQ(0, _sink->rows);
+
+    _source->no_data = false;
+    ASSERT_TRUE(task.is_ready());
+    ASSERT_TRUE(task.execute(&eos).ok());
+    ASSERT_TRUE(eos);
+    ASSERT_EQ(30, _sink->rows);
+    ASSERT_TRUE(task.close().ok());
+}
+
+TEST_F(PipelineTaskTest, Dependency) {
+    auto build = create_pipeline(0, 1);
+    auto probe = create_pipeline(1, 1);
+    probe->add_dependency(build);
+    PipelineTask build_task(build.get(), &_state, nullptr, _state.runtime_profile());
+    PipelineTask probe_task(probe.get(), &_state, nullptr, _state.runtime_profile());
+
+    ASSERT_EQ(PipelineTaskState::BLOCKED_FOR_DEPENDENCY, probe_task.state());
+    ASSERT_FALSE(probe_task.is_ready());
+    ASSERT_TRUE(build_task.is_ready());
+
+    bool eos = false;
+    ASSERT_TRUE(build_task.execute(&eos).ok());
+    ASSERT_TRUE(eos);
+    ASSERT_FALSE(probe_task.is_ready());
+    ASSERT_TRUE(build_task.close().ok());
+    ASSERT_TRUE(probe_task.is_ready());
+}
+
+TEST_F(PipelineTaskTest, Cancelled) {
+    auto pipeline = create_pipeline(0, 3);
+    PipelineTask task(pipeline.get(), &_state, nullptr, _state.runtime_profile());
+    _state.set_is_cancelled(true);
+    ASSERT_TRUE(task.is_cancelled());
+
+    bool eos = false;
+    ASSERT_TRUE(task.execute(&eos).is_cancelled());
+    ASSERT_FALSE(eos);
+    ASSERT_EQ(0, _sink->rows);
+    ASSERT_TRUE(task.close().ok());
+    ASSERT_TRUE(pipeline->is_finished());
+}
+
+TEST_F(PipelineTaskTest, WakeUpBlockedTask) {
+    auto pipeline = create_pipeline(0, 3);
+    std::promise<Status> finished;
+    auto context = std::make_shared<PipelineFragmentContext>(
+            &_state, nullptr, nullptr, [&](const Status& status) { finished.set_value(status); });
+    PipelineTask task(pipeline.get(), &_state, context.get(), _state.runtime_profile());
+    TaskScheduler scheduler(1);
+    ASSERT_TRUE(scheduler.start().ok());
+
+    _source->ready = false;
+    scheduler.submit(&task);
+    while (task.state() != PipelineTaskState::BLOCKED_FOR_SOURCE) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // the task is requeued by wake_up(), not by the safety net polling
+    _source->ready = true;
+    scheduler.wake_up();
+    auto future = finished.get_future();
+    ASSERT_EQ(std::future_status::ready, future.wait_for(std::chrono::milliseconds(50)));
+    ASSERT_TRUE(future.get().ok());
+    ASSERT_EQ(30, _sink->rows);
+    scheduler.shutdown();
+}
+
+} // namespace doris::pipeline
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
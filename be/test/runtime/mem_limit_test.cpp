@@ -17,6 +17,7 @@
 
 #include <gtest/gtest.h>
 
+#include "common/config.h"
 #include "runtime/mem_tracker.h"
 #include "util/logging.h"
 #include "util/metrics.h"
@@ -141,6 +142,54 @@ TEST(MemTestTest, TrackerHierarchyTryConsume) {
     c2->Release(10);
 }
 
+TEST(MemTestTest, ThreadCachedConsumption) {
+    config::mem_tracker_consume_min_size_bytes = 100;
+    auto p = MemTracker::CreateTracker(1000);
+    auto c1 = MemTracker::CreateTracker(-1, "c1", p);
+    auto c2 = MemTracker::CreateTracker(-1, "c2", p);
+    {
+        SCOPED_SWITCH_THREAD_MEM_TRACKER(c1);
+        // cached in the thread
+        c1->CacheConsume(60);
+        EXPECT_EQ(c1->consumption(), 0);
+        EXPECT_EQ(p->consumption(), 0);
+        EXPECT_EQ(tls_mem_tracker_mgr.untracked_mem(), 60);
+
+        // the thread isn't attached to c2
+        c2->CacheConsume(10);
+        EXPECT_EQ(c2->consumption(), 10);
+        EXPECT_EQ(p->consumption(), 10);
+
+        // flushed when over the threshold
+        c1->CacheConsume(50);
+        EXPECT_EQ(c1->consumption(), 110);
+        EXPECT_EQ(p->consumption(), 120);
+        EXPECT_EQ(tls_mem_tracker_mgr.untracked_mem(), 0);
+
+        c1->CacheRelease(30);
+        EXPECT_EQ(c1->consumption(), 110);
+        {
+            SCOPED_SWITCH_THREAD_MEM_TRACKER(c2);
+            // the cache of c1 is flushed when switching
+            EXPECT_EQ(c1->consumption(), 80);
+            c2->CacheRelease(10);
+        }
+        EXPECT_EQ(c2->consumption(), 0);
+        EXPECT_EQ(tls_mem_tracker_mgr.tracker(), c1.get());
+
+        // TryConsume checks the limit with the cached consumption
+        c1->CacheConsume(90);
+        EXPECT_TRUE(p->TryConsume(831).is_mem_limit_exceeded());
+        EXPECT_EQ(p->consumption(), 170);
+        c1->CacheRelease(50);
+    }
+    EXPECT_EQ(tls_mem_tracker_mgr.tracker(), nullptr);
+    EXPECT_EQ(c1->consumption(), 120);
+    c1->Release(120);
+    EXPECT_EQ(p->consumption(), 0);
+    config::mem_tracker_consume_min_size_bytes = 1048576;
+}
+
 } // end namespace doris
 
 int main(int argc, char** argv) {
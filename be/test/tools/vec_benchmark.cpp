@@ -0,0 +1,817 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// Micro benchmarks of the vectorized operators: the hash aggregation and hash join nodes, and
+// the kernels of sort, merge of sorted runs, block serialization, filter and scalar functions.
+// The input is generated with configurable rows, key skew and null ratio, the key
+// cardinality is the argument of each benchmark.
+
+#include <benchmark/benchmark.h>
+#include <gflags/gflags.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "common/object_pool.h"
+#include "gen_cpp/Exprs_types.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "gen_cpp/data.pb.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+#include "runtime/memory/chunk_allocator.h"
+#include "runtime/runtime_state.h"
+#include "runtime/types.h"
+#include "testutil/function_utils.h"
+#include "udf/udf.h"
+#include "util/runtime_profile.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/core/block.h"
+#include "vec/core/sort_block.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/exec/join/vhash_join_node.h"
+#include "vec/exec/vaggregation_node.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/exprs/vexpr_context.h"
+#include "vec/functions/simple_function_factory.h"
+#include "vec/runtime/vsorted_run_merger.h"
+
+DEFINE_int64(rows, 1 << 20, "rows of the generated input");
+DEFINE_double(skew, 0, "Zipf exponent of the keys, 0 means uniform distribution");
+DEFINE_double(null_ratio, 0, "ratio of null keys in the nullable benchmarks");
+DEFINE_int32(runs, 8, "number of sorted runs to merge in VSortedRunMerger benchmark");
+DEFINE_int32(seed, 2022, "seed of the data generator");
+
+std::string get_usage(const std::string& progname) {
+    std::stringstream ss;
+    ss << progname << " is the Doris BE vectorized operators benchmark tool.\n";
+    ss << "Usage:\n";
+    ss << "./vec_benchmark --rows=1048576 --skew=1.1 --null_ratio=0.1 "
+          "--benchmark_filter=Agg\n";
+    return ss.str();
+}
+
+namespace doris::vectorized {
+
+// Generates keys in [0, cardinality), the keys follow Zipf distribution if skew is not 0.
+class KeyGenerator {
+public:
+    KeyGenerator(int64_t cardinality, double skew) : _cardinality(cardinality), _rng(FLAGS_seed) {
+        if (skew > 0) {
+            _cdf.resize(cardinality);
+            double sum = 0;
+            for (int64_t i = 0; i < cardinality; ++i) {
+                sum += 1.0 / std::pow(i + 1, skew);
+                _cdf[i] = sum;
+            }
+            for (auto& v : _cdf) {
+                v /= sum;
+            }
+        }
+    }
+
+    int64_t next() {
+        if (_cdf.empty()) {
+            return std::uniform_int_distribution<int64_t>(0, _cardinality - 1)(_rng);
+        }
+        double p = std::uniform_real_distribution<double>(0, 1)(_rng);
+        auto pos = std::lower_bound(_cdf.begin(), _cdf.end(), p) - _cdf.begin();
+        return std::min<int64_t>(pos, _cardinality - 1);
+    }
+
+    // Keys are scattered in the domain, so that they are not clustered by frequency.
+    int64_t next_scattered() { return (next() * 0x9E3779B97F4A7C15ULL) >> 1; }
+
+private:
+    int64_t _cardinality;
+    std::mt19937_64 _rng;
+    std::vector<double> _cdf;
+};
+
+static ColumnPtr make_int64_keys(size_t rows, int64_t cardinality) {
+    KeyGenerator generator(cardinality, FLAGS_skew);
+    auto column = ColumnInt64::create();
+    auto& data = column->get_data();
+    data.resize(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        data[i] = generator.next_scattered();
+    }
+    return column;
+}
+
+static ColumnPtr make_string_keys(size_t rows, int64_t cardinality) {
+    KeyGenerator generator(cardinality, FLAGS_skew);
+    auto column = ColumnString::create();
+    for (size_t i = 0; i < rows; ++i) {
+        std::string key = "key_" + std::to_string(generator.next_scattered());
+        column->insert_data(key.data(), key.size());
+    }
+    return column;
+}
+
+// Wraps the column into a nullable column with FLAGS_null_ratio of null rows.
+static ColumnPtr make_nullable_keys(const ColumnPtr& column) {
+    std::mt19937_64 rng(FLAGS_seed);
+    std::bernoulli_distribution is_null(FLAGS_null_ratio);
+    auto null_map = ColumnUInt8::create(column->size(), 0);
+    for (auto& v : null_map->get_data()) {
+        v = is_null(rng);
+    }
+    return ColumnNullable::create(column, std::move(null_map));
+}
+
+static size_t input_rows() {
+    return FLAGS_rows;
+}
+
+static void set_items_processed(benchmark::State& state, size_t rows) {
+    state.SetItemsProcessed(state.iterations() * rows);
+}
+
+/////////////////////////////////////////////////////////////
+// Hash aggregation and hash join, the plan nodes are driven with the generated blocks as the
+// pipeline operators drive them: sink() and pull() of AggregationNode, sink(), push() and
+// pull() of HashJoinNode.
+/////////////////////////////////////////////////////////////
+
+// The input tuple has k1 BIGINT, k2 STRING, k3 nullable BIGINT and v BIGINT, the build tuple of
+// the join has b1 BIGINT and b2 STRING, the aggregation outputs its keys and sum(v).
+constexpr TupleId INPUT_TUPLE_ID = 0;
+constexpr TupleId BUILD_TUPLE_ID = 1;
+constexpr TupleId AGG_TUPLE_ID = 2;
+constexpr SlotId K1_SLOT = 0;
+constexpr SlotId K2_SLOT = 1;
+constexpr SlotId K3_SLOT = 2;
+constexpr SlotId V_SLOT = 3;
+constexpr SlotId B1_SLOT = 4;
+constexpr SlotId B2_SLOT = 5;
+constexpr size_t BATCH_SIZE = 4096;
+
+struct SlotType {
+    PrimitiveType type;
+    bool nullable;
+};
+
+static const SlotType INPUT_SLOTS[] = {
+        {TYPE_BIGINT, false}, {TYPE_STRING, false}, {TYPE_BIGINT, true}, {TYPE_BIGINT, false}};
+static const SlotType BUILD_SLOTS[] = {{TYPE_BIGINT, false}, {TYPE_STRING, false}};
+
+static void check(const Status& st) {
+    CHECK(st.ok()) << st.to_string();
+}
+
+// Only describes the rows of a child, the blocks are passed to the node by the benchmark.
+class MockChildNode final : public ExecNode {
+public:
+    using ExecNode::ExecNode;
+
+    Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) override {
+        return Status::NotSupported("Not Implemented MockChildNode::get_next scalar");
+    }
+    Status get_next(RuntimeState* state, Block* block, bool* eos) override {
+        return Status::NotSupported("Not Implemented MockChildNode::get_next");
+    }
+};
+
+template <typename Node>
+class NodeWithChildren : public Node {
+public:
+    using Node::Node;
+
+    void add_child(ExecNode* child) { this->_children.push_back(child); }
+};
+
+static TExprNode create_slot_ref(SlotId slot_id, TupleId tuple_id, const SlotType& slot_type) {
+    TExprNode node;
+    node.node_type = TExprNodeType::SLOT_REF;
+    node.type = TypeDescriptor(slot_type.type).to_thrift();
+    node.num_children = 0;
+    node.__isset.slot_ref = true;
+    node.slot_ref.slot_id = slot_id;
+    node.slot_ref.tuple_id = tuple_id;
+    node.__set_is_nullable(slot_type.nullable);
+    return node;
+}
+
+// sum(v)
+static TExpr create_sum() {
+    TTypeDesc bigint = TypeDescriptor(TYPE_BIGINT).to_thrift();
+    TExprNode sum;
+    sum.node_type = TExprNodeType::AGG_EXPR;
+    sum.type = bigint;
+    sum.num_children = 1;
+    TFunction fn;
+    fn.name.function_name = "sum";
+    fn.binary_type = TFunctionBinaryType::BUILTIN;
+    fn.arg_types = {bigint};
+    fn.ret_type = bigint;
+    fn.has_var_args = false;
+    fn.__isset.aggregate_fn = true;
+    fn.aggregate_fn.intermediate_type = bigint;
+    sum.__set_fn(fn);
+    sum.__isset.agg_expr = true;
+    sum.agg_expr.is_merge_agg = false;
+    sum.__set_is_nullable(true);
+
+    TExpr expr;
+    expr.nodes = {sum, create_slot_ref(V_SLOT, INPUT_TUPLE_ID, INPUT_SLOTS[V_SLOT])};
+    return expr;
+}
+
+static TPlanNode create_plan_node(TPlanNodeType::type type, int num_children,
+                                  const std::vector<TTupleId>& row_tuples) {
+    TPlanNode tnode;
+    tnode.node_id = 0;
+    tnode.node_type = type;
+    tnode.num_children = num_children;
+    tnode.limit = -1;
+    tnode.row_tuples = row_tuples;
+    tnode.nullable_tuples = std::vector<bool>(row_tuples.size(), false);
+    tnode.compact_data = false;
+    return tnode;
+}
+
+// The descriptors and the runtime state of a plan, `agg_keys` are the input slots the
+// aggregation groups by.
+class PlanContext {
+public:
+    explicit PlanContext(const std::vector<SlotId>& agg_keys = {}) {
+        TDescriptorTableBuilder table_builder;
+        auto slot = [](const SlotType& slot_type) {
+            return TSlotDescriptorBuilder()
+                    .type(slot_type.type)
+                    .nullable(slot_type.nullable)
+                    .build();
+        };
+        TTupleDescriptorBuilder input_tuple;
+        for (const auto& slot_type : INPUT_SLOTS) {
+            input_tuple.add_slot(slot(slot_type));
+        }
+        input_tuple.build(&table_builder);
+        TTupleDescriptorBuilder build_tuple;
+        for (const auto& slot_type : BUILD_SLOTS) {
+            build_tuple.add_slot(slot(slot_type));
+        }
+        build_tuple.build(&table_builder);
+        TTupleDescriptorBuilder agg_tuple;
+        for (SlotId key : agg_keys) {
+            agg_tuple.add_slot(slot(INPUT_SLOTS[key]));
+        }
+        agg_tuple.add_slot(slot({TYPE_BIGINT, true}));
+        agg_tuple.build(&table_builder);
+        check(DescriptorTbl::create(&pool, table_builder.desc_tbl(), &desc_tbl));
+
+        TQueryOptions query_options;
+        query_options.batch_size = BATCH_SIZE;
+        query_options.enable_vectorized_engine = true;
+        state = std::make_unique<RuntimeState>(TUniqueId(), query_options, TQueryGlobals(),
+                                               nullptr);
+        check(state->init_instance_mem_tracker());
+        state->set_desc_tbl(desc_tbl);
+    }
+
+    ExecNode* create_child(TupleId tuple_id) {
+        TPlanNode tnode = create_plan_node(TPlanNodeType::EXCHANGE_NODE, 0, {tuple_id});
+        auto* child = pool.add(new MockChildNode(&pool, tnode, *desc_tbl));
+        check(child->init(tnode, state.get()));
+        return child;
+    }
+
+    ObjectPool pool;
+    DescriptorTbl* desc_tbl = nullptr;
+    std::unique_ptr<RuntimeState> state;
+};
+
+// Cuts the columns into blocks of BATCH_SIZE rows, as the children of the nodes return.
+static std::vector<Block> split_block(const Block& block) {
+    std::vector<Block> blocks;
+    for (size_t offset = 0; offset < block.rows(); offset += BATCH_SIZE) {
+        size_t length = std::min(BATCH_SIZE, block.rows() - offset);
+        Block batch = block.clone_empty();
+        for (size_t i = 0; i < block.columns(); ++i) {
+            batch.get_by_position(i).column = block.get_by_position(i).column->cut(offset, length);
+        }
+        blocks.emplace_back(std::move(batch));
+    }
+    return blocks;
+}
+
+// The rows of the input tuple, the keys are generated in [0, cardinality).
+static std::vector<Block> make_input_blocks(size_t rows, int64_t cardinality) {
+    auto int_type = std::make_shared<DataTypeInt64>();
+    Block block({{make_int64_keys(rows, cardinality), int_type, "k1"},
+                 {make_string_keys(rows, cardinality), std::make_shared<DataTypeString>(), "k2"},
+                 {make_nullable_keys(make_int64_keys(rows, cardinality)), make_nullable(int_type),
+                  "k3"},
+                 {make_int64_keys(rows, rows), int_type, "v"}});
+    return split_block(block);
+}
+
+// SELECT <keys>, sum(v) FROM input GROUP BY <keys>
+class AggregationPlan {
+public:
+    explicit AggregationPlan(const std::vector<SlotId>& keys) : _context(keys) {
+        TPlanNode tnode = create_plan_node(TPlanNodeType::AGGREGATION_NODE, 1, {AGG_TUPLE_ID});
+        tnode.__isset.agg_node = true;
+        std::vector<TExpr> grouping_exprs(keys.size());
+        for (size_t i = 0; i < keys.size(); ++i) {
+            grouping_exprs[i].nodes = {
+                    create_slot_ref(keys[i], INPUT_TUPLE_ID, INPUT_SLOTS[keys[i]])};
+        }
+        tnode.agg_node.__set_grouping_exprs(grouping_exprs);
+        tnode.agg_node.aggregate_functions = {create_sum()};
+        tnode.agg_node.intermediate_tuple_id = AGG_TUPLE_ID;
+        tnode.agg_node.output_tuple_id = AGG_TUPLE_ID;
+        tnode.agg_node.need_finalize = true;
+
+        auto* node = _context.pool.add(
+                new NodeWithChildren<AggregationNode>(&_context.pool, tnode, *_context.desc_tbl));
+        node->add_child(_context.create_child(INPUT_TUPLE_ID));
+        _node = node;
+        RuntimeState* state = _context.state.get();
+        check(_node->init(tnode, state));
+        check(_node->prepare(state));
+        check(_node->alloc_resource(state));
+    }
+
+    ~AggregationPlan() { check(_node->close(_context.state.get())); }
+
+    // Returns the number of groups.
+    size_t execute(const std::vector<Block>& blocks) {
+        RuntimeState* state = _context.state.get();
+        for (size_t i = 0; i < blocks.size(); ++i) {
+            Block block = blocks[i];
+            check(_node->sink(state, &block, i + 1 == blocks.size()));
+        }
+        size_t groups = 0;
+        bool eos = false;
+        while (!eos) {
+            Block block;
+            check(_node->pull(state, &block, &eos));
+            groups += block.rows();
+        }
+        return groups;
+    }
+
+private:
+    PlanContext _context;
+    AggregationNode* _node = nullptr;
+};
+
+static void run_agg(benchmark::State& state, const std::vector<SlotId>& keys) {
+    auto blocks = make_input_blocks(input_rows(), state.range(0));
+    std::unique_ptr<AggregationPlan> plan;
+    for (auto _ : state) {
+        state.PauseTiming();
+        plan.reset();
+        plan = std::make_unique<AggregationPlan>(keys);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(plan->execute(blocks));
+    }
+    set_items_processed(state, input_rows());
+}
+
+static void BM_AggInt64Key(benchmark::State& state) {
+    run_agg(state, {K1_SLOT});
+}
+
+static void BM_AggStringKey(benchmark::State& state) {
+    run_agg(state, {K2_SLOT});
+}
+
+static void BM_AggInt64AndStringKeys(benchmark::State& state) {
+    run_agg(state, {K1_SLOT, K2_SLOT});
+}
+
+static void BM_AggInt64AndNullableKeys(benchmark::State& state) {
+    run_agg(state, {K1_SLOT, K3_SLOT});
+}
+
+// SELECT * FROM input JOIN build ON input.k1 = build.b1, or on the string keys k2 = b2.
+class HashJoinPlan {
+public:
+    explicit HashJoinPlan(bool string_key) {
+        TPlanNode tnode = create_plan_node(TPlanNodeType::HASH_JOIN_NODE, 2,
+                                           {INPUT_TUPLE_ID, BUILD_TUPLE_ID});
+        tnode.__isset.hash_join_node = true;
+        tnode.hash_join_node.join_op = TJoinOp::INNER_JOIN;
+        SlotId probe_slot = string_key ? K2_SLOT : K1_SLOT;
+        SlotId build_slot = string_key ? B2_SLOT : B1_SLOT;
+        TEqJoinCondition condition;
+        condition.left.nodes = {
+                create_slot_ref(probe_slot, INPUT_TUPLE_ID, INPUT_SLOTS[probe_slot])};
+        condition.right.nodes = {create_slot_ref(build_slot, BUILD_TUPLE_ID,
+                                                 BUILD_SLOTS[build_slot - B1_SLOT])};
+        condition.__set_opcode(TExprOpcode::EQ);
+        tnode.hash_join_node.eq_join_conjuncts = {condition};
+
+        auto* node = _context.pool.add(
+                new NodeWithChildren<HashJoinNode>(&_context.pool, tnode, *_context.desc_tbl));
+        node->add_child(_context.create_child(INPUT_TUPLE_ID));
+        node->add_child(_context.create_child(BUILD_TUPLE_ID));
+        _node = node;
+        RuntimeState* state = _context.state.get();
+        check(_node->init(tnode, state));
+        check(_node->prepare(state));
+        check(_node->alloc_resource(state));
+    }
+
+    ~HashJoinPlan() { check(_node->close(_context.state.get())); }
+
+    void build(const std::vector<Block>& blocks) {
+        for (size_t i = 0; i < blocks.size(); ++i) {
+            Block block = blocks[i];
+            check(_node->sink(_context.state.get(), &block, i + 1 == blocks.size()));
+        }
+    }
+
+    // Returns the number of joined rows.
+    size_t probe(const std::vector<Block>& blocks) {
+        RuntimeState* state = _context.state.get();
+        size_t joined_rows = 0;
+        for (size_t i = 0; i < blocks.size(); ++i) {
+            Block block = blocks[i];
+            check(_node->push(state, &block, i + 1 == blocks.size()));
+            bool eos = false;
+            while (!eos && !_node->need_more_input_data()) {
+                Block output;
+                check(_node->pull(state, &output, &eos));
+                joined_rows += output.rows();
+            }
+        }
+        return joined_rows;
+    }
+
+private:
+    PlanContext _context;
+    HashJoinNode* _node = nullptr;
+};
+
+// The rows of the build tuple, the keys are generated in [0, cardinality), or are all of
+// [0, cardinality) in order if `unique` is set.
+static std::vector<Block> make_build_blocks(size_t rows, int64_t cardinality, bool unique) {
+    KeyGenerator generator(cardinality, FLAGS_skew);
+    auto int_keys = ColumnInt64::create();
+    auto string_keys = ColumnString::create();
+    for (size_t i = 0; i < rows; ++i) {
+        int64_t key = unique ? i : generator.next();
+        std::string string_key = "key_" + std::to_string(key);
+        int_keys->insert_value(key);
+        string_keys->insert_data(string_key.data(), string_key.size());
+    }
+    return split_block(Block({{std::move(int_keys), std::make_shared<DataTypeInt64>(), "b1"},
+                              {std::move(string_keys), std::make_shared<DataTypeString>(), "b2"}}));
+}
+
+// The rows of the input tuple, with keys in [0, cardinality * 2), so that half of the probe
+// rows are matched by the unique build keys.
+static std::vector<Block> make_probe_blocks(size_t rows, int64_t cardinality) {
+    KeyGenerator generator(cardinality * 2, FLAGS_skew);
+    auto int_keys = ColumnInt64::create();
+    auto string_keys = ColumnString::create();
+    for (size_t i = 0; i < rows; ++i) {
+        int64_t key = generator.next();
+        std::string string_key = "key_" + std::to_string(key);
+        int_keys->insert_value(key);
+        string_keys->insert_data(string_key.data(), string_key.size());
+    }
+    auto int_type = std::make_shared<DataTypeInt64>();
+    ColumnPtr nullable_keys = make_nullable_keys(int_keys->get_ptr());
+    ColumnPtr values = int_keys->get_ptr();
+    return split_block(Block({{std::move(int_keys), int_type, "k1"},
+                              {std::move(string_keys), std::make_shared<DataTypeString>(), "k2"},
+                              {nullable_keys, make_nullable(int_type), "k3"},
+                              {values, int_type, "v"}}));
+}
+
+static void run_join_build(benchmark::State& state, bool string_key) {
+    auto blocks = make_build_blocks(input_rows(), state.range(0), false);
+    std::unique_ptr<HashJoinPlan> plan;
+    for (auto _ : state) {
+        state.PauseTiming();
+        plan.reset();
+        plan = std::make_unique<HashJoinPlan>(string_key);
+        state.ResumeTiming();
+        plan->build(blocks);
+    }
+    set_items_processed(state, input_rows());
+}
+
+static void run_join_probe(benchmark::State& state, bool string_key) {
+    HashJoinPlan plan(string_key);
+    plan.build(make_build_blocks(state.range(0), state.range(0), true));
+    auto blocks = make_probe_blocks(input_rows(), state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(plan.probe(blocks));
+    }
+    set_items_processed(state, input_rows());
+}
+
+static void BM_JoinBuildInt64Key(benchmark::State& state) {
+    run_join_build(state, false);
+}
+
+static void BM_JoinBuildStringKey(benchmark::State& state) {
+    run_join_build(state, true);
+}
+
+static void BM_JoinProbeInt64Key(benchmark::State& state) {
+    run_join_probe(state, false);
+}
+
+static void BM_JoinProbeStringKey(benchmark::State& state) {
+    run_join_probe(state, true);
+}
+
+/////////////////////////////////////////////////////////////
+// Sort, merge of sorted runs, serialization and filter.
+/////////////////////////////////////////////////////////////
+
+static Block make_block(size_t rows, int64_t cardinality) {
+    auto int_keys = make_int64_keys(rows, cardinality);
+    auto string_keys = make_string_keys(rows, cardinality);
+    auto nullable_keys = make_nullable_keys(make_int64_keys(rows, cardinality));
+    auto int_type = std::make_shared<DataTypeInt64>();
+    return Block({{int_keys, int_type, "k1"},
+                  {string_keys, std::make_shared<DataTypeString>(), "k2"},
+                  {nullable_keys, make_nullable(int_type), "k3"}});
+}
+
+static void BM_SortBlockInt64(benchmark::State& state) {
+    Block input = make_block(input_rows(), state.range(0));
+    SortDescription description {SortColumnDescription(0, 1, 1)};
+    for (auto _ : state) {
+        state.PauseTiming();
+        Block block = input;
+        state.ResumeTiming();
+        sort_block(block, description);
+        benchmark::DoNotOptimize(block.rows());
+    }
+    set_items_processed(state, input.rows());
+}
+
+static void BM_SortBlockStringAndNullable(benchmark::State& state) {
+    Block input = make_block(input_rows(), state.range(0));
+    SortDescription description {SortColumnDescription(1, 1, 1), SortColumnDescription(2, -1, 1)};
+    for (auto _ : state) {
+        state.PauseTiming();
+        Block block = input;
+        state.ResumeTiming();
+        sort_block(block, description);
+        benchmark::DoNotOptimize(block.rows());
+    }
+    set_items_processed(state, input.rows());
+}
+
+static void BM_SortBlockTopN(benchmark::State& state) {
+    Block input = make_block(input_rows(), state.range(0));
+    SortDescription description {SortColumnDescription(0, 1, 1)};
+    for (auto _ : state) {
+        state.PauseTiming();
+        Block block = input;
+        state.ResumeTiming();
+        sort_block(block, description, 100);
+        benchmark::DoNotOptimize(block.rows());
+    }
+    set_items_processed(state, input.rows());
+}
+
+// Returns the column at a fixed position of the block, as a slot ref does.
+class ColumnRefExpr final : public VExpr {
+public:
+    explicit ColumnRefExpr(int column_id)
+            : VExpr(TypeDescriptor(TYPE_BIGINT), false, false), _column_id(column_id) {}
+
+    Status execute(VExprContext* context, Block* block, int* result_column_id) override {
+        *result_column_id = _column_id;
+        return Status::OK();
+    }
+    VExpr* clone(ObjectPool* pool) const override { return pool->add(new ColumnRefExpr(*this)); }
+    const std::string& expr_name() const override { return _name; }
+
+private:
+    int _column_id;
+    std::string _name = "column_ref";
+};
+
+static void BM_MergeSortedRuns(benchmark::State& state) {
+    size_t run_rows = input_rows() / FLAGS_runs;
+    size_t batch_size = 4096;
+    std::vector<std::vector<Block>> runs(FLAGS_runs);
+    SortDescription description {SortColumnDescription(0, 1, 1)};
+    for (auto& run : runs) {
+        Block sorted = make_block(run_rows, state.range(0));
+        sort_block(sorted, description);
+        for (size_t offset = 0; offset < run_rows; offset += batch_size) {
+            size_t length = std::min(batch_size, run_rows - offset);
+            Block batch = sorted.clone_empty();
+            for (size_t i = 0; i < sorted.columns(); ++i) {
+                batch.get_by_position(i).column =
+                        sorted.get_by_position(i).column->cut(offset, length);
+            }
+            run.emplace_back(std::move(batch));
+        }
+    }
+
+    ColumnRefExpr ordering_expr(0);
+    VExprContext ordering_ctx(&ordering_expr);
+    for (auto _ : state) {
+        RuntimeProfile profile("VSortedRunMerger");
+        VSortedRunMerger merger({&ordering_ctx}, {true}, {false}, batch_size, -1, 0, &profile);
+        std::vector<BlockSupplier> suppliers;
+        for (auto& run : runs) {
+            suppliers.emplace_back([&run, pos = size_t(0)](Block** block) mutable {
+                *block = pos < run.size() ? &run[pos++] : nullptr;
+                return Status::OK();
+            });
+        }
+        merger.prepare(suppliers);
+        bool eos = false;
+        size_t merged_rows = 0;
+        while (!eos) {
+            Block output;
+            merger.get_next(&output, &eos);
+            merged_rows += output.rows();
+        }
+        benchmark::DoNotOptimize(merged_rows);
+    }
+    set_items_processed(state, run_rows * FLAGS_runs);
+}
+
+static void BM_BlockSerialize(benchmark::State& state) {
+    Block block = make_block(input_rows(), state.range(0));
+    for (auto _ : state) {
+        PBlock pblock;
+        benchmark::DoNotOptimize(block.serialize(&pblock));
+    }
+    set_items_processed(state, block.rows());
+}
+
+static void BM_BlockDeserialize(benchmark::State& state) {
+    Block block = make_block(input_rows(), state.range(0));
+    PBlock pblock;
+    block.serialize(&pblock);
+    for (auto _ : state) {
+        Block deserialized(pblock);
+        benchmark::DoNotOptimize(deserialized.rows());
+    }
+    set_items_processed(state, block.rows());
+}
+
+// The filter keeps state.range(0) percent of rows.
+static void BM_BlockFilter(benchmark::State& state) {
+    Block input = make_block(input_rows(), input_rows());
+    std::mt19937_64 rng(FLAGS_seed);
+    std::bernoulli_distribution keep(state.range(0) / 100.0);
+    auto filter = ColumnUInt8::create(input.rows());
+    for (auto& v : filter->get_data()) {
+        v = keep(rng);
+    }
+    ColumnPtr filter_column = std::move(filter);
+    size_t columns = input.columns();
+    for (auto _ : state) {
+        state.PauseTiming();
+        Block block = input;
+        block.insert({filter_column, std::make_shared<DataTypeUInt8>(), "filter"});
+        state.ResumeTiming();
+        Block::filter_block(&block, columns, columns);
+        benchmark::DoNotOptimize(block.rows());
+    }
+    set_items_processed(state, input.rows());
+}
+
+/////////////////////////////////////////////////////////////
+// Scalar functions, called as VectorizedFnCall does.
+/////////////////////////////////////////////////////////////
+
+static void run_function(benchmark::State& state, const std::string& name, Block input,
+                         const DataTypePtr& return_type) {
+    ColumnsWithTypeAndName arguments;
+    ColumnNumbers argument_ids;
+    for (size_t i = 0; i < input.columns(); ++i) {
+        arguments.push_back(input.get_by_position(i));
+        argument_ids.push_back(i);
+    }
+    auto function = SimpleFunctionFactory::instance().get_function(name, arguments, return_type);
+    if (function == nullptr) {
+        state.SkipWithError(("function not found: " + name).c_str());
+        return;
+    }
+    FunctionUtils fn_utils;
+    auto* fn_ctx = fn_utils.get_fn_ctx();
+    function->prepare(fn_ctx, FunctionContext::FRAGMENT_LOCAL);
+    function->prepare(fn_ctx, FunctionContext::THREAD_LOCAL);
+
+    size_t rows = input.rows();
+    for (auto _ : state) {
+        state.PauseTiming();
+        Block block = input;
+        block.insert({nullptr, return_type, "result"});
+        state.ResumeTiming();
+        function->execute(fn_ctx, block, argument_ids, block.columns() - 1, rows);
+        benchmark::DoNotOptimize(block.get_by_position(block.columns() - 1).column.get());
+    }
+
+    function->close(fn_ctx, FunctionContext::THREAD_LOCAL);
+    function->close(fn_ctx, FunctionContext::FRAGMENT_LOCAL);
+    set_items_processed(state, rows);
+}
+
+static void BM_FunctionAdd(benchmark::State& state) {
+    auto type = std::make_shared<DataTypeInt64>();
+    Block input({{make_int64_keys(input_rows(), state.range(0)), type, "a"},
+                 {make_int64_keys(input_rows(), state.range(0)), type, "b"}});
+    run_function(state, "add", std::move(input), type);
+}
+
+static void BM_FunctionAddNullable(benchmark::State& state) {
+    auto type = make_nullable(std::make_shared<DataTypeInt64>());
+    Block input({{make_nullable_keys(make_int64_keys(input_rows(), state.range(0))), type, "a"},
+                 {make_nullable_keys(make_int64_keys(input_rows(), state.range(0))), type, "b"}});
+    run_function(state, "add", std::move(input), type);
+}
+
+static void BM_FunctionEq(benchmark::State& state) {
+    auto type = std::make_shared<DataTypeInt64>();
+    Block input({{make_int64_keys(input_rows(), state.range(0)), type, "a"},
+                 {make_int64_keys(input_rows(), state.range(0)), type, "b"}});
+    run_function(state, "eq", std::move(input), std::make_shared<DataTypeUInt8>());
+}
+
+static void BM_FunctionLength(benchmark::State& state) {
+    Block input({{make_string_keys(input_rows(), state.range(0)),
+                  std::make_shared<DataTypeString>(), "a"}});
+    run_function(state, "length", std::move(input), std::make_shared<DataTypeInt32>());
+}
+
+static void BM_FunctionUpper(benchmark::State& state) {
+    auto type = std::make_shared<DataTypeString>();
+    Block input({{make_string_keys(input_rows(), state.range(0)), type, "a"}});
+    run_function(state, "upper", std::move(input), type);
+}
+
+// The argument is the number of distinct keys, from cache resident to memory bound tables.
+#define CARDINALITY_ARGS \
+    ->Arg(1 << 4)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond)
+
+BENCHMARK(BM_AggInt64Key) CARDINALITY_ARGS;
+BENCHMARK(BM_AggStringKey) CARDINALITY_ARGS;
+BENCHMARK(BM_AggInt64AndStringKeys) CARDINALITY_ARGS;
+BENCHMARK(BM_AggInt64AndNullableKeys) CARDINALITY_ARGS;
+BENCHMARK(BM_JoinBuildInt64Key) CARDINALITY_ARGS;
+BENCHMARK(BM_JoinBuildStringKey) CARDINALITY_ARGS;
+BENCHMARK(BM_JoinProbeInt64Key) CARDINALITY_ARGS;
+BENCHMARK(BM_JoinProbeStringKey) CARDINALITY_ARGS;
+BENCHMARK(BM_SortBlockInt64) CARDINALITY_ARGS;
+BENCHMARK(BM_SortBlockStringAndNullable) CARDINALITY_ARGS;
+BENCHMARK(BM_SortBlockTopN) CARDINALITY_ARGS;
+BENCHMARK(BM_MergeSortedRuns) CARDINALITY_ARGS;
+BENCHMARK(BM_BlockSerialize)->Arg(1 << 10)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BlockDeserialize)->Arg(1 << 10)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BlockFilter)->Arg(1)->Arg(50)->Arg(99)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FunctionAdd)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FunctionAddNullable)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FunctionEq)->Arg(1 << 4)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FunctionLength)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FunctionUpper)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+#undef CARDINALITY_ARGS
+
+} // namespace doris::vectorized
+
+int main(int argc, char** argv) {
+    std::string usage = get_usage(argv[0]);
+    gflags::SetUsageMessage(usage);
+    google::ParseCommandLineFlags(&argc, &argv, true);
+
+    doris::ChunkAllocator::init_instance(4096);
+    doris::vectorized::SimpleFunctionFactory::instance();
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
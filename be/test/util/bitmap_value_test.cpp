@@ -19,6 +19,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "util/coding.h"
 #define private public
@@ -66,6 +67,45 @@ TEST(BitmapValueTest, bitmap_union) {
     ASSERT_EQ(5, bitmap2.cardinality());
 }
 
+TEST(BitmapValueTest, bitmap_fastunion) {
+    BitmapValue empty;
+    BitmapValue single(1024);
+    BitmapValue single64(uint64_t(1) << 40);
+    BitmapValue bitmap({1024, 1025, 1026});
+    BitmapValue bitmap64({1, uint64_t(1) << 40, (uint64_t(1) << 40) + 1});
+
+    BitmapValue res;
+    res.fastunion({&empty, &single});
+    ASSERT_EQ(1, res.cardinality());
+    res.fastunion({&empty, &single, &single64});
+    ASSERT_EQ(2, res.cardinality());
+    res.fastunion({&bitmap, &single, &bitmap64, &empty});
+    ASSERT_EQ("1,1024,1025,1026,1099511627776,1099511627777", res.to_string());
+
+    BitmapValue expected;
+    BitmapValue fast_res(7);
+    std::vector<BitmapValue> values;
+    for (uint64_t i = 0; i < 100; ++i) {
+        values.emplace_back(std::vector<uint64_t> {i * 1000, i * 1000 + 1, i << 32});
+    }
+    std::vector<const BitmapValue*> inputs;
+    for (const auto& value : values) {
+        expected |= value;
+        inputs.push_back(&value);
+    }
+    expected.add(7);
+    fast_res.fastunion(inputs);
+    ASSERT_EQ(expected.to_string(), fast_res.to_string());
+
+    BitmapValue many;
+    std::vector<uint64_t> sorted_values {5, 5};
+    many.add_many(sorted_values.data(), sorted_values.size());
+    ASSERT_EQ(1, many.cardinality());
+    sorted_values = {1, 5, 8, uint64_t(1) << 33, (uint64_t(1) << 33) + 2};
+    many.add_many(sorted_values.data(), sorted_values.size());
+    ASSERT_EQ("1,5,8,8589934592,8589934594", many.to_string());
+}
+
 TEST(BitmapValueTest, bitmap_intersect) {
     BitmapValue empty;
     BitmapValue single(1024);
@@ -19,7 +19,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <random>
+#include <vector>
 
 #include "test_util/test_util.h"
 
@@ -246,6 +248,25 @@ TEST_F(TDigestTest, Montonicity) {
     }
 }
 
+TEST_F(TDigestTest, AddBatch) {
+    std::vector<double> values;
+    for (int i = 0; i < 10000; ++i) {
+        values.push_back((i * 7919) % 10007);
+    }
+    values.push_back(NAN);
+    TDigest digest(100);
+    for (auto value : values) {
+        digest.add(value);
+    }
+    TDigest batch_digest(100);
+    batch_digest.add_batch(values.data(), values.size() / 3);
+    batch_digest.add_batch(values.data() + values.size() / 3, values.size() - values.size() / 3);
+    EXPECT_EQ(digest.totalWeight(), batch_digest.totalWeight());
+    for (double q : {0.0, 0.01, 0.25, 0.5, 0.9, 0.999, 1.0}) {
+        EXPECT_EQ(digest.quantile(q), batch_digest.quantile(q)) << q;
+    }
+}
+
 } // namespace doris
 
 int main(int argc, char** argv) {
@@ -15,14 +15,22 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "vec/aggregate_functions/aggregate_function.h"
 #include "vec/aggregate_functions/aggregate_function_simple_factory.h"
+#include "vec/columns/column_bitmap.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
 #include "vec/columns/column_vector.h"
 #include "vec/data_types/data_type.h"
+#include "vec/data_types/data_type_bitmap.h"
+#include "vec/data_types/data_type_nullable.h"
 #include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
 
 namespace doris::vectorized {
 // declare function
@@ -53,6 +61,394 @@ TEST(AggTest, basic_test) {
     ASSERT_EQ(ans, *(int32_t*)place);
     agg_function->destroy(place);
 }
+
+// Serializes states with serialize_vec() and merges them with deserialize_and_merge_vec(),
+// the results must be the same as merging the states directly.
+static void check_serialize_and_merge(const std::string& name, const DataTypePtr& data_type,
+                                      const ColumnPtr& column, bool fixed_size_state,
+                                      bool raw_state) {
+    auto agg_function = AggregateFunctionSimpleFactory::instance().get(name, {data_type}, {},
+                                                                       data_type->is_nullable());
+    ASSERT_TRUE(agg_function != nullptr) << name;
+    ASSERT_EQ(fixed_size_state, agg_function->has_fixed_size_state()) << name;
+
+    const size_t num_sources = 100;
+    const size_t num_targets = 7;
+    auto create_places = [&](size_t num) {
+        std::vector<std::unique_ptr<char[]>> buffers;
+        std::vector<AggregateDataPtr> places;
+        for (size_t i = 0; i < num; ++i) {
+            buffers.emplace_back(new char[agg_function->size_of_data()]);
+            places.push_back(buffers.back().get());
+            agg_function->create(places.back());
+        }
+        return std::make_pair(std::move(buffers), places);
+    };
+    auto [source_buffers, sources] = create_places(num_sources);
+    const IColumn* columns[1] = {column.get()};
+    for (size_t i = 0; i < column->size(); ++i) {
+        // the last sources stay empty
+        agg_function->add(sources[i % (num_sources - 10)], columns, i, nullptr);
+    }
+
+    auto serialized = ColumnString::create();
+    serialized->insert_data("", 0);
+    agg_function->serialize_vec(sources.data(), 0, *serialized, num_sources, raw_state);
+    ASSERT_EQ(num_sources + 1, serialized->size());
+    if (raw_state && fixed_size_state) {
+        for (size_t i = 1; i < serialized->size(); ++i) {
+            ASSERT_EQ(agg_function->size_of_data(), serialized->get_data_at(i).size);
+        }
+    } else {
+        // the states older BEs read, as serialize() writes them
+        auto expected_serialized = ColumnString::create();
+        VectorBufferWriter writer(*expected_serialized);
+        for (size_t i = 0; i < num_sources; ++i) {
+            agg_function->serialize(sources[i], writer);
+            writer.commit();
+        }
+        for (size_t i = 0; i < num_sources; ++i) {
+            ASSERT_EQ(expected_serialized->get_data_at(i), serialized->get_data_at(i + 1))
+                    << name << " " << i;
+        }
+    }
+    serialized = ColumnString::create();
+    agg_function->serialize_vec(sources.data(), 0, *serialized, num_sources, raw_state);
+
+    auto [target_buffers, targets] = create_places(num_targets);
+    auto [expected_buffers, expected] = create_places(num_targets);
+    std::vector<AggregateDataPtr> target_places;
+    for (size_t i = 0; i < num_sources; ++i) {
+        target_places.push_back(targets[i % num_targets]);
+        agg_function->merge(expected[i % num_targets], sources[i], nullptr);
+    }
+    Arena arena;
+    ASSERT_TRUE(agg_function
+                        ->deserialize_and_merge_vec(target_places.data(), 0, *serialized, &arena,
+                                                    num_sources, raw_state)
+                        .ok());
+
+    auto check_results = [&](const std::vector<AggregateDataPtr>& results,
+                             const std::vector<AggregateDataPtr>& expected_results) {
+        auto result = agg_function->get_return_type()->create_column();
+        auto expected_result = agg_function->get_return_type()->create_column();
+        for (size_t i = 0; i < num_targets; ++i) {
+            agg_function->insert_result_into(results[i], *result);
+            agg_function->insert_result_into(expected_results[i], *expected_result);
+        }
+        for (size_t i = 0; i < num_targets; ++i) {
+            ASSERT_EQ((*expected_result)[i], (*result)[i]) << name << " " << i;
+        }
+    };
+    check_results(targets, expected);
+
+    // merging the one-row states of streaming_agg_serialize() is the same as adding the rows
+    auto streamed = ColumnString::create();
+    agg_function->streaming_agg_serialize(columns, *streamed, column->size(), &arena, raw_state);
+    ASSERT_EQ(column->size(), streamed->size());
+    auto [streamed_target_buffers, streamed_targets] = create_places(num_targets);
+    auto [added_buffers, added] = create_places(num_targets);
+    target_places.clear();
+    for (size_t i = 0; i < column->size(); ++i) {
+        target_places.push_back(streamed_targets[i % num_targets]);
+        agg_function->add(added[i % num_targets], columns, i, nullptr);
+    }
+    ASSERT_TRUE(agg_function
+                        ->deserialize_and_merge_vec(target_places.data(), 0, *streamed, &arena,
+                                                    column->size(), raw_state)
+                        .ok());
+    check_results(streamed_targets, added);
+
+    if (raw_state && fixed_size_state) {
+        // a raw state of another size is rejected instead of being merged
+        auto truncated = ColumnString::create();
+        truncated->insert_data(serialized->get_data_at(0).data, agg_function->size_of_data() - 1);
+        ASSERT_FALSE(agg_function
+                             ->deserialize_and_merge_vec(target_places.data(), 0, *truncated,
+                                                         &arena, 1, raw_state)
+                             .ok());
+    }
+
+    for (auto* places : {&sources, &targets, &expected, &streamed_targets, &added}) {
+        for (auto place : *places) {
+            agg_function->destroy(place);
+        }
+    }
+}
+
+TEST(AggTest, serialize_and_merge_vec) {
+    auto int_column = ColumnInt32::create();
+    auto bigint_column = ColumnInt64::create();
+    auto string_column = ColumnString::create();
+    auto null_map = ColumnUInt8::create();
+    for (int i = 0; i < 1000; i++) {
+        int_column->insert_value(i * 7 % 1001 - 500);
+        bigint_column->insert_value(Int64(i) * 1000000007);
+        std::string value(i % 100, 'a' + i % 26);
+        string_column->insert_data(value.data(), value.size());
+        null_map->insert_value(i % 3 == 0);
+    }
+    auto nullable_bigint_column = ColumnNullable::create(bigint_column->clone(), null_map->clone());
+    auto nullable_string_column = ColumnNullable::create(string_column->clone(), null_map->clone());
+
+    auto int_type = std::make_shared<DataTypeInt32>();
+    auto bigint_type = std::make_shared<DataTypeInt64>();
+    auto string_type = std::make_shared<DataTypeString>();
+    for (bool raw_state : {false, true}) {
+        check_serialize_and_merge("sum", bigint_type, bigint_column->clone(), true, raw_state);
+        check_serialize_and_merge("avg", int_type, int_column->clone(), true, raw_state);
+        check_serialize_and_merge("count", int_type, int_column->clone(), true, raw_state);
+        check_serialize_and_merge("min", int_type, int_column->clone(), true, raw_state);
+        check_serialize_and_merge("max", int_type, int_column->clone(), true, raw_state);
+        check_serialize_and_merge("max", string_type, string_column->clone(), false, raw_state);
+        check_serialize_and_merge("sum", make_nullable(bigint_type),
+                                  nullable_bigint_column->clone(), true, raw_state);
+        check_serialize_and_merge("min", make_nullable(string_type),
+                                  nullable_string_column->clone(), false, raw_state);
+    }
+}
+
+// Aggregates all rows into one state, with add_batch_single_place() or row by row.
+static Field aggregate_single_place(const std::string& name, const DataTypes& data_types,
+                                    const std::vector<const IColumn*>& columns, bool batch) {
+    auto agg_function = AggregateFunctionSimpleFactory::instance().get(name, data_types, {});
+    EXPECT_TRUE(agg_function != nullptr) << name;
+    std::unique_ptr<char[]> place(new char[agg_function->size_of_data()]);
+    agg_function->create(place.get());
+    size_t rows = columns[0]->size();
+    if (batch) {
+        agg_function->add_batch_single_place(rows, place.get(), columns.data(), nullptr);
+    } else {
+        for (size_t i = 0; i < rows; ++i) {
+            agg_function->add(place.get(), columns.data(), i, nullptr);
+        }
+    }
+    auto result = agg_function->get_return_type()->create_column();
+    agg_function->insert_result_into(place.get(), *result);
+    agg_function->destroy(place.get());
+    return (*result)[0];
+}
+
+TEST(AggTest, approx_aggregates) {
+    auto bigint_type = std::make_shared<DataTypeInt64>();
+    auto string_type = std::make_shared<DataTypeString>();
+    for (int distinct : {1, 100, 160, 1000, 50000}) {
+        auto bigint_column = ColumnInt64::create();
+        auto string_column = ColumnString::create();
+        for (int i = 0; i < 100000; i++) {
+            bigint_column->insert_value(i % distinct);
+            std::string value = std::to_string(i % distinct);
+            string_column->insert_data(value.data(), value.size());
+        }
+        for (const auto& [type, column] : std::vector<std::pair<DataTypePtr, const IColumn*>> {
+                     {bigint_type, bigint_column.get()}, {string_type, string_column.get()}}) {
+            auto result = aggregate_single_place("approx_count_distinct", {type}, {column}, true);
+            ASSERT_EQ(result, aggregate_single_place("ndv", {type}, {column}, false));
+            if (distinct <= 160) {
+                // the hash values are counted exactly
+                ASSERT_EQ(distinct, result.get<Int64>());
+            } else {
+                ASSERT_NEAR(distinct, result.get<Int64>(), distinct * 0.02);
+            }
+        }
+    }
+    auto bigint_column = ColumnInt64::create();
+    for (int i = 0; i < 1000; i++) {
+        bigint_column->insert_value(Int64(i % 300) * 1000000007);
+    }
+    check_serialize_and_merge("approx_count_distinct", bigint_type, std::move(bigint_column),
+                              false);
+
+    // percentile_approx of 0, 1, ..., 99999
+    auto double_type = std::make_shared<DataTypeFloat64>();
+    auto values = ColumnFloat64::create();
+    auto quantiles = ColumnFloat64::create();
+    auto compressions = ColumnFloat64::create();
+    for (int i = 0; i < 100000; i++) {
+        values->insert_value((i * 7919) % 100000);
+        quantiles->insert_value(0.9);
+        compressions->insert_value(2048);
+    }
+    for (bool batch : {true, false}) {
+        auto result = aggregate_single_place("percentile_approx", {double_type, double_type},
+                                             {values.get(), quantiles.get()}, batch);
+        ASSERT_NEAR(90000, result.get<Float64>(), 100);
+        result = aggregate_single_place("percentile_approx",
+                                        {double_type, double_type, double_type},
+                                        {values.get(), quantiles.get(), compressions.get()}, batch);
+        ASSERT_NEAR(90000, result.get<Float64>(), 100);
+    }
+
+    // topn of a skewed column: i appears 20 - i times
+    auto int_type = std::make_shared<DataTypeInt32>();
+    auto items = ColumnInt32::create();
+    auto string_items = ColumnString::create();
+    auto top_nums = ColumnInt32::create();
+    for (int i = 0; i < 20; i++) {
+        for (int j = i; j < 20; j++) {
+            items->insert_value(i);
+            std::string item = "item" + std::to_string(i);
+            string_items->insert_data(item.data(), item.size());
+            top_nums->insert_value(3);
+        }
+    }
+    for (bool batch : {true, false}) {
+        ASSERT_EQ("{\"0\":20,\"1\":19,\"2\":18}",
+                  aggregate_single_place("topn", {int_type, int_type},
+                                         {items.get(), top_nums.get()}, batch)
+                          .get<String>());
+        ASSERT_EQ("{\"item0\":20,\"item1\":19,\"item2\":18}",
+                  aggregate_single_place("topn", {string_type, int_type},
+                                         {string_items.get(), top_nums.get()}, batch)
+                          .get<String>());
+    }
+}
+
+// merge() must not change the merged state, e.g. by pruning its counters to the capacity.
+TEST(AggTest, topn_merge_keeps_rhs) {
+    auto int_type = std::make_shared<DataTypeInt32>();
+    auto agg_function =
+            AggregateFunctionSimpleFactory::instance().get("topn", {int_type, int_type}, {});
+    ASSERT_TRUE(agg_function != nullptr);
+    // i appears i + 1 times, there are more distinct items than the capacity of topn(x, 3)
+    auto items = ColumnInt32::create();
+    auto top_nums = ColumnInt32::create();
+    for (int i = 0; i < 250; i++) {
+        for (int j = 0; j <= i; j++) {
+            items->insert_value(i);
+            top_nums->insert_value(3);
+        }
+    }
+    // the item with the smallest count becomes the most frequent one
+    auto more_items = ColumnInt32::create();
+    auto more_top_nums = ColumnInt32::create();
+    for (int i = 0; i < 1000; i++) {
+        more_items->insert_value(0);
+        more_top_nums->insert_value(3);
+    }
+    const IColumn* columns[] = {items.get(), top_nums.get()};
+    const IColumn* more_columns[] = {more_items.get(), more_top_nums.get()};
+
+    std::vector<std::unique_ptr<char[]>> places;
+    for (int i = 0; i < 3; ++i) {
+        places.emplace_back(new char[agg_function->size_of_data()]);
+        agg_function->create(places.back().get());
+    }
+    char* rhs = places[0].get();
+    char* merged = places[1].get();
+    char* expected = places[2].get();
+    auto serialize = [&](char* place) {
+        auto column = ColumnString::create();
+        AggregateDataPtr places_to_serialize[] = {place};
+        agg_function->serialize_vec(places_to_serialize, 0, *column, 1, false);
+        return column->get_data_at(0).to_string();
+    };
+
+    agg_function->add_batch_single_place(items->size(), rhs, columns, nullptr);
+    agg_function->add_batch_single_place(items->size(), expected, columns, nullptr);
+    std::string serialized = serialize(rhs);
+    agg_function->merge(merged, rhs, nullptr);
+    ASSERT_EQ(serialized, serialize(rhs));
+    ASSERT_EQ(serialized, serialize(merged));
+
+    agg_function->add_batch_single_place(more_items->size(), rhs, more_columns, nullptr);
+    agg_function->add_batch_single_place(more_items->size(), expected, more_columns, nullptr);
+    ASSERT_EQ(serialize(expected), serialize(rhs));
+    for (auto& place : places) {
+        agg_function->destroy(place.get());
+    }
+}
+
+// bitmap_union, bitmap_union_count and bitmap_union_int union the rows of a batch at once,
+// or add them one by one if the states have a few rows each, the results must be the same as
+// adding the rows one by one.
+TEST(AggTest, bitmap_union_batch) {
+    auto bitmap_column = ColumnBitmap::create();
+    auto bigint_column = ColumnInt64::create();
+    auto null_map = ColumnUInt8::create();
+    for (int i = 0; i < 1000; i++) {
+        if (i % 4 == 0) {
+            bitmap_column->insert_default();
+        } else if (i % 4 == 1) {
+            bitmap_column->insert_value(BitmapValue(i));
+        } else if (i % 4 == 2) {
+            bitmap_column->insert_value(BitmapValue(uint64_t(i) << 33));
+        } else {
+            BitmapValue bitmap;
+            for (int j = 0; j < 100; j++) {
+                bitmap.add(i * 10 + j);
+            }
+            bitmap_column->insert_value(bitmap);
+        }
+        bigint_column->insert_value(Int64(i % 300) * 1000000007);
+        null_map->insert_value(i % 3 == 0);
+    }
+    auto nullable_bigint_column = ColumnNullable::create(bigint_column->clone(), null_map->clone());
+
+    auto check = [](const std::string& name, const DataTypePtr& data_type, const IColumn* column,
+                    size_t num_places) {
+        auto agg_function = AggregateFunctionSimpleFactory::instance().get(
+                name, {data_type}, {}, data_type->is_nullable());
+        ASSERT_TRUE(agg_function != nullptr) << name;
+        // the last place aggregates all rows
+        std::vector<std::unique_ptr<char[]>> buffers;
+        std::vector<AggregateDataPtr> batch_places;
+        std::vector<AggregateDataPtr> row_places;
+        for (size_t i = 0; i < num_places; ++i) {
+            for (auto* places : {&batch_places, &row_places}) {
+                buffers.emplace_back(new char[agg_function->size_of_data()]);
+                places->push_back(buffers.back().get());
+                agg_function->create(places->back());
+            }
+        }
+
+        const IColumn* columns[1] = {column};
+        std::vector<AggregateDataPtr> places_of_rows;
+        for (size_t i = 0; i < column->size(); ++i) {
+            // the rows of a place are scattered in the batch
+            size_t place = i * 2654435761 % (num_places - 1);
+            places_of_rows.push_back(batch_places[place]);
+            agg_function->add(row_places[place], columns, i, nullptr);
+            agg_function->add(row_places.back(), columns, i, nullptr);
+        }
+        agg_function->add_batch(column->size(), places_of_rows.data(), 0, columns, nullptr);
+        agg_function->add_batch_single_place(column->size(), batch_places.back(), columns,
+                                             nullptr);
+
+        auto to_strings = [&](const std::vector<AggregateDataPtr>& places) {
+            auto result = agg_function->get_return_type()->create_column();
+            std::vector<std::string> values;
+            for (size_t i = 0; i < num_places; ++i) {
+                agg_function->insert_result_into(places[i], *result);
+                if (const auto* bitmaps = check_and_get_column<ColumnBitmap>(*result)) {
+                    values.push_back(bitmaps->get_element(i).to_string());
+                } else {
+                    values.push_back(std::to_string(result->get_int(i)));
+                }
+            }
+            return values;
+        };
+        auto values = to_strings(batch_places);
+        ASSERT_EQ(to_strings(row_places), values) << name << ", " << num_places << " places";
+
+        for (auto* places : {&batch_places, &row_places}) {
+            for (auto place : *places) {
+                agg_function->destroy(place);
+            }
+        }
+    };
+    auto bitmap_type = std::make_shared<DataTypeBitMap>();
+    auto bigint_type = std::make_shared<DataTypeInt64>();
+    // a few states of many rows, and the high cardinality case of about a state per row
+    for (size_t num_places : {8, 1001}) {
+        check("bitmap_union", bitmap_type, bitmap_column.get(), num_places);
+        check("bitmap_union_count", bitmap_type, bitmap_column.get(), num_places);
+        check("bitmap_intersect", bitmap_type, bitmap_column.get(), num_places);
+        check("bitmap_union_int", bigint_type, bigint_column.get(), num_places);
+        check("bitmap_union_int", make_nullable(bigint_type), nullable_bigint_column.get(),
+              num_places);
+    }
+}
 } // namespace doris::vectorized
 
 int main(int argc, char** argv) {
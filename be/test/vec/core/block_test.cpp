@@ -30,10 +30,12 @@
 #include "vec/columns/column_decimal.h"
 #include "vec/columns/column_nullable.h"
 #include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
 #include "vec/columns/column_vector.h"
 #include "vec/common/exception.h"
 #include "vec/data_types/data_type.h"
 #include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
 #include "vec/runtime/vdatetime_value.h"
 namespace doris {
 
@@ -301,6 +303,27 @@ TEST(BlockTest, dump_data) {
             {test_int, test_string, test_decimal, test_nullable_int32, test_date, test_datetime});
     EXPECT_GT(block.dump_data().size(), 1);
 }
+
+TEST(BlockTest, clear_shared_column_data) {
+    auto column = vectorized::ColumnInt32::create();
+    for (int i = 0; i < 100; ++i) {
+        column->insert_value(i);
+    }
+    vectorized::ColumnPtr column_ptr = std::move(column);
+    vectorized::DataTypePtr int_type(std::make_shared<vectorized::DataTypeInt32>());
+    vectorized::Block block({{column_ptr, int_type, "k1"}});
+    vectorized::Block shared_block({{column_ptr, int_type, "k1"}});
+
+    // the columns shared with another block are left untouched
+    block.clear_column_data();
+    EXPECT_EQ(0, block.rows());
+    EXPECT_EQ(1, block.columns());
+    EXPECT_EQ(100, shared_block.rows());
+    EXPECT_EQ(99, shared_block.get_by_position(0).column->get_int(99));
+
+    shared_block.clear_column_data();
+    EXPECT_EQ(0, shared_block.rows());
+}
 } // namespace doris
 
 int main(int argc, char** argv) {
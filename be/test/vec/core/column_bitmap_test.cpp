@@ -0,0 +1,110 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#include "vec/columns/column_bitmap.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "vec/common/assert_cast.h"
+
+namespace doris::vectorized {
+
+static ColumnBitmap::MutablePtr create_column() {
+    auto column = ColumnBitmap::create();
+    column->insert_value(BitmapValue());
+    column->insert_value(BitmapValue(7));
+    column->insert_value(BitmapValue(std::vector<uint64_t> {1, 2, 3}));
+    column->insert_value(BitmapValue(std::vector<uint64_t> {5, 1ULL << 40}));
+    column->insert_default();
+    return column;
+}
+
+TEST(ColumnBitmapTest, InsertAndGet) {
+    auto column = create_column();
+    ASSERT_EQ(5, column->size());
+    ASSERT_EQ("", column->get_element(0).to_string());
+    ASSERT_EQ("7", column->get_element(1).to_string());
+    ASSERT_EQ("1,2,3", column->get_element(2).to_string());
+    ASSERT_EQ("5,1099511627776", column->get_element(3).to_string());
+    ASSERT_EQ("", column->get_element(4).to_string());
+
+    std::vector<uint64_t> cardinalities {0, 1, 3, 2, 0};
+    for (size_t i = 0; i < column->size(); ++i) {
+        ASSERT_EQ(cardinalities[i], column->cardinality(i));
+    }
+
+    // the serialized bytes can be inserted as is
+    auto copy = ColumnBitmap::create();
+    for (size_t i = 0; i < column->size(); ++i) {
+        StringRef ref = column->get_data_at(i);
+        copy->insert_data(ref.data, ref.size);
+    }
+    ASSERT_EQ(column->get_chars(), copy->get_chars());
+    ASSERT_EQ(column->get_offsets(), copy->get_offsets());
+}
+
+TEST(ColumnBitmapTest, UnionInto) {
+    auto column = create_column();
+    BitmapValue value(2);
+    for (size_t i = 0; i < column->size(); ++i) {
+        column->union_into(i, &value);
+    }
+    ASSERT_EQ("1,2,3,5,7,1099511627776", value.to_string());
+}
+
+TEST(ColumnBitmapTest, FilterPermuteReplicate) {
+    auto column = create_column();
+
+    IColumn::Filter filter {0, 1, 1, 0, 1};
+    auto filtered = column->filter(filter, 0);
+    const auto& filtered_column = assert_cast<const ColumnBitmap&>(*filtered);
+    ASSERT_EQ(3, filtered_column.size());
+    ASSERT_EQ("7", filtered_column.get_element(0).to_string());
+    ASSERT_EQ("1,2,3", filtered_column.get_element(1).to_string());
+    ASSERT_EQ("", filtered_column.get_element(2).to_string());
+
+    IColumn::Permutation perm {3, 2, 1, 0, 4};
+    auto permuted = column->permute(perm, 2);
+    const auto& permuted_column = assert_cast<const ColumnBitmap&>(*permuted);
+    ASSERT_EQ(2, permuted_column.size());
+    ASSERT_EQ("5,1099511627776", permuted_column.get_element(0).to_string());
+    ASSERT_EQ("1,2,3", permuted_column.get_element(1).to_string());
+
+    IColumn::Offsets offsets {0, 2, 2, 3, 3};
+    auto replicated = column->replicate(offsets);
+    const auto& replicated_column = assert_cast<const ColumnBitmap&>(*replicated);
+    ASSERT_EQ(3, replicated_column.size());
+    ASSERT_EQ("7", replicated_column.get_element(0).to_string());
+    ASSERT_EQ("7", replicated_column.get_element(1).to_string());
+    ASSERT_EQ("5,1099511627776", replicated_column.get_element(2).to_string());
+
+    auto range = ColumnBitmap::create();
+    range->insert_range_from(*column, 1, 3);
+    ASSERT_EQ(3, range->size());
+    ASSERT_EQ("7", range->get_element(0).to_string());
+    ASSERT_EQ("5,1099511627776", range->get_element(2).to_string());
+}
+
+} // namespace doris::vectorized
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
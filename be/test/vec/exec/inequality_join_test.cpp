@@ -0,0 +1,161 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/join/inequality_join.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+
+namespace doris::vectorized {
+
+using Op = InequalityJoin::Op;
+using Values = std::vector<std::optional<int32_t>>;
+
+static ColumnPtr create_column(const Values& values) {
+    auto column = ColumnNullable::create(ColumnInt32::create(), ColumnUInt8::create());
+    for (const auto& value : values) {
+        if (value.has_value()) {
+            column->insert(Field(Int64(*value)));
+        } else {
+            column->insert_default();
+        }
+    }
+    return column;
+}
+
+static bool satisfied(Op op, const std::optional<int32_t>& lhs, const std::optional<int32_t>& rhs) {
+    if (!lhs.has_value() || !rhs.has_value()) {
+        return false;
+    }
+    switch (op) {
+    case Op::LESS:
+        return *lhs < *rhs;
+    case Op::LESS_EQUAL:
+        return *lhs <= *rhs;
+    case Op::GREATER:
+        return *lhs > *rhs;
+    case Op::GREATER_EQUAL:
+        return *lhs >= *rhs;
+    }
+    return false;
+}
+
+// Joins the probe blocks with the build rows, reading the pairs 'max_pairs' at a time, and
+// compares the pairs with the ones of the nested loop join.
+static void check_join(const std::vector<Op>& ops, const std::vector<Values>& build_keys,
+                       const std::vector<std::vector<Values>>& probe_blocks, size_t max_pairs) {
+    InequalityJoin join(ops);
+    Columns build_columns;
+    for (const auto& values : build_keys) {
+        build_columns.push_back(create_column(values));
+    }
+    join.build(std::move(build_columns));
+
+    for (const auto& probe_keys : probe_blocks) {
+        Columns probe_columns;
+        for (const auto& values : probe_keys) {
+            probe_columns.push_back(create_column(values));
+        }
+        join.probe(std::move(probe_columns));
+
+        std::vector<uint32_t> probe_rows;
+        std::vector<uint32_t> build_rows;
+        while (!join.probe_finished()) {
+            size_t num_pairs = probe_rows.size();
+            EXPECT_LE(join.next_pairs(max_pairs, &probe_rows, &build_rows), max_pairs);
+            EXPECT_LE(probe_rows.size() - num_pairs, max_pairs);
+        }
+        ASSERT_EQ(probe_rows.size(), build_rows.size());
+        // the pairs of a probe row are adjacent
+        for (size_t i = 1; i < probe_rows.size(); ++i) {
+            EXPECT_TRUE(probe_rows[i] == probe_rows[i - 1] ||
+                        std::find(probe_rows.begin(), probe_rows.begin() + i, probe_rows[i]) ==
+                                probe_rows.begin() + i);
+        }
+
+        std::vector<std::pair<uint32_t, uint32_t>> pairs;
+        for (size_t i = 0; i < probe_rows.size(); ++i) {
+            pairs.emplace_back(probe_rows[i], build_rows[i]);
+        }
+        std::vector<std::pair<uint32_t, uint32_t>> expected;
+        for (uint32_t i = 0; i < probe_keys[0].size(); ++i) {
+            for (uint32_t j = 0; j < build_keys[0].size(); ++j) {
+                bool matched = true;
+                for (size_t k = 0; k < ops.size(); ++k) {
+                    matched &= satisfied(ops[k], probe_keys[k][i], build_keys[k][j]);
+                }
+                if (matched) {
+                    expected.emplace_back(i, j);
+                }
+            }
+        }
+        std::sort(pairs.begin(), pairs.end());
+        EXPECT_EQ(expected, pairs);
+    }
+}
+
+TEST(InequalityJoinTest, one_condition) {
+    Values build = {5, 1, std::nullopt, 3, 3, 8, 1, 10};
+    Values probe = {0, 1, 3, 4, std::nullopt, 10, 11, 3};
+    for (auto op : {Op::LESS, Op::LESS_EQUAL, Op::GREATER, Op::GREATER_EQUAL}) {
+        for (size_t max_pairs : {1, 3, 100}) {
+            check_join({op}, {build}, {{probe}, {Values()}, {Values {2, 2}}}, max_pairs);
+        }
+    }
+}
+
+TEST(InequalityJoinTest, two_conditions) {
+    // intervals [start, end] of the build rows, some of them empty or with null bounds
+    Values starts;
+    Values ends;
+    for (int i = 0; i < 200; ++i) {
+        int start = (i * 37) % 101;
+        starts.push_back(i % 17 == 0 ? std::nullopt : std::optional<int32_t>(start));
+        ends.push_back(i % 23 == 0 ? std::nullopt
+                                   : std::optional<int32_t>(start + (i * 13) % 11 - 2));
+    }
+    Values points;
+    for (int i = 0; i < 150; ++i) {
+        points.push_back(i % 19 == 0 ? std::nullopt : std::optional<int32_t>((i * 7) % 110 - 3));
+    }
+
+    std::vector<Op> ops = {Op::LESS, Op::LESS_EQUAL, Op::GREATER, Op::GREATER_EQUAL};
+    for (auto first_op : ops) {
+        for (auto second_op : ops) {
+            for (size_t max_pairs : {1, 7, 4096}) {
+                // "point op start AND point op end", the band join is "point >= start AND
+                // point <= end"
+                check_join({first_op, second_op}, {starts, ends},
+                           {{points, points}, {Values(), Values()}}, max_pairs);
+            }
+        }
+    }
+}
+
+} // namespace doris::vectorized
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,354 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/vanalytic_eval_node.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/object_pool.h"
+#include "gen_cpp/Exprs_types.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+#include "runtime/memory/chunk_allocator.h"
+#include "runtime/runtime_state.h"
+#include "vec/core/block.h"
+#include "vec/utils/util.hpp"
+
+namespace doris::vectorized {
+
+using Value = std::optional<int64_t>;
+using Row = std::vector<Value>;
+using Rows = std::vector<Row>;
+
+// the input tuple has p (slot 0), v (slot 1) and the nullable n (slot 2), the output tuple has
+// sum(v), count(n), sum(n) and max(n)
+constexpr TupleId INPUT_TUPLE_ID = 0;
+constexpr TupleId OUTPUT_TUPLE_ID = 1;
+
+// Returns a block per element of `blocks`, some of them may be empty.
+class MockBlockNode : public ExecNode {
+public:
+    MockBlockNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs,
+                  std::vector<Rows> blocks)
+            : ExecNode(pool, tnode, descs), _blocks(std::move(blocks)) {}
+
+    Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) override {
+        return Status::NotSupported("Not Implemented MockBlockNode::get_next scalar");
+    }
+
+    Status get_next(RuntimeState* state, Block* block, bool* eos) override {
+        block->clear();
+        if (_next < _blocks.size()) {
+            MutableBlock mutable_block(
+                    VectorizedUtils::create_empty_columnswithtypename(row_desc()));
+            auto& columns = mutable_block.mutable_columns();
+            for (const auto& row : _blocks[_next]) {
+                for (size_t i = 0; i < row.size(); ++i) {
+                    if (row[i].has_value()) {
+                        columns[i]->insert(Field(Int64(*row[i])));
+                    } else {
+                        columns[i]->insert_default();
+                    }
+                }
+            }
+            block->swap(mutable_block.to_block());
+            ++_next;
+        }
+        *eos = _next == _blocks.size();
+        return Status::OK();
+    }
+
+private:
+    std::vector<Rows> _blocks;
+    size_t _next = 0;
+};
+
+template <typename Node>
+class NodeWithChild : public Node {
+public:
+    using Node::Node;
+
+    void add_child(ExecNode* child) { this->_children.push_back(child); }
+};
+
+static TTypeDesc create_type(TPrimitiveType::type type) {
+    TTypeNode node;
+    node.type = TTypeNodeType::SCALAR;
+    node.__isset.scalar_type = true;
+    node.scalar_type.type = type;
+    TTypeDesc type_desc;
+    type_desc.types.push_back(node);
+    return type_desc;
+}
+
+static TExprNode create_slot_ref(SlotId slot_id, bool nullable) {
+    TExprNode node;
+    node.node_type = TExprNodeType::SLOT_REF;
+    node.type = create_type(TPrimitiveType::BIGINT);
+    node.num_children = 0;
+    node.__isset.slot_ref = true;
+    node.slot_ref.slot_id = slot_id;
+    node.slot_ref.tuple_id = INPUT_TUPLE_ID;
+    node.__set_is_nullable(nullable);
+    return node;
+}
+
+// <name>(<slot>) of a BIGINT slot returning BIGINT
+static TExpr create_analytic_function(const std::string& name, SlotId slot_id,
+                                      bool arg_nullable, bool result_nullable) {
+    TExprNode agg;
+    agg.node_type = TExprNodeType::AGG_EXPR;
+    agg.type = create_type(TPrimitiveType::BIGINT);
+    agg.num_children = 1;
+    TFunction fn;
+    fn.name.function_name = name;
+    fn.binary_type = TFunctionBinaryType::BUILTIN;
+    fn.arg_types = {create_type(TPrimitiveType::BIGINT)};
+    fn.ret_type = create_type(TPrimitiveType::BIGINT);
+    fn.has_var_args = false;
+    fn.__isset.aggregate_fn = true;
+    fn.aggregate_fn.intermediate_type = create_type(TPrimitiveType::BIGINT);
+    agg.__set_fn(fn);
+    agg.__isset.agg_expr = true;
+    agg.agg_expr.is_merge_agg = false;
+    agg.__set_is_nullable(result_nullable);
+
+    TExpr expr;
+    expr.nodes = {agg, create_slot_ref(slot_id, arg_nullable)};
+    return expr;
+}
+
+static TPlanNode create_plan_node(TPlanNodeType::type type, int num_children,
+                                  const std::vector<TTupleId>& row_tuples) {
+    TPlanNode tnode;
+    tnode.node_id = 0;
+    tnode.node_type = type;
+    tnode.num_children = num_children;
+    tnode.limit = -1;
+    tnode.row_tuples = row_tuples;
+    tnode.nullable_tuples = std::vector<bool>(row_tuples.size(), false);
+    tnode.compact_data = false;
+    return tnode;
+}
+
+// A bound of a ROWS window, an offset < 0 is PRECEDING, > 0 is FOLLOWING and 0 is CURRENT ROW.
+static TAnalyticWindowBoundary create_boundary(int64_t offset) {
+    TAnalyticWindowBoundary boundary;
+    if (offset == 0) {
+        boundary.type = TAnalyticWindowBoundaryType::CURRENT_ROW;
+    } else {
+        boundary.type = offset < 0 ? TAnalyticWindowBoundaryType::PRECEDING
+                                   : TAnalyticWindowBoundaryType::FOLLOWING;
+        boundary.__set_rows_offset_value(std::abs(offset));
+    }
+    return boundary;
+}
+
+// The frame ROWS BETWEEN <start> AND <end>, nullopt start is UNBOUNDED PRECEDING.
+struct Frame {
+    std::optional<int64_t> start;
+    int64_t end;
+
+    std::string to_string() const {
+        return fmt::format("ROWS BETWEEN {} AND {}",
+                           start.has_value() ? std::to_string(*start) : "UNBOUNDED", end);
+    }
+};
+
+// The rows of "SELECT p, v, n, sum(v), count(n), sum(n), max(n) OVER (PARTITION BY p <frame>)".
+// The sliding frames are computed by retracting rows (sum(v) and count(n)) and by segment trees
+// (sum(n) and max(n), the nullable results), or if `sliding` is false, the frame of every row is
+// added again from scratch.
+static Rows analytic(const std::vector<Rows>& blocks, const Frame& frame, bool sliding) {
+    SCOPED_TRACE(fmt::format("{}, sliding={}", frame.to_string(), sliding));
+    ObjectPool pool;
+    TDescriptorTableBuilder table_builder;
+    auto slot = [](bool nullable, const char* name) {
+        return TSlotDescriptorBuilder()
+                .type(TYPE_BIGINT)
+                .nullable(nullable)
+                .column_name(name)
+                .build();
+    };
+    TTupleDescriptorBuilder()
+            .add_slot(slot(false, "p"))
+            .add_slot(slot(false, "v"))
+            .add_slot(slot(true, "n"))
+            .build(&table_builder);
+    TTupleDescriptorBuilder()
+            .add_slot(slot(false, "sum_v"))
+            .add_slot(slot(false, "count_n"))
+            .add_slot(slot(true, "sum_n"))
+            .add_slot(slot(true, "max_n"))
+            .build(&table_builder);
+    DescriptorTbl* desc_tbl = nullptr;
+    EXPECT_TRUE(DescriptorTbl::create(&pool, table_builder.desc_tbl(), &desc_tbl).ok());
+
+    TQueryOptions query_options;
+    query_options.enable_vectorized_engine = true;
+    RuntimeState state(TUniqueId(), query_options, TQueryGlobals(), nullptr);
+    EXPECT_TRUE(state.init_instance_mem_tracker().ok());
+    state.set_desc_tbl(desc_tbl);
+
+    TPlanNode sort_tnode = create_plan_node(TPlanNodeType::SORT_NODE, 0, {INPUT_TUPLE_ID});
+    auto* sort = pool.add(new MockBlockNode(&pool, sort_tnode, *desc_tbl, blocks));
+    EXPECT_TRUE(sort->init(sort_tnode, &state).ok());
+
+    TPlanNode tnode = create_plan_node(TPlanNodeType::ANALYTIC_EVAL_NODE, 1,
+                                       {INPUT_TUPLE_ID, OUTPUT_TUPLE_ID});
+    tnode.__isset.analytic_node = true;
+    TExpr partition_expr;
+    partition_expr.nodes = {create_slot_ref(0, false)};
+    tnode.analytic_node.partition_exprs = {partition_expr};
+    tnode.analytic_node.analytic_functions = {create_analytic_function("sum", 1, false, false),
+                                              create_analytic_function("count", 2, true, false),
+                                              create_analytic_function("sum", 2, true, true),
+                                              create_analytic_function("max", 2, true, true)};
+    TAnalyticWindow window;
+    window.type = TAnalyticWindowType::ROWS;
+    if (frame.start.has_value()) {
+        window.__set_window_start(create_boundary(*frame.start));
+    }
+    window.__set_window_end(create_boundary(frame.end));
+    tnode.analytic_node.__set_window(window);
+    tnode.analytic_node.intermediate_tuple_id = OUTPUT_TUPLE_ID;
+    tnode.analytic_node.output_tuple_id = OUTPUT_TUPLE_ID;
+    NodeWithChild<VAnalyticEvalNode> node(&pool, tnode, *desc_tbl);
+    node.add_child(sort);
+    EXPECT_TRUE(node.init(tnode, &state).ok());
+    EXPECT_TRUE(node.prepare(&state).ok());
+    using Strategies = std::vector<VAnalyticEvalNode::FrameStrategy>;
+    EXPECT_EQ(Strategies({VAnalyticEvalNode::RETRACT, VAnalyticEvalNode::RETRACT,
+                          VAnalyticEvalNode::SEGMENT_TREE, VAnalyticEvalNode::SEGMENT_TREE}),
+              node._frame_strategies);
+    if (!sliding) {
+        node._frame_strategies.clear();
+    }
+    EXPECT_TRUE(node.open(&state).ok());
+
+    Rows result;
+    bool eos = false;
+    while (!eos) {
+        Block block;
+        EXPECT_TRUE(node.get_next(&state, &block, &eos).ok());
+        for (size_t i = 0; i < block.rows(); ++i) {
+            Row row;
+            for (size_t j = 0; j < block.columns(); ++j) {
+                Field field = (*block.get_by_position(j).column)[i];
+                row.push_back(field.is_null() ? std::nullopt : Value(field.get<Int64>()));
+            }
+            result.push_back(std::move(row));
+        }
+    }
+    EXPECT_TRUE(node.close(&state).ok());
+    return result;
+}
+
+// The same rows computed row by row.
+static Rows expected_analytic(const std::vector<Rows>& blocks, const Frame& frame) {
+    Rows input;
+    for (const auto& rows : blocks) {
+        input.insert(input.end(), rows.begin(), rows.end());
+    }
+    const int64_t num_rows = input.size();
+    Rows result;
+    for (int64_t partition_start = 0; partition_start < num_rows;) {
+        int64_t partition_end = partition_start;
+        while (partition_end < num_rows && input[partition_end][0] == input[partition_start][0]) {
+            ++partition_end;
+        }
+        for (int64_t i = partition_start; i < partition_end; ++i) {
+            int64_t start = frame.start.has_value() ? std::max(i + *frame.start, partition_start)
+                                                    : partition_start;
+            int64_t end = std::min(i + frame.end + 1, partition_end);
+            int64_t sum_v = 0;
+            int64_t count_n = 0;
+            Value sum_n;
+            Value max_n;
+            for (int64_t j = start; j < end; ++j) {
+                sum_v += *input[j][1];
+                if (const auto& n = input[j][2]; n.has_value()) {
+                    ++count_n;
+                    sum_n = sum_n.value_or(0) + *n;
+                    max_n = std::max(max_n.value_or(*n), *n);
+                }
+            }
+            Row row = input[i];
+            row.insert(row.end(), {sum_v, count_n, sum_n, max_n});
+            result.push_back(std::move(row));
+        }
+        partition_start = partition_end;
+    }
+    return result;
+}
+
+// Partitions of 1, 2, 10 and 30 rows sorted by p, cut into blocks of various sizes so that
+// partitions and frames span blocks. Every third n is NULL, the last partition has a run of
+// NULLs longer than the frames.
+static std::vector<Rows> create_blocks() {
+    const std::vector<std::pair<int64_t, int64_t>> partitions = {{1, 1}, {2, 2}, {3, 10}, {4, 30}};
+    Rows input;
+    int64_t row = 0;
+    for (auto [p, rows] : partitions) {
+        for (int64_t i = 0; i < rows; ++i, ++row) {
+            int64_t v = row * 7 % 11 - 5;
+            bool null = row % 3 == 0 || (p == 4 && i >= 10 && i < 17);
+            input.push_back({p, v, null ? Value() : Value(row * 13 % 17 - 8)});
+        }
+    }
+    std::vector<Rows> blocks;
+    const std::vector<size_t> block_sizes = {5, 0, 9, 1, 3};
+    for (size_t offset = 0, i = 0; offset < input.size(); ++i) {
+        size_t size = std::min(block_sizes[i % block_sizes.size()], input.size() - offset);
+        blocks.emplace_back(input.begin() + offset, input.begin() + offset + size);
+        offset += size;
+    }
+    return blocks;
+}
+
+TEST(VAnalyticEvalNodeTest, sliding_rows_frames) {
+    auto blocks = create_blocks();
+    const std::vector<Frame> frames = {
+            {-2, 1},           // n PRECEDING AND m FOLLOWING
+            {-3, -1},          // the frames of the first rows are empty
+            {1, 3},            // the frames of the last rows are empty
+            {0, 4},            // CURRENT ROW AND m FOLLOWING
+            {-5, 5},           // wider than the small partitions
+            {std::nullopt, 2}, // UNBOUNDED PRECEDING AND m FOLLOWING
+    };
+    for (const auto& frame : frames) {
+        auto expected = expected_analytic(blocks, frame);
+        EXPECT_EQ(expected, analytic(blocks, frame, false)) << frame.to_string();
+        EXPECT_EQ(expected, analytic(blocks, frame, true)) << frame.to_string();
+    }
+}
+
+} // namespace doris::vectorized
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    doris::ChunkAllocator::init_instance(4096);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,359 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/join/vmerge_join_node.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "common/object_pool.h"
+#include "gen_cpp/Exprs_types.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+#include "runtime/memory/chunk_allocator.h"
+#include "runtime/runtime_state.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/core/block.h"
+#include "vec/utils/util.hpp"
+
+namespace doris::vectorized {
+
+using Value = std::optional<int32_t>;
+// a row of an input: the join key and a value
+using Row = std::pair<Value, Value>;
+using Rows = std::vector<Row>;
+using OutputRow = std::vector<Value>;
+
+// the slots of the left input are 0 (key) and 1 (value), the ones of the right input 2 and 3
+constexpr TupleId LEFT_TUPLE_ID = 0;
+constexpr TupleId RIGHT_TUPLE_ID = 1;
+
+// Returns a block per element of `blocks`, some of them may be empty.
+class MockBlockNode : public ExecNode {
+public:
+    MockBlockNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs,
+                  std::vector<Rows> blocks)
+            : ExecNode(pool, tnode, descs), _blocks(std::move(blocks)) {}
+
+    Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) override {
+        return Status::NotSupported("Not Implemented MockBlockNode::get_next scalar");
+    }
+
+    Status get_next(RuntimeState* state, Block* block, bool* eos) override {
+        block->clear();
+        if (_next < _blocks.size()) {
+            MutableBlock mutable_block(
+                    VectorizedUtils::create_empty_columnswithtypename(row_desc()));
+            auto& columns = mutable_block.mutable_columns();
+            for (const auto& [key, value] : _blocks[_next]) {
+                insert_value(*columns[0], key);
+                insert_value(*columns[1], value);
+            }
+            block->swap(mutable_block.to_block());
+            ++_next;
+        }
+        *eos = _next == _blocks.size();
+        return Status::OK();
+    }
+
+private:
+    static void insert_value(IColumn& column, const Value& value) {
+        if (value.has_value()) {
+            column.insert(Field(Int64(*value)));
+        } else {
+            column.insert_default();
+        }
+    }
+
+    std::vector<Rows> _blocks;
+    size_t _next = 0;
+};
+
+class TestMergeJoinNode : public VMergeJoinNode {
+public:
+    using VMergeJoinNode::VMergeJoinNode;
+
+    void add_child(ExecNode* child) { _children.push_back(child); }
+};
+
+static TTypeDesc create_type(TPrimitiveType::type type) {
+    TTypeNode node;
+    node.type = TTypeNodeType::SCALAR;
+    node.__isset.scalar_type = true;
+    node.scalar_type.type = type;
+    TTypeDesc type_desc;
+    type_desc.types.push_back(node);
+    return type_desc;
+}
+
+static TExprNode create_slot_ref(SlotId slot_id, TupleId tuple_id) {
+    TExprNode node;
+    node.node_type = TExprNodeType::SLOT_REF;
+    node.type = create_type(TPrimitiveType::INT);
+    node.num_children = 0;
+    node.__isset.slot_ref = true;
+    node.slot_ref.slot_id = slot_id;
+    node.slot_ref.tuple_id = tuple_id;
+    node.__set_is_nullable(true);
+    return node;
+}
+
+// left.value < right.value
+static TExpr create_other_join_conjunct() {
+    TExprNode pred;
+    pred.node_type = TExprNodeType::BINARY_PRED;
+    pred.type = create_type(TPrimitiveType::BOOLEAN);
+    pred.num_children = 2;
+    pred.__set_opcode(TExprOpcode::LT);
+    TFunction fn;
+    fn.name.function_name = "lt";
+    fn.binary_type = TFunctionBinaryType::BUILTIN;
+    fn.arg_types = {create_type(TPrimitiveType::INT), create_type(TPrimitiveType::INT)};
+    fn.ret_type = create_type(TPrimitiveType::BOOLEAN);
+    fn.has_var_args = false;
+    pred.__set_fn(fn);
+    pred.__set_is_nullable(true);
+
+    TExpr expr;
+    expr.nodes = {pred, create_slot_ref(1, LEFT_TUPLE_ID), create_slot_ref(3, RIGHT_TUPLE_ID)};
+    return expr;
+}
+
+static TPlanNode create_plan_node(TPlanNodeType::type type, int num_children,
+                                  const std::vector<TTupleId>& row_tuples,
+                                  const std::vector<bool>& nullable_tuples) {
+    TPlanNode tnode;
+    tnode.node_id = 0;
+    tnode.node_type = type;
+    tnode.num_children = num_children;
+    tnode.limit = -1;
+    tnode.row_tuples = row_tuples;
+    tnode.nullable_tuples = nullable_tuples;
+    tnode.compact_data = false;
+    return tnode;
+}
+
+static bool join_matched(const Row& left, const Row& right, bool null_safe, bool other_conjunct) {
+    bool key_matched = left.first.has_value() && right.first.has_value()
+                               ? *left.first == *right.first
+                               : null_safe && !left.first.has_value() && !right.first.has_value();
+    if (!key_matched || !other_conjunct) {
+        return key_matched;
+    }
+    return left.second.has_value() && right.second.has_value() && *left.second < *right.second;
+}
+
+// The result of the join computed by a nested loop.
+static std::vector<OutputRow> nested_loop_join(TJoinOp::type join_op, bool null_safe,
+                                               bool other_conjunct, const Rows& left,
+                                               const Rows& right) {
+    std::vector<OutputRow> result;
+    for (const auto& left_row : left) {
+        bool matched = false;
+        for (const auto& right_row : right) {
+            if (!join_matched(left_row, right_row, null_safe, other_conjunct)) {
+                continue;
+            }
+            matched = true;
+            if (join_op == TJoinOp::INNER_JOIN || join_op == TJoinOp::LEFT_OUTER_JOIN) {
+                result.push_back(
+                        {left_row.first, left_row.second, right_row.first, right_row.second});
+            }
+        }
+        if (join_op == TJoinOp::LEFT_OUTER_JOIN && !matched) {
+            result.push_back({left_row.first, left_row.second, std::nullopt, std::nullopt});
+        } else if ((join_op == TJoinOp::LEFT_SEMI_JOIN && matched) ||
+                   (join_op == TJoinOp::LEFT_ANTI_JOIN && !matched)) {
+            result.push_back({left_row.first, left_row.second});
+        }
+    }
+    return result;
+}
+
+// Joins the blocks with VMergeJoinNode and compares the rows with the ones of the nested
+// loop join.
+static void check_join(TJoinOp::type join_op, bool null_safe, bool other_conjunct,
+                       const std::vector<Rows>& left_blocks, const std::vector<Rows>& right_blocks,
+                       int batch_size) {
+    SCOPED_TRACE(fmt::format("join_op={} null_safe={} other_conjunct={} batch_size={}",
+                             static_cast<int>(join_op), null_safe, other_conjunct, batch_size));
+    ObjectPool pool;
+    TDescriptorTableBuilder table_builder;
+    for (const char* side : {"left", "right"}) {
+        TTupleDescriptorBuilder tuple_builder;
+        for (const char* column : {"k", "v"}) {
+            tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                           .type(TYPE_INT)
+                                           .nullable(true)
+                                           .column_name(fmt::format("{}_{}", side, column))
+                                           .build());
+        }
+        tuple_builder.build(&table_builder);
+    }
+    DescriptorTbl* desc_tbl = nullptr;
+    ASSERT_TRUE(DescriptorTbl::create(&pool, table_builder.desc_tbl(), &desc_tbl).ok());
+
+    TQueryOptions query_options;
+    query_options.batch_size = batch_size;
+    query_options.enable_vectorized_engine = true;
+    RuntimeState state(TUniqueId(), query_options, TQueryGlobals(), nullptr);
+    ASSERT_TRUE(state.init_instance_mem_tracker().ok());
+    state.set_desc_tbl(desc_tbl);
+
+    TPlanNode left_tnode =
+            create_plan_node(TPlanNodeType::EXCHANGE_NODE, 0, {LEFT_TUPLE_ID}, {false});
+    TPlanNode right_tnode =
+            create_plan_node(TPlanNodeType::EXCHANGE_NODE, 0, {RIGHT_TUPLE_ID}, {false});
+    auto* left = pool.add(new MockBlockNode(&pool, left_tnode, *desc_tbl, left_blocks));
+    auto* right = pool.add(new MockBlockNode(&pool, right_tnode, *desc_tbl, right_blocks));
+    ASSERT_TRUE(left->init(left_tnode, &state).ok());
+    ASSERT_TRUE(right->init(right_tnode, &state).ok());
+
+    bool left_only = join_op == TJoinOp::LEFT_SEMI_JOIN || join_op == TJoinOp::LEFT_ANTI_JOIN;
+    TPlanNode tnode = create_plan_node(
+            TPlanNodeType::MERGE_JOIN_NODE, 2,
+            left_only ? std::vector<TTupleId> {LEFT_TUPLE_ID}
+                      : std::vector<TTupleId> {LEFT_TUPLE_ID, RIGHT_TUPLE_ID},
+            left_only ? std::vector<bool> {false}
+                      : std::vector<bool> {false, join_op == TJoinOp::LEFT_OUTER_JOIN});
+    TEqJoinCondition cmp_conjunct;
+    cmp_conjunct.left.nodes = {create_slot_ref(0, LEFT_TUPLE_ID)};
+    cmp_conjunct.right.nodes = {create_slot_ref(2, RIGHT_TUPLE_ID)};
+    cmp_conjunct.__set_opcode(null_safe ? TExprOpcode::EQ_FOR_NULL : TExprOpcode::EQ);
+    tnode.__isset.merge_join_node = true;
+    tnode.merge_join_node.cmp_conjuncts = {cmp_conjunct};
+    tnode.merge_join_node.__set_join_op(join_op);
+    if (other_conjunct) {
+        tnode.merge_join_node.__set_vother_join_conjunct(create_other_join_conjunct());
+    }
+
+    TestMergeJoinNode node(&pool, tnode, *desc_tbl);
+    node.add_child(left);
+    node.add_child(right);
+    ASSERT_TRUE(node.init(tnode, &state).ok());
+    ASSERT_TRUE(node.prepare(&state).ok());
+    ASSERT_TRUE(node.open(&state).ok());
+
+    std::vector<OutputRow> result;
+    bool eos = false;
+    while (!eos) {
+        Block block;
+        ASSERT_TRUE(node.get_next(&state, &block, &eos).ok());
+        for (size_t i = 0; i < block.rows(); ++i) {
+            OutputRow row;
+            for (size_t j = 0; j < block.columns(); ++j) {
+                Field field = (*block.get_by_position(j).column)[i];
+                row.push_back(field.is_null() ? std::nullopt : Value(field.get<Int64>()));
+            }
+            result.push_back(std::move(row));
+        }
+    }
+    ASSERT_TRUE(node.close(&state).ok());
+
+    Rows left_rows;
+    for (const auto& rows : left_blocks) {
+        left_rows.insert(left_rows.end(), rows.begin(), rows.end());
+    }
+    Rows right_rows;
+    for (const auto& rows : right_blocks) {
+        right_rows.insert(right_rows.end(), rows.begin(), rows.end());
+    }
+    auto expected = nested_loop_join(join_op, null_safe, other_conjunct, left_rows, right_rows);
+    std::sort(result.begin(), result.end());
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(expected, result);
+}
+
+static const std::vector<TJoinOp::type> JOIN_OPS = {
+        TJoinOp::INNER_JOIN, TJoinOp::LEFT_OUTER_JOIN, TJoinOp::LEFT_SEMI_JOIN,
+        TJoinOp::LEFT_ANTI_JOIN};
+
+TEST(VMergeJoinNodeTest, join_ops) {
+    // sorted on the keys with nulls first, the group of the right key 5 spans four blocks and
+    // some keys are only on one side
+    std::vector<Rows> left_blocks = {
+            {{std::nullopt, 1}, {std::nullopt, 9}, {1, 3}},
+            {},
+            {{2, 0}, {2, 5}, {4, 4}, {5, 2}},
+            {{5, std::nullopt}, {5, 6}, {7, 1}, {9, 8}}};
+    std::vector<Rows> right_blocks = {
+            {{std::nullopt, 2}, {2, 1}},
+            {{2, 6}, {3, 3}, {5, 1}},
+            {},
+            {{5, 3}, {5, std::nullopt}},
+            {{5, 7}},
+            {{5, 2}, {5, 9}, {8, 0}},
+            {{9, 1}}};
+    for (auto join_op : JOIN_OPS) {
+        for (bool null_safe : {false, true}) {
+            for (bool other_conjunct : {false, true}) {
+                for (int batch_size : {1, 3, 4096}) {
+                    check_join(join_op, null_safe, other_conjunct, left_blocks, right_blocks,
+                               batch_size);
+                }
+            }
+        }
+    }
+}
+
+TEST(VMergeJoinNodeTest, empty_inputs) {
+    std::vector<Rows> rows = {{{std::nullopt, 1}, {1, 1}, {2, 2}}};
+    for (auto join_op : JOIN_OPS) {
+        for (bool other_conjunct : {false, true}) {
+            check_join(join_op, false, other_conjunct, rows, {}, 3);
+            check_join(join_op, false, other_conjunct, {}, rows, 3);
+            check_join(join_op, false, other_conjunct, {{}}, {{}, rows[0], {}}, 3);
+        }
+    }
+}
+
+TEST(VMergeJoinNodeTest, group_larger_than_batch_size) {
+    // a right group of 50 rows spanning blocks, which is larger than the batch size
+    std::vector<Rows> right_blocks;
+    for (int i = 0; i < 5; ++i) {
+        Rows rows;
+        for (int j = 0; j < 10; ++j) {
+            rows.emplace_back(1, i * 10 + j);
+        }
+        right_blocks.push_back(std::move(rows));
+    }
+    right_blocks.push_back({{2, 0}, {3, 7}});
+    std::vector<Rows> left_blocks = {{{0, 0}, {1, 5}, {1, 45}}, {{1, 60}, {1, std::nullopt}},
+                                     {{3, 1}, {3, 9}}};
+    for (auto join_op : JOIN_OPS) {
+        for (bool other_conjunct : {false, true}) {
+            for (int batch_size : {1, 8, 4096}) {
+                check_join(join_op, false, other_conjunct, left_blocks, right_blocks,
+                           batch_size);
+            }
+        }
+    }
+}
+
+} // namespace doris::vectorized
+
+int main(int argc, char** argv) {
+    doris::ChunkAllocator::init_instance(4096);
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
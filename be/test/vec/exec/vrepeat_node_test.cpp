@@ -0,0 +1,354 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/vrepeat_node.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <map>
+#include <optional>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "common/object_pool.h"
+#include "gen_cpp/Exprs_types.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+#include "runtime/memory/chunk_allocator.h"
+#include "runtime/runtime_state.h"
+#include "vec/core/block.h"
+#include "vec/exec/vaggregation_node.h"
+#include "vec/utils/util.hpp"
+
+namespace doris::vectorized {
+
+using Value = std::optional<int64_t>;
+using Row = std::vector<Value>;
+using Rows = std::vector<Row>;
+
+// the scan tuple has k1 (slot 0), k2 (slot 1) and v (slot 2), the output tuple of the repeat
+// node has grouping_id (slot 3), and the aggregation outputs k1, k2, grouping_id, sum(v)
+constexpr TupleId SCAN_TUPLE_ID = 0;
+constexpr TupleId REPEAT_TUPLE_ID = 1;
+constexpr TupleId AGG_TUPLE_ID = 2;
+
+// Returns a block per element of `blocks`, some of them may be empty.
+class MockBlockNode : public ExecNode {
+public:
+    MockBlockNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs,
+                  std::vector<Rows> blocks)
+            : ExecNode(pool, tnode, descs), _blocks(std::move(blocks)) {}
+
+    Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) override {
+        return Status::NotSupported("Not Implemented MockBlockNode::get_next scalar");
+    }
+
+    Status get_next(RuntimeState* state, Block* block, bool* eos) override {
+        block->clear();
+        if (_next < _blocks.size()) {
+            MutableBlock mutable_block(
+                    VectorizedUtils::create_empty_columnswithtypename(row_desc()));
+            auto& columns = mutable_block.mutable_columns();
+            for (const auto& row : _blocks[_next]) {
+                for (size_t i = 0; i < row.size(); ++i) {
+                    if (row[i].has_value()) {
+                        columns[i]->insert(Field(Int64(*row[i])));
+                    } else {
+                        columns[i]->insert_default();
+                    }
+                }
+            }
+            block->swap(mutable_block.to_block());
+            ++_next;
+        }
+        *eos = _next == _blocks.size();
+        return Status::OK();
+    }
+
+private:
+    std::vector<Rows> _blocks;
+    size_t _next = 0;
+};
+
+template <typename Node>
+class NodeWithChild : public Node {
+public:
+    using Node::Node;
+
+    void add_child(ExecNode* child) { this->_children.push_back(child); }
+};
+
+static TTypeDesc create_type(TPrimitiveType::type type) {
+    TTypeNode node;
+    node.type = TTypeNodeType::SCALAR;
+    node.__isset.scalar_type = true;
+    node.scalar_type.type = type;
+    TTypeDesc type_desc;
+    type_desc.types.push_back(node);
+    return type_desc;
+}
+
+static TExprNode create_slot_ref(SlotId slot_id, TupleId tuple_id, TPrimitiveType::type type,
+                                 bool nullable) {
+    TExprNode node;
+    node.node_type = TExprNodeType::SLOT_REF;
+    node.type = create_type(type);
+    node.num_children = 0;
+    node.__isset.slot_ref = true;
+    node.slot_ref.slot_id = slot_id;
+    node.slot_ref.tuple_id = tuple_id;
+    node.__set_is_nullable(nullable);
+    return node;
+}
+
+// sum(v)
+static TExpr create_sum() {
+    TExprNode sum;
+    sum.node_type = TExprNodeType::AGG_EXPR;
+    sum.type = create_type(TPrimitiveType::BIGINT);
+    sum.num_children = 1;
+    TFunction fn;
+    fn.name.function_name = "sum";
+    fn.binary_type = TFunctionBinaryType::BUILTIN;
+    fn.arg_types = {create_type(TPrimitiveType::BIGINT)};
+    fn.ret_type = create_type(TPrimitiveType::BIGINT);
+    fn.has_var_args = false;
+    fn.__isset.aggregate_fn = true;
+    fn.aggregate_fn.intermediate_type = create_type(TPrimitiveType::BIGINT);
+    sum.__set_fn(fn);
+    sum.__isset.agg_expr = true;
+    sum.agg_expr.is_merge_agg = false;
+    sum.__set_is_nullable(true);
+
+    TExpr expr;
+    expr.nodes = {sum, create_slot_ref(2, SCAN_TUPLE_ID, TPrimitiveType::BIGINT, true)};
+    return expr;
+}
+
+static TPlanNode create_plan_node(TPlanNodeType::type type, int num_children,
+                                  const std::vector<TTupleId>& row_tuples, int64_t limit = -1) {
+    TPlanNode tnode;
+    tnode.node_id = 0;
+    tnode.node_type = type;
+    tnode.num_children = num_children;
+    tnode.limit = limit;
+    tnode.row_tuples = row_tuples;
+    tnode.nullable_tuples = std::vector<bool>(row_tuples.size(), false);
+    tnode.compact_data = false;
+    return tnode;
+}
+
+// The grouping sets ((k1, k2), (k1), ()).
+static const std::vector<std::set<SlotId>> GROUPING_SETS = {{0, 1}, {0}, {}};
+static const std::vector<int64_t> GROUPING_IDS = {0, 1, 3};
+
+// The sum of a serialized state of sum(v), nullopt if v is all null.
+static Value deserialize_sum(const Field& field) {
+    const auto& state = field.get<String>();
+    // the null flag and the nested state of the nullable sum
+    if (state.size() == sizeof(bool)) {
+        return std::nullopt;
+    }
+    EXPECT_EQ(sizeof(bool) + sizeof(Int64), state.size());
+    Int64 sum = 0;
+    memcpy(&sum, state.data() + sizeof(bool), sizeof(Int64));
+    return sum;
+}
+
+// The result of "SELECT k1, k2, grouping_id(k1, k2), sum(v) ... GROUP BY GROUPING SETS", with
+// the aggregation on top of the repeat node. The repeat node isn't fused into the aggregation
+// if it has a limit. A streaming preaggregation returns the serialized states, maybe several
+// of a group, which are merged here.
+static Rows aggregate_grouping_sets(const std::vector<Rows>& blocks, bool fused,
+                                    bool streaming = false) {
+    SCOPED_TRACE(fmt::format("fused={}, streaming={}", fused, streaming));
+    ObjectPool pool;
+    TDescriptorTableBuilder table_builder;
+    auto slot = [](PrimitiveType type, bool nullable, const char* name) {
+        return TSlotDescriptorBuilder().type(type).nullable(nullable).column_name(name).build();
+    };
+    TTupleDescriptorBuilder()
+            .add_slot(slot(TYPE_INT, true, "k1"))
+            .add_slot(slot(TYPE_INT, true, "k2"))
+            .add_slot(slot(TYPE_BIGINT, true, "v"))
+            .build(&table_builder);
+    TTupleDescriptorBuilder()
+            .add_slot(slot(TYPE_BIGINT, false, "grouping_id"))
+            .build(&table_builder);
+    TTupleDescriptorBuilder()
+            .add_slot(slot(TYPE_INT, true, "k1"))
+            .add_slot(slot(TYPE_INT, true, "k2"))
+            .add_slot(slot(TYPE_BIGINT, false, "grouping_id"))
+            .add_slot(slot(TYPE_BIGINT, true, "sum"))
+            .build(&table_builder);
+    DescriptorTbl* desc_tbl = nullptr;
+    EXPECT_TRUE(DescriptorTbl::create(&pool, table_builder.desc_tbl(), &desc_tbl).ok());
+
+    TQueryOptions query_options;
+    query_options.enable_vectorized_engine = true;
+    RuntimeState state(TUniqueId(), query_options, TQueryGlobals(), nullptr);
+    EXPECT_TRUE(state.init_instance_mem_tracker().ok());
+    state.set_desc_tbl(desc_tbl);
+
+    TPlanNode scan_tnode = create_plan_node(TPlanNodeType::EXCHANGE_NODE, 0, {SCAN_TUPLE_ID});
+    auto* scan = pool.add(new MockBlockNode(&pool, scan_tnode, *desc_tbl, blocks));
+    EXPECT_TRUE(scan->init(scan_tnode, &state).ok());
+
+    TPlanNode repeat_tnode = create_plan_node(TPlanNodeType::REPEAT_NODE, 1,
+                                              {SCAN_TUPLE_ID, REPEAT_TUPLE_ID},
+                                              fused ? -1 : 1000000);
+    repeat_tnode.__isset.repeat_node = true;
+    repeat_tnode.repeat_node.output_tuple_id = REPEAT_TUPLE_ID;
+    repeat_tnode.repeat_node.slot_id_set_list = GROUPING_SETS;
+    repeat_tnode.repeat_node.repeat_id_list = GROUPING_IDS;
+    repeat_tnode.repeat_node.grouping_list = {GROUPING_IDS};
+    repeat_tnode.repeat_node.all_slot_ids = {0, 1};
+    auto* repeat = pool.add(new NodeWithChild<VRepeatNode>(&pool, repeat_tnode, *desc_tbl));
+    repeat->add_child(scan);
+    EXPECT_TRUE(repeat->init(repeat_tnode, &state).ok());
+    EXPECT_EQ(fused, repeat->can_be_fused());
+
+    TPlanNode agg_tnode = create_plan_node(TPlanNodeType::AGGREGATION_NODE, 1, {AGG_TUPLE_ID});
+    agg_tnode.__isset.agg_node = true;
+    std::vector<TExpr> grouping_exprs(3);
+    grouping_exprs[0].nodes = {create_slot_ref(0, SCAN_TUPLE_ID, TPrimitiveType::INT, true)};
+    grouping_exprs[1].nodes = {create_slot_ref(1, SCAN_TUPLE_ID, TPrimitiveType::INT, true)};
+    grouping_exprs[2].nodes = {
+            create_slot_ref(3, REPEAT_TUPLE_ID, TPrimitiveType::BIGINT, false)};
+    agg_tnode.agg_node.__set_grouping_exprs(grouping_exprs);
+    agg_tnode.agg_node.aggregate_functions = {create_sum()};
+    agg_tnode.agg_node.intermediate_tuple_id = AGG_TUPLE_ID;
+    agg_tnode.agg_node.output_tuple_id = AGG_TUPLE_ID;
+    agg_tnode.agg_node.need_finalize = !streaming;
+    agg_tnode.agg_node.__set_use_streaming_preaggregation(streaming);
+    NodeWithChild<AggregationNode> agg(&pool, agg_tnode, *desc_tbl);
+    agg.add_child(repeat);
+    EXPECT_TRUE(agg.init(agg_tnode, &state).ok());
+    EXPECT_TRUE(agg.prepare(&state).ok());
+    EXPECT_TRUE(agg.open(&state).ok());
+
+    std::map<Row, Value> groups;
+    bool eos = false;
+    while (!eos) {
+        Block block;
+        EXPECT_TRUE(agg.get_next(&state, &block, &eos).ok());
+        for (size_t i = 0; i < block.rows(); ++i) {
+            Row key;
+            for (size_t j = 0; j + 1 < block.columns(); ++j) {
+                Field field = (*block.get_by_position(j).column)[i];
+                key.push_back(field.is_null() ? std::nullopt : Value(field.get<Int64>()));
+            }
+            Field field = (*block.get_by_position(block.columns() - 1).column)[i];
+            Value value;
+            if (streaming) {
+                value = deserialize_sum(field);
+            } else if (!field.is_null()) {
+                value = field.get<Int64>();
+            }
+            if (!streaming) {
+                EXPECT_EQ(0, groups.count(key));
+            }
+            auto& sum = groups[key];
+            if (value.has_value()) {
+                sum = sum.value_or(0) + *value;
+            }
+        }
+    }
+
+    // the repeat node returns every input row once per grouping set, fused or not
+    int64_t input_rows = 0;
+    for (const auto& rows : blocks) {
+        input_rows += rows.size();
+    }
+    int64_t repeated_rows = input_rows * GROUPING_SETS.size();
+    EXPECT_EQ(repeated_rows, repeat->rows_returned());
+    EXPECT_EQ(repeated_rows, repeat->runtime_profile()->get_counter("RowsReturned")->value());
+    EXPECT_TRUE(agg.close(&state).ok());
+
+    Rows result;
+    for (const auto& [key, sum] : groups) {
+        Row row = key;
+        row.push_back(sum);
+        result.push_back(std::move(row));
+    }
+    return result;
+}
+
+// The grouping sets aggregated row by row.
+static Rows expected_grouping_sets(const std::vector<Rows>& blocks) {
+    std::map<Row, Value> groups;
+    for (size_t i = 0; i < GROUPING_SETS.size(); ++i) {
+        for (const auto& rows : blocks) {
+            for (const auto& row : rows) {
+                Row key = {GROUPING_SETS[i].count(0) ? row[0] : std::nullopt,
+                           GROUPING_SETS[i].count(1) ? row[1] : std::nullopt, GROUPING_IDS[i]};
+                auto& sum = groups[key];
+                if (row[2].has_value()) {
+                    sum = sum.value_or(0) + *row[2];
+                }
+            }
+        }
+    }
+    Rows result;
+    for (const auto& [key, sum] : groups) {
+        Row row = key;
+        row.push_back(sum);
+        result.push_back(std::move(row));
+    }
+    return result;
+}
+
+TEST(VRepeatNodeTest, fused_into_aggregation) {
+    std::vector<Rows> blocks = {
+            {{1, 1, 10}, {1, 2, 20}, {2, std::nullopt, 5}},
+            {},
+            {{std::nullopt, 1, 7}, {1, 1, std::nullopt}, {2, 3, 1}},
+            {{3, 3, std::nullopt}, {1, 2, 2}}};
+    for (int i = 0; i < 100; ++i) {
+        blocks.push_back({{i % 7, i % 3, i}, {i % 5, std::nullopt, i * 2}});
+    }
+    Rows fused = aggregate_grouping_sets(blocks, true);
+    Rows unfused = aggregate_grouping_sets(blocks, false);
+    EXPECT_EQ(unfused, fused);
+    EXPECT_EQ(expected_grouping_sets(blocks), fused);
+}
+
+TEST(VRepeatNodeTest, fused_into_streaming_preaggregation) {
+    std::vector<Rows> blocks = {{{1, 1, 10}, {1, 2, 20}, {2, std::nullopt, 5}},
+                                {},
+                                {{std::nullopt, 1, 7}, {1, 1, std::nullopt}, {2, 3, 1}}};
+    for (int i = 0; i < 100; ++i) {
+        blocks.push_back({{i % 7, i % 3, i}, {i % 5, std::nullopt, i * 2}});
+    }
+    blocks.push_back({});
+    Rows fused = aggregate_grouping_sets(blocks, true, true);
+    Rows unfused = aggregate_grouping_sets(blocks, false, true);
+    EXPECT_EQ(unfused, fused);
+    EXPECT_EQ(expected_grouping_sets(blocks), fused);
+}
+
+} // namespace doris::vectorized
+
+int main(int argc, char** argv) {
+    doris::ChunkAllocator::init_instance(4096);
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
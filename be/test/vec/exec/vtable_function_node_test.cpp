@@ -0,0 +1,331 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/vtable_function_node.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/object_pool.h"
+#include "gen_cpp/Exprs_types.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+#include "runtime/memory/chunk_allocator.h"
+#include "runtime/runtime_state.h"
+#include "util/bitmap_value.h"
+#include "vec/columns/column_bitmap.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_bitmap.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+
+namespace doris::vectorized {
+
+// the child tuple has k (slot 0), the nullable s (slot 1) and b (slot 2), the lateral tuples of
+// explode_split(s, ',') and explode_bitmap(b) have s_value (slot 3) and b_value (slot 4)
+constexpr TupleId CHILD_TUPLE_ID = 0;
+constexpr TupleId SPLIT_TUPLE_ID = 1;
+constexpr TupleId BITMAP_TUPLE_ID = 2;
+constexpr SlotId K_SLOT = 0;
+constexpr SlotId S_SLOT = 1;
+constexpr SlotId B_SLOT = 2;
+constexpr SlotId SPLIT_SLOT = 3;
+constexpr SlotId BITMAP_SLOT = 4;
+
+// k, s and the elements of b
+struct ChildRow {
+    int64_t k;
+    std::optional<std::string> s;
+    std::vector<uint64_t> b;
+};
+
+// k, s_value and b_value
+using Row = std::tuple<int64_t, std::string, int64_t>;
+
+// Returns the given blocks, some of them may be empty.
+class MockBlockNode : public ExecNode {
+public:
+    MockBlockNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs,
+                  std::vector<Block> blocks)
+            : ExecNode(pool, tnode, descs), _blocks(std::move(blocks)) {}
+
+    Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) override {
+        return Status::NotSupported("Not Implemented MockBlockNode::get_next scalar");
+    }
+
+    Status get_next(RuntimeState* state, Block* block, bool* eos) override {
+        block->clear();
+        if (_next < _blocks.size()) {
+            Block copy = _blocks[_next++];
+            block->swap(copy);
+        }
+        *eos = _next == _blocks.size();
+        return Status::OK();
+    }
+
+private:
+    std::vector<Block> _blocks;
+    size_t _next = 0;
+};
+
+template <typename Node>
+class NodeWithChild : public Node {
+public:
+    using Node::Node;
+
+    void add_child(ExecNode* child) { this->_children.push_back(child); }
+};
+
+static Block create_block(const std::vector<ChildRow>& rows) {
+    auto k = ColumnInt64::create();
+    auto s = ColumnNullable::create(ColumnString::create(), ColumnUInt8::create());
+    auto b = ColumnBitmap::create();
+    for (const auto& row : rows) {
+        k->insert_value(row.k);
+        if (row.s.has_value()) {
+            s->insert_data(row.s->data(), row.s->size());
+        } else {
+            s->insert_data(nullptr, 0);
+        }
+        BitmapValue bitmap;
+        for (uint64_t value : row.b) {
+            bitmap.add(value);
+        }
+        b->insert_value(bitmap);
+    }
+    return Block({{std::move(k), std::make_shared<DataTypeInt64>(), "k"},
+                  {std::move(s), make_nullable(std::make_shared<DataTypeString>()), "s"},
+                  {std::move(b), std::make_shared<DataTypeBitMap>(), "b"}});
+}
+
+static TExprNode create_slot_ref(SlotId slot_id, PrimitiveType type, bool nullable) {
+    TExprNode node;
+    node.node_type = TExprNodeType::SLOT_REF;
+    node.type = TypeDescriptor(type).to_thrift();
+    node.num_children = 0;
+    node.__isset.slot_ref = true;
+    node.slot_ref.slot_id = slot_id;
+    node.slot_ref.tuple_id = CHILD_TUPLE_ID;
+    node.__set_is_nullable(nullable);
+    return node;
+}
+
+static TExprNode create_function_call(const std::string& name, PrimitiveType ret_type,
+                                      const std::vector<PrimitiveType>& arg_types) {
+    TExprNode node;
+    node.node_type = TExprNodeType::FUNCTION_CALL;
+    node.type = TypeDescriptor(ret_type).to_thrift();
+    node.num_children = arg_types.size();
+    TFunction fn;
+    fn.name.function_name = name;
+    fn.binary_type = TFunctionBinaryType::BUILTIN;
+    for (auto arg_type : arg_types) {
+        fn.arg_types.push_back(TypeDescriptor(arg_type).to_thrift());
+    }
+    fn.ret_type = node.type;
+    fn.has_var_args = false;
+    node.__set_fn(fn);
+    node.__set_is_nullable(true);
+    return node;
+}
+
+// explode_split(s, ',')
+static TExpr create_explode_split() {
+    TExprNode delimiter;
+    delimiter.node_type = TExprNodeType::STRING_LITERAL;
+    delimiter.type = TypeDescriptor(TYPE_STRING).to_thrift();
+    delimiter.num_children = 0;
+    delimiter.__isset.string_literal = true;
+    delimiter.string_literal.value = ",";
+    delimiter.__set_is_nullable(false);
+
+    TExpr expr;
+    expr.nodes = {create_function_call("explode_split", TYPE_STRING, {TYPE_STRING, TYPE_STRING}),
+                  create_slot_ref(S_SLOT, TYPE_STRING, true), delimiter};
+    return expr;
+}
+
+// explode_bitmap(b)
+static TExpr create_explode_bitmap() {
+    TExpr expr;
+    expr.nodes = {create_function_call("explode_bitmap", TYPE_BIGINT, {TYPE_OBJECT}),
+                  create_slot_ref(B_SLOT, TYPE_OBJECT, false)};
+    return expr;
+}
+
+static TPlanNode create_plan_node(TPlanNodeType::type type, int num_children,
+                                  const std::vector<TTupleId>& row_tuples) {
+    TPlanNode tnode;
+    tnode.node_id = 0;
+    tnode.node_type = type;
+    tnode.num_children = num_children;
+    tnode.limit = -1;
+    tnode.row_tuples = row_tuples;
+    tnode.nullable_tuples = std::vector<bool>(row_tuples.size(), false);
+    tnode.compact_data = false;
+    return tnode;
+}
+
+// The rows of "SELECT k, s_value, b_value FROM t LATERAL VIEW explode_split(s, ',') LATERAL VIEW
+// explode_bitmap(b)", or with the lateral views swapped if `bitmap_first` is set. Checks that no
+// returned block is empty unless it's the last one, and that none exceeds the batch size.
+static std::vector<Row> lateral_view(const std::vector<std::vector<ChildRow>>& blocks,
+                                     bool bitmap_first, int batch_size) {
+    SCOPED_TRACE(fmt::format("bitmap_first={}, batch_size={}", bitmap_first, batch_size));
+    ObjectPool pool;
+    TDescriptorTableBuilder table_builder;
+    auto slot = [](PrimitiveType type, bool nullable, const char* name) {
+        return TSlotDescriptorBuilder().type(type).nullable(nullable).column_name(name).build();
+    };
+    TTupleDescriptorBuilder()
+            .add_slot(slot(TYPE_BIGINT, false, "k"))
+            .add_slot(slot(TYPE_STRING, true, "s"))
+            .add_slot(slot(TYPE_OBJECT, false, "b"))
+            .build(&table_builder);
+    TTupleDescriptorBuilder().add_slot(slot(TYPE_STRING, true, "s_value")).build(&table_builder);
+    TTupleDescriptorBuilder().add_slot(slot(TYPE_BIGINT, true, "b_value")).build(&table_builder);
+    DescriptorTbl* desc_tbl = nullptr;
+    EXPECT_TRUE(DescriptorTbl::create(&pool, table_builder.desc_tbl(), &desc_tbl).ok());
+
+    TQueryOptions query_options;
+    query_options.batch_size = batch_size;
+    query_options.enable_vectorized_engine = true;
+    RuntimeState state(TUniqueId(), query_options, TQueryGlobals(), nullptr);
+    EXPECT_TRUE(state.init_instance_mem_tracker().ok());
+    state.set_desc_tbl(desc_tbl);
+
+    std::vector<Block> child_blocks;
+    for (const auto& rows : blocks) {
+        child_blocks.push_back(create_block(rows));
+    }
+    TPlanNode scan_tnode = create_plan_node(TPlanNodeType::EXCHANGE_NODE, 0, {CHILD_TUPLE_ID});
+    auto* scan = pool.add(new MockBlockNode(&pool, scan_tnode, *desc_tbl, child_blocks));
+    EXPECT_TRUE(scan->init(scan_tnode, &state).ok());
+
+    std::vector<TTupleId> row_tuples = {CHILD_TUPLE_ID, SPLIT_TUPLE_ID, BITMAP_TUPLE_ID};
+    std::vector<TExpr> fns = {create_explode_split(), create_explode_bitmap()};
+    if (bitmap_first) {
+        std::swap(row_tuples[1], row_tuples[2]);
+        std::swap(fns[0], fns[1]);
+    }
+    TPlanNode tnode = create_plan_node(TPlanNodeType::TABLE_FUNCTION_NODE, 1, row_tuples);
+    tnode.__isset.table_function_node = true;
+    tnode.table_function_node.__set_fnCallExprList(fns);
+    // s and b are not output
+    tnode.table_function_node.__set_outputSlotIds({K_SLOT, SPLIT_SLOT, BITMAP_SLOT});
+    NodeWithChild<VTableFunctionNode> node(&pool, tnode, *desc_tbl);
+    node.add_child(scan);
+    EXPECT_TRUE(node.init(tnode, &state).ok());
+    EXPECT_TRUE(node.prepare(&state).ok());
+    EXPECT_TRUE(node.open(&state).ok());
+
+    // the columns of the child slots, followed by the lateral columns in the order of the
+    // functions
+    const size_t split_pos = bitmap_first ? 4 : 3;
+    const size_t bitmap_pos = bitmap_first ? 3 : 4;
+    std::vector<Row> result;
+    bool eos = false;
+    while (!eos) {
+        Block block;
+        EXPECT_TRUE(node.get_next(&state, &block, &eos).ok());
+        EXPECT_TRUE(block.rows() > 0 || eos);
+        EXPECT_LE(block.rows(), batch_size);
+        for (size_t i = 0; i < block.rows(); ++i) {
+            Field s_value = (*block.get_by_position(split_pos).column)[i];
+            Field b_value = (*block.get_by_position(bitmap_pos).column)[i];
+            EXPECT_FALSE(s_value.is_null());
+            EXPECT_FALSE(b_value.is_null());
+            result.emplace_back((*block.get_by_position(0).column)[i].get<Int64>(),
+                                s_value.get<String>(), b_value.get<Int64>());
+        }
+    }
+    EXPECT_TRUE(node.close(&state).ok());
+    return result;
+}
+
+// The Cartesian product of the values of each row, computed row by row.
+static std::vector<Row> expected_lateral_view(const std::vector<std::vector<ChildRow>>& blocks,
+                                              bool bitmap_first) {
+    std::vector<Row> result;
+    for (const auto& rows : blocks) {
+        for (const auto& row : rows) {
+            std::vector<std::string> parts;
+            if (row.s.has_value()) {
+                size_t begin = 0;
+                for (size_t end; (end = row.s->find(',', begin)) != std::string::npos;
+                     begin = end + 1) {
+                    parts.push_back(row.s->substr(begin, end - begin));
+                }
+                parts.push_back(row.s->substr(begin));
+            }
+            if (bitmap_first) {
+                for (uint64_t value : row.b) {
+                    for (const auto& part : parts) {
+                        result.emplace_back(row.k, part, value);
+                    }
+                }
+            } else {
+                for (const auto& part : parts) {
+                    for (uint64_t value : row.b) {
+                        result.emplace_back(row.k, part, value);
+                    }
+                }
+            }
+        }
+    }
+    return result;
+}
+
+TEST(VTableFunctionNodeTest, two_lateral_views) {
+    std::vector<uint64_t> large_bitmap;
+    for (uint64_t value = 100; value < 130; value += 3) {
+        large_bitmap.push_back(value);
+    }
+    const std::vector<std::vector<ChildRow>> blocks = {
+            {{1, "a,b", {1, 5}}, {2, "c", {7}}, {3, "d,e,f", large_bitmap}},
+            // no row of the block produces values
+            {{4, std::nullopt, {1, 2}}, {5, "g,h", {}}},
+            {},
+            {{6, "", {9}}, {7, std::nullopt, {}}, {8, "i,,j", large_bitmap}},
+            // the last block produces no values
+            {{9, "k", {}}},
+    };
+    for (bool bitmap_first : {false, true}) {
+        auto expected = expected_lateral_view(blocks, bitmap_first);
+        for (int batch_size : {1, 4, 7, 4096}) {
+            EXPECT_EQ(expected, lateral_view(blocks, bitmap_first, batch_size));
+        }
+    }
+}
+
+} // namespace doris::vectorized
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    doris::ChunkAllocator::init_instance(4096);
+    return RUN_ALL_TESTS();
+}
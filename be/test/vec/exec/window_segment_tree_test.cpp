@@ -0,0 +1,153 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/window_segment_tree.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "vec/aggregate_functions/aggregate_function_simple_factory.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+
+namespace doris::vectorized {
+
+// Computes the frames [row + start_offset, row + end_offset + 1) of the rows of a partition with
+// the segment tree, and by retracting and adding rows if the function can retract, the results
+// must be the same as adding every row of the frames.
+static void check_sliding_frames(const std::string& name, const DataTypePtr& data_type,
+                                 const ColumnPtr& column, bool retractable) {
+    auto agg_function = AggregateFunctionSimpleFactory::instance().get(name, {data_type}, {},
+                                                                       data_type->is_nullable());
+    ASSERT_TRUE(agg_function != nullptr) << name;
+    ASSERT_TRUE(agg_function->is_frame_mergeable()) << name;
+    ASSERT_EQ(retractable, agg_function->is_retractable()) << name;
+
+    std::unique_ptr<char[]> expected(new char[agg_function->size_of_data()]);
+    std::unique_ptr<char[]> merged(new char[agg_function->size_of_data()]);
+    std::unique_ptr<char[]> slid(new char[agg_function->size_of_data()]);
+    for (auto* place : {expected.get(), merged.get(), slid.get()}) {
+        agg_function->create(place);
+    }
+
+    const IColumn* columns[1] = {column.get()};
+    const int64_t partition_start = 10;
+    const int64_t partition_end = column->size() - 10;
+    WindowSegmentTree tree(agg_function.get());
+    tree.build(columns, partition_start, partition_end, nullptr);
+
+    std::vector<std::pair<int64_t, int64_t>> frames = {{-3, 3},   {-100, 0}, {0, 50},
+                                                       {-10, -2}, {2, 7},    {-1000, 1000}};
+    for (auto [start_offset, end_offset] : frames) {
+        auto expected_result = agg_function->get_return_type()->create_column();
+        auto merged_result = agg_function->get_return_type()->create_column();
+        auto slid_result = agg_function->get_return_type()->create_column();
+        agg_function->reset(slid.get());
+        int64_t slid_start = partition_start;
+        int64_t slid_end = partition_start;
+        for (int64_t row = partition_start; row < partition_end; ++row) {
+            int64_t frame_start = row + start_offset;
+            int64_t frame_end = row + end_offset + 1;
+            agg_function->reset(expected.get());
+            agg_function->add_range_single_place(partition_start, partition_end, frame_start,
+                                                 frame_end, expected.get(), columns, nullptr);
+            agg_function->insert_result_into(expected.get(), *expected_result);
+
+            agg_function->reset(merged.get());
+            tree.merge_frame(merged.get(), frame_start, frame_end, nullptr);
+            agg_function->insert_result_into(merged.get(), *merged_result);
+
+            if (retractable) {
+                int64_t start = std::max(frame_start, partition_start);
+                int64_t end = std::max(std::min(frame_end, partition_end), start);
+                if (start >= slid_end) {
+                    agg_function->reset(slid.get());
+                    slid_start = slid_end = start;
+                }
+                for (; slid_start < start; ++slid_start) {
+                    agg_function->retract(slid.get(), columns, slid_start, nullptr);
+                }
+                for (; slid_end < end; ++slid_end) {
+                    agg_function->add(slid.get(), columns, slid_end, nullptr);
+                }
+                agg_function->insert_result_into(slid.get(), *slid_result);
+            }
+        }
+        for (size_t i = 0; i < expected_result->size(); ++i) {
+            ASSERT_EQ((*expected_result)[i], (*merged_result)[i])
+                    << name << " " << start_offset << " " << end_offset << " " << i;
+            if (retractable) {
+                ASSERT_EQ((*expected_result)[i], (*slid_result)[i])
+                        << name << " " << start_offset << " " << end_offset << " " << i;
+            }
+        }
+    }
+
+    for (auto* place : {expected.get(), merged.get(), slid.get()}) {
+        agg_function->destroy(place);
+    }
+}
+
+TEST(WindowSegmentTreeTest, sliding_frames) {
+    auto int_column = ColumnInt32::create();
+    auto bigint_column = ColumnInt64::create();
+    auto double_column = ColumnFloat64::create();
+    auto string_column = ColumnString::create();
+    auto null_map = ColumnUInt8::create();
+    for (int i = 0; i < 300; i++) {
+        int_column->insert_value(i * 7 % 101 - 50);
+        bigint_column->insert_value(Int64(i % 13) * 1000000007);
+        double_column->insert_value(i * 0.5);
+        std::string value(i % 10, 'a' + i * 3 % 26);
+        string_column->insert_data(value.data(), value.size());
+        // long runs of nulls, so that some frames have only nulls
+        null_map->insert_value(i % 50 < 20);
+    }
+    auto nullable_bigint_column = ColumnNullable::create(bigint_column->clone(), null_map->clone());
+    auto nullable_int_column = ColumnNullable::create(int_column->clone(), null_map->clone());
+
+    auto int_type = std::make_shared<DataTypeInt32>();
+    auto bigint_type = std::make_shared<DataTypeInt64>();
+    check_sliding_frames("sum", bigint_type, std::move(bigint_column), true);
+    check_sliding_frames("sum", std::make_shared<DataTypeFloat64>(), std::move(double_column),
+                         false);
+    check_sliding_frames("avg", int_type, int_column->clone(), true);
+    check_sliding_frames("count", int_type, int_column->clone(), true);
+    check_sliding_frames("min", int_type, int_column->clone(), false);
+    check_sliding_frames("max", int_type, std::move(int_column), false);
+    check_sliding_frames("max", std::make_shared<DataTypeString>(), std::move(string_column),
+                         false);
+    check_sliding_frames("sum", make_nullable(bigint_type), std::move(nullable_bigint_column),
+                         false);
+    check_sliding_frames("min", make_nullable(int_type), nullable_int_column->clone(), false);
+    check_sliding_frames("count", make_nullable(int_type), std::move(nullable_int_column), true);
+}
+
+} // namespace doris::vectorized
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,144 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "common/object_pool.h"
+#include "util/bitmap_value.h"
+#include "vec/columns/column_bitmap.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/exprs/table_function/table_function.h"
+#include "vec/exprs/table_function/table_function_factory.h"
+
+namespace doris::vectorized {
+
+static ColumnPtr create_string_column(const std::vector<std::string>& values) {
+    auto column = ColumnString::create();
+    for (const auto& value : values) {
+        column->insert_data(value.data(), value.size());
+    }
+    return column;
+}
+
+static TableFunction* get_fn(ObjectPool* pool, const std::string& name) {
+    TableFunction* fn = nullptr;
+    EXPECT_TRUE(TableFunctionFactory::get_fn(name, pool, &fn).ok());
+    return fn;
+}
+
+TEST(TableFunctionTest, explode_split) {
+    ObjectPool pool;
+    TableFunction* fn = get_fn(&pool, "explode_split");
+    ASSERT_TRUE(fn->process_init({create_string_column({"a,bc,,d", "", "a,"}),
+                                  create_string_column({",", ",", ","})})
+                        .ok());
+
+    // the values of a row can be read by several ranges
+    ASSERT_EQ(4, fn->process_row(0));
+    auto column = ColumnNullable::create(ColumnString::create(), ColumnUInt8::create());
+    fn->get_values(0, 3, column.get());
+    fn->get_values(3, 1, column.get());
+    ASSERT_EQ(1, fn->process_row(1));
+    fn->get_values(0, 1, column.get());
+    ASSERT_EQ(2, fn->process_row(2));
+    fn->get_values(0, 2, column.get());
+
+    std::vector<std::string> expected = {"a", "bc", "", "d", "", "a", ""};
+    ASSERT_EQ(expected.size(), column->size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_FALSE(column->is_null_at(i));
+        EXPECT_EQ(expected[i], column->get_data_at(i).to_string());
+    }
+}
+
+TEST(TableFunctionTest, explode_bitmap) {
+    ObjectPool pool;
+    TableFunction* fn = get_fn(&pool, "explode_bitmap");
+    auto bitmaps = ColumnBitmap::create();
+    BitmapValue bitmap;
+    for (uint64_t value = 0; value < 10000; value += 3) {
+        bitmap.add(value);
+    }
+    bitmaps->insert_value(bitmap);
+    bitmaps->insert_value(BitmapValue(uint64_t(7)));
+    bitmaps->insert_value(BitmapValue());
+    auto null_map = ColumnUInt8::create(3, 0);
+    null_map->get_data()[2] = 1;
+    ASSERT_TRUE(fn->process_init({ColumnNullable::create(std::move(bitmaps), std::move(null_map))})
+                        .ok());
+
+    ASSERT_EQ(3334, fn->process_row(0));
+    auto column = ColumnInt64::create();
+    // in order, with a gap, and backwards
+    fn->get_values(0, 2, column.get());
+    fn->get_values(3000, 3, column.get());
+    fn->get_values(1, 1, column.get());
+    std::vector<Int64> expected = {0, 3, 9000, 9003, 9006, 3};
+    ASSERT_EQ(expected, std::vector<Int64>(column->get_data().begin(), column->get_data().end()));
+
+    ASSERT_EQ(1, fn->process_row(1));
+    column->clear();
+    fn->get_values(0, 1, column.get());
+    ASSERT_EQ(7, column->get_element(0));
+    ASSERT_EQ(0, fn->process_row(2));
+}
+
+TEST(TableFunctionTest, explode_json_array) {
+    ObjectPool pool;
+    TableFunction* int_fn = get_fn(&pool, "explode_json_array_int");
+    TableFunction* string_fn = get_fn(&pool, "explode_json_array_string");
+    ColumnPtr json = create_string_column({R"([1, "a", null, 2.5])", R"({"k": 1})", "invalid"});
+    ASSERT_TRUE(int_fn->process_init({json}).ok());
+    ASSERT_TRUE(string_fn->process_init({json}).ok());
+
+    ASSERT_EQ(4, int_fn->process_row(0));
+    auto ints = ColumnNullable::create(ColumnInt64::create(), ColumnUInt8::create());
+    int_fn->get_values(0, 4, ints.get());
+    ASSERT_EQ(4, ints->size());
+    EXPECT_EQ(1, ints->operator[](0).get<Int64>());
+    EXPECT_TRUE(ints->is_null_at(1));
+    EXPECT_TRUE(ints->is_null_at(2));
+    EXPECT_EQ(2, ints->operator[](3).get<Int64>());
+
+    ASSERT_EQ(4, string_fn->process_row(0));
+    auto strings = ColumnNullable::create(ColumnString::create(), ColumnUInt8::create());
+    string_fn->get_values(0, 2, strings.get());
+    EXPECT_EQ("1", strings->get_data_at(0).to_string());
+    EXPECT_EQ("a", strings->get_data_at(1).to_string());
+
+    // not an array
+    ASSERT_EQ(0, int_fn->process_row(1));
+    ASSERT_EQ(0, int_fn->process_row(2));
+}
+
+TEST(TableFunctionTest, not_supported) {
+    ObjectPool pool;
+    TableFunction* fn = nullptr;
+    ASSERT_FALSE(TableFunctionFactory::get_fn("explode", &pool, &fn).ok());
+}
+
+} // namespace doris::vectorized
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -21,6 +21,7 @@
 
 #include <cmath>
 #include <iostream>
+#include <optional>
 
 #include "exec/schema_scanner.h"
 #include "gen_cpp/Data_types.h"
@@ -36,6 +37,10 @@
 #include "runtime/tuple.h"
 #include "runtime/tuple_row.h"
 #include "testutil/desc_tbl_builder.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/exprs/vcompound_pred.h"
 #include "vec/exprs/vliteral.h"
 #include "vec/runtime/vdatetime_value.h"
 #include "vec/utils/util.hpp"
@@ -351,6 +356,194 @@ TEST(TEST_VEXPR, LITERALTEST) {
     }
 }
 
+namespace doris::vectorized {
+// Returns 'value % mod == 0' of the int column 0, or null if 'value % 7 == 0', and counts
+// the rows it's evaluated on.
+class MockPredicate final : public VExpr {
+public:
+    explicit MockPredicate(int mod) : VExpr(TypeDescriptor(TYPE_BOOLEAN), false, true), _mod(mod) {}
+
+    Status execute(VExprContext* context, Block* block, int* result_column_id) override {
+        auto column = block->get_by_position(0).column->convert_to_full_column_if_const();
+        const auto& data = assert_cast<const ColumnInt32&>(*column).get_data();
+        auto result = ColumnUInt8::create();
+        auto null_map = ColumnUInt8::create();
+        for (auto value : data) {
+            result->insert_value(value % _mod == 0);
+            null_map->insert_value(value % 7 == 0);
+        }
+        evaluated_rows += data.size();
+        *result_column_id = block->columns();
+        block->insert({ColumnNullable::create(std::move(result), std::move(null_map)), _data_type,
+                       "mock"});
+        return Status::OK();
+    }
+    void collect_slot_column_ids(std::set<int>* column_ids) const override {
+        column_ids->insert(0);
+    }
+    VExpr* clone(ObjectPool* pool) const override { return pool->add(new MockPredicate(*this)); }
+    const std::string& expr_name() const override { return _name; }
+
+    static std::optional<bool> eval(int value, int mod) {
+        if (value % 7 == 0) {
+            return std::nullopt;
+        }
+        return value % mod == 0;
+    }
+
+    size_t evaluated_rows = 0;
+
+private:
+    int _mod;
+    std::string _name = "mock";
+};
+
+static void test_compound_pred(TExprOpcode::type opcode) {
+    TExprNode node;
+    node.__set_node_type(TExprNodeType::COMPOUND_PRED);
+    node.__set_opcode(opcode);
+    node.__set_type(TypeDescriptor(TYPE_BOOLEAN).to_thrift());
+    node.__set_is_nullable(true);
+    node.__set_num_children(2);
+    VcompoundPred pred(node);
+    MockPredicate left(2);
+    MockPredicate right(3);
+    pred.add_child(&left);
+    pred.add_child(&right);
+
+    const bool is_or = opcode == TExprOpcode::COMPOUND_OR;
+    auto column = ColumnInt32::create();
+    size_t num_undecided = 0;
+    for (int i = 0; i < 1000; ++i) {
+        column->insert_value(i);
+        auto l = MockPredicate::eval(i, 2);
+        num_undecided += !(l.has_value() && *l == is_or);
+    }
+    Block block({{std::move(column), std::make_shared<DataTypeInt32>(), "k1"}});
+
+    VExprContext context(&pred);
+    int result_id = -1;
+    ASSERT_TRUE(pred.execute(&context, &block, &result_id).ok());
+    ASSERT_EQ(1000, left.evaluated_rows);
+    // the right side only runs on the rows not decided by the left side
+    ASSERT_EQ(num_undecided, right.evaluated_rows);
+
+    auto result = block.get_by_position(result_id).column;
+    ASSERT_EQ(1000, result->size());
+    for (int i = 0; i < 1000; ++i) {
+        auto l = MockPredicate::eval(i, 2);
+        auto r = MockPredicate::eval(i, 3);
+        std::optional<bool> expected;
+        if ((l.has_value() && *l == is_or) || (r.has_value() && *r == is_or)) {
+            expected = is_or;
+        } else if (l.has_value() && r.has_value()) {
+            expected = !is_or;
+        }
+        ASSERT_EQ(!expected.has_value(), result->is_null_at(i)) << i;
+        if (expected.has_value()) {
+            ASSERT_EQ(*expected, result->get_bool(i)) << i;
+        }
+    }
+}
+
+// Returns column 0 plus one, and counts the rows it's evaluated on.
+class MockPlusOne final : public VExpr {
+public:
+    explicit MockPlusOne(bool is_deterministic) : VExpr(TypeDescriptor(TYPE_INT), false, false) {
+        init_fingerprint("plus_one", is_deterministic);
+    }
+
+    Status execute(VExprContext* context, Block* block, int* result_column_id) override {
+        if (find_cached_result(context, *block, result_column_id)) {
+            return Status::OK();
+        }
+        const auto& data =
+                assert_cast<const ColumnInt32&>(*block->get_by_position(0).column).get_data();
+        auto result = ColumnInt32::create();
+        for (auto value : data) {
+            result->insert_value(value + 1);
+        }
+        evaluated_rows += data.size();
+        *result_column_id = block->columns();
+        block->insert({std::move(result), _data_type, "plus_one"});
+        cache_result(context, *block, *result_column_id);
+        return Status::OK();
+    }
+    VExpr* clone(ObjectPool* pool) const override { return pool->add(new MockPlusOne(*this)); }
+    const std::string& expr_name() const override { return _name; }
+
+    size_t evaluated_rows = 0;
+
+private:
+    std::string _name = "plus_one";
+};
+
+static Block create_int_block(int rows) {
+    auto column = ColumnInt32::create();
+    for (int i = 0; i < rows; ++i) {
+        column->insert_value(i);
+    }
+    return Block({{std::move(column), std::make_shared<DataTypeInt32>(), "k1"}});
+}
+} // namespace doris::vectorized
+
+TEST(TEST_VEXPR, COMMON_EXPR_CACHE) {
+    using namespace doris::vectorized;
+    MockPlusOne expr1(true);
+    MockPlusOne expr2(true);
+    MockPlusOne random_expr(false);
+    ASSERT_EQ(expr1.fingerprint(), expr2.fingerprint());
+    ASSERT_TRUE(random_expr.fingerprint().empty());
+
+    VExprContext ctx1(&expr1);
+    VExprContext ctx2(&expr2);
+    VExprContext random_ctx(&random_expr);
+    VExprCache cache;
+    VExpr::set_expr_cache({&ctx1, &ctx2, &random_ctx}, &cache);
+
+    Block block = create_int_block(100);
+    int id1 = -1;
+    int id2 = -1;
+    ASSERT_TRUE(ctx1.execute(&block, &id1).ok());
+    ASSERT_TRUE(ctx2.execute(&block, &id2).ok());
+    // the result of expr1 is reused
+    ASSERT_EQ(id1, id2);
+    ASSERT_EQ(2, block.columns());
+    ASSERT_EQ(100, expr1.evaluated_rows);
+    ASSERT_EQ(0, expr2.evaluated_rows);
+    ASSERT_EQ(1, cache.hit_count());
+
+    // not deterministic, always executed
+    int random_id = -1;
+    ASSERT_TRUE(random_ctx.execute(&block, &random_id).ok());
+    ASSERT_NE(id1, random_id);
+    ASSERT_EQ(100, random_expr.evaluated_rows);
+
+    // the cached column is replaced, the entry is stale
+    block.erase(id1);
+    block.insert(id1, {ColumnInt32::create(100, 0), std::make_shared<DataTypeInt32>(), "other"});
+    ASSERT_TRUE(ctx2.execute(&block, &id2).ok());
+    ASSERT_EQ(100, expr2.evaluated_rows);
+    ASSERT_EQ(3, id2);
+    const auto& result = assert_cast<const ColumnInt32&>(*block.get_by_position(id2).column);
+    ASSERT_EQ(6, result.get_element(5));
+
+    // a new block with the same layout doesn't use the entries of the last one
+    cache.clear();
+    ASSERT_EQ(0, cache.size());
+    Block next_block = create_int_block(10);
+    ASSERT_TRUE(ctx2.execute(&next_block, &id2).ok());
+    ASSERT_TRUE(ctx1.execute(&next_block, &id1).ok());
+    ASSERT_EQ(id1, id2);
+    ASSERT_EQ(100, expr1.evaluated_rows);
+    ASSERT_EQ(110, expr2.evaluated_rows);
+}
+
+TEST(TEST_VEXPR, COMPOUND_PRED_SHORT_CIRCUIT) {
+    doris::vectorized::test_compound_pred(doris::TExprOpcode::COMPOUND_AND);
+    doris::vectorized::test_compound_pred(doris::TExprOpcode::COMPOUND_OR);
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,283 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "exprs/create_predicate_function.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/string_value.h"
+#include "vec/columns/column_const.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/exprs/vbloom_predicate.h"
+#include "vec/exprs/vdirect_in_predicate.h"
+#include "vec/exprs/vexpr_context.h"
+
+namespace doris::vectorized {
+
+// Returns a column of the block, like a slot ref.
+class MockColumnRef final : public VExpr {
+public:
+    MockColumnRef(int column_id, PrimitiveType type, bool nullable)
+            : VExpr(TypeDescriptor(type), false, nullable), _column_id(column_id) {}
+
+    Status execute(VExprContext* context, Block* block, int* result_column_id) override {
+        *result_column_id = _column_id;
+        return Status::OK();
+    }
+    VExpr* clone(ObjectPool* pool) const override { return pool->add(new MockColumnRef(*this)); }
+    const std::string& expr_name() const override { return _name; }
+
+private:
+    int _column_id;
+    std::string _name = "column_ref";
+};
+
+static TExprNode create_predicate_node(TExprNodeType::type node_type) {
+    TExprNode node;
+    node.__set_node_type(node_type);
+    node.__set_type(TypeDescriptor(TYPE_BOOLEAN).to_thrift());
+    node.__set_num_children(1);
+    node.__set_is_nullable(false);
+    return node;
+}
+
+// A nullable int column of `rows` rows, row i is i, or null if i % null_every == 0.
+static Block create_nullable_int_block(int rows, int null_every = 5) {
+    auto column = ColumnInt32::create();
+    auto null_map = ColumnUInt8::create();
+    for (int i = 0; i < rows; ++i) {
+        column->insert_value(i);
+        null_map->insert_value(i % null_every == 0);
+    }
+    auto type = make_nullable(std::make_shared<DataTypeInt32>());
+    return Block({{ColumnNullable::create(std::move(column), std::move(null_map)), type, "k1"}});
+}
+
+static const IColumn& result_column(const Block& block, int result_column_id, size_t rows) {
+    const auto& result = *block.get_by_position(result_column_id).column;
+    EXPECT_EQ(rows, result.size());
+    EXPECT_FALSE(result.is_nullable());
+    return result;
+}
+
+TEST(VRuntimeFilterPredicateTest, bloom_predicate_int) {
+    auto tracker = MemTracker::CreateTracker();
+    std::shared_ptr<IBloomFilterFuncBase> filter(create_bloom_filter(tracker.get(), TYPE_INT));
+    ASSERT_TRUE(filter->init(1024, 0.05).ok());
+    for (int i = 0; i < 1000; i += 2) {
+        filter->insert(&i);
+    }
+
+    for (bool nullable : {false, true}) {
+        SCOPED_TRACE(nullable);
+        VBloomPredicate pred(create_predicate_node(TExprNodeType::BLOOM_PRED), filter);
+        MockColumnRef column_ref(0, TYPE_INT, nullable);
+        pred.add_child(&column_ref);
+        VExprContext context(&pred);
+
+        Block block = create_nullable_int_block(1000);
+        if (!nullable) {
+            block.get_by_position(0).column =
+                    assert_cast<const ColumnNullable&>(*block.get_by_position(0).column)
+                            .get_nested_column_ptr();
+            block.get_by_position(0).type = std::make_shared<DataTypeInt32>();
+        }
+        int result_column_id = -1;
+        ASSERT_TRUE(context.execute(&block, &result_column_id).ok());
+        const auto& result = result_column(block, result_column_id, 1000);
+        for (int i = 0; i < 1000; ++i) {
+            bool expected = (!nullable || i % 5 != 0) && filter->find(&i);
+            ASSERT_EQ(expected, result.get_bool(i)) << i;
+            if (i % 2 == 0 && (!nullable || i % 5 != 0)) {
+                // no false negative
+                ASSERT_TRUE(result.get_bool(i)) << i;
+            }
+        }
+    }
+}
+
+TEST(VRuntimeFilterPredicateTest, bloom_predicate_string) {
+    auto tracker = MemTracker::CreateTracker();
+    std::shared_ptr<IBloomFilterFuncBase> filter(
+            create_bloom_filter(tracker.get(), TYPE_VARCHAR));
+    ASSERT_TRUE(filter->init(1024, 0.05).ok());
+    std::vector<std::string> values;
+    for (int i = 0; i < 200; ++i) {
+        values.push_back("value_" + std::to_string(i));
+    }
+    for (int i = 0; i < 200; i += 3) {
+        StringValue value(values[i]);
+        filter->insert(&value);
+    }
+
+    auto column = ColumnString::create();
+    auto null_map = ColumnUInt8::create();
+    for (int i = 0; i < 200; ++i) {
+        column->insert_data(values[i].data(), values[i].size());
+        null_map->insert_value(i % 7 == 0);
+    }
+    Block block({{ColumnNullable::create(std::move(column), std::move(null_map)),
+                  make_nullable(std::make_shared<DataTypeString>()), "k1"}});
+
+    VBloomPredicate pred(create_predicate_node(TExprNodeType::BLOOM_PRED), filter);
+    MockColumnRef column_ref(0, TYPE_VARCHAR, true);
+    pred.add_child(&column_ref);
+    VExprContext context(&pred);
+    int result_column_id = -1;
+    ASSERT_TRUE(context.execute(&block, &result_column_id).ok());
+    const auto& result = result_column(block, result_column_id, 200);
+    for (int i = 0; i < 200; ++i) {
+        StringValue value(values[i]);
+        bool expected = i % 7 != 0 && filter->find(&value);
+        ASSERT_EQ(expected, result.get_bool(i)) << i;
+    }
+}
+
+TEST(VRuntimeFilterPredicateTest, bloom_predicate_skipped_if_not_selective) {
+    auto tracker = MemTracker::CreateTracker();
+    std::shared_ptr<IBloomFilterFuncBase> filter(create_bloom_filter(tracker.get(), TYPE_INT));
+    ASSERT_TRUE(filter->init(1024, 0.05).ok());
+    // only the null rows, 1/10 of all, are filtered
+    for (int i = 0; i < 10000; ++i) {
+        filter->insert(&i);
+    }
+    VBloomPredicate pred(create_predicate_node(TExprNodeType::BLOOM_PRED), filter);
+    MockColumnRef column_ref(0, TYPE_INT, true);
+    pred.add_child(&column_ref);
+    VExprContext context(&pred);
+
+    // the first rows are filtered until VBloomPredicate::_loop_size rows are sampled
+    Block block = create_nullable_int_block(4096, 10);
+    int result_column_id = -1;
+    ASSERT_TRUE(context.execute(&block, &result_column_id).ok());
+    ASSERT_FALSE(is_column_const(*block.get_by_position(result_column_id).column));
+    ASSERT_FALSE(result_column(block, result_column_id, 4096).get_bool(0));
+
+    block = create_nullable_int_block(8192, 10);
+    ASSERT_TRUE(context.execute(&block, &result_column_id).ok());
+    ASSERT_FALSE(is_column_const(*block.get_by_position(result_column_id).column));
+
+    // 1/10 of the rows filtered, less than VBloomPredicate::_expect_filter_rate
+    block = create_nullable_int_block(100, 10);
+    ASSERT_TRUE(context.execute(&block, &result_column_id).ok());
+    const auto& skipped = result_column(block, result_column_id, 100);
+    ASSERT_TRUE(is_column_const(skipped));
+    ASSERT_TRUE(skipped.get_bool(0));
+
+    // a copy keeps the decision, but samples the rows by itself before it's made
+    VBloomPredicate copied(pred);
+    ASSERT_TRUE(copied._always_true);
+    ASSERT_EQ(0, copied._scan_rows.load());
+}
+
+TEST(VRuntimeFilterPredicateTest, direct_in_predicate) {
+    std::shared_ptr<HybridSetBase> set(create_set(TYPE_INT));
+    for (int i = 0; i < 1000; i += 3) {
+        set->insert(&i);
+    }
+
+    for (bool nullable : {false, true}) {
+        SCOPED_TRACE(nullable);
+        VDirectInPredicate pred(create_predicate_node(TExprNodeType::IN_PRED), set);
+        MockColumnRef column_ref(0, TYPE_INT, nullable);
+        pred.add_child(&column_ref);
+        VExprContext context(&pred);
+
+        Block block = create_nullable_int_block(1000);
+        if (!nullable) {
+            block.get_by_position(0).column =
+                    assert_cast<const ColumnNullable&>(*block.get_by_position(0).column)
+                            .get_nested_column_ptr();
+            block.get_by_position(0).type = std::make_shared<DataTypeInt32>();
+        }
+        int result_column_id = -1;
+        ASSERT_TRUE(context.execute(&block, &result_column_id).ok());
+        const auto& result = result_column(block, result_column_id, 1000);
+        for (int i = 0; i < 1000; ++i) {
+            bool expected = (!nullable || i % 5 != 0) && i % 3 == 0;
+            ASSERT_EQ(expected, result.get_bool(i)) << i;
+        }
+    }
+}
+
+TEST(VRuntimeFilterPredicateTest, filter_block_by_contexts) {
+    auto tracker = MemTracker::CreateTracker();
+    std::shared_ptr<IBloomFilterFuncBase> filter(create_bloom_filter(tracker.get(), TYPE_INT));
+    ASSERT_TRUE(filter->init(1024, 0.05).ok());
+    for (int i = 0; i < 1000; i += 2) {
+        filter->insert(&i);
+    }
+    std::shared_ptr<HybridSetBase> set(create_set(TYPE_INT));
+    for (int i = 0; i < 1000; i += 3) {
+        set->insert(&i);
+    }
+
+    VBloomPredicate bloom_pred(create_predicate_node(TExprNodeType::BLOOM_PRED), filter);
+    MockColumnRef bloom_child(0, TYPE_INT, true);
+    bloom_pred.add_child(&bloom_child);
+    VExprContext bloom_context(&bloom_pred);
+    VDirectInPredicate in_pred(create_predicate_node(TExprNodeType::IN_PRED), set);
+    MockColumnRef in_child(0, TYPE_INT, true);
+    in_pred.add_child(&in_child);
+    VExprContext in_context(&in_pred);
+
+    Block block = create_nullable_int_block(1000);
+    ASSERT_TRUE(VExprContext::filter_block({&bloom_context, &in_context}, &block, 1).ok());
+    // the result columns are dropped
+    ASSERT_EQ(1, block.columns());
+
+    std::vector<int> expected;
+    for (int i = 0; i < 1000; ++i) {
+        if (i % 5 != 0 && i % 3 == 0 && filter->find(&i)) {
+            expected.push_back(i);
+        }
+    }
+    const auto& column = assert_cast<const ColumnNullable&>(*block.get_by_position(0).column);
+    ASSERT_EQ(expected.size(), column.size());
+    const auto& data = assert_cast<const ColumnInt32&>(column.get_nested_column()).get_data();
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_FALSE(column.is_null_at(i));
+        ASSERT_EQ(expected[i], data[i]);
+    }
+
+    // nothing left after an empty set
+    std::shared_ptr<HybridSetBase> empty_set(create_set(TYPE_INT));
+    VDirectInPredicate empty_pred(create_predicate_node(TExprNodeType::IN_PRED), empty_set);
+    MockColumnRef empty_child(0, TYPE_INT, true);
+    empty_pred.add_child(&empty_child);
+    VExprContext empty_context(&empty_pred);
+    block = create_nullable_int_block(1000);
+    ASSERT_TRUE(VExprContext::filter_block({&bloom_context, &empty_context}, &block, 1).ok());
+    ASSERT_EQ(0, block.rows());
+}
+
+} // namespace doris::vectorized
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
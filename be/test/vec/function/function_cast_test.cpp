@@ -0,0 +1,195 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "util/cpu_info.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_date.h"
+#include "vec/data_types/data_type_date_time.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/functions/function_cast.h"
+
+namespace doris::vectorized {
+
+// Converts the column with the column-level kernel, and checks the texts against
+// IDataType::to_string() of each row.
+static void check_to_string(const DataTypePtr& type, const ColumnPtr& column) {
+    Block block({{column, type, "from"}, {nullptr, std::make_shared<DataTypeString>(), "to"}});
+    ASSERT_TRUE(ConvertImplGenericToString::execute(block, {0}, 1).ok());
+    const auto& result = assert_cast<const ColumnString&>(*block.get_by_position(1).column);
+    ASSERT_EQ(column->size(), result.size());
+
+    auto expected = ColumnString::create();
+    VectorBufferWriter writer(*expected);
+    for (size_t i = 0; i < column->size(); ++i) {
+        type->to_string(*column, i, writer);
+        writer.commit();
+    }
+    for (size_t i = 0; i < column->size(); ++i) {
+        ASSERT_EQ(expected->get_data_at(i).to_string(), result.get_data_at(i).to_string()) << i;
+    }
+}
+
+template <typename T>
+static void check_int_to_string() {
+    auto column = ColumnVector<T>::create();
+    std::vector<T> values = {0,
+                             1,
+                             9,
+                             10,
+                             99,
+                             100,
+                             std::numeric_limits<T>::min(),
+                             std::numeric_limits<T>::max(),
+                             static_cast<T>(std::numeric_limits<T>::max() / 10),
+                             static_cast<T>(std::numeric_limits<T>::min() + 1)};
+    uint64_t seed = 17;
+    for (int i = 0; i < 1000; ++i) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        values.push_back(static_cast<T>(seed >> (i % 64)));
+    }
+    for (auto value : values) {
+        column->insert_value(value);
+    }
+    check_to_string(std::make_shared<DataTypeNumber<T>>(), std::move(column));
+}
+
+TEST(FunctionCastTest, number_to_string) {
+    check_int_to_string<Int8>();
+    check_int_to_string<Int16>();
+    check_int_to_string<Int32>();
+    check_int_to_string<Int64>();
+    check_int_to_string<UInt8>();
+    check_int_to_string<UInt16>();
+    check_int_to_string<UInt32>();
+    check_int_to_string<UInt64>();
+
+    auto doubles = ColumnFloat64::create();
+    for (double value : {0.0, -0.0, 1.5, -2.25, 1e100, 1.0 / 3, 123456789.125,
+                         std::numeric_limits<double>::min(), std::numeric_limits<double>::max(),
+                         std::numeric_limits<double>::lowest()}) {
+        doubles->insert_value(value);
+    }
+    check_to_string(std::make_shared<DataTypeFloat64>(), std::move(doubles));
+
+    auto floats = ColumnFloat32::create();
+    for (float value : {0.1f, -3.75f, 1e30f, std::numeric_limits<float>::max()}) {
+        floats->insert_value(value);
+    }
+    check_to_string(std::make_shared<DataTypeFloat32>(), std::move(floats));
+
+    // an empty column
+    check_to_string(std::make_shared<DataTypeInt32>(), ColumnInt32::create());
+}
+
+TEST(FunctionCastTest, date_to_string) {
+    auto dates = ColumnInt64::create();
+    auto datetimes = ColumnInt64::create();
+    for (int64_t value : {20210101L, 20210101L, 20211231L, 20211231L, 20211231L, 99991231L,
+                          10101L, 20210101L}) {
+        VecDateTimeValue date;
+        ASSERT_TRUE(date.from_date_int64(value));
+        date.cast_to_date();
+        dates->insert_value(binary_cast<VecDateTimeValue, Int64>(date));
+
+        VecDateTimeValue datetime;
+        ASSERT_TRUE(datetime.from_date_int64(value * 1000000 + 123456));
+        datetime.to_datetime();
+        datetimes->insert_value(binary_cast<VecDateTimeValue, Int64>(datetime));
+    }
+    check_to_string(std::make_shared<DataTypeDate>(), std::move(dates));
+    check_to_string(std::make_shared<DataTypeDateTime>(), std::move(datetimes));
+}
+
+// Casts the strings with ConvertThroughParsing, and checks the results against
+// read_int_text_impl() of each string.
+template <typename ToDataType>
+static void check_string_to_int(const std::vector<std::string>& strings) {
+    using T = typename ToDataType::FieldType;
+    auto column = ColumnString::create();
+    for (const auto& str : strings) {
+        column->insert_data(str.data(), str.size());
+    }
+    Block block({{std::move(column), std::make_shared<DataTypeString>(), "from"},
+                 {nullptr, make_nullable(std::make_shared<ToDataType>()), "to"}});
+    ASSERT_TRUE((ConvertThroughParsing<DataTypeString, ToDataType, NameCast>::execute(
+                         block, {0}, 1, strings.size()))
+                        .ok());
+    const auto& result = assert_cast<const ColumnNullable&>(*block.get_by_position(1).column);
+    const auto& values = assert_cast<const ColumnVector<T>&>(result.get_nested_column());
+
+    for (size_t i = 0; i < strings.size(); ++i) {
+        T expected = 0;
+        ReadBuffer buffer(const_cast<char*>(strings[i].data()), strings[i].size());
+        bool parsed = read_int_text_impl(expected, buffer) && buffer.eof();
+        ASSERT_EQ(!parsed, result.is_null_at(i)) << strings[i];
+        if (parsed) {
+            ASSERT_EQ(expected, values.get_element(i)) << strings[i];
+        }
+    }
+}
+
+TEST(FunctionCastTest, string_to_int) {
+    std::vector<std::string> strings = {"0",
+                                        "7",
+                                        "-7",
+                                        "+7",
+                                        "12345678",
+                                        "-123456789",
+                                        "00000000000000000012",
+                                        "2147483647",
+                                        "-2147483648",
+                                        "2147483648",
+                                        "99999999999999999999999",
+                                        "9223372036854775807",
+                                        "-9223372036854775808",
+                                        "18446744073709551615",
+                                        "",
+                                        "-",
+                                        "+",
+                                        "1-2",
+                                        "12a",
+                                        "1234567a",
+                                        "12345678a",
+                                        "a2345678",
+                                        " 12",
+                                        "12 ",
+                                        "1.5",
+                                        "12345678:"};
+    check_string_to_int<DataTypeInt8>(strings);
+    check_string_to_int<DataTypeInt16>(strings);
+    check_string_to_int<DataTypeInt32>(strings);
+    check_string_to_int<DataTypeInt64>(strings);
+    check_string_to_int<DataTypeUInt8>(strings);
+    check_string_to_int<DataTypeInt128>(strings);
+}
+
+} // namespace doris::vectorized
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    doris::CpuInfo::init();
+    return RUN_ALL_TESTS();
+}
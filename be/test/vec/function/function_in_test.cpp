@@ -0,0 +1,260 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "exprs/create_predicate_function.h"
+#include "function_test_util.h"
+#include "util/cpu_info.h"
+#include "vec/columns/column_const.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/assert_cast.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+
+namespace doris {
+
+// Builds a set of BIGINT values and checks find() and find_batch() of all values in
+// [begin, end) against the inserted values.
+static void check_bigint_set(const std::vector<int64_t>& values, int64_t begin, int64_t end) {
+    std::unique_ptr<HybridSetBase> set(create_set(TYPE_BIGINT));
+    for (auto value : values) {
+        set->insert(&value);
+    }
+    std::set<int64_t> expected(values.begin(), values.end());
+    ASSERT_EQ(expected.size(), set->size());
+
+    auto column = vectorized::ColumnInt64::create();
+    std::vector<uint8_t> null_map;
+    for (int64_t v = begin; v < end; ++v) {
+        column->insert_value(v);
+        null_map.push_back(v % 7 == 0);
+    }
+    for (auto value : values) {
+        column->insert_value(value);
+        null_map.push_back(0);
+    }
+    std::vector<uint8_t> results(column->size());
+    set->find_batch(*column, nullptr, results.data());
+    for (size_t i = 0; i < column->size(); ++i) {
+        int64_t value = column->get_element(i);
+        bool found = expected.count(value) > 0;
+        ASSERT_EQ(found, results[i]) << value;
+        ASSERT_EQ(found, set->find(&value)) << value;
+    }
+    set->find_batch(*column, null_map.data(), results.data());
+    for (size_t i = 0; i < column->size(); ++i) {
+        ASSERT_EQ(!null_map[i] && expected.count(column->get_element(i)) > 0, results[i]);
+    }
+}
+
+TEST(FunctionInTest, int_set_layouts) {
+    // compared one by one
+    check_bigint_set({}, -10, 10);
+    check_bigint_set({3, -5, 3, 100}, -10, 110);
+    std::vector<int64_t> values;
+    for (int64_t i = 0; i < 16; ++i) {
+        values.push_back(i * 1000);
+    }
+    check_bigint_set(values, -100, 16000);
+
+    // dense, growing in both directions
+    values.clear();
+    for (int64_t i = 0; i < 3000; ++i) {
+        values.push_back(i % 2 == 0 ? i : -i);
+    }
+    check_bigint_set(values, -4000, 4000);
+
+    // dense, descending and at the end of the range
+    values.clear();
+    for (int64_t i = 0; i < 200; ++i) {
+        values.push_back(std::numeric_limits<int64_t>::min() + 300 - i);
+    }
+    check_bigint_set(values, std::numeric_limits<int64_t>::min(),
+                     std::numeric_limits<int64_t>::min() + 1000);
+
+    // sparse, and dense again after more values are inserted
+    values.clear();
+    for (int64_t i = 0; i < 100; ++i) {
+        values.push_back(i * 1000003);
+    }
+    check_bigint_set(values, -100, 1000);
+    for (int64_t i = 0; i < 10000; ++i) {
+        values.push_back(i * 3);
+    }
+    check_bigint_set(values, -100, 40000);
+
+    values = {std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()};
+    for (int64_t i = 0; i < 20; ++i) {
+        values.push_back(i);
+    }
+    check_bigint_set(values, -100, 100);
+}
+
+TEST(FunctionInTest, string_set) {
+    for (int num : {3, 16, 100}) {
+        std::unique_ptr<HybridSetBase> set(create_set(TYPE_VARCHAR));
+        std::set<std::string> expected;
+        for (int i = 0; i < num; ++i) {
+            std::string value = std::string(i % 5, 'a') + std::to_string(i * 3);
+            set->insert(value.data(), value.size());
+            expected.insert(value);
+        }
+        set->insert((void*)"", 0);
+        expected.insert("");
+
+        auto column = vectorized::ColumnString::create();
+        for (int i = 0; i < num * 3; ++i) {
+            std::string value = std::string(i % 5, 'a') + std::to_string(i);
+            column->insert_data(value.data(), value.size());
+        }
+        column->insert_data("", 0);
+        std::vector<uint8_t> results(column->size());
+        set->find_batch(*column, nullptr, results.data());
+        for (size_t i = 0; i < column->size(); ++i) {
+            std::string value = column->get_data_at(i).to_string();
+            ASSERT_EQ(expected.count(value) > 0, results[i]) << value;
+            ASSERT_EQ(expected.count(value) > 0, set->find(value.data(), value.size()));
+        }
+    }
+}
+
+// Executes "value [not] in (args)", the args are constant or columns of the same value.
+static vectorized::ColumnPtr execute_in(const std::string& func_name,
+                                        const vectorized::ColumnPtr& values,
+                                        const std::vector<std::optional<int32_t>>& args,
+                                        bool const_args) {
+    using namespace vectorized;
+    size_t rows = values->size();
+    auto data_type = make_nullable(std::make_shared<DataTypeInt32>());
+    auto return_type = make_nullable(std::make_shared<DataTypeUInt8>());
+    Block block({{values, data_type, "value"}});
+    std::vector<std::shared_ptr<ColumnPtrWrapper>> constant_cols;
+    std::vector<ColumnPtrWrapper*> constant_col_ptrs = {nullptr};
+    for (const auto& arg : args) {
+        auto column = data_type->create_column();
+        if (arg.has_value()) {
+            column->insert(Field(Int64(*arg)));
+        } else {
+            column->insert_default();
+        }
+        ColumnPtr arg_column = ColumnConst::create(std::move(column), rows);
+        if (!const_args) {
+            arg_column = arg_column->convert_to_full_column_if_const();
+        }
+        constant_cols.push_back(std::make_shared<ColumnPtrWrapper>(arg_column));
+        constant_col_ptrs.push_back(const_args ? constant_cols.back().get() : nullptr);
+        block.insert({arg_column, data_type, "arg"});
+    }
+    ColumnNumbers arguments;
+    ColumnsWithTypeAndName arg_columns;
+    for (size_t i = 0; i < block.columns(); ++i) {
+        arguments.push_back(i);
+        arg_columns.push_back(block.get_by_position(i));
+    }
+    auto func = SimpleFunctionFactory::instance().get_function(func_name, arg_columns,
+                                                               return_type);
+    size_t result = block.columns();
+    block.insert({nullptr, return_type, "result"});
+
+    FunctionContext::TypeDesc int_type;
+    int_type.type = FunctionContext::TYPE_INT;
+    FunctionUtils fn_utils(int_type, std::vector<FunctionContext::TypeDesc>(arguments.size(),
+                                                                             int_type),
+                           0);
+    auto* fn_ctx = fn_utils.get_fn_ctx();
+    fn_ctx->impl()->set_constant_cols(constant_col_ptrs);
+    func->prepare(fn_ctx, FunctionContext::FRAGMENT_LOCAL);
+    func->prepare(fn_ctx, FunctionContext::THREAD_LOCAL);
+    EXPECT_TRUE(func->execute(fn_ctx, block, arguments, result, rows).ok());
+    func->close(fn_ctx, FunctionContext::THREAD_LOCAL);
+    func->close(fn_ctx, FunctionContext::FRAGMENT_LOCAL);
+    return block.get_by_position(result).column;
+}
+
+TEST(FunctionInTest, constant_and_column_args) {
+    using namespace vectorized;
+    auto values = ColumnNullable::create(ColumnInt32::create(), ColumnUInt8::create());
+    for (int i = -50; i < 150; ++i) {
+        if (i % 11 == 0) {
+            values->insert_default();
+        } else {
+            values->insert(Field(Int64(i)));
+        }
+    }
+    ColumnPtr values_ptr = std::move(values);
+
+    std::vector<std::vector<std::optional<int32_t>>> arg_lists = {
+            {1, 2, 3},
+            {1, std::nullopt, 33},
+            {std::nullopt},
+    };
+    std::vector<std::optional<int32_t>> large_args;
+    for (int i = 0; i < 100; ++i) {
+        large_args.push_back(i * 2);
+    }
+    arg_lists.push_back(large_args);
+    large_args.push_back(std::nullopt);
+    arg_lists.push_back(large_args);
+
+    for (const std::string func_name : {"in", "not_in"}) {
+        for (const auto& args : arg_lists) {
+            auto const_result = execute_in(func_name, values_ptr, args, true);
+            auto column_result = execute_in(func_name, values_ptr, args, false);
+            bool negative = func_name == "not_in";
+            for (size_t i = 0; i < values_ptr->size(); ++i) {
+                // null if the value is null, or if it's not found and a null is in the list
+                Field value = (*values_ptr)[i];
+                std::optional<bool> expected = std::nullopt;
+                if (!value.is_null()) {
+                    bool found = false;
+                    bool null_in_set = false;
+                    for (const auto& arg : args) {
+                        found |= arg.has_value() && *arg == value.get<Int64>();
+                        null_in_set |= !arg.has_value();
+                    }
+                    if (found || !null_in_set) {
+                        expected = negative ^ found;
+                    }
+                }
+                for (const auto& result : {const_result, column_result}) {
+                    ASSERT_EQ(!expected.has_value(), result->is_null_at(i)) << i;
+                    if (expected.has_value()) {
+                        ASSERT_EQ(*expected, (*result)[i].get<UInt64>()) << i;
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace doris
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    doris::CpuInfo::init();
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,105 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "function_test_util.h"
+#include "util/cpu_info.h"
+#include "vec/core/types.h"
+
+namespace doris {
+
+using vectorized::DataSet;
+using vectorized::Null;
+using vectorized::TypeIndex;
+
+// Checks the data set with a path column, and with a constant path for each line.
+template <typename ReturnType>
+static void check_json_function(const std::string& func_name, const DataSet& data_set) {
+    std::vector<std::any> const_path_input_types = {TypeIndex::String,
+                                                    vectorized::Consted {TypeIndex::String}};
+    for (const auto& line : data_set) {
+        DataSet const_path_dataset = {line};
+        vectorized::check_function<ReturnType, true>(func_name, const_path_input_types,
+                                                     const_path_dataset);
+    }
+
+    std::vector<std::any> input_types = {TypeIndex::String, TypeIndex::String};
+    vectorized::check_function<ReturnType, true>(func_name, input_types, data_set);
+}
+
+static const std::string JSON =
+        R"({"k1": "v1", "k2": {"k3": 12, "k4": [1, 2], "k5": "a\"b"}, "k6": 3.5, "k7": null})";
+
+TEST(FunctionJsonTest, get_json_string) {
+    DataSet data_set = {
+            {{JSON, std::string("$.k1")}, std::string("v1")},
+            {{JSON, std::string("$.k2")}, std::string(R"({"k3":12,"k4":[1,2],"k5":"a\"b"})")},
+            {{JSON, std::string("$.k2.k4")}, std::string("[1,2]")},
+            {{JSON, std::string("$.k2.k4[1]")}, std::string("2")},
+            {{JSON, std::string("$.k2.k5")}, std::string("a\"b")},
+            {{JSON, std::string("$.k6")}, std::string("3.5")},
+            {{JSON, std::string("$.k7")}, Null()},
+            {{JSON, std::string("$.k8")}, Null()},
+            {{JSON, std::string("$.k1.k3")}, Null()},
+            {{JSON, std::string("$.k2.k8")}, Null()},
+            // the first member of the key
+            {{std::string(R"({"a": 1, "a": 2})"), std::string("$.a")}, std::string("1")},
+            // arrays on the path are flattened
+            {{std::string(R"([{"a": 1}, {"a": 2}])"), std::string("$.a")}, std::string("[1,2]")},
+            {{std::string(R"({"x": [{"a": 1}, {"b": 2}, {"a": [3]}]})"), std::string("$.x.a")},
+             std::string("[1,3]")},
+            {{std::string(R"({"a": 1})"), std::string("$")}, std::string(R"({"a":1})")},
+            {{std::string("{"), std::string("$.a")}, Null()},
+            {{std::string("12"), std::string("$.a")}, Null()},
+            {{Null(), std::string("$.a")}, Null()},
+            {{JSON, Null()}, Null()},
+    };
+    check_json_function<vectorized::DataTypeString>("get_json_string", data_set);
+}
+
+TEST(FunctionJsonTest, get_json_int) {
+    DataSet data_set = {
+            {{JSON, std::string("$.k2.k3")}, 12},
+            {{JSON, std::string("$.k2.k4[0]")}, 1},
+            {{JSON, std::string("$.k6")}, Null()},
+            {{JSON, std::string("$.k2")}, Null()},
+            {{JSON, std::string("$.k9")}, Null()},
+            {{std::string(R"({"a": {"b": -3}, "c": 1})"), std::string("$.a.b")}, -3},
+    };
+    check_json_function<vectorized::DataTypeInt32>("get_json_int", data_set);
+}
+
+TEST(FunctionJsonTest, get_json_double) {
+    DataSet data_set = {
+            {{JSON, std::string("$.k6")}, 3.5},
+            {{JSON, std::string("$.k2.k3")}, 12.0},
+            {{JSON, std::string("$.k1")}, Null()},
+            {{JSON, std::string("$.k7")}, Null()},
+    };
+    check_json_function<vectorized::DataTypeFloat64>("get_json_double", data_set);
+}
+
+} // namespace doris
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    doris::CpuInfo::init();
+    return RUN_ALL_TESTS();
+}
@@ -21,7 +21,11 @@
 
 #include "function_test_util.h"
 #include "util/cpu_info.h"
+#include "vec/columns/column_const.h"
+#include "vec/columns/column_string.h"
+#include "vec/common/assert_cast.h"
 #include "vec/core/types.h"
+#include "vec/data_types/data_type_string.h"
 
 namespace doris {
 
@@ -54,6 +58,16 @@ TEST(FunctionLikeTest, like) {
             {{std::string("abc"), std::string("_a_")}, uint8_t(0)},
             {{std::string("abc"), std::string("a__")}, uint8_t(1)},
             {{std::string("abc"), std::string("a_")}, uint8_t(0)},
+            // only '%' wildcards
+            {{std::string("abcabd"), std::string("a%b%d")}, uint8_t(1)},
+            {{std::string("abcabd"), std::string("%ab%bd%")}, uint8_t(1)},
+            {{std::string("abcabd"), std::string("%bd%ab%")}, uint8_t(0)},
+            {{std::string("abab"), std::string("ab%ab")}, uint8_t(1)},
+            {{std::string("aba"), std::string("ab%ba")}, uint8_t(0)},
+            {{std::string("a%c"), std::string("%a\\%%c")}, uint8_t(1)},
+            {{std::string("abc"), std::string("%a\\%%c")}, uint8_t(0)},
+            {{std::string(""), std::string("%")}, uint8_t(1)},
+            {{std::string("abc"), std::string("%%")}, uint8_t(1)},
             // null
             {{std::string("abc"), Null()}, Null()},
             {{Null(), std::string("_x__ab%")}, Null()}
@@ -116,6 +130,71 @@ TEST(FunctionLikeTest, regexp) {
     vectorized::check_function<vectorized::DataTypeUInt8, true>(func_name, input_types, data_set);
 }
 
+// Matches many values with a constant pattern, the results are compared with the same pattern
+// given as a non-constant column, which is matched value by value.
+static std::vector<uint8_t> execute_like(const std::string& func_name,
+                                         const vectorized::ColumnPtr& values,
+                                         const std::string& pattern, bool const_pattern) {
+    using namespace vectorized;
+    size_t rows = values->size();
+    auto pattern_column = ColumnString::create();
+    pattern_column->insert_data(pattern.data(), pattern.size());
+    ColumnPtr patterns = ColumnConst::create(std::move(pattern_column), rows);
+    if (!const_pattern) {
+        patterns = patterns->convert_to_full_column_if_const();
+    }
+
+    auto string_type = std::make_shared<DataTypeString>();
+    auto return_type = std::make_shared<DataTypeUInt8>();
+    Block block({{values, string_type, "value"}, {patterns, string_type, "pattern"}});
+    auto func = SimpleFunctionFactory::instance().get_function(
+            func_name, {block.get_by_position(0), block.get_by_position(1)}, return_type);
+    block.insert({nullptr, return_type, "result"});
+
+    FunctionUtils fn_utils;
+    auto* fn_ctx = fn_utils.get_fn_ctx();
+    auto constant_col = std::make_shared<ColumnPtrWrapper>(patterns);
+    fn_ctx->impl()->set_constant_cols({nullptr, const_pattern ? constant_col.get() : nullptr});
+    func->prepare(fn_ctx, FunctionContext::FRAGMENT_LOCAL);
+    func->prepare(fn_ctx, FunctionContext::THREAD_LOCAL);
+    EXPECT_TRUE(func->execute(fn_ctx, block, {0, 1}, 2, rows).ok());
+    func->close(fn_ctx, FunctionContext::THREAD_LOCAL);
+    func->close(fn_ctx, FunctionContext::FRAGMENT_LOCAL);
+
+    const auto& result = assert_cast<const ColumnUInt8&>(*block.get_by_position(2).column);
+    return {result.get_data().begin(), result.get_data().end()};
+}
+
+TEST(FunctionLikeTest, constant_pattern_batch) {
+    auto values = vectorized::ColumnString::create();
+    std::string alphabet = "abc%_";
+    for (int i = 0; i < 2000; ++i) {
+        // values of different lengths, some longer than a SIMD register
+        std::string value;
+        for (int j = 0; j < (i * 7) % 41; ++j) {
+            value.push_back(alphabet[(i * 13 + j * j) % alphabet.size()]);
+        }
+        values->insert_data(value.data(), value.size());
+    }
+    vectorized::ColumnPtr values_ptr = std::move(values);
+
+    std::vector<std::string> like_patterns = {"%ab%",   "%cab%", "%bca%",  "ab%",  "%ca",
+                                              "aabbcc", "a%b%c", "%a%b%c", "%a%%", "%",
+                                              "%a\\%%", "a_c%",  "%b_a%",  "",     "%\\_b%"};
+    for (const auto& pattern : like_patterns) {
+        EXPECT_EQ(execute_like("like", values_ptr, pattern, false),
+                  execute_like("like", values_ptr, pattern, true))
+                << "like pattern: " << pattern;
+    }
+    std::vector<std::string> regexp_patterns = {"ab",  ".*ab.*", "^ab.*", ".*ca$",
+                                                "^a$", "a.c",    "(ab|ca)c", ""};
+    for (const auto& pattern : regexp_patterns) {
+        EXPECT_EQ(execute_like("regexp", values_ptr, pattern, false),
+                  execute_like("regexp", values_ptr, pattern, true))
+                << "regexp pattern: " << pattern;
+    }
+}
+
 } // namespace doris
 
 int main(int argc, char** argv) {
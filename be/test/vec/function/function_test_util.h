@@ -29,7 +29,7 @@
 #include "util/bitmap_value.h"
 #include "udf/udf.h"
 #include "udf/udf_internal.h"
-#include "vec/columns/column_complex.h"
+#include "vec/columns/column_bitmap.h"
 #include "vec/functions/function_string.h"
 #include "vec/functions/function_string_to_string.h"
 #include "vec/functions/simple_function_factory.h"
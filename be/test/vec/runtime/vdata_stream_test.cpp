@@ -169,6 +169,56 @@ TEST_F(VDataStreamTest, BasicTest) {
     sender.close(&runtime_stat, exec_status);
     recv->close();
 }
+
+// The pipeline engine checks is_full() before sending to a local receiver, and the sender
+// doesn't wait for the receiver in add_block().
+TEST_F(VDataStreamTest, LocalBlockWithoutWait) {
+    doris::DescriptorTblBuilder builder(&_object_pool);
+    builder.declare_tuple() << doris::TYPE_INT;
+    doris::DescriptorTbl* desc_tbl = builder.build();
+    auto tuple_desc = const_cast<doris::TupleDescriptor*>(desc_tbl->get_tuple_descriptor(0));
+    doris::RowDescriptor row_desc(tuple_desc, false);
+
+    doris::RuntimeState runtime_stat(doris::TUniqueId(), doris::TQueryOptions(),
+                                     doris::TQueryGlobals(), nullptr);
+    runtime_stat.init_instance_mem_tracker();
+    runtime_stat.set_desc_tbl(desc_tbl);
+
+    TUniqueId uid;
+    PlanNodeId nid = 1;
+    int num_senders = 1;
+    int buffer_size = 1024;
+    RuntimeProfile profile("profile");
+    std::shared_ptr<QueryStatisticsRecvr> statistics = std::make_shared<QueryStatisticsRecvr>();
+    auto recv = _instance.create_recvr(&runtime_stat, row_desc, uid, nid, num_senders, buffer_size,
+                                       &profile, false, statistics);
+    ASSERT_FALSE(recv->is_full());
+
+    auto create_block = []() {
+        auto vec = vectorized::ColumnVector<Int32>::create();
+        for (int i = 0; i < 1024; ++i) {
+            vec->get_data().push_back(i);
+        }
+        vectorized::DataTypePtr data_type(std::make_shared<vectorized::DataTypeInt32>());
+        return vectorized::Block({{vec->get_ptr(), data_type, "test_int"}});
+    };
+    // 4KB exceeds the buffer limit, add_block() would wait if 'wait_if_full'
+    auto block = create_block();
+    recv->add_block(&block, 0, false, false);
+    ASSERT_TRUE(recv->is_full());
+    auto block_2 = create_block();
+    recv->add_block(&block_2, 0, false, false);
+
+    for (int i = 0; i < 2; ++i) {
+        Block result;
+        bool eos = false;
+        ASSERT_TRUE(recv->get_next(&result, &eos).ok());
+        ASSERT_EQ(1024, result.rows());
+        ASSERT_FALSE(eos);
+    }
+    ASSERT_FALSE(recv->is_full());
+    recv->close();
+}
 } // namespace doris::vectorized
 
 int main(int argc, char** argv) {
@@ -688,8 +688,11 @@ public class FunctionCallExpr extends Expr {
                 fn = getTableFunction(fnName.getFunction(), childTypes,
                         Function.CompareMode.IS_NONSTRICT_SUPERTYPE_OF);
                 if (fn == null) {
-                    throw new AnalysisException("Doris only support `explode_split(varchar, varchar)` table function");
+                    throw new AnalysisException("Doris only support `explode_split(varchar, varchar)`, "
+                            + "`explode_bitmap(bitmap)` and `explode_json_array_int/double/string(varchar)` "
+                            + "table function");
                 }
+                type = fn.getReturnType();
                 return;
             }
             // now first find function in built-in functions
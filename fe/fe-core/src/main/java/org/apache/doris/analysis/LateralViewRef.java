@@ -20,7 +20,6 @@ package org.apache.doris.analysis;
 import org.apache.doris.catalog.Column;
 import org.apache.doris.catalog.FunctionSet;
 import org.apache.doris.catalog.InlineView;
-import org.apache.doris.catalog.Type;
 import org.apache.doris.common.AnalysisException;
 import org.apache.doris.common.Config;
 import org.apache.doris.common.UserException;
@@ -81,11 +80,9 @@ public class LateralViewRef extends TableRef {
         fnExpr.setTableFnCall(true);
         checkAndSupplyDefaultTableName(fnExpr);
         fnExpr.analyze(analyzer);
-        if (!fnExpr.getFnName().getFunction().equals(FunctionSet.EXPLODE_SPLIT)) {
-            throw new AnalysisException("Only support explode function in lateral view");
-        }
         checkScalarFunction(fnExpr.getChild(0));
-        if (!(fnExpr.getChild(1) instanceof StringLiteral)) {
+        if (fnExpr.getFnName().getFunction().equals(FunctionSet.EXPLODE_SPLIT)
+                && !(fnExpr.getChild(1) instanceof StringLiteral)) {
             throw new AnalysisException("Split separator of explode must be a string const");
         }
         fnExpr.getChild(0).collect(SlotRef.class, originSlotRefList);
@@ -100,7 +97,7 @@ public class LateralViewRef extends TableRef {
     public TupleDescriptor createTupleDescriptor(Analyzer analyzer) throws AnalysisException {
         // Create a fake catalog table for the lateral view
         List<Column> columnList = Lists.newArrayList();
-        columnList.add(new Column(columnName, Type.VARCHAR,
+        columnList.add(new Column(columnName, fnExpr.getType(),
                 false, null, true,
                 null, ""));
         view = new InlineView(viewName, columnList);
@@ -1555,4 +1555,13 @@ public class Config extends ConfigBase {
      */
     @ConfField(mutable = true, masterOnly = true)
     public static boolean enable_force_drop_redundant_replica = false;
+
+    /*
+     * The exec version of the BEs sent to them in the query options. The data exchanged between BEs
+     * may use the formats added in this version, e.g. the raw intermediate states of aggregate functions
+     * from version 1, which the BEs of older versions can't read.
+     * Only increase it after all BEs are upgraded to a version supporting it.
+     */
+    @ConfField(mutable = true, masterOnly = false)
+    public static int be_exec_version = 0;
 }
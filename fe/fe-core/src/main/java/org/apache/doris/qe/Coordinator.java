@@ -228,6 +228,7 @@ public class Coordinator {
         this.descTable = analyzer.getDescTbl().toThrift();
         this.returnedAllResults = false;
         this.queryOptions = context.getSessionVariable().toThrift();
+        this.queryOptions.setBeExecVersion(Config.be_exec_version);
 
         setFromUserProperty(analyzer);
 
@@ -257,6 +258,7 @@ public class Coordinator {
         this.fragments = fragments;
         this.scanNodes = scanNodes;
         this.queryOptions = new TQueryOptions();
+        this.queryOptions.setBeExecVersion(Config.be_exec_version);
         this.queryGlobals.setNowString(DATE_FORMAT.format(new Date()));
         this.queryGlobals.setTimestampMs(new Date().getTime());
         this.queryGlobals.setTimeZone(timezone);
@@ -87,6 +87,7 @@ struct TCreateTabletReq {
     12: optional bool is_eco_mode
     13: optional TStorageFormat storage_format
     14: optional TTabletType tablet_type
+    15: optional bool enable_unique_key_merge_on_write = false
 }
 
 struct TDropTabletReq {
@@ -160,6 +160,14 @@ struct TQueryOptions {
   // show bitmap data in result, if use this in mysql cli may make the terminal
   // output corrupted character
   43: optional bool return_object_data_as_binary = false
+
+  // run the fragments on the pipeline engine, only works with the vectorized engine
+  44: optional bool enable_pipeline_engine = false
+
+  // the exec version which all BEs of the query support, the formats of the data exchanged
+  // between BEs which older BEs can't read are only used from the version they are added in.
+  // Set by the coordinator from the FE config be_exec_version.
+  45: optional i32 be_exec_version = 0
 }
     
 
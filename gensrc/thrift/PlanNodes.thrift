@@ -403,6 +403,13 @@ struct TMergeJoinNode {
   // anything from the ON or USING clauses (but *not* the WHERE clause) that's not an
   // equi-join predicate
   2: optional list<Exprs.TExpr> other_join_conjuncts
+
+  // only use in vec exec engine, which supports inner, left outer, left semi and left anti
+  // join, the inputs must be sorted ascending on the join keys with nulls first
+  3: optional TJoinOp join_op
+
+  // same as other_join_conjuncts, only use in vec exec engine
+  4: optional Exprs.TExpr vother_join_conjunct
 }
 
 enum TAggregationOp {